@@ -119,7 +119,8 @@ void DumpIRProto(const FuncGraphPtr &func_graph, const std::string &suffix);
 
 std::string GetOnnxProtoString(const FuncGraphPtr &func_graph);
 
-std::string GetBinaryProtoString(const FuncGraphPtr &func_graph);
+// Export a graph in MindIR format, the data of the parameters with default value can be left out
+std::string GetBinaryProtoString(const FuncGraphPtr &func_graph, bool export_param_data = true);
 }  // namespace mindspore
 
 #endif  // MINDSPORE_CCSRC_DEBUG_ANF_IR_UTILS_H_
@@ -16,7 +16,9 @@
 
 #include "frontend/optimizer/opt.h"
 
+#include <algorithm>
 #include <deque>
+#include <iterator>
 #include <memory>
 #include <unordered_map>
 
@@ -31,7 +33,7 @@ namespace opt {
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name, const PrimitivePtr &prim,
                                  const RenormAction &renorm_action) {
   auto fn = [prim](const AnfNodePtr &node) -> bool { return IsPrimitiveCNode(node, prim); };
-  return std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  return std::make_shared<Substitution>(transform, name, fn, renorm_action, std::vector<PrimitivePtr>{prim});
 }
 
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
@@ -58,7 +60,7 @@ SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std:
     return false;
   };
 
-  return std::make_shared<Substitution>(transform, name, fn, renorm_action);
+  return std::make_shared<Substitution>(transform, name, fn, renorm_action, prims);
 }
 
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
@@ -102,8 +104,45 @@ static bool isTraversable(const AnfNodePtr &node) {
   return false;
 }
 
-bool SubstitutionList::ApplyTransform(const OptimizerPtr &optimizer, const AnfNodePtr &root_node,
-                                      const SubstitutionPtr &transform) const {
+SubstitutionList::SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once)
+    : list_(patterns), is_once_(is_once) {
+  for (size_t i = 0; i < list_.size(); i++) {
+    MS_EXCEPTION_IF_NULL(list_[i]);
+    if (list_[i]->prims_.empty()) {
+      generic_.push_back(i);
+      continue;
+    }
+    for (auto &prim : list_[i]->prims_) {
+      MS_EXCEPTION_IF_NULL(prim);
+      auto &indices = prim_index_[prim->name()];
+      if (indices.empty() || indices.back() != i) {
+        indices.push_back(i);
+      }
+    }
+  }
+}
+
+const std::vector<size_t> &SubstitutionList::Candidates(const AnfNodePtr &node, std::vector<size_t> *buffer) const {
+  auto prim = GetCNodePrimitive(node);
+  if (prim == nullptr) {
+    return generic_;
+  }
+  auto iter = prim_index_.find(prim->name());
+  if (iter == prim_index_.end()) {
+    return generic_;
+  }
+  if (generic_.empty()) {
+    return iter->second;
+  }
+  // keep the order of the list between the substitutions of the primitive and the generic ones
+  buffer->clear();
+  (void)std::merge(iter->second.begin(), iter->second.end(), generic_.begin(), generic_.end(),
+                   std::back_inserter(*buffer));
+  return *buffer;
+}
+
+bool SubstitutionList::ApplyTransforms(const OptimizerPtr &optimizer, const AnfNodePtr &root_node,
+                                       std::vector<bool> *changed) const {
 #ifdef ENABLE_PROFILE
   double start = GetTime();
 #endif
@@ -114,8 +153,24 @@ bool SubstitutionList::ApplyTransform(const OptimizerPtr &optimizer, const AnfNo
   todo.clear();
   todo.push_back(root_node);
   bool changes = false;
+  std::vector<size_t> buffer;
+  size_t visits = 0;
+  size_t matches = 0;
+  size_t replaces = 0;
+
+  // a node which has already been visited is visited again when it is pushed after a reset of its mark
+  auto revisit = [&todo, seen](const AnfNodePtr &node) {
+    if (node == nullptr) {
+      return;
+    }
+    if (node->seen_ == seen) {
+      node->seen_--;
+    }
+    todo.push_back(node);
+  };
 
   auto &all_nodes = manager->all_nodes();
+  auto &node_users = manager->node_users();
   while (!todo.empty()) {
     AnfNodePtr node = todo.front();
     todo.pop_front();
@@ -125,17 +180,18 @@ bool SubstitutionList::ApplyTransform(const OptimizerPtr &optimizer, const AnfNo
       continue;
     }
     node->seen_ = seen;
+    visits++;
 
-    // select nodes that this transform can be applied.
-    bool is_match = transform->predicate_(node);
-
-    // apply transform on this node
-    bool change = false;
-    if (is_match) {
+    // try the substitutions which can be applied on this node in list order, the first replacement wins
+    AnfNodePtr new_node = nullptr;
+    for (size_t i : Candidates(node, &buffer)) {
+      auto &transform = list_[i];
+      if (!transform->predicate_(node)) {
+        continue;
+      }
+      matches++;
       auto ret = (*transform)(optimizer, node);
       if (ret != nullptr && ret != node) {
-        change = true;
-        changes = true;
 #ifdef ENABLE_PROFILE
         double t = GetTime();
 #endif
@@ -143,10 +199,31 @@ bool SubstitutionList::ApplyTransform(const OptimizerPtr &optimizer, const AnfNo
 #ifdef ENABLE_PROFILE
         MsProfile::StatTime("replace." + transform->name_, GetTime() - t);
 #endif
-        node = ret;
+        (*changed)[i] = true;
+        replaces++;
+        new_node = ret;
+        break;
       }
     }
 
+    if (new_node != nullptr) {
+      changes = true;
+      // the new node is matched again, the users of the replaced node now use it and its producers lost a user
+      revisit(new_node);
+      auto users = node_users.find(new_node);
+      if (users != node_users.end()) {
+        for (auto &use : users->second) {
+          revisit(use.first);
+        }
+      }
+      if (node->isa<CNode>()) {
+        for (auto &input : node->cast<CNodePtr>()->inputs()) {
+          revisit(input);
+        }
+      }
+      continue;
+    }
+
     // find success, and add them to todo list
     if (IsValueNode<FuncGraph>(node)) {
       todo.push_back(GetValueNode<FuncGraphPtr>(node)->output());
@@ -156,25 +233,16 @@ bool SubstitutionList::ApplyTransform(const OptimizerPtr &optimizer, const AnfNo
       auto &inputs = node->cast<CNodePtr>()->inputs();
       (void)std::copy(inputs.begin(), inputs.end(), std::back_inserter(todo));
     }
-
-    auto &node_users = manager->node_users();
-    if (change && node_users.find(node) != node_users.end()) {
-      for (auto &use : node_users[node]) {
-        auto use_node = use.first;
-        if (use_node == nullptr) {
-          continue;
-        }
-        todo.push_back(use_node);
-        if (use_node->seen_ == seen) {
-          use_node->seen_--;
-        }
-      }
-    }
   }
 
 #ifdef ENABLE_PROFILE
   MsProfile::StatTime("opt.transform." + optimizer->name(), GetTime() - start);
+  MsProfile::StatCount("opt.transform.visit." + optimizer->name(), visits);
+  MsProfile::StatCount("opt.transform.match." + optimizer->name(), matches);
+  MsProfile::StatCount("opt.transform.replace." + optimizer->name(), replaces);
 #endif
+  MS_LOG(DEBUG) << "Transform pass of " << optimizer->name() << ", visited nodes: " << visits
+                << ", matched nodes: " << matches << ", replaced nodes: " << replaces;
   return changes;
 }
 
@@ -197,15 +265,14 @@ bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const Optimize
   bool changes = false;
 
   do {
-    loop = false;
-    for (size_t i = 0; i < list_.size(); i++) {
-      auto change = ApplyTransform(optimizer, func_graph->output(), list_[i]);
-      changes = changes || change;
-      loop = loop || change;
+    std::vector<bool> changed(list_.size(), false);
+    loop = ApplyTransforms(optimizer, func_graph->output(), &changed);
+    changes = changes || loop;
 
-      // record the status of each transform
-      if (optimizer->is_on_debug_) {
-        status[list_[i]->name_ + std::to_string(i)].push_back(change);
+    // record the status of each transform
+    if (optimizer->is_on_debug_) {
+      for (size_t i = 0; i < list_.size(); i++) {
+        status[list_[i]->name_ + std::to_string(i)].push_back(changed[i]);
         space = std::max(list_[i]->name_.size(), space);
       }
     }
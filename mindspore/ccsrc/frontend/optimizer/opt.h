@@ -19,6 +19,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "ir/anf.h"
@@ -42,9 +43,11 @@ class Substitution {
   PredicateFuncType predicate_{nullptr};
   // an enum to mark this Substitution relation to renormalize pass
   RenormAction renorm_action_;
+  // primitives of the cnodes this Substitution is selected for, empty if it is selected by the predicate only
+  std::vector<PrimitivePtr> prims_;
   Substitution(const OptimizerCallerPtr &transform, const std::string &name, const PredicateFuncType &predicate,
-               const RenormAction &renorm_action)
-      : transform_(transform), name_(name), predicate_(predicate), renorm_action_(renorm_action) {}
+               const RenormAction &renorm_action, const std::vector<PrimitivePtr> &prims = {})
+      : transform_(transform), name_(name), predicate_(predicate), renorm_action_(renorm_action), prims_(prims) {}
   ~Substitution() = default;
   AnfNodePtr operator()(const OptimizerPtr &optimizer, const AnfNodePtr &node);
 };
@@ -59,19 +62,29 @@ SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std:
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
                                  const PredicateFuncType &predicate, const RenormAction &action_renorm = CHECK_RENORM);
 
+// Apply a list of Substitution to a graph. All the substitutions are applied in a single worklist traversal: the
+// substitutions are indexed by the primitive they are selected for, so each node only tries the ones which can match
+// it, in list order. After a replacement only the new node, the users and the producers of the replaced node are
+// visited again. The traversal is repeated until it does not change the graph, unless is_once is set.
 class SubstitutionList {
  public:
-  explicit SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once = false)
-      : list_(patterns), is_once_(is_once) {}
+  explicit SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once = false);
   ~SubstitutionList() = default;
 
   bool operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const;
 
  private:
-  bool ApplyTransform(const OptimizerPtr &optimizer, const AnfNodePtr &node, const SubstitutionPtr &transform) const;
+  // indices in list_ of the substitutions which may match the node, in increasing order
+  const std::vector<size_t> &Candidates(const AnfNodePtr &node, std::vector<size_t> *buffer) const;
+  // one worklist traversal of the graph, changed records which substitutions replaced a node
+  bool ApplyTransforms(const OptimizerPtr &optimizer, const AnfNodePtr &root_node, std::vector<bool> *changed) const;
   std::vector<SubstitutionPtr> list_;
   // a flag to mark this list of Substitution can only be executed only once
   bool is_once_;
+  // indices in list_ of the substitutions selected by a primitive, by primitive name
+  std::unordered_map<std::string, std::vector<size_t>> prim_index_;
+  // indices in list_ of the substitutions selected by a predicate only, tried on every node
+  std::vector<size_t> generic_;
 };
 }  // namespace opt
 }  // namespace mindspore
@@ -39,12 +39,20 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("set_op_connector_size", &ConfigManager::set_op_connector_size)
                     .def("set_seed", &ConfigManager::set_seed)
                     .def("set_monitor_sampling_interval", &ConfigManager::set_monitor_sampling_interval)
+                    .def("set_enable_autotune", &ConfigManager::set_enable_autotune)
+                    .def("set_autotune_steps", &ConfigManager::set_autotune_steps)
+                    .def("set_out_of_order", &ConfigManager::set_out_of_order)
+                    .def("set_reorder_window", &ConfigManager::set_reorder_window)
                     .def("get_rows_per_buffer", &ConfigManager::rows_per_buffer)
                     .def("get_num_parallel_workers", &ConfigManager::num_parallel_workers)
                     .def("get_worker_connector_size", &ConfigManager::worker_connector_size)
                     .def("get_op_connector_size", &ConfigManager::op_connector_size)
                     .def("get_seed", &ConfigManager::seed)
                     .def("get_monitor_sampling_interval", &ConfigManager::monitor_sampling_interval)
+                    .def("get_enable_autotune", &ConfigManager::enable_autotune)
+                    .def("get_autotune_steps", &ConfigManager::autotune_steps)
+                    .def("get_out_of_order", &ConfigManager::out_of_order)
+                    .def("get_reorder_window", &ConfigManager::reorder_window)
                     .def("load", [](ConfigManager &c, std::string s) { THROW_IF_ERROR(c.LoadFile(s)); });
                 }));
 
@@ -22,15 +22,16 @@ namespace dataset {
 
 PYBIND_REGISTER(CacheClient, 0, ([](const py::module *m) {
                   (void)py::class_<CacheClient, std::shared_ptr<CacheClient>>(*m, "CacheClient")
-                    .def(
-                      py::init([](session_id_type id, uint64_t mem_sz, bool spill, int32_t port, int32_t prefetch_sz) {
-                        std::shared_ptr<CacheClient> cc;
-                        CacheClient::Builder builder;
-                        builder.SetSessionId(id).SetCacheMemSz(mem_sz).SetSpill(spill).SetPort(port).SetPrefetchSize(
-                          prefetch_sz);
-                        THROW_IF_ERROR(builder.Build(&cc));
-                        return cc;
-                      }))
+                    .def(py::init([](session_id_type id, uint64_t mem_sz, bool spill, int32_t port, int32_t prefetch_sz,
+                                     uint8_t evict_policy, bool compress) {
+                      std::shared_ptr<CacheClient> cc;
+                      CacheClient::Builder builder;
+                      builder.SetSessionId(id).SetCacheMemSz(mem_sz).SetSpill(spill).SetPort(port).SetPrefetchSize(
+                        prefetch_sz);
+                      builder.SetEvictPolicy(static_cast<CachePool::EvictPolicy>(evict_policy)).SetCompress(compress);
+                      THROW_IF_ERROR(builder.Build(&cc));
+                      return cc;
+                    }))
                     .def("GetStat", [](CacheClient &cc) {
                       CacheServiceStat stat{};
                       THROW_IF_ERROR(cc.GetStat(&stat));
@@ -40,7 +41,12 @@ PYBIND_REGISTER(CacheClient, 0, ([](const py::module *m) {
                     .def(py::init<>())
                     .def_readwrite("avg_cache_sz", &CacheServiceStat::avg_cache_sz)
                     .def_readwrite("num_mem_cached", &CacheServiceStat::num_mem_cached)
-                    .def_readwrite("num_disk_cached", &CacheServiceStat::num_disk_cached);
+                    .def_readwrite("num_disk_cached", &CacheServiceStat::num_disk_cached)
+                    .def_readwrite("num_compressed", &CacheServiceStat::num_compressed)
+                    .def_readwrite("num_evicted", &CacheServiceStat::num_evicted)
+                    .def_readwrite("num_mem_hit", &CacheServiceStat::num_mem_hit)
+                    .def_readwrite("num_disk_hit", &CacheServiceStat::num_disk_hit)
+                    .def_readwrite("num_miss", &CacheServiceStat::num_miss);
                 }));
 
 }  // namespace dataset
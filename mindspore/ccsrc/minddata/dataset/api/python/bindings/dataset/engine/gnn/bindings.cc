@@ -29,10 +29,10 @@ PYBIND_REGISTER(
   Graph, 0, ([](const py::module *m) {
     (void)py::class_<gnn::GraphData, std::shared_ptr<gnn::GraphData>>(*m, "GraphDataClient")
       .def(py::init([](const std::string &dataset_file, int32_t num_workers, const std::string &working_mode,
-                       const std::string &hostname, int32_t port) {
+                       const std::string &hostname, int32_t port, bool csr_storage) {
         std::shared_ptr<gnn::GraphData> out;
         if (working_mode == "local") {
-          out = std::make_shared<gnn::GraphDataImpl>(dataset_file, num_workers);
+          out = std::make_shared<gnn::GraphDataImpl>(dataset_file, num_workers, false, csr_storage);
         } else if (working_mode == "client") {
           out = std::make_shared<gnn::GraphDataClient>(dataset_file, hostname, port);
         }
@@ -106,10 +106,10 @@ PYBIND_REGISTER(
 
     (void)py::class_<gnn::GraphDataServer, std::shared_ptr<gnn::GraphDataServer>>(*m, "GraphDataServer")
       .def(py::init([](const std::string &dataset_file, int32_t num_workers, const std::string &hostname, int32_t port,
-                       int32_t client_num, bool auto_shutdown) {
+                       int32_t client_num, bool auto_shutdown, bool csr_storage) {
         std::shared_ptr<gnn::GraphDataServer> out;
-        out =
-          std::make_shared<gnn::GraphDataServer>(dataset_file, num_workers, hostname, port, client_num, auto_shutdown);
+        out = std::make_shared<gnn::GraphDataServer>(dataset_file, num_workers, hostname, port, client_num,
+                                                     auto_shutdown, csr_storage);
         THROW_IF_ERROR(out->Init());
         return out;
       }))
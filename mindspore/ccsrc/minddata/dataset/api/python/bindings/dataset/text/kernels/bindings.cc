@@ -89,7 +89,8 @@ PYBIND_REGISTER(RegexTokenizerOp, 1, ([](const py::module *m) {
 PYBIND_REGISTER(BertTokenizerOp, 1, ([](const py::module *m) {
                   (void)py::class_<BertTokenizerOp, TensorOp, std::shared_ptr<BertTokenizerOp>>(*m, "BertTokenizerOp")
                     .def(py::init<const std::shared_ptr<Vocab> &, const std::string &, const int &, const std::string &,
-                                  const bool &, const bool &, const NormalizeForm &, const bool &, const bool &>());
+                                  const bool &, const bool &, const NormalizeForm &, const bool &, const bool &,
+                                  const bool &>());
                 }));
 
 PYBIND_REGISTER(NormalizeForm, 0, ([](const py::module *m) {
@@ -148,7 +149,7 @@ PYBIND_REGISTER(WordpieceTokenizerOp, 1, ([](const py::module *m) {
                   (void)py::class_<WordpieceTokenizerOp, TensorOp, std::shared_ptr<WordpieceTokenizerOp>>(
                     *m, "WordpieceTokenizerOp")
                     .def(py::init<const std::shared_ptr<Vocab> &, const std::string &, const int &, const std::string &,
-                                  const bool &>());
+                                  const bool &, const bool &>());
                 }));
 
 PYBIND_REGISTER(SlidingWindowOp, 1, ([](const py::module *m) {
@@ -42,6 +42,10 @@ Status ConfigManager::FromJson(const nlohmann::json &j) {
   set_op_connector_size(j.value("opConnectorSize", op_connector_size_));
   set_seed(j.value("seed", seed_));
   set_monitor_sampling_interval(j.value("monitorSamplingInterval", monitor_sampling_interval_));
+  set_enable_autotune(j.value("enableAutoTune", enable_autotune_));
+  set_autotune_steps(j.value("autoTuneSteps", autotune_steps_));
+  set_out_of_order(j.value("outOfOrder", out_of_order_));
+  set_reorder_window(j.value("reorderWindow", reorder_window_));
   return Status::OK();
 }
 
@@ -88,5 +92,13 @@ uint32_t ConfigManager::seed() const { return seed_; }
 void ConfigManager::set_seed(uint32_t seed) { seed_ = seed; }
 
 void ConfigManager::set_monitor_sampling_interval(uint32_t interval) { monitor_sampling_interval_ = interval; }
+
+void ConfigManager::set_enable_autotune(bool enable) { enable_autotune_ = enable; }
+
+void ConfigManager::set_autotune_steps(int64_t steps) { autotune_steps_ = steps; }
+
+void ConfigManager::set_out_of_order(bool out_of_order) { out_of_order_ = out_of_order; }
+
+void ConfigManager::set_reorder_window(int32_t window) { reorder_window_ = window; }
 }  // namespace dataset
 }  // namespace mindspore
@@ -119,6 +119,38 @@ class ConfigManager {
   // @return The iterval of monitor sampling
   int32_t monitor_sampling_interval() const { return monitor_sampling_interval_; }
 
+  // setter function
+  // @param enable - Whether the performance monitor tunes the pipeline while it is running
+  void set_enable_autotune(bool enable);
+
+  // getter function
+  // @return Whether pipeline autotuning is enabled
+  bool enable_autotune() const { return enable_autotune_; }
+
+  // setter function
+  // @param steps - The number of steps at the beginning of the run during which the pipeline is tuned
+  void set_autotune_steps(int64_t steps);
+
+  // getter function
+  // @return The number of steps during which the pipeline is tuned
+  int64_t autotune_steps() const { return autotune_steps_; }
+
+  // setter function
+  // @param out_of_order - Whether parallel ops of a new pipeline may output their buffers out of order
+  void set_out_of_order(bool out_of_order);
+
+  // getter function
+  // @return Whether new pipelines run out of order
+  bool out_of_order() const { return out_of_order_; }
+
+  // setter function
+  // @param window - How many buffers following a buffer may overtake it when a pipeline runs out of order, plus one
+  void set_reorder_window(int32_t window);
+
+  // getter function
+  // @return The reorder window of pipelines running out of order
+  int32_t reorder_window() const { return reorder_window_; }
+
  private:
   int32_t rows_per_buffer_{kCfgRowsPerBuffer};
   int32_t num_parallel_workers_{kCfgParallelWorkers};
@@ -126,6 +158,10 @@ class ConfigManager {
   int32_t op_connector_size_{kCfgOpConnectorSize};
   uint32_t seed_{kCfgDefaultSeed};
   uint32_t monitor_sampling_interval_{kCfgMonitorSamplingInterval};
+  bool enable_autotune_{kCfgAutoTuneEnable};
+  int64_t autotune_steps_{kCfgAutoTuneSteps};
+  bool out_of_order_{kCfgOutOfOrder};
+  int32_t reorder_window_{kCfgReorderWindow};
 
   // Private helper function that taks a nlohmann json format and populates the settings
   // @param j - The json nlohmann json info
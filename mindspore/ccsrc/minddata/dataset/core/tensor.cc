@@ -53,6 +53,28 @@ namespace dataset {
     break;                                                                                      \
   }
 
+namespace {
+// pools reserved by Tensor::ReserveAllocation, each one serves the first numeric buffer of its length
+thread_local std::vector<std::pair<dsize_t, std::shared_ptr<MemoryPool>>> reserved_allocations;
+
+std::shared_ptr<MemoryPool> TakeReservedAllocation(dsize_t length) {
+  for (auto it = reserved_allocations.begin(); it != reserved_allocations.end(); ++it) {
+    if (it->first == length) {
+      auto pool = std::move(it->second);
+      reserved_allocations.erase(it);
+      return pool;
+    }
+  }
+  return nullptr;
+}
+}  // namespace
+
+void Tensor::ReserveAllocation(const std::shared_ptr<MemoryPool> &pool, dsize_t length) {
+  reserved_allocations.emplace_back(length, pool);
+}
+
+void Tensor::ClearReservedAllocations() { reserved_allocations.clear(); }
+
 Tensor::Tensor(const TensorShape &shape, const DataType &type) : shape_(shape), type_(type), data_(nullptr) {
   // grab the mem pool from global context and create the allocator for char data area
   std::shared_ptr<MemoryPool> global_pool = GlobalContext::Instance()->mem_pool();
@@ -132,6 +154,22 @@ Status Tensor::CreateFromMemory(const TensorShape &shape, const DataType &type,
   return Status::OK();
 }
 
+Status Tensor::CreateViewFromMemory(const TensorShape &shape, const DataType &type, uchar *src, const dsize_t &length,
+                                    const std::shared_ptr<MemoryPool> &pool, TensorPtr *out) {
+  CHECK_FAIL_RETURN_UNEXPECTED(src != nullptr, "Pointer to source data is null.");
+  RETURN_UNEXPECTED_IF_NULL(pool);
+  CHECK_FAIL_RETURN_UNEXPECTED(type.IsNumeric(), "Only a numeric tensor can be created over existing memory.");
+  CHECK_FAIL_RETURN_UNEXPECTED(reinterpret_cast<uintptr_t>(src) % type.SizeInBytes() == 0,
+                               "Source data is not aligned to the type of the tensor.");
+  const TensorAlloc *alloc = GlobalContext::Instance()->tensor_allocator();
+  *out = std::allocate_shared<Tensor>(*alloc, shape, type);
+  CHECK_FAIL_RETURN_UNEXPECTED((*out)->SizeInBytes() == length, "Length of source data does not match the shape.");
+  (*out)->data_allocator_ = std::make_unique<Allocator<unsigned char>>(pool);
+  (*out)->data_ = src;
+  (*out)->data_end_ = src + length;
+  return Status::OK();
+}
+
 #ifdef ENABLE_PYTHON
 Status Tensor::CreateFromNpString(py::array arr, std::shared_ptr<Tensor> *out) {
   std::vector<dsize_t> shape;
@@ -444,6 +482,12 @@ void Tensor::Print(std::ostream &out) const {
 Status Tensor::AllocateBuffer(const dsize_t &length) {
   RETURN_UNEXPECTED_IF_NULL(data_allocator_);
   if (data_ == nullptr) {
+    if (!reserved_allocations.empty() && type_.IsNumeric()) {
+      auto pool = TakeReservedAllocation(length);
+      if (pool != nullptr) {
+        data_allocator_ = std::make_unique<Allocator<unsigned char>>(pool);
+      }
+    }
     data_ = data_allocator_->allocate(length);
     CHECK_FAIL_RETURN_UNEXPECTED(data_ != nullptr, "Failed to allocate memory for tensor.");
     data_end_ = data_ + length;
@@ -55,6 +55,7 @@ class DETensor;
 #endif
 namespace dataset {
 class Tensor;
+class MemoryPool;
 template <typename T>
 class Allocator;
 
@@ -110,6 +111,18 @@ class Tensor {
   static Status CreateFromMemory(const TensorShape &shape, const DataType &type, const uchar *src,
                                  const dsize_t &length, TensorPtr *out);
 
+  /// Create a numeric tensor over memory owned by `pool` without copying. The tensor keeps `pool` alive through its
+  /// allocator and hands `src` back to `pool` when it is destroyed.
+  /// \param[in] shape shape of the output tensor
+  /// \param[in] type type of the output tensor, must be numeric
+  /// \param[in] src pointer to the source data, aligned to the size of the type
+  /// \param[in] length length of the src data
+  /// \param[in] pool memory pool that owns the src data
+  /// \param[out] out Generated tensor
+  /// \return Status code
+  static Status CreateViewFromMemory(const TensorShape &shape, const DataType &type, uchar *src, const dsize_t &length,
+                                     const std::shared_ptr<MemoryPool> &pool, TensorPtr *out);
+
   /// Create a copy of the input tensor
   /// \param[in] in original tensor to be copied
   /// \param[out] out output tensor to be generated
@@ -118,6 +131,15 @@ class Tensor {
     return CreateFromMemory(in->shape(), in->type(), in->GetBuffer(), in->SizeInBytes(), out);
   }
 
+  /// Serve the next numeric buffer of exactly `length` bytes allocated by a Tensor on the calling thread from `pool`.
+  /// MapOp uses it to let the last TensorOp write its output straight into the slot of a batch buffer.
+  /// \param[in] pool memory pool the buffer is taken from, it is kept alive by the allocator of the tensor
+  /// \param[in] length size of the buffer in bytes
+  static void ReserveAllocation(const std::shared_ptr<MemoryPool> &pool, dsize_t length);
+
+  /// Drop the reservations of the calling thread which were not taken by any tensor
+  static void ClearReservedAllocations();
+
 #ifdef ENABLE_PYTHON
   /// Create a Tensor from a given py::array
   /// \param[in] arr py::array
@@ -0,0 +1,130 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/batch_slots.h"
+#include <algorithm>
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/core/tensor.h"
+
+namespace mindspore {
+namespace dataset {
+Status BatchSlab::Create(dsize_t row_bytes, int32_t num_rows, std::shared_ptr<BatchSlab> *out) {
+  CHECK_FAIL_RETURN_UNEXPECTED(row_bytes > 0 && num_rows > 0, "Invalid batch slab size.");
+  std::shared_ptr<MemoryPool> pool = GlobalContext::Instance()->mem_pool();
+  void *data = nullptr;
+  RETURN_IF_NOT_OK(pool->Allocate(row_bytes * num_rows, &data));
+  *out = std::make_shared<BatchSlab>(pool, reinterpret_cast<uchar *>(data), row_bytes, num_rows);
+  return Status::OK();
+}
+
+BatchSlab::BatchSlab(std::shared_ptr<MemoryPool> pool, uchar *data, dsize_t row_bytes, int32_t num_rows)
+    : pool_(std::move(pool)), data_(data), row_bytes_(row_bytes), num_rows_(num_rows) {}
+
+BatchSlab::~BatchSlab() { pool_->Deallocate(data_); }
+
+SlabRegion::SlabRegion(std::shared_ptr<BatchSlab> slab, uchar *begin, dsize_t size)
+    : slab_(std::move(slab)),
+      fallback_(GlobalContext::Instance()->mem_pool()),
+      begin_(begin),
+      size_(size),
+      taken_(false) {}
+
+Status SlabRegion::Allocate(size_t n, void **p) {
+  if (!taken_ && n == static_cast<size_t>(size_)) {
+    taken_ = true;
+    *p = begin_;
+    return Status::OK();
+  }
+  return fallback_->Allocate(n, p);
+}
+
+Status SlabRegion::Reallocate(void **p, size_t old_sz, size_t new_sz) {
+  CHECK_FAIL_RETURN_UNEXPECTED(*p != begin_, "A slab region can not be reallocated.");
+  return fallback_->Reallocate(p, old_sz, new_sz);
+}
+
+void SlabRegion::Deallocate(void *p) {
+  // the region is released together with the slab
+  if (p != begin_) {
+    fallback_->Deallocate(p);
+  }
+}
+
+void BatchSlots::SetRowBytes(const std::vector<dsize_t> &row_bytes) {
+  std::lock_guard<std::mutex> lock(mux_);
+  if (row_bytes_.empty()) {
+    row_bytes_ = row_bytes;
+  }
+}
+
+void BatchSlots::DisableColumn(size_t col) {
+  std::lock_guard<std::mutex> lock(mux_);
+  if (col < row_bytes_.size()) {
+    row_bytes_[col] = 0;
+  }
+}
+
+bool BatchSlots::HasRowBytes() const {
+  std::lock_guard<std::mutex> lock(mux_);
+  return !row_bytes_.empty();
+}
+
+Status BatchSlots::ReserveRow(int64_t epoch, int64_t row_id) {
+  Tensor::ClearReservedAllocations();
+  std::vector<std::shared_ptr<BatchSlab>> slabs;
+  {
+    std::lock_guard<std::mutex> lock(mux_);
+    if (std::all_of(row_bytes_.begin(), row_bytes_.end(), [](dsize_t bytes) { return bytes == 0; })) {
+      return Status::OK();
+    }
+    auto &batch = batches_[std::make_pair(epoch, row_id / batch_size_)];
+    batch.resize(row_bytes_.size());
+    for (size_t col = 0; col < row_bytes_.size(); col++) {
+      if (row_bytes_[col] == 0) {
+        continue;
+      }
+      if (batch[col] == nullptr) {
+        RETURN_IF_NOT_OK(BatchSlab::Create(row_bytes_[col], batch_size_, &batch[col]));
+      }
+    }
+    slabs = batch;
+  }
+  dsize_t slot = row_id % batch_size_;
+  for (auto &slab : slabs) {
+    if (slab != nullptr) {
+      Tensor::ReserveAllocation(std::make_shared<SlabRegion>(slab, slab->Slot(slot), slab->row_bytes()),
+                                slab->row_bytes());
+    }
+  }
+  return Status::OK();
+}
+
+std::vector<std::shared_ptr<BatchSlab>> BatchSlots::TakeBatch(int64_t epoch, int64_t batch_id) {
+  std::lock_guard<std::mutex> lock(mux_);
+  auto it = batches_.find(std::make_pair(epoch, batch_id));
+  if (it == batches_.end()) {
+    return {};
+  }
+  auto slabs = std::move(it->second);
+  batches_.erase(it);
+  return slabs;
+}
+
+void BatchSlots::DropEpochsBefore(int64_t epoch) {
+  std::lock_guard<std::mutex> lock(mux_);
+  batches_.erase(batches_.begin(), batches_.lower_bound(std::make_pair(epoch, int64_t(0))));
+}
+}  // namespace dataset
+}  // namespace mindspore
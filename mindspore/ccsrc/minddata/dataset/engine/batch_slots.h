@@ -0,0 +1,123 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_BATCH_SLOTS_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_BATCH_SLOTS_H_
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include "minddata/dataset/core/constants.h"
+#include "minddata/dataset/util/memory_pool.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Contiguous memory holding one column of a whole batch, row j lives in slot j.
+class BatchSlab {
+ public:
+  /// \brief Allocate a slab from the global memory pool.
+  /// \param[in] row_bytes Bytes of one row of the column
+  /// \param[in] num_rows Number of slots
+  /// \param[out] out The slab
+  /// \return Status
+  static Status Create(dsize_t row_bytes, int32_t num_rows, std::shared_ptr<BatchSlab> *out);
+
+  BatchSlab(std::shared_ptr<MemoryPool> pool, uchar *data, dsize_t row_bytes, int32_t num_rows);
+
+  ~BatchSlab();
+
+  uchar *Slot(dsize_t row) const { return data_ + row * row_bytes_; }
+
+  dsize_t row_bytes() const { return row_bytes_; }
+
+  bool Contains(const uchar *ptr) const { return ptr >= data_ && ptr < data_ + row_bytes_ * num_rows_; }
+
+ private:
+  std::shared_ptr<MemoryPool> pool_;
+  uchar *data_;
+  dsize_t row_bytes_;
+  int32_t num_rows_;
+};
+
+/// \brief A MemoryPool handing out a fixed region of a slab to the one Tensor the region is reserved for. The Tensor
+///     keeps the slab alive through its allocator, any other allocation is served by the global memory pool.
+class SlabRegion : public MemoryPool {
+ public:
+  SlabRegion(std::shared_ptr<BatchSlab> slab, uchar *begin, dsize_t size);
+
+  ~SlabRegion() override = default;
+
+  Status Allocate(size_t n, void **p) override;
+
+  Status Reallocate(void **p, size_t old_sz, size_t new_sz) override;
+
+  void Deallocate(void *p) override;
+
+  uint64_t get_max_size() const override { return size_; }
+
+  int PercentFree() const override { return taken_ ? 0 : 100; }
+
+ private:
+  std::shared_ptr<BatchSlab> slab_;
+  std::shared_ptr<MemoryPool> fallback_;
+  uchar *begin_;
+  dsize_t size_;
+  bool taken_;
+};
+
+/// \brief Batch buffers shared by a BatchOp and the MapOp feeding it. Map workers reserve slot j of the batch a row
+///     belongs to before the last TensorOp runs on the row, so the op writes its output straight into the batch and
+///     BatchOp only has to wrap the slab into the batched tensor instead of copying every row.
+class BatchSlots {
+ public:
+  explicit BatchSlots(int32_t batch_size) : batch_size_(batch_size) {}
+
+  ~BatchSlots() = default;
+
+  /// \brief Set the bytes of one row of every column once known, 0 disables the slots of a column.
+  void SetRowBytes(const std::vector<dsize_t> &row_bytes);
+
+  /// \brief Stop reserving slots for a column, e.g. because its rows never end up in their slots.
+  void DisableColumn(size_t col);
+
+  bool HasRowBytes() const;
+
+  /// \brief Reserve the slots of a row for the next tensor allocations on the calling thread.
+  /// \param[in] epoch Epoch of the row, counted in eoe buffers
+  /// \param[in] row_id Row index inside the epoch
+  /// \return Status
+  Status ReserveRow(int64_t epoch, int64_t row_id);
+
+  /// \brief Remove the slabs of a batch, one per column and nullptr where no slot was reserved.
+  /// \param[in] epoch Epoch of the batch
+  /// \param[in] batch_id Batch index inside the epoch
+  /// \return The slabs, empty if no row of the batch reserved its slot
+  std::vector<std::shared_ptr<BatchSlab>> TakeBatch(int64_t epoch, int64_t batch_id);
+
+  /// \brief Release the slabs of batches that never got batched, e.g. dropped remainders of previous epochs.
+  void DropEpochsBefore(int64_t epoch);
+
+ private:
+  int32_t batch_size_;
+  mutable std::mutex mux_;
+  std::vector<dsize_t> row_bytes_;
+  std::map<std::pair<int64_t, int64_t>, std::vector<std::shared_ptr<BatchSlab>>> batches_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_BATCH_SLOTS_H_
@@ -23,13 +23,24 @@
 
 namespace mindspore {
 namespace dataset {
+CacheSharedBlock::~CacheSharedBlock() {
+  // We won't wait for the result for the sake of performance.
+  auto mfree_req = std::make_shared<FreeSharedBlockRequest>(connection_id_, addr_);
+  Status rc = comm_->HandleRequest(mfree_req);
+  if (rc.IsError()) {
+    MS_LOG(WARNING) << "Failed to free shared memory block " << addr_ << ". " << rc.ToString();
+  }
+}
 
 // Constructor
 CacheClient::CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool spill, std::string hostname,
-                         int32_t port, int32_t num_workers, int32_t prefetch_size)
+                         int32_t port, int32_t num_workers, int32_t prefetch_size, CachePool::EvictPolicy evict_policy,
+                         bool compress)
     : server_connection_id_(0),
       cache_mem_sz_(cache_mem_sz),
       spill_(spill),
+      evict_policy_(evict_policy),
+      compress_(compress),
       local_bypass_(false),
       hostname_(std::move(hostname)),
       port_(port),
@@ -43,7 +54,9 @@ CacheClient::CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool
 void CacheClient::Print(std::ostream &out) const {
   out << "  Session id: " << session_id() << "\n  Cache crc: " << cinfo_.crc()
       << "\n  Server cache id: " << server_connection_id_ << "\n  Cache mem size: " << getCacheMemSz()
-      << "\n  Spilling: " << std::boolalpha << isSpill() << "\n  Hostname: " << getHostname()
+      << "\n  Spilling: " << std::boolalpha << isSpill()
+      << "\n  Eviction policy: " << static_cast<int>(getEvictPolicy()) << "\n  Compression: " << isCompress()
+      << "\n  Hostname: " << getHostname()
       << "\n  Port: " << getPort() << "\n  Number of rpc workers: " << getNumWorkers()
       << "\n  Prefetch size: " << getPrefetchSize() << "\n  Local client support: " << std::boolalpha
       << SupportLocalClient();
@@ -86,18 +99,13 @@ Status CacheClient::GetRows(const std::vector<row_id_type> &row_id, TensorTable
   auto rq = std::make_shared<BatchFetchRequest>(server_connection_id_, row_id, SupportLocalClient());
   RETURN_IF_NOT_OK(PushRequest(rq));
   RETURN_IF_NOT_OK(rq->Wait());
-  int64_t mem_addr;
-  Status rc = rq->RestoreRows(out, comm_->SharedMemoryBaseAddr(), &mem_addr);
-  // Free the memory by sending a request back to the server.
+  std::shared_ptr<MemoryPool> block;
+  auto mem_addr = rq->GetSharedBlockOffset();
   if (mem_addr != -1) {
-    auto mfree_req = std::make_shared<FreeSharedBlockRequest>(server_connection_id_, mem_addr);
-    Status rc2 = PushRequest(mfree_req);
-    // But we won't wait for the result for the sake of performance.
-    if (rc.IsOk() && rc2.IsError()) {
-      rc = rc2;
-    }
+    // Tensors are views into the shared memory. The block goes back to the server when they are all gone.
+    block = std::make_shared<CacheSharedBlock>(comm_, server_connection_id_, mem_addr);
   }
-  return rc;
+  return rq->RestoreRows(out, comm_->SharedMemoryBaseAddr(), block);
 }
 
 Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
@@ -145,10 +153,14 @@ Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
     if (generate_id) {
       createFlag |= CreateCacheRequest::CreateCacheFlag::kGenerateRowId;
     }
+    if (compress_) {
+      createFlag |= CreateCacheRequest::CreateCacheFlag::kCompress;
+    }
     // Start the comm layer to receive reply
     RETURN_IF_NOT_OK(comm_->ServiceStart());
     // Initiate connection
-    auto rq = std::make_shared<CreateCacheRequest>(cinfo_, cache_mem_sz_, createFlag);
+    auto rq = std::make_shared<CreateCacheRequest>(cinfo_, cache_mem_sz_, createFlag,
+                                                   static_cast<uint8_t>(evict_policy_));
     RETURN_IF_NOT_OK(PushRequest(rq));
     Status rc = rq->Wait();
     if (rc.IsOk() || rc.get_code() == StatusCode::kDuplicateKey) {
@@ -30,10 +30,39 @@
 #include "minddata/dataset/engine/cache/stub/cache_grpc_client.h"
 #endif
 #include "minddata/dataset/engine/data_buffer.h"
+#include "minddata/dataset/util/cache_pool.h"
 #include "minddata/dataset/util/lock.h"
 
 namespace mindspore {
 namespace dataset {
+/// \brief A block of the server shared memory that holds the rows of one BatchFetchRequest.
+/// Tensors restored from the block are views into it and keep it alive through their allocators. The block is
+/// given back to the server when the last of them is gone.
+class CacheSharedBlock : public MemoryPool {
+ public:
+  CacheSharedBlock(std::shared_ptr<CacheClientGreeter> comm, connection_id_type connection_id, int64_t addr)
+      : comm_(std::move(comm)), connection_id_(connection_id), addr_(addr) {}
+
+  ~CacheSharedBlock() override;
+
+  /// Tensors never allocate from the block. They are placed on it by Tensor::CreateViewFromMemory.
+  Status Allocate(size_t, void **) override { RETURN_STATUS_UNEXPECTED("Not supported"); }
+
+  Status Reallocate(void **, size_t old_sz, size_t new_sz) override { RETURN_STATUS_UNEXPECTED("Not supported"); }
+
+  /// The whole block is freed at once when the last tensor is destroyed.
+  void Deallocate(void *) override {}
+
+  uint64_t get_max_size() const override { return 0; }
+
+  int PercentFree() const override { return 0; }
+
+ private:
+  std::shared_ptr<CacheClientGreeter> comm_;
+  connection_id_type connection_id_;
+  int64_t addr_;
+};
+
 /// \brief A CacheClient is a bridge between a DatasetOp and a CacheServer. All communications are through
 /// a CacheClient. Typical tasks including like creating a cache service, cache a data buffer, restore a previously
 /// rows, etc.
@@ -44,7 +73,15 @@ class CacheClient {
   /// \brief A builder to help creating a CacheClient object
   class Builder {
    public:
-    Builder() : session_id_(0), cache_mem_sz_(0), spill_(false), port_(0), num_workers_(0), prefetch_size_(0) {
+    Builder()
+        : session_id_(0),
+          cache_mem_sz_(0),
+          spill_(false),
+          evict_policy_(CachePool::EvictPolicy::kNone),
+          compress_(false),
+          port_(0),
+          num_workers_(0),
+          prefetch_size_(0) {
       std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
       hostname_ = "127.0.0.1";
       port_ = 50052;
@@ -76,6 +113,22 @@ class CacheClient {
       return *this;
     }
 
+    /// Setter function to set the eviction policy when the cache memory is full
+    /// \param evict_policy
+    /// \return Builder object itself
+    Builder &SetEvictPolicy(CachePool::EvictPolicy evict_policy) {
+      evict_policy_ = evict_policy;
+      return *this;
+    }
+
+    /// Setter function to compress the cached rows
+    /// \param compress
+    /// \return Builder object itself
+    Builder &SetCompress(bool compress) {
+      compress_ = compress;
+      return *this;
+    }
+
     /// Setter function to set rpc hostname
     /// \param host
     /// \return Builder object itself
@@ -112,6 +165,8 @@ class CacheClient {
     session_id_type getSessionId() const { return session_id_; }
     uint64_t getCacheMemSz() const { return cache_mem_sz_; }
     bool isSpill() const { return spill_; }
+    CachePool::EvictPolicy getEvictPolicy() const { return evict_policy_; }
+    bool isCompress() const { return compress_; }
     const std::string &getHostname() const { return hostname_; }
     int32_t getPort() const { return port_; }
     int32_t getNumWorkers() const { return num_workers_; }
@@ -130,7 +185,7 @@ class CacheClient {
       RETURN_UNEXPECTED_IF_NULL(out);
       RETURN_IF_NOT_OK(SanityCheck());
       *out = std::make_shared<CacheClient>(session_id_, cache_mem_sz_, spill_, hostname_, port_, num_workers_,
-                                           prefetch_size_);
+                                           prefetch_size_, evict_policy_, compress_);
       return Status::OK();
     }
 
@@ -138,6 +193,8 @@ class CacheClient {
     session_id_type session_id_;
     uint64_t cache_mem_sz_;
     bool spill_;
+    CachePool::EvictPolicy evict_policy_;
+    bool compress_;
     std::string hostname_;
     int32_t port_;
     int32_t num_workers_;
@@ -148,11 +205,15 @@ class CacheClient {
   /// \param session_id A user assigned session id for the current pipeline
   /// \param cache_mem_sz Size of the memory set aside for the row caching. 0 for unlimited
   /// \param spill Spill to disk if out of memory
+  /// \param evict_policy Which rows to move out of memory when the memory is full
+  /// \param compress Compress the rows cached by the server
   CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool spill, std::string hostname, int32_t port,
-              int32_t num_workers, int32_t prefetch_size);
+              int32_t num_workers, int32_t prefetch_size,
+              CachePool::EvictPolicy evict_policy = CachePool::EvictPolicy::kNone, bool compress = false);
 
   /// \brief Destructor
-  ~CacheClient() { (void)comm_->ServiceStop(); }
+  /// \note The comm layer is stopped when the last tensor fetched through the shared memory is gone.
+  ~CacheClient() = default;
 
   /// \brief Send a TensorRow to the cache server
   /// \param[in] row
@@ -237,6 +298,8 @@ class CacheClient {
   session_id_type session_id() const { return cinfo_.session_id(); }
   uint64_t getCacheMemSz() const { return cache_mem_sz_; }
   bool isSpill() const { return spill_; }
+  CachePool::EvictPolicy getEvictPolicy() const { return evict_policy_; }
+  bool isCompress() const { return compress_; }
   const std::string &getHostname() const { return hostname_; }
   int32_t getPort() const { return port_; }
   int32_t getNumWorkers() const { return num_workers_; }
@@ -246,6 +309,8 @@ class CacheClient {
   mutable RWLock mux_;
   uint64_t cache_mem_sz_;
   bool spill_;
+  CachePool::EvictPolicy evict_policy_;
+  bool compress_;
   // The session_id_ and cache_crc_ work together to uniquely identify this particular cache and allow
   // sharing of the cache.
   CacheClientInfo cinfo_;
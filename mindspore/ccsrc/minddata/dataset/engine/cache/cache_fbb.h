@@ -24,6 +24,7 @@
 #include <vector>
 #include "minddata/dataset/engine/cache/de_tensor_generated.h"
 #include "minddata/dataset/core/tensor_row.h"
+#include "minddata/dataset/util/memory_pool.h"
 #include "minddata/dataset/util/slice.h"
 #include "minddata/dataset/util/status.h"
 
@@ -39,8 +40,11 @@ Status SerializeTensorRowHeader(const TensorRow &row, std::shared_ptr<flatbuffer
 /// \param col_ts A serialized version of Tensor meta data
 /// \param data Tensor data wrapped in a slice
 /// \param out Tensor
+/// \param pool If not null, a numeric tensor whose data is suitably aligned becomes a view into the memory of the
+///        slice, which is owned by this pool. Otherwise the data is copied.
 /// \return Status object
-Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data, std::shared_ptr<Tensor> *out);
+Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data, std::shared_ptr<Tensor> *out,
+                        const std::shared_ptr<MemoryPool> &pool = nullptr);
 }  // namespace dataset
 }  // namespace mindspore
 #endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_FBB_H_
@@ -111,6 +111,11 @@ Status CacheClientGreeter::DoServiceStop() {
 }
 
 Status CacheClientGreeter::HandleRequest(std::shared_ptr<BaseRequest> rq) {
+  // Hold off the shutdown of the queue while the call is made.
+  SharedLock lck(&state_lock_);
+  if (state_ == STATE::kStopInProg || state_ == STATE::kStopped) {
+    RETURN_STATUS_UNEXPECTED("Cache client is stopped");
+  }
   auto tag = std::make_unique<CacheClientRequestTag>(std::move(rq));
   return tag->MakeCall(stub_.get(), &cq_, std::move(tag));
 }
@@ -133,23 +133,26 @@ BatchFetchRequest::BatchFetchRequest(connection_id_type connection_id, const std
   rq_.add_buf_data(fbb.GetBufferPointer(), fbb.GetSize());
 }
 
-Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr, int64_t *out_addr) {
-  RETURN_UNEXPECTED_IF_NULL(out);
-  auto num_elements = row_id_.size();
-  const char *ptr = nullptr;
-  int64_t sz = 0;
+int64_t BatchFetchRequest::GetSharedBlockOffset() const {
   // Tap into the reply flag to see where we can find the data. Server may decide the amount is
   // so small that it doesn't use shared memory method.
   auto flag = reply_.flag();
   bool dataOnSharedMemory = support_local_bypass_ ? (BitTest(flag, kDataIsInSharedMemory)) : false;
-  if (dataOnSharedMemory) {
-    auto addr = strtoll(reply_.result().data(), nullptr, 10);
+  return dataOnSharedMemory ? strtoll(reply_.result().data(), nullptr, 10) : -1;
+}
+
+Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr,
+                                      const std::shared_ptr<MemoryPool> &block) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  auto num_elements = row_id_.size();
+  const char *ptr = nullptr;
+  int64_t sz = 0;
+  auto addr = GetSharedBlockOffset();
+  if (addr != -1) {
+    RETURN_UNEXPECTED_IF_NULL(baseAddr);
     ptr = reinterpret_cast<const char *>(reinterpret_cast<int64_t>(baseAddr) + addr);
-    RETURN_UNEXPECTED_IF_NULL(out);
-    *out_addr = addr;
   } else {
     ptr = reply_.result().data();
-    *out_addr = -1;
   }
   auto *offset_array = reinterpret_cast<const int64_t *>(ptr);
   sz = offset_array[num_elements];
@@ -173,7 +176,7 @@ Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr, in
         auto col_ts = msg->column()->Get(k);
         std::shared_ptr<Tensor> ts;
         ReadableSlice data(row_data, ts_offset, msg->data_sz()->Get(k));
-        RETURN_IF_NOT_OK(mindspore::dataset::RestoreOneTensor(col_ts, data, &ts));
+        RETURN_IF_NOT_OK(mindspore::dataset::RestoreOneTensor(col_ts, data, &ts, block));
         row.push_back(ts);
         ts_offset += data.GetSize();
       }
@@ -187,8 +190,8 @@ Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr, in
 }
 
 CreateCacheRequest::CreateCacheRequest(const CacheClientInfo &cinfo, uint64_t cache_mem_sz,
-                                       CreateCacheRequest::CreateCacheFlag flag)
-    : BaseRequest(RequestType::kCreateCache), cache_mem_sz_(cache_mem_sz), flag_(flag) {
+                                       CreateCacheRequest::CreateCacheFlag flag, uint8_t evict_policy)
+    : BaseRequest(RequestType::kCreateCache), cache_mem_sz_(cache_mem_sz), flag_(flag), evict_policy_(evict_policy) {
   // Type has been set already in the base constructor. So we need to fill in the connection info.
   // On successful return, we will get the connection id
   rq_.mutable_connection_info()->operator=(cinfo);
@@ -200,6 +203,7 @@ Status CreateCacheRequest::Prepare() {
     CreateCacheRequestMsgBuilder bld(fbb);
     bld.add_cache_mem_sz(cache_mem_sz_);
     bld.add_flag(static_cast<uint32_t>(flag_));
+    bld.add_evict_policy(evict_policy_);
     auto off = bld.Finish();
     fbb.Finish(off);
     rq_.add_buf_data(fbb.GetBufferPointer(), fbb.GetSize());
@@ -248,6 +252,11 @@ Status GetStatRequest::PostReply() {
   stat_.max_row_id = msg->max_row_id();
   stat_.min_row_id = msg->min_row_id();
   stat_.cache_service_state = msg->state();
+  stat_.num_compressed = msg->num_compressed();
+  stat_.num_evicted = msg->num_evicted();
+  stat_.num_mem_hit = msg->num_mem_hit();
+  stat_.num_disk_hit = msg->num_disk_hit();
+  stat_.num_miss = msg->num_miss();
   return Status::OK();
 }
 }  // namespace dataset
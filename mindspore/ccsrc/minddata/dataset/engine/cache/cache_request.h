@@ -30,6 +30,7 @@
 #include "proto/cache_grpc.pb.h"
 #include "minddata/dataset/core/tensor_row.h"
 #include "minddata/dataset/engine/cache/de_tensor_generated.h"
+#include "minddata/dataset/util/memory_pool.h"
 #include "minddata/dataset/util/slice.h"
 #include "minddata/dataset/util/wait_post.h"
 
@@ -44,6 +45,11 @@ struct CacheServiceStat {
   row_id_type min_row_id;
   row_id_type max_row_id;
   int8_t cache_service_state;
+  int64_t num_compressed;
+  int64_t num_evicted;
+  int64_t num_mem_hit;
+  int64_t num_disk_hit;
+  int64_t num_miss;
 };
 
 /// \brief CacheClient communicates with CacheServer using Requests.
@@ -184,7 +190,18 @@ class BatchFetchRequest : public BaseRequest {
   friend class CacheService;
   BatchFetchRequest(connection_id_type connection_id, const std::vector<row_id_type> &row_id, bool local_bypass);
   ~BatchFetchRequest() = default;
-  Status RestoreRows(TensorTable *out, const void *baseAddr, int64_t *out_addr);
+
+  /// \brief Offset of the block in the shared memory holding the rows of the reply
+  /// \return -1 if the server sends the rows back in the reply
+  int64_t GetSharedBlockOffset() const;
+
+  /// \brief Deserialize the rows of the reply
+  /// \param out Restored rows
+  /// \param baseAddr Base address of the shared memory
+  /// \param block Owner of the shared memory block, see GetSharedBlockOffset. Numeric tensors restored from the
+  ///        block are views into it and keep it alive. Null if the rows are in the reply.
+  /// \return Status object
+  Status RestoreRows(TensorTable *out, const void *baseAddr, const std::shared_ptr<MemoryPool> &block);
 
  private:
   bool support_local_bypass_;
@@ -195,14 +212,20 @@ class BatchFetchRequest : public BaseRequest {
 class CreateCacheRequest : public BaseRequest {
  public:
   friend class CacheServer;
-  enum class CreateCacheFlag : uint32_t { kNone = 0, kSpillToDisk = 1, kGenerateRowId = 1u << 1L };
+  enum class CreateCacheFlag : uint32_t {
+    kNone = 0,
+    kSpillToDisk = 1,
+    kGenerateRowId = 1u << 1L,
+    kCompress = 1u << 2L
+  };
 
   /// \brief Constructor
   /// \param connection_id
   /// \param cache_mem_sz Maximum memory assigned for this connection. 0 means unlimited
   /// \param flag Attributes of the cache.
+  /// \param evict_policy Eviction policy of the cache, in the value of CachePool::EvictPolicy
   explicit CreateCacheRequest(const CacheClientInfo &cinfo, uint64_t cache_mem_sz,
-                              CreateCacheFlag flag = CreateCacheFlag::kNone);
+                              CreateCacheFlag flag = CreateCacheFlag::kNone, uint8_t evict_policy = 0);
   ~CreateCacheRequest() = default;
   void ParseResult(connection_id_type *id, std::string *out) {
     auto p = flatbuffers::GetRoot<CreateCacheReplyMsg>(reply_.result().data());
@@ -216,6 +239,7 @@ class CreateCacheRequest : public BaseRequest {
  private:
   uint64_t cache_mem_sz_;
   CreateCacheFlag flag_;
+  uint8_t evict_policy_;
 };
 
 /// \brief Request to purge a cache.
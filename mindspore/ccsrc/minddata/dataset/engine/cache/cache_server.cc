@@ -146,6 +146,12 @@ Status CacheServer::CreateService(CacheRequest *rq, CacheReply *reply) {
     (flag & CreateCacheRequest::CreateCacheFlag::kSpillToDisk) == CreateCacheRequest::CreateCacheFlag::kSpillToDisk;
   bool generate_id =
     (flag & CreateCacheRequest::CreateCacheFlag::kGenerateRowId) == CreateCacheRequest::CreateCacheFlag::kGenerateRowId;
+  bool compress =
+    (flag & CreateCacheRequest::CreateCacheFlag::kCompress) == CreateCacheRequest::CreateCacheFlag::kCompress;
+  auto evict_policy = static_cast<CachePool::EvictPolicy>(p->evict_policy());
+  if (evict_policy > CachePool::EvictPolicy::kLfu) {
+    RETURN_STATUS_UNEXPECTED("Unknown eviction policy " + std::to_string(p->evict_policy()));
+  }
   if (spill && top_.empty()) {
     RETURN_STATUS_UNEXPECTED("Server is not set up with spill support.");
   }
@@ -165,7 +171,7 @@ Status CacheServer::CreateService(CacheRequest *rq, CacheReply *reply) {
   if (it == end) {
     std::unique_ptr<CacheService> cs;
     try {
-      cs = std::make_unique<CacheService>(cache_mem_sz, spill ? top_ : "", generate_id);
+      cs = std::make_unique<CacheService>(cache_mem_sz, spill ? top_ : "", generate_id, evict_policy, compress);
       RETURN_IF_NOT_OK(cs->ServiceStart());
       cookie = cs->cookie();
       all_caches_.emplace(connection_id, std::move(cs));
@@ -293,15 +299,28 @@ Status CacheServer::BatchFetchRows(CacheService *cs, CacheRequest *rq, CacheRepl
     // For large amount data to be sent back, we will use shared memory provided it is a local
     // client that has local bypass support
     bool local_bypass = local_client ? (mem_sz >= kLocalByPassThreshold) : false;
+    auto shared_pool = comm_layer_->GetSharedMemoryPool();
+    void *q = nullptr;
+    if (local_bypass) {
+      // The client holds on to the blocks for as long as the tensors it fetched are alive. When the shared
+      // memory runs out, send the rows back in the reply instead.
+      Status rc = shared_pool->Allocate(mem_sz, &q);
+      if (rc.IsOutofMemory()) {
+        local_bypass = false;
+      } else {
+        RETURN_IF_NOT_OK(rc);
+      }
+    }
     reply->set_flag(local_bypass ? kDataIsInSharedMemory : 0);
     if (local_bypass) {
       // We will use shared memory
-      auto shared_pool = comm_layer_->GetSharedMemoryPool();
       auto *base = shared_pool->SharedMemoryBaseAddr();
-      void *q = nullptr;
-      RETURN_IF_NOT_OK(shared_pool->Allocate(mem_sz, &q));
       WritableSlice dest(q, mem_sz);
-      RETURN_IF_NOT_OK(cs->BatchFetch(row_id, v, &dest));
+      Status rc = cs->BatchFetch(row_id, v, &dest);
+      if (rc.IsError()) {
+        shared_pool->Deallocate(q);
+        return rc;
+      }
       // We can't return the absolute address which makes no sense to the client.
       // Instead we return the difference.
       auto difference = reinterpret_cast<int64_t>(q) - reinterpret_cast<int64_t>(base);
@@ -319,6 +338,8 @@ Status CacheServer::BatchFetchRows(CacheService *cs, CacheRequest *rq, CacheRepl
       }
       WritableSlice dest(mem.data(), mem_sz);
       RETURN_IF_NOT_OK(cs->BatchFetch(row_id, v, &dest));
+      // Rows evicted in the middle of the fetch are sent back empty. Trim the unused space.
+      mem.resize(reinterpret_cast<const int64_t *>(mem.data())[row_id.size()]);
       reply->set_result(std::move(mem));
     }
   }
@@ -341,6 +362,11 @@ inline Status GetStat(CacheService *cs, CacheRequest *rq, CacheReply *reply) {
     bld.add_max_row_id(svc_stat.max_);
     bld.add_min_row_id(svc_stat.min_);
     bld.add_state(svc_stat.state_);
+    bld.add_num_compressed(svc_stat.stat_.num_compressed);
+    bld.add_num_evicted(svc_stat.stat_.num_evicted);
+    bld.add_num_mem_hit(svc_stat.stat_.num_mem_hit);
+    bld.add_num_disk_hit(svc_stat.stat_.num_disk_hit);
+    bld.add_num_miss(svc_stat.num_miss_);
     auto offset = bld.Finish();
     fbb.Finish(offset);
     reply->set_result(fbb.GetBufferPointer(), fbb.GetSize());
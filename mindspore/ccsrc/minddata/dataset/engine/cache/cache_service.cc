@@ -18,15 +18,25 @@
 
 namespace mindspore {
 namespace dataset {
-CacheService::CacheService(uint64_t mem_sz, const std::string &root, bool generate_id)
+CacheService::CacheService(uint64_t mem_sz, const std::string &root, bool generate_id,
+                           CachePool::EvictPolicy policy, bool compress)
     : root_(root),
       cache_mem_sz_(mem_sz),
+      policy_(policy),
+      compress_(compress),
       cp_(nullptr),
       map_(nullptr),
       next_id_(0),
       generate_id_(generate_id),
       schema_key_(-1),
-      st_(generate_id ? State::kBuildPhase : State::kNone) {}
+      st_(generate_id ? State::kBuildPhase : State::kNone),
+      num_miss_(0) {
+  // Rows are dropped from memory if there is nowhere to spill. But a cache with a build phase must keep all the rows.
+  if (policy_ != CachePool::EvictPolicy::kNone && root_.empty() && generate_id_) {
+    MS_LOG(WARNING) << "Eviction without spilling is not supported for a cache with a build phase. It is turned off.";
+    policy_ = CachePool::EvictPolicy::kNone;
+  }
+}
 CacheService::~CacheService() { (void)ServiceStop(); }
 bool CacheService::UseArena() {
   // If fixed size, use Arena instead of the pool from global context.
@@ -44,7 +54,7 @@ Status CacheService::DoServiceStart() {
     mp_ = std::make_shared<SystemPool>();
   }
   // Put together a CachePool for backing up the Tensor
-  cp_ = std::make_shared<CachePool>(CachePool::value_allocator(mp_), root_);
+  cp_ = std::make_shared<CachePool>(CachePool::value_allocator(mp_), root_, policy_, compress_);
   RETURN_IF_NOT_OK(cp_->ServiceStart());
   // Set up the B+ tree as well. But use the system pool instead.
   map_ = std::make_shared<row_map>();
@@ -103,12 +113,7 @@ Status CacheService::CacheRow(const std::vector<const void *> &buf, row_id_type
     // Now we cache the flat buffer.
     CachePool::key_type key;
     RETURN_IF_NOT_OK(cp_->Insert(all_data, &key));
-    Status rc = map_->DoInsert(*row_id_generated, key);
-    if (rc == Status(StatusCode::kDuplicateKey)) {
-      MS_LOG(DEBUG) << "Ignoring duplicate key.";
-    } else {
-      RETURN_IF_NOT_OK(rc);
-    }
+    RETURN_IF_NOT_OK(InsertRow(*row_id_generated, key));
     return Status::OK();
   } catch (const std::exception &e) {
     RETURN_STATUS_UNEXPECTED(e.what());
@@ -142,20 +147,37 @@ Status CacheService::FastCacheRow(const ReadableSlice &src, row_id_type *row_id_
     // Now we cache the flat buffer.
     CachePool::key_type key;
     RETURN_IF_NOT_OK(cp_->Insert({src}, &key));
-    Status rc = map_->DoInsert(*row_id_generated, key);
-    if (rc == Status(StatusCode::kDuplicateKey)) {
-      MS_LOG(DEBUG) << "Ignoring duplicate key.";
-    } else {
-      RETURN_IF_NOT_OK(rc);
-    }
+    RETURN_IF_NOT_OK(InsertRow(*row_id_generated, key));
     return Status::OK();
   } catch (const std::exception &e) {
     RETURN_STATUS_UNEXPECTED(e.what());
   }
 }
+Status CacheService::InsertRow(row_id_type row_id, CachePool::key_type key) {
+  Status rc = map_->DoInsert(row_id, key);
+  if (rc == Status(StatusCode::kDuplicateKey)) {
+    CachePool::key_type old_key = -1;
+    {
+      auto r = map_->Search(row_id);
+      if (r.second) {
+        old_key = r.first.value();
+      }
+    }
+    // A row dropped by the eviction is cached again after the cache miss. Point the row id to the new copy.
+    if (old_key >= 0 && cp_->GetSize(old_key) == 0) {
+      (void)map_->DoUpdate(row_id, key);
+    } else {
+      MS_LOG(DEBUG) << "Ignoring duplicate key.";
+    }
+    return Status::OK();
+  }
+  return rc;
+}
 std::ostream &operator<<(std::ostream &out, const CacheService &cs) {
   // Then show any custom derived-internal stuff
   out << "\nCache memory size: " << cs.cache_mem_sz_;
+  out << "\nEviction policy: " << static_cast<int>(cs.policy_);
+  out << "\nCompression: " << std::boolalpha << cs.compress_;
   out << "\nSpill path: ";
   if (cs.root_.empty()) {
     out << "None";
@@ -173,6 +195,7 @@ Status CacheService::Purge() {
   map_.reset();
   map_ = std::move(new_map);
   next_id_ = 0;
+  num_miss_ = 0;
   RETURN_IF_NOT_OK(cp_->ServiceStart());
   return Status::OK();
 }
@@ -181,6 +204,7 @@ Status CacheService::GetStat(CacheService::ServiceStat *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
   if (st_ == State::kNone || st_ == State::kFetchPhase) {
     out->stat_ = cp_->GetStat();
+    out->num_miss_ = num_miss_;
     out->state_ = static_cast<ServiceStat::state_type>(st_);
     auto it = map_->begin();
     if (it != map_->end()) {
@@ -210,14 +234,21 @@ Status CacheService::PreBatchFetch(const std::vector<row_id_type> &v, std::vecto
       CachePool::key_type key = it.value();
       auto sz = cp_->GetSize(key);
       if (sz == 0) {
-        std::string errMsg = "Key not found: ";
-        errMsg += std::to_string(key);
-        RETURN_STATUS_UNEXPECTED(errMsg);
+        if (cp_->GetEvictPolicy() == CachePool::EvictPolicy::kNone) {
+          std::string errMsg = "Key not found: ";
+          errMsg += std::to_string(key);
+          RETURN_STATUS_UNEXPECTED(errMsg);
+        }
+        // Dropped by the eviction
+        (*out).emplace_back(-1, 0);
+        ++num_miss_;
+        continue;
       }
       (*out).emplace_back(key, sz);
       (*mem_sz) += sz;
     } else {
       (*out).emplace_back(-1, 0);
+      ++num_miss_;
     }
   }
   return Status::OK();
@@ -242,7 +273,14 @@ Status CacheService::BatchFetch(const std::vector<row_id_type> &v, const std::ve
       WritableSlice row_data(*out, offset_array[i], sz);
       auto key = info.at(i).first;
       size_t bytesRead = 0;
-      RETURN_IF_NOT_OK(cp_->Read(key, &row_data, &bytesRead));
+      Status rc = cp_->Read(key, &row_data, &bytesRead);
+      if (rc.get_code() == StatusCode::kFileNotExist) {
+        // Dropped by the eviction after PreBatchFetch. Send back an empty row as a cache miss.
+        offset_array[i + 1] = offset_array[i];
+        ++num_miss_;
+        continue;
+      }
+      RETURN_IF_NOT_OK(rc);
       if (bytesRead != sz) {
         MS_LOG(ERROR) << "Unexpected length. Read " << bytesRead << ". Expected " << sz << "."
                       << " Internal key: " << key << "\n";
@@ -53,7 +53,10 @@ class CacheService : public Service {
   /// \param root Spill path. Empty string means no spilling
   /// \param generate_id If the cache service should generate row id for buffer that is cached.
   /// For non-mappable dataset, this should be set to true.
-  CacheService(uint64_t mem_sz, const std::string &root, bool generate_id);
+  /// \param policy Which rows to move out of memory when the memory is full
+  /// \param compress Compress the rows that are cached
+  CacheService(uint64_t mem_sz, const std::string &root, bool generate_id,
+               CachePool::EvictPolicy policy = CachePool::EvictPolicy::kNone, bool compress = false);
   ~CacheService();
 
   /// \brief For fixed size memory, we will create an Arena.
@@ -97,12 +100,13 @@ class CacheService : public Service {
   class ServiceStat {
    public:
     using state_type = std::underlying_type<State>::type;
-    ServiceStat() : min_(0), max_(0), state_(0) {}
+    ServiceStat() : min_(0), max_(0), state_(0), num_miss_(0) {}
     ~ServiceStat() = default;
     CachePool::CacheStat stat_{};
     row_id_type min_;
     row_id_type max_;
     state_type state_;
+    int64_t num_miss_;
   };
   /// \brief Statistics for the current service
   /// \param[in/out] A pointer to a pre-allocated ServiceStat structure
@@ -141,6 +145,8 @@ class CacheService : public Service {
   mutable RWLock rw_lock_;
   std::string root_;
   uint64_t cache_mem_sz_;
+  CachePool::EvictPolicy policy_;
+  bool compress_;
   std::shared_ptr<CachePool> cp_;
   std::shared_ptr<row_map> map_;
   std::atomic<row_id_type> next_id_;
@@ -148,10 +154,15 @@ class CacheService : public Service {
   std::atomic<CachePool::key_type> schema_key_;
   std::string cookie_;
   State st_;
+  mutable std::atomic<int64_t> num_miss_;
 
   /// \brief Private function to generate a row id
   /// \return Row id assigned.
   row_id_type GetNextRowId() { return next_id_.fetch_add(1); }
+
+  /// \brief Private function to map a row id to the key of the row in the CachePool
+  /// \return Status object
+  Status InsertRow(row_id_type row_id, CachePool::key_type key);
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -174,6 +174,15 @@ class Connector {
     return capacity;
   }
 
+  // Change the capacity of every internal queue while the producers and consumers are running.
+  // @param queue_capacity The new number of element (DataBuffer) for each queue.
+  Status Resize(int32_t queue_capacity) {
+    for (int32_t i = 0; i < queues_.size(); ++i) {
+      RETURN_IF_NOT_OK(queues_[i]->Resize(queue_capacity));
+    }
+    return Status::OK();
+  }
+
   // Register the internal resources with Task group for interruption service.
   // @param vg
   // @return
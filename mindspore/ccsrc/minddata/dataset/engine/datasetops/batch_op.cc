@@ -15,6 +15,7 @@
  */
 #include "minddata/dataset/engine/datasetops/batch_op.h"
 
+#include <algorithm>
 #include <utility>
 #include <iomanip>
 
@@ -24,6 +25,7 @@
 #endif
 #include "minddata/dataset/engine/data_buffer.h"
 #include "minddata/dataset/engine/db_connector.h"
+#include "minddata/dataset/engine/datasetops/map_op/map_op.h"
 #include "minddata/dataset/engine/opt/pass.h"
 #include "minddata/dataset/kernels/data/data_utils.h"
 
@@ -117,6 +119,10 @@ Status BatchOp::operator()() {
     // end of the current epoch, batch_num should start from 0 again
     batch_num = 0;
     epoch_num++;
+    if (batch_slots_ != nullptr) {
+      // workers may still be batching the previous epoch, release what is left of the one before
+      batch_slots_->DropEpochsBefore(epoch_num - 1);
+    }
     RETURN_IF_NOT_OK(
       worker_queues_[cnt++ % num_workers_]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kEOE))));
     RETURN_IF_NOT_OK(GetBatchSize(&cur_batch_size, CBatchInfo(epoch_num, batch_num, cnt - epoch_num)));
@@ -165,36 +171,118 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, const std::u
   TensorRow batched_row;
   auto num_columns = (*src)->front().size();
   for (size_t i = 0; i < num_columns; i++) {
-    std::shared_ptr<Tensor> first_tensor = (*src)->at(0).at(i);  // first row, column i
-    TensorShape first_shape = first_tensor->shape();
-    DataType first_type = first_tensor->type();
-    TensorShape new_shape = first_shape.PrependDim(static_cast<int64_t>(batch_size));
-
     std::shared_ptr<Tensor> new_tensor;
-    if (first_type.IsNumeric()) {  // numeric tensor
-      RETURN_IF_NOT_OK(Tensor::CreateEmpty(new_shape, first_type, &new_tensor));
-      dsize_t j = 0;
-      for (auto row : **src) {
-        std::shared_ptr<Tensor> old_tensor = row.at(i);  // row j, column i
-        if (old_tensor->shape() == first_shape) {        // check the newly popped rows have the same dim as the first
-          if (new_shape.NumOfElements() != 0) {
-            RETURN_IF_NOT_OK(new_tensor->InsertTensor({j++}, old_tensor));
-          }
-          // Don't do anything if the tensor has no data
-        } else {
-          RETURN_STATUS_UNEXPECTED("[Batch ERROR] Inconsistent TensorShapes of Column " + std::to_string(i));
+    RETURN_IF_NOT_OK(BatchColumn(src, i, batch_size, &new_tensor));
+    batched_row.emplace_back(new_tensor);
+  }
+
+  (*dest)->emplace_back(batched_row);
+
+  return Status::OK();
+}
+
+Status BatchOp::BatchColumn(const std::unique_ptr<TensorQTable> *src, size_t col, dsize_t batch_size,
+                            std::shared_ptr<Tensor> *out) {
+  std::shared_ptr<Tensor> first_tensor = (*src)->at(0).at(col);  // first row, column col
+  TensorShape first_shape = first_tensor->shape();
+  DataType first_type = first_tensor->type();
+  TensorShape new_shape = first_shape.PrependDim(static_cast<int64_t>(batch_size));
+
+  std::shared_ptr<Tensor> new_tensor;
+  if (first_type.IsNumeric()) {  // numeric tensor
+    RETURN_IF_NOT_OK(Tensor::CreateEmpty(new_shape, first_type, &new_tensor));
+    dsize_t j = 0;
+    for (auto row : **src) {
+      std::shared_ptr<Tensor> old_tensor = row.at(col);  // row j, column col
+      if (old_tensor->shape() == first_shape) {          // check the newly popped rows have the same dim as the first
+        if (new_shape.NumOfElements() != 0) {
+          RETURN_IF_NOT_OK(new_tensor->InsertTensor({j++}, old_tensor));
         }
+        // Don't do anything if the tensor has no data
+      } else {
+        RETURN_STATUS_UNEXPECTED("[Batch ERROR] Inconsistent TensorShapes of Column " + std::to_string(col));
       }
-    } else {  // handle string column differently
-      std::vector<std::string> strings;
-      for (dsize_t j = 0; j < batch_size; j++) {
-        std::shared_ptr<Tensor> old_tensor = (*src)->at(j).at(i);
-        for (auto itr = old_tensor->begin<std::string_view>(); itr != old_tensor->end<std::string_view>(); itr++) {
-          strings.emplace_back(*itr);
-        }
+    }
+  } else {  // handle string column differently
+    std::vector<std::string> strings;
+    for (dsize_t j = 0; j < batch_size; j++) {
+      std::shared_ptr<Tensor> old_tensor = (*src)->at(j).at(col);
+      for (auto itr = old_tensor->begin<std::string_view>(); itr != old_tensor->end<std::string_view>(); itr++) {
+        strings.emplace_back(*itr);
       }
-      RETURN_IF_NOT_OK(Tensor::CreateFromVector(strings, new_shape, &new_tensor));
     }
+    RETURN_IF_NOT_OK(Tensor::CreateFromVector(strings, new_shape, &new_tensor));
+  }
+  *out = new_tensor;
+  return Status::OK();
+}
+
+Status BatchOp::BatchRowsInSlabs(const std::unique_ptr<TensorQTable> *src, const std::unique_ptr<TensorQTable> *dest,
+                                 const std::vector<std::shared_ptr<BatchSlab>> &slabs) {
+  auto batch_size = static_cast<dsize_t>((*src)->size());
+  auto num_columns = (*src)->front().size();
+  auto in_slot = [&slabs](size_t col, dsize_t row, const uchar *data) {
+    return col < slabs.size() && slabs[col] != nullptr && data == slabs[col]->Slot(row);
+  };
+  // A tensor may have taken the slot reserved for another column of its row. Copy it out before that slot is
+  // overwritten with the row of the other column.
+  for (dsize_t j = 0; j < batch_size; j++) {
+    TensorRow &row = (*src)->at(j);
+    for (size_t i = 0; i < row.size(); i++) {
+      const uchar *data = row[i]->GetBuffer();
+      if (data == nullptr || in_slot(i, j, data)) {
+        continue;
+      }
+      if (std::any_of(slabs.begin(), slabs.end(), [data](const std::shared_ptr<BatchSlab> &slab) {
+            return slab != nullptr && slab->Contains(data);
+          })) {
+        std::shared_ptr<Tensor> in_slab = row[i];
+        RETURN_IF_NOT_OK(Tensor::CreateFromTensor(in_slab, &row[i]));
+      }
+    }
+  }
+
+  TensorRow batched_row;
+  for (size_t i = 0; i < num_columns; i++) {
+    std::shared_ptr<Tensor> first_tensor = (*src)->at(0).at(i);
+    auto slab = i < slabs.size() ? slabs[i] : nullptr;
+    std::shared_ptr<Tensor> new_tensor;
+    if (slab == nullptr || !first_tensor->type().IsNumeric() || first_tensor->SizeInBytes() != slab->row_bytes()) {
+      RETURN_IF_NOT_OK(BatchColumn(src, i, batch_size, &new_tensor));
+      batched_row.emplace_back(new_tensor);
+      continue;
+    }
+    TensorShape first_shape = first_tensor->shape();
+    DataType first_type = first_tensor->type();
+    dsize_t row_bytes = slab->row_bytes();
+    int32_t num_in_slot = 0;
+    for (dsize_t j = 0; j < batch_size; j++) {
+      std::shared_ptr<Tensor> old_tensor = (*src)->at(j).at(i);  // row j, column i
+      if (old_tensor->shape() != first_shape) {
+        RETURN_STATUS_UNEXPECTED("[Batch ERROR] Inconsistent TensorShapes of Column " + std::to_string(i));
+      }
+      CHECK_FAIL_RETURN_UNEXPECTED(old_tensor->type() == first_type,
+                                   "[Batch ERROR] Inconsistent types of Column " + std::to_string(i));
+      if (in_slot(i, j, old_tensor->GetBuffer())) {
+        num_in_slot++;
+        continue;
+      }
+      // the row was not produced by the last map op, fall back to copying it
+      int ret_code = memcpy_s(slab->Slot(j), row_bytes, old_tensor->GetBuffer(), row_bytes);
+      CHECK_FAIL_RETURN_UNEXPECTED(ret_code == 0, "[Batch ERROR] Failed to copy row into batch.");
+    }
+    if (num_in_slot == 0) {
+      // rows of this column never end up in their slots, stop reserving memory for them
+      batch_slots_->DisableColumn(i);
+    }
+    rows_in_slots_ += num_in_slot;
+    // the batched tensor is a view of the slab and keeps it alive
+    dsize_t batch_bytes = row_bytes * batch_size;
+    Tensor::ReserveAllocation(std::make_shared<SlabRegion>(slab, slab->Slot(0), batch_bytes), batch_bytes);
+    Status rc = Tensor::CreateEmpty(first_shape.PrependDim(static_cast<int64_t>(batch_size)), first_type, &new_tensor);
+    Tensor::ClearReservedAllocations();
+    RETURN_IF_NOT_OK(rc);
+    CHECK_FAIL_RETURN_UNEXPECTED(new_tensor->GetBuffer() == slab->Slot(0), "[Batch ERROR] Failed to wrap batch slab.");
     batched_row.emplace_back(new_tensor);
   }
 
@@ -203,6 +291,19 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, const std::u
   return Status::OK();
 }
 
+void BatchOp::LearnRowBytes(const std::unique_ptr<TensorQTable> &table) {
+  std::vector<dsize_t> row_bytes;
+  for (size_t i = 0; i < table->front().size(); i++) {
+    const auto &first_tensor = table->front().at(i);
+    bool fixed_shape = first_tensor->type().IsNumeric();
+    for (const auto &row : *table) {
+      fixed_shape = fixed_shape && row.at(i)->shape() == first_tensor->shape();
+    }
+    row_bytes.push_back(fixed_shape ? first_tensor->SizeInBytes() : 0);
+  }
+  batch_slots_->SetRowBytes(row_bytes);
+}
+
 Status BatchOp::WorkerEntry(int32_t workerId) {
   TaskManager::FindMe()->Post();
   std::pair<std::unique_ptr<TensorQTable>, CBatchInfo> table_pair;
@@ -214,7 +315,10 @@ Status BatchOp::WorkerEntry(int32_t workerId) {
       RETURN_IF_NOT_OK(out_connector_->Add(workerId, std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF)));
     } else if (table_pair.second.ctrl_ == batchCtrl::kNoCtrl) {
       std::unique_ptr<DataBuffer> db = nullptr;
-      RETURN_IF_NOT_OK(MakeBatchedBuffer(std::move(table_pair), &db));
+      RETURN_IF_NOT_OK(AcquireWorkerSlot());
+      Status rc = MakeBatchedBuffer(std::move(table_pair), &db);
+      ReleaseWorkerSlot();
+      RETURN_IF_NOT_OK(rc);
       RETURN_IF_NOT_OK(out_connector_->Add(workerId, std::move(db)));
     }
     RETURN_IF_NOT_OK(worker_queues_[workerId]->PopFront(&table_pair));
@@ -231,7 +335,18 @@ Status BatchOp::MakeBatchedBuffer(std::pair<std::unique_ptr<TensorQTable>, CBatc
   if (pad_) RETURN_IF_NOT_OK(PadColumns(&table_pair.first, pad_info_, column_name_id_map_));  // do padding if needed
   (*db) = std::make_unique<DataBuffer>(table_pair.second.batch_num_, DataBuffer::kDeBFlagNone);
   std::unique_ptr<TensorQTable> dest_table = std::make_unique<TensorQTable>();
-  RETURN_IF_NOT_OK(BatchRows(&table_pair.first, &dest_table, table_pair.first->size()));
+  std::vector<std::shared_ptr<BatchSlab>> slabs;
+  if (batch_slots_ != nullptr) {
+    slabs = batch_slots_->TakeBatch(table_pair.second.epoch_num_, table_pair.second.batch_num_);
+    if (!batch_slots_->HasRowBytes()) {
+      LearnRowBytes(table_pair.first);
+    }
+  }
+  if (!slabs.empty() && table_pair.first->size() > 1) {
+    RETURN_IF_NOT_OK(BatchRowsInSlabs(&table_pair.first, &dest_table, slabs));
+  } else {
+    RETURN_IF_NOT_OK(BatchRows(&table_pair.first, &dest_table, table_pair.first->size()));
+  }
   (*db)->set_tensor_table(std::move(dest_table));
   return Status::OK();
 }
@@ -243,6 +358,30 @@ Status BatchOp::LaunchThreadsAndInitOp() {
   return Status::OK();
 }
 
+Status BatchOp::ReserveWorkers(int32_t max_workers) {
+  if (max_workers > num_workers_) {
+    worker_queues_.Init(max_workers - num_workers_, oc_queue_size_);
+  }
+  return ParallelOp::ReserveWorkers(max_workers);
+}
+
+Status BatchOp::PrepareNodePostAction() {
+  RETURN_IF_NOT_OK(ParallelOp::PrepareNodePostAction());
+  // row r of an epoch only lands in slot r % batch_size of batch r / batch_size if every batch has the same size and
+  // is made of the rows exactly as the map produced them
+  bool fixed_slots = start_batch_size_ > 1 && !pad_;
+#ifdef ENABLE_PYTHON
+  fixed_slots = fixed_slots && !batch_size_func_ && pyfunc_column_names_.empty();
+#endif
+  // out of order, the rows of a batch are not the rows whose slots it holds
+  auto map_op = child_.empty() ? nullptr : std::dynamic_pointer_cast<MapOp>(child_[0]);
+  if (fixed_slots && map_op != nullptr && !map_op->out_of_order()) {
+    batch_slots_ = std::make_shared<BatchSlots>(start_batch_size_);
+    map_op->SetBatchSlots(batch_slots_);
+  }
+  return Status::OK();
+}
+
 Status BatchOp::EofReceived(int32_t) { return Status::OK(); }
 
 Status BatchOp::EoeReceived(int32_t) {
@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_BATCH_OP_H_
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <queue>
@@ -28,6 +29,7 @@
 
 #include "minddata/dataset/core/config_manager.h"
 #include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/engine/batch_slots.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 #include "minddata/dataset/util/status.h"
@@ -202,6 +204,10 @@ class BatchOp : public ParallelOp {
   // @return Name of the current Op
   std::string Name() const override { return kBatchOp; }
 
+  // Getter
+  // @return the number of rows found in the slots map workers wrote them to, so they were batched without a copy
+  int64_t rows_in_slots() const { return rows_in_slots_; }
+
   // batch the rows in src table then put it to dest table
   // @param const std::unique_ptr<TensorQTable> *src - table that has the rows for batching
   // @param const std::unique_ptr<TensorQTable> *dest - dest_table to hold batched rows
@@ -211,6 +217,15 @@ class BatchOp : public ParallelOp {
   static Status BatchRows(const std::unique_ptr<TensorQTable> *src, const std::unique_ptr<TensorQTable> *dest,
                           dsize_t batch_size);
 
+  // batch one column of the rows in src table
+  // @param const std::unique_ptr<TensorQTable> *src - table that has the rows for batching
+  // @param size_t col - index of the column
+  // @param dsize_t batch_size - number of rows in src
+  // @param std::shared_ptr<Tensor> *out - the batched tensor
+  // @return Status - The error code return
+  static Status BatchColumn(const std::unique_ptr<TensorQTable> *src, size_t col, dsize_t batch_size,
+                            std::shared_ptr<Tensor> *out);
+
   // @param table
   // @param const PadInfo &pad_info pad info
   // @param const std::unordered_map<std::string, int32_t>& column_name_id_map - column names to index mapping
@@ -224,6 +239,31 @@ class BatchOp : public ParallelOp {
   // @return Status - The error code return
   Status WorkerEntry(int32_t worker_id) override;
 
+  // The workers batch in worker slots, so BatchOp can be autotuned
+  // @return - true
+  bool CanReserveWorkers() const override { return true; }
+
+  // Create the queues of the extra workers, the queues of the first workers are created by the constructor
+  // @param int32_t max_workers - number of workers to launch
+  // @return Status - The error code return
+  Status ReserveWorkers(int32_t max_workers) override;
+
+  // During tree prepare phase, share batch buffers with a child MapOp so rows are mapped straight into them
+  // @return Status - The error code return
+  Status PrepareNodePostAction() override;
+
+  // batch the rows in src table into the slabs map workers wrote them to, columns without a slab are copied
+  // @param const std::unique_ptr<TensorQTable> *src - table that has the rows for batching
+  // @param const std::unique_ptr<TensorQTable> *dest - dest_table to hold batched rows
+  // @param const std::vector<std::shared_ptr<BatchSlab>> &slabs - slab of every column, nullptr if not reserved
+  // @return Status - The error code return
+  Status BatchRowsInSlabs(const std::unique_ptr<TensorQTable> *src, const std::unique_ptr<TensorQTable> *dest,
+                          const std::vector<std::shared_ptr<BatchSlab>> &slabs);
+
+  // record the bytes of one row of every column with fixed shape, so map workers can start reserving slots
+  // @param const std::unique_ptr<TensorQTable> &table - a table of rows to batch
+  void LearnRowBytes(const std::unique_ptr<TensorQTable> &table);
+
   // Generate buffer with batched tensors
   // @return Status - The error code return
   Status MakeBatchedBuffer(std::pair<std::unique_ptr<TensorQTable>, CBatchInfo> table_pair,
@@ -275,6 +315,8 @@ class BatchOp : public ParallelOp {
   std::vector<std::string> pyfunc_column_names_;   // Name of the columns to perform map op on
   PadInfo pad_info_;                               // column names to perform padding on
   std::unique_ptr<ChildIterator> child_iterator_;  // child iterator for fetching TensorRows 1 by 1
+  std::shared_ptr<BatchSlots> batch_slots_;        // batch buffers shared with the child MapOp, may be nullptr
+  std::atomic<int64_t> rows_in_slots_{0};          // rows batched without a copy
   QueueList<std::pair<std::unique_ptr<TensorQTable>, CBatchInfo>> worker_queues_;  // internal queue for syncing worker
 #ifdef ENABLE_PYTHON
   py::function batch_size_func_;  // Function pointer of batch size function
@@ -293,6 +293,16 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
     return ChildOpConnectorCapacity();
   }
 
+  /// \brief Resize each queue of the output connector while the tree is running
+  /// \param queue_capacity - The new capacity of each queue of the output connector
+  /// \return Status - The error code return
+  Status ResizeConnector(int32_t queue_capacity) {
+    if (inlined() || out_connector_ == nullptr) {
+      RETURN_STATUS_UNEXPECTED("Op " + Name() + " has no output connector to resize.");
+    }
+    return out_connector_->Resize(queue_capacity);
+  }
+
   /// \brief Getter function
   /// \return connector size of child op
   int32_t ChildOpConnectorSize(int32_t child_index = 0) const { return child_[child_index]->ConnectorSize(); }
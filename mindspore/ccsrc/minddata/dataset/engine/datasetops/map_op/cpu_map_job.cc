@@ -38,6 +38,9 @@ Status CpuMapJob::Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) {
     TensorRow input_row = in[row];
     TensorRow result_row;
     for (size_t i = 0; i < ops_.size(); i++) {
+      if (i + 1 == ops_.size() && before_last_op_ != nullptr) {
+        RETURN_IF_NOT_OK(before_last_op_(row));
+      }
       // Call compute function for cpu
       RETURN_IF_NOT_OK(ops_[i]->Compute(input_row, &result_row));
 
@@ -48,6 +51,10 @@ Status CpuMapJob::Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) {
     }
     out->push_back(std::move(result_row));
   }
+  if (before_last_op_ != nullptr) {
+    // reservations the last op did not take must not leak into the next job of this thread
+    Tensor::ClearReservedAllocations();
+  }
 
   return Status::OK();
 }
@@ -16,7 +16,9 @@
 #ifndef DATASET_ENGINE_DATASETOPS_MAP_OP_MAP_JOB_H_
 #define DATASET_ENGINE_DATASETOPS_MAP_OP_MAP_JOB_H_
 
+#include <functional>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "minddata/dataset/kernels/tensor_op.h"
@@ -42,11 +44,15 @@ class MapJob {
     return Status::OK();
   }
 
+  // Set a function called with the row index right before the last TensorOp of the job runs on that row
+  void SetBeforeLastOp(std::function<Status(int32_t)> before_last_op) { before_last_op_ = std::move(before_last_op); }
+
   // A pure virtual run function to execute a particular map job
   virtual Status Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) = 0;
 
  protected:
   std::vector<std::shared_ptr<TensorOp>> ops_;
+  std::function<Status(int32_t)> before_last_op_;
 };
 
 }  // namespace dataset
@@ -115,7 +115,7 @@ Status MapOp::FetchNextWork(uint32_t worker_id, std::unique_ptr<DataBuffer> *db,
   return Status::OK();
 }
 
-Status MapOp::GenerateWorkerJob(const std::unique_ptr<MapWorkerJob> *worker_job) {
+Status MapOp::GenerateWorkerJob(const std::unique_ptr<MapWorkerJob> *worker_job, int64_t epoch, int64_t first_row) {
   std::shared_ptr<MapJob> map_job = nullptr;
   MapTargetDevice prev_target;
   for (size_t i = 0; i < tfuncs_.size(); i++) {
@@ -156,6 +156,14 @@ Status MapOp::GenerateWorkerJob(const std::unique_ptr<MapWorkerJob> *worker_job)
     prev_target = target_device;
   }
 
+  // Rows come out of the map in order, so the parent BatchOp puts row r of the epoch into slot r % batch_size of
+  // batch r / batch_size. Let the last op allocate the output of each row right in that slot.
+  if (batch_slots_ != nullptr && !(*worker_job)->jobs.empty()) {
+    auto batch_slots = batch_slots_;
+    (*worker_job)->jobs.back()->SetBeforeLastOp([batch_slots, epoch, first_row](int32_t row) {
+      return batch_slots->ReserveRow(epoch, first_row + row);
+    });
+  }
   return Status::OK();
 }
 
@@ -179,6 +187,8 @@ Status MapOp::operator()() {
   RETURN_IF_NOT_OK(rc);
   // num_buffers received, including eoe, num_epoch, num_step of current epoch
   int64_t num_buf = 0, ep_step = 0, total_step = 0;
+  // eoe buffers and rows of the current epoch seen so far, locate the batch slot of every row
+  int64_t num_eoe = 0, epoch_row = 0;
   RETURN_IF_NOT_OK(callback_manager_.Begin(CallbackParam(0, ep_step, total_step)));
 
   std::unique_ptr<DataBuffer> buff;
@@ -196,7 +206,8 @@ Status MapOp::operator()() {
       std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(buff));
 
       // Populate map worker job for a worker to execute
-      RETURN_IF_NOT_OK(GenerateWorkerJob(&worker_job));
+      RETURN_IF_NOT_OK(GenerateWorkerJob(&worker_job, num_eoe, epoch_row));
+      epoch_row += worker_job->databuffer->NumRows();
 
       // Push map worker job to the corresponding worker's queue
       RETURN_IF_NOT_OK(local_queues_[num_buf++ % num_workers_]->Add(std::move(worker_job)));
@@ -212,16 +223,35 @@ Status MapOp::operator()() {
       RETURN_IF_NOT_OK(callback_manager_.EpochEnd(CallbackParam(op_current_epochs_ + 1, ep_step, total_step)));
       ep_step = 0;
     }
-    std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(buff));
-    RETURN_IF_NOT_OK(local_queues_[num_buf++ % num_workers_]->Add(std::move(worker_job)));
+    RETURN_IF_NOT_OK(SendEndMarker(std::move(buff), &num_buf));
+    num_eoe++;
+    epoch_row = 0;
     UpdateRepeatAndEpochCounter();
     RETURN_IF_NOT_OK(child_[0]->GetNextBuffer(&buff, 0));
   }
   // the last eoe increments the eoe count by 1, but this shouldn't be reflected on End() callback
   //  RETURN_IF_NOT_OK(callback_manager_.End(CallbackParam(op_current_epochs_, ep_step, total_step)));
   // handle eof logic
-  std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(buff));
-  RETURN_IF_NOT_OK(local_queues_[num_buf++ % num_workers_]->Add(std::move(worker_job)));
+  RETURN_IF_NOT_OK(SendEndMarker(std::move(buff), &num_buf));
+  return Status::OK();
+}
+
+Status MapOp::SendEndMarker(std::unique_ptr<DataBuffer> marker, int64_t *num_buf) {
+  int32_t num_markers = out_of_order() ? num_workers_ : 1;
+  for (int32_t i = 1; i < num_markers; i++) {
+    auto copy = std::make_unique<DataBuffer>(0, marker->buffer_flags());
+    RETURN_IF_NOT_OK(local_queues_[(*num_buf)++ % num_workers_]->Add(std::make_unique<MapWorkerJob>(std::move(copy))));
+  }
+  return local_queues_[(*num_buf)++ % num_workers_]->Add(std::make_unique<MapWorkerJob>(std::move(marker)));
+}
+
+Status MapOp::PrepareNodePostAction() {
+  RETURN_IF_NOT_OK(ParallelOp::PrepareNodePostAction());
+  // A single worker has nothing to overtake
+  if (tree_->OutOfOrderEnabled() && out_connector_ != nullptr && num_producers() > 1) {
+    out_connector_->SetOutOfOrder(tree_->reorder_window());
+    MS_LOG(INFO) << "MapOp(ID:" << id() << ") outputs out of order, reorder window: " << tree_->reorder_window() << ".";
+  }
   return Status::OK();
 }
 
@@ -265,7 +295,10 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
     CHECK_FAIL_RETURN_UNEXPECTED(in_buffer->NumRows() * in_buffer->NumCols() != 0, "MapOp got an empty DataBuffer.");
     std::unique_ptr<TensorQTable> new_tensor_table(std::make_unique<TensorQTable>());
     // Perform the compute function of TensorOp(s) and store the result in new_tensor_table.
-    RETURN_IF_NOT_OK(WorkerCompute(in_buffer.get(), new_tensor_table.get(), job_list));
+    RETURN_IF_NOT_OK(AcquireWorkerSlot());
+    Status rc = WorkerCompute(in_buffer.get(), new_tensor_table.get(), job_list);
+    ReleaseWorkerSlot();
+    RETURN_IF_NOT_OK(rc);
     // Replace the TensorTable in DataBuffer with the new one.
     in_buffer->set_tensor_table(std::move(new_tensor_table));
     // Push the buffer onto the connector for next operator to consume.
@@ -24,6 +24,7 @@
 #include <vector>
 
 #include "minddata/dataset/callback/ds_callback.h"
+#include "minddata/dataset/engine/batch_slots.h"
 #include "minddata/dataset/engine/datasetops/map_op/map_job.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 #include "minddata/dataset/kernels/tensor_op.h"
@@ -194,6 +195,19 @@ class MapOp : public ParallelOp {
 
   const auto &TFuncs() const { return tfuncs_; }
 
+  // Let the last TensorOp write its output rows straight into the batch buffers of the BatchOp consuming this op.
+  // Must be set before the tree is launched.
+  // @param batch_slots - The batch buffers shared with the parent BatchOp
+  void SetBatchSlots(std::shared_ptr<BatchSlots> batch_slots) { batch_slots_ = std::move(batch_slots); }
+
+  // During tree prepare phase, let the output connector hand out buffers out of order if the tree runs out of order.
+  // @return Status The error code return
+  Status PrepareNodePostAction() override;
+
+  // Getter
+  // @return Whether the next op gets the buffers out of order
+  bool out_of_order() const { return out_connector_ != nullptr && out_connector_->out_of_order(); }
+
  private:
   // A unit of job for map worker thread.
   // MapWorkerJob holds a list of MapJob where each MapJob can be a CpuMapJob, GpuMapJob or DvppMapJob.
@@ -204,7 +218,9 @@ class MapOp : public ParallelOp {
   };
 
   // A helper function to create jobs for workers.
-  Status GenerateWorkerJob(const std::unique_ptr<MapWorkerJob> *worker_job);
+  // @param epoch - Number of eoe buffers seen before the data buffer of the job
+  // @param first_row - Index of the first row of the data buffer inside the epoch
+  Status GenerateWorkerJob(const std::unique_ptr<MapWorkerJob> *worker_job, int64_t epoch, int64_t first_row);
 
   // A helper function that fetch worker map job from local queues and extract the data and map job list
   Status FetchNextWork(uint32_t worker_id, std::unique_ptr<DataBuffer> *db,
@@ -234,6 +250,16 @@ class MapOp : public ParallelOp {
   // count number of workers that have signaled master
   std::atomic_int num_workers_paused_;
 
+  // batch buffers of the parent BatchOp, nullptr unless zero-copy batching is on
+  std::shared_ptr<BatchSlots> batch_slots_;
+
+  // Private function for the master to send an eoe or eof buffer to the workers. Out of order, every worker forwards
+  // one, so the output connector knows when all the buffers before it are out.
+  // @param marker The eoe or eof buffer.
+  // @param num_buf The number of jobs sent to the workers so far, it picks the next worker.
+  // @return Status The error code return
+  Status SendEndMarker(std::unique_ptr<DataBuffer> marker, int64_t *num_buf);
+
   // Private function for worker/thread to loop continuously. It comprises the main
   // logic of MapOp: getting the data from previous Op, validating user specified column names,
   // applying a list of TensorOps to each of the data, process the results and then
@@ -242,6 +268,10 @@ class MapOp : public ParallelOp {
   // @return Status The error code return
   Status WorkerEntry(int32_t worker_id) override;  //  In: workerId assigned by tree_
 
+  // The workers compute in worker slots and the local queues are created at launch, so MapOp can be autotuned
+  // @return - true
+  bool CanReserveWorkers() const override { return true; }
+
   // Private function for worker thread to perform TensorOp's compute function and get the result.
   // @param in_buffer A raw pointer to the DataBuffer. A raw pointer is fine because this function doesn't manage memory
   //     and is not shared with other threads.
@@ -15,11 +15,14 @@
  */
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 
+#include <algorithm>
 #include <iostream>
+#include <thread>
 #include <utility>
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/db_connector.h"
 #include "minddata/dataset/util/task_manager.h"
 
@@ -31,7 +34,10 @@ ParallelOp::ParallelOp(int32_t num_workers, int32_t op_connector_size, std::shar
       num_workers_(num_workers),
       num_producers_(num_workers),
       worker_connector_size_(1),
-      worker_connector_(nullptr) {}
+      worker_connector_(nullptr),
+      gated_(false),
+      active_workers_(num_workers),
+      busy_workers_(0) {}
 
 // Creates the internal worker connector for the parallel op if the derived class wants to use it
 Status ParallelOp::CreateWorkerConnector(int32_t worker_connector_size) {
@@ -62,6 +68,71 @@ void ParallelOp::Print(std::ostream &out, bool show_all) const {
   }
 }
 
+// During tree prepare phase, reserve the worker threads the pipeline autotuner may scale the op up to
+Status ParallelOp::PrepareNodePreAction() {
+  // Run common code from super class before adding ParallelOp specific logic
+  RETURN_IF_NOT_OK(DatasetOp::PrepareNodePreAction());
+  if (!GlobalContext::config_manager()->enable_autotune() || !CanReserveWorkers()) {
+    return Status::OK();
+  }
+  // The tunable ops of the tree share the cores, so the reserved threads do not grow with the number of ops
+  int32_t tunable_ops = 0;
+  for (auto &node : *tree_) {
+    auto parallel_op = dynamic_cast<ParallelOp *>(&node);
+    if (parallel_op != nullptr && parallel_op->CanReserveWorkers()) {
+      tunable_ops++;
+    }
+  }
+  int32_t cores = static_cast<int32_t>(std::thread::hardware_concurrency());
+  int32_t max_workers = std::max(num_workers_, cores / std::max(tunable_ops, 1));
+  RETURN_IF_NOT_OK(ReserveWorkers(max_workers));
+  gated_ = true;
+  return Status::OK();
+}
+
+// Raise the number of worker threads, the number of active workers stays the same
+Status ParallelOp::ReserveWorkers(int32_t max_workers) {
+  if (max_workers <= num_workers_) {
+    return Status::OK();
+  }
+  MS_LOG(INFO) << Name() << " reserves " << max_workers << " workers, " << active_workers() << " of them are active.";
+  // Unless a worker connector funnels the output through the master, every worker is a producer
+  if (worker_connector_ == nullptr) {
+    num_producers_ = max_workers;
+  }
+  num_workers_ = max_workers;
+  return Status::OK();
+}
+
+void ParallelOp::SetActiveWorkers(int32_t active_workers) {
+  {
+    std::unique_lock<std::mutex> lck(worker_slot_mux_);
+    active_workers_ = std::min(std::max(active_workers, 1), num_workers_);
+  }
+  worker_slot_cv_.NotifyAll();
+}
+
+Status ParallelOp::AcquireWorkerSlot() {
+  if (!gated_) {
+    return Status::OK();
+  }
+  std::unique_lock<std::mutex> lck(worker_slot_mux_);
+  RETURN_IF_NOT_OK(worker_slot_cv_.Wait(&lck, [this]() { return busy_workers_ < active_workers_; }));
+  busy_workers_++;
+  return Status::OK();
+}
+
+void ParallelOp::ReleaseWorkerSlot() {
+  if (!gated_) {
+    return;
+  }
+  {
+    std::unique_lock<std::mutex> lck(worker_slot_mux_);
+    busy_workers_--;
+  }
+  worker_slot_cv_.NotifyOne();
+}
+
 // Override base class reset to provide reset actions specific to the ParallelOp class.
 Status ParallelOp::Reset() {
   RETURN_IF_NOT_OK(DatasetOp::Reset());  // Perform any super class reset work
@@ -77,6 +148,9 @@ Status ParallelOp::Reset() {
 
 // Register the internal worker connectors
 Status ParallelOp::RegisterWorkerConnectors() {
+  if (gated_) {
+    RETURN_IF_NOT_OK(worker_slot_cv_.Register(tree_->AllTasks()->GetIntrpService()));
+  }
   if (worker_connector_) {
     return (worker_connector_->Register(tree_->AllTasks()));
   }
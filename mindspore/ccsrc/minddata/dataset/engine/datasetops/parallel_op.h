@@ -16,11 +16,14 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_PARALLEL_OP_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_PARALLEL_OP_H_
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include "minddata/dataset/core/constants.h"
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
+#include "minddata/dataset/util/cond_var.h"
 #include "minddata/dataset/util/status.h"
 
 namespace mindspore {
@@ -72,10 +75,7 @@ class ParallelOp : public DatasetOp {
   // @notes Derived versions of this function should always call it's superclass version first
   // before providing their own implementations.
   // @return Status - The error return code
-  Status PrepareNodePreAction() override {
-    // Run common code from super class before adding ParallelOp specific logic
-    return (DatasetOp::PrepareNodePreAction());
-  }
+  Status PrepareNodePreAction() override;
 
   // During tree prepare phase, operators may have specific post-operations to perform depending on
   // their role.
@@ -111,7 +111,39 @@ class ParallelOp : public DatasetOp {
   // @return Status
   Status RegisterWorkerConnectors() override;
 
+  // Getter
+  // @return the number of workers allowed to compute at the same time
+  int32_t active_workers() const { return active_workers_; }
+
+  // Limit the number of workers computing at the same time. The worker threads and the order of the output stay the
+  // same, which lets the pipeline autotuner scale a running op. Only has effect if the op gates its workers.
+  // @param active_workers - The new limit, clamped to [1, num_workers]
+  void SetActiveWorkers(int32_t active_workers);
+
+  // Whether the workers pass through AcquireWorkerSlot() so SetActiveWorkers() can scale the op
+  bool gated() const { return gated_; }
+
  protected:
+  // Whether the op can launch more worker threads than it was built with. Ops opting in must call
+  // AcquireWorkerSlot() and ReleaseWorkerSlot() around the compute of their workers, and if they size internal
+  // structures by the number of workers at construction time, grow them in ReserveWorkers().
+  // @return - true if ReserveWorkers() is supported
+  virtual bool CanReserveWorkers() const { return false; }
+
+  // Raise the number of worker threads before the node is prepared, while keeping the number of active workers.
+  // The connectors are created from the number of workers, so this can not be called once the op is prepared.
+  // @param max_workers - The number of worker threads to launch
+  // @return Status - The error code return
+  virtual Status ReserveWorkers(int32_t max_workers);
+
+  // Block the worker until less than active_workers() workers compute. Workers hold a slot only while they compute,
+  // never while they wait on a queue, so a gated op can not deadlock.
+  // @return Status - The error code return, set if the tree is interrupted
+  Status AcquireWorkerSlot();
+
+  // Give back the slot taken by AcquireWorkerSlot()
+  void ReleaseWorkerSlot();
+
   // Interface for derived classes to implement. All derived classes must provide the entry
   // function with the main execution loop for worker threads.
   // @return Status - The error code return
@@ -121,6 +153,13 @@ class ParallelOp : public DatasetOp {
   int32_t num_producers_;  // The number of threads pushing to the out_connector_
   int32_t worker_connector_size_;
   std::unique_ptr<DbConnector> worker_connector_;  // The internal connector for worker threads
+
+ private:
+  bool gated_;                           // The workers go through the worker slots
+  std::atomic<int32_t> active_workers_;  // The number of workers allowed to compute at the same time
+  int32_t busy_workers_;                 // The number of workers holding a slot
+  std::mutex worker_slot_mux_;
+  CondVar worker_slot_cv_;
 };
 }  // namespace dataset
 }  // namespace mindspore
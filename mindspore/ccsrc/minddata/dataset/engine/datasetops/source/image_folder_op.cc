@@ -82,6 +82,13 @@ ImageFolderOp::ImageFolderOp(int32_t num_wkrs, int32_t rows_per_buffer, std::str
   io_block_queues_.Init(num_workers_, queue_size);
 }
 
+Status ImageFolderOp::ReserveWorkers(int32_t max_workers) {
+  if (max_workers > num_workers_) {
+    io_block_queues_.Init(max_workers - num_workers_, oc_queue_size_);
+  }
+  return ParallelOp::ReserveWorkers(max_workers);
+}
+
 // Master thread that pulls the prescan worker's results.
 // Keep collecting results until all prescan workers quit
 // Then consolidate 2 level shuffles together into 1 giant vector
@@ -190,7 +197,10 @@ Status ImageFolderOp::WorkerEntry(int32_t worker_id) {
       RETURN_IF_NOT_OK(io_block->GetKeys(&keys));
       if (keys.empty() == true) return Status::OK();  // empty key is a quit signal for workers
       std::unique_ptr<DataBuffer> db = std::make_unique<DataBuffer>(buffer_id, DataBuffer::kDeBFlagNone);
-      RETURN_IF_NOT_OK(LoadBuffer(keys, &db));
+      RETURN_IF_NOT_OK(AcquireWorkerSlot());
+      Status rc = LoadBuffer(keys, &db);
+      ReleaseWorkerSlot();
+      RETURN_IF_NOT_OK(rc);
       RETURN_IF_NOT_OK(out_connector_->Add(worker_id, std::move(db)));
       buffer_id += num_workers_;
     }
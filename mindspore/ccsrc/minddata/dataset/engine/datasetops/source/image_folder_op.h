@@ -215,6 +215,15 @@ class ImageFolderOp : public ParallelOp, public RandomAccessOp {
   std::string Name() const override { return "ImageFolderOp"; }
 
  private:
+  // The workers load buffers in worker slots, so ImageFolderOp can be autotuned
+  // @return - true
+  bool CanReserveWorkers() const override { return true; }
+
+  // Create the IOBlock queues of the extra workers
+  // @param int32_t max_workers - number of workers to launch
+  // @return Status - The error code return
+  Status ReserveWorkers(int32_t max_workers) override;
+
   // Initialize Sampler, calls sampler->Init() within
   // @return Status - The error code return
   Status InitSampler();
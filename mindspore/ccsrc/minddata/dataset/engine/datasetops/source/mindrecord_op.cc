@@ -263,9 +263,11 @@ Status MindRecordOp::GetBufferFromReader(std::unique_ptr<DataBuffer> *fetched_bu
                                          int32_t worker_id) {
   *fetched_buffer = std::make_unique<DataBuffer>(buffer_id, DataBuffer::kDeBFlagNone);
   std::unique_ptr<TensorQTable> tensor_table = std::make_unique<TensorQTable>();
+  // the rows of the buffer are read one after another, so the reader merges their adjacent blobs into one read
+  int64_t end_row_id = (buffer_id + 1) * rows_per_buffer_;
   for (int32_t i = 0; i < rows_per_buffer_; ++i) {
     int32_t row_id = buffer_id * rows_per_buffer_ + i;
-    auto rc = shard_reader_->GetNextById(row_id, worker_id);
+    auto rc = shard_reader_->GetNextById(row_id, worker_id, end_row_id);
     auto task_type = rc.first;
     auto tupled_buffer = rc.second;
     if (task_type == mindrecord::TaskType::kPaddedTask) {
@@ -15,16 +15,18 @@
  */
 #include "minddata/dataset/engine/datasetops/source/sampler/distributed_sampler.h"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 
 #include "minddata/dataset/engine/data_buffer.h"
 #include "minddata/dataset/util/random.h"
+#include "minddata/mindrecord/include/common/shard_utils.h"
 
 namespace mindspore {
 namespace dataset {
 DistributedSampler::DistributedSampler(int64_t num_samples, int64_t num_dev, int64_t dev_id, bool shuffle,
-                                       uint32_t seed, int64_t offset, bool even_dist)
+                                       uint32_t seed, int64_t offset, bool even_dist, int64_t shuffle_block_size)
     : Sampler(num_samples, std::numeric_limits<int64_t>::max()),
       cnt_(0),
       seed_(seed == std::numeric_limits<uint32_t>::max() ? GetSeed() : seed),
@@ -33,7 +35,8 @@ DistributedSampler::DistributedSampler(int64_t num_samples, int64_t num_dev, int
       shuffle_(shuffle),
       even_dist_(even_dist),
       offset_(offset),
-      non_empty_(true) {}
+      non_empty_(true),
+      shuffle_block_size_(shuffle_block_size) {}
 
 Status DistributedSampler::InitSampler() {
   // Special value of 0 for num_samples means that the user wants to sample the entire set of data.
@@ -45,6 +48,8 @@ Status DistributedSampler::InitSampler() {
   CHECK_FAIL_RETURN_UNEXPECTED(num_rows_ > 0, "num_rows <= 0\n");
   CHECK_FAIL_RETURN_UNEXPECTED(device_id_ < num_devices_ && device_id_ >= 0 && num_rows_ > 0 && num_samples_ > 0,
                                "fail to init DistributedSampler");
+  CHECK_FAIL_RETURN_UNEXPECTED(shuffle_block_size_ <= 0 || (offset_ == -1 && even_dist_),
+                               "DistributedSampler: block shuffle does not support offset or uneven distribution");
   rnd_.seed(seed_++);
 
   if (offset_ != -1 || !even_dist_) {
@@ -63,7 +68,7 @@ Status DistributedSampler::InitSampler() {
     for (int64_t i = 0; i < num_rows_; i++) {
       shuffle_vec_.push_back(i);
     }
-    std::shuffle(shuffle_vec_.begin(), shuffle_vec_.end(), rnd_);
+    Shuffle();
   }
   if (!samples_per_buffer_) non_empty_ = false;
 
@@ -100,6 +105,10 @@ Status DistributedSampler::GetNextSample(std::unique_ptr<DataBuffer> *out_buffer
     bool flag_add_1 = false;
     while (cnt_ < samples_per_buffer_ && id_ptr != sample_ids->end<int64_t>()) {
       int64_t middle_value = num_devices_ * cnt_ + device_id_ - offset_;
+      if (shuffle_ && shuffle_block_size_ > 0) {
+        // a contiguous slice of the block order for each device
+        middle_value = device_id_ * ((num_rows_ + num_devices_ - 1) / num_devices_) + cnt_;
+      }
       // if index < 0, we move back one place
       if (middle_value < 0) {
         samples_per_buffer_++;
@@ -140,7 +149,7 @@ Status DistributedSampler::ResetSampler() {
   if (shuffle_ == true) {
     rnd_.seed(seed_);
     seed_++;
-    std::shuffle(shuffle_vec_.begin(), shuffle_vec_.end(), rnd_);
+    Shuffle();
   }
 
   if (HasChildSampler()) {
@@ -150,12 +159,20 @@ Status DistributedSampler::ResetSampler() {
   return Status::OK();
 }
 
+void DistributedSampler::Shuffle() {
+  if (shuffle_block_size_ <= 0) {
+    std::shuffle(shuffle_vec_.begin(), shuffle_vec_.end(), rnd_);
+    return;
+  }
+  mindrecord::BlockShuffle(shuffle_block_size_, &rnd_, &shuffle_vec_);
+}
+
 void DistributedSampler::Print(std::ostream &out, bool show_all) const {
   out << "\nSampler: DistributedSampler";
   if (show_all) {
     Sampler::Print(out, show_all);
     out << "\nseed: " << seed_ << "\ndevice_id: " << device_id_ << "\nnum_devices: " << num_devices_
-        << "\nshuffle: " << shuffle_;
+        << "\nshuffle: " << shuffle_ << "\nshuffle_block_size: " << shuffle_block_size_;
   }
 }
 
@@ -39,8 +39,12 @@ class DistributedSampler : public Sampler {
   /// \param even_dist The option to indicate whether or not each shard returns the same number of rows.
   ///     This option is not exposed in the python API. Current behavior is that the remainder will always
   ///     be handled by the first n shards, n being the corresponding device id.
+  /// \param[in] shuffle_block_size When positive, shuffle in two levels: blocks of this many consecutive rows are
+  ///     shuffled, then the rows within a window of kShuffleWindowBlocks blocks. Each shard reads a contiguous slice
+  ///     of the order, so it only touches its own blocks. Rows stored close together stay close in the order.
   DistributedSampler(int64_t num_samples, int64_t num_dev, int64_t dev_id, bool shuffle,
-                     uint32_t seed = std::numeric_limits<uint32_t>::max(), int64_t offset = -1, bool even_dist = true);
+                     uint32_t seed = std::numeric_limits<uint32_t>::max(), int64_t offset = -1, bool even_dist = true,
+                     int64_t shuffle_block_size = 0);
 
   /// \brief default destructor
   ~DistributedSampler() = default;
@@ -64,6 +68,9 @@ class DistributedSampler : public Sampler {
   void Print(std::ostream &out, bool show_all) const override;
 
  private:
+  /// \brief Shuffle shuffle_vec_ for the next epoch
+  void Shuffle();
+
   int64_t cnt_;  // number of samples that have already been filled in to buffer
   uint32_t seed_;
   int64_t device_id_;
@@ -74,6 +81,7 @@ class DistributedSampler : public Sampler {
   bool even_dist_;
   int64_t offset_;
   bool non_empty_;
+  int64_t shuffle_block_size_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 #include "minddata/dataset/engine/connector.h"
 #include "minddata/dataset/engine/data_buffer.h"
 #include "minddata/dataset/core/constants.h"
@@ -25,7 +26,8 @@
 namespace mindspore {
 namespace dataset {
 // DbConnector is a derived class from Connector with added logic to handle EOE and EOF.
-// The Connector class itself is responsible to ensure deterministic order on every run.
+// The Connector class itself is responsible to ensure deterministic order on every run, unless the DbConnector is
+// switched to out of order mode, see SetOutOfOrder().
 class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
  public:
   // Constructor of DbConnector
@@ -45,7 +47,38 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
   // @param worker_id The id of a worker thread calling this method.
   // @param el A rvalue reference to an element to be passed/added/pushed.
   Status Add(int32_t worker_id, std::unique_ptr<DataBuffer> &&el) noexcept {
-    return (Connector<std::unique_ptr<DataBuffer>>::Push(worker_id, std::move(el)));
+    RETURN_IF_NOT_OK(Connector<std::unique_ptr<DataBuffer>>::Push(worker_id, std::move(el)));
+    if (reorder_window_ > 0) {
+      // A consumer may be waiting for any producer to have a buffer ready. Taking the lock makes sure it is either
+      // waiting already or will see this buffer when it checks the queues.
+      { std::unique_lock<std::mutex> lk(m_); }
+      cv_.NotifyAll();
+    }
+    return Status::OK();
+  }
+
+  // Let the consumers take the buffer of whichever producer has one ready instead of following the strict round
+  // robin order, so one slow buffer does not block the buffers other producers already finished.
+  // Every producer must push its own EOE and EOF. A producer which reached the end of the epoch is held back until
+  // all producers did, then the consumers get a single EOE (or EOF), so buffers never cross an epoch boundary.
+  // @param window A buffer can be overtaken by at most window - 1 buffers following it in round robin order.
+  //     A window of 1 gives the deterministic order back.
+  void SetOutOfOrder(int32_t window) {
+    reorder_window_ = window;
+    popped_.assign(num_producers_, 0);
+    end_markers_.clear();
+    end_markers_.resize(num_producers_);
+  }
+
+  // Whether the consumers may get the buffers out of the round robin order.
+  bool out_of_order() const { return reorder_window_ > 0; }
+
+  // Resets the connector for the next repeat, see Connector::Reset().
+  void Reset() {
+    if (reorder_window_ > 0) {
+      SetOutOfOrder(reorder_window_);
+    }
+    Connector<std::unique_ptr<DataBuffer>>::Reset();
   }
 
   // Get a unique_ptr<DataBuffer> from the DbConnector.
@@ -66,6 +99,11 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
       // Once an EOF message is encountered this flag will be set and we can return early.
       if (end_of_file_) {
         *result = std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOF);
+      } else if (reorder_window_ > 0) {
+        RETURN_IF_NOT_OK(PopOutOfOrder(&lk, result));
+        if ((*result)->eof()) {
+          end_of_file_ = true;
+        }
       } else {
         RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
         if (*result == nullptr) {
@@ -89,8 +127,79 @@ class DbConnector : public Connector<std::unique_ptr<DataBuffer>> {
   }
 
  private:
+  // Position of the next buffer of a producer in the round robin order.
+  int64_t NextPosition(int32_t producer) const { return popped_[producer] * num_producers_ + producer; }
+
+  // Whether a buffer of the producer can be popped now without breaking the reorder window.
+  // @param producer The id of the producer.
+  // @param oldest The position of the oldest buffer not popped yet.
+  bool CanPopFrom(int32_t producer, int64_t oldest) const {
+    return end_markers_[producer] == nullptr && queues_[producer]->size() > 0 &&
+           NextPosition(producer) < oldest + reorder_window_;
+  }
+
+  // Position of the oldest buffer not popped yet among the producers which did not reach the end of the epoch.
+  int64_t OldestPosition() const {
+    int64_t oldest = -1;
+    for (int32_t i = 0; i < num_producers_; ++i) {
+      if (end_markers_[i] == nullptr && (oldest < 0 || NextPosition(i) < oldest)) {
+        oldest = NextPosition(i);
+      }
+    }
+    return oldest;
+  }
+
+  // Pop the oldest buffer which is ready within the reorder window, the caller holds the lock of the connector.
+  // @param lk The lock of the connector, released while waiting for a producer.
+  // @param result The address of a unique_ptr<DataBuffer> where the popped element will be placed.
+  Status PopOutOfOrder(std::unique_lock<std::mutex> *lk, std::unique_ptr<DataBuffer> *result) {
+    while (true) {
+      int64_t oldest = OldestPosition();
+      if (oldest < 0) {
+        // All producers reached the end of the epoch, hand out one of their EOE or EOF
+        *result = std::move(end_markers_[0]);
+        for (auto &marker : end_markers_) {
+          marker.reset();
+        }
+        return Status::OK();
+      }
+      RETURN_IF_NOT_OK(cv_.Wait(lk, [this, oldest]() {
+        for (int32_t i = 0; i < num_producers_; ++i) {
+          if (CanPopFrom(i, oldest)) {
+            return true;
+          }
+        }
+        return false;
+      }));
+      int32_t producer = -1;
+      for (int32_t i = 0; i < num_producers_; ++i) {
+        if (CanPopFrom(i, oldest) && (producer < 0 || NextPosition(i) < NextPosition(producer))) {
+          producer = i;
+        }
+      }
+      std::unique_ptr<DataBuffer> buffer;
+      RETURN_IF_NOT_OK(queues_[producer]->PopFront(&buffer));
+      if (buffer == nullptr) {
+        RETURN_STATUS_UNEXPECTED("[ERROR] nullptr detected when getting data from db connector");
+      }
+      popped_[producer]++;
+      if (buffer->eoe() || buffer->eof()) {
+        end_markers_[producer] = std::move(buffer);
+        continue;
+      }
+      *result = std::move(buffer);
+      return Status::OK();
+    }
+  }
+
   // A flag to indicate the end of stream has been encountered.
   bool end_of_file_;
+  // Out of order mode: the reorder window, 0 for the deterministic round robin order
+  int32_t reorder_window_ = 0;
+  // Out of order mode: the number of buffers popped from each producer
+  std::vector<int64_t> popped_;
+  // Out of order mode: the EOE or EOF of each producer which reached the end of the epoch
+  std::vector<std::unique_ptr<DataBuffer>> end_markers_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -16,6 +16,8 @@
 #include "minddata/dataset/engine/execution_tree.h"
 #include <iostream>
 #include <string>
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
 #include "minddata/dataset/engine/datasetops/shuffle_op.h"
 #include "minddata/dataset/util/task_manager.h"
@@ -38,6 +40,9 @@ ExecutionTree::ExecutionTree() : id_count_(0) {
   perf_monitor_ = std::make_unique<Monitor>(this);
   profiling_manager_ = std::make_unique<ProfilingManager>(this);
   optimize_ = common::GetEnv("OPTIMIZE") == "true" ? true : false;
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  out_of_order_ = cfg->out_of_order();
+  reorder_window_ = cfg->reorder_window();
 }
 
 // Destructor
@@ -133,9 +138,17 @@ Status ExecutionTree::Launch() {
   ss << *this;
 
   // Profiling infrastructures need to be initialized before Op launching
-  if (profiling_manager_->IsProfilingEnable()) {
+  bool profiling = profiling_manager_->IsProfilingEnable();
+  if (profiling) {
     // Setup profiling manager
     RETURN_IF_NOT_OK(profiling_manager_->Initialize());
+  }
+  // The autotuner runs on the samples of the Monitor, with or without profiling
+  bool autotune = GlobalContext::config_manager()->enable_autotune();
+  if (autotune) {
+    RETURN_IF_NOT_OK(perf_monitor_->EnableAutoTune());
+  }
+  if (profiling || autotune) {
     // Launch Monitor Thread
     RETURN_IF_NOT_OK(tg_->CreateAsyncTask("Monitor Thread launched", std::ref(*perf_monitor_)));
   }
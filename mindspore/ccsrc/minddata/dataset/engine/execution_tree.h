@@ -232,6 +232,28 @@ class ExecutionTree {
   // Optional optimizations status
   bool OptimizationEnabled() const { return optimize_; }
 
+  // Let parallel ops hand out their buffers out of order if tree has not been prepared yet
+  // @param value - false to keep the deterministic order of every op
+  // @param reorder_window - a buffer can be overtaken by at most reorder_window - 1 buffers following it
+  // @return Status - The error code return
+  Status SetOutOfOrder(bool value, int32_t reorder_window) {
+    if (tree_state_ != kDeTStateInit && tree_state_ != kDeTStateBuilding) {
+      RETURN_STATUS_UNEXPECTED("Tree has already been prepared, can not change its output order.");
+    }
+    if (value && reorder_window <= 0) {
+      RETURN_STATUS_UNEXPECTED("Reorder window must be positive, got " + std::to_string(reorder_window) + ".");
+    }
+    out_of_order_ = value;
+    reorder_window_ = reorder_window;
+    return Status::OK();
+  }
+
+  // Out of order status
+  bool OutOfOrderEnabled() const { return out_of_order_; }
+
+  // Getter for the reorder window of the parallel ops when the tree runs out of order
+  int32_t reorder_window() const { return reorder_window_; }
+
   // Getter function to get the total number of epochs to be run on this tree.
   // @return total number of epochs
   int32_t num_epochs() { return num_epochs_; }
@@ -254,6 +276,8 @@ class ExecutionTree {
   std::unique_ptr<Monitor> perf_monitor_;                // Performance Monitor
   std::unique_ptr<ProfilingManager> profiling_manager_;  // Profiling manager
   bool optimize_;                                        // Flag to enable optional optimizations
+  bool out_of_order_;                                    // Flag to let parallel ops output out of order
+  int32_t reorder_window_;                               // Bound of the reordering when out of order
 };
 
 inline bool operator==(const ExecutionTree::Iterator &lhs, const ExecutionTree::Iterator &rhs) { return lhs == rhs; }
@@ -0,0 +1,309 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/gnn/csr_graph.h"
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+
+#include "securec.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+
+void CsrGraph::IdIndex::Init(std::vector<int32_t> ids) {
+  size_ = static_cast<int32_t>(ids.size());
+  first_ = ids.empty() ? 0 : ids.front();
+  // Most graphs number their nodes and edges from 0, the index is then the id minus the first one
+  bool consecutive = ids.empty() || static_cast<int64_t>(ids.back()) - ids.front() + 1 == size_;
+  if (consecutive) {
+    ids_.clear();
+    ids_.shrink_to_fit();
+  } else {
+    ids_ = std::move(ids);
+  }
+}
+
+int32_t CsrGraph::IdIndex::Find(int32_t id) const {
+  if (ids_.empty()) {
+    int64_t index = static_cast<int64_t>(id) - first_;
+    return (index >= 0 && index < size_) ? static_cast<int32_t>(index) : -1;
+  }
+  auto itr = std::lower_bound(ids_.begin(), ids_.end(), id);
+  if (itr == ids_.end() || *itr != id) {
+    return -1;
+  }
+  return static_cast<int32_t>(itr - ids_.begin());
+}
+
+Status CsrGraph::Build(std::vector<std::shared_ptr<Node>> *nodes, std::vector<std::shared_ptr<Edge>> *edges,
+                       const std::unordered_map<NodeType, std::unordered_set<FeatureType>> &node_features,
+                       const std::unordered_map<EdgeType, std::unordered_set<FeatureType>> &edge_features) {
+  RETURN_UNEXPECTED_IF_NULL(nodes);
+  RETURN_UNEXPECTED_IF_NULL(edges);
+  std::vector<NodeType> node_types;
+  RETURN_IF_NOT_OK(BuildNodes(nodes, node_features, &node_types));
+  RETURN_IF_NOT_OK(BuildEdges(edges, node_types, edge_features));
+  MS_LOG(INFO) << "Built the CSR graph, nodes:" << node_index_.size() << " edges:" << edge_index_.size()
+               << " neighbor types:" << adjacency_.size();
+  return Status::OK();
+}
+
+Status CsrGraph::BuildNodes(std::vector<std::shared_ptr<Node>> *nodes,
+                            const std::unordered_map<NodeType, std::unordered_set<FeatureType>> &node_features,
+                            std::vector<NodeType> *node_types) {
+  // Keep the first node loaded when several have the same id, as the map of nodes does
+  std::stable_sort(nodes->begin(), nodes->end(),
+                   [](const std::shared_ptr<Node> &a, const std::shared_ptr<Node> &b) { return a->id() < b->id(); });
+  auto last = std::unique(nodes->begin(), nodes->end(), [](const std::shared_ptr<Node> &a,
+                                                           const std::shared_ptr<Node> &b) { return a->id() == b->id(); });
+  if (last != nodes->end()) {
+    MS_LOG(WARNING) << "Found " << std::distance(last, nodes->end()) << " nodes with a duplicated id, they are ignored.";
+    nodes->erase(last, nodes->end());
+  }
+
+  std::vector<int32_t> ids(nodes->size());
+  node_types->resize(nodes->size());
+  for (size_t i = 0; i < nodes->size(); ++i) {
+    ids[i] = (*nodes)[i]->id();
+    (*node_types)[i] = (*nodes)[i]->type();
+  }
+  node_index_.Init(std::move(ids));
+  RETURN_IF_NOT_OK(BuildFeatureColumns(*nodes, node_features, &node_features_));
+  nodes->clear();
+  nodes->shrink_to_fit();
+  return Status::OK();
+}
+
+Status CsrGraph::BuildEdges(std::vector<std::shared_ptr<Edge>> *edges, const std::vector<NodeType> &node_types,
+                            const std::unordered_map<EdgeType, std::unordered_set<FeatureType>> &edge_features) {
+  const int32_t num_nodes = node_index_.size();
+  std::vector<int32_t> src(edges->size());
+  std::vector<int32_t> dst(edges->size());
+  // Count the neighbors of each type of every node
+  for (size_t i = 0; i < edges->size(); ++i) {
+    std::pair<std::shared_ptr<Node>, std::shared_ptr<Node>> p;
+    RETURN_IF_NOT_OK((*edges)[i]->GetNode(&p));
+    src[i] = node_index_.Find(p.first->id());
+    dst[i] = node_index_.Find(p.second->id());
+    CHECK_FAIL_RETURN_UNEXPECTED(src[i] >= 0, "invalid src_id:" + std::to_string(p.first->id()));
+    CHECK_FAIL_RETURN_UNEXPECTED(dst[i] >= 0, "invalid dst_id:" + std::to_string(p.second->id()));
+    Adjacency &adjacency = adjacency_[node_types[dst[i]]];
+    if (adjacency.offsets.empty()) {
+      adjacency.offsets.assign(num_nodes + 1, 0);
+    }
+    adjacency.offsets[src[i] + 1]++;
+  }
+  for (auto &itr : adjacency_) {
+    Adjacency &adjacency = itr.second;
+    std::partial_sum(adjacency.offsets.begin(), adjacency.offsets.end(), adjacency.offsets.begin());
+    adjacency.neighbors.resize(adjacency.offsets.back());
+  }
+  // Fill the neighbors in loading order, offsets[i] moves to the end of the neighbors of node i and is shifted back
+  for (size_t i = 0; i < edges->size(); ++i) {
+    Adjacency &adjacency = adjacency_[node_types[dst[i]]];
+    adjacency.neighbors[adjacency.offsets[src[i]]++] = dst[i];
+  }
+  for (auto &itr : adjacency_) {
+    std::vector<int64_t> &offsets = itr.second.offsets;
+    for (int32_t i = num_nodes; i > 0; --i) {
+      offsets[i] = offsets[i - 1];
+    }
+    offsets[0] = 0;
+  }
+
+  // Keep the first edge loaded when several have the same id, as the map of edges does
+  std::vector<size_t> order(edges->size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [edges](size_t a, size_t b) { return (*edges)[a]->id() < (*edges)[b]->id(); });
+  auto last = std::unique(order.begin(), order.end(),
+                          [edges](size_t a, size_t b) { return (*edges)[a]->id() == (*edges)[b]->id(); });
+  if (last != order.end()) {
+    MS_LOG(WARNING) << "Found " << std::distance(last, order.end()) << " edges with a duplicated id, they are ignored.";
+    order.erase(last, order.end());
+  }
+
+  std::vector<std::shared_ptr<Edge>> sorted_edges(order.size());
+  std::vector<int32_t> ids(order.size());
+  edge_src_.resize(order.size());
+  edge_dst_.resize(order.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    sorted_edges[i] = std::move((*edges)[order[i]]);
+    ids[i] = sorted_edges[i]->id();
+    edge_src_[i] = src[order[i]];
+    edge_dst_[i] = dst[order[i]];
+  }
+  edges->clear();
+  edges->shrink_to_fit();
+  edge_index_.Init(std::move(ids));
+  RETURN_IF_NOT_OK(BuildFeatureColumns(sorted_edges, edge_features, &edge_features_));
+  return Status::OK();
+}
+
+template <typename T>
+Status CsrGraph::BuildFeatureColumns(const std::vector<std::shared_ptr<T>> &items,
+                                     const std::unordered_map<int8_t, std::unordered_set<FeatureType>> &feature_types,
+                                     std::unordered_map<FeatureType, FeatureColumn> *columns) {
+  for (const auto &types : feature_types) {
+    for (const auto &type : types.second) {
+      (*columns)[type].offsets.assign(items.size() + 1, 0);
+    }
+  }
+  // The size of every feature is known before copying, so that each column is allocated once
+  for (int pass = 0; pass < 2; ++pass) {
+    for (size_t i = 0; i < items.size(); ++i) {
+      auto itr = feature_types.find(items[i]->type());
+      if (itr == feature_types.end()) {
+        continue;
+      }
+      for (const auto &type : itr->second) {
+        std::shared_ptr<Feature> feature;
+        if (!items[i]->GetFeatures(type, &feature).IsOk()) {
+          continue;
+        }
+        FeatureColumn &column = (*columns)[type];
+        int64_t size = feature->Value()->SizeInBytes();
+        if (pass == 0) {
+          column.offsets[i + 1] = size;
+        } else if (size > 0) {
+          int ret = memcpy_s(column.data.data() + column.offsets[i], size, feature->Value()->GetBuffer(), size);
+          CHECK_FAIL_RETURN_UNEXPECTED(ret == EOK, "Failed to copy feature:" + std::to_string(type));
+        }
+      }
+    }
+    if (pass == 0) {
+      for (auto &itr : *columns) {
+        FeatureColumn &column = itr.second;
+        std::partial_sum(column.offsets.begin(), column.offsets.end(), column.offsets.begin());
+        column.data.resize(column.offsets.back());
+      }
+    }
+  }
+  return Status::OK();
+}
+
+void CsrGraph::GetFeature(const std::unordered_map<FeatureType, FeatureColumn> &columns, int32_t index,
+                          FeatureType feature_type, const uchar **data, int64_t *size) {
+  *data = nullptr;
+  *size = 0;
+  auto itr = columns.find(feature_type);
+  if (itr == columns.end()) {
+    return;
+  }
+  const FeatureColumn &column = itr->second;
+  int64_t begin = column.offsets[index];
+  if (column.offsets[index + 1] > begin) {
+    *data = column.data.data() + begin;
+    *size = column.offsets[index + 1] - begin;
+  }
+}
+
+Status CsrGraph::GetNodeIndex(NodeIdType id, int32_t *index) const {
+  *index = node_index_.Find(id);
+  if (*index < 0) {
+    std::string err_msg = "Invalid node id:" + std::to_string(id);
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  return Status::OK();
+}
+
+Status CsrGraph::CheckNodeId(NodeIdType id) const {
+  int32_t index;
+  return GetNodeIndex(id, &index);
+}
+
+Status CsrGraph::GetAllNeighbors(NodeIdType id, NodeType neighbor_type, bool exclude_itself,
+                                 std::vector<NodeIdType> *out_neighbors) const {
+  int32_t index;
+  RETURN_IF_NOT_OK(GetNodeIndex(id, &index));
+  std::vector<NodeIdType> neighbors;
+  if (!exclude_itself) {
+    neighbors.emplace_back(id);
+  }
+  auto itr = adjacency_.find(neighbor_type);
+  if (itr != adjacency_.end()) {
+    const Adjacency &adjacency = itr->second;
+    neighbors.reserve(neighbors.size() + adjacency.offsets[index + 1] - adjacency.offsets[index]);
+    for (int64_t i = adjacency.offsets[index]; i < adjacency.offsets[index + 1]; ++i) {
+      neighbors.emplace_back(node_index_.Id(adjacency.neighbors[i]));
+    }
+  }
+  *out_neighbors = std::move(neighbors);
+  return Status::OK();
+}
+
+Status CsrGraph::GetSampledNeighbors(NodeIdType id, NodeType neighbor_type, int32_t samples_num, CounterRng *rnd,
+                                     std::vector<NodeIdType> *out_neighbors) const {
+  int32_t index;
+  RETURN_IF_NOT_OK(GetNodeIndex(id, &index));
+  std::vector<NodeIdType> neighbors;
+  neighbors.reserve(samples_num);
+  auto itr = adjacency_.find(neighbor_type);
+  const int32_t *adjacent = nullptr;
+  int64_t degree = 0;
+  if (itr != adjacency_.end()) {
+    adjacent = itr->second.neighbors.data() + itr->second.offsets[index];
+    degree = itr->second.offsets[index + 1] - itr->second.offsets[index];
+  }
+  if (degree == 0) {
+    MS_LOG(DEBUG) << "There are no neighbors. node_id:" << id << " neighbor_type:" << neighbor_type;
+    // If there are no neighbors, they are filled with kDefaultNodeId
+    neighbors.assign(samples_num, kDefaultNodeId);
+  } else {
+    // Every round takes distinct neighbors in random order, a round costs the number of samples and not the degree
+    // of the node
+    while (neighbors.size() < static_cast<size_t>(samples_num)) {
+      LazyShuffle shuffle(degree);
+      while (neighbors.size() < static_cast<size_t>(samples_num) && !shuffle.Done()) {
+        neighbors.emplace_back(node_index_.Id(adjacent[shuffle.Next(rnd)]));
+      }
+    }
+  }
+  *out_neighbors = std::move(neighbors);
+  return Status::OK();
+}
+
+Status CsrGraph::GetNodesFromEdge(EdgeIdType id, std::pair<NodeIdType, NodeIdType> *out_nodes) const {
+  int32_t index = edge_index_.Find(id);
+  if (index < 0) {
+    std::string err_msg = "Invalid edge id:" + std::to_string(id);
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  *out_nodes = std::make_pair(node_index_.Id(edge_src_[index]), node_index_.Id(edge_dst_[index]));
+  return Status::OK();
+}
+
+Status CsrGraph::GetNodeFeature(NodeIdType id, FeatureType feature_type, const uchar **data, int64_t *size) const {
+  int32_t index;
+  RETURN_IF_NOT_OK(GetNodeIndex(id, &index));
+  GetFeature(node_features_, index, feature_type, data, size);
+  return Status::OK();
+}
+
+Status CsrGraph::GetEdgeFeature(EdgeIdType id, FeatureType feature_type, const uchar **data, int64_t *size) const {
+  int32_t index = edge_index_.Find(id);
+  if (index < 0) {
+    std::string err_msg = "Invalid edge id:" + std::to_string(id);
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  GetFeature(edge_features_, index, feature_type, data, size);
+  return Status::OK();
+}
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
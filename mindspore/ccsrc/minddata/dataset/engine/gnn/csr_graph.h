@@ -0,0 +1,164 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_CSR_GRAPH_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_CSR_GRAPH_H_
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/engine/gnn/edge.h"
+#include "minddata/dataset/engine/gnn/feature.h"
+#include "minddata/dataset/engine/gnn/node.h"
+#include "minddata/dataset/util/random.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+namespace gnn {
+
+// Compact storage of a graph in compressed sparse row format.
+// Node and edge ids are remapped to dense indices in id order, the neighbors of each node are stored in one
+// contiguous array per neighbor type and the features in one contiguous column per feature type. There is no
+// object per node or edge, which divides the memory used by large graphs and keeps sampling cache friendly.
+class CsrGraph {
+ public:
+  CsrGraph() = default;
+
+  ~CsrGraph() = default;
+
+  // Build the graph from the nodes and edges read by GraphLoader. Both lists are released during the build.
+  // @param std::vector<std::shared_ptr<Node>> *nodes - all the nodes, in loading order
+  // @param std::vector<std::shared_ptr<Edge>> *edges - all the edges, in loading order. Their nodes only carry ids
+  // @param std::unordered_map<NodeType, std::unordered_set<FeatureType>> &node_features - feature types of each
+  // node type
+  // @param std::unordered_map<EdgeType, std::unordered_set<FeatureType>> &edge_features - feature types of each
+  // edge type
+  // @return Status - The error code return
+  Status Build(std::vector<std::shared_ptr<Node>> *nodes, std::vector<std::shared_ptr<Edge>> *edges,
+               const std::unordered_map<NodeType, std::unordered_set<FeatureType>> &node_features,
+               const std::unordered_map<EdgeType, std::unordered_set<FeatureType>> &edge_features);
+
+  // @param NodeIdType id - node id
+  // @return Status - The error code return, an error if the node does not exist
+  Status CheckNodeId(NodeIdType id) const;
+
+  // Get the all neighbors of a node
+  // @param NodeIdType id - node id
+  // @param NodeType neighbor_type - type of neighbor
+  // @param bool exclude_itself - do not put the node itself in front of its neighbors
+  // @param std::vector<NodeIdType> *out_neighbors - Returned neighbors id
+  // @return Status - The error code return
+  Status GetAllNeighbors(NodeIdType id, NodeType neighbor_type, bool exclude_itself,
+                         std::vector<NodeIdType> *out_neighbors) const;
+
+  // Get the sampled neighbors of a node, same sampling as LocalNode::GetSampledNeighbors
+  // @param NodeIdType id - node id
+  // @param NodeType neighbor_type - type of neighbor
+  // @param int32_t samples_num - Number of neighbors to be acquired
+  // @param CounterRng *rnd - random generator
+  // @param std::vector<NodeIdType> *out_neighbors - Returned neighbors id
+  // @return Status - The error code return
+  Status GetSampledNeighbors(NodeIdType id, NodeType neighbor_type, int32_t samples_num, CounterRng *rnd,
+                             std::vector<NodeIdType> *out_neighbors) const;
+
+  // Get the source and destination of an edge
+  // @param EdgeIdType id - edge id
+  // @param std::pair<NodeIdType, NodeIdType> *out_nodes - Returned node ids
+  // @return Status - The error code return
+  Status GetNodesFromEdge(EdgeIdType id, std::pair<NodeIdType, NodeIdType> *out_nodes) const;
+
+  // Get the feature of a node
+  // @param NodeIdType id - node id
+  // @param FeatureType feature_type - type of feature
+  // @param const uchar **data - Returned feature data, nullptr if the node does not have the feature
+  // @param int64_t *size - Returned size in bytes of the feature data
+  // @return Status - The error code return
+  Status GetNodeFeature(NodeIdType id, FeatureType feature_type, const uchar **data, int64_t *size) const;
+
+  // Get the feature of an edge
+  // @param EdgeIdType id - edge id
+  // @param FeatureType feature_type - type of feature
+  // @param const uchar **data - Returned feature data, nullptr if the edge does not have the feature
+  // @param int64_t *size - Returned size in bytes of the feature data
+  // @return Status - The error code return
+  Status GetEdgeFeature(EdgeIdType id, FeatureType feature_type, const uchar **data, int64_t *size) const;
+
+ private:
+  // Dense indices of a sorted list of ids, the ids are not stored when they are consecutive
+  class IdIndex {
+   public:
+    // @param std::vector<int32_t> ids - sorted unique ids
+    void Init(std::vector<int32_t> ids);
+
+    // @return int32_t - the dense index of the id, -1 if the id does not exist
+    int32_t Find(int32_t id) const;
+
+    int32_t Id(int32_t index) const { return ids_.empty() ? first_ + index : ids_[index]; }
+
+    int32_t size() const { return size_; }
+
+   private:
+    int32_t first_ = 0;
+    int32_t size_ = 0;
+    std::vector<int32_t> ids_;
+  };
+
+  // Neighbors of one type for all the nodes, the neighbors of node i are neighbors[offsets[i]:offsets[i + 1]]
+  struct Adjacency {
+    std::vector<int64_t> offsets;
+    std::vector<int32_t> neighbors;
+  };
+
+  // One feature type for all the nodes or edges, the feature of row i is data[offsets[i]:offsets[i + 1]] and is
+  // empty when the row does not have the feature
+  struct FeatureColumn {
+    std::vector<int64_t> offsets;
+    std::vector<uchar> data;
+  };
+
+  Status BuildNodes(std::vector<std::shared_ptr<Node>> *nodes,
+                    const std::unordered_map<NodeType, std::unordered_set<FeatureType>> &node_features,
+                    std::vector<NodeType> *node_types);
+
+  Status BuildEdges(std::vector<std::shared_ptr<Edge>> *edges, const std::vector<NodeType> &node_types,
+                    const std::unordered_map<EdgeType, std::unordered_set<FeatureType>> &edge_features);
+
+  template <typename T>
+  static Status BuildFeatureColumns(const std::vector<std::shared_ptr<T>> &items,
+                                    const std::unordered_map<int8_t, std::unordered_set<FeatureType>> &feature_types,
+                                    std::unordered_map<FeatureType, FeatureColumn> *columns);
+
+  static void GetFeature(const std::unordered_map<FeatureType, FeatureColumn> &columns, int32_t index,
+                         FeatureType feature_type, const uchar **data, int64_t *size);
+
+  Status GetNodeIndex(NodeIdType id, int32_t *index) const;
+
+  IdIndex node_index_;
+  std::unordered_map<NodeType, Adjacency> adjacency_;
+  std::unordered_map<FeatureType, FeatureColumn> node_features_;
+
+  IdIndex edge_index_;
+  std::vector<int32_t> edge_src_;
+  std::vector<int32_t> edge_dst_;
+  std::unordered_map<FeatureType, FeatureColumn> edge_features_;
+};
+}  // namespace gnn
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_CSR_GRAPH_H_
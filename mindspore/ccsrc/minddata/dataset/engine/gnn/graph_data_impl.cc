@@ -24,16 +24,19 @@
 #include "minddata/dataset/core/tensor_shape.h"
 #include "minddata/dataset/engine/gnn/graph_loader.h"
 #include "minddata/dataset/util/random.h"
+#include "minddata/dataset/util/task_manager.h"
+#include "securec.h"
 namespace mindspore {
 namespace dataset {
 namespace gnn {
 
-GraphDataImpl::GraphDataImpl(std::string dataset_file, int32_t num_workers, bool server_mode)
+GraphDataImpl::GraphDataImpl(std::string dataset_file, int32_t num_workers, bool server_mode, bool csr_storage)
     : dataset_file_(dataset_file),
       num_workers_(num_workers),
       rnd_(GetRandomDevice()),
       random_walk_(this),
-      server_mode_(server_mode) {
+      server_mode_(server_mode),
+      csr_storage_(csr_storage) {
   rnd_.seed(GetSeed());
   MS_LOG(INFO) << "num_workers:" << num_workers;
 }
@@ -77,6 +80,30 @@ Status GraphDataImpl::CreateTensorByVector(const std::vector<std::vector<T>> &da
   return Status::OK();
 }
 
+Status GraphDataImpl::ParallelFor(size_t size, int32_t num_workers,
+                                  const std::function<Status(size_t, size_t)> &func) {
+  size_t num_tasks = (size + kMinItemsPerTask - 1) / kMinItemsPerTask;
+  num_tasks = std::min(num_tasks, static_cast<size_t>(std::max(num_workers, 1)));
+  if (num_tasks <= 1) {
+    return func(0, size);
+  }
+  TaskGroup vg;
+  Status rc;
+  size_t range_size = (size + num_tasks - 1) / num_tasks;
+  for (size_t begin = 0; begin < size && rc.IsOk(); begin += range_size) {
+    size_t end = std::min(begin + range_size, size);
+    rc = vg.CreateAsyncTask("GraphSampling", [&func, begin, end]() -> Status {
+      TaskManager::FindMe()->Post();
+      return func(begin, end);
+    });
+  }
+  // wait for threads to finish and check its return code
+  vg.join_all(Task::WaitFlag::kBlocking);
+  RETURN_IF_NOT_OK(rc);
+  RETURN_IF_NOT_OK(vg.GetTaskErrorIfAny());
+  return Status::OK();
+}
+
 template <typename T>
 Status GraphDataImpl::ComplementVector(std::vector<std::vector<T>> *data, size_t max_size, T default_value) {
   if (!data || data->empty()) {
@@ -114,6 +141,12 @@ Status GraphDataImpl::GetNodesFromEdges(const std::vector<EdgeIdType> &edge_list
   std::vector<std::vector<NodeIdType>> node_list;
   node_list.reserve(edge_list.size());
   for (const auto &edge_id : edge_list) {
+    if (csr_graph_ != nullptr) {
+      std::pair<NodeIdType, NodeIdType> nodes;
+      RETURN_IF_NOT_OK(csr_graph_->GetNodesFromEdge(edge_id, &nodes));
+      node_list.push_back({nodes.first, nodes.second});
+      continue;
+    }
     auto itr = edge_id_map_.find(edge_id);
     if (itr == edge_id_map_.end()) {
       std::string err_msg = "Invalid edge id:" + std::to_string(edge_id);
@@ -137,9 +170,7 @@ Status GraphDataImpl::GetAllNeighbors(const std::vector<NodeIdType> &node_list,
   size_t max_neighbor_num = 0;
   neighbors.resize(node_list.size());
   for (size_t i = 0; i < node_list.size(); ++i) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[i], &node));
-    RETURN_IF_NOT_OK(node->GetAllNeighbors(neighbor_type, &neighbors[i]));
+    RETURN_IF_NOT_OK(GetNodeNeighbors(node_list[i], neighbor_type, &neighbors[i]));
     max_neighbor_num = max_neighbor_num > neighbors[i].size() ? max_neighbor_num : neighbors[i].size();
   }
 
@@ -181,52 +212,68 @@ Status GraphDataImpl::GetSampledNeighbors(const std::vector<NodeIdType> &node_li
   for (const auto &type : neighbor_types) {
     RETURN_IF_NOT_OK(CheckNeighborType(type));
   }
+  size_t row_size = 1;
+  size_t hop_size = 1;
+  for (const auto &num : neighbor_nums) {
+    hop_size *= num;
+    row_size += hop_size;
+  }
+  // Each node draws from its own random stream, the result does not depend on the number of workers
+  const uint64_t seed = rnd_();
   std::vector<std::vector<NodeIdType>> neighbors_vec(node_list.size());
-  for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
-    std::shared_ptr<Node> input_node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &input_node));
-    neighbors_vec[node_idx].emplace_back(node_list[node_idx]);
-    std::vector<NodeIdType> input_list = {node_list[node_idx]};
-    for (size_t i = 0; i < neighbor_nums.size(); ++i) {
-      std::vector<NodeIdType> neighbors;
-      neighbors.reserve(input_list.size() * neighbor_nums[i]);
-      for (const auto &node_id : input_list) {
-        if (node_id == kDefaultNodeId) {
-          for (int32_t j = 0; j < neighbor_nums[i]; ++j) {
-            neighbors.emplace_back(kDefaultNodeId);
+  auto sample = [&](size_t begin, size_t end) -> Status {
+    for (size_t node_idx = begin; node_idx < end; ++node_idx) {
+      RETURN_IF_NOT_OK(CheckNodeId(node_list[node_idx]));
+      CounterRng rnd(seed, node_idx);
+      neighbors_vec[node_idx].reserve(row_size);
+      neighbors_vec[node_idx].emplace_back(node_list[node_idx]);
+      std::vector<NodeIdType> input_list = {node_list[node_idx]};
+      for (size_t i = 0; i < neighbor_nums.size(); ++i) {
+        std::vector<NodeIdType> neighbors;
+        neighbors.reserve(input_list.size() * neighbor_nums[i]);
+        for (const auto &node_id : input_list) {
+          if (node_id == kDefaultNodeId) {
+            for (int32_t j = 0; j < neighbor_nums[i]; ++j) {
+              neighbors.emplace_back(kDefaultNodeId);
+            }
+          } else {
+            std::vector<NodeIdType> out;
+            RETURN_IF_NOT_OK(GetNodeSampledNeighbors(node_id, neighbor_types[i], neighbor_nums[i], &rnd, &out));
+            neighbors.insert(neighbors.end(), out.begin(), out.end());
           }
-        } else {
-          std::shared_ptr<Node> node;
-          RETURN_IF_NOT_OK(GetNodeByNodeId(node_id, &node));
-          std::vector<NodeIdType> out;
-          RETURN_IF_NOT_OK(node->GetSampledNeighbors(neighbor_types[i], neighbor_nums[i], &out));
-          neighbors.insert(neighbors.end(), out.begin(), out.end());
         }
+        neighbors_vec[node_idx].insert(neighbors_vec[node_idx].end(), neighbors.begin(), neighbors.end());
+        input_list = std::move(neighbors);
       }
-      neighbors_vec[node_idx].insert(neighbors_vec[node_idx].end(), neighbors.begin(), neighbors.end());
-      input_list = std::move(neighbors);
     }
-  }
+    return Status::OK();
+  };
+  RETURN_IF_NOT_OK(ParallelFor(node_list.size(), num_workers_, sample));
   RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(neighbors_vec, DataType(DataType::DE_INT32), out));
   return Status::OK();
 }
 
 Status GraphDataImpl::NegativeSample(const std::vector<NodeIdType> &data,
                                      const std::unordered_set<NodeIdType> &exclude_data, int32_t samples_num,
-                                     std::vector<NodeIdType> *out_samples) {
+                                     CounterRng *rnd, std::vector<NodeIdType> *out_samples) {
   CHECK_FAIL_RETURN_UNEXPECTED(!data.empty(), "Input data is empty.");
-  std::vector<NodeIdType> shuffled_id(data.size());
-  std::iota(shuffled_id.begin(), shuffled_id.end(), 0);
-  std::shuffle(shuffled_id.begin(), shuffled_id.end(), rnd_);
-  for (const auto &index : shuffled_id) {
-    if (exclude_data.find(data[index]) != exclude_data.end()) {
-      continue;
-    }
-    out_samples->emplace_back(data[index]);
-    if (out_samples->size() >= samples_num) {
-      break;
+  const size_t size = out_samples->size() + samples_num;
+  // Every pass draws the nodes in a new random order, without shuffling all of them, until enough of them are not
+  // excluded
+  bool found = true;
+  while (out_samples->size() < size && found) {
+    found = false;
+    LazyShuffle shuffle(data.size());
+    while (out_samples->size() < size && !shuffle.Done()) {
+      NodeIdType node_id = data[shuffle.Next(rnd)];
+      if (exclude_data.find(node_id) == exclude_data.end()) {
+        out_samples->emplace_back(node_id);
+        found = true;
+      }
     }
   }
+  // If all the nodes are excluded, the samples are filled with kDefaultNodeId
+  out_samples->resize(size, kDefaultNodeId);
   return Status::OK();
 }
 
@@ -236,33 +283,33 @@ Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node
   RETURN_IF_NOT_OK(CheckSamplesNum(samples_num));
   RETURN_IF_NOT_OK(CheckNeighborType(neg_neighbor_type));
 
+  // Each node draws from its own random stream, the result does not depend on the number of workers
+  const uint64_t seed = rnd_();
+  const std::vector<NodeIdType> &all_nodes = node_type_map_.at(neg_neighbor_type);
   std::vector<std::vector<NodeIdType>> neg_neighbors_vec;
   neg_neighbors_vec.resize(node_list.size());
-  for (size_t node_idx = 0; node_idx < node_list.size(); ++node_idx) {
-    std::shared_ptr<Node> node;
-    RETURN_IF_NOT_OK(GetNodeByNodeId(node_list[node_idx], &node));
-    std::vector<NodeIdType> neighbors;
-    RETURN_IF_NOT_OK(node->GetAllNeighbors(neg_neighbor_type, &neighbors));
-    std::unordered_set<NodeIdType> exclude_nodes;
-    std::transform(neighbors.begin(), neighbors.end(),
-                   std::insert_iterator<std::unordered_set<NodeIdType>>(exclude_nodes, exclude_nodes.begin()),
-                   [](const NodeIdType node) { return node; });
-    const std::vector<NodeIdType> &all_nodes = node_type_map_[neg_neighbor_type];
-    neg_neighbors_vec[node_idx].emplace_back(node->id());
-    if (all_nodes.size() > exclude_nodes.size()) {
-      while (neg_neighbors_vec[node_idx].size() < samples_num + 1) {
-        RETURN_IF_NOT_OK(NegativeSample(all_nodes, exclude_nodes, samples_num - neg_neighbors_vec[node_idx].size(),
-                                        &neg_neighbors_vec[node_idx]));
-      }
-    } else {
-      MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << node->id()
-                    << " neg_neighbor_type:" << neg_neighbor_type;
-      // If there are no negative neighbors, they are filled with kDefaultNodeId
-      for (int32_t i = 0; i < samples_num; ++i) {
-        neg_neighbors_vec[node_idx].emplace_back(kDefaultNodeId);
+  auto sample = [&](size_t begin, size_t end) -> Status {
+    for (size_t node_idx = begin; node_idx < end; ++node_idx) {
+      std::vector<NodeIdType> neighbors;
+      RETURN_IF_NOT_OK(GetNodeNeighbors(node_list[node_idx], neg_neighbor_type, &neighbors));
+      std::unordered_set<NodeIdType> exclude_nodes(neighbors.begin(), neighbors.end());
+      CounterRng rnd(seed, node_idx);
+      neg_neighbors_vec[node_idx].reserve(samples_num + 1);
+      neg_neighbors_vec[node_idx].emplace_back(node_list[node_idx]);
+      if (all_nodes.size() > exclude_nodes.size()) {
+        RETURN_IF_NOT_OK(NegativeSample(all_nodes, exclude_nodes, samples_num, &rnd, &neg_neighbors_vec[node_idx]));
+      } else {
+        MS_LOG(DEBUG) << "There are no negative neighbors. node_id:" << node_list[node_idx]
+                      << " neg_neighbor_type:" << neg_neighbor_type;
+        // If there are no negative neighbors, they are filled with kDefaultNodeId
+        for (int32_t i = 0; i < samples_num; ++i) {
+          neg_neighbors_vec[node_idx].emplace_back(kDefaultNodeId);
+        }
       }
     }
-  }
+    return Status::OK();
+  };
+  RETURN_IF_NOT_OK(ParallelFor(node_list.size(), num_workers_, sample));
   RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>(neg_neighbors_vec, DataType(DataType::DE_INT32), out));
   return Status::OK();
 }
@@ -270,7 +317,8 @@ Status GraphDataImpl::GetNegSampledNeighbors(const std::vector<NodeIdType> &node
 Status GraphDataImpl::RandomWalk(const std::vector<NodeIdType> &node_list, const std::vector<NodeType> &meta_path,
                                  float step_home_param, float step_away_param, NodeIdType default_node,
                                  std::shared_ptr<Tensor> *out) {
-  RETURN_IF_NOT_OK(random_walk_.Build(node_list, meta_path, step_home_param, step_away_param, default_node));
+  RETURN_IF_NOT_OK(
+    random_walk_.Build(node_list, meta_path, step_home_param, step_away_param, default_node, 1, num_workers_));
   std::vector<std::vector<NodeIdType>> walks;
   RETURN_IF_NOT_OK(random_walk_.SimulateWalk(&walks));
   RETURN_IF_NOT_OK(CreateTensorByVector<NodeIdType>({walks}, DataType(DataType::DE_INT32), out));
@@ -318,20 +366,24 @@ Status GraphDataImpl::GetNodeFeature(const std::shared_ptr<Tensor> &nodes,
     std::shared_ptr<Tensor> fea_tensor;
     RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, default_feature->Value()->type(), &fea_tensor));
 
-    dsize_t index = 0;
-    for (auto node_itr = nodes->begin<NodeIdType>(); node_itr != nodes->end<NodeIdType>(); ++node_itr) {
-      std::shared_ptr<Feature> feature;
-      if (*node_itr == kDefaultNodeId) {
-        feature = default_feature;
-      } else {
-        std::shared_ptr<Node> node;
-        RETURN_IF_NOT_OK(GetNodeByNodeId(*node_itr, &node));
-        if (!node->GetFeatures(f_type, &feature).IsOk()) {
+    if (csr_graph_ != nullptr) {
+      RETURN_IF_NOT_OK(CopyCsrFeatures(nodes, f_type, true, default_feature->Value(), &fea_tensor));
+    } else {
+      dsize_t index = 0;
+      for (auto node_itr = nodes->begin<NodeIdType>(); node_itr != nodes->end<NodeIdType>(); ++node_itr) {
+        std::shared_ptr<Feature> feature;
+        if (*node_itr == kDefaultNodeId) {
           feature = default_feature;
+        } else {
+          std::shared_ptr<Node> node;
+          RETURN_IF_NOT_OK(GetNodeByNodeId(*node_itr, &node));
+          if (!node->GetFeatures(f_type, &feature).IsOk()) {
+            feature = default_feature;
+          }
         }
+        RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
+        index++;
       }
-      RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
-      index++;
     }
 
     TensorShape reshape(nodes->shape());
@@ -362,6 +414,21 @@ Status GraphDataImpl::GetNodeFeatureSharedMemory(const std::shared_ptr<Tensor> &
       ++out_fea_itr;
       *out_fea_itr = -1;
       ++out_fea_itr;
+    } else if (csr_graph_ != nullptr) {
+      const uchar *data = nullptr;
+      int64_t size = 0;
+      RETURN_IF_NOT_OK(csr_graph_->GetNodeFeature(*node_itr, type, &data, &size));
+      if (data == nullptr) {
+        *out_fea_itr = -1;
+        ++out_fea_itr;
+        *out_fea_itr = -1;
+        ++out_fea_itr;
+      } else {
+        for (int64_t i = 0; i < size / static_cast<int64_t>(sizeof(int64_t)); ++i) {
+          *out_fea_itr = reinterpret_cast<const int64_t *>(data)[i];
+          ++out_fea_itr;
+        }
+      }
     } else {
       std::shared_ptr<Node> node;
       RETURN_IF_NOT_OK(GetNodeByNodeId(*node_itr, &node));
@@ -406,16 +473,20 @@ Status GraphDataImpl::GetEdgeFeature(const std::shared_ptr<Tensor> &edges,
     std::shared_ptr<Tensor> fea_tensor;
     RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, default_feature->Value()->type(), &fea_tensor));
 
-    dsize_t index = 0;
-    for (auto edge_itr = edges->begin<EdgeIdType>(); edge_itr != edges->end<EdgeIdType>(); ++edge_itr) {
-      std::shared_ptr<Edge> edge;
-      RETURN_IF_NOT_OK(GetEdgeByEdgeId(*edge_itr, &edge));
-      std::shared_ptr<Feature> feature;
-      if (!edge->GetFeatures(f_type, &feature).IsOk()) {
-        feature = default_feature;
+    if (csr_graph_ != nullptr) {
+      RETURN_IF_NOT_OK(CopyCsrFeatures(edges, f_type, false, default_feature->Value(), &fea_tensor));
+    } else {
+      dsize_t index = 0;
+      for (auto edge_itr = edges->begin<EdgeIdType>(); edge_itr != edges->end<EdgeIdType>(); ++edge_itr) {
+        std::shared_ptr<Edge> edge;
+        RETURN_IF_NOT_OK(GetEdgeByEdgeId(*edge_itr, &edge));
+        std::shared_ptr<Feature> feature;
+        if (!edge->GetFeatures(f_type, &feature).IsOk()) {
+          feature = default_feature;
+        }
+        RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
+        index++;
       }
-      RETURN_IF_NOT_OK(fea_tensor->InsertTensor({index}, feature->Value()));
-      index++;
     }
 
     TensorShape reshape(edges->shape());
@@ -441,6 +512,23 @@ Status GraphDataImpl::GetEdgeFeatureSharedMemory(const std::shared_ptr<Tensor> &
 
   auto out_fea_itr = fea_tensor->begin<int64_t>();
   for (auto edge_itr = edges->begin<EdgeIdType>(); edge_itr != edges->end<EdgeIdType>(); ++edge_itr) {
+    if (csr_graph_ != nullptr) {
+      const uchar *data = nullptr;
+      int64_t size = 0;
+      RETURN_IF_NOT_OK(csr_graph_->GetEdgeFeature(*edge_itr, type, &data, &size));
+      if (data == nullptr) {
+        *out_fea_itr = -1;
+        ++out_fea_itr;
+        *out_fea_itr = -1;
+        ++out_fea_itr;
+      } else {
+        for (int64_t i = 0; i < size / static_cast<int64_t>(sizeof(int64_t)); ++i) {
+          *out_fea_itr = reinterpret_cast<const int64_t *>(data)[i];
+          ++out_fea_itr;
+        }
+      }
+      continue;
+    }
     std::shared_ptr<Edge> edge;
     RETURN_IF_NOT_OK(GetEdgeByEdgeId(*edge_itr, &edge));
     std::shared_ptr<Feature> feature;
@@ -552,6 +640,67 @@ Status GraphDataImpl::GetEdgeByEdgeId(EdgeIdType id, std::shared_ptr<Edge> *edge
   return Status::OK();
 }
 
+Status GraphDataImpl::CheckNodeId(NodeIdType id) {
+  if (csr_graph_ != nullptr) {
+    return csr_graph_->CheckNodeId(id);
+  }
+  std::shared_ptr<Node> node;
+  return GetNodeByNodeId(id, &node);
+}
+
+Status GraphDataImpl::GetNodeNeighbors(NodeIdType id, NodeType neighbor_type, std::vector<NodeIdType> *out_neighbors,
+                                       bool exclude_itself) {
+  if (csr_graph_ != nullptr) {
+    return csr_graph_->GetAllNeighbors(id, neighbor_type, exclude_itself, out_neighbors);
+  }
+  std::shared_ptr<Node> node;
+  RETURN_IF_NOT_OK(GetNodeByNodeId(id, &node));
+  return node->GetAllNeighbors(neighbor_type, out_neighbors, exclude_itself);
+}
+
+Status GraphDataImpl::GetNodeSampledNeighbors(NodeIdType id, NodeType neighbor_type, int32_t samples_num,
+                                              CounterRng *rnd, std::vector<NodeIdType> *out_neighbors) {
+  if (csr_graph_ != nullptr) {
+    return csr_graph_->GetSampledNeighbors(id, neighbor_type, samples_num, rnd, out_neighbors);
+  }
+  std::shared_ptr<Node> node;
+  RETURN_IF_NOT_OK(GetNodeByNodeId(id, &node));
+  return node->GetSampledNeighbors(neighbor_type, samples_num, rnd, out_neighbors);
+}
+
+Status GraphDataImpl::CopyCsrFeatures(const std::shared_ptr<Tensor> &ids, FeatureType feature_type, bool is_node,
+                                      const std::shared_ptr<Tensor> &default_value, std::shared_ptr<Tensor> *out) {
+  const int64_t row_size = default_value->SizeInBytes();
+  if (row_size == 0) {
+    return Status::OK();
+  }
+  uchar *out_ptr = nullptr;
+  TensorShape remaining = TensorShape::CreateUnknownRankShape();
+  RETURN_IF_NOT_OK((*out)->StartAddrOfIndex({0}, &out_ptr, &remaining));
+  // The rows are copied straight from the feature column, the default value fills the ones without the feature
+  for (auto itr = ids->begin<int32_t>(); itr != ids->end<int32_t>(); ++itr) {
+    const uchar *data = nullptr;
+    int64_t size = 0;
+    if (!is_node) {
+      RETURN_IF_NOT_OK(csr_graph_->GetEdgeFeature(*itr, feature_type, &data, &size));
+    } else if (*itr != kDefaultNodeId) {
+      RETURN_IF_NOT_OK(csr_graph_->GetNodeFeature(*itr, feature_type, &data, &size));
+    }
+    if (data == nullptr) {
+      data = default_value->GetBuffer();
+      size = row_size;
+    }
+    if (size != row_size) {
+      std::string err_msg = "The size of feature " + std::to_string(feature_type) + " of id " + std::to_string(*itr) +
+                            " is different from the default feature.";
+      RETURN_STATUS_UNEXPECTED(err_msg);
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(memcpy_s(out_ptr, row_size, data, row_size) == EOK, "Failed to copy feature.");
+    out_ptr += row_size;
+  }
+  return Status::OK();
+}
+
 GraphDataImpl::RandomWalkBase::RandomWalkBase(GraphDataImpl *graph)
     : graph_(graph), step_home_param_(1.0), step_away_param_(1.0), default_node_(-1), num_walks_(1), num_workers_(1) {}
 
@@ -596,35 +745,36 @@ Status GraphDataImpl::RandomWalkBase::Build(const std::vector<NodeIdType> &node_
   return Status::OK();
 }
 
-Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node, std::vector<NodeIdType> *walk_path) {
+Status GraphDataImpl::RandomWalkBase::Node2vecWalk(NodeIdType start_node, CounterRng *rnd, TransitionCache *cache,
+                                                   std::vector<NodeIdType> *walk_path) {
   // Simulate a random walk starting from start node.
   auto walk = std::vector<NodeIdType>(1, start_node);  // walk is an vector
+  walk.reserve(meta_path_.size() + 1);
   // walk simulate
   while (walk.size() - 1 < meta_path_.size()) {
-    // current nodE
+    // current node
     auto cur_node_id = walk.back();
-    std::shared_ptr<Node> cur_node;
-    RETURN_IF_NOT_OK(graph_->GetNodeByNodeId(cur_node_id, &cur_node));
-
-    // current neighbors
-    std::vector<NodeIdType> cur_neighbors;
-    RETURN_IF_NOT_OK(cur_node->GetAllNeighbors(meta_path_[walk.size() - 1], &cur_neighbors, true));
-    std::sort(cur_neighbors.begin(), cur_neighbors.end());
-
-    // break if no neighbors
-    if (cur_neighbors.empty()) {
-      break;
-    }
-
-    // walk by the fist node, then by the previous 2 nodes
-    std::shared_ptr<StochasticIndex> stochastic_index;
+    NodeIdType next_node_id;
     if (walk.size() == 1) {
-      RETURN_IF_NOT_OK(GetNodeProbability(cur_node_id, meta_path_[0], &stochastic_index));
+      // walk by the first node, all its neighbors have the same probability
+      std::vector<NodeIdType> cur_neighbors;
+      RETURN_IF_NOT_OK(graph_->GetNodeNeighbors(cur_node_id, meta_path_[0], &cur_neighbors, true));
+      // break if no neighbors
+      if (cur_neighbors.empty()) {
+        break;
+      }
+      std::uniform_int_distribution<size_t> distribution(0, cur_neighbors.size() - 1);
+      next_node_id = cur_neighbors[distribution(*rnd)];
     } else {
-      NodeIdType prev_node_id = walk[walk.size() - 2];
-      RETURN_IF_NOT_OK(GetEdgeProbability(prev_node_id, cur_node_id, walk.size() - 2, &stochastic_index));
+      // then by the previous 2 nodes
+      const Transition *transition = nullptr;
+      RETURN_IF_NOT_OK(GetTransition(walk[walk.size() - 2], cur_node_id, walk.size() - 2, cache, &transition));
+      // break if no neighbors
+      if (transition->dst_neighbors.empty()) {
+        break;
+      }
+      next_node_id = transition->dst_neighbors[WalkToNextNode(transition->alias, rnd)];
     }
-    NodeIdType next_node_id = cur_neighbors[WalkToNextNode(*stochastic_index)];
     walk.push_back(next_node_id);
   }
 
@@ -637,53 +787,47 @@ Status GraphDataImpl::RandomWalkBase::Node2vecWalk(const NodeIdType &start_node,
 }
 
 Status GraphDataImpl::RandomWalkBase::SimulateWalk(std::vector<std::vector<NodeIdType>> *walks) {
-  for (int32_t i = 0; i < num_walks_; ++i) {
-    for (const auto &node : node_list_) {
-      std::vector<NodeIdType> walk;
-      RETURN_IF_NOT_OK(Node2vecWalk(node, &walk));
-      walks->push_back(walk);
+  // Walk i starts from node i % node_list_.size() and draws from its own random stream, the walks do not depend on
+  // the number of workers
+  const uint64_t seed = graph_->rnd_();
+  const size_t num_nodes = node_list_.size();
+  walks->resize(num_walks_ * num_nodes);
+  auto walk = [&](size_t begin, size_t end) -> Status {
+    TransitionCache cache;
+    for (size_t i = begin; i < end; ++i) {
+      CounterRng rnd(seed, i);
+      RETURN_IF_NOT_OK(Node2vecWalk(node_list_[i % num_nodes], &rnd, &cache, &(*walks)[i]));
     }
-  }
+    return Status::OK();
+  };
+  RETURN_IF_NOT_OK(ParallelFor(walks->size(), num_workers_, walk));
   return Status::OK();
 }
 
-Status GraphDataImpl::RandomWalkBase::GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
-                                                         std::shared_ptr<StochasticIndex> *node_probability) {
-  // Generate alias nodes
-  std::shared_ptr<Node> node;
-  graph_->GetNodeByNodeId(node_id, &node);
-  std::vector<NodeIdType> neighbors;
-  RETURN_IF_NOT_OK(node->GetAllNeighbors(node_type, &neighbors, true));
-  std::sort(neighbors.begin(), neighbors.end());
-  auto non_normalized_probability = std::vector<float>(neighbors.size(), 1.0);
-  *node_probability =
-    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
-  return Status::OK();
-}
-
-Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const NodeIdType &src, const NodeIdType &dst,
-                                                         uint32_t meta_path_index,
-                                                         std::shared_ptr<StochasticIndex> *edge_probability) {
+Status GraphDataImpl::RandomWalkBase::GetTransition(NodeIdType src, NodeIdType dst, uint32_t meta_path_index,
+                                                    TransitionCache *cache, const Transition **transition) {
+  TransitionKey key = {src, dst, meta_path_[meta_path_index], meta_path_[meta_path_index + 1]};
+  auto itr = cache->find(key);
+  if (itr != cache->end()) {
+    *transition = &itr->second;
+    return Status::OK();
+  }
   // Get the alias edge setup lists for a given edge.
-  std::shared_ptr<Node> src_node;
-  graph_->GetNodeByNodeId(src, &src_node);
   std::vector<NodeIdType> src_neighbors;
-  RETURN_IF_NOT_OK(src_node->GetAllNeighbors(meta_path_[meta_path_index], &src_neighbors, true));
+  RETURN_IF_NOT_OK(graph_->GetNodeNeighbors(src, key.src_type, &src_neighbors, true));
+  std::sort(src_neighbors.begin(), src_neighbors.end());
 
-  std::shared_ptr<Node> dst_node;
-  graph_->GetNodeByNodeId(dst, &dst_node);
-  std::vector<NodeIdType> dst_neighbors;
-  RETURN_IF_NOT_OK(dst_node->GetAllNeighbors(meta_path_[meta_path_index + 1], &dst_neighbors, true));
-
-  std::sort(dst_neighbors.begin(), dst_neighbors.end());
+  Transition result;
+  RETURN_IF_NOT_OK(graph_->GetNodeNeighbors(dst, key.dst_type, &result.dst_neighbors, true));
+  std::sort(result.dst_neighbors.begin(), result.dst_neighbors.end());
   std::vector<float> non_normalized_probability;
-  for (const auto &dst_nbr : dst_neighbors) {
+  non_normalized_probability.reserve(result.dst_neighbors.size());
+  for (const auto &dst_nbr : result.dst_neighbors) {
     if (dst_nbr == src) {
       non_normalized_probability.push_back(1.0 / step_home_param_);  // replace 1.0 with G[dst][dst_nbr]['weight']
       continue;
     }
-    auto it = std::find(src_neighbors.begin(), src_neighbors.end(), dst_nbr);
-    if (it != src_neighbors.end()) {
+    if (std::binary_search(src_neighbors.begin(), src_neighbors.end(), dst_nbr)) {
       // stay close, this node connect both src and dst
       non_normalized_probability.push_back(1.0);  // replace 1.0 with G[dst][dst_nbr]['weight']
     } else {
@@ -691,25 +835,24 @@ Status GraphDataImpl::RandomWalkBase::GetEdgeProbability(const NodeIdType &src,
       non_normalized_probability.push_back(1.0 / step_away_param_);  // replace 1.0 with G[dst][dst_nbr]['weight']
     }
   }
+  result.alias = GenerateProbability(Normalize<float>(non_normalized_probability));
 
-  *edge_probability =
-    std::make_shared<StochasticIndex>(GenerateProbability(Normalize<float>(non_normalized_probability)));
+  if (cache->size() >= kMaxCachedTransitions) {
+    cache->clear();
+  }
+  *transition = &cache->emplace(key, std::move(result)).first->second;
   return Status::OK();
 }
 
 StochasticIndex GraphDataImpl::RandomWalkBase::GenerateProbability(const std::vector<float> &probability) {
+  // Alias table of Vose's method
   uint32_t K = probability.size();
   std::vector<int32_t> switch_to_large_index(K, 0);
   std::vector<float> weight(K, .0);
   std::vector<int32_t> smaller;
   std::vector<int32_t> larger;
-  auto random_device = GetRandomDevice();
-  std::uniform_real_distribution<> distribution(-kGnnEpsilon, kGnnEpsilon);
-  float accumulate_threshold = 0.0;
   for (uint32_t i = 0; i < K; i++) {
-    float threshold_one = distribution(random_device);
-    accumulate_threshold += threshold_one;
-    weight[i] = i < K - 1 ? probability[i] * K + threshold_one : probability[i] * K - accumulate_threshold;
+    weight[i] = probability[i] * K;
     weight[i] < 1.0 ? smaller.push_back(i) : larger.push_back(i);
   }
 
@@ -722,21 +865,27 @@ StochasticIndex GraphDataImpl::RandomWalkBase::GenerateProbability(const std::ve
     weight[large] = weight[large] + weight[small] - 1.0;
     weight[large] < 1.0 ? smaller.push_back(large) : larger.push_back(large);
   }
+  // The weights left are 1 up to rounding errors
+  for (const auto &i : smaller) {
+    weight[i] = 1.0;
+  }
+  for (const auto &i : larger) {
+    weight[i] = 1.0;
+  }
   return StochasticIndex(switch_to_large_index, weight);
 }
 
-uint32_t GraphDataImpl::RandomWalkBase::WalkToNextNode(const StochasticIndex &stochastic_index) {
-  auto switch_to_large_index = stochastic_index.first;
-  auto weight = stochastic_index.second;
+uint32_t GraphDataImpl::RandomWalkBase::WalkToNextNode(const StochasticIndex &stochastic_index, CounterRng *rnd) {
+  const auto &switch_to_large_index = stochastic_index.first;
+  const auto &weight = stochastic_index.second;
   const uint32_t size_of_index = switch_to_large_index.size();
 
-  auto random_device = GetRandomDevice();
-  std::uniform_real_distribution<> distribution(0.0, 1.0);
-
   // Generate random integer between [0, K)
-  uint32_t random_idx = std::floor(distribution(random_device) * size_of_index);
+  std::uniform_int_distribution<uint32_t> index_distribution(0, size_of_index - 1);
+  uint32_t random_idx = index_distribution(*rnd);
 
-  if (distribution(random_device) < weight[random_idx]) {
+  std::uniform_real_distribution<float> distribution(0.0, 1.0);
+  if (distribution(*rnd) < weight[random_idx]) {
     return random_idx;
   }
   return switch_to_large_index[random_idx];
@@ -744,8 +893,7 @@ uint32_t GraphDataImpl::RandomWalkBase::WalkToNextNode(const StochasticIndex &st
 
 template <typename T>
 std::vector<float> GraphDataImpl::RandomWalkBase::Normalize(const std::vector<T> &non_normalized_probability) {
-  float sum_probability =
-    1.0 * std::accumulate(non_normalized_probability.begin(), non_normalized_probability.end(), 0);
+  float sum_probability = std::accumulate(non_normalized_probability.begin(), non_normalized_probability.end(), 0.0f);
   if (sum_probability < kGnnEpsilon) {
     sum_probability = 1.0;
   }
@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_GNN_GRAPH_DATA_IMPL_H_
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <string>
 #include <map>
@@ -25,6 +26,7 @@
 #include <vector>
 #include <utility>
 
+#include "minddata/dataset/engine/gnn/csr_graph.h"
 #include "minddata/dataset/engine/gnn/graph_data.h"
 #if !defined(_WIN32) && !defined(_WIN64)
 #include "minddata/dataset/engine/gnn/graph_shared_memory.h"
@@ -37,6 +39,8 @@ namespace gnn {
 
 const float kGnnEpsilon = 0.0001;
 const uint32_t kMaxNumWalks = 80;
+const size_t kMinItemsPerTask = 128;          // Smaller batches of nodes or walks are sampled by the calling thread
+const size_t kMaxCachedTransitions = 100000;  // Alias tables kept by each random walk task
 using StochasticIndex = std::pair<std::vector<int32_t>, std::vector<float>>;
 
 class GraphDataImpl : public GraphData {
@@ -44,7 +48,9 @@ class GraphDataImpl : public GraphData {
   // Constructor
   // @param std::string dataset_file -
   // @param int32_t num_workers - number of parallel threads
-  GraphDataImpl(std::string dataset_file, int32_t num_workers, bool server_mode = false);
+  // @param bool server_mode - load the features into shared memory
+  // @param bool csr_storage - store the graph in compressed sparse row format instead of one object per node and edge
+  GraphDataImpl(std::string dataset_file, int32_t num_workers, bool server_mode = false, bool csr_storage = false);
 
   ~GraphDataImpl();
 
@@ -175,17 +181,55 @@ class GraphDataImpl : public GraphData {
     Status SimulateWalk(std::vector<std::vector<NodeIdType>> *walks);
 
    private:
-    Status Node2vecWalk(const NodeIdType &start_node, std::vector<NodeIdType> *walk_path);
-
-    Status GetNodeProbability(const NodeIdType &node_id, const NodeType &node_type,
-                              std::shared_ptr<StochasticIndex> *node_probability);
-
-    Status GetEdgeProbability(const NodeIdType &src, const NodeIdType &dst, uint32_t meta_path_index,
-                              std::shared_ptr<StochasticIndex> *edge_probability);
+    // Step from dst when the walk comes from src, dst_neighbors are in the order of the alias table
+    struct TransitionKey {
+      NodeIdType src;
+      NodeIdType dst;
+      NodeType src_type;
+      NodeType dst_type;
+
+      bool operator==(const TransitionKey &other) const {
+        return src == other.src && dst == other.dst && src_type == other.src_type && dst_type == other.dst_type;
+      }
+    };
+
+    struct TransitionKeyHash {
+      size_t operator()(const TransitionKey &key) const {
+        uint64_t nodes = (static_cast<uint64_t>(static_cast<uint32_t>(key.src)) << 32) | static_cast<uint32_t>(key.dst);
+        uint64_t types = (static_cast<uint64_t>(static_cast<uint8_t>(key.src_type)) << 8) |
+                         static_cast<uint8_t>(key.dst_type);
+        return std::hash<uint64_t>()(nodes ^ (types * 0x9E3779B97F4A7C15ULL));
+      }
+    };
+
+    struct Transition {
+      std::vector<NodeIdType> dst_neighbors;
+      StochasticIndex alias;
+    };
+
+    using TransitionCache = std::unordered_map<TransitionKey, Transition, TransitionKeyHash>;
+
+    // @param NodeIdType start_node - first node of the walk
+    // @param CounterRng *rnd - random generator of the walk
+    // @param TransitionCache *cache - alias tables already computed by the task
+    // @param std::vector<NodeIdType> *walk_path - Returned walk
+    // @return Status - The error code return
+    Status Node2vecWalk(NodeIdType start_node, CounterRng *rnd, TransitionCache *cache,
+                        std::vector<NodeIdType> *walk_path);
+
+    // Get the alias table of the step from dst, coming from src, computed once per task
+    // @param NodeIdType src - previous node of the walk
+    // @param NodeIdType dst - current node of the walk
+    // @param uint32_t meta_path_index - index of the step to dst in the meta path
+    // @param TransitionCache *cache - alias tables already computed by the task
+    // @param const Transition **transition - Returned alias table
+    // @return Status - The error code return
+    Status GetTransition(NodeIdType src, NodeIdType dst, uint32_t meta_path_index, TransitionCache *cache,
+                         const Transition **transition);
 
     static StochasticIndex GenerateProbability(const std::vector<float> &probability);
 
-    static uint32_t WalkToNextNode(const StochasticIndex &stochastic_index);
+    static uint32_t WalkToNextNode(const StochasticIndex &stochastic_index, CounterRng *rnd);
 
     template <typename T>
     std::vector<float> Normalize(const std::vector<T> &non_normalized_probability);
@@ -221,6 +265,13 @@ class GraphDataImpl : public GraphData {
   template <typename T>
   Status ComplementVector(std::vector<std::vector<T>> *data, size_t max_size, T default_value);
 
+  // Run func on the ranges of a batch of items, with one task per range when the batch is large enough
+  // @param size_t size - number of items
+  // @param int32_t num_workers - maximum number of tasks
+  // @param std::function<Status(size_t, size_t)> func - processes the items [begin, end)
+  // @return Status - The error code return, the first error of the tasks
+  static Status ParallelFor(size_t size, int32_t num_workers, const std::function<Status(size_t, size_t)> &func);
+
   // Get the default feature of a node
   // @param FeatureType feature_type -
   // @param std::shared_ptr<Feature> *out_feature - Returned feature
@@ -245,14 +296,49 @@ class GraphDataImpl : public GraphData {
   // @return Status - The error code return
   Status GetEdgeByEdgeId(EdgeIdType id, std::shared_ptr<Edge> *edge);
 
+  // Check that a node exists, in either storage
+  // @param NodeIdType id -
+  // @return Status - The error code return
+  Status CheckNodeId(NodeIdType id);
+
+  // Get the all neighbors of a node, in either storage
+  // @param NodeIdType id -
+  // @param NodeType neighbor_type - type of neighbor
+  // @param std::vector<NodeIdType> *out_neighbors - Returned neighbors id
+  // @param bool exclude_itself - do not put the node itself in front of its neighbors
+  // @return Status - The error code return
+  Status GetNodeNeighbors(NodeIdType id, NodeType neighbor_type, std::vector<NodeIdType> *out_neighbors,
+                          bool exclude_itself = false);
+
+  // Get the sampled neighbors of a node, in either storage
+  // @param NodeIdType id -
+  // @param NodeType neighbor_type - type of neighbor
+  // @param int32_t samples_num - Number of neighbors to be acquired
+  // @param CounterRng *rnd - random generator
+  // @param std::vector<NodeIdType> *out_neighbors - Returned neighbors id
+  // @return Status - The error code return
+  Status GetNodeSampledNeighbors(NodeIdType id, NodeType neighbor_type, int32_t samples_num, CounterRng *rnd,
+                                 std::vector<NodeIdType> *out_neighbors);
+
+  // Copy the features of nodes or edges from the columns of the CSR graph
+  // @param std::shared_ptr<Tensor> ids - List of nodes or edges
+  // @param FeatureType feature_type -
+  // @param bool is_node - whether ids are nodes or edges
+  // @param std::shared_ptr<Tensor> default_value - used for the ids without the feature
+  // @param std::shared_ptr<Tensor> *out - Tensor of the ids followed by the shape of the feature
+  // @return Status - The error code return
+  Status CopyCsrFeatures(const std::shared_ptr<Tensor> &ids, FeatureType feature_type, bool is_node,
+                         const std::shared_ptr<Tensor> &default_value, std::shared_ptr<Tensor> *out);
+
   // Negative sampling
   // @param std::vector<NodeIdType> &input_data - The data set to be sampled
   // @param std::unordered_set<NodeIdType> &exclude_data - Data to be excluded
-  // @param int32_t samples_num -
+  // @param int32_t samples_num - Number of samples appended to out_samples
+  // @param CounterRng *rnd - random generator
   // @param std::vector<NodeIdType> *out_samples - Sampling results returned
   // @return Status - The error code return
   Status NegativeSample(const std::vector<NodeIdType> &input_data, const std::unordered_set<NodeIdType> &exclude_data,
-                        int32_t samples_num, std::vector<NodeIdType> *out_samples);
+                        int32_t samples_num, CounterRng *rnd, std::vector<NodeIdType> *out_samples);
 
   Status CheckSamplesNum(NodeIdType samples_num);
 
@@ -260,10 +346,12 @@ class GraphDataImpl : public GraphData {
 
   std::string dataset_file_;
   int32_t num_workers_;  // The number of worker threads
-  std::mt19937 rnd_;
+  std::mt19937 rnd_;     // Draws the seed of each sampling call, the nodes or walks then have their own CounterRng
   RandomWalkBase random_walk_;
   mindrecord::json data_schema_;
   bool server_mode_;
+  bool csr_storage_;
+  std::unique_ptr<CsrGraph> csr_graph_;  // Only built with csr_storage_, the node and edge maps are then empty
 #if !defined(_WIN32) && !defined(_WIN64)
   std::unique_ptr<GraphSharedMemory> graph_shared_memory_;
 #endif
@@ -42,6 +42,9 @@ GraphLoader::GraphLoader(GraphDataImpl *graph_impl, std::string mr_filepath, int
       keys_({"first_id", "second_id", "third_id", "attribute", "type", "node_feature_index", "edge_feature_index"}) {}
 
 Status GraphLoader::GetNodesAndEdges() {
+  if (graph_impl_->csr_storage_) {
+    return BuildCsrGraph();
+  }
   NodeIdMap *n_id_map = &graph_impl_->node_id_map_;
   EdgeIdMap *e_id_map = &graph_impl_->edge_id_map_;
   for (std::deque<std::shared_ptr<Node>> &dq : n_deques_) {
@@ -76,6 +79,35 @@ Status GraphLoader::GetNodesAndEdges() {
   return Status::OK();
 }
 
+Status GraphLoader::BuildCsrGraph() {
+  std::vector<std::shared_ptr<Node>> nodes;
+  for (std::deque<std::shared_ptr<Node>> &dq : n_deques_) {
+    for (std::shared_ptr<Node> &node_ptr : dq) {
+      graph_impl_->node_type_map_[node_ptr->type()].push_back(node_ptr->id());
+      nodes.emplace_back(std::move(node_ptr));
+    }
+    dq.clear();
+  }
+
+  std::vector<std::shared_ptr<Edge>> edges;
+  for (std::deque<std::shared_ptr<Edge>> &dq : e_deques_) {
+    for (std::shared_ptr<Edge> &edge_ptr : dq) {
+      graph_impl_->edge_type_map_[edge_ptr->type()].push_back(edge_ptr->id());
+      edges.emplace_back(std::move(edge_ptr));
+    }
+    dq.clear();
+  }
+
+  for (auto &itr : graph_impl_->node_type_map_) itr.second.shrink_to_fit();
+  for (auto &itr : graph_impl_->edge_type_map_) itr.second.shrink_to_fit();
+
+  MergeFeatureMaps();
+  graph_impl_->csr_graph_ = std::make_unique<CsrGraph>();
+  RETURN_IF_NOT_OK(graph_impl_->csr_graph_->Build(&nodes, &edges, graph_impl_->node_feature_map_,
+                                                  graph_impl_->edge_feature_map_));
+  return Status::OK();
+}
+
 Status GraphLoader::InitAndLoad() {
   CHECK_FAIL_RETURN_UNEXPECTED(num_workers_ > 0, "num_reader can't be < 1\n");
   CHECK_FAIL_RETURN_UNEXPECTED(row_id_ == 0, "InitAndLoad Can only be called once!\n");
@@ -98,6 +98,10 @@ class GraphLoader {
   // merge NodeFeatureMap and EdgeFeatureMap of each worker into 1
   void MergeFeatureMaps();
 
+  // move all nodes and edges into the CSR graph of graph_impl_ instead of connecting them
+  // @return Status - the status code
+  Status BuildCsrGraph();
+
   GraphDataImpl *graph_impl_;
   std::string mr_path_;
   const int32_t num_workers_;
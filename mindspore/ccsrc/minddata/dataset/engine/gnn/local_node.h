@@ -53,9 +53,10 @@ class LocalNode : public Node {
   // Get the sampled neighbors of a node
   // @param NodeType neighbor_type - type of neighbor
   // @param int32_t samples_num - Number of neighbors to be acquired
+  // @param CounterRng *rnd - random generator
   // @param std::vector<NodeIdType> *out_neighbors - Returned neighbors id
   // @return Status - The error code return
-  Status GetSampledNeighbors(NodeType neighbor_type, int32_t samples_num,
+  Status GetSampledNeighbors(NodeType neighbor_type, int32_t samples_num, CounterRng *rnd,
                              std::vector<NodeIdType> *out_neighbors) override;
 
   // Add neighbor of node
@@ -69,10 +70,6 @@ class LocalNode : public Node {
   Status UpdateFeature(const std::shared_ptr<Feature> &feature) override;
 
  private:
-  Status GetSampledNeighbors(const std::vector<std::shared_ptr<Node>> &neighbors, int32_t samples_num,
-                             std::vector<NodeIdType> *out);
-
-  std::mt19937 rnd_;
   std::unordered_map<FeatureType, std::shared_ptr<Feature>> features_;
   std::unordered_map<NodeType, std::vector<std::shared_ptr<Node>>> neighbor_nodes_;
 };
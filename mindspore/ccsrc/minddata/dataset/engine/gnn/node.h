@@ -21,6 +21,7 @@
 #include <vector>
 
 #include "minddata/dataset/engine/gnn/feature.h"
+#include "minddata/dataset/util/random.h"
 #include "minddata/dataset/util/status.h"
 
 namespace mindspore {
@@ -62,9 +63,10 @@ class Node {
   // Get the sampled neighbors of a node
   // @param NodeType neighbor_type - type of neighbor
   // @param int32_t samples_num - Number of neighbors to be acquired
+  // @param CounterRng *rnd - random generator
   // @param std::vector<NodeIdType> *out_neighbors - Returned neighbors id
   // @return Status - The error code return
-  virtual Status GetSampledNeighbors(NodeType neighbor_type, int32_t samples_num,
+  virtual Status GetSampledNeighbors(NodeType neighbor_type, int32_t samples_num, CounterRng *rnd,
                                      std::vector<NodeIdType> *out_neighbors) = 0;
 
   // Add neighbor of node
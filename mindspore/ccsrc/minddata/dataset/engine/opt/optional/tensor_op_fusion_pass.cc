@@ -14,44 +14,160 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
-#include "minddata/dataset/kernels/image/decode_op.h"
 #include "minddata/dataset/engine/datasetops/map_op/map_op.h"
+#include "minddata/dataset/kernels/data/type_cast_op.h"
+#include "minddata/dataset/kernels/image/center_crop_op.h"
+#include "minddata/dataset/kernels/image/decode_center_crop_op.h"
+#include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/fused_normalize_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "minddata/dataset/kernels/image/rescale_op.h"
 
 namespace mindspore {
 namespace dataset {
+namespace {
+bool IsFloatType(const DataType &type) {
+  return type == DataType::DE_FLOAT16 || type == DataType::DE_FLOAT32 || type == DataType::DE_FLOAT64;
+}
 
-Status TensorOpFusionPass::RunOnNode(std::shared_ptr<MapOp> node, bool *modified) {
-  // Most primitive pattern: DecodeOp immediately followed by RandomCropAndResizeOp
-  // Abstract into a more general member function that can find any pattern, expressed
-  // by regular expressions, for instance.
-  // Add a list of optimisation policies. For now, just this lambda
-  auto FindPattern = [](auto &tfuncs) {
-    auto it =
-      std::find_if(tfuncs.begin(), tfuncs.end(), [](const auto &tf) -> bool { return tf->Name() == kDecodeOp; });
-    auto next = it + 1;
-    if (it != tfuncs.end() && next != tfuncs.end() && (*next)->Name() == kRandomCropAndResizeOp) {
-      return it;
-    } else {
-      return tfuncs.end();
-    }
-  };
+// The fused kernels decode to RGB
+bool IsRgbDecode(const std::shared_ptr<TensorOp> &op) { return static_cast<DecodeOp *>(op.get())->is_rgb_format(); }
 
-  auto &tfuncs = node->TFuncs();
-  auto it = FindPattern(tfuncs);
-  if (it != tfuncs.end()) {
-    auto next = it + 1;
-    auto op = static_cast<RandomCropAndResizeOp *>(next->get());
-    *it = std::static_pointer_cast<TensorOp>(std::make_shared<RandomCropDecodeResizeOp>(*op));
-    tfuncs.erase(next);
+std::shared_ptr<FusedNormalizeOp> FuseNormalize(const std::shared_ptr<TensorOp> &op, float rescale, float shift) {
+  std::vector<float> mean;
+  std::vector<float> stddev;
+  if (static_cast<NormalizeOp *>(op.get())->GetMeanStd(&mean, &stddev).IsError()) {
+    return nullptr;
   }
-  if (modified != nullptr) {
-    *modified = true;
-  } else {
+  return std::make_shared<FusedNormalizeOp>(rescale, shift, std::move(mean), std::move(stddev));
+}
+
+std::vector<TensorOpFusionPass::FusionRule> BuiltinRules() {
+  using Ops = std::vector<std::shared_ptr<TensorOp>>;
+  std::vector<TensorOpFusionPass::FusionRule> rules;
+  // Decode only the window which is cropped
+  rules.push_back({"RandomCropDecodeResize", {kDecodeOp, kRandomCropAndResizeOp},
+                   [](const Ops &ops, std::shared_ptr<TensorOp> *fused) {
+                     if (IsRgbDecode(ops[0])) {
+                       auto op = static_cast<RandomCropAndResizeOp *>(ops[1].get());
+                       *fused = std::make_shared<RandomCropDecodeResizeOp>(*op);
+                     }
+                     return Status::OK();
+                   }});
+  rules.push_back({"DecodeCenterCrop", {kDecodeOp, kCenterCropOp},
+                   [](const Ops &ops, std::shared_ptr<TensorOp> *fused) {
+                     if (IsRgbDecode(ops[0])) {
+                       *fused = std::make_shared<DecodeCenterCropOp>(*static_cast<CenterCropOp *>(ops[1].get()));
+                     }
+                     return Status::OK();
+                   }});
+  // Rescale, normalize, transpose and cast in a single pass over the pixels. A chain of these ops is fused by
+  // creating a FusedNormalizeOp, and then merging the ops around it one at a time.
+  rules.push_back({"RescaleNormalize", {kRescaleOp, kNormalizeOp},
+                   [](const Ops &ops, std::shared_ptr<TensorOp> *fused) {
+                     auto rescale_op = static_cast<RescaleOp *>(ops[0].get());
+                     *fused = FuseNormalize(ops[1], rescale_op->rescale(), rescale_op->shift());
+                     return Status::OK();
+                   }});
+  rules.push_back({"NormalizeHwcToChw", {kNormalizeOp, kHwcToChwOp},
+                   [](const Ops &ops, std::shared_ptr<TensorOp> *fused) {
+                     auto op = FuseNormalize(ops[0], 1.0, 0.0);
+                     if (op != nullptr) {
+                       op->set_to_chw(true);
+                       *fused = op;
+                     }
+                     return Status::OK();
+                   }});
+  rules.push_back({"NormalizeTypeCast", {kNormalizeOp, kTypeCastOp},
+                   [](const Ops &ops, std::shared_ptr<TensorOp> *fused) {
+                     const DataType &type = static_cast<TypeCastOp *>(ops[1].get())->type();
+                     auto op = IsFloatType(type) ? FuseNormalize(ops[0], 1.0, 0.0) : nullptr;
+                     if (op != nullptr) {
+                       op->set_output_type(type);
+                       *fused = op;
+                     }
+                     return Status::OK();
+                   }});
+  rules.push_back({"ResizeFusedNormalize", {kResizeOp, kFusedNormalizeOp},
+                   [](const Ops &ops, std::shared_ptr<TensorOp> *fused) {
+                     auto normalize_op = static_cast<FusedNormalizeOp *>(ops[1].get());
+                     if (!normalize_op->has_resize_op()) {
+                       auto op = std::make_shared<FusedNormalizeOp>(*normalize_op);
+                       op->set_resize_op(ops[0]);
+                       *fused = op;
+                     }
+                     return Status::OK();
+                   }});
+  rules.push_back({"FusedNormalizeHwcToChw", {kFusedNormalizeOp, kHwcToChwOp},
+                   [](const Ops &ops, std::shared_ptr<TensorOp> *fused) {
+                     auto normalize_op = static_cast<FusedNormalizeOp *>(ops[0].get());
+                     if (!normalize_op->to_chw()) {
+                       auto op = std::make_shared<FusedNormalizeOp>(*normalize_op);
+                       op->set_to_chw(true);
+                       *fused = op;
+                     }
+                     return Status::OK();
+                   }});
+  rules.push_back({"FusedNormalizeTypeCast", {kFusedNormalizeOp, kTypeCastOp},
+                   [](const Ops &ops, std::shared_ptr<TensorOp> *fused) {
+                     const DataType &type = static_cast<TypeCastOp *>(ops[1].get())->type();
+                     if (IsFloatType(type)) {
+                       auto op = std::make_shared<FusedNormalizeOp>(*static_cast<FusedNormalizeOp *>(ops[0].get()));
+                       op->set_output_type(type);
+                       *fused = op;
+                     }
+                     return Status::OK();
+                   }});
+  return rules;
+}
+}  // namespace
+
+TensorOpFusionPass::TensorOpFusionPass() : rules_(BuiltinRules()) {}
+
+Status TensorOpFusionPass::FuseFirstMatch(std::vector<std::shared_ptr<TensorOp>> *tfuncs, bool *fused) const {
+  *fused = false;
+  for (auto it = tfuncs->begin(); it != tfuncs->end(); ++it) {
+    for (const auto &rule : rules_) {
+      auto len = static_cast<int64_t>(rule.pattern.size());
+      auto matches = [](const std::string &name, const std::shared_ptr<TensorOp> &op) { return op->Name() == name; };
+      if (len < 2 || tfuncs->end() - it < len || !std::equal(rule.pattern.begin(), rule.pattern.end(), it, matches)) {
+        continue;
+      }
+      std::vector<std::shared_ptr<TensorOp>> ops(it, it + len);
+      std::shared_ptr<TensorOp> fused_op;
+      RETURN_IF_NOT_OK(rule.fuse(ops, &fused_op));
+      if (fused_op == nullptr) {
+        continue;
+      }
+      MS_LOG(INFO) << "Tensor op fusion rule " << rule.name << " fuses " << len << " ops into " << fused_op->Name()
+                   << ".";
+      *it = std::move(fused_op);
+      (void)tfuncs->erase(it + 1, it + len);
+      *fused = true;
+      return Status::OK();
+    }
+  }
+  return Status::OK();
+}
+
+Status TensorOpFusionPass::RunOnNode(std::shared_ptr<MapOp> node, bool *modified) {
+  if (modified == nullptr) {
     RETURN_STATUS_UNEXPECTED("modified is nullptr");
   }
+  auto &tfuncs = node->TFuncs();
+  // Every fusion replaces at least 2 ops by one, so this ends
+  bool fused = true;
+  while (fused) {
+    RETURN_IF_NOT_OK(FuseFirstMatch(&tfuncs, &fused));
+    *modified = *modified || fused;
+  }
   return Status::OK();
 }
 }  // namespace dataset
@@ -16,21 +16,61 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_TENSOR_OP_FUSION_PASS_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_TENSOR_OP_FUSION_PASS_H_
 
+#include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 #include "minddata/dataset/engine/opt/pass.h"
 
 namespace mindspore {
 namespace dataset {
+class TensorOp;
 
 /// \class TensorOpFusionPass tensor_op_fusion_pass.h
 /// \brief And optional optimization pass identifying and fusing
 ///     tensor ops within MapOp
 class TensorOpFusionPass : public NodePass {
-  /// \brief Identifies and fuses tensor ops within MapOp
+ public:
+  /// \brief Builds the fused op of a chain of tensor ops matching the pattern of a rule
+  /// \param[in] ops The matched tensor ops, in the order of the pattern
+  /// \param[out] fused The fused op, or nullptr if the rule does not apply to the parameters of the ops
+  /// \return Status The error code return
+  using FusionFunc = std::function<Status(const std::vector<std::shared_ptr<TensorOp>> &ops,
+                                          std::shared_ptr<TensorOp> *fused)>;
+
+  /// \brief A fusion rule, a chain of at least 2 consecutive tensor ops given by their names, and how to fuse them
+  struct FusionRule {
+    std::string name;
+    std::vector<std::string> pattern;
+    FusionFunc fuse;
+  };
+
+  /// \brief Constructor, registers the built-in fusion rules
+  TensorOpFusionPass();
+
+  /// \brief Registers one more fusion rule, which is tried after the ones already registered
+  /// \param[in] rule The fusion rule
+  void AddRule(FusionRule rule) { rules_.push_back(std::move(rule)); }
+
+  /// \brief Getter
+  /// \return The registered fusion rules
+  const std::vector<FusionRule> &rules() const { return rules_; }
+
+  /// \brief Identifies and fuses tensor ops within MapOp. Rules are applied until none of them matches, so the
+  ///     result of one fusion can be fused again by another rule.
   /// \param[in] node The node being visited
-  /// \param[inout] *modified indicates whether the node has been visited
+  /// \param[inout] *modified indicates whether the node has been modified
   /// \return Status The error code return
   Status RunOnNode(std::shared_ptr<MapOp> node, bool *modified) override;
+
+ private:
+  /// \brief Fuses the first chain of tensor ops matching a rule
+  /// \param[inout] tfuncs The tensor ops of a MapOp
+  /// \param[out] fused Whether a chain was fused
+  /// \return Status The error code return
+  Status FuseFirstMatch(std::vector<std::shared_ptr<TensorOp>> *tfuncs, bool *fused) const;
+
+  std::vector<FusionRule> rules_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -0,0 +1,216 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/perf/auto_tune.h"
+#include <algorithm>
+#include <unordered_map>
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/engine/datasetops/dataset_op.h"
+#include "minddata/dataset/engine/datasetops/parallel_op.h"
+#include "minddata/dataset/engine/execution_tree.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Length of the window of samples the pipeline is tuned from
+constexpr int32_t kWindowMs = 500;
+// A queue is full above this utilization, and starved below half of it
+constexpr double kFullUtilization = 0.8;
+constexpr double kStarvedUtilization = 0.4;
+// A queue is bursty if it is both empty and full in this fraction of the samples of a window
+constexpr double kBurstFraction = 0.1;
+// A queue does not grow beyond this multiple of its initial capacity
+constexpr int32_t kMaxQueueGrowth = 4;
+
+bool HasOutputQueue(const DatasetOp &op) { return !op.inlined() && op.Name() != kDeviceQueueOp; }
+}  // namespace
+
+AutoTune::AutoTune(ExecutionTree *tree)
+    : tree_(tree),
+      feeder_(nullptr),
+      window_(1),
+      window_samples_(0),
+      max_steps_(0),
+      steps_(0),
+      last_out_buffers_(0),
+      done_(false) {}
+
+Status AutoTune::Init() {
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  window_ = std::max(1, kWindowMs / std::max(1, cfg->monitor_sampling_interval()));
+  max_steps_ = cfg->autotune_steps();
+
+  // The tree iterates in post order, so children are collected before their parent
+  std::unordered_map<DatasetOp *, int32_t> index;
+  for (auto &node : *tree_) {
+    if (node.Name() == kDeviceQueueOp) {
+      continue;
+    }
+    OpStats stats{};
+    stats.op = &node;
+    stats.child = node.Children().empty() ? -1 : index[node.Children()[0].get()];
+    auto parallel_op = dynamic_cast<ParallelOp *>(&node);
+    if (parallel_op != nullptr && parallel_op->gated()) {
+      stats.parallel_op = parallel_op;
+      stats.initial_workers = parallel_op->active_workers();
+    }
+    if (HasOutputQueue(node) && node.num_producers() > 0) {
+      stats.queue_capacity = node.ConnectorCapacity() / node.num_producers();
+      stats.initial_queue_capacity = stats.queue_capacity;
+    }
+    index[&node] = static_cast<int32_t>(ops_.size());
+    ops_.push_back(stats);
+  }
+
+  // The connector the consumer pops from, skipping the device queue and inlined ops which have none of their own
+  for (auto op = tree_->root(); op != nullptr; op = op->Children().empty() ? nullptr : op->Children()[0]) {
+    if (HasOutputQueue(*op)) {
+      feeder_ = op.get();
+      break;
+    }
+  }
+  if (feeder_ == nullptr) {
+    RETURN_STATUS_UNEXPECTED("AutoTune can not find the output connector feeding the consumer of the tree.");
+  }
+  last_out_buffers_ = feeder_->ConnectorOutBufferCount();
+  MS_LOG(INFO) << "AutoTune tunes " << ops_.size() << " ops during the first " << max_steps_ << " steps, one window is "
+               << window_ << " samples.";
+  return Status::OK();
+}
+
+void AutoTune::SampleOp(OpStats *stats) {
+  int32_t capacity = stats->op->ConnectorCapacity();
+  int32_t size = stats->op->ConnectorSize();
+  if (capacity <= 0) {
+    return;
+  }
+  double utilization = static_cast<double>(size) / capacity;
+  stats->sum_utilization += utilization;
+  stats->empty_samples += size == 0 ? 1 : 0;
+  stats->full_samples += utilization >= kFullUtilization ? 1 : 0;
+}
+
+void AutoTune::CountSteps() {
+  int64_t out_buffers = feeder_->ConnectorOutBufferCount();
+  // The count starts over if the connector is reset for the next repeat
+  steps_ += out_buffers >= last_out_buffers_ ? out_buffers - last_out_buffers_ : out_buffers;
+  last_out_buffers_ = out_buffers;
+}
+
+Status AutoTune::Sample() {
+  if (done_) {
+    return Status::OK();
+  }
+  for (auto &stats : ops_) {
+    SampleOp(&stats);
+  }
+  CountSteps();
+  if (++window_samples_ >= window_) {
+    RETURN_IF_NOT_OK(Analyse());
+    for (auto &stats : ops_) {
+      stats.sum_utilization = 0;
+      stats.empty_samples = 0;
+      stats.full_samples = 0;
+    }
+    window_samples_ = 0;
+  }
+  if (steps_ >= max_steps_) {
+    done_ = true;
+    Report();
+  }
+  return Status::OK();
+}
+
+double AutoTune::Utilization(const OpStats &stats) const {
+  return window_samples_ > 0 ? stats.sum_utilization / window_samples_ : 0;
+}
+
+Status AutoTune::Analyse() {
+  auto feeder = std::find_if(ops_.begin(), ops_.end(), [this](const OpStats &stats) { return stats.op == feeder_; });
+  if (feeder != ops_.end() && Utilization(*feeder) >= kFullUtilization) {
+    MS_LOG(DEBUG) << "AutoTune: the pipeline keeps up, " << feeder_->Name() << " has a full output connector.";
+    return Status::OK();
+  }
+  (void)ScaleBottleneck();
+  return EnlargeBurstyQueues();
+}
+
+bool AutoTune::ScaleBottleneck() {
+  // The bottleneck starves its output while its input is there, a leaf has no input to wait for
+  OpStats *bottleneck = nullptr;
+  double max_gap = 0;
+  for (auto &stats : ops_) {
+    if (stats.parallel_op == nullptr) {
+      continue;
+    }
+    double out_utilization = Utilization(stats);
+    double in_utilization = stats.child >= 0 ? Utilization(ops_[stats.child]) : 1.0;
+    if (out_utilization < kStarvedUtilization && in_utilization >= kStarvedUtilization &&
+        in_utilization - out_utilization > max_gap) {
+      bottleneck = &stats;
+      max_gap = in_utilization - out_utilization;
+    }
+  }
+  if (bottleneck == nullptr) {
+    return false;
+  }
+  ParallelOp *op = bottleneck->parallel_op;
+  int32_t active = op->active_workers();
+  if (active >= op->num_workers()) {
+    MS_LOG(DEBUG) << "AutoTune: " << op->Name() << "(ID:" << op->id() << ") is the bottleneck with all "
+                  << op->num_workers() << " workers active.";
+    return false;
+  }
+  op->SetActiveWorkers(active + std::max(1, active / 2));
+  MS_LOG(INFO) << "AutoTune: " << op->Name() << "(ID:" << op->id() << ") is the bottleneck, active workers "
+               << active << " -> " << op->active_workers() << ".";
+  return true;
+}
+
+Status AutoTune::EnlargeBurstyQueues() {
+  for (auto &stats : ops_) {
+    if (stats.queue_capacity <= 0 || stats.queue_capacity >= stats.initial_queue_capacity * kMaxQueueGrowth) {
+      continue;
+    }
+    double min_samples = kBurstFraction * window_samples_;
+    if (stats.empty_samples < min_samples || stats.full_samples < min_samples) {
+      continue;
+    }
+    int32_t capacity = std::min(stats.queue_capacity * 2, stats.initial_queue_capacity * kMaxQueueGrowth);
+    RETURN_IF_NOT_OK(stats.op->ResizeConnector(capacity));
+    MS_LOG(INFO) << "AutoTune: " << stats.op->Name() << "(ID:" << stats.op->id()
+                 << ") has a bursty output connector, queue size " << stats.queue_capacity << " -> " << capacity
+                 << ".";
+    stats.queue_capacity = capacity;
+  }
+  return Status::OK();
+}
+
+void AutoTune::Report() const {
+  MS_LOG(INFO) << "AutoTune is done after " << steps_ << " steps, tuned settings:";
+  for (auto &stats : ops_) {
+    if (stats.parallel_op == nullptr && stats.queue_capacity == stats.initial_queue_capacity) {
+      continue;
+    }
+    std::string workers = stats.parallel_op == nullptr ? "-" : std::to_string(stats.initial_workers) + " -> " +
+                                                                  std::to_string(stats.parallel_op->active_workers());
+    MS_LOG(INFO) << "  " << stats.op->Name() << "(ID:" << stats.op->id() << ") num_parallel_workers: " << workers
+                 << ", queue size: " << stats.initial_queue_capacity << " -> " << stats.queue_capacity;
+  }
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,109 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+class DatasetOp;
+class ExecutionTree;
+class ParallelOp;
+
+// AutoTune tunes a running pipeline from the same per-op samples the perf Monitor collects: the size and capacity
+// of every output connector, and the number of buffers popped from the connector that feeds the device (or the
+// iterator). Every window of samples it checks if that feeding connector stays full. If it does not, the op whose
+// output queue is starved while its input queue is not is the bottleneck, and its number of active workers is raised.
+// Output queues which swing between empty and full are enlarged to absorb the bursts. Tuning stops after the
+// configured number of steps, and the final settings are logged so they can be hard coded.
+class AutoTune {
+ public:
+  // Constructor
+  // @param tree - The execution tree to tune
+  explicit AutoTune(ExecutionTree *tree);
+
+  ~AutoTune() = default;
+
+  // Collect the ops of the tree, must be called once the tree is prepared
+  // @return Status - The error code return
+  Status Init();
+
+  // Take one sample of the queues, and tune the pipeline at the end of a window.
+  // This function is invoked by the Monitor thread every sampling interval.
+  // @return Status - The error code return
+  Status Sample();
+
+  // @return true if the tuning steps are over
+  bool IsDone() const { return done_; }
+
+  // @return the number of steps seen so far
+  int64_t steps() const { return steps_; }
+
+ private:
+  // Queue statistics of one op over the current window
+  struct OpStats {
+    DatasetOp *op;            // The op, inlined ops report the queue of their child
+    ParallelOp *parallel_op;  // Not null if the number of active workers of the op can be tuned
+    int32_t child;            // Index of the stats of the first child, -1 for a leaf
+    int32_t queue_capacity;   // The capacity of each queue of the output connector, 0 if it can not be resized
+    int32_t initial_workers;  // The number of active workers before tuning
+    int32_t initial_queue_capacity;
+    double sum_utilization;  // Sum over the window of size / capacity of the output connector
+    int32_t empty_samples;   // Samples in which the output connector was empty
+    int32_t full_samples;    // Samples in which the output connector was full
+  };
+
+  // Sample the output connector of one op
+  void SampleOp(OpStats *stats);
+
+  // Count the buffers popped from the feeding connector since the last sample
+  void CountSteps();
+
+  // Tune the pipeline from the statistics of the window
+  // @return Status - The error code return
+  Status Analyse();
+
+  // Raise the active workers of the bottleneck op
+  // @return true if an op was scaled
+  bool ScaleBottleneck();
+
+  // Enlarge the output connectors which are bursty
+  // @return Status - The error code return
+  Status EnlargeBurstyQueues();
+
+  // Log the tuned settings of every op
+  void Report() const;
+
+  double Utilization(const OpStats &stats) const;
+
+  ExecutionTree *tree_;
+  std::vector<OpStats> ops_;
+  DatasetOp *feeder_;  // The op whose output connector feeds the device or the iterator
+  int32_t window_;     // Number of samples per window
+  int32_t window_samples_;
+  int64_t max_steps_;
+  int64_t steps_;
+  int64_t last_out_buffers_;
+  bool done_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_H_
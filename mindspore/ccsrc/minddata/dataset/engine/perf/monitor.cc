@@ -28,6 +28,12 @@ Monitor::Monitor(ExecutionTree *tree) : tree_(tree) {
   max_samples_ = 0;
   cur_row_ = 0;
 }
+
+Status Monitor::EnableAutoTune() {
+  auto_tune_ = std::make_unique<AutoTune>(tree_);
+  return auto_tune_->Init();
+}
+
 Status Monitor::operator()() {
   // Register this thread with TaskManager to receive proper interrupt signal.
   TaskManager::FindMe()->Post();
@@ -39,6 +45,13 @@ Status Monitor::operator()() {
     for (auto &node : tree_->GetProfilingManager()->GetSamplingNodes()) {
       RETURN_IF_NOT_OK(node.second->Sample());
     }
+    if (auto_tune_ != nullptr) {
+      RETURN_IF_NOT_OK(auto_tune_->Sample());
+      // Without profiling there is nothing left to sample once the pipeline is tuned
+      if (auto_tune_->IsDone() && tree_->GetProfilingManager()->GetSamplingNodes().empty()) {
+        break;
+      }
+    }
     std::this_thread::sleep_for(std::chrono::milliseconds(sampling_interval_));
   }
 
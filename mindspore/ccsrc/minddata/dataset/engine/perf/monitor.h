@@ -21,6 +21,7 @@
 #include <unordered_map>
 #include <vector>
 #include "minddata/dataset/util/status.h"
+#include "minddata/dataset/engine/perf/auto_tune.h"
 #include "minddata/dataset/engine/perf/profiling.h"
 
 namespace mindspore {
@@ -42,12 +43,17 @@ class Monitor {
 
   int64_t GetSamplingInterval() { return sampling_interval_; }
 
+  // Tune the pipeline from the samples while the monitor is running, see AutoTune
+  // @return Status - The error code return
+  Status EnableAutoTune();
+
  private:
   int64_t cur_row_;
   int64_t max_samples_;
   int64_t sampling_interval_;
   ExecutionTree *tree_;
   std::vector<std::shared_ptr<Sampling>> sampling_list_;
+  std::unique_ptr<AutoTune> auto_tune_;
 };
 }  // namespace dataset
 }  // namespace mindspore
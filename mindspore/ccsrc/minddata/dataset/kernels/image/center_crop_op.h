@@ -42,7 +42,11 @@ class CenterCropOp : public TensorOp {
 
   std::string Name() const override { return kCenterCropOp; }
 
- private:
+  int32_t crop_height() const { return crop_het_; }
+
+  int32_t crop_width() const { return crop_wid_; }
+
+ protected:
   int32_t crop_het_;
   int32_t crop_wid_;
 };
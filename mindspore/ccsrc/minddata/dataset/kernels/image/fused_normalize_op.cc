@@ -0,0 +1,56 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/fused_normalize_op.h"
+#include "minddata/dataset/kernels/image/image_utils.h"
+
+namespace mindspore {
+namespace dataset {
+Status FusedNormalizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  std::shared_ptr<Tensor> image = input;
+  if (resize_op_ != nullptr) {
+    RETURN_IF_NOT_OK(resize_op_->Compute(input, &image));
+  }
+  return RescaleNormalize(image, output, rescale_, shift_, mean_, std_, to_chw_, output_type_);
+}
+
+Status FusedNormalizeOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  std::vector<TensorShape> resized = inputs;
+  if (resize_op_ != nullptr) {
+    RETURN_IF_NOT_OK(resize_op_->OutputShape(inputs, resized));
+  }
+  RETURN_IF_NOT_OK(TensorOp::OutputShape(resized, outputs));
+  outputs.clear();
+  TensorShape in = resized[0];
+  if (in.Rank() != 3) {
+    return Status(StatusCode::kUnexpectedError, "Input has a wrong shape");
+  }
+  outputs.emplace_back(to_chw_ ? TensorShape{in[2], in[0], in[1]} : in);
+  return Status::OK();
+}
+
+Status FusedNormalizeOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  outputs[0] = output_type_;
+  return Status::OK();
+}
+
+void FusedNormalizeOp::Print(std::ostream &out) const {
+  out << Name() << ": resize: " << (resize_op_ != nullptr) << ", rescale: " << rescale_ << ", shift: " << shift_
+      << ", to_chw: " << to_chw_ << ", output_type: " << output_type_;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,85 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_NORMALIZE_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_NORMALIZE_OP_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// Fused chain of ResizeOp, RescaleOp, NormalizeOp, HwcToChwOp and TypeCastOp to a float type, created by the
+// TensorOpFusionPass. After the optional resize, the image is rescaled, normalized, transposed and cast in a single
+// pass over the pixels, instead of one pass and one intermediate image per op.
+class FusedNormalizeOp : public TensorOp {
+ public:
+  // @param rescale: rescale parameter, 1.0 if there is no RescaleOp
+  // @param shift: shift parameter, 0.0 if there is no RescaleOp
+  // @param mean: mean of each channel in RGB order
+  // @param stddev: std of each channel in RGB order
+  FusedNormalizeOp(float rescale, float shift, std::vector<float> mean, std::vector<float> stddev)
+      : rescale_(rescale),
+        shift_(shift),
+        mean_(std::move(mean)),
+        std_(std::move(stddev)),
+        to_chw_(false),
+        output_type_(DataType::DE_FLOAT32) {}
+
+  ~FusedNormalizeOp() override = default;
+
+  void Print(std::ostream &out) const override;
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+  std::string Name() const override { return kFusedNormalizeOp; }
+
+  // Fuse the resize op which runs before the normalization
+  void set_resize_op(std::shared_ptr<TensorOp> resize_op) { resize_op_ = std::move(resize_op); }
+
+  // Fuse a HwcToChwOp which runs after the normalization
+  void set_to_chw(bool to_chw) { to_chw_ = to_chw; }
+
+  // Fuse a TypeCastOp which runs after the normalization
+  void set_output_type(const DataType &output_type) { output_type_ = output_type; }
+
+  bool has_resize_op() const { return resize_op_ != nullptr; }
+
+  bool to_chw() const { return to_chw_; }
+
+  const DataType &output_type() const { return output_type_; }
+
+ private:
+  std::shared_ptr<TensorOp> resize_op_;
+  float rescale_;
+  float shift_;
+  std::vector<float> mean_;
+  std::vector<float> std_;
+  bool to_chw_;
+  DataType output_type_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_NORMALIZE_OP_H_
@@ -22,6 +22,7 @@
 #include <opencv2/imgcodecs.hpp>
 #include "utils/ms_utils.h"
 #include "minddata/dataset/kernels/image/math_utils.h"
+#include "minddata/dataset/kernels/image/native_image_utils.h"
 #include "minddata/dataset/core/constants.h"
 #include "minddata/dataset/core/cv_tensor.h"
 #include "minddata/dataset/core/tensor.h"
@@ -61,7 +62,33 @@ int GetCVBorderType(BorderType type) {
   }
 }
 
+// First byte of the data of a tensor, for the native kernels to write to
+static uint8_t *GetImageBuffer(const std::shared_ptr<Tensor> &tensor) { return &(*tensor->begin<uint8_t>()); }
+
+// Size of a <H,W> or <H,W,C> image the native kernels can work on, false if it has to go through OpenCV
+static bool GetNativeImageSize(const std::shared_ptr<Tensor> &input, int *height, int *width, int *channels) {
+  if ((input->Rank() != 2 && input->Rank() != 3) || input->type().AsCVType() == kCVInvalidType ||
+      input->GetBuffer() == nullptr) {
+    return false;
+  }
+  *height = static_cast<int>(input->shape()[0]);
+  *width = static_cast<int>(input->shape()[1]);
+  *channels = input->Rank() == 3 ? static_cast<int>(input->shape()[2]) : 1;
+  return *height > 0 && *width > 0 && *channels > 0;
+}
+
 Status Flip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output, int flip_code) {
+  int height = 0;
+  int width = 0;
+  int channels = 0;
+  if (flip_code >= 0 && GetNativeImageSize(input, &height, &width, &channels)) {
+    std::shared_ptr<Tensor> output_tensor;
+    RETURN_IF_NOT_OK(Tensor::CreateEmpty(input->shape(), input->type(), &output_tensor));
+    native::Flip(input->GetBuffer(), GetImageBuffer(output_tensor), height, width,
+                 channels * input->type().SizeInBytes(), flip_code > 0);
+    *output = std::move(output_tensor);
+    return Status::OK();
+  }
   std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(std::move(input));
 
   std::shared_ptr<CVTensor> output_cv;
@@ -106,6 +133,21 @@ Status Resize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *out
       "1000 times the original image; 2) can not be 0.";
     return Status(StatusCode::kShapeMisMatch, err_msg);
   }
+  int height = 0;
+  int width = 0;
+  int channels = 0;
+  if (mode == InterpolationMode::kLinear && input_cv->type() == DataType::DE_UINT8 &&
+      GetNativeImageSize(input_cv, &height, &width, &channels) &&
+      native::ResizeBilinearMatchesCv(height, width, output_height, output_width)) {
+    TensorShape shape{output_height, output_width};
+    if (input_cv->Rank() == 3) shape = shape.AppendDim(channels);
+    std::shared_ptr<Tensor> output_tensor;
+    RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, input_cv->type(), &output_tensor));
+    native::ResizeBilinear(input_cv->GetBuffer(), height, width, static_cast<int64_t>(width) * channels, channels,
+                           GetImageBuffer(output_tensor), output_height, output_width);
+    *output = std::move(output_tensor);
+    return Status::OK();
+  }
   try {
     TensorShape shape{output_height, output_width};
     int num_channels = input_cv->shape()[2];
@@ -352,6 +394,21 @@ Status Crop(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *outpu
   if (input_cv->Rank() != 3 && input_cv->Rank() != 2) {
     RETURN_STATUS_UNEXPECTED("Shape not <H,W,C> or <H,W>");
   }
+  int height = 0;
+  int width = 0;
+  int channels = 0;
+  if (GetNativeImageSize(input_cv, &height, &width, &channels) && x >= 0 && y >= 0 && w > 0 && h > 0 &&
+      x <= width - w && y <= height - h) {
+    TensorShape shape{h, w};
+    if (input_cv->Rank() == 3) shape = shape.AppendDim(channels);
+    std::shared_ptr<Tensor> output_tensor;
+    RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, input_cv->type(), &output_tensor));
+    int64_t pixel_size = static_cast<int64_t>(channels) * input_cv->type().SizeInBytes();
+    native::CopyRect(input_cv->GetBuffer() + (static_cast<int64_t>(y) * width + x) * pixel_size, width * pixel_size,
+                     GetImageBuffer(output_tensor), w * pixel_size, h);
+    *output = std::move(output_tensor);
+    return Status::OK();
+  }
   try {
     TensorShape shape{h, w};
     int num_channels = input_cv->shape()[2];
@@ -388,6 +445,14 @@ Status HwcToChw(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output)
     int height = input_cv->shape()[0];
     int width = input_cv->shape()[1];
 
+    if (input_cv->type().AsCVType() != kCVInvalidType && input_cv->GetBuffer() != nullptr) {
+      std::shared_ptr<Tensor> output_tensor;
+      RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape{num_channels, height, width}, input_cv->type(), &output_tensor));
+      native::HwcToChw(input_cv->GetBuffer(), GetImageBuffer(output_tensor), static_cast<int64_t>(height) * width,
+                       num_channels, input_cv->type().SizeInBytes());
+      *output = std::move(output_tensor);
+      return Status::OK();
+    }
     std::shared_ptr<CVTensor> output_cv;
     CVTensor::CreateEmpty(TensorShape{num_channels, height, width}, input_cv->type(), &output_cv);
     for (int i = 0; i < num_channels; ++i) {
@@ -494,6 +559,24 @@ Status CropAndResize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tenso
         "1000 times the original image; 2) can not be 0.";
       RETURN_STATUS_UNEXPECTED(err_msg);
     }
+    int height = 0;
+    int width = 0;
+    int channels = 0;
+    if (mode == InterpolationMode::kLinear && input_cv->type() == DataType::DE_UINT8 &&
+        GetNativeImageSize(input_cv, &height, &width, &channels) && x >= 0 && y >= 0 && crop_width > 0 &&
+        crop_height > 0 && x <= width - crop_width && y <= height - crop_height &&
+        native::ResizeBilinearMatchesCv(crop_height, crop_width, target_height, target_width)) {
+      TensorShape shape{target_height, target_width};
+      if (input_cv->Rank() == 3) shape = shape.AppendDim(channels);
+      std::shared_ptr<Tensor> output_tensor;
+      RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, input_cv->type(), &output_tensor));
+      int64_t stride = static_cast<int64_t>(width) * channels;
+      native::ResizeBilinear(input_cv->GetBuffer() + y * stride + static_cast<int64_t>(x) * channels, crop_height,
+                             crop_width, stride, channels, GetImageBuffer(output_tensor), target_height,
+                             target_width);
+      *output = std::move(output_tensor);
+      return Status::OK();
+    }
     cv::Rect roi(x, y, crop_width, crop_height);
     auto cv_mode = GetCVInterpolationMode(mode);
     cv::Mat cv_in = input_cv->mat();
@@ -577,6 +660,29 @@ Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *
     std::string err_msg = "Std tensor should be of size 3 and type float.";
     return Status(StatusCode::kShapeMisMatch, err_msg);
   }
+  DataType type = input_cv->type();
+  if ((type == DataType::DE_UINT8 || type == DataType::DE_FLOAT32) && input_cv->shape()[2] == 3) {
+    // Same float weights as the convertTo calls below
+    float scale[3];
+    float offset[3];
+    for (uint8_t i = 0; i < 3; i++) {
+      float mean_c, std_c;
+      RETURN_IF_NOT_OK(mean->GetItemAt<float>(&mean_c, {i}));
+      RETURN_IF_NOT_OK(std->GetItemAt<float>(&std_c, {i}));
+      scale[i] = static_cast<float>(1.0 / std_c);
+      offset[i] = -mean_c / std_c;
+    }
+    int64_t num_pixels = input_cv->shape()[0] * input_cv->shape()[1];
+    auto out = reinterpret_cast<float *>(GetImageBuffer(output_cv));
+    if (type == DataType::DE_UINT8) {
+      native::NormalizeToFloat(input_cv->GetBuffer(), out, num_pixels, scale, offset, false);
+    } else {
+      native::NormalizeToFloat(reinterpret_cast<const float *>(input_cv->GetBuffer()), out, num_pixels, scale, offset,
+                               false);
+    }
+    *output = std::static_pointer_cast<Tensor>(output_cv);
+    return Status::OK();
+  }
   try {
     // NOTE: We are assuming the input image is in RGB and the mean
     // and std are in RGB
@@ -596,6 +702,86 @@ Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *
   }
 }
 
+template <typename T_in, typename T_out>
+static void RescaleNormalizePixels(const T_in *in, T_out *out, int64_t num_pixels, const float *scale,
+                                   const float *offset, bool to_chw) {
+  constexpr int64_t kNumChannels = 3;
+  // Rescale and normalize fold into a single multiply add per channel
+  if (to_chw) {
+    for (int64_t c = 0; c < kNumChannels; c++) {
+      T_out *out_c = out + c * num_pixels;
+      for (int64_t i = 0; i < num_pixels; i++) {
+        out_c[i] = static_cast<T_out>(static_cast<float>(in[i * kNumChannels + c]) * scale[c] + offset[c]);
+      }
+    }
+  } else {
+    for (int64_t i = 0; i < num_pixels; i++) {
+      for (int64_t c = 0; c < kNumChannels; c++) {
+        int64_t k = i * kNumChannels + c;
+        out[k] = static_cast<T_out>(static_cast<float>(in[k]) * scale[c] + offset[c]);
+      }
+    }
+  }
+}
+
+template <typename T_in>
+static Status RescaleNormalizeTo(const T_in *in, const std::shared_ptr<Tensor> &output, int64_t num_pixels,
+                                 const float *scale, const float *offset, bool to_chw) {
+  auto out = GetImageBuffer(output);
+  switch (output->type().value()) {
+    case DataType::DE_FLOAT16:
+      RescaleNormalizePixels(in, reinterpret_cast<float16 *>(out), num_pixels, scale, offset, to_chw);
+      break;
+    case DataType::DE_FLOAT32:
+      native::NormalizeToFloat(in, reinterpret_cast<float *>(out), num_pixels, scale, offset, to_chw);
+      break;
+    case DataType::DE_FLOAT64:
+      RescaleNormalizePixels(in, reinterpret_cast<double *>(out), num_pixels, scale, offset, to_chw);
+      break;
+    default:
+      RETURN_STATUS_UNEXPECTED("RescaleNormalize: output type should be float16, float32 or float64.");
+  }
+  return Status::OK();
+}
+
+Status RescaleNormalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, float rescale,
+                        float shift, const std::vector<float> &mean, const std::vector<float> &std, bool to_chw,
+                        const DataType &output_type) {
+  constexpr int kNumChannels = 3;
+  if (input->Rank() != 3 || input->shape()[2] != kNumChannels) {
+    RETURN_STATUS_UNEXPECTED("RescaleNormalize: the shape of the image should be <H,W,3>.");
+  }
+  if (mean.size() != kNumChannels || std.size() != kNumChannels) {
+    return Status(StatusCode::kShapeMisMatch, "Mean and std should be of size 3.");
+  }
+  float scale[kNumChannels];
+  float offset[kNumChannels];
+  for (int c = 0; c < kNumChannels; c++) {
+    if (std[c] == 0) {
+      RETURN_STATUS_UNEXPECTED("RescaleNormalize: std can not be zero.");
+    }
+    scale[c] = rescale / std[c];
+    offset[c] = (shift - mean[c]) / std[c];
+  }
+  std::shared_ptr<Tensor> image = input;
+  if (image->type() != DataType::DE_UINT8 && image->type() != DataType::DE_FLOAT32) {
+    RETURN_IF_NOT_OK(Rescale(input, &image, 1.0, 0.0));
+  }
+  int64_t height = image->shape()[0];
+  int64_t width = image->shape()[1];
+  TensorShape shape = to_chw ? TensorShape({kNumChannels, height, width}) : image->shape();
+  std::shared_ptr<Tensor> output_tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape, output_type, &output_tensor));
+  if (image->type() == DataType::DE_UINT8) {
+    RETURN_IF_NOT_OK(RescaleNormalizeTo(image->GetBuffer(), output_tensor, height * width, scale, offset, to_chw));
+  } else {
+    RETURN_IF_NOT_OK(RescaleNormalizeTo(reinterpret_cast<const float *>(image->GetBuffer()), output_tensor,
+                                        height * width, scale, offset, to_chw));
+  }
+  *output = std::move(output_tensor);
+  return Status::OK();
+}
+
 Status AdjustBrightness(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, const float &alpha) {
   try {
     std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
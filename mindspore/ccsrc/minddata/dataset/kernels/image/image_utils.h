@@ -171,6 +171,21 @@ Status Rotate(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *out
 Status Normalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output,
                  const std::shared_ptr<Tensor> &mean, const std::shared_ptr<Tensor> &std);
 
+/// \brief Returns rescaled and normalized image, computed in a single pass over the pixels.
+///     The output is ((input * rescale + shift) - mean) / std per channel, the same as Rescale followed by Normalize.
+/// \param input: Tensor of shape <H,W,3> in RGB order and type DE_UINT8 or DE_FLOAT32, other types are converted
+///     to DE_FLOAT32 first.
+/// \param rescale: rescale parameter
+/// \param shift: shift parameter
+/// \param mean: mean of each channel in RGB order
+/// \param std: std of each channel in RGB order
+/// \param to_chw: if the output is transposed to <3,H,W> as HwcToChw does
+/// \param output_type: type of the output, DE_FLOAT16, DE_FLOAT32 or DE_FLOAT64
+/// \param output: Normalized image Tensor
+Status RescaleNormalize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, float rescale,
+                        float shift, const std::vector<float> &mean, const std::vector<float> &std, bool to_chw,
+                        const DataType &output_type);
+
 /// \brief Returns image with adjusted brightness.
 /// \param input: Tensor of shape <H,W,3> in RGB order and any OpenCv compatible type, see CVTensor.
 /// \param alpha: Alpha value to adjust brightness by. Should be a positive number.
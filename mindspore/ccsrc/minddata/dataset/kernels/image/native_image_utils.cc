@@ -0,0 +1,611 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/native_image_utils.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+// The AVX2 kernels are compiled for the AVX2 and FMA targets only, and picked at run time when the CPU supports them
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define NATIVE_ENABLE_AVX2
+#include <immintrin.h>
+#define AVX2_FUNC __attribute__((target("avx2,fma")))
+#endif
+
+namespace mindspore {
+namespace dataset {
+namespace native {
+namespace {
+// cv::resize blends 8-bit images with 11 bit fixed point weights
+constexpr int kCoefBits = 11;
+constexpr float kCoefScale = 1 << kCoefBits;
+constexpr int kNumChannels = 3;
+
+// Source offsets and fixed point weights of the two taps of each destination element along one axis
+struct LinearTaps {
+  std::vector<int> first;
+  std::vector<int> second;
+  std::vector<int16_t> first_coef;
+  std::vector<int16_t> second_coef;
+  // both weights of an element in one int32, the layout of a pair for _mm_madd_epi16
+  std::vector<int32_t> packed_coef;
+};
+
+// Weights are rounded half to even like saturate_cast<short> of OpenCV
+inline int16_t ToCoef(float weight) { return static_cast<int16_t>(std::lrint(weight * kCoefScale)); }
+
+// Taps along the y-axis, in the same float arithmetic as cv::resize. Rows out of the image are clamped but their
+// weights are kept.
+void ComputeRowTaps(int src_size, int dst_size, LinearTaps *taps) {
+  double scale = 1. / (static_cast<double>(dst_size) / src_size);
+  taps->first.resize(dst_size);
+  taps->second.resize(dst_size);
+  taps->first_coef.resize(dst_size);
+  taps->second_coef.resize(dst_size);
+  for (int d = 0; d < dst_size; d++) {
+    auto f = static_cast<float>((d + 0.5) * scale - 0.5);
+    auto s = static_cast<int>(std::floor(f));
+    f -= s;
+    taps->first[d] = std::min(std::max(s, 0), src_size - 1);
+    taps->second[d] = std::min(std::max(s + 1, 0), src_size - 1);
+    taps->first_coef[d] = ToCoef(1.f - f);
+    taps->second_coef[d] = ToCoef(f);
+  }
+}
+
+// Taps along the x-axis, as offsets of the first channel of the source pixels. Pixels out of the image snap to the
+// border.
+void ComputeColumnTaps(int src_size, int dst_size, int channels, LinearTaps *taps) {
+  double scale = 1. / (static_cast<double>(dst_size) / src_size);
+  taps->first.resize(dst_size);
+  taps->second.resize(dst_size);
+  taps->first_coef.resize(dst_size);
+  taps->second_coef.resize(dst_size);
+  taps->packed_coef.resize(dst_size);
+  for (int d = 0; d < dst_size; d++) {
+    auto f = static_cast<float>((d + 0.5) * scale - 0.5);
+    auto s = static_cast<int>(std::floor(f));
+    f -= s;
+    if (s < 0) {
+      f = 0;
+      s = 0;
+    }
+    if (s >= src_size - 1) {
+      f = 0;
+      s = src_size - 1;
+    }
+    taps->first[d] = s * channels;
+    taps->second[d] = std::min(s + 1, src_size - 1) * channels;
+    taps->first_coef[d] = ToCoef(1.f - f);
+    taps->second_coef[d] = ToCoef(f);
+    auto low = static_cast<uint32_t>(static_cast<uint16_t>(taps->first_coef[d]));
+    auto high = static_cast<uint32_t>(static_cast<uint16_t>(taps->second_coef[d]));
+    taps->packed_coef[d] = static_cast<int32_t>(low | (high << 16));
+  }
+}
+
+// A fixed number of channels lets the compiler unroll the channels of a pixel
+template <int kChannels>
+void HorizontalPassFixed(const uint8_t *src, int32_t *__restrict dst, const LinearTaps &taps, int begin,
+                         int dst_width) {
+  const int *first = taps.first.data();
+  const int *second = taps.second.data();
+  const int16_t *first_coef = taps.first_coef.data();
+  const int16_t *second_coef = taps.second_coef.data();
+  for (int x = begin; x < dst_width; x++) {
+    const uint8_t *s0 = src + first[x];
+    const uint8_t *s1 = src + second[x];
+    int32_t a0 = first_coef[x];
+    int32_t a1 = second_coef[x];
+    for (int k = 0; k < kChannels; k++) {
+      dst[x * kChannels + k] = s0[k] * a0 + s1[k] * a1;
+    }
+  }
+}
+
+#ifdef NATIVE_ENABLE_AVX2
+AVX2_FUNC inline int LoadU16(const uint8_t *p) {
+  uint16_t v;
+  (void)memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+// The second tap is read right after the first one, where it is unless the pixel snapped to the right border, and
+// then its weight is 0. Loads stay within the row of row_size bytes. Returns the number of destination pixels done.
+AVX2_FUNC int HorizontalPassAvx2(const uint8_t *src, int32_t *dst, const LinearTaps &taps, int dst_width,
+                                 int channels, int row_size) {
+  constexpr int kLoadSize = 8;
+  constexpr int kPixels = 4;
+  const int *first = taps.first.data();
+  const int32_t *coefs = taps.packed_coef.data();
+  int x = 0;
+  if (channels == 1) {
+    // 4 pixels of (first, second) byte pairs, widened to int16
+    for (; x + kPixels <= dst_width && first[x + kPixels - 1] + 2 <= row_size; x += kPixels) {
+      __m128i v = _mm_setr_epi16(LoadU16(src + first[x]), LoadU16(src + first[x + 1]), LoadU16(src + first[x + 2]),
+                                 LoadU16(src + first[x + 3]), 0, 0, 0, 0);
+      __m128i r = _mm_madd_epi16(_mm_cvtepu8_epi16(v), _mm_loadu_si128(reinterpret_cast<const __m128i *>(coefs + x)));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), r);
+    }
+    return x;
+  }
+  // One pixel per step, the channels of the two taps are paired up as int16
+  const __m128i pairs = channels == kNumChannels
+                          ? _mm_setr_epi8(0, -1, 3, -1, 1, -1, 4, -1, 2, -1, 5, -1, -1, -1, -1, -1)
+                          : _mm_setr_epi8(0, -1, 4, -1, 1, -1, 5, -1, 2, -1, 6, -1, 3, -1, 7, -1);
+  // 3 channels store a fourth element, which the next pixel overwrites
+  int end = channels == kNumChannels ? dst_width - 1 : dst_width;
+  for (; x < end && first[x] + kLoadSize <= row_size; x++) {
+    __m128i v = _mm_shuffle_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + first[x])), pairs);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x * channels), _mm_madd_epi16(v, _mm_set1_epi32(coefs[x])));
+  }
+  return x;
+}
+#endif
+
+void HorizontalPass(const uint8_t *src, int32_t *dst, const LinearTaps &taps, int dst_width, int channels,
+                    int row_size) {
+  int x = 0;
+#ifdef NATIVE_ENABLE_AVX2
+  if (UseAvx2() && (channels == 1 || channels == kNumChannels || channels == 4)) {
+    x = HorizontalPassAvx2(src, dst, taps, dst_width, channels, row_size);
+  }
+#endif
+  switch (channels) {
+    case 1:
+      HorizontalPassFixed<1>(src, dst, taps, x, dst_width);
+      break;
+    case kNumChannels:
+      HorizontalPassFixed<kNumChannels>(src, dst, taps, x, dst_width);
+      break;
+    case 4:
+      HorizontalPassFixed<4>(src, dst, taps, x, dst_width);
+      break;
+    default:
+      for (; x < dst_width; x++) {
+        for (int k = 0; k < channels; k++) {
+          dst[x * channels + k] =
+            src[taps.first[x] + k] * taps.first_coef[x] + src[taps.second[x] + k] * taps.second_coef[x];
+        }
+      }
+  }
+}
+
+inline uint8_t SaturateU8(int v) { return static_cast<uint8_t>(std::min(std::max(v, 0), 255)); }
+
+// Rows are blended like the SIMD code of cv::resize, rounding in two steps
+inline uint8_t BlendTwoStep(int32_t s0, int32_t s1, int16_t b0, int16_t b1) {
+  constexpr int kPreShift = 4;
+  constexpr int kHiShift = 16;
+  constexpr int kRound = 2;
+  auto v0 = static_cast<int16_t>((static_cast<int16_t>(s0 >> kPreShift) * b0) >> kHiShift);
+  auto v1 = static_cast<int16_t>((static_cast<int16_t>(s1 >> kPreShift) * b1) >> kHiShift);
+  return SaturateU8((v0 + v1 + kRound) >> kRound);
+}
+
+#ifdef NATIVE_ENABLE_AVX2
+AVX2_FUNC inline __m256i LoadPreShifted(const int32_t *s) {
+  constexpr int kPreShift = 4;
+  constexpr int kHalf = 8;
+  __m256i lo = _mm256_srai_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s)), kPreShift);
+  __m256i hi = _mm256_srai_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + kHalf)), kPreShift);
+  return _mm256_packs_epi32(lo, hi);
+}
+
+AVX2_FUNC inline __m256i BlendTwoStep16(const int32_t *s0, const int32_t *s1, __m256i b0, __m256i b1) {
+  return _mm256_add_epi16(_mm256_mulhi_epi16(LoadPreShifted(s0), b0), _mm256_mulhi_epi16(LoadPreShifted(s1), b1));
+}
+
+// Returns the number of columns done, a multiple of 32
+AVX2_FUNC int VerticalPassAvx2(const int32_t *s0, const int32_t *s1, int16_t b0, int16_t b1, uint8_t *dst, int width) {
+  constexpr int kStep = 32;
+  constexpr int kHalf = 16;
+  constexpr int kRound = 2;
+  const __m256i vb0 = _mm256_set1_epi16(b0);
+  const __m256i vb1 = _mm256_set1_epi16(b1);
+  const __m256i round = _mm256_set1_epi16(kRound);
+  // packs and packus work within 128 bit lanes, put the 4 byte groups back in order
+  const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+  int x = 0;
+  for (; x + kStep <= width; x += kStep) {
+    __m256i lo = _mm256_srai_epi16(_mm256_add_epi16(BlendTwoStep16(s0 + x, s1 + x, vb0, vb1), round), kRound);
+    __m256i hi =
+      _mm256_srai_epi16(_mm256_add_epi16(BlendTwoStep16(s0 + x + kHalf, s1 + x + kHalf, vb0, vb1), round), kRound);
+    __m256i v = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(lo, hi), order);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + x), v);
+  }
+  return x;
+}
+#endif
+
+void VerticalPass(const int32_t *s0, const int32_t *s1, int16_t b0, int16_t b1, uint8_t *dst, int width) {
+  int x = 0;
+#ifdef NATIVE_ENABLE_AVX2
+  if (UseAvx2()) {
+    x = VerticalPassAvx2(s0, s1, b0, b1, dst, width);
+  }
+#endif
+  for (; x < width; x++) {
+    dst[x] = BlendTwoStep(s0[x], s1[x], b0, b1);
+  }
+}
+
+// convertTo of OpenCV rounds once with FMA in its AVX2 build, and twice otherwise
+inline float MulAdd(float v, float scale, float offset, bool fused) {
+  return fused ? std::fma(v, scale, offset) : v * scale + offset;
+}
+
+template <typename T_in>
+void NormalizePixels(const T_in *in, float *out, int64_t begin, int64_t num_pixels, const float *scale,
+                     const float *offset, bool to_chw) {
+  bool fused = UseAvx2();
+  if (to_chw) {
+    for (int64_t c = 0; c < kNumChannels; c++) {
+      float *out_c = out + c * num_pixels;
+      for (int64_t i = begin; i < num_pixels; i++) {
+        out_c[i] = MulAdd(static_cast<float>(in[i * kNumChannels + c]), scale[c], offset[c], fused);
+      }
+    }
+  } else {
+    for (int64_t i = begin; i < num_pixels; i++) {
+      for (int64_t c = 0; c < kNumChannels; c++) {
+        int64_t k = i * kNumChannels + c;
+        out[k] = MulAdd(static_cast<float>(in[k]), scale[c], offset[c], fused);
+      }
+    }
+  }
+}
+
+#ifdef NATIVE_ENABLE_AVX2
+// Scale and offset of 24 interleaved elements, 8 pixels of 3 channels, split over 3 registers
+struct ChannelPattern {
+  __m256 scale[kNumChannels];
+  __m256 offset[kNumChannels];
+};
+
+AVX2_FUNC void MakeChannelPattern(const float *scale, const float *offset, ChannelPattern *p) {
+  constexpr int kLanes = 8;
+  for (int r = 0; r < kNumChannels; r++) {
+    float s[kLanes];
+    float o[kLanes];
+    for (int i = 0; i < kLanes; i++) {
+      s[i] = scale[(r * kLanes + i) % kNumChannels];
+      o[i] = offset[(r * kLanes + i) % kNumChannels];
+    }
+    p->scale[r] = _mm256_loadu_ps(s);
+    p->offset[r] = _mm256_loadu_ps(o);
+  }
+}
+
+AVX2_FUNC inline __m256 MulAdd(__m256 v, __m256 scale, __m256 offset) { return _mm256_fmadd_ps(v, scale, offset); }
+
+AVX2_FUNC inline __m256 LoadU8AsFloat(__m128i v) { return _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(v)); }
+
+// Shuffle masks picking channel c of 8 interleaved pixels from the first 16 bytes and from the next 8 bytes
+void MakeDeinterleaveMasks(int c, int8_t *lo, int8_t *hi) {
+  constexpr int kBytes = 16;
+  constexpr int8_t kZero = -128;
+  for (int i = 0; i < kBytes; i++) {
+    int pos = i * kNumChannels + c;
+    lo[i] = (i < 8 && pos < kBytes) ? static_cast<int8_t>(pos) : kZero;
+    hi[i] = (i < 8 && pos >= kBytes) ? static_cast<int8_t>(pos - kBytes) : kZero;
+  }
+}
+
+// Returns the number of pixels done, a multiple of 8
+AVX2_FUNC int64_t NormalizeU8Avx2(const uint8_t *in, float *out, int64_t num_pixels, const float *scale,
+                                  const float *offset, bool to_chw) {
+  constexpr int64_t kPixels = 8;
+  constexpr int kLanes = 8;
+  ChannelPattern p;
+  MakeChannelPattern(scale, offset, &p);
+  int64_t i = 0;
+  if (to_chw) {
+    __m128i lo_mask[kNumChannels];
+    __m128i hi_mask[kNumChannels];
+    __m256 vs[kNumChannels];
+    __m256 vo[kNumChannels];
+    for (int c = 0; c < kNumChannels; c++) {
+      int8_t lo[16];
+      int8_t hi[16];
+      MakeDeinterleaveMasks(c, lo, hi);
+      lo_mask[c] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lo));
+      hi_mask[c] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(hi));
+      vs[c] = _mm256_set1_ps(scale[c]);
+      vo[c] = _mm256_set1_ps(offset[c]);
+    }
+    for (; i + kPixels <= num_pixels; i += kPixels) {
+      const uint8_t *src = in + i * kNumChannels;
+      __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+      __m128i v1 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + 16));
+      for (int c = 0; c < kNumChannels; c++) {
+        __m128i bytes = _mm_or_si128(_mm_shuffle_epi8(v0, lo_mask[c]), _mm_shuffle_epi8(v1, hi_mask[c]));
+        _mm256_storeu_ps(out + c * num_pixels + i, MulAdd(LoadU8AsFloat(bytes), vs[c], vo[c]));
+      }
+    }
+  } else {
+    for (; i + kPixels <= num_pixels; i += kPixels) {
+      const uint8_t *src = in + i * kNumChannels;
+      float *dst = out + i * kNumChannels;
+      __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+      __m128i v1 = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + 16));
+      _mm256_storeu_ps(dst, MulAdd(LoadU8AsFloat(v0), p.scale[0], p.offset[0]));
+      _mm256_storeu_ps(dst + kLanes, MulAdd(LoadU8AsFloat(_mm_srli_si128(v0, 8)), p.scale[1], p.offset[1]));
+      _mm256_storeu_ps(dst + 2 * kLanes, MulAdd(LoadU8AsFloat(v1), p.scale[2], p.offset[2]));
+    }
+  }
+  return i;
+}
+
+AVX2_FUNC int64_t NormalizeF32Avx2(const float *in, float *out, int64_t num_pixels, const float *scale,
+                                   const float *offset) {
+  constexpr int64_t kPixels = 8;
+  constexpr int kLanes = 8;
+  ChannelPattern p;
+  MakeChannelPattern(scale, offset, &p);
+  int64_t i = 0;
+  for (; i + kPixels <= num_pixels; i += kPixels) {
+    const float *src = in + i * kNumChannels;
+    float *dst = out + i * kNumChannels;
+    for (int r = 0; r < kNumChannels; r++) {
+      _mm256_storeu_ps(dst + r * kLanes, MulAdd(_mm256_loadu_ps(src + r * kLanes), p.scale[r], p.offset[r]));
+    }
+  }
+  return i;
+}
+
+// Returns the number of pixels done, a multiple of 16
+AVX2_FUNC int64_t HwcToChwU8Avx2(const uint8_t *in, uint8_t *out, int64_t num_pixels) {
+  constexpr int64_t kPixels = 16;
+  constexpr int kBytes = 16;
+  constexpr int8_t kZero = -128;
+  __m128i mask[kNumChannels][kNumChannels];
+  for (int c = 0; c < kNumChannels; c++) {
+    for (int r = 0; r < kNumChannels; r++) {
+      int8_t m[kBytes];
+      for (int i = 0; i < kBytes; i++) {
+        int pos = i * kNumChannels + c - r * kBytes;
+        m[i] = (pos >= 0 && pos < kBytes) ? static_cast<int8_t>(pos) : kZero;
+      }
+      mask[c][r] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(m));
+    }
+  }
+  int64_t i = 0;
+  for (; i + kPixels <= num_pixels; i += kPixels) {
+    const uint8_t *src = in + i * kNumChannels;
+    __m128i v[kNumChannels];
+    for (int r = 0; r < kNumChannels; r++) {
+      v[r] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + r * kBytes));
+    }
+    for (int c = 0; c < kNumChannels; c++) {
+      __m128i bytes = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(v[0], mask[c][0]), _mm_shuffle_epi8(v[1], mask[c][1])),
+                                   _mm_shuffle_epi8(v[2], mask[c][2]));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(out + c * num_pixels + i), bytes);
+    }
+  }
+  return i;
+}
+
+// Mirror rows of single byte pixels, returns the number of pixels done, a multiple of 32
+AVX2_FUNC int FlipRowU8Avx2(const uint8_t *in, uint8_t *out, int width) {
+  constexpr int kStep = 32;
+  const __m256i reverse = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11,
+                                           10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  int x = 0;
+  for (; x + kStep <= width; x += kStep) {
+    __m256i v = _mm256_shuffle_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + x)), reverse);
+    v = _mm256_permute2x128_si256(v, v, 1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + width - x - kStep), v);
+  }
+  return x;
+}
+
+// Mirror rows of 4 byte pixels, returns the number of pixels done, a multiple of 8
+AVX2_FUNC int FlipRow32Avx2(const uint8_t *in, uint8_t *out, int width) {
+  constexpr int kStep = 8;
+  constexpr int kPixelSize = 4;
+  const __m256i reverse = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+  int x = 0;
+  for (; x + kStep <= width; x += kStep) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + x * kPixelSize));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + (width - x - kStep) * kPixelSize),
+                        _mm256_permutevar8x32_epi32(v, reverse));
+  }
+  return x;
+}
+#endif
+
+template <typename T>
+void HwcToChwTyped(const T *in, T *out, int64_t num_pixels, int channels, int64_t begin) {
+  for (int c = 0; c < channels; c++) {
+    T *out_c = out + c * num_pixels;
+    for (int64_t i = begin; i < num_pixels; i++) {
+      out_c[i] = in[i * channels + c];
+    }
+  }
+}
+
+// A fixed size lets the compiler turn the copy of a pixel into plain moves
+template <int kPixelSize>
+void FlipRowFixed(const uint8_t *in, uint8_t *out, int width, int begin) {
+  for (int x = begin; x < width; x++) {
+    (void)memcpy(out + (width - 1 - x) * kPixelSize, in + x * kPixelSize, kPixelSize);
+  }
+}
+
+void FlipRow(const uint8_t *in, uint8_t *out, int width, int pixel_size) {
+  int x = 0;
+  switch (pixel_size) {
+    case 1:
+#ifdef NATIVE_ENABLE_AVX2
+      if (UseAvx2()) x = FlipRowU8Avx2(in, out, width);
+#endif
+      FlipRowFixed<1>(in, out, width, x);
+      break;
+    case 2:
+      FlipRowFixed<2>(in, out, width, x);
+      break;
+    case 3:
+      FlipRowFixed<3>(in, out, width, x);
+      break;
+    case 4:
+#ifdef NATIVE_ENABLE_AVX2
+      if (UseAvx2()) x = FlipRow32Avx2(in, out, width);
+#endif
+      FlipRowFixed<4>(in, out, width, x);
+      break;
+    case 8:
+      FlipRowFixed<8>(in, out, width, x);
+      break;
+    case 12:
+      FlipRowFixed<12>(in, out, width, x);
+      break;
+    default:
+      for (; x < width; x++) {
+        (void)memcpy(out + static_cast<int64_t>(width - 1 - x) * pixel_size, in + static_cast<int64_t>(x) * pixel_size,
+                     pixel_size);
+      }
+  }
+}
+}  // namespace
+
+bool UseAvx2() {
+#ifdef NATIVE_ENABLE_AVX2
+  static const bool use_avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+  return use_avx2;
+#else
+  return false;
+#endif
+}
+
+bool ResizeBilinearMatchesCv(int src_height, int src_width, int dst_height, int dst_width) {
+  double scale_x = 1. / (static_cast<double>(dst_width) / src_width);
+  double scale_y = 1. / (static_cast<double>(dst_height) / src_height);
+  auto iscale_x = std::lrint(scale_x);
+  auto iscale_y = std::lrint(scale_y);
+  bool is_area_fast = std::abs(scale_x - iscale_x) < DBL_EPSILON && std::abs(scale_y - iscale_y) < DBL_EPSILON;
+  return !(is_area_fast && iscale_x == 2 && iscale_y == 2);
+}
+
+void ResizeBilinear(const uint8_t *src, int src_height, int src_width, int64_t src_stride, int channels, uint8_t *dst,
+                    int dst_height, int dst_width) {
+  int width = dst_width * channels;
+  LinearTaps x_taps;
+  LinearTaps y_taps;
+  ComputeColumnTaps(src_width, dst_width, channels, &x_taps);
+  ComputeRowTaps(src_height, dst_height, &y_taps);
+  // Horizontally resized source rows, kept for the next destination rows which mostly blend the same ones
+  std::vector<int32_t> buffer(2 * static_cast<int64_t>(width));
+  int32_t *rows[2] = {buffer.data(), buffer.data() + width};
+  int row_ids[2] = {-1, -1};
+  for (int dy = 0; dy < dst_height; dy++) {
+    int sy0 = y_taps.first[dy];
+    int sy1 = y_taps.second[dy];
+    if (row_ids[0] != sy0) {
+      if (row_ids[1] == sy0) {
+        std::swap(rows[0], rows[1]);
+        std::swap(row_ids[0], row_ids[1]);
+      } else {
+        HorizontalPass(src + sy0 * src_stride, rows[0], x_taps, dst_width, channels, src_width * channels);
+        row_ids[0] = sy0;
+      }
+    }
+    const int32_t *second = rows[0];
+    if (sy1 != sy0) {
+      if (row_ids[1] != sy1) {
+        HorizontalPass(src + sy1 * src_stride, rows[1], x_taps, dst_width, channels, src_width * channels);
+        row_ids[1] = sy1;
+      }
+      second = rows[1];
+    }
+    VerticalPass(rows[0], second, y_taps.first_coef[dy], y_taps.second_coef[dy],
+                 dst + static_cast<int64_t>(dy) * width, width);
+  }
+}
+
+void NormalizeToFloat(const uint8_t *in, float *out, int64_t num_pixels, const float *scale, const float *offset,
+                      bool to_chw) {
+  int64_t i = 0;
+#ifdef NATIVE_ENABLE_AVX2
+  if (UseAvx2()) {
+    i = NormalizeU8Avx2(in, out, num_pixels, scale, offset, to_chw);
+  }
+#endif
+  NormalizePixels(in, out, i, num_pixels, scale, offset, to_chw);
+}
+
+void NormalizeToFloat(const float *in, float *out, int64_t num_pixels, const float *scale, const float *offset,
+                      bool to_chw) {
+  int64_t i = 0;
+#ifdef NATIVE_ENABLE_AVX2
+  if (UseAvx2() && !to_chw) {
+    i = NormalizeF32Avx2(in, out, num_pixels, scale, offset);
+  }
+#endif
+  NormalizePixels(in, out, i, num_pixels, scale, offset, to_chw);
+}
+
+void HwcToChw(const uint8_t *in, uint8_t *out, int64_t num_pixels, int channels, int elem_size) {
+  if (channels == 1) {
+    (void)memcpy(out, in, num_pixels * elem_size);
+    return;
+  }
+  switch (elem_size) {
+    case 1: {
+      int64_t i = 0;
+#ifdef NATIVE_ENABLE_AVX2
+      if (UseAvx2() && channels == kNumChannels) {
+        i = HwcToChwU8Avx2(in, out, num_pixels);
+      }
+#endif
+      HwcToChwTyped(in, out, num_pixels, channels, i);
+      break;
+    }
+    case 2:
+      HwcToChwTyped(reinterpret_cast<const uint16_t *>(in), reinterpret_cast<uint16_t *>(out), num_pixels, channels, 0);
+      break;
+    case 4:
+      HwcToChwTyped(reinterpret_cast<const uint32_t *>(in), reinterpret_cast<uint32_t *>(out), num_pixels, channels, 0);
+      break;
+    default:
+      HwcToChwTyped(reinterpret_cast<const uint64_t *>(in), reinterpret_cast<uint64_t *>(out), num_pixels, channels, 0);
+  }
+}
+
+void Flip(const uint8_t *in, uint8_t *out, int height, int width, int pixel_size, bool horizontal) {
+  int64_t row_size = static_cast<int64_t>(width) * pixel_size;
+  for (int y = 0; y < height; y++) {
+    const uint8_t *in_row = in + y * row_size;
+    if (horizontal) {
+      FlipRow(in_row, out + y * row_size, width, pixel_size);
+    } else {
+      (void)memcpy(out + (height - 1 - y) * row_size, in_row, row_size);
+    }
+  }
+}
+
+void CopyRect(const uint8_t *src, int64_t src_stride, uint8_t *dst, int64_t row_size, int rows) {
+  for (int y = 0; y < rows; y++) {
+    (void)memcpy(dst + y * row_size, src + y * src_stride, row_size);
+  }
+}
+}  // namespace native
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,86 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_NATIVE_IMAGE_UTILS_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_NATIVE_IMAGE_UTILS_H_
+
+#include <cstdint>
+
+namespace mindspore {
+namespace dataset {
+/// Image kernels working directly on the buffers of interleaved <H,W,C> images, without going through cv::Mat.
+/// They are used by image_utils for the hot augmentation ops and produce the same results as the OpenCV calls they
+/// replace. The inner loops use AVX2 when the CPU supports it, the results do not depend on it.
+namespace native {
+/// \brief Whether the native kernels run with AVX2 and FMA on this CPU
+bool UseAvx2();
+
+/// \brief Whether ResizeBilinear gives the same result as cv::resize with INTER_LINEAR for the sizes. OpenCV turns
+///     an exact 2x down-scaling into INTER_AREA.
+bool ResizeBilinearMatchesCv(int src_height, int src_width, int dst_height, int dst_width);
+
+/// \brief Bilinear resize of a uint8 image, in the fixed point arithmetic of cv::resize with INTER_LINEAR
+/// \param src: first pixel of the source image
+/// \param src_height: height of the source image
+/// \param src_width: width of the source image
+/// \param src_stride: distance in bytes between two rows of the source image
+/// \param channels: number of channels
+/// \param dst: destination image, a dense <dst_height,dst_width,channels> buffer
+/// \param dst_height: height of the destination image
+/// \param dst_width: width of the destination image
+void ResizeBilinear(const uint8_t *src, int src_height, int src_width, int64_t src_stride, int channels, uint8_t *dst,
+                    int dst_height, int dst_width);
+
+/// \brief out = in * scale[c] + offset[c] for the pixels of a <H,W,3> image, in a single pass. The rounding follows
+///     convertTo of OpenCV, fused multiply add when UseAvx2().
+/// \param in: input pixels
+/// \param out: output pixels, <H,W,3> or <3,H,W> if to_chw
+/// \param num_pixels: H * W
+/// \param scale: scale of each channel
+/// \param offset: offset of each channel
+/// \param to_chw: transpose the output to <3,H,W>
+void NormalizeToFloat(const uint8_t *in, float *out, int64_t num_pixels, const float *scale, const float *offset,
+                      bool to_chw);
+void NormalizeToFloat(const float *in, float *out, int64_t num_pixels, const float *scale, const float *offset,
+                      bool to_chw);
+
+/// \brief Transpose a <H,W,C> image to <C,H,W>
+/// \param in: input pixels
+/// \param out: output pixels
+/// \param num_pixels: H * W
+/// \param channels: C
+/// \param elem_size: size in bytes of one element, 1, 2, 4 or 8
+void HwcToChw(const uint8_t *in, uint8_t *out, int64_t num_pixels, int channels, int elem_size);
+
+/// \brief Mirror a <H,W,C> image
+/// \param in: input pixels
+/// \param out: output pixels
+/// \param height: H
+/// \param width: W
+/// \param pixel_size: C times the size in bytes of one element
+/// \param horizontal: flip around the y-axis if true, around the x-axis if false
+void Flip(const uint8_t *in, uint8_t *out, int height, int width, int pixel_size, bool horizontal);
+
+/// \brief Copy a rectangle of rows
+/// \param src: first byte of the rectangle
+/// \param src_stride: distance in bytes between two rows of the source
+/// \param dst: destination, rows are dense
+/// \param row_size: size in bytes of one row of the rectangle
+/// \param rows: number of rows
+void CopyRect(const uint8_t *src, int64_t src_stride, uint8_t *dst, int64_t row_size, int rows);
+}  // namespace native
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_NATIVE_IMAGE_UTILS_H_
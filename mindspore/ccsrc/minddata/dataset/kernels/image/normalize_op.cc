@@ -40,6 +40,20 @@ Status NormalizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_pt
   return Normalize(input, output, mean_, std_);
 }
 
+Status NormalizeOp::GetMeanStd(std::vector<float> *mean, std::vector<float> *stddev) const {
+  RETURN_UNEXPECTED_IF_NULL(mean);
+  RETURN_UNEXPECTED_IF_NULL(stddev);
+  mean->clear();
+  stddev->clear();
+  for (auto it = mean_->begin<float>(); it != mean_->end<float>(); ++it) {
+    mean->push_back(*it);
+  }
+  for (auto it = std_->begin<float>(); it != std_->end<float>(); ++it) {
+    stddev->push_back(*it);
+  }
+  return Status::OK();
+}
+
 void NormalizeOp::Print(std::ostream &out) const {
   out << "NormalizeOp, mean: " << mean_ << std::endl << "std: " << std_ << std::endl;
 }
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "minddata/dataset/core/cv_tensor.h"
 #include "minddata/dataset/core/tensor.h"
@@ -38,6 +39,12 @@ class NormalizeOp : public TensorOp {
 
   std::string Name() const override { return kNormalizeOp; }
 
+  // Get the mean and the standard deviation of the RGB channels
+  // @param mean - The mean of each channel
+  // @param stddev - The standard deviation of each channel
+  // @return Status - The error code return
+  Status GetMeanStd(std::vector<float> *mean, std::vector<float> *stddev) const;
+
  private:
   std::shared_ptr<Tensor> mean_;
   std::shared_ptr<Tensor> std_;
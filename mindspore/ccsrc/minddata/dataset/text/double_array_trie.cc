@@ -0,0 +1,195 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/text/double_array_trie.h"
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Number of transitions of a state, one per byte
+constexpr int32_t kAlphabetSize = 256;
+// Number of failed tries after which a free slot is no longer tried as the first transition of a state
+constexpr int32_t kMaxFreeTries = 16;
+}  // namespace
+
+void DoubleArrayTrie::Resize(size_t size) {
+  base_.resize(size, 0);
+  check_.resize(size, kNoState);
+  value_.resize(size, kNoValue);
+}
+
+void DoubleArrayTrie::Grow(size_t size) {
+  size_t old_size = check_.size();
+  Resize(size);
+  next_free_.resize(size, kNoState);
+  prev_free_.resize(size, kNoState);
+  free_tries_.resize(size, 0);
+  for (size_t i = old_size; i < size; ++i) {
+    int32_t pos = static_cast<int32_t>(i);
+    prev_free_[pos] = free_tail_;
+    if (free_tail_ == kNoState) {
+      free_head_ = pos;
+    } else {
+      next_free_[free_tail_] = pos;
+    }
+    free_tail_ = pos;
+  }
+}
+
+void DoubleArrayTrie::Unlink(int32_t pos) {
+  if (free_tries_[pos] == kNoState) {
+    return;
+  }
+  free_tries_[pos] = kNoState;
+  if (prev_free_[pos] == kNoState) {
+    free_head_ = next_free_[pos];
+  } else {
+    next_free_[prev_free_[pos]] = next_free_[pos];
+  }
+  if (next_free_[pos] == kNoState) {
+    free_tail_ = prev_free_[pos];
+  } else {
+    prev_free_[next_free_[pos]] = prev_free_[pos];
+  }
+}
+
+int32_t DoubleArrayTrie::FindBase(const std::vector<int32_t> &codes) {
+  // The first transition is tried on the free slots in order, used slots are never visited
+  int32_t pos = free_head_;
+  while (true) {
+    if (pos == kNoState) {
+      // Every slot of the list was tried, the slots past the end are all free
+      size_t old_size = check_.size();
+      Grow(old_size * 2);
+      pos = static_cast<int32_t>(old_size);
+    }
+    if (pos >= codes[0]) {
+      int32_t base = pos - codes[0];
+      if (static_cast<size_t>(base) + kAlphabetSize >= check_.size()) {
+        Grow(std::max(check_.size() * 2, static_cast<size_t>(base) + kAlphabetSize + 1));
+      }
+      bool free = std::all_of(codes.begin() + 1, codes.end(),
+                              [this, base](int32_t code) { return check_[base + code] == kNoState; });
+      if (free) {
+        return base;
+      }
+      // A slot stuck among used ones would be tried by every later state, giving it up after a few tries keeps Build
+      // linear, it remains free for the other transitions
+      int32_t next = next_free_[pos];
+      if (++free_tries_[pos] >= kMaxFreeTries) {
+        Unlink(pos);
+      }
+      pos = next;
+    } else {
+      pos = next_free_[pos];
+    }
+  }
+}
+
+Status DoubleArrayTrie::Build(const std::unordered_map<std::string, int32_t> &keys) {
+  // In sorted order the keys below a state are a range, and the keys below each of its transitions are sub-ranges
+  std::vector<std::pair<std::string_view, int32_t>> sorted_keys;
+  sorted_keys.reserve(keys.size());
+  for (const auto &key : keys) {
+    CHECK_FAIL_RETURN_UNEXPECTED(key.second >= 0, "The value of key " + key.first + " is negative.");
+    sorted_keys.emplace_back(key.first, key.second);
+  }
+  std::sort(sorted_keys.begin(), sorted_keys.end());
+
+  base_.clear();
+  check_.clear();
+  value_.clear();
+  next_free_.clear();
+  prev_free_.clear();
+  free_tries_.clear();
+  free_head_ = kNoState;
+  free_tail_ = kNoState;
+  Grow(kAlphabetSize + 1);
+  Unlink(kRoot);
+  int32_t max_base = 0;
+
+  // The states are placed in breadth first order, each one with all its transitions at once
+  struct Range {
+    int32_t state;
+    size_t begin;
+    size_t end;
+    size_t depth;
+  };
+  std::deque<Range> ranges = {{kRoot, 0, sorted_keys.size(), 0}};
+  std::vector<int32_t> codes;
+  std::vector<size_t> bounds;
+  while (!ranges.empty()) {
+    Range range = ranges.front();
+    ranges.pop_front();
+    size_t begin = range.begin;
+    if (begin < range.end && sorted_keys[begin].first.size() == range.depth) {
+      value_[range.state] = sorted_keys[begin].second;
+      begin++;
+    }
+    if (begin == range.end) {
+      continue;
+    }
+    codes.clear();
+    bounds.clear();
+    for (size_t i = begin; i < range.end; ++i) {
+      int32_t code = static_cast<uint8_t>(sorted_keys[i].first[range.depth]) + 1;
+      if (codes.empty() || codes.back() != code) {
+        codes.push_back(code);
+        bounds.push_back(i);
+      }
+    }
+    bounds.push_back(range.end);
+    int32_t base = FindBase(codes);
+    base_[range.state] = base;
+    max_base = std::max(max_base, base);
+    for (size_t i = 0; i < codes.size(); ++i) {
+      check_[base + codes[i]] = range.state;
+      Unlink(base + codes[i]);
+      ranges.push_back({base + codes[i], bounds[i], bounds[i + 1], range.depth + 1});
+    }
+  }
+
+  next_free_ = std::vector<int32_t>();
+  prev_free_ = std::vector<int32_t>();
+  free_tries_ = std::vector<int32_t>();
+  // Every transition of every state stays inside the arrays, so Next does not check the bounds
+  Resize(max_base + kAlphabetSize + 1);
+  base_.shrink_to_fit();
+  check_.shrink_to_fit();
+  value_.shrink_to_fit();
+  return Status::OK();
+}
+
+int32_t DoubleArrayTrie::Traverse(std::string_view str, int32_t state) const {
+  for (char c : str) {
+    if (!Next(&state, c)) {
+      return kNoState;
+    }
+  }
+  return state;
+}
+
+int32_t DoubleArrayTrie::Find(std::string_view key) const {
+  int32_t state = Traverse(key);
+  return state == kNoState ? kNoValue : Value(state);
+}
+
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,105 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_DOUBLE_ARRAY_TRIE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_DOUBLE_ARRAY_TRIE_H_
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+
+// Byte-wise trie of a set of strings, stored as a double array. The transition of state s on byte c goes to
+// t = base[s] + c + 1 when check[t] == s, so walking a string costs one array access per byte and needs neither
+// allocation nor hashing of the string. Any prefix of a walk is itself a lookup, which gives prefix matching for free.
+class DoubleArrayTrie {
+ public:
+  static constexpr int32_t kRoot = 0;
+  static constexpr int32_t kNoState = -1;
+  static constexpr int32_t kNoValue = -1;
+
+  DoubleArrayTrie() = default;
+
+  ~DoubleArrayTrie() = default;
+
+  // Build the trie of a set of keys
+  // @param std::unordered_map<std::string, int32_t> &keys - keys and their values, the values are not negative
+  // @return Status - The error code return
+  Status Build(const std::unordered_map<std::string, int32_t> &keys);
+
+  // Follow the transition of one byte
+  // @param int32_t *state - current state, moved to the next state if the transition exists
+  // @param char c - next byte
+  // @return bool - whether the transition exists
+  bool Next(int32_t *state, char c) const {
+    int32_t next = base_[*state] + static_cast<uint8_t>(c) + 1;
+    if (check_[next] != *state) {
+      return false;
+    }
+    *state = next;
+    return true;
+  }
+
+  // @param int32_t state -
+  // @return int32_t - value of the key which ends at the state, kNoValue if no key ends there
+  int32_t Value(int32_t state) const { return value_[state]; }
+
+  // Follow the transitions of a string
+  // @param std::string_view str -
+  // @param int32_t state - state to start from
+  // @return int32_t - state reached at the end of str, kNoState if a transition does not exist
+  int32_t Traverse(std::string_view str, int32_t state = kRoot) const;
+
+  // Exact lookup of a key
+  // @param std::string_view key -
+  // @return int32_t - value of the key, kNoValue if it does not exist
+  int32_t Find(std::string_view key) const;
+
+ private:
+  // @param std::vector<int32_t> &codes - transitions of a state, byte + 1 in increasing order
+  // @return int32_t - a base for which all the transitions land on free slots
+  int32_t FindBase(const std::vector<int32_t> &codes);
+
+  void Resize(size_t size);
+
+  // Resize and add the new slots at the end of the free list
+  // @param size_t size - new size, larger than the current one
+  void Grow(size_t size);
+
+  // Remove a slot from the free list, nothing happens if it is not in the list
+  // @param int32_t pos -
+  void Unlink(int32_t pos);
+
+  std::vector<int32_t> base_;
+  std::vector<int32_t> check_;
+  std::vector<int32_t> value_;
+  // Doubly linked list of the free slots still tried as the first transition of a state, used during Build
+  std::vector<int32_t> next_free_;
+  std::vector<int32_t> prev_free_;
+  std::vector<int32_t> free_tries_;  // Failed tries of each slot in the list, kNoState once it left the list
+  int32_t free_head_ = kNoState;
+  int32_t free_tail_ = kNoState;
+};
+
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_DOUBLE_ARRAY_TRIE_H_
@@ -36,8 +36,9 @@ class BertTokenizerOp : public TensorOp {
                            const bool &keep_whitespace = BasicTokenizerOp::kDefKeepWhitespace,
                            const NormalizeForm &normalization_form = BasicTokenizerOp::kDefNormalizationForm,
                            const bool &preserve_unused_token = BasicTokenizerOp::kDefPreserveUnusedToken,
-                           const bool &with_offsets = WordpieceTokenizerOp::kDefWithOffsets)
-      : wordpiece_tokenizer_(vocab, suffix_indicator, max_bytes_per_token, unknown_token, with_offsets),
+                           const bool &with_offsets = WordpieceTokenizerOp::kDefWithOffsets,
+                           const bool &output_ids = WordpieceTokenizerOp::kDefOutputIds)
+      : wordpiece_tokenizer_(vocab, suffix_indicator, max_bytes_per_token, unknown_token, with_offsets, output_ids),
         basic_tokenizer_(lower_case, keep_whitespace, normalization_form, preserve_unused_token, with_offsets) {}
 
   ~BertTokenizerOp() override = default;
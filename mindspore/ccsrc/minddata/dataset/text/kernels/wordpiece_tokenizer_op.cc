@@ -20,95 +20,117 @@
 
 namespace mindspore {
 namespace dataset {
+namespace {
+bool IsContinuationByte(char c) { return (static_cast<uint8_t>(c) & 0xC0) == 0x80; }
+
+bool IsValidUtf8(std::string_view str) {
+  for (size_t i = 0; i < str.size();) {
+    uint8_t lead = static_cast<uint8_t>(str[i]);
+    size_t len = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+    if (len == 0 || i + len > str.size()) {
+      return false;
+    }
+    for (size_t j = i + 1; j < i + len; ++j) {
+      if (!IsContinuationByte(str[j])) {
+        return false;
+      }
+    }
+    i += len;
+  }
+  return true;
+}
+}  // namespace
 
 const char WordpieceTokenizerOp::kDefSuffixIndicator[] = "##";
 const int WordpieceTokenizerOp::kDefMaxBytesPerToken = 100;
 const char WordpieceTokenizerOp::kDefUnknownToken[] = "[UNK]";
 const bool WordpieceTokenizerOp::kDefWithOffsets = false;
+const bool WordpieceTokenizerOp::kDefOutputIds = false;
 
 WordpieceTokenizerOp::WordpieceTokenizerOp(const std::shared_ptr<Vocab> &vocab, const std::string &suffix_indicator,
                                            const int &max_bytes_per_token, const std::string &unknown_token,
-                                           const bool &with_offsets)
+                                           const bool &with_offsets, const bool &output_ids)
     : vocab_(vocab),
       suffix_indicator_(suffix_indicator),
+      with_offsets_(with_offsets),
       max_bytes_per_token_(max_bytes_per_token),
       unknown_token_(unknown_token),
-      with_offsets_(with_offsets) {}
+      output_ids_(output_ids) {}
 
-Status WordpieceTokenizerOp::LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start,
-                                        bool *out_found, int *out_end) const {
-  CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && start < input_token.size(), "Out of range");
-  *out_found = false;
-  for (int i = runes.size() - 1; i >= 0; i--) {
-    *out_end = runes[i].offset + runes[i].len;
-    int len = *out_end - start;
-    std::string word = input_token.substr(start, len);
-    if (start > 0) {
-      word = suffix_indicator_ + word;
-    }
-    if (vocab_->Lookup(word) != Vocab::kNoTokenExists) {
-      *out_found = true;
-      break;
+void WordpieceTokenizerOp::LookupWord(std::string_view input_token, const DoubleArrayTrie &trie, int32_t state,
+                                      int start, Subword *out_subword) {
+  out_subword->start = start;
+  out_subword->end = start;
+  out_subword->id = Vocab::kNoTokenExists;
+  if (state == DoubleArrayTrie::kNoState) {
+    return;
+  }
+  // Every byte walks one step down the trie, the last word met is the longest one
+  for (int i = start; i < input_token.size() && trie.Next(&state, input_token[i]); ++i) {
+    int end = i + 1;
+    if (trie.Value(state) != DoubleArrayTrie::kNoValue &&
+        (end == input_token.size() || !IsContinuationByte(input_token[end]))) {
+      out_subword->end = end;
+      out_subword->id = trie.Value(state);
     }
   }
-  return Status::OK();
 }
 
-Status WordpieceTokenizerOp::FoundNoToken(const std::string &input_token, const uint32_t &basic_start,
-                                          std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
-                                          std::vector<uint32_t> *offsets_limit) const {
-  out_tokens->clear();
-  offsets_start->push_back(basic_start);
-  if (unknown_token_.empty()) {
-    out_tokens->emplace_back(input_token);
-    offsets_limit->push_back(basic_start + input_token.length());
+Status WordpieceTokenizerOp::AddToken(std::string_view token, const DoubleArrayTrie &trie, Output *output) const {
+  if (output_ids_) {
+    WordIdType id = trie.Find(token);
+    CHECK_FAIL_RETURN_UNEXPECTED(
+      id != Vocab::kNoTokenExists,
+      "Lookup Error: token: " + std::string(token) + " doesn't exist in vocab and no unknown token is specified.");
+    output->ids.push_back(id);
   } else {
-    out_tokens->emplace_back(unknown_token_);
-    offsets_limit->push_back(basic_start + input_token.length());
+    output->tokens.emplace_back(token);
   }
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::AddSubword(const std::string &input_token, const int &start, const int &end,
-                                        std::vector<std::string> *out_tokens) const {
-  CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && end > start && end <= input_token.size(), "Out of range");
-  std::string subword = input_token.substr(start, end - start);
-  if (start > 0) {
-    subword = suffix_indicator_ + subword;
-  }
-  out_tokens->emplace_back(subword);
-  return Status::OK();
+Status WordpieceTokenizerOp::FoundNoToken(std::string_view input_token, const uint32_t &basic_start,
+                                          const DoubleArrayTrie &trie, Output *output) const {
+  output->offsets_start.push_back(basic_start);
+  output->offsets_limit.push_back(basic_start + input_token.length());
+  return AddToken(unknown_token_.empty() ? input_token : std::string_view(unknown_token_), trie, output);
 }
 
-Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uint32_t &basic_start,
-                                       std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
-                                       std::vector<uint32_t> *offsets_limit) const {
+Status WordpieceTokenizerOp::GetTokens(std::string_view input_token, const uint32_t &basic_start,
+                                       const DoubleArrayTrie &trie, int32_t suffix_state,
+                                       std::vector<Subword> *subwords, Output *output) const {
   if (input_token.size() > max_bytes_per_token_) {
-    offsets_start->push_back(basic_start);
+    output->offsets_start.push_back(basic_start);
     if (!unknown_token_.empty()) {
-      offsets_limit->push_back(basic_start + unknown_token_.size());
-      out_tokens->emplace_back(unknown_token_);
-    } else {
-      out_tokens->emplace_back(input_token);
-      offsets_limit->push_back(basic_start + input_token.size());
+      output->offsets_limit.push_back(basic_start + unknown_token_.size());
+      return AddToken(unknown_token_, trie, output);
     }
-    return Status::OK();
+    output->offsets_limit.push_back(basic_start + input_token.size());
+    return AddToken(input_token, trie, output);
   }
-  RuneStrArray runes;
-  if (!DecodeRunesInString(input_token.data(), input_token.size(), runes)) {
+  if (!IsValidUtf8(input_token)) {
     RETURN_STATUS_UNEXPECTED("Decode utf8 string failed.");
   }
-  int end = 0;
+  subwords->clear();
   for (int start = 0; start < input_token.size();) {
-    bool found = false;
-    RETURN_IF_NOT_OK(LookupWord(input_token, runes, start, &found, &end));
-    if (found) {
-      RETURN_IF_NOT_OK(AddSubword(input_token, start, end, out_tokens));
-      offsets_start->push_back(static_cast<uint32_t>(basic_start + start));
-      offsets_limit->push_back(static_cast<uint32_t>(basic_start + end));
-      start = end;
+    Subword subword;
+    LookupWord(input_token, trie, start == 0 ? DoubleArrayTrie::kRoot : suffix_state, start, &subword);
+    if (subword.end == start) {
+      return FoundNoToken(input_token, basic_start, trie, output);
+    }
+    subwords->push_back(subword);
+    start = subword.end;
+  }
+  for (const auto &subword : *subwords) {
+    output->offsets_start.push_back(static_cast<uint32_t>(basic_start + subword.start));
+    output->offsets_limit.push_back(static_cast<uint32_t>(basic_start + subword.end));
+    if (output_ids_) {
+      output->ids.push_back(subword.id);
+    } else if (subword.start > 0) {
+      output->tokens.emplace_back(suffix_indicator_);
+      output->tokens.back().append(input_token.substr(subword.start, subword.end - subword.start));
     } else {
-      return FoundNoToken(input_token, basic_start, out_tokens, offsets_start, offsets_limit);
+      output->tokens.emplace_back(input_token.substr(subword.start, subword.end - subword.start));
     }
   }
   return Status::OK();
@@ -119,30 +141,44 @@ Status WordpieceTokenizerOp::Compute(const TensorRow &input, TensorRow *output)
   if (input[0]->Rank() > 1 || input[0]->type() != DataType::DE_STRING) {
     RETURN_STATUS_UNEXPECTED("The input tensor should be scalar or 1-D string tensor");
   }
+  RETURN_UNEXPECTED_IF_NULL(vocab_);
+  std::shared_ptr<const DoubleArrayTrie> trie;
+  RETURN_IF_NOT_OK(vocab_->GetTrie(&trie));
+  // The subwords after the first one are looked up from the state of the trie after the suffix indicator
+  int32_t suffix_state = trie->Traverse(suffix_indicator_);
   dsize_t count = 0;
-  std::vector<std::string> out_tokens;
-  std::vector<uint32_t> offsets_start, offsets_limit;
+  Output out;
+  std::vector<Subword> subwords;
   std::shared_ptr<Tensor> token_tensor, offsets_start_tensor, offsets_limit_tensor;
   for (auto iter = input[0]->begin<std::string_view>(); iter != input[0]->end<std::string_view>(); iter++) {
     uint32_t basic_start = 0;
-    std::vector<std::string> temp_tokens;
     if (with_offsets_ && input.size() == 3) {
       RETURN_IF_NOT_OK(input[1]->GetItemAt<uint32_t>(&basic_start, {count, 0}));
     }
-    RETURN_IF_NOT_OK(GetTokens(std::string(*iter), basic_start, &temp_tokens, &offsets_start, &offsets_limit));
-    out_tokens.insert(out_tokens.end(), temp_tokens.begin(), temp_tokens.end());
+    RETURN_IF_NOT_OK(GetTokens(*iter, basic_start, *trie, suffix_state, &subwords, &out));
     count++;
   }
-  if (out_tokens.empty()) {
-    out_tokens.emplace_back("");
-    offsets_start.push_back(0);
-    offsets_limit.push_back(0);
+  if (output_ids_) {
+    if (out.ids.empty()) {
+      // the string path gives one empty token, which a lookup maps to the unknown token unless "" is in the vocab
+      bool has_empty = trie->Find("") != Vocab::kNoTokenExists;
+      RETURN_IF_NOT_OK(AddToken(has_empty ? "" : unknown_token_, *trie, &out));
+      out.offsets_start.push_back(0);
+      out.offsets_limit.push_back(0);
+    }
+    RETURN_IF_NOT_OK(Tensor::CreateFromVector(out.ids, &token_tensor));
+  } else {
+    if (out.tokens.empty()) {
+      out.tokens.emplace_back("");
+      out.offsets_start.push_back(0);
+      out.offsets_limit.push_back(0);
+    }
+    RETURN_IF_NOT_OK(Tensor::CreateFromVector(out.tokens, &token_tensor));
   }
-  Tensor::CreateFromVector(out_tokens, &token_tensor);
   output->push_back(token_tensor);
   if (with_offsets_) {
-    RETURN_IF_NOT_OK(Tensor::CreateFromVector(offsets_start, &offsets_start_tensor));
-    RETURN_IF_NOT_OK(Tensor::CreateFromVector(offsets_limit, &offsets_limit_tensor));
+    RETURN_IF_NOT_OK(Tensor::CreateFromVector(out.offsets_start, &offsets_start_tensor));
+    RETURN_IF_NOT_OK(Tensor::CreateFromVector(out.offsets_limit, &offsets_limit_tensor));
 
     output->push_back(offsets_start_tensor);
     output->push_back(offsets_limit_tensor);
@@ -20,15 +20,12 @@
 #include <string_view>
 #include <vector>
 
-#include "cppjieba/Unicode.hpp"
-
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/text/double_array_trie.h"
 #include "minddata/dataset/text/vocab.h"
 #include "minddata/dataset/util/status.h"
 
-using cppjieba::DecodeRunesInString;
-using cppjieba::RuneStrArray;
 namespace mindspore {
 namespace dataset {
 
@@ -38,23 +35,48 @@ class WordpieceTokenizerOp : public TensorOp {
   static const int kDefMaxBytesPerToken;
   static const char kDefUnknownToken[];
   static const bool kDefWithOffsets;
+  static const bool kDefOutputIds;
   WordpieceTokenizerOp(const std::shared_ptr<Vocab> &vocab, const std::string &suffix_indicator = kDefSuffixIndicator,
                        const int &max_bytes_per_token = kDefMaxBytesPerToken,
-                       const std::string &unknown_token = kDefUnknownToken, const bool &with_offsets = kDefWithOffsets);
+                       const std::string &unknown_token = kDefUnknownToken, const bool &with_offsets = kDefWithOffsets,
+                       const bool &output_ids = kDefOutputIds);
 
   ~WordpieceTokenizerOp() override = default;
 
   Status Compute(const TensorRow &input, TensorRow *output) override;
 
  protected:
-  Status AddSubword(const std::string &input_token, const int &start, const int &end,
-                    std::vector<std::string> *out_token) const;
-  Status FoundNoToken(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
-                      std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
-  Status LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start, bool *out_found,
-                    int *out_end) const;
-  Status GetTokens(const std::string &input_token, const uint32_t &basic_start, std::vector<std::string> *out_tokens,
-                   std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
+  // A subword of a token, it is looked up with the suffix indicator in front when it does not start the token
+  struct Subword {
+    int start;
+    int end;
+    WordIdType id;
+  };
+
+  // Output of the tokenizer, the subwords are either copied as strings or given as ids
+  struct Output {
+    std::vector<std::string> tokens;
+    std::vector<WordIdType> ids;
+    std::vector<uint32_t> offsets_start;
+    std::vector<uint32_t> offsets_limit;
+  };
+
+  // Find the longest word of the vocab which starts at start and ends on a character boundary
+  // @param std::string_view input_token -
+  // @param const DoubleArrayTrie &trie - compiled vocab
+  // @param int32_t state - state of the trie in front of the word, after the suffix indicator when start > 0
+  // @param int start - offset of the word in input_token
+  // @param Subword *out_subword - Returned word, it ends at start if there is none
+  static void LookupWord(std::string_view input_token, const DoubleArrayTrie &trie, int32_t state, int start,
+                         Subword *out_subword);
+
+  Status AddToken(std::string_view token, const DoubleArrayTrie &trie, Output *output) const;
+
+  Status FoundNoToken(std::string_view input_token, const uint32_t &basic_start, const DoubleArrayTrie &trie,
+                      Output *output) const;
+
+  Status GetTokens(std::string_view input_token, const uint32_t &basic_start, const DoubleArrayTrie &trie,
+                   int32_t suffix_state, std::vector<Subword> *subwords, Output *output) const;
 
   std::string Name() const override { return kWordpieceTokenizerOp; }
 
@@ -64,6 +86,7 @@ class WordpieceTokenizerOp : public TensorOp {
   const bool with_offsets_;
   const int max_bytes_per_token_;
   const std::string unknown_token_;
+  const bool output_ids_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -31,6 +31,17 @@ WordIdType Vocab::Lookup(const WordType &word) const {
   return itr == word2id_.end() ? kNoTokenExists : itr->second;
 }
 
+Status Vocab::GetTrie(std::shared_ptr<const DoubleArrayTrie> *trie) const {
+  std::lock_guard<std::mutex> lock(trie_mutex_);
+  if (trie_ == nullptr) {
+    auto new_trie = std::make_shared<DoubleArrayTrie>();
+    RETURN_IF_NOT_OK(new_trie->Build(word2id_));
+    trie_ = std::move(new_trie);
+  }
+  *trie = trie_;
+  return Status::OK();
+}
+
 Status Vocab::BuildFromPyList(const py::list &words, const py::list &special_tokens, bool prepend_special,
                               std::shared_ptr<Vocab> *vocab) {
   // check of duplication on both words and special_tokens will be performed in python
@@ -65,6 +76,8 @@ Status Vocab::BuildFromPyDict(const py::dict &words, std::shared_ptr<Vocab> *voc
 void Vocab::append_word(const std::string &word) {
   if (word2id_.find(word) == word2id_.end()) {
     word2id_[word] = word2id_.size();
+    std::lock_guard<std::mutex> lock(trie_mutex_);
+    trie_.reset();
   }
 }
 
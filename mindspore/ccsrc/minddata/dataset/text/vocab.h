@@ -19,9 +19,11 @@
 
 #include <string>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
+#include "minddata/dataset/text/double_array_trie.h"
 #include "minddata/dataset/util/status.h"
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
@@ -91,6 +93,11 @@ class Vocab {
   // @return WordIdType, word_id
   WordIdType Lookup(const WordType &word) const;
 
+  // Compiled form of the vocab for lookups without allocation and prefix matching, built on the first call
+  // @param std::shared_ptr<const DoubleArrayTrie> *trie - return value, the value of each word is its id
+  // @return error code
+  Status GetTrie(std::shared_ptr<const DoubleArrayTrie> *trie) const;
+
   // constructor, shouldn't be called directly, can't be private due to std::make_unique()
   // @param std::unordered_map<WordType, WordIdType> map - sanitized word2id map
   explicit Vocab(std::unordered_map<WordType, WordIdType> map);
@@ -108,6 +115,8 @@ class Vocab {
 
  private:
   std::unordered_map<WordType, WordIdType> word2id_;
+  mutable std::mutex trie_mutex_;
+  mutable std::shared_ptr<const DoubleArrayTrie> trie_;  // Reset when a word is appended
 };
 
 }  // namespace dataset
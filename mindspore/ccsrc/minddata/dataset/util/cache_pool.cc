@@ -13,18 +13,42 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#ifdef ENABLE_CACHE
+#include <zlib.h>
+#endif
 #include <algorithm>
+#include <limits>
 #include "utils/ms_utils.h"
 #include "minddata/dataset/util/cache_pool.h"
 #include "minddata/dataset/util/services.h"
 
 namespace mindspore {
 namespace dataset {
-CachePool::CachePool(const value_allocator &alloc, const std::string &root)
-    : alloc_(alloc), root_(root), subfolder_(Services::GetUniqueID()), sm_(nullptr), tree_(nullptr) {}
+CachePool::CachePool(const value_allocator &alloc, const std::string &root, EvictPolicy policy, bool compress)
+    : alloc_(alloc),
+      root_(root),
+      subfolder_(Services::GetUniqueID()),
+      sm_(nullptr),
+      tree_(nullptr),
+      policy_(policy),
+      compress_(compress),
+      clock_(0),
+      num_evicted_(0),
+      num_mem_hit_(0),
+      num_disk_hit_(0) {
+#ifndef ENABLE_CACHE
+  if (compress_) {
+    MS_LOG(WARNING) << "Compression is not supported on this platform. Buffers will be cached uncompressed.";
+    compress_ = false;
+  }
+#endif
+}
 
 Status CachePool::DoServiceStart() {
   tree_ = std::make_shared<data_index>();
+  num_evicted_ = 0;
+  num_mem_hit_ = 0;
+  num_disk_hit_ = 0;
   // If we are given a disk path, set up the StorageManager
   if (!root_.toString().empty()) {
     Path spill = GetSpillPath();
@@ -45,6 +69,11 @@ Status CachePool::DoServiceStop() {
     }
   }
   sm_.reset();
+  {
+    std::unique_lock<std::mutex> lck(evict_mux_);
+    priority_.clear();
+    victims_.clear();
+  }
   for (auto &bl : *tree_) {
     if (bl.ptr != nullptr) {
       alloc_.deallocate(bl.ptr, bl.sz);
@@ -76,13 +105,36 @@ Status CachePool::Insert(const std::vector<ReadableSlice> &buf, CachePool::key_t
   for (auto &v : buf) {
     sz += v.GetSize();
   }
+  bl.raw_sz = sz;
+  // Only keep the compressed form if it is smaller.
+  std::string compressed;
+  std::vector<ReadableSlice> packed;
+  if (compress_) {
+    RETURN_IF_NOT_OK(Compress(buf, sz, &compressed));
+    if (!compressed.empty() && compressed.size() < sz) {
+      packed.emplace_back(compressed.data(), compressed.size());
+      sz = compressed.size();
+    }
+  }
+  const std::vector<ReadableSlice> &data = packed.empty() ? buf : packed;
   bl.sz = sz;
-  try {
-    bl.ptr = alloc_.allocate(sz);
+  // If we run out of memory, move other buffers out of memory to make room for this one.
+  bool evicted = true;
+  while (bl.ptr == nullptr && evicted) {
+    try {
+      bl.ptr = alloc_.allocate(sz);
+    } catch (std::bad_alloc &e) {
+      evicted = false;
+      if (policy_ != EvictPolicy::kNone) {
+        RETURN_IF_NOT_OK(EvictOne(&evicted));
+      }
+    }
+  }
+  if (bl.ptr != nullptr) {
     // We will do a piecewise copy.
     WritableSlice dest(bl.ptr, bl.sz);
     size_t pos = 0;
-    for (auto &v : buf) {
+    for (auto &v : data) {
       WritableSlice out(dest, pos);
       rc = WritableSlice::Copy(&out, v);
       if (rc.IsError()) {
@@ -95,16 +147,24 @@ Status CachePool::Insert(const std::vector<ReadableSlice> &buf, CachePool::key_t
       bl.ptr = nullptr;
       return rc;
     }
-  } catch (std::bad_alloc &e) {
-    if (sm_ != nullptr) {
-      RETURN_IF_NOT_OK(sm_->Write(&bl.storage_key, buf));
-    } else {
-      return Status(StatusCode::kOutOfMemory, __LINE__, __FILE__);
+  } else if (sm_ != nullptr) {
+    RETURN_IF_NOT_OK(sm_->Write(&bl.storage_key, data));
+  } else {
+    return Status(StatusCode::kOutOfMemory, __LINE__, __FILE__);
+  }
+  key_type k;
+  rc = tree_->insert(bl, &k);
+  if (rc.IsError()) {
+    if (bl.ptr != nullptr) {
+      alloc_.deallocate(bl.ptr, sz);
     }
+    return rc;
   }
-  rc = tree_->insert(bl, key);
-  if (rc.IsError() && bl.ptr != nullptr) {
-    alloc_.deallocate(bl.ptr, sz);
+  if (bl.ptr != nullptr) {
+    Track(k);
+  }
+  if (key != nullptr) {
+    *key = k;
   }
   return rc;
 }
@@ -113,20 +173,45 @@ Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *byt
   auto r = tree_->Search(key);
   if (r.second) {
     auto &it = r.first;
+    if (it->ptr == nullptr && it->raw_sz == 0) {
+      return Status(StatusCode::kFileNotExist, __LINE__, __FILE__, "Key has been evicted");
+    }
+    bool compressed = it->sz < it->raw_sz;
     if (it->ptr != nullptr) {
-      ReadableSlice src(it->ptr, it->sz);
-      RETURN_IF_NOT_OK(WritableSlice::Copy(dest, src));
+      if (compressed) {
+        RETURN_IF_NOT_OK(Decompress(it->ptr, it->sz, dest, it->raw_sz));
+      } else {
+        ReadableSlice src(it->ptr, it->sz);
+        RETURN_IF_NOT_OK(WritableSlice::Copy(dest, src));
+      }
+      ++num_mem_hit_;
+      Touch(key);
     } else if (sm_ != nullptr) {
       size_t expectedLength = 0;
-      RETURN_IF_NOT_OK(sm_->Read(it->storage_key, dest, &expectedLength));
+      if (compressed) {
+        std::string mem;
+        try {
+          mem.resize(it->sz);
+        } catch (const std::bad_alloc &e) {
+          return Status(StatusCode::kOutOfMemory, __LINE__, __FILE__);
+        }
+        WritableSlice src(&mem[0], mem.size());
+        RETURN_IF_NOT_OK(sm_->Read(it->storage_key, &src, &expectedLength));
+        if (expectedLength == it->sz) {
+          RETURN_IF_NOT_OK(Decompress(mem.data(), mem.size(), dest, it->raw_sz));
+        }
+      } else {
+        RETURN_IF_NOT_OK(sm_->Read(it->storage_key, dest, &expectedLength));
+      }
       if (expectedLength != it->sz) {
         MS_LOG(ERROR) << "Unexpected length. Read " << expectedLength << ". Expected " << it->sz << "."
                       << " Internal key: " << key << "\n";
         RETURN_STATUS_UNEXPECTED("Length mismatch. See log file for details.");
       }
+      ++num_disk_hit_;
     }
     if (bytesRead != nullptr) {
-      *bytesRead = it->sz;
+      *bytesRead = it->raw_sz;
     }
   } else {
     RETURN_STATUS_UNEXPECTED("Key not found");
@@ -142,13 +227,23 @@ CachePool::CacheStat CachePool::GetStat() const {
   CacheStat cs{0};
   int64_t total_sz = 0;
   for (auto &it : *tree_) {
-    total_sz += it.sz;
+    if (it.ptr == nullptr && it.raw_sz == 0) {
+      // Dropped by eviction
+      continue;
+    }
+    total_sz += it.raw_sz;
+    if (it.sz < it.raw_sz) {
+      ++cs.num_compressed;
+    }
     if (it.ptr != nullptr) {
       ++cs.num_mem_cached;
     } else {
       ++cs.num_disk_cached;
     }
   }
+  cs.num_evicted = num_evicted_;
+  cs.num_mem_hit = num_mem_hit_;
+  cs.num_disk_hit = num_disk_hit_;
   if (total_sz > 0) {
     // integer arithmetic. NO need to cast to float or double.
     cs.average_cache_sz = total_sz / (cs.num_disk_cached + cs.num_mem_cached);
@@ -197,10 +292,133 @@ size_t CachePool::GetSize(CachePool::key_type key) const {
   auto r = tree_->Search(key);
   if (r.second) {
     auto &it = r.first;
-    return it->sz;
+    return it->raw_sz;
   } else {
     return 0;
   }
 }
+void CachePool::Track(CachePool::key_type key) {
+  if (policy_ == EvictPolicy::kNone) {
+    return;
+  }
+  std::unique_lock<std::mutex> lck(evict_mux_);
+  priority_type p(0, ++clock_);
+  priority_[key] = p;
+  (void)victims_.emplace(p, key);
+}
+void CachePool::Touch(CachePool::key_type key) const {
+  if (policy_ == EvictPolicy::kNone) {
+    return;
+  }
+  std::unique_lock<std::mutex> lck(evict_mux_);
+  auto it = priority_.find(key);
+  if (it == priority_.end()) {
+    // It is being evicted
+    return;
+  }
+  auto &p = it->second;
+  (void)victims_.erase(std::make_pair(p, key));
+  // LRU only looks at the last access. LFU looks at the access count first, the last access breaks the tie.
+  if (policy_ == EvictPolicy::kLfu) {
+    ++p.first;
+  }
+  p.second = ++clock_;
+  (void)victims_.emplace(p, key);
+}
+Status CachePool::EvictOne(bool *evicted) {
+  RETURN_UNEXPECTED_IF_NULL(evicted);
+  *evicted = false;
+  key_type key;
+  {
+    std::unique_lock<std::mutex> lck(evict_mux_);
+    if (victims_.empty()) {
+      return Status::OK();
+    }
+    auto it = victims_.begin();
+    key = it->second;
+    (void)priority_.erase(key);
+    (void)victims_.erase(it);
+  }
+  DataLocator bl;
+  {
+    auto r = tree_->Search(key);
+    if (!r.second) {
+      RETURN_STATUS_UNEXPECTED("Key not found");
+    }
+    bl = *(r.first);
+  }
+  RETURN_UNEXPECTED_IF_NULL(bl.ptr);
+  auto new_bl = std::make_unique<DataLocator>(bl);
+  new_bl->ptr = nullptr;
+  if (sm_ != nullptr) {
+    ReadableSlice data(bl.ptr, bl.sz);
+    Status rc = sm_->Write(&new_bl->storage_key, {data});
+    if (rc.IsError()) {
+      Track(key);
+      return rc;
+    }
+  } else {
+    // Nowhere to spill. The buffer is dropped and any read of it later is a cache miss.
+    new_bl->sz = 0;
+    new_bl->raw_sz = 0;
+  }
+  // Readers hold a lock on the old locator. Once it is swapped out, no one can see the memory any more.
+  (void)tree_->DoUpdate(key, std::move(new_bl));
+  alloc_.deallocate(bl.ptr, bl.sz);
+  ++num_evicted_;
+  *evicted = true;
+  return Status::OK();
+}
+Status CachePool::Compress(const std::vector<ReadableSlice> &buf, size_t sz, std::string *out) const {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  out->clear();
+#ifdef ENABLE_CACHE
+  // zlib works on 32 bit lengths. Too small or too big buffers are left uncompressed.
+  if (buf.empty() || sz == 0 || sz > std::numeric_limits<uInt>::max()) {
+    return Status::OK();
+  }
+  z_stream strm{};
+  if (deflateInit(&strm, Z_BEST_SPEED) != Z_OK) {
+    RETURN_STATUS_UNEXPECTED("Failed to initialize compression");
+  }
+  try {
+    out->resize(deflateBound(&strm, sz));
+  } catch (const std::bad_alloc &e) {
+    (void)deflateEnd(&strm);
+    return Status(StatusCode::kOutOfMemory, __LINE__, __FILE__);
+  }
+  strm.next_out = reinterpret_cast<Bytef *>(&(*out)[0]);
+  strm.avail_out = static_cast<uInt>(out->size());
+  int rc = Z_OK;
+  for (size_t i = 0; i < buf.size() && rc == Z_OK; ++i) {
+    strm.next_in = reinterpret_cast<Bytef *>(const_cast<void *>(buf[i].GetPointer()));
+    strm.avail_in = static_cast<uInt>(buf[i].GetSize());
+    rc = deflate(&strm, (i + 1 == buf.size()) ? Z_FINISH : Z_NO_FLUSH);
+  }
+  if (rc == Z_STREAM_END) {
+    out->resize(strm.total_out);
+  } else {
+    // Not compressible within the bound. Keep it as it is.
+    out->clear();
+  }
+  (void)deflateEnd(&strm);
+#endif
+  return Status::OK();
+}
+Status CachePool::Decompress(const void *src, size_t sz, WritableSlice *dest, size_t raw_sz) const {
+  RETURN_UNEXPECTED_IF_NULL(dest);
+  CHECK_FAIL_RETURN_UNEXPECTED(dest->GetSize() >= raw_sz, "Destination is too small");
+#ifdef ENABLE_CACHE
+  uLongf len = raw_sz;
+  int rc = uncompress(reinterpret_cast<Bytef *>(dest->GetMutablePointer()), &len,
+                      reinterpret_cast<const Bytef *>(src), sz);
+  if (rc != Z_OK || len != raw_sz) {
+    RETURN_STATUS_UNEXPECTED("Failed to decompress. zlib error " + std::to_string(rc));
+  }
+  return Status::OK();
+#else
+  RETURN_STATUS_UNEXPECTED("Compression is not supported on this platform");
+#endif
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -16,9 +16,13 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_CACHE_POOL_H_
 
+#include <atomic>
 #include <memory>
 #include <mutex>
+#include <set>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 #include "minddata/dataset/util/allocator.h"
 #include "minddata/dataset/util/service.h"
@@ -32,6 +36,9 @@ namespace dataset {
 /// ReadableSlice where all memory blocks will be copied to one contiguous block which can be in memory or spilled to
 /// disk (if a disk directory is provided). Every buffer insert will return a generated key which can be used to
 /// restore the buffer.
+/// When the memory is full, an eviction policy can be given to move the least recently (or least frequently) used
+/// buffers out of memory, either to disk or, if no disk directory is provided, dropped from the pool. Buffers can
+/// also be compressed to cache more of them in the same amount of memory.
 /// \see ReadableSlice
 class CachePool : public Service {
  public:
@@ -42,34 +49,42 @@ class CachePool : public Service {
   using const_reference = const base_type &;
   using value_allocator = Allocator<base_type>;
 
+  /// \brief Policy to choose the buffers to move out of memory when the memory is full
+  enum class EvictPolicy : uint8_t { kNone = 0, kLru = 1, kLfu = 2 };
+
   // An internal class to locate the whereabouts of a backed up buffer which can be either in
   class DataLocator {
    public:
-    DataLocator() : ptr(nullptr), sz(0), storage_key(0) {}
+    DataLocator() : ptr(nullptr), sz(0), raw_sz(0), storage_key(0) {}
     ~DataLocator() = default;
     DataLocator(const DataLocator &other) = default;
     DataLocator &operator=(const DataLocator &other) = default;
     DataLocator(DataLocator &&other) noexcept {
       ptr = other.ptr;
       sz = other.sz;
+      raw_sz = other.raw_sz;
       storage_key = other.storage_key;
       other.ptr = nullptr;
       other.sz = 0;
+      other.raw_sz = 0;
       other.storage_key = 0;
     }
     DataLocator &operator=(DataLocator &&other) noexcept {
       if (&other != this) {
         ptr = other.ptr;
         sz = other.sz;
+        raw_sz = other.raw_sz;
         storage_key = other.storage_key;
         other.ptr = nullptr;
         other.sz = 0;
+        other.raw_sz = 0;
         other.storage_key = 0;
       }
       return *this;
     }
     pointer ptr;
-    size_t sz;
+    size_t sz;      // Number of bytes stored, less than raw_sz if the buffer is compressed
+    size_t raw_sz;  // Number of bytes of the buffer. 0 if the buffer is dropped by eviction
     StorageManager::key_type storage_key;
   };
 
@@ -83,12 +98,19 @@ class CachePool : public Service {
     int64_t num_mem_cached;
     int64_t num_disk_cached;
     int64_t average_cache_sz;
+    int64_t num_compressed;
+    int64_t num_evicted;
+    int64_t num_mem_hit;
+    int64_t num_disk_hit;
   };
 
   /// \brief Constructor
   /// \param alloc Allocator to allocate memory from
   /// \param root Optional disk folder to spill
-  explicit CachePool(const value_allocator &alloc, const std::string &root = "");
+  /// \param policy Optional eviction policy when the allocator runs out of memory
+  /// \param compress Optional. Compress the buffers
+  explicit CachePool(const value_allocator &alloc, const std::string &root = "",
+                     EvictPolicy policy = EvictPolicy::kNone, bool compress = false);
 
   CachePool(const CachePool &) = delete;
   CachePool(CachePool &&) = delete;
@@ -118,6 +140,9 @@ class CachePool : public Service {
 
   Status Locate(DataLocator *dl);
 
+  /// \brief Get the size of a cached buffer
+  /// \param key A previous key returned from Insert
+  /// \return Size of the buffer before compression. 0 if not found or dropped by eviction.
   size_t GetSize(key_type key) const;
 
   /// \brief Get statistics.
@@ -128,12 +153,45 @@ class CachePool : public Service {
 
   std::string MyName() const { return subfolder_; }
 
+  EvictPolicy GetEvictPolicy() const { return policy_; }
+
+  bool IsCompressed() const { return compress_; }
+
  private:
+  // (access count, last access) of a buffer in memory. The buffer with the smallest priority is evicted first.
+  using priority_type = std::pair<uint64_t, uint64_t>;
+
   value_allocator alloc_;
   Path root_;
   const std::string subfolder_;
   std::shared_ptr<StorageManager> sm_;
   std::shared_ptr<data_index> tree_;
+  EvictPolicy policy_;
+  bool compress_;
+  mutable std::mutex evict_mux_;
+  mutable uint64_t clock_;
+  mutable std::unordered_map<key_type, priority_type> priority_;
+  mutable std::set<std::pair<priority_type, key_type>> victims_;
+  std::atomic<int64_t> num_evicted_;
+  mutable std::atomic<int64_t> num_mem_hit_;
+  mutable std::atomic<int64_t> num_disk_hit_;
+
+  /// \brief Start tracking a buffer in memory for eviction
+  void Track(key_type key);
+
+  /// \brief Record an access to a buffer in memory
+  void Touch(key_type key) const;
+
+  /// \brief Move the buffer with the smallest priority out of memory
+  /// \param[out] evicted False if there is nothing to evict
+  /// \return Error code
+  Status EvictOne(bool *evicted);
+
+  /// \brief Compress a sequence of ReadableSlice objects into one piece
+  Status Compress(const std::vector<ReadableSlice> &buf, size_t sz, std::string *out) const;
+
+  /// \brief Decompress a buffer into dest
+  Status Decompress(const void *src, size_t sz, WritableSlice *dest, size_t raw_sz) const;
 };
 }  // namespace dataset
 }  // namespace mindspore
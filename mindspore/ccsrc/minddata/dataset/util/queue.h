@@ -173,6 +173,42 @@ class Queue {
     return rc;
   }
 
+  // Change the capacity of the queue while producers and consumers are running. The queued elements keep their
+  // order, and blocked producers are woken up if the queue grows.
+  // @param sz - The new capacity, which can not be less than the number of queued elements
+  Status Resize(int sz) {
+    std::unique_lock<std::mutex> _lock(mux_);
+    if (sz <= 0 || sz < size()) {
+      std::string err_msg = "Can not resize a queue holding " + std::to_string(size()) + " elements to size " +
+                            std::to_string(sz) + ".";
+      RETURN_STATUS_UNEXPECTED(err_msg);
+    }
+    if (static_cast<uint64_t>(sz) == sz_) {
+      return Status::OK();
+    }
+    pointer new_arr = alloc_.allocate(sz);
+    for (int i = 0; i < sz; i++) {
+      std::allocator_traits<Allocator<T>>::construct(alloc_, &(new_arr[i]));
+    }
+    uint64_t n = tail_ - head_;
+    for (uint64_t i = 0; i < n; i++) {
+      uint32_t k = (head_ + i) % sz_;
+      new_arr[i] = std::move(arr_[k]);
+    }
+    if (arr_ != nullptr) {
+      for (uint64_t i = 0; i < sz_; i++) {
+        arr_[i].~T();
+      }
+      alloc_.deallocate(arr_);
+    }
+    arr_ = new_arr;
+    sz_ = sz;
+    head_ = 0;
+    tail_ = n;
+    full_cv_.NotifyAll();
+    return Status::OK();
+  }
+
   void ResetQue() noexcept {
     std::unique_lock<std::mutex> _lock(mux_);
     // If there are elements in the queue, invoke its destructor one by one.
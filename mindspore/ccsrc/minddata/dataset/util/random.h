@@ -25,6 +25,7 @@
 #include <random>
 #include <string>
 #include <thread>
+#include <unordered_map>
 
 #include "minddata/dataset/core/config_manager.h"
 #include "minddata/dataset/core/global_context.h"
@@ -68,6 +69,64 @@ inline uint32_t GetSeed() {
   return seed;
 }
 
+// Counter based random generator. The n-th number of the stream (seed, stream) is a hash of the seed, the stream and
+// n, so independent streams cost nothing to create, e.g. one per sampled item, and the numbers drawn for an item do
+// not depend on the thread which draws them.
+class CounterRng {
+ public:
+  using result_type = uint64_t;
+
+  CounterRng(uint64_t seed, uint64_t stream) : key_(Mix(seed + Mix(stream * kIncrement))), counter_(0) {}
+
+  static constexpr result_type min() { return 0; }
+
+  static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+  result_type operator()() { return Mix(key_ + kIncrement * ++counter_); }
+
+ private:
+  static constexpr uint64_t kIncrement = 0x9E3779B97F4A7C15ULL;
+
+  // Output function of SplitMix64
+  static uint64_t Mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+
+  uint64_t key_;
+  uint64_t counter_;
+};
+
+// Random permutation of [0, size) drawn one index at a time. The Fisher-Yates shuffle only records the positions it
+// moved, so drawing k indices costs O(k) whatever the size.
+class LazyShuffle {
+ public:
+  explicit LazyShuffle(int64_t size) : size_(size), drawn_(0) {}
+
+  bool Done() const { return drawn_ >= size_; }
+
+  template <typename Rng>
+  int64_t Next(Rng *rnd) {
+    std::uniform_int_distribution<int64_t> distribution(drawn_, size_ - 1);
+    int64_t j = distribution(*rnd);
+    int64_t at_j = At(j);
+    moved_[j] = At(drawn_);
+    drawn_++;
+    return at_j;
+  }
+
+ private:
+  int64_t At(int64_t i) const {
+    auto itr = moved_.find(i);
+    return itr == moved_.end() ? i : itr->second;
+  }
+
+  int64_t size_;
+  int64_t drawn_;
+  std::unordered_map<int64_t, int64_t> moved_;
+};
+
 }  // namespace dataset
 }  // namespace mindspore
 
@@ -86,6 +86,7 @@ class ReadableSlice {
 class WritableSlice : public ReadableSlice {
  public:
   friend class StorageContainer;
+  friend class CachePool;
   friend class CacheService;
   /// \brief Default constructor
   WritableSlice() : ReadableSlice(), mutable_data_(nullptr) {}
@@ -26,6 +26,7 @@
 #include <sys/wait.h>
 #endif
 #include <unistd.h>
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <cstdio>
@@ -33,6 +34,7 @@
 #include <future>
 #include <iostream>
 #include <map>
+#include <numeric>
 #include <random>
 #include <set>
 #include <sstream>
@@ -79,12 +81,21 @@ enum TaskType {
 };
 enum SamplerType { kCustomTopNSampler, kCustomTopPercentSampler, kSubsetRandomSampler, kPKSampler };
 
-enum ShuffleType { kShuffleCategory, kShuffleSample };
+enum ShuffleType { kShuffleCategory, kShuffleSample, kShuffleBlock };
 
 const double kEpsilon = 1e-7;
 
 const int kThreadNumber = 14;
 
+// Number of coalesced blob reads the reader prefetches ahead of its consumers
+const int kPrefetchDepth = 32;
+
+// Adjacent blobs of the rows a consumer reads in a row are merged into reads of at most this size
+const uint64_t kMaxReadRunBytes = 1 << 22;  // 4MB
+
+// Blobs count as adjacent if at most this many bytes lie between them, such as the size field in front of each blob
+const uint64_t kMaxReadRunGap = 4096;
+
 // Shard default parameters
 const uint64_t kDefaultHeaderSize = 1 << 24;  // 16MB
 const uint64_t kDefaultPageSize = 1 << 25;    // 32MB
@@ -181,6 +192,35 @@ std::pair<MSRStatus, uint64_t> GetDiskSize(const std::string &str_dir, const Dis
 /// \brief get the max hardware concurrency
 /// \return max concurrency
 uint32_t GetMaxThreadNum();
+
+/// \brief number of blocks whose ids are shuffled together by BlockShuffle
+const int64_t kShuffleWindowBlocks = 16;
+
+/// \brief two level shuffle of the ids [0, ids->size()): blocks of block_size consecutive ids are shuffled, then the
+///        ids within each window of kShuffleWindowBlocks blocks. The order is rebuilt from the identity, so it only
+///        depends on the state of rnd.
+/// \param block_size positive number of ids per block
+/// \param rnd random engine
+/// \param ids ids to fill in the shuffled order
+template <typename T, typename Engine>
+void BlockShuffle(int64_t block_size, Engine *rnd, std::vector<T> *ids) {
+  int64_t num_ids = static_cast<int64_t>(ids->size());
+  int64_t num_blocks = (num_ids + block_size - 1) / block_size;
+  std::vector<int64_t> blocks(num_blocks);
+  std::iota(blocks.begin(), blocks.end(), 0);
+  std::shuffle(blocks.begin(), blocks.end(), *rnd);
+  auto pos = ids->begin();
+  for (int64_t window = 0; window < num_blocks; window += kShuffleWindowBlocks) {
+    auto window_begin = pos;
+    for (int64_t i = window; i < std::min(window + kShuffleWindowBlocks, num_blocks); i++) {
+      int64_t end = std::min((blocks[i] + 1) * block_size, num_ids);
+      for (int64_t id = blocks[i] * block_size; id < end; id++) {
+        *pos++ = static_cast<T>(id);
+      }
+    }
+    std::shuffle(window_begin, pos, *rnd);
+  }
+}
 }  // namespace mindrecord
 }  // namespace mindspore
 
@@ -0,0 +1,153 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_BINARY_INDEX_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_BINARY_INDEX_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+const char kBinaryIndexMagic[] = "MSRINDEX";
+const uint64_t kBinaryIndexVersion = 2;
+const char kBinaryIndexSuffix[] = ".idx";
+
+/// \brief storage class of an index value as sqlite keeps it, in the order sqlite sorts them
+enum class IndexValueType : uint64_t { kNull = 0, kInteger = 1, kReal = 2, kText = 3 };
+
+/// \brief value of an index field in one row
+struct IndexValue {
+  IndexValueType type = IndexValueType::kNull;
+  int64_t integer = 0;
+  double real = 0;
+  std::string text;  // text sqlite returns for the value, empty for null
+};
+
+/// \brief location of one row in the shard file, the same columns as the INDEXES table of the sqlite index
+struct IndexRow {
+  uint64_t row_id;
+  uint64_t row_group_id;
+  uint64_t page_id_raw;
+  uint64_t page_offset_raw;
+  uint64_t page_offset_raw_end;
+  uint64_t page_id_blob;
+  uint64_t page_offset_blob;
+  uint64_t page_offset_blob_end;
+};
+
+/// \brief Read-only binary index of one shard, mapped into memory.
+///
+/// Layout, every item is a little-endian uint64 and strings are padded to 8 bytes:
+///   magic, version, shard file size, number of rows, number of fields, shard name
+///   rows sorted by row id
+///   for each index field: name, whether the column has numeric affinity,
+///   (type, integer or double bits, text offset, text length) of the value of every row,
+///   row positions sorted by (value, position), size of the text pool, text pool
+///
+/// Values are ordered and compared like sqlite does: null first, then numbers by value, then text bytewise.
+class ShardBinaryIndex {
+ public:
+  ShardBinaryIndex() = default;
+
+  ~ShardBinaryIndex();
+
+  ShardBinaryIndex(const ShardBinaryIndex &) = delete;
+
+  ShardBinaryIndex &operator=(const ShardBinaryIndex &) = delete;
+
+  /// \brief write the index of a shard
+  /// \param[in] index_path path of the index file
+  /// \param[in] shard_name file name of the shard
+  /// \param[in] file_size size of the shard file
+  /// \param[in] field_names index field names, as generated by ShardIndexGenerator::GenerateFieldName
+  /// \param[in] number_fields whether each index field is a number column, its values then match numerically
+  /// \param[in] rows location of the rows, in any order
+  /// \param[in] values field values of the rows, in the same order as rows
+  /// \return MSRStatus the status of MSRStatus
+  static MSRStatus Write(const std::string &index_path, const std::string &shard_name, uint64_t file_size,
+                         const std::vector<std::string> &field_names, const std::vector<bool> &number_fields,
+                         std::vector<IndexRow> rows, std::vector<std::vector<IndexValue>> values);
+
+  /// \brief map an index file and check its layout
+  /// \param[in] index_path path of the index file
+  /// \return MSRStatus the status of MSRStatus
+  MSRStatus Load(const std::string &index_path);
+
+  const std::string &GetShardName() const { return shard_name_; }
+
+  uint64_t GetFileSize() const { return file_size_; }
+
+  uint64_t GetNumRows() const { return num_rows_; }
+
+  /// \brief get the row at a position, rows are sorted by row id
+  const IndexRow &GetRow(uint64_t pos) const { return rows_[pos]; }
+
+  /// \brief get the position of an index field, -1 if it is not indexed
+  int GetFieldId(const std::string &field_name) const;
+
+  /// \brief get the value of an index field in the row at a position, as the text sqlite returns, empty for null
+  std::string_view GetValue(int field_id, uint64_t pos) const;
+
+  /// \brief get the distinct values of an index field, as the text sqlite returns, empty for null
+  std::vector<std::string> GetDistinctValues(int field_id) const;
+
+  /// \brief get the positions of the rows whose field equals value and row id is in [start_row_id, end_row_id).
+  ///        The value is parsed as a number for number fields, null matches nothing.
+  /// \return positions in ascending order
+  std::vector<uint64_t> GetRowsByValue(int field_id, const std::string &value, uint64_t start_row_id,
+                                       uint64_t end_row_id) const;
+
+ private:
+  struct Field {
+    std::string name;
+    bool is_number;
+    const uint64_t *values;  // (type, integer or double bits, offset, length) in pool per row
+    const uint64_t *sorted;  // row positions sorted by value
+    const char *pool;
+  };
+
+  // value of a row as stored in the index file
+  struct ValueRef {
+    IndexValueType type;
+    int64_t integer;
+    double real;
+    std::string_view text;
+  };
+
+  ValueRef GetValueRef(int field_id, uint64_t pos) const;
+
+  /// \brief compare two values the way sqlite orders them, negative, zero or positive
+  static int CompareValues(const ValueRef &a, const ValueRef &b);
+
+  uint8_t *addr_ = nullptr;         // mapped index file
+  uint64_t size_ = 0;               // size of the index file
+  std::vector<uint8_t> buffer_;     // index file content where it can not be mapped
+  std::string shard_name_;          // file name of the shard
+  uint64_t file_size_ = 0;          // size of the shard file
+  uint64_t num_rows_ = 0;           // number of rows
+  const IndexRow *rows_ = nullptr;  // rows sorted by row id
+  std::vector<Field> fields_;       // index fields
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_BINARY_INDEX_H_
@@ -29,11 +29,13 @@ namespace mindspore {
 namespace mindrecord {
 class ShardDistributedSample : public ShardSample {
  public:
+  /// \param shuffle_block_size: when positive, shuffle blocks of this many consecutive rows and then the rows within
+  ///     a few blocks, instead of all rows. Each shard reads a contiguous slice of the order, so its own blocks only.
   ShardDistributedSample(int num_shards, int shard_id, int no_of_padded_samples, bool shuffle, uint32_t seed,
-                         int no_of_samples = 0, int offset = -1);
+                         int no_of_samples = 0, int offset = -1, int64_t shuffle_block_size = 0);
 
   ShardDistributedSample(int num_shards, int shard_id, bool shuffle, uint32_t seed, int no_of_samples = 0,
-                         int offset = -1);
+                         int offset = -1, int64_t shuffle_block_size = 0);
 
   void SetNumPaddedSamples(int no_of_padded_samples) { no_of_padded_samples_ = no_of_padded_samples; }
 
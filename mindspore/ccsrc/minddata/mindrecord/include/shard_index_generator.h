@@ -25,6 +25,7 @@
 #include <tuple>
 #include <utility>
 #include <vector>
+#include "minddata/mindrecord/include/shard_binary_index.h"
 #include "minddata/mindrecord/include/shard_header.h"
 #include "./sqlite3.h"
 
@@ -105,6 +106,12 @@ class ShardIndexGenerator {
   void AddIndexFieldByRawData(const std::vector<json> &schema_detail,
                               std::vector<std::tuple<std::string, std::string, std::string>> &row_data);
 
+  /// \brief read the rows of the database back for the binary index, ordered by row id
+  MSRStatus ReadBinaryIndexRows(sqlite3 *db, std::vector<IndexRow> *rows, std::vector<std::vector<IndexValue>> *values);
+
+  /// \brief write the binary index next to the shard, the reader falls back to the database without it
+  void WriteBinaryIndex(sqlite3 *db, const std::string &shard_address, uint64_t file_size);
+
   void DatabaseWriter();  // worker thread
 
   std::string file_path_;
@@ -20,16 +20,22 @@
 #include <dirent.h>
 #include <signal.h>
 #if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/prctl.h>
 #endif
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 #include <algorithm>
+#include <cerrno>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -43,6 +49,7 @@
 #include <utility>
 #include <vector>
 #include "minddata/mindrecord/include/common/shard_utils.h"
+#include "minddata/mindrecord/include/shard_binary_index.h"
 #include "minddata/mindrecord/include/shard_category.h"
 #include "minddata/mindrecord/include/shard_column.h"
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
@@ -183,9 +190,14 @@ class ShardReader {
   std::vector<std::tuple<std::vector<uint8_t>, json>> GetNext();
 
   /// \brief return a row by id
+  /// \param[in] task_id id of the row
+  /// \param[in] consumer_id id of the consumer thread
+  /// \param[in] end_task_id the consumer goes on with the rows up to end_task_id, so the blobs of these rows which
+  ///            follow each other in the file are read at once; -1 reads only this row
   /// \return a batch of images and image data
   std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>> GetNextById(const int64_t &task_id,
-                                                                                       const int32_t &consumer_id);
+                                                                                       const int32_t &consumer_id,
+                                                                                       const int64_t &end_task_id = -1);
 
   /// \brief return a batch, given that one is ready, python API
   /// \return a batch of images and image data
@@ -212,6 +224,14 @@ class ShardReader {
   /// \brief get the size of blob data
   MSRStatus GetTotalBlobSize(int64_t *total_blob_size);
 
+  /// \brief set how many coalesced blob reads are prefetched ahead of the consumers, 0 to disable prefetching.
+  ///        Must be called before Launch.
+  void SetPrefetchDepth(int prefetch_depth) { prefetch_depth_ = prefetch_depth; }
+
+  /// \brief read the blobs with the file streams of the consumers instead of pread and the prefetcher.
+  ///        Must be called before Open.
+  void SetMapFiles(bool map_files) { map_files_ = map_files; }
+
  protected:
   /// \brief sqlite call back function
   static int SelectCallback(void *p_data, int num_fields, char **p_fields, char **p_col_names);
@@ -230,6 +250,16 @@ class ShardReader {
                                std::vector<std::vector<std::vector<uint64_t>>> &offsets,
                                std::vector<std::vector<json>> &column_values);
 
+  /// \brief read all rows in one shard from its binary index, in the same format as the index db
+  MSRStatus ReadAllRowsInBinaryIndex(int shard_id, const std::vector<std::string> &columns,
+                                     std::vector<std::vector<std::string>> *labels);
+
+  /// \brief get the positions of index columns in the binary index of a shard
+  MSRStatus GetBinaryIndexFieldIds(int shard_id, const std::vector<std::string> &columns, std::vector<int> *field_ids);
+
+  /// \brief load the binary index of a shard, nullptr if it is missing or does not match the shard
+  std::shared_ptr<ShardBinaryIndex> LoadBinaryIndex(const std::string &file);
+
   /// \brief initialize reader
   MSRStatus Init(const std::vector<std::string> &file_paths, bool load_dataset);
 
@@ -250,6 +280,14 @@ class ShardReader {
   std::pair<MSRStatus, std::vector<json>> GetLabels(int group_id, int shard_id, const std::vector<std::string> &columns,
                                                     const std::pair<std::string, std::string> &criteria = {"", ""});
 
+  /// \brief convert column values of the index to json by schema
+  std::vector<json> ConstructLabelJson(const std::vector<std::vector<std::string>> &labels,
+                                       const std::vector<std::string> &columns);
+
+  /// \brief get column values of rows in the binary index
+  std::pair<MSRStatus, std::vector<json>> GetLabelsFromBinaryIndex(int shard_id, const std::vector<uint64_t> &rows,
+                                                                   const std::vector<std::string> &columns);
+
   /// \brief get column values from raw data page
   std::pair<MSRStatus, std::vector<json>> GetLabelsFromPage(int group_id, int shard_id,
                                                             const std::vector<std::string> &columns,
@@ -277,8 +315,8 @@ class ShardReader {
   /// \brief open multiple file handle
   void FileStreamsOperator();
 
-  /// \brief read one row by one task
-  TASK_RETURN_CONTENT ConsumerOneTask(int task_id, uint32_t consumer_id);
+  /// \brief read one row by one task, reading ahead the adjacent blobs of the tasks before end_task_id
+  TASK_RETURN_CONTENT ConsumerOneTask(int task_id, uint32_t consumer_id, int end_task_id = -1);
 
   /// \brief get labels from binary file
   std::pair<MSRStatus, std::vector<json>> GetLabelsFromBinaryFile(
@@ -287,12 +325,45 @@ class ShardReader {
   /// \brief get classes in one shard
   void GetClassesInShard(sqlite3 *db, int shard_id, const std::string sql, std::set<std::string> &categories);
 
+  /// \brief get classes in one shard from its binary index
+  void GetClassesInBinaryIndex(int shard_id, const std::string &field_name, std::set<std::string> &categories);
+
   /// \brief get number of classes
   int64_t GetNumClasses(const std::string &category_field);
 
   /// \brief get meta of header
   std::pair<MSRStatus, std::vector<std::string>> GetMeta(const std::string &file_path, json &meta_data);
 
+  /// \brief open the shard files for pread and map them for the prefetcher, the shards which can not be opened are
+  ///        read with file streams
+  void MapFiles();
+
+  /// \brief unmap and close the shard files
+  void UnmapFiles();
+
+  /// \brief read a blob with pread, or with the file stream of the consumer
+  MSRStatus ReadBlob(int shard_id, uint32_t consumer_id, uint64_t file_offset, uint64_t length,
+                     std::vector<uint8_t> *blob);
+
+  /// \brief read the blob of a task out of the last read run of the consumer, or read a new run starting with it
+  MSRStatus ReadTaskBlob(int task_id, int end_task_id, int shard_id, uint32_t consumer_id, uint64_t file_offset,
+                         uint64_t length, std::vector<uint8_t> *blob);
+
+  /// \brief get the shard, page and file range of the blob of a task, false if it has no blob
+  bool GetBlobRange(int task_id, int *shard_id, uint64_t *page_id, uint64_t *file_offset, uint64_t *length);
+
+  /// \brief advise the kernel to read ahead the blobs of the rows following the consumers, in a background thread
+  void PrefetchBlobs();
+
+  /// \brief record the task read by a consumer, and wake up the prefetch thread if the read moves its window
+  void UpdateReadCursor(int task_id);
+
+  /// \brief restart prefetching from the first task
+  void ResetPrefetch();
+
+  /// \brief stop the prefetch thread
+  void StopPrefetch();
+
   /// \brief extract uncompressed data based on column list
   std::pair<MSRStatus, std::vector<std::vector<uint8_t>>> UnCompressBlob(const std::vector<uint8_t> &raw_blob_data);
 
@@ -304,9 +375,19 @@ class ShardReader {
   std::shared_ptr<ShardColumn> shard_column_;  // shard column
 
   std::vector<sqlite3 *> database_paths_;                                        // sqlite handle list
+  std::vector<std::shared_ptr<ShardBinaryIndex>> binary_indexes_;                // binary index list, may be nullptr
   std::vector<string> file_paths_;                                               // file paths
   std::vector<std::shared_ptr<std::fstream>> file_streams_;                      // single-file handle list
   std::vector<std::vector<std::shared_ptr<std::fstream>>> file_streams_random_;  // multiple-file handle list
+  std::vector<std::pair<uint8_t *, uint64_t>> file_maps_;  // address and size of mapped files, nullptr if not mapped
+  std::vector<int> file_descriptors_;                      // descriptors for pread, -1 if not opened
+  // adjacent blobs read at once by a consumer
+  struct ReadRun {
+    int shard_id = -1;
+    uint64_t file_offset = 0;
+    std::vector<uint8_t> data;
+  };
+  std::vector<ReadRun> read_runs_;  // last read run of each consumer
 
  private:
   int n_consumer_;                                         // number of workers (threads)
@@ -335,6 +416,19 @@ class ShardReader {
   // map of delivery
   std::unordered_map<int, std::shared_ptr<std::vector<std::tuple<std::vector<uint8_t>, json>>>> delivery_map_;
   // Delivery/Iterator mode end
+
+  // Prefetch begin
+  bool map_files_ = true;                // read blobs with pread and prefetch them through a mapping
+  int prefetch_depth_ = kPrefetchDepth;  // number of coalesced blob reads prefetched ahead of the consumers
+  std::thread prefetch_thread_;          // prefetch thread
+  std::mutex mtx_prefetch_;              // locker for prefetch, guards the task list against ShuffleTask
+  std::condition_variable cv_prefetch_;  // conditional variable for prefetch
+  std::atomic<int> read_cursor_;         // highest task ID read by the consumers
+  std::atomic<int> prefetch_wakeup_;     // read cursor at which the waiting prefetch thread has to be woken up
+  int prefetch_task_ = 0;                // next task ID to prefetch
+  std::deque<int> prefetch_runs_;        // last task ID of each prefetched read not consumed yet
+  bool stop_prefetch_ = false;           // prefetch thread stopped
+  // Prefetch end
 };
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -24,7 +24,9 @@ namespace mindspore {
 namespace mindrecord {
 class ShardShuffle : public ShardOperator {
  public:
-  explicit ShardShuffle(uint32_t seed = 0, ShuffleType shuffle_type = kShuffleCategory);
+  /// \param block_size: rows per block of kShuffleBlock, which shuffles the blocks of consecutive rows and then the
+  ///     rows within windows of kShuffleWindowBlocks blocks
+  explicit ShardShuffle(uint32_t seed = 0, ShuffleType shuffle_type = kShuffleCategory, int64_t block_size = 0);
 
   ShardShuffle(uint32_t seed, int64_t no_of_samples, bool replacement, bool reshuffle_each_epoch,
                ShuffleType shuffle_type = kShuffleSample);
@@ -36,11 +38,15 @@ class ShardShuffle : public ShardOperator {
   int64_t GetNumSamples(int64_t dataset_size, int64_t num_classes) override;
 
  private:
+  // Two level permutation of the tasks, rebuilt from the identity so it only depends on the seed
+  void ShuffleBlocks(ShardTask &tasks);
+
   uint32_t shuffle_seed_;
   int64_t no_of_samples_;
   bool replacement_;
   bool reshuffle_each_epoch_;
   ShuffleType shuffle_type_;
+  int64_t block_size_;
 };
 }  // namespace mindrecord
 }  // namespace mindspore
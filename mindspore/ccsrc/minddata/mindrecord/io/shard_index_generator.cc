@@ -549,7 +549,10 @@ MSRStatus ShardIndexGenerator::ExecuteTransaction(const int &shard_no, std::pair
     MS_LOG(INFO) << "Insert " << data.second.size() << " rows to index db.";
   }
   (void)sqlite3_exec(db.second, "END TRANSACTION;", nullptr, nullptr, nullptr);
+  (void)in.seekg(0, std::ios::end);
+  auto file_size = static_cast<uint64_t>(in.tellg());
   in.close();
+  WriteBinaryIndex(db.second, shard_address, file_size);
 
   // Close database
   if (sqlite3_close(db.second) != SQLITE_OK) {
@@ -560,6 +563,104 @@ MSRStatus ShardIndexGenerator::ExecuteTransaction(const int &shard_no, std::pair
   return SUCCESS;
 }
 
+MSRStatus ShardIndexGenerator::ReadBinaryIndexRows(sqlite3 *db, std::vector<IndexRow> *rows,
+                                                   std::vector<std::vector<IndexValue>> *values) {
+  // read the rows back so that the binary index keeps the values exactly as the database stores them
+  std::string sql =
+    "SELECT ROW_ID, ROW_GROUP_ID, PAGE_ID_RAW, PAGE_OFFSET_RAW, PAGE_OFFSET_RAW_END, PAGE_ID_BLOB, PAGE_OFFSET_BLOB, "
+    "PAGE_OFFSET_BLOB_END";
+  for (const auto &field : fields_) {
+    auto ret = GenerateFieldName(field);
+    if (ret.first != SUCCESS) {
+      return FAILED;
+    }
+    sql += ", " + ret.second;
+  }
+  sql += " FROM INDEXES ORDER BY ROW_ID;";
+
+  sqlite3_stmt *stmt = nullptr;
+  if (sqlite3_prepare_v2(db, common::SafeCStr(sql), -1, &stmt, 0) != SQLITE_OK) {
+    MS_LOG(ERROR) << "SQL error: could not prepare statement, sql: " << sql;
+    return FAILED;
+  }
+  const std::vector<uint64_t IndexRow::*> row_columns = {&IndexRow::row_id,
+                                                          &IndexRow::row_group_id,
+                                                          &IndexRow::page_id_raw,
+                                                          &IndexRow::page_offset_raw,
+                                                          &IndexRow::page_offset_raw_end,
+                                                          &IndexRow::page_id_blob,
+                                                          &IndexRow::page_offset_blob,
+                                                          &IndexRow::page_offset_blob_end};
+  int rc = sqlite3_step(stmt);
+  while (rc == SQLITE_ROW) {
+    IndexRow row{};
+    for (size_t i = 0; i < row_columns.size(); ++i) {
+      row.*(row_columns[i]) = static_cast<uint64_t>(sqlite3_column_int64(stmt, static_cast<int>(i)));
+    }
+    std::vector<IndexValue> row_values(fields_.size());
+    for (size_t i = 0; i < fields_.size(); ++i) {
+      int column = static_cast<int>(row_columns.size() + i);
+      auto &value = row_values[i];
+      switch (sqlite3_column_type(stmt, column)) {
+        case SQLITE_NULL:
+          value.type = IndexValueType::kNull;
+          continue;
+        case SQLITE_INTEGER:
+          value.type = IndexValueType::kInteger;
+          value.integer = sqlite3_column_int64(stmt, column);
+          break;
+        case SQLITE_FLOAT:
+          value.type = IndexValueType::kReal;
+          value.real = sqlite3_column_double(stmt, column);
+          break;
+        default:
+          value.type = IndexValueType::kText;
+          break;
+      }
+      // the same text the reader gets from the database
+      auto text = reinterpret_cast<const char *>(sqlite3_column_text(stmt, column));
+      value.text = text == nullptr ? "" : text;
+    }
+    rows->push_back(row);
+    values->push_back(std::move(row_values));
+    rc = sqlite3_step(stmt);
+  }
+  (void)sqlite3_finalize(stmt);
+  if (rc != SQLITE_DONE) {
+    MS_LOG(ERROR) << "SQL error: could not read rows of index db, error code: " << rc;
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+void ShardIndexGenerator::WriteBinaryIndex(sqlite3 *db, const std::string &shard_address, uint64_t file_size) {
+  std::string index_path = shard_address + kBinaryIndexSuffix;
+  std::vector<std::string> field_names;
+  std::vector<bool> number_fields;
+  for (const auto &field : fields_) {
+    auto schema = shard_header_.GetSchemaByID(field.first);
+    if (schema.second != SUCCESS) {
+      (void)remove(common::SafeCStr(index_path));
+      return;
+    }
+    std::string type = ConvertJsonToSQL(TakeFieldType(field.second, schema.first->GetSchema()["schema"]));
+    field_names.push_back(GenerateFieldName(field).second);
+    // TEXT and BLOB columns compare values as they are, the others convert them to numbers
+    number_fields.push_back(type != "TEXT" && type != "BLOB");
+  }
+  std::vector<IndexRow> rows;
+  std::vector<std::vector<IndexValue>> values;
+  if (ReadBinaryIndexRows(db, &rows, &values) != SUCCESS ||
+      ShardBinaryIndex::Write(index_path, GetFileName(shard_address).second, file_size, field_names, number_fields,
+                              std::move(rows), std::move(values)) != SUCCESS) {
+    // do not leave an index of the previous content behind
+    (void)remove(common::SafeCStr(index_path));
+    MS_LOG(WARNING) << "Failed to write binary index: " << index_path << ", readers will use the index db.";
+    return;
+  }
+  MS_LOG(INFO) << "Write binary index: " << index_path << " successfully.";
+}
+
 MSRStatus ShardIndexGenerator::WriteToDatabase() {
   fields_ = shard_header_.GetFields();
   page_size_ = shard_header_.GetPageSize();
@@ -45,6 +45,8 @@ ShardReader::ShardReader() {
   num_rows_ = 0;
   total_blob_size_ = 0;
   num_padded_ = 0;
+  read_cursor_ = -1;
+  prefetch_wakeup_ = std::numeric_limits<int>::max();
 }
 
 std::pair<MSRStatus, std::vector<std::string>> ShardReader::GetMeta(const std::string &file_path, json &meta_data) {
@@ -128,7 +130,9 @@ MSRStatus ShardReader::Init(const std::vector<std::string> &file_paths, bool loa
         return FAILED;
       }
     }
+    auto binary_index = LoadBinaryIndex(file);
     database_paths_.push_back(db);
+    binary_indexes_.push_back(binary_index);
   }
   ShardHeader sh = ShardHeader();
   if (sh.BuildDataset(file_paths_, load_dataset) == FAILED) {
@@ -145,8 +149,18 @@ MSRStatus ShardReader::Init(const std::vector<std::string> &file_paths, bool loa
   }
   num_rows_ = 0;
   auto row_group_summary = ReadRowGroupSummary();
+  std::vector<uint64_t> shard_rows(binary_indexes_.size(), 0);
   for (const auto &rg : row_group_summary) {
     num_rows_ += std::get<3>(rg);
+    if (std::get<0>(rg) < static_cast<int>(shard_rows.size())) {
+      shard_rows[std::get<0>(rg)] += std::get<3>(rg);
+    }
+  }
+  for (size_t i = 0; i < binary_indexes_.size(); ++i) {
+    if (binary_indexes_[i] != nullptr && binary_indexes_[i]->GetNumRows() != shard_rows[i]) {
+      MS_LOG(WARNING) << "Binary index of " << file_paths_[i] << " does not match the shard, use the index db.";
+      binary_indexes_[i] = nullptr;
+    }
   }
   auto disk_size = page_size_ * row_group_summary.size();
   auto compression_size = shard_header_->GetCompressionSize();
@@ -159,6 +173,41 @@ MSRStatus ShardReader::Init(const std::vector<std::string> &file_paths, bool loa
   return SUCCESS;
 }
 
+MSRStatus ShardReader::GetBinaryIndexFieldIds(int shard_id, const std::vector<std::string> &columns,
+                                              std::vector<int> *field_ids) {
+  std::map<std::string, uint64_t> index_columns;
+  for (auto &field : shard_header_->GetFields()) {
+    index_columns[field.second] = field.first;
+  }
+  for (const auto &col : columns) {
+    if (index_columns.find(col) == index_columns.end()) {
+      return FAILED;
+    }
+    auto ret = ShardIndexGenerator::GenerateFieldName(std::make_pair(index_columns[col], col));
+    int field_id = ret.first == SUCCESS ? binary_indexes_[shard_id]->GetFieldId(ret.second) : -1;
+    if (field_id < 0) {
+      return FAILED;
+    }
+    field_ids->push_back(field_id);
+  }
+  return SUCCESS;
+}
+
+std::shared_ptr<ShardBinaryIndex> ShardReader::LoadBinaryIndex(const std::string &file) {
+  auto binary_index = std::make_shared<ShardBinaryIndex>();
+  if (binary_index->Load(file + kBinaryIndexSuffix) != SUCCESS) {
+    return nullptr;
+  }
+  struct stat file_stat;
+  if (binary_index->GetShardName() != GetFileName(file).second || stat(common::SafeCStr(file), &file_stat) != 0 ||
+      binary_index->GetFileSize() != static_cast<uint64_t>(file_stat.st_size)) {
+    MS_LOG(WARNING) << "Binary index can not match file " << file << ", use the index db.";
+    return nullptr;
+  }
+  MS_LOG(DEBUG) << "Load binary index of " << file << " successfully.";
+  return binary_index;
+}
+
 MSRStatus ShardReader::CheckColumnList(const std::vector<std::string> &selected_columns) {
   vector<int> inSchema(selected_columns.size(), 0);
   for (auto &p : GetShardHeader()->GetSchemas()) {
@@ -208,7 +257,136 @@ MSRStatus ShardReader::Open(int n_consumer) {
     }
     MS_LOG(INFO) << "Open shard file successfully.";
   }
+  read_runs_ = std::vector<ReadRun>(n_consumer);
+  MapFiles();
+
+  return SUCCESS;
+}
+
+void ShardReader::MapFiles() {
+  UnmapFiles();
+  file_maps_ = std::vector<std::pair<uint8_t *, uint64_t>>(file_paths_.size(), {nullptr, 0});
+  file_descriptors_ = std::vector<int>(file_paths_.size(), -1);
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (!map_files_) {
+    return;
+  }
+  for (size_t i = 0; i < file_paths_.size(); ++i) {
+    int fd = open(common::SafeCStr(file_paths_[i]), O_RDONLY);
+    if (fd < 0) {
+      MS_LOG(WARNING) << "Failed to open shard file for pread, fall back to file stream: " << file_paths_[i];
+      continue;
+    }
+    file_descriptors_[i] = fd;
+    // Rows are copied with pread and the mapping is only given to madvise. Touching a mapping of a file which shrinks
+    // raises SIGBUS, while pread just comes back short and fails the row.
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == 0 && file_stat.st_size > 0) {
+      void *addr = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+      if (addr != MAP_FAILED) {
+        file_maps_[i] = {static_cast<uint8_t *>(addr), static_cast<uint64_t>(file_stat.st_size)};
+      } else {
+        MS_LOG(WARNING) << "Failed to map shard file, blobs will not be prefetched: " << file_paths_[i];
+      }
+    }
+  }
+#endif
+}
+
+void ShardReader::UnmapFiles() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  for (auto &file_map : file_maps_) {
+    if (file_map.first != nullptr) {
+      (void)munmap(file_map.first, file_map.second);
+    }
+  }
+  for (auto fd : file_descriptors_) {
+    if (fd >= 0) {
+      (void)close(fd);
+    }
+  }
+#endif
+  file_maps_.clear();
+  file_descriptors_.clear();
+}
+
+MSRStatus ShardReader::ReadBlob(int shard_id, uint32_t consumer_id, uint64_t file_offset, uint64_t length,
+                                std::vector<uint8_t> *blob) {
+  blob->resize(length);
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (shard_id < static_cast<int>(file_descriptors_.size()) && file_descriptors_[shard_id] >= 0) {
+    uint64_t done = 0;
+    while (done < length) {
+      auto n = pread(file_descriptors_[shard_id], blob->data() + done, length - done, file_offset + done);
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        MS_LOG(ERROR) << "File read failed, the shard file may have been truncated, offset: " << file_offset
+                      << ", length: " << length;
+        return FAILED;
+      }
+      done += static_cast<uint64_t>(n);
+    }
+    return SUCCESS;
+  }
+#endif
+
+  auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
+  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+    MS_LOG(ERROR) << "File seekg failed";
+    file_streams_random_[consumer_id][shard_id]->close();
+    return FAILED;
+  }
+
+  auto &io_read = file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&(*blob)[0]), length);
+  if (!io_read.good() || io_read.fail() || io_read.bad()) {
+    MS_LOG(ERROR) << "File read failed";
+    file_streams_random_[consumer_id][shard_id]->close();
+    return FAILED;
+  }
+  return SUCCESS;
+}
 
+MSRStatus ShardReader::ReadTaskBlob(int task_id, int end_task_id, int shard_id, uint32_t consumer_id,
+                                    uint64_t file_offset, uint64_t length, std::vector<uint8_t> *blob) {
+  if (consumer_id >= read_runs_.size()) {
+    return ReadBlob(shard_id, consumer_id, file_offset, length, blob);
+  }
+  // The run is looked up by file range, so it stays valid when the tasks are shuffled
+  auto &run = read_runs_[consumer_id];
+  if (run.shard_id == shard_id && file_offset >= run.file_offset &&
+      file_offset + length <= run.file_offset + run.data.size()) {
+    auto first = run.data.begin() + (file_offset - run.file_offset);
+    blob->assign(first, first + length);
+    return SUCCESS;
+  }
+
+  // Merge the blobs of the following tasks of the consumer which lie right behind each other in the file
+  uint64_t run_length = length;
+  int next_shard_id = 0;
+  uint64_t next_page_id = 0;
+  uint64_t next_offset = 0;
+  uint64_t next_length = 0;
+  for (int next_task = task_id + 1; next_task < end_task_id && run_length < kMaxReadRunBytes; ++next_task) {
+    if (!GetBlobRange(next_task, &next_shard_id, &next_page_id, &next_offset, &next_length) ||
+        next_shard_id != shard_id || next_offset < file_offset + run_length ||
+        next_offset - (file_offset + run_length) > kMaxReadRunGap) {
+      break;
+    }
+    run_length = next_offset + next_length - file_offset;
+  }
+  if (run_length == length) {
+    return ReadBlob(shard_id, consumer_id, file_offset, length, blob);
+  }
+  run.shard_id = -1;
+  if (SUCCESS != ReadBlob(shard_id, consumer_id, file_offset, run_length, &run.data)) {
+    // the file may end inside the run, the row itself can still be there
+    return ReadBlob(shard_id, consumer_id, file_offset, length, blob);
+  }
+  run.shard_id = shard_id;
+  run.file_offset = file_offset;
+  blob->assign(run.data.begin(), run.data.begin() + length);
   return SUCCESS;
 }
 
@@ -234,6 +412,7 @@ void ShardReader::FileStreamsOperator() {
       database_paths_[i] = nullptr;
     }
   }
+  binary_indexes_.clear();
 }
 
 ShardReader::~ShardReader() { Close(); }
@@ -241,6 +420,8 @@ ShardReader::~ShardReader() { Close(); }
 void ShardReader::Close() {
   (void)Finish();  // interrupt reading and stop threads
   FileStreamsOperator();
+  UnmapFiles();
+  read_runs_.clear();
 }
 
 std::shared_ptr<ShardHeader> ShardReader::GetShardHeader() const { return shard_header_; }
@@ -356,16 +537,19 @@ MSRStatus ShardReader::ConvertLabelToJson(const std::vector<std::vector<std::str
 MSRStatus ShardReader::ReadAllRowsInShard(int shard_id, const std::string &sql, const std::vector<std::string> &columns,
                                           std::vector<std::vector<std::vector<uint64_t>>> &offsets,
                                           std::vector<std::vector<json>> &column_values) {
-  auto db = database_paths_[shard_id];
   std::vector<std::vector<std::string>> labels;
-  char *errmsg = nullptr;
-  int rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, &labels, &errmsg);
-  if (rc != SQLITE_OK) {
-    MS_LOG(ERROR) << "Error in select statement, sql: " << sql << ", error: " << errmsg;
+  if (ReadAllRowsInBinaryIndex(shard_id, columns, &labels) != SUCCESS) {
+    auto db = database_paths_[shard_id];
+    char *errmsg = nullptr;
+    int rc = sqlite3_exec(db, common::SafeCStr(sql), SelectCallback, &labels, &errmsg);
+    if (rc != SQLITE_OK) {
+      MS_LOG(ERROR) << "Error in select statement, sql: " << sql << ", error: " << errmsg;
+      sqlite3_free(errmsg);
+      sqlite3_close(db);
+      db = nullptr;
+      return FAILED;
+    }
     sqlite3_free(errmsg);
-    sqlite3_close(db);
-    db = nullptr;
-    return FAILED;
   }
   MS_LOG(INFO) << "Get " << static_cast<int>(labels.size()) << " records from shard " << shard_id << " index.";
 
@@ -378,10 +562,40 @@ MSRStatus ShardReader::ReadAllRowsInShard(int shard_id, const std::string &sql,
       return FAILED;
     }
   }
-  sqlite3_free(errmsg);
   return ConvertLabelToJson(labels, fs, offsets, shard_id, columns, column_values);
 }
 
+MSRStatus ShardReader::ReadAllRowsInBinaryIndex(int shard_id, const std::vector<std::string> &columns,
+                                                std::vector<std::vector<std::string>> *labels) {
+  const auto &binary_index = binary_indexes_[shard_id];
+  if (binary_index == nullptr) {
+    return FAILED;
+  }
+  std::vector<int> field_ids;
+  if (all_in_index_ && GetBinaryIndexFieldIds(shard_id, columns, &field_ids) != SUCCESS) {
+    return FAILED;
+  }
+
+  // same columns as the select statement of ReadAllRowGroup
+  labels->reserve(binary_index->GetNumRows());
+  for (uint64_t pos = 0; pos < binary_index->GetNumRows(); ++pos) {
+    const auto &row = binary_index->GetRow(pos);
+    std::vector<std::string> label{std::to_string(row.row_group_id), std::to_string(row.page_offset_blob),
+                                   std::to_string(row.page_offset_blob_end)};
+    if (all_in_index_) {
+      for (int field_id : field_ids) {
+        label.emplace_back(binary_index->GetValue(field_id, pos));
+      }
+    } else {
+      label.push_back(std::to_string(row.page_id_raw));
+      label.push_back(std::to_string(row.page_offset_raw));
+      label.push_back(std::to_string(row.page_offset_raw_end));
+    }
+    labels->push_back(std::move(label));
+  }
+  return SUCCESS;
+}
+
 MSRStatus ShardReader::GetAllClasses(const std::string &category_field, std::set<std::string> &categories) {
   std::map<std::string, uint64_t> index_columns;
   for (auto &field : GetShardHeader()->GetFields()) {
@@ -398,7 +612,12 @@ MSRStatus ShardReader::GetAllClasses(const std::string &category_field, std::set
   std::string sql = "SELECT DISTINCT " + ret.second + " FROM INDEXES";
   std::vector<std::thread> threads = std::vector<std::thread>(shard_count_);
   for (int x = 0; x < shard_count_; x++) {
-    threads[x] = std::thread(&ShardReader::GetClassesInShard, this, database_paths_[x], x, sql, std::ref(categories));
+    if (binary_indexes_[x] != nullptr && binary_indexes_[x]->GetFieldId(ret.second) >= 0) {
+      threads[x] = std::thread(&ShardReader::GetClassesInBinaryIndex, this, x, ret.second, std::ref(categories));
+    } else {
+      threads[x] =
+        std::thread(&ShardReader::GetClassesInShard, this, database_paths_[x], x, sql, std::ref(categories));
+    }
   }
 
   for (int x = 0; x < shard_count_; x++) {
@@ -429,6 +648,15 @@ void ShardReader::GetClassesInShard(sqlite3 *db, int shard_id, const std::string
   }
 }
 
+void ShardReader::GetClassesInBinaryIndex(int shard_id, const std::string &field_name,
+                                          std::set<std::string> &categories) {
+  const auto &binary_index = binary_indexes_[shard_id];
+  auto values = binary_index->GetDistinctValues(binary_index->GetFieldId(field_name));
+  MS_LOG(INFO) << "Get " << static_cast<int>(values.size()) << " records from shard " << shard_id << " index.";
+  std::lock_guard<std::mutex> lck(shard_locker_);
+  categories.insert(values.begin(), values.end());
+}
+
 ROW_GROUPS ShardReader::ReadAllRowGroup(std::vector<std::string> &columns) {
   std::string fields = "ROW_GROUP_ID, PAGE_OFFSET_BLOB, PAGE_OFFSET_BLOB_END";
   std::vector<std::vector<std::vector<uint64_t>>> offsets(shard_count_, std::vector<std::vector<uint64_t>>{});
@@ -494,6 +722,24 @@ ROW_GROUP_BRIEF ShardReader::ReadRowGroupCriteria(int group_id, int shard_id,
   std::string file_name = file_paths_[shard_id];
   uint64_t page_length = page->GetPageSize();
   uint64_t page_offset = page_size_ * page->GetPageID() + header_size_;
+  const auto &binary_index = binary_indexes_[shard_id];
+  std::vector<int> field_ids;
+  if (binary_index != nullptr && GetBinaryIndexFieldIds(shard_id, criteria_list, &field_ids) == SUCCESS) {
+    // rows of a blob page are consecutive, look them up in the sorted column of the criteria field
+    auto rows =
+      binary_index->GetRowsByValue(field_ids[0], criteria.second, page->GetStartRowID(), page->GetEndRowID());
+    auto status_labels = GetLabelsFromBinaryIndex(shard_id, rows, columns);
+    if (status_labels.first != SUCCESS) {
+      return std::make_tuple(FAILED, "", 0, 0, std::vector<std::vector<uint64_t>>(), std::vector<json>());
+    }
+    std::vector<std::vector<uint64_t>> image_offset;
+    for (auto pos : rows) {
+      const auto &row = binary_index->GetRow(pos);
+      image_offset.emplace_back(std::vector<uint64_t>{row.page_offset_blob + kInt64Len, row.page_offset_blob_end});
+    }
+    return std::make_tuple(SUCCESS, file_name, page_length, page_offset, std::move(image_offset),
+                           std::move(status_labels.second));
+  }
   std::vector<std::vector<uint64_t>> image_offset = GetImageOffset(page->GetPageID(), shard_id, criteria);
 
   auto status_labels = GetLabels(page->GetPageID(), shard_id, columns, criteria);
@@ -727,32 +973,67 @@ std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabels(int page_id, int
       }
       sqlite3_free(errmsg);
     }
-    std::vector<json> ret;
-    for (unsigned int i = 0; i < labels.size(); ++i) ret.emplace_back(json{});
-    for (unsigned int i = 0; i < labels.size(); ++i) {
-      json construct_json;
-      for (unsigned int j = 0; j < columns.size(); ++j) {
-        // construct json "f1": value
-        auto schema = shard_header_->GetSchemas()[0]->GetSchema()["schema"];
+    return {SUCCESS, ConstructLabelJson(labels, columns)};
+  }
+  return GetLabelsFromPage(page_id, shard_id, columns, criteria);
+}
 
-        // convert the string to base type by schema
-        if (schema[columns[j]]["type"] == "int32") {
-          construct_json[columns[j]] = StringToNum<int32_t>(labels[i][j]);
-        } else if (schema[columns[j]]["type"] == "int64") {
-          construct_json[columns[j]] = StringToNum<int64_t>(labels[i][j]);
-        } else if (schema[columns[j]]["type"] == "float32") {
-          construct_json[columns[j]] = StringToNum<float>(labels[i][j]);
-        } else if (schema[columns[j]]["type"] == "float64") {
-          construct_json[columns[j]] = StringToNum<double>(labels[i][j]);
-        } else {
-          construct_json[columns[j]] = std::string(labels[i][j]);
-        }
+std::vector<json> ShardReader::ConstructLabelJson(const std::vector<std::vector<std::string>> &labels,
+                                                  const std::vector<std::string> &columns) {
+  std::vector<json> ret;
+  for (unsigned int i = 0; i < labels.size(); ++i) ret.emplace_back(json{});
+  for (unsigned int i = 0; i < labels.size(); ++i) {
+    json construct_json;
+    for (unsigned int j = 0; j < columns.size(); ++j) {
+      // construct json "f1": value
+      auto schema = shard_header_->GetSchemas()[0]->GetSchema()["schema"];
+
+      // convert the string to base type by schema
+      if (schema[columns[j]]["type"] == "int32") {
+        construct_json[columns[j]] = StringToNum<int32_t>(labels[i][j]);
+      } else if (schema[columns[j]]["type"] == "int64") {
+        construct_json[columns[j]] = StringToNum<int64_t>(labels[i][j]);
+      } else if (schema[columns[j]]["type"] == "float32") {
+        construct_json[columns[j]] = StringToNum<float>(labels[i][j]);
+      } else if (schema[columns[j]]["type"] == "float64") {
+        construct_json[columns[j]] = StringToNum<double>(labels[i][j]);
+      } else {
+        construct_json[columns[j]] = std::string(labels[i][j]);
       }
-      ret[i] = construct_json;
     }
-    return {SUCCESS, ret};
+    ret[i] = construct_json;
   }
-  return GetLabelsFromPage(page_id, shard_id, columns, criteria);
+  return ret;
+}
+
+std::pair<MSRStatus, std::vector<json>> ShardReader::GetLabelsFromBinaryIndex(int shard_id,
+                                                                              const std::vector<uint64_t> &rows,
+                                                                              const std::vector<std::string> &columns) {
+  const auto &binary_index = binary_indexes_[shard_id];
+  if (all_in_index_) {
+    std::vector<int> field_ids;
+    if (GetBinaryIndexFieldIds(shard_id, columns, &field_ids) != SUCCESS) {
+      MS_LOG(ERROR) << "Columns are not in the binary index of shard " << shard_id;
+      return {FAILED, {}};
+    }
+    std::vector<std::vector<std::string>> labels;
+    for (auto pos : rows) {
+      std::vector<std::string> label;
+      for (int field_id : field_ids) {
+        label.emplace_back(binary_index->GetValue(field_id, pos));
+      }
+      labels.push_back(std::move(label));
+    }
+    return {SUCCESS, ConstructLabelJson(labels, columns)};
+  }
+
+  std::vector<std::vector<std::string>> label_offsets;
+  for (auto pos : rows) {
+    const auto &row = binary_index->GetRow(pos);
+    label_offsets.push_back(std::vector<std::string>{
+      std::to_string(row.page_id_raw), std::to_string(row.page_offset_raw), std::to_string(row.page_offset_raw_end)});
+  }
+  return GetLabelsFromBinaryFile(shard_id, columns, label_offsets);
 }
 
 bool ResortRowGroups(std::tuple<int, int, int, int> a, std::tuple<int, int, int, int> b) {
@@ -772,6 +1053,7 @@ MSRStatus ShardReader::Finish() {
       i_thread.join();
     }
   }
+  StopPrefetch();
   return SUCCESS;
 }
 
@@ -956,6 +1238,16 @@ MSRStatus ShardReader::Launch(bool isSimpleReader) {
     interrupt_ = true;
     return FAILED;
   }
+
+  // Start prefetching the blobs if any shard file is mapped
+  bool has_file_map =
+    std::any_of(file_maps_.begin(), file_maps_.end(),
+                [](const std::pair<uint8_t *, uint64_t> &file_map) { return file_map.first != nullptr; });
+  if (prefetch_depth_ > 0 && has_file_map && !prefetch_thread_.joinable()) {
+    ResetPrefetch();
+    stop_prefetch_ = false;
+    prefetch_thread_ = std::thread(&ShardReader::PrefetchBlobs, this);
+  }
   if (isSimpleReader) return SUCCESS;
   // Start provider consumer threads
   thread_set_ = std::vector<std::thread>(n_consumer_);
@@ -1103,7 +1395,7 @@ MSRStatus ShardReader::CreateTasks(const std::vector<std::tuple<int, int, int, u
   return SUCCESS;
 }
 
-TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_id) {
+TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_id, int end_task_id) {
   // All tasks are done
   if (task_id >= static_cast<int>(tasks_.Size())) {
     return std::make_pair(FAILED,
@@ -1131,25 +1423,13 @@ TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_
   const std::shared_ptr<Page> &page = ret.second;
 
   // Pack image list
-  std::vector<uint8_t> images(addr[1] - addr[0]);
+  std::vector<uint8_t> images;
   auto file_offset = header_size_ + page_size_ * (page->GetPageID()) + addr[0];
-
-  auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
-  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-    MS_LOG(ERROR) << "File seekg failed";
-    file_streams_random_[consumer_id][shard_id]->close();
+  if (SUCCESS != ReadTaskBlob(task_id, end_task_id, shard_id, consumer_id, file_offset, addr[1] - addr[0], &images)) {
     return std::make_pair(FAILED,
                           std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
   }
-
-  auto &io_read =
-    file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), addr[1] - addr[0]);
-  if (!io_read.good() || io_read.fail() || io_read.bad()) {
-    MS_LOG(ERROR) << "File read failed";
-    file_streams_random_[consumer_id][shard_id]->close();
-    return std::make_pair(FAILED,
-                          std::pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
-  }
+  UpdateReadCursor(task_id);
 
   // Deliver batch data to output map
   std::vector<std::tuple<std::vector<uint8_t>, json>> batch;
@@ -1220,11 +1500,11 @@ std::vector<std::tuple<std::vector<uint8_t>, json>> ShardReader::GetNext() {
 }
 
 std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>> ShardReader::GetNextById(
-  const int64_t &task_id, const int32_t &consumer_id) {
+  const int64_t &task_id, const int32_t &consumer_id, const int64_t &end_task_id) {
   if (interrupt_) {
     return std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
   }
-  const auto &ret = ConsumerOneTask(task_id, consumer_id);
+  const auto &ret = ConsumerOneTask(task_id, consumer_id, end_task_id);
   if (SUCCESS != ret.first) {
     return std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
   }
@@ -1275,9 +1555,12 @@ void ShardReader::Reset() {
     deliver_id_ = 0;
   }
   cv_delivery_.notify_all();
+  ResetPrefetch();
 }
 
 void ShardReader::ShuffleTask() {
+  // the prefetch thread walks the task list, hold it off while the permutation changes
+  std::lock_guard<std::mutex> lck(mtx_prefetch_);
   // exist shuffle and distributed sampler in ops, skip shuffle
   bool has_sharding = false;
   for (const auto &op : operators_) {
@@ -1297,6 +1580,135 @@ void ShardReader::ShuffleTask() {
     }
   }
   if (tasks_.permutation_.empty()) tasks_.MakePerm();
+  read_cursor_ = -1;
+  prefetch_task_ = 0;
+  prefetch_runs_.clear();
+  cv_prefetch_.notify_one();
+}
+
+bool ShardReader::GetBlobRange(int task_id, int *shard_id, uint64_t *page_id, uint64_t *file_offset,
+                               uint64_t *length) {
+  if (task_id < 0 || task_id >= static_cast<int>(tasks_.Size())) {
+    return false;
+  }
+  const auto &task = tasks_.GetTaskByID(tasks_.permutation_[task_id]);
+  if (std::get<0>(task) == TaskType::kPaddedTask) {
+    return false;
+  }
+  *shard_id = std::get<0>(std::get<1>(task));
+  const auto &addr = std::get<2>(task);
+  const auto &ret = shard_header_->GetPageByGroupId(std::get<1>(std::get<1>(task)), *shard_id);
+  if (SUCCESS != ret.first) {
+    return false;
+  }
+  *page_id = ret.second->GetPageID();
+  *file_offset = header_size_ + page_size_ * (*page_id) + addr[0];
+  *length = addr[1] - addr[0];
+  return true;
+}
+
+void ShardReader::PrefetchBlobs() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  auto thread_id = kThreadName + "PREFETCH";
+  prctl(PR_SET_NAME, common::SafeCStr(thread_id), 0, 0, 0);
+  const uint64_t kSystemPageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+
+  for (;;) {
+    int shard_id = 0;
+    uint64_t begin = 0;
+    uint64_t end = 0;
+    {
+      std::unique_lock<std::mutex> lck(mtx_prefetch_);
+      cv_prefetch_.wait(lck, [this] {
+        bool window_full = false;
+        do {
+          // drop the reads which have been consumed
+          while (!prefetch_runs_.empty() && prefetch_runs_.front() <= read_cursor_) {
+            prefetch_runs_.pop_front();
+          }
+          // the consumers only wake us up once the window is full and they are done with its oldest read, check the
+          // cursor again after publishing that in case a consumer moved it in between
+          window_full = static_cast<int>(prefetch_runs_.size()) >= prefetch_depth_;
+          prefetch_wakeup_ = window_full ? prefetch_runs_.front() : std::numeric_limits<int>::max();
+        } while (window_full && prefetch_runs_.front() <= read_cursor_);
+        return stop_prefetch_ || (!window_full && prefetch_task_ < static_cast<int>(tasks_.Size()));
+      });
+      if (stop_prefetch_) {
+        return;
+      }
+      // do not prefetch the rows which have already been read
+      prefetch_task_ = std::max(prefetch_task_, read_cursor_ + 1);
+
+      // Coalesce the following rows in the same page into one read
+      uint64_t page_id = 0;
+      uint64_t length = 0;
+      if (!GetBlobRange(prefetch_task_++, &shard_id, &page_id, &begin, &length)) {
+        continue;
+      }
+      end = begin + length;
+      int next_shard_id = 0;
+      uint64_t next_page_id = 0;
+      uint64_t next_offset = 0;
+      while (GetBlobRange(prefetch_task_, &next_shard_id, &next_page_id, &next_offset, &length) &&
+             next_shard_id == shard_id && next_page_id == page_id) {
+        begin = std::min(begin, next_offset);
+        end = std::max(end, next_offset + length);
+        ++prefetch_task_;
+      }
+      prefetch_runs_.push_back(prefetch_task_ - 1);
+    }
+
+    // Ask the kernel to read the range ahead, the consumers then copy from the page cache
+    const auto &file_map = file_maps_[shard_id];
+    if (file_map.first == nullptr || begin >= file_map.second) {
+      continue;
+    }
+    end = std::min(end, file_map.second);
+    uint64_t aligned_begin = begin / kSystemPageSize * kSystemPageSize;
+    (void)madvise(file_map.first + aligned_begin, end - aligned_begin, MADV_WILLNEED);
+  }
+#endif
+}
+
+void ShardReader::UpdateReadCursor(int task_id) {
+  if (!prefetch_thread_.joinable()) {
+    return;
+  }
+  int cursor = read_cursor_;
+  while (task_id > cursor && !read_cursor_.compare_exchange_weak(cursor, task_id)) {
+  }
+  // Most reads stay inside the prefetch window, only a read which moves the window wakes up the prefetch thread.
+  // The prefetch thread sets prefetch_wakeup_ before it checks read_cursor_, so one of the two sees the other.
+  if (task_id < prefetch_wakeup_) {
+    return;
+  }
+  {
+    // the prefetch thread may be between its check and its wait, the locker lets it get to the wait first
+    std::lock_guard<std::mutex> lck(mtx_prefetch_);
+    prefetch_wakeup_ = std::numeric_limits<int>::max();
+  }
+  cv_prefetch_.notify_one();
+}
+
+void ShardReader::ResetPrefetch() {
+  {
+    std::lock_guard<std::mutex> lck(mtx_prefetch_);
+    read_cursor_ = -1;
+    prefetch_task_ = 0;
+    prefetch_runs_.clear();
+  }
+  cv_prefetch_.notify_one();
+}
+
+void ShardReader::StopPrefetch() {
+  {
+    std::lock_guard<std::mutex> lck(mtx_prefetch_);
+    stop_prefetch_ = true;
+  }
+  cv_prefetch_.notify_one();
+  if (prefetch_thread_.joinable()) {
+    prefetch_thread_.join();
+  }
 }
 
 }  // namespace mindrecord
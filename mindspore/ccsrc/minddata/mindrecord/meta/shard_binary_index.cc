@@ -0,0 +1,367 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_binary_index.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include <sys/stat.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::ERROR;
+using mindspore::MsLogLevel::WARNING;
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+const uint64_t kAlignment = 8;
+const uint64_t kValueItems = 4;  // type, integer or double bits, text offset, text length
+
+uint64_t Padding(uint64_t len) { return (kAlignment - len % kAlignment) % kAlignment; }
+
+void WriteUint64(std::ofstream &out, uint64_t value) {
+  (void)out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void WriteString(std::ofstream &out, const std::string &str) {
+  const char zeros[kAlignment] = {0};
+  WriteUint64(out, str.size());
+  (void)out.write(str.data(), str.size());
+  (void)out.write(zeros, Padding(str.size()));
+}
+}  // namespace
+
+ShardBinaryIndex::~ShardBinaryIndex() {
+#if !defined(_WIN32) && !defined(_WIN64)
+  if (addr_ != nullptr && buffer_.empty()) {
+    (void)munmap(addr_, size_);
+  }
+#endif
+}
+
+MSRStatus ShardBinaryIndex::Write(const std::string &index_path, const std::string &shard_name, uint64_t file_size,
+                                  const std::vector<std::string> &field_names, const std::vector<bool> &number_fields,
+                                  std::vector<IndexRow> rows, std::vector<std::vector<IndexValue>> values) {
+  if (values.size() != rows.size()) {
+    MS_LOG(ERROR) << "Number of rows " << rows.size() << " does not match number of values " << values.size();
+    return FAILED;
+  }
+  if (number_fields.size() != field_names.size()) {
+    MS_LOG(ERROR) << "Number of field types " << number_fields.size() << " does not match number of fields "
+                  << field_names.size();
+    return FAILED;
+  }
+  uint64_t num_rows = rows.size();
+
+  // Sort rows by row id
+  std::vector<uint64_t> order(num_rows);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&rows](uint64_t a, uint64_t b) { return rows[a].row_id < rows[b].row_id; });
+  std::vector<IndexRow> sorted_rows(num_rows);
+  std::vector<std::vector<IndexValue>> sorted_values(num_rows);
+  for (uint64_t i = 0; i < num_rows; ++i) {
+    sorted_rows[i] = rows[order[i]];
+    sorted_values[i] = std::move(values[order[i]]);
+    sorted_values[i].resize(field_names.size());
+  }
+
+  // Write to a temporary file first so that readers never see a partial index
+  std::string tmp_path = index_path + ".tmp";
+  std::ofstream out(common::SafeCStr(tmp_path), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!out.good()) {
+    MS_LOG(ERROR) << "Failed to open index file: " << tmp_path;
+    return FAILED;
+  }
+  (void)out.write(kBinaryIndexMagic, kAlignment);
+  WriteUint64(out, kBinaryIndexVersion);
+  WriteUint64(out, file_size);
+  WriteUint64(out, num_rows);
+  WriteUint64(out, field_names.size());
+  WriteString(out, shard_name);
+  (void)out.write(reinterpret_cast<const char *>(sorted_rows.data()), num_rows * sizeof(IndexRow));
+
+  for (uint64_t field_id = 0; field_id < field_names.size(); ++field_id) {
+    WriteString(out, field_names[field_id]);
+    WriteUint64(out, number_fields[field_id] ? 1 : 0);
+    uint64_t offset = 0;
+    std::vector<ValueRef> refs(num_rows);
+    for (uint64_t i = 0; i < num_rows; ++i) {
+      const auto &value = sorted_values[i][field_id];
+      refs[i] = ValueRef{value.type, value.integer, value.real, value.text};
+      uint64_t bits = 0;
+      if (value.type == IndexValueType::kInteger) {
+        bits = static_cast<uint64_t>(value.integer);
+      } else if (value.type == IndexValueType::kReal) {
+        (void)memcpy(&bits, &value.real, sizeof(bits));
+      }
+      WriteUint64(out, static_cast<uint64_t>(value.type));
+      WriteUint64(out, bits);
+      WriteUint64(out, offset);
+      WriteUint64(out, value.text.size());
+      offset += value.text.size();
+    }
+
+    // stable sort keeps the positions of equal values ascending
+    std::vector<uint64_t> sorted(num_rows);
+    std::iota(sorted.begin(), sorted.end(), 0);
+    std::stable_sort(sorted.begin(), sorted.end(),
+                     [&refs](uint64_t a, uint64_t b) { return CompareValues(refs[a], refs[b]) < 0; });
+    (void)out.write(reinterpret_cast<const char *>(sorted.data()), num_rows * sizeof(uint64_t));
+
+    std::string pool;
+    pool.reserve(offset);
+    for (uint64_t i = 0; i < num_rows; ++i) {
+      pool += sorted_values[i][field_id].text;
+    }
+    WriteString(out, pool);
+  }
+  out.close();
+  if (out.fail()) {
+    MS_LOG(ERROR) << "Failed to write index file: " << tmp_path;
+    (void)std::remove(common::SafeCStr(tmp_path));
+    return FAILED;
+  }
+  if (std::rename(common::SafeCStr(tmp_path), common::SafeCStr(index_path)) != 0) {
+    MS_LOG(ERROR) << "Failed to rename index file " << tmp_path << " to " << index_path;
+    (void)std::remove(common::SafeCStr(tmp_path));
+    return FAILED;
+  }
+  return SUCCESS;
+}
+
+MSRStatus ShardBinaryIndex::Load(const std::string &index_path) {
+#if !defined(_WIN32) && !defined(_WIN64)
+  int fd = open(common::SafeCStr(index_path), O_RDONLY);
+  if (fd < 0) {
+    return FAILED;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    close(fd);
+    return FAILED;
+  }
+  void *addr = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    MS_LOG(WARNING) << "Failed to map index file: " << index_path;
+    return FAILED;
+  }
+  addr_ = static_cast<uint8_t *>(addr);
+  size_ = static_cast<uint64_t>(file_stat.st_size);
+#else
+  std::ifstream in(common::SafeCStr(index_path), std::ios::in | std::ios::binary | std::ios::ate);
+  if (!in.good()) {
+    return FAILED;
+  }
+  buffer_.resize(static_cast<uint64_t>(in.tellg()));
+  (void)in.seekg(0, std::ios::beg);
+  if (buffer_.empty() || !in.read(reinterpret_cast<char *>(buffer_.data()), buffer_.size())) {
+    return FAILED;
+  }
+  addr_ = buffer_.data();
+  size_ = buffer_.size();
+#endif
+
+  // Walk the layout, every section is checked against the file size
+  uint64_t pos = 0;
+  auto read_uint64 = [this, &pos](uint64_t *value) {
+    if (pos + sizeof(uint64_t) > size_) return false;
+    (void)memcpy(value, addr_ + pos, sizeof(uint64_t));
+    pos += sizeof(uint64_t);
+    return true;
+  };
+  auto read_section = [this, &pos](uint64_t len, const uint8_t **data) {
+    if (len > size_ - pos) return false;
+    *data = addr_ + pos;
+    pos += len + Padding(len);
+    return pos <= size_;
+  };
+  auto read_string = [&read_uint64, &read_section](std::string *str) {
+    uint64_t len = 0;
+    const uint8_t *data = nullptr;
+    if (!read_uint64(&len) || !read_section(len, &data)) return false;
+    str->assign(reinterpret_cast<const char *>(data), len);
+    return true;
+  };
+
+  uint64_t version = 0;
+  uint64_t num_fields = 0;
+  if (size_ < kAlignment || memcmp(addr_, kBinaryIndexMagic, kAlignment) != 0) {
+    MS_LOG(ERROR) << "Invalid index file: " << index_path;
+    return FAILED;
+  }
+  pos = kAlignment;
+  if (!read_uint64(&version) || version != kBinaryIndexVersion || !read_uint64(&file_size_) ||
+      !read_uint64(&num_rows_) || !read_uint64(&num_fields) || num_fields > kMaxFieldCount ||
+      !read_string(&shard_name_)) {
+    MS_LOG(ERROR) << "Invalid header of index file: " << index_path;
+    return FAILED;
+  }
+  const uint8_t *data = nullptr;
+  if (num_rows_ > size_ / sizeof(IndexRow) || !read_section(num_rows_ * sizeof(IndexRow), &data)) {
+    MS_LOG(ERROR) << "Invalid rows of index file: " << index_path;
+    return FAILED;
+  }
+  rows_ = reinterpret_cast<const IndexRow *>(data);
+
+  fields_.clear();
+  for (uint64_t i = 0; i < num_fields; ++i) {
+    Field field;
+    uint64_t is_number = 0;
+    const uint8_t *values = nullptr;
+    const uint8_t *sorted = nullptr;
+    const uint8_t *pool = nullptr;
+    uint64_t pool_size = 0;
+    if (!read_string(&field.name) || !read_uint64(&is_number) ||
+        !read_section(num_rows_ * kInt64Len * kValueItems, &values) ||
+        !read_section(num_rows_ * kInt64Len, &sorted) || !read_uint64(&pool_size) ||
+        !read_section(pool_size, &pool)) {
+      MS_LOG(ERROR) << "Invalid field of index file: " << index_path;
+      return FAILED;
+    }
+    field.is_number = is_number != 0;
+    field.values = reinterpret_cast<const uint64_t *>(values);
+    field.sorted = reinterpret_cast<const uint64_t *>(sorted);
+    field.pool = reinterpret_cast<const char *>(pool);
+    for (uint64_t row = 0; row < num_rows_; ++row) {
+      const uint64_t *value = field.values + row * kValueItems;
+      if (value[0] > static_cast<uint64_t>(IndexValueType::kText) || value[2] > pool_size ||
+          value[3] > pool_size - value[2] || field.sorted[row] >= num_rows_) {
+        MS_LOG(ERROR) << "Invalid field of index file: " << index_path;
+        return FAILED;
+      }
+    }
+    fields_.push_back(std::move(field));
+  }
+  return SUCCESS;
+}
+
+int ShardBinaryIndex::GetFieldId(const std::string &field_name) const {
+  for (size_t i = 0; i < fields_.size(); ++i) {
+    if (fields_[i].name == field_name) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+ShardBinaryIndex::ValueRef ShardBinaryIndex::GetValueRef(int field_id, uint64_t pos) const {
+  const auto &field = fields_[field_id];
+  const uint64_t *value = field.values + pos * kValueItems;
+  ValueRef ref{static_cast<IndexValueType>(value[0]), 0, 0, std::string_view(field.pool + value[2], value[3])};
+  if (ref.type == IndexValueType::kInteger) {
+    ref.integer = static_cast<int64_t>(value[1]);
+  } else if (ref.type == IndexValueType::kReal) {
+    (void)memcpy(&ref.real, &value[1], sizeof(ref.real));
+  }
+  return ref;
+}
+
+int ShardBinaryIndex::CompareValues(const ValueRef &a, const ValueRef &b) {
+  // sqlite sorts null before numbers and numbers before text
+  auto rank = [](IndexValueType type) {
+    return type == IndexValueType::kNull ? 0 : (type == IndexValueType::kText ? 2 : 1);
+  };
+  if (rank(a.type) != rank(b.type)) {
+    return rank(a.type) < rank(b.type) ? -1 : 1;
+  }
+  if (a.type == IndexValueType::kNull) {
+    return 0;
+  }
+  if (a.type == IndexValueType::kText) {
+    int ret = a.text.compare(b.text);
+    return ret < 0 ? -1 : (ret > 0 ? 1 : 0);
+  }
+  if (a.type == IndexValueType::kInteger && b.type == IndexValueType::kInteger) {
+    return a.integer < b.integer ? -1 : (a.integer > b.integer ? 1 : 0);
+  }
+  // long double holds every int64 exactly, so 1 and 1.0 are equal as in sqlite
+  long double x = a.type == IndexValueType::kInteger ? static_cast<long double>(a.integer) : a.real;
+  long double y = b.type == IndexValueType::kInteger ? static_cast<long double>(b.integer) : b.real;
+  return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+std::string_view ShardBinaryIndex::GetValue(int field_id, uint64_t pos) const { return GetValueRef(field_id, pos).text; }
+
+std::vector<std::string> ShardBinaryIndex::GetDistinctValues(int field_id) const {
+  std::vector<std::string> values;
+  const auto &field = fields_[field_id];
+  for (uint64_t i = 0; i < num_rows_; ++i) {
+    auto value = GetValueRef(field_id, field.sorted[i]);
+    if (i > 0 && CompareValues(GetValueRef(field_id, field.sorted[i - 1]), value) == 0) {
+      continue;
+    }
+    // null reads as the empty text, the same as the select callback of the reader
+    if (values.empty() || values.back() != value.text) {
+      values.emplace_back(value.text);
+    }
+  }
+  return values;
+}
+
+std::vector<uint64_t> ShardBinaryIndex::GetRowsByValue(int field_id, const std::string &value, uint64_t start_row_id,
+                                                       uint64_t end_row_id) const {
+  const auto &field = fields_[field_id];
+
+  // the value of the criteria takes the affinity of the column, number fields compare numerically
+  ValueRef key{IndexValueType::kText, 0, 0, std::string_view(value)};
+  if (field.is_number && !value.empty()) {
+    char *end = nullptr;
+    errno = 0;
+    long long integer = std::strtoll(value.c_str(), &end, 10);
+    if (errno == 0 && *end == '\0') {
+      key.type = IndexValueType::kInteger;
+      key.integer = static_cast<int64_t>(integer);
+    } else {
+      errno = 0;
+      double real = std::strtod(value.c_str(), &end);
+      if (errno == 0 && *end == '\0') {
+        key.type = IndexValueType::kReal;
+        key.real = real;
+      }
+    }
+  }
+
+  // positions of the rows with the value, ascending
+  auto first = std::lower_bound(field.sorted, field.sorted + num_rows_, key, [this, field_id](uint64_t pos, auto k) {
+    return CompareValues(GetValueRef(field_id, pos), k) < 0;
+  });
+  auto last = std::upper_bound(first, field.sorted + num_rows_, key, [this, field_id](auto k, uint64_t pos) {
+    return CompareValues(k, GetValueRef(field_id, pos)) < 0;
+  });
+
+  // positions of the rows in [start_row_id, end_row_id), rows are sorted by row id
+  auto by_row_id = [](const IndexRow &row, uint64_t row_id) { return row.row_id < row_id; };
+  uint64_t pos_begin = std::lower_bound(rows_, rows_ + num_rows_, start_row_id, by_row_id) - rows_;
+  uint64_t pos_end = std::lower_bound(rows_, rows_ + num_rows_, end_row_id, by_row_id) - rows_;
+
+  return std::vector<uint64_t>(std::lower_bound(first, last, pos_begin), std::lower_bound(first, last, pos_end));
+}
+}  // namespace mindrecord
+}  // namespace mindspore
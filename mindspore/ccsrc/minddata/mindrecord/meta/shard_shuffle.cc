@@ -20,12 +20,13 @@
 
 namespace mindspore {
 namespace mindrecord {
-ShardShuffle::ShardShuffle(uint32_t seed, ShuffleType shuffle_type)
+ShardShuffle::ShardShuffle(uint32_t seed, ShuffleType shuffle_type, int64_t block_size)
     : shuffle_seed_(seed),
       no_of_samples_(0),
       replacement_(false),
       reshuffle_each_epoch_(true),
-      shuffle_type_(shuffle_type) {}
+      shuffle_type_(shuffle_type),
+      block_size_(block_size) {}
 
 ShardShuffle::ShardShuffle(uint32_t seed, int64_t no_of_samples, bool replacement, bool reshuffle_each_epoch,
                            ShuffleType shuffle_type)
@@ -33,7 +34,8 @@ ShardShuffle::ShardShuffle(uint32_t seed, int64_t no_of_samples, bool replacemen
       no_of_samples_(no_of_samples),
       replacement_(replacement),
       reshuffle_each_epoch_(reshuffle_each_epoch),
-      shuffle_type_(shuffle_type) {}
+      shuffle_type_(shuffle_type),
+      block_size_(0) {}
 
 int64_t ShardShuffle::GetNumSamples(int64_t dataset_size, int64_t num_classes) {
   if (replacement_) {
@@ -42,12 +44,24 @@ int64_t ShardShuffle::GetNumSamples(int64_t dataset_size, int64_t num_classes) {
   return dataset_size;
 }
 
+void ShardShuffle::ShuffleBlocks(ShardTask &tasks) {
+  std::default_random_engine rnd(shuffle_seed_);
+  tasks.permutation_.resize(tasks.Size());
+  BlockShuffle(block_size_, &rnd, &tasks.permutation_);
+}
+
 MSRStatus ShardShuffle::Execute(ShardTask &tasks) {
   if (reshuffle_each_epoch_) shuffle_seed_++;
   if (tasks.categories < 1) {
     return FAILED;
   }
-  if (shuffle_type_ == kShuffleSample) {  // shuffle each sample
+  if (shuffle_type_ == kShuffleBlock) {
+    if (block_size_ <= 0) {
+      MS_LOG(ERROR) << "block size of shuffle need to be positive.";
+      return FAILED;
+    }
+    ShuffleBlocks(tasks);
+  } else if (shuffle_type_ == kShuffleSample) {  // shuffle each sample
     if (tasks.permutation_.empty() == true) {
       tasks.MakePerm();
     }
@@ -0,0 +1,616 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/jit/compile_cache.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iterator>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ir/graph_utils.h"
+#include "ir/tensor.h"
+#include "utils/hashing.h"
+#include "utils/ms_context.h"
+#include "utils/log_adapter.h"
+#include "debug/anf_ir_utils.h"
+#include "frontend/parallel/costmodel_context.h"
+#include "utils/load_onnx/anf_converter.h"
+#include "pipeline/jit/parse/resolve.h"
+#include "pipeline/jit/static_analysis/static_analysis.h"
+#include "pipeline/jit/parse/python_adapter.h"
+
+namespace mindspore {
+namespace pipeline {
+namespace {
+constexpr char kCompileCachePathEnv[] = "MS_COMPILE_CACHE_PATH";
+constexpr char kCompileCacheSizeEnv[] = "MS_COMPILE_CACHE_SIZE";
+constexpr uint64_t kDefaultCacheSizeMB = 1024;
+constexpr uint64_t kMBToByte = 1024 * 1024;
+constexpr char kCacheFileMagic[] = "MSCOMPILECACHE";
+constexpr char kCacheFileSuffix[] = ".mindir";
+// Changed when the key or the layout of the cache files changes
+constexpr int kCacheFormatVersion = 2;
+constexpr uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+uint64_t Fnv1a(const void *data, size_t size, uint64_t hash = kFnvOffsetBasis) {
+  auto bytes = static_cast<const uint8_t *>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ bytes[i]) * kFnvPrime;
+  }
+  return hash;
+}
+
+// Two independent 64 bits hashes of a sequence of strings
+class KeyHasher {
+ public:
+  void Update(const std::string &str) {
+    size_t size = str.size();
+    fnv_ = Fnv1a(&size, sizeof(size), fnv_);
+    fnv_ = Fnv1a(str.data(), size, fnv_);
+    std_ = hash_combine(std_, std::hash<std::string>{}(str));
+  }
+
+  std::string Digest() const {
+    std::ostringstream oss;
+    oss << std::hex << std::setfill('0') << std::setw(16) << fnv_ << std::setw(16) << static_cast<uint64_t>(std_);
+    return oss.str();
+  }
+
+ private:
+  uint64_t fnv_ = kFnvOffsetBasis;
+  std::size_t std_ = 0;
+};
+
+// Hash of the structure of a graph and of all the graphs it uses, independent of the node ids. The values are
+// hashed in full, so two graphs only differing by the data of a constant tensor get different hashes.
+class GraphHasher {
+ public:
+  explicit GraphHasher(KeyHasher *hasher) : hasher_(hasher) {}
+  ~GraphHasher() = default;
+
+  void Hash(const FuncGraphPtr &func_graph) {
+    (void)GraphIndex(func_graph);
+    // graphs_ grows while the graphs are hashed
+    for (size_t i = 0; i < graphs_.size(); ++i) {
+      HashGraph(graphs_[i]);
+    }
+  }
+
+ private:
+  size_t GraphIndex(const FuncGraphPtr &func_graph) {
+    auto iter = graph_indexes_.find(func_graph);
+    if (iter != graph_indexes_.end()) {
+      return iter->second;
+    }
+    graph_indexes_[func_graph] = graphs_.size();
+    graphs_.push_back(func_graph);
+    return graphs_.size() - 1;
+  }
+
+  void HashGraph(const FuncGraphPtr &func_graph) {
+    std::ostringstream oss;
+    oss << "graph ";
+    std::map<std::string, ValuePtr> attrs(func_graph->attrs().begin(), func_graph->attrs().end());
+    for (auto &attr : attrs) {
+      oss << attr.first << "=" << ValueText(attr.second) << " ";
+    }
+    hasher_->Update(oss.str());
+    for (auto &node : func_graph->parameters()) {
+      auto param = node->cast<ParameterPtr>();
+      MS_EXCEPTION_IF_NULL(param);
+      std::string text = "parameter " + param->name();
+      if (param->has_default()) {
+        // the data of the parameters does not change the compilation
+        auto tensor = param->default_param()->cast<tensor::TensorPtr>();
+        text += tensor == nullptr ? " " + param->default_param()->ToString() : " " + tensor->GetShapeAndDataTypeInfo();
+      }
+      hasher_->Update(text);
+    }
+
+    std::unordered_map<AnfNodePtr, size_t> indexes;
+    for (auto &node : TopoSort(func_graph->get_return(), SuccIncoming, AlwaysInclude)) {
+      indexes[node] = indexes.size();
+      hasher_->Update(NodeText(node, indexes));
+    }
+  }
+
+  std::string NodeText(const AnfNodePtr &node, const std::unordered_map<AnfNodePtr, size_t> &indexes) {
+    if (node->isa<ValueNode>()) {
+      return "value " + ValueText(node->cast<ValueNodePtr>()->value());
+    }
+    if (node->isa<Parameter>()) {
+      auto func_graph = node->func_graph();
+      MS_EXCEPTION_IF_NULL(func_graph);
+      const auto &params = func_graph->parameters();
+      auto position = std::find(params.begin(), params.end(), node) - params.begin();
+      return "parameter " + std::to_string(GraphIndex(func_graph)) + ":" + std::to_string(position);
+    }
+    auto cnode = node->cast<CNodePtr>();
+    MS_EXCEPTION_IF_NULL(cnode);
+    std::ostringstream oss;
+    oss << "cnode";
+    for (auto &input : cnode->inputs()) {
+      // the inputs are before the node in topological order
+      oss << " " << indexes.at(input);
+    }
+    return oss.str();
+  }
+
+  std::string ValueText(const ValuePtr &value) {
+    MS_EXCEPTION_IF_NULL(value);
+    if (value->isa<FuncGraph>()) {
+      return "graph " + std::to_string(GraphIndex(value->cast<FuncGraphPtr>()));
+    }
+    if (value->isa<Primitive>()) {
+      auto prim = value->cast<PrimitivePtr>();
+      std::map<std::string, ValuePtr> attrs(prim->attrs().begin(), prim->attrs().end());
+      std::string text = "primitive " + prim->name();
+      for (auto &attr : attrs) {
+        text += " " + attr.first + "=" + ValueText(attr.second);
+      }
+      return text;
+    }
+    if (value->isa<tensor::Tensor>()) {
+      auto tensor = value->cast<tensor::TensorPtr>();
+      std::ostringstream oss;
+      oss << "tensor " << tensor->GetShapeAndDataTypeInfo() << " " << std::hex
+          << Fnv1a(tensor->data_c(), tensor->data().nbytes());
+      return oss.str();
+    }
+    if (value->isa<ValueSequeue>()) {
+      std::string text = value->isa<ValueTuple>() ? "(" : "[";
+      for (auto &item : value->cast<ValueSequeuePtr>()->value()) {
+        text += ValueText(item) + ",";
+      }
+      return text + (value->isa<ValueTuple>() ? ")" : "]");
+    }
+    if (value->isa<parse::PyObjectWrapper>()) {
+      // the python objects kept after resolution are read by the type inference, e.g. the fields of a dataclass
+      auto obj = value->cast<std::shared_ptr<parse::PyObjectWrapper>>()->obj();
+      return value->ToString() + " " + py::str(obj).cast<std::string>();
+    }
+    return value->type_name() + " " + value->ToString();
+  }
+
+  KeyHasher *hasher_;
+  std::vector<FuncGraphPtr> graphs_;
+  std::unordered_map<FuncGraphPtr, size_t> graph_indexes_;
+};
+
+std::string GetVersion() {
+  try {
+    return py::str(parse::python_adapter::GetPyFn("mindspore", "__version__")).cast<std::string>();
+  } catch (const std::exception &e) {
+    MS_LOG(INFO) << "Get the version failed: " << e.what();
+    return "unknown";
+  }
+}
+
+std::string GetContextText() {
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  std::ostringstream oss;
+  oss << context->device_target() << " " << context->execution_mode() << " " << context->backend_policy() << " "
+      << context->enable_graph_kernel() << context->enable_sparse() << context->auto_mixed_precision_flag()
+      << context->enable_reduce_precision() << context->check_bprop_flag();
+  // combine_like_graphs only runs on a single graph
+  oss << " " << parallel::CostModelContext::GetInstance()->is_multi_subgraphs();
+  return oss.str();
+}
+
+// Convert a stored graph, nullptr if it cannot be parsed
+FuncGraphPtr ConvertGraph(const std::string &proto) {
+  if (proto.empty()) {
+    return nullptr;
+  }
+  try {
+    return lite::AnfConverter::RunAnfConverter(proto.data(), proto.size());
+  } catch (const std::exception &e) {
+    MS_LOG(INFO) << "Convert the stored graph failed: " << e.what();
+    return nullptr;
+  }
+}
+
+// Parameter of a stored graph
+struct CachedParameter {
+  std::string name;
+  bool has_default;
+};
+
+// Give the loaded parameters their names, and the ones with default value the value of the parameter with the same
+// name in the source graph. The abstracts are rebuilt as the type inference does, without the values set by the
+// loader.
+bool BindParameters(const FuncGraphPtr &func_graph, const std::vector<CachedParameter> &params,
+                    const FuncGraphPtr &source) {
+  const auto &loaded = func_graph->parameters();
+  if (loaded.size() != params.size()) {
+    MS_LOG(INFO) << "The number of parameters " << loaded.size() << " differs from the stored one " << params.size();
+    return false;
+  }
+  std::unordered_map<std::string, ParameterPtr> weights;
+  size_t inputs_num = 0;
+  for (auto &node : source->parameters()) {
+    auto param = node->cast<ParameterPtr>();
+    MS_EXCEPTION_IF_NULL(param);
+    if (param->has_default()) {
+      weights[param->name()] = param;
+    } else {
+      inputs_num++;
+    }
+  }
+  for (size_t i = 0; i < loaded.size(); ++i) {
+    auto param = loaded[i]->cast<ParameterPtr>();
+    MS_EXCEPTION_IF_NULL(param);
+    MS_EXCEPTION_IF_NULL(param->abstract());
+    param->set_name(params[i].name);
+    if (!params[i].has_default) {
+      param->set_abstract(param->abstract()->Broaden());
+      inputs_num--;
+      continue;
+    }
+    auto iter = weights.find(params[i].name);
+    if (iter == weights.end()) {
+      MS_LOG(INFO) << "The parameter " << params[i].name << " is not found.";
+      return false;
+    }
+    param->set_default_param(iter->second->default_param());
+    param->set_abstract(abstract::FromValue(param->default_param(), true));
+  }
+  if (inputs_num != 0) {
+    MS_LOG(INFO) << "The number of inputs differs from the stored one.";
+    return false;
+  }
+  for (auto &node : TopoSort(func_graph->get_return())) {
+    if (node->isa<CNode>() && node->abstract() != nullptr) {
+      node->set_abstract(node->abstract()->Broaden());
+    }
+  }
+  return true;
+}
+
+bool SameAbstract(AbstractBasePtr first, AbstractBasePtr second) {
+  if (first == nullptr || second == nullptr) {
+    return first == second;
+  }
+  if (first->isa<abstract::AbstractRef>()) {
+    first = first->cast<abstract::AbstractRefPtr>()->ref();
+  }
+  if (second->isa<abstract::AbstractRef>()) {
+    second = second->cast<abstract::AbstractRefPtr>()->ref();
+  }
+  return first->BuildType()->ToString() == second->BuildType()->ToString() &&
+         first->BuildShape()->ToString() == second->BuildShape()->ToString();
+}
+
+bool SameValue(const ValuePtr &first, const ValuePtr &second) {
+  if (first->isa<tensor::Tensor>() && second->isa<tensor::Tensor>()) {
+    return first->cast<tensor::TensorPtr>()->ValueEqual(*second->cast<tensor::TensorPtr>());
+  }
+  return *first == *second;
+}
+
+// Whether the loaded graph has the same nodes, primitives, values and abstracts as the original one. The loader
+// creates one value node per use, so the value nodes are compared by value.
+bool SameGraph(const FuncGraphPtr &original, const FuncGraphPtr &loaded) {
+  auto position = [](const FuncGraphPtr &func_graph, const AnfNodePtr &node) {
+    const auto &params = func_graph->parameters();
+    return std::find(params.begin(), params.end(), node) - params.begin();
+  };
+  std::unordered_map<AnfNodePtr, AnfNodePtr> pairs;
+  std::vector<std::pair<AnfNodePtr, AnfNodePtr>> todo = {{original->output(), loaded->output()}};
+  while (!todo.empty()) {
+    auto first = todo.back().first;
+    auto second = todo.back().second;
+    todo.pop_back();
+    if (first == nullptr || second == nullptr) {
+      return false;
+    }
+    if (first->isa<ValueNode>()) {
+      if (!second->isa<ValueNode>() ||
+          !SameValue(first->cast<ValueNodePtr>()->value(), second->cast<ValueNodePtr>()->value())) {
+        return false;
+      }
+      continue;
+    }
+    auto iter = pairs.find(first);
+    if (iter != pairs.end()) {
+      if (iter->second != second) {
+        return false;
+      }
+      continue;
+    }
+    pairs[first] = second;
+    if (!SameAbstract(first->abstract(), second->abstract())) {
+      return false;
+    }
+    if (first->isa<Parameter>()) {
+      if (!second->isa<Parameter>() || position(original, first) != position(loaded, second)) {
+        return false;
+      }
+      continue;
+    }
+    auto first_cnode = first->cast<CNodePtr>();
+    auto second_cnode = second->cast<CNodePtr>();
+    if (first_cnode == nullptr || second_cnode == nullptr || first_cnode->size() != second_cnode->size()) {
+      return false;
+    }
+    for (size_t i = 0; i < first_cnode->size(); ++i) {
+      todo.emplace_back(first_cnode->input(i), second_cnode->input(i));
+    }
+  }
+  return true;
+}
+
+// The graphs which the MindIR format may represent: a single graph with flags only and builtin primitives
+bool CanStore(const FuncGraphPtr &func_graph) {
+  if (!func_graph->func_graphs_used_total().empty()) {
+    MS_LOG(INFO) << "The graph uses other graphs.";
+    return false;
+  }
+  for (auto &attr : func_graph->attrs()) {
+    if (!attr.second->isa<BoolImm>()) {
+      MS_LOG(INFO) << "The graph attribute " << attr.first << " is not a flag.";
+      return false;
+    }
+  }
+  auto nodes = TopoSort(func_graph->get_return());
+  return std::none_of(nodes.begin(), nodes.end(), [](const AnfNodePtr &node) {
+    auto prim = GetValueNode<PrimitivePtr>(node);
+    return prim != nullptr && prim->prim_type() == kPrimTypeUserCustom;
+  });
+}
+}  // namespace
+
+CompileCache &CompileCache::GetInstance() {
+  static CompileCache instance;
+  return instance;
+}
+
+CompileCache::CompileCache() {
+  const char *path = getenv(kCompileCachePathEnv);
+  if (path == nullptr || *path == '\0') {
+    return;
+  }
+  uint64_t max_size_mb = kDefaultCacheSizeMB;
+  const char *size = getenv(kCompileCacheSizeEnv);
+  if (size != nullptr && *size != '\0') {
+    char *end = nullptr;
+    auto value = strtoull(size, &end, 10);
+    if (*end == '\0' && value > 0) {
+      max_size_mb = value;
+    } else {
+      MS_LOG(WARNING) << "The compile cache size " << size << " is not valid, use " << kDefaultCacheSizeMB << " MB.";
+    }
+  }
+  Init(path, max_size_mb * kMBToByte);
+}
+
+void CompileCache::Init(const std::string &path, uint64_t max_size) {
+  path_.clear();
+  max_size_ = max_size;
+  if (path.empty()) {
+    return;
+  }
+#if defined(_WIN32) || defined(_WIN64)
+  (void)mkdir(path.c_str());
+#else
+  (void)mkdir(path.c_str(), S_IRWXU);
+#endif
+  char real_path[PATH_MAX] = {0};
+  if (realpath(path.c_str(), real_path) == nullptr) {
+    MS_LOG(WARNING) << "The compile cache path " << path << " is not valid, the compile cache is disabled.";
+    return;
+  }
+  path_ = real_path;
+  MS_LOG(INFO) << "Compile cache path: " << path_ << ", maximal size: " << max_size_ << " bytes";
+}
+
+std::string CompileCache::GetFilePath(const std::string &key) const { return path_ + "/" + key + kCacheFileSuffix; }
+
+std::string CompileCache::GetKey(const FuncGraphPtr &func_graph, const abstract::AbstractBasePtrList &args_spec) const {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  KeyHasher hasher;
+  hasher.Update(std::to_string(kCacheFormatVersion));
+  hasher.Update(GetVersion());
+  hasher.Update(GetContextText());
+  for (auto &arg : args_spec) {
+    MS_EXCEPTION_IF_NULL(arg);
+    hasher.Update(arg->ToString());
+  }
+  GraphHasher(&hasher).Hash(func_graph);
+  return hasher.Digest();
+}
+
+FuncGraphPtr CompileCache::Load(const std::string &key, const FuncGraphPtr &func_graph) const {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  std::ifstream ifs(GetFilePath(key), std::ios::in | std::ios::binary);
+  if (!ifs.is_open()) {
+    MS_LOG(INFO) << "Compile cache miss: " << key;
+    return nullptr;
+  }
+  std::string magic;
+  int version = 0;
+  size_t proto_size = 0;
+  uint64_t proto_hash = 0;
+  size_t params_num = 0;
+  ifs >> magic >> version >> proto_size >> std::hex >> proto_hash >> std::dec >> params_num;
+  if (!ifs.good() || magic != kCacheFileMagic || version != kCacheFormatVersion) {
+    MS_LOG(WARNING) << "The compile cache file of " << key << " is not valid.";
+    return nullptr;
+  }
+  // the numbers are not trusted before the graph is checked, the items are read while the file has some
+  std::vector<CachedParameter> params;
+  for (size_t i = 0; i < params_num && ifs.good(); ++i) {
+    CachedParameter param;
+    ifs >> param.has_default >> param.name;
+    params.push_back(param);
+  }
+  size_t flags_num = 0;
+  ifs >> flags_num;
+  std::vector<std::pair<std::string, bool>> flags;
+  for (size_t i = 0; i < flags_num && ifs.good(); ++i) {
+    std::pair<std::string, bool> flag;
+    ifs >> flag.first >> flag.second;
+    flags.push_back(flag);
+  }
+  // the graph follows the newline ending the header
+  (void)ifs.get();
+  if (!ifs.good()) {
+    MS_LOG(WARNING) << "The compile cache file of " << key << " is not valid.";
+    return nullptr;
+  }
+  std::string proto((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+  if (proto.size() != proto_size || Fnv1a(proto.data(), proto.size()) != proto_hash) {
+    MS_LOG(WARNING) << "The graph in the compile cache file of " << key << " is corrupted.";
+    return nullptr;
+  }
+
+  auto graph = ConvertGraph(proto);
+  if (graph == nullptr || !BindParameters(graph, params, func_graph)) {
+    MS_LOG(WARNING) << "Load the compile cache of " << key << " failed.";
+    return nullptr;
+  }
+  for (auto &flag : flags) {
+    graph->set_flag(flag.first, flag.second);
+  }
+  // the graphs used last are evicted last
+  (void)utime(GetFilePath(key).c_str(), nullptr);
+  MS_LOG(INFO) << "Compile cache hit: " << key;
+  return graph;
+}
+
+void CompileCache::Store(const std::string &key, const FuncGraphPtr &func_graph) const {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  if (!CanStore(func_graph)) {
+    MS_LOG(INFO) << "The graph of " << key << " is not stored in the compile cache.";
+    return;
+  }
+  std::string proto;
+  try {
+    proto = GetBinaryProtoString(func_graph, false);
+  } catch (const std::exception &e) {
+    MS_LOG(INFO) << "The graph of " << key << " is not stored in the compile cache: " << e.what();
+    return;
+  }
+  std::vector<CachedParameter> params;
+  for (auto &node : func_graph->parameters()) {
+    auto param = node->cast<ParameterPtr>();
+    MS_EXCEPTION_IF_NULL(param);
+    if (param->name().empty() || param->name().find_first_of(" \t\r\n") != std::string::npos) {
+      MS_LOG(INFO) << "The graph of " << key << " is not stored in the compile cache, parameter name: "
+                   << param->name();
+      return;
+    }
+    params.push_back({param->name(), param->has_default()});
+  }
+  // check the round trip before storing, the loader does not support every graph
+  auto loaded = ConvertGraph(proto);
+  if (loaded == nullptr || !BindParameters(loaded, params, func_graph) || !SameGraph(func_graph, loaded)) {
+    MS_LOG(INFO) << "The graph of " << key << " is not restored exactly, it is not stored in the compile cache.";
+    return;
+  }
+
+  // write to a temporary file then rename it, so that processes sharing the cache never read a partial file
+  std::string file_path = GetFilePath(key);
+  std::string tmp_path = file_path + "." + std::to_string(getpid()) + ".tmp";
+  {
+    std::ofstream ofs(tmp_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) {
+      MS_LOG(WARNING) << "Open the compile cache file " << tmp_path << " failed.";
+      return;
+    }
+    ofs << kCacheFileMagic << " " << kCacheFormatVersion << " " << proto.size() << " " << std::hex
+        << Fnv1a(proto.data(), proto.size()) << std::dec << " " << params.size() << "\n";
+    for (auto &param : params) {
+      ofs << param.has_default << " " << param.name << "\n";
+    }
+    ofs << func_graph->attrs().size() << "\n";
+    for (auto &attr : func_graph->attrs()) {
+      ofs << attr.first << " " << GetValue<bool>(attr.second) << "\n";
+    }
+    ofs.write(proto.data(), static_cast<std::streamsize>(proto.size()));
+    if (!ofs.good()) {
+      MS_LOG(WARNING) << "Write the compile cache file " << tmp_path << " failed.";
+      ofs.close();
+      (void)remove(tmp_path.c_str());
+      return;
+    }
+  }
+  if (rename(tmp_path.c_str(), file_path.c_str()) != 0) {
+    MS_LOG(WARNING) << "Rename the compile cache file " << tmp_path << " failed.";
+    (void)remove(tmp_path.c_str());
+    return;
+  }
+  MS_LOG(INFO) << "Store the compile cache of " << key;
+  Evict(file_path);
+}
+
+void CompileCache::Evict(const std::string &keep) const {
+  DIR *dir = opendir(path_.c_str());
+  if (dir == nullptr) {
+    return;
+  }
+  // the files of the graphs ordered by last use
+  std::vector<std::pair<time_t, std::string>> files;
+  uint64_t total_size = 0;
+  const std::string suffix = kCacheFileSuffix;
+  struct dirent *entry;
+  while ((entry = readdir(dir)) != nullptr) {
+    std::string name = entry->d_name;
+    if (name.size() <= suffix.size() || name.compare(name.size() - suffix.size(), suffix.size(), suffix) != 0) {
+      continue;
+    }
+    std::string file_path = path_ + "/" + name;
+    struct stat file_stat;
+    if (stat(file_path.c_str(), &file_stat) != 0) {
+      continue;
+    }
+    total_size += static_cast<uint64_t>(file_stat.st_size);
+    if (file_path != keep) {
+      files.emplace_back(file_stat.st_mtime, file_path);
+    }
+  }
+  (void)closedir(dir);
+  std::sort(files.begin(), files.end());
+  for (auto &file : files) {
+    if (total_size <= max_size_) {
+      break;
+    }
+    struct stat file_stat;
+    if (stat(file.second.c_str(), &file_stat) != 0 || remove(file.second.c_str()) != 0) {
+      continue;
+    }
+    total_size -= std::min(total_size, static_cast<uint64_t>(file_stat.st_size));
+    MS_LOG(INFO) << "Remove the compile cache file " << file.second;
+  }
+}
+}  // namespace pipeline
+}  // namespace mindspore
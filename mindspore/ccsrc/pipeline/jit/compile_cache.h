@@ -0,0 +1,78 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
+#define MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
+
+#include <cstdint>
+#include <string>
+
+#include "ir/func_graph.h"
+#include "abstract/abstract_value.h"
+
+namespace mindspore {
+namespace pipeline {
+// Persistent cache of the graphs compiled in graph mode, enabled by setting MS_COMPILE_CACHE_PATH to a directory.
+// A compilation is keyed by the graph after symbol resolution, the abstracts of the arguments, the context flags
+// which change the compilation and the version. The graph after the validate stage is stored in MindIR format, so a
+// process compiling the same network again loads it and goes on with the task emission, skipping type inference and
+// optimization. Only the graphs restored exactly by the MindIR loader are stored: a single graph whose nodes,
+// primitives and abstracts survive the round trip. The data of the parameters with default value is not stored,
+// they are bound by name to the parameters of the network when the graph is loaded. The size of the cache is bounded
+// by MS_COMPILE_CACHE_SIZE in MB, the least recently used graphs are removed when a graph is stored.
+class CompileCache {
+ public:
+  static CompileCache &GetInstance();
+
+  ~CompileCache() = default;
+
+  // Set the directory of the cache, the cache is disabled if it is empty
+  // @param path - directory of the cache, created if it does not exist
+  // @param max_size - maximal size in bytes of the graphs stored in the directory
+  void Init(const std::string &path, uint64_t max_size);
+
+  bool enabled() const { return !path_.empty(); }
+
+  // @param func_graph - graph after symbol resolution
+  // @param args_spec - abstracts of the arguments
+  // @return the key of the compilation
+  std::string GetKey(const FuncGraphPtr &func_graph, const abstract::AbstractBasePtrList &args_spec) const;
+
+  // @param key - key of the compilation
+  // @param func_graph - graph after symbol resolution, its parameters with default value are bound to the loaded graph
+  // @return the graph stored for the key, nullptr if there is none or it cannot be restored
+  FuncGraphPtr Load(const std::string &key, const FuncGraphPtr &func_graph) const;
+
+  // Store a graph after the validate stage, nothing is stored if it cannot be restored exactly
+  // @param key - key of the compilation
+  // @param func_graph - graph to store
+  void Store(const std::string &key, const FuncGraphPtr &func_graph) const;
+
+ private:
+  CompileCache();
+
+  std::string GetFilePath(const std::string &key) const;
+
+  // Remove the least recently used graphs until the cache fits in its maximal size, the file kept is never removed
+  void Evict(const std::string &keep) const;
+
+  std::string path_;
+  uint64_t max_size_ = 0;
+};
+}  // namespace pipeline
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_PIPELINE_JIT_COMPILE_CACHE_H_
@@ -26,6 +26,7 @@
 
 #include "ir/param_info.h"
 #include "pipeline/jit/pass.h"
+#include "pipeline/jit/compile_cache.h"
 #include "pipeline/jit/parse/data_converter.h"
 #include "frontend/optimizer/ad/dfunctor.h"
 #include "debug/anf_ir_dump.h"
@@ -617,14 +618,68 @@ void RunPipelineAction(const ActionItem &action, pipeline::ResourcePtr resource,
 }
 #endif
 
+// The compile cache replaces the stages from symbol resolution to validation, and the graph goes on to task emission
+static bool UseCompileCache(const std::vector<ActionItem> &actions) {
+  if (!CompileCache::GetInstance().enabled()) {
+    return false;
+  }
+  if (parallel::ParallelContext::GetInstance()->parallel_mode() != parallel::STAND_ALONE) {
+    return false;
+  }
+  // the python passes are not part of the key, they run in the stages replaced by the cache
+  auto py_pass_manager = opt::python_pass::PyPassManager::GetInstance();
+  for (auto phase : {opt::python_pass::Phase::RESOLVE, opt::python_pass::Phase::OPT}) {
+    if (!py_pass_manager->GetPassGroup(phase)->passes().empty()) {
+      MS_LOG(INFO) << "The compile cache is disabled since some python passes are registered.";
+      return false;
+    }
+  }
+#if (ENABLE_CPU && (ENABLE_D || ENABLE_GPU))
+  if (mindspore::parallel::ps::Util::IsParamServerMode()) {
+    return false;
+  }
+#endif
+  auto has_action = [&actions](const std::string &name) {
+    return std::any_of(actions.begin(), actions.end(), [&name](const ActionItem &item) { return item.first == name; });
+  };
+  return has_action("symbol_resolve") && has_action("validate") && has_action("task_emit");
+}
+
+// Load the graph compiled before for the resolved graph, its key is returned to store the graph on a cache miss
+static bool LoadCompileCache(const ResourcePtr &resource, std::string *key) {
+  MS_EXCEPTION_IF_NULL(resource);
+  auto func_graph = resource->func_graph();
+  MS_EXCEPTION_IF_NULL(func_graph);
+  auto &cache = CompileCache::GetInstance();
+  *key = cache.GetKey(func_graph, resource->args_spec());
+  auto graph = cache.Load(*key, func_graph);
+  if (graph == nullptr) {
+    return false;
+  }
+  auto manager = resource->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  manager->KeepRoots({graph});
+  resource->set_func_graph(graph);
+  return true;
+}
+
 void Pipeline::Run() {
   MS_LOG(INFO) << "Pipeline run";
   MS_EXCEPTION_IF_NULL(resource_);
   FuncGraphPtr user_graph = nullptr;
+  bool use_compile_cache = UseCompileCache(actions_);
 
-  WITH(MsProfile::GetProfile())[&user_graph, this]() {
+  WITH(MsProfile::GetProfile())[&user_graph, use_compile_cache, this]() {
     int i = 0;
+    std::string cache_key;
+    bool cache_hit = false;
     for (auto &action : actions_) {
+      if (cache_hit) {
+        // the stages up to validate are done by the cached graph
+        cache_hit = action.first != "validate";
+        i++;
+        continue;
+      }
 #ifdef ENABLE_TIMELINE
       DumpTime &dump_time = DumpTime::GetInstance();
       dump_time.Record(action.first, GetTime(), true);
@@ -642,6 +697,11 @@ void Pipeline::Run() {
       if (!result) {
         MS_LOG(EXCEPTION) << "Pipeline running to end, failed in step:" << action.first;
       }
+      if (use_compile_cache && action.first == "symbol_resolve") {
+        cache_hit = LoadCompileCache(resource_, &cache_key);
+      } else if (use_compile_cache && action.first == "validate" && !cache_key.empty()) {
+        CompileCache::GetInstance().Store(cache_key, resource_->func_graph());
+      }
       if (MsContext::GetInstance()->save_graphs_flag() && resource_->func_graph() != nullptr) {
         auto graph = resource_->func_graph();
         if (graph != nullptr) {
@@ -70,8 +70,8 @@ class IrExporter {
 
 class IrExportBuilder {
  public:
-  IrExportBuilder() = default;
-  ~IrExportBuilder() { google::protobuf::ShutdownProtobufLibrary(); }
+  explicit IrExportBuilder(bool export_param_data = true) : export_param_data_(export_param_data) {}
+  ~IrExportBuilder() = default;
   std::string GetProtoString(const FuncGraphPtr &func_graph);
   void BuildModelInfo();
   void BuildModel(const FuncGraphPtr &func_graph);
@@ -114,6 +114,8 @@ class IrExportBuilder {
   std::list<FuncGraphPtr> todo_;
   std::map<AnfNodePtr, size_t> node_index_map_;
   size_t node_index_{0};
+  // whether the data of the parameters with default value is exported, their shapes are always exported
+  bool export_param_data_;
 };
 
 using IrExporterPtr = std::shared_ptr<IrExporter>;
@@ -186,7 +188,7 @@ void IrExportBuilder::BuildParameters(const FuncGraphPtr &func_graph, onnx::Grap
     initializer_proto->set_name(param_name);
     SetParamToTensorProto(param, initializer_proto);
     auto tensor = std::dynamic_pointer_cast<tensor::Tensor>(param->default_param());
-    if (tensor) {
+    if (tensor && export_param_data_) {
       initializer_proto->set_raw_data(tensor->data_c(), tensor->data().nbytes());
     }
   }
@@ -355,12 +357,33 @@ void IrExportBuilder::SetShapeToNodeProto(const TypePtr &type, const BaseShapePt
   SetTensorProto(type, shape, tensor_proto);
 }
 
+// Whether the output of a cnode is a tuple of at least two tensors
+static bool IsTensorTuple(const CNodePtr &node) {
+  auto type = node->Type();
+  auto shape = node->Shape();
+  if (type == nullptr || shape == nullptr || !type->isa<Tuple>() || !shape->isa<abstract::TupleShape>()) {
+    return false;
+  }
+  const auto &elements = type->cast<TuplePtr>()->elements();
+  const auto &tuple_shape = shape->cast<abstract::TupleShapePtr>()->shape();
+  if (elements.size() < 2 || elements.size() != tuple_shape.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < elements.size(); i++) {
+    if (!elements[i]->isa<TensorType>() || !tuple_shape[i]->isa<abstract::Shape>()) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void IrExportBuilder::SetShapeToNodeProto(const CNodePtr &node, onnx::NodeProto *const node_proto) {
   // Get shape of cnode
   // 1. prim ArgMaxWithValue need to get shape from tuple element
   // 2. some cnode doesn't has shape, such as LayerNorm
-  // 3. other cnodes have shape
-  if (node->IsApply(prim::kPrimArgMaxWithValue) || node->IsApply(prim::kPrimLayerNorm)) {
+  // 3. cnodes with several tensor outputs get one shape per tuple element
+  // 4. other cnodes have shape
+  if (node->IsApply(prim::kPrimArgMaxWithValue) || node->IsApply(prim::kPrimLayerNorm) || IsTensorTuple(node)) {
     auto type = node->Type();
     auto shape = node->Shape();
     if (!type->isa<Tuple>()) {
@@ -601,8 +624,8 @@ void IrExportBuilder::SetSequenceToAttributeProto(const ValueSequeuePtr &value,
   }
 }
 
-std::string GetBinaryProtoString(const FuncGraphPtr &func_graph) {
-  auto builder = std::make_shared<IrExportBuilder>();
+std::string GetBinaryProtoString(const FuncGraphPtr &func_graph, bool export_param_data) {
+  auto builder = std::make_shared<IrExportBuilder>(export_param_data);
   if (builder == nullptr) {
     MS_LOG(ERROR) << "Create ir exporter failed!";
     return "";
@@ -15,10 +15,14 @@
  */
 
 #include "utils/load_onnx/anf_model_parser.h"
+#include <algorithm>
+#include <cctype>
 #include <functional>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 #include "ir/tensor.h"
 #include "ir/param_info.h"
@@ -33,8 +37,6 @@ namespace mindspore {
 namespace lite {
 static constexpr char kConstantValueNode[] = "Constant";
 static constexpr char kCNodeShapeAttr[] = "shape";
-static constexpr char kCNodeShape1Attr[] = "shape1";
-static constexpr char kCNodeShape2Attr[] = "shape2";
 enum ParseForm : int {
   FORM_PARSE_TYPE = 0,
   FORM_PARSE_SCALAR = 1,
@@ -368,6 +370,23 @@ AbstractBasePtr MSANFModelParser::GetAbstractForCNode(const onnx::AttributeProto
   return abstract;
 }
 
+// The output shapes of a cnode are the attributes shape, shape1, shape2..., one per tuple element
+static bool GetShapeAttrIndex(const std::string &attr_name, size_t *index) {
+  const size_t prefix_size = sizeof(kCNodeShapeAttr) - 1;
+  if (attr_name.compare(0, prefix_size, kCNodeShapeAttr) != 0) {
+    return false;
+  }
+  if (attr_name.size() == prefix_size) {
+    *index = 0;
+    return true;
+  }
+  if (!std::all_of(attr_name.begin() + prefix_size, attr_name.end(), [](char c) { return std::isdigit(c) != 0; })) {
+    return false;
+  }
+  *index = std::stoul(attr_name.substr(prefix_size));
+  return *index > 0;
+}
+
 CNodePtr MSANFModelParser::BuildCNodeForFuncGraph(const FuncGraphPtr &outputFuncGraph,
                                                   const onnx::NodeProto &node_proto) {
   MS_EXCEPTION_IF_NULL(outputFuncGraph);
@@ -382,21 +401,12 @@ CNodePtr MSANFModelParser::BuildCNodeForFuncGraph(const FuncGraphPtr &outputFunc
   MS_EXCEPTION_IF_NULL(prim);
   prim->set_instance_name(node_type);
 
-  AbstractBasePtr abstract = nullptr;
-  AbstractBasePtr abstract_first = nullptr;
-  AbstractBasePtr abstract_second = nullptr;
+  std::map<size_t, AbstractBasePtr> output_abstracts;
   for (int i = 0; i < node_proto.attribute_size(); ++i) {
     const onnx::AttributeProto &attr_proto = node_proto.attribute(i);
-    if (attr_proto.name() == kCNodeShapeAttr) {
-      abstract = GetAbstractForCNode(attr_proto);
-      continue;
-    }
-    if (attr_proto.name() == kCNodeShape1Attr) {
-      abstract_first = GetAbstractForCNode(attr_proto);
-      continue;
-    }
-    if (attr_proto.name() == kCNodeShape2Attr) {
-      abstract_second = GetAbstractForCNode(attr_proto);
+    size_t output_index = 0;
+    if (GetShapeAttrIndex(attr_proto.name(), &output_index)) {
+      output_abstracts[output_index] = GetAbstractForCNode(attr_proto);
       continue;
     }
     if (!GetAttrValueForCNode(prim, attr_proto)) {
@@ -418,25 +428,19 @@ CNodePtr MSANFModelParser::BuildCNodeForFuncGraph(const FuncGraphPtr &outputFunc
   }
   CNodePtr cnode_ptr = outputFuncGraph->NewCNode(inputs);
   MS_EXCEPTION_IF_NULL(cnode_ptr);
-  if (node_type == "LayerNorm") {
-    AbstractBasePtrList elem;
-    elem.push_back(abstract);
-    elem.push_back(abstract_first);
-    elem.push_back(abstract_second);
-    cnode_ptr->set_abstract(std::make_shared<abstract::AbstractTuple>(elem));
-  } else if (node_type == "ArgMaxWithValue") {
+  if (output_abstracts.size() > 1) {
     AbstractBasePtrList elem;
-    elem.push_back(abstract);
-    elem.push_back(abstract_first);
+    (void)std::transform(output_abstracts.begin(), output_abstracts.end(), std::back_inserter(elem),
+                         [](const std::pair<const size_t, AbstractBasePtr> &item) { return item.second; });
     cnode_ptr->set_abstract(std::make_shared<abstract::AbstractTuple>(elem));
-  } else if (nullptr == abstract) {
+  } else if (output_abstracts.empty()) {
     AbstractBasePtrList elem;
     for (size_t index = 1; index < cnode_ptr->inputs().size(); ++index) {
       elem.push_back(cnode_ptr->input(index)->abstract());
     }
     cnode_ptr->set_abstract(std::make_shared<abstract::AbstractTuple>(elem));
   } else {
-    cnode_ptr->set_abstract(abstract);
+    cnode_ptr->set_abstract(output_abstracts.begin()->second);
   }
   cnode_ptr->set_fullname_with_scope(fullname_with_scope);
   anfnode_build_map_[node_name] = cnode_ptr;
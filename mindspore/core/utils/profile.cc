@@ -356,6 +356,13 @@ void MsProfile::Print() {
     std::string prefix = (i < items.size() ? items[i] : std::string("others."));
     PrintTimeStat(oss, groups[i], prefix);
   }
+  const auto &count_stat = GetSingleton().count_stat_;
+  if (!count_stat.empty()) {
+    oss << "------[counts]\n";
+    for (const auto &iter : count_stat) {
+      oss << std::setw(12) << iter.second << ": " << iter.first << "\n";
+    }
+  }
   std::string text = oss.str();
   // here use printf to output profile info, not use MS_LOG(INFO) since when open log, it affects performace
   (void)printf("\nTime group info:\n%s", text.c_str());
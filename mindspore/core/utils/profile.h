@@ -199,6 +199,8 @@ class MsProfile {
     return ms_prof.profile_;
   }
   static void StatTime(const std::string &id, double time) { GetSingleton().time_stat_[id] += time; }
+  // record a number of events without time, e.g. the nodes visited by a pass, kept apart from the time groups
+  static void StatCount(const std::string &id, size_t count) { GetSingleton().count_stat_[id] += count; }
 
   static void Print();
 
@@ -212,6 +214,7 @@ class MsProfile {
 
   void Clear() {
     time_stat_.clear();
+    count_stat_.clear();
     if (profile_ != nullptr) {
       delete profile_;
       profile_ = nullptr;
@@ -219,6 +222,7 @@ class MsProfile {
   }
 
   std::map<std::string, TimeStat> time_stat_;  // record time and count info from some activity
+  std::map<std::string, size_t> count_stat_;   // record count info of events without time
   ProfileBase *profile_ = nullptr;             // record hierarchical profile info
 };
 }  // namespace mindspore
@@ -20,7 +20,9 @@ import numpy
 import mindspore._c_dataengine as cde
 
 __all__ = ['set_seed', 'get_seed', 'set_prefetch_size', 'get_prefetch_size', 'set_num_parallel_workers',
-           'get_num_parallel_workers', 'set_monitor_sampling_interval', 'get_monitor_sampling_interval', 'load']
+           'get_num_parallel_workers', 'set_monitor_sampling_interval', 'get_monitor_sampling_interval',
+           'set_enable_autotune', 'get_enable_autotune', 'set_autotune_steps', 'get_autotune_steps',
+           'set_out_of_order', 'get_out_of_order', 'set_reorder_window', 'get_reorder_window', 'load']
 
 INT32_MAX = 2147483647
 UINT32_MAX = 4294967295
@@ -157,6 +159,135 @@ def get_monitor_sampling_interval():
     return _config.get_monitor_sampling_interval()
 
 
+def set_enable_autotune(enable):
+    """
+    Set whether the pipeline is tuned while it is running.
+
+    When enabled, the performance monitor watches the output queue of every operator during the first steps,
+    raises the number of active workers of the operator which is the bottleneck of the pipeline and enlarges the
+    queues which are bursty, until the queue feeding the device stays full. The tuned settings are logged.
+
+    Args:
+        enable (bool): whether to enable pipeline autotuning.
+
+    Raises:
+        TypeError: If enable is not a boolean.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> # tune num_parallel_workers and queue sizes during the first steps of the next run.
+        >>> ds.config.set_enable_autotune(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable must be of type bool.")
+    _config.set_enable_autotune(enable)
+
+
+def get_enable_autotune():
+    """
+    Get whether the pipeline is tuned while it is running.
+
+    Returns:
+        Bool, whether pipeline autotuning is enabled.
+    """
+    return _config.get_enable_autotune()
+
+
+def set_autotune_steps(steps):
+    """
+    Set the number of steps at the beginning of the run during which the pipeline is tuned.
+
+    Args:
+        steps (int): number of batches fed to the device (or the iterator) before tuning stops.
+
+    Raises:
+        ValueError: If steps is invalid (<= 0 or > MAX_INT_32).
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> ds.config.set_autotune_steps(500)
+    """
+    if steps <= 0 or steps > INT32_MAX:
+        raise ValueError("Steps given is not within the required range.")
+    _config.set_autotune_steps(steps)
+
+
+def get_autotune_steps():
+    """
+    Get the number of steps during which the pipeline is tuned.
+
+    Returns:
+        Int, number of steps.
+    """
+    return _config.get_autotune_steps()
+
+
+def set_out_of_order(out_of_order):
+    """
+    Set whether the parallel operators of pipelines created from now on may output their data out of order.
+
+    By default the outputs of the workers of a parallel operator are handed out in a fixed round robin order, so one
+    slow sample blocks the samples other workers already finished. Out of order, the next operator takes whichever
+    output is ready first, bounded by the reorder window. Epoch boundaries are kept, but the order of the samples
+    within an epoch is no longer deterministic.
+
+    Args:
+        out_of_order (bool): whether the parallel operators may output out of order.
+
+    Raises:
+        TypeError: If out_of_order is not a boolean.
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> ds.config.set_out_of_order(True)
+    """
+    if not isinstance(out_of_order, bool):
+        raise TypeError("out_of_order must be of type bool.")
+    _config.set_out_of_order(out_of_order)
+
+
+def get_out_of_order():
+    """
+    Get whether the parallel operators of new pipelines may output their data out of order.
+
+    Returns:
+        Bool, whether new pipelines run out of order.
+    """
+    return _config.get_out_of_order()
+
+
+def set_reorder_window(window):
+    """
+    Set the reorder window of pipelines running out of order.
+
+    An output can be overtaken by at most window - 1 outputs which follow it in the deterministic order. A window of
+    1 gives the deterministic order back.
+
+    Args:
+        window (int): size of the reorder window.
+
+    Raises:
+        ValueError: If window is invalid (<= 0 or > MAX_INT_32).
+
+    Examples:
+        >>> import mindspore.dataset as ds
+        >>> ds.config.set_reorder_window(32)
+    """
+    if window <= 0 or window > INT32_MAX:
+        raise ValueError("Window given is not within the required range.")
+    _config.set_reorder_window(window)
+
+
+def get_reorder_window():
+    """
+    Get the reorder window of pipelines running out of order.
+
+    Returns:
+        Int, size of the reorder window.
+    """
+    return _config.get_reorder_window()
+
+
 def __str__():
     """
     String representation of the configurations.
@@ -189,7 +320,11 @@ def load(file):
         >>> #     "workerConnectorSize": 16,
         >>> #     "opConnectorSize": 16,
         >>> #     "seed": 5489,
-        >>> #     "monitorSamplingInterval": 30
+        >>> #     "monitorSamplingInterval": 30,
+        >>> #     "enableAutoTune": false,
+        >>> #     "autoTuneSteps": 1000,
+        >>> #     "outOfOrder": false,
+        >>> #     "reorderWindow": 16
         >>> # }
     """
     _config.load(file)
@@ -20,24 +20,46 @@ from mindspore._c_dataengine import CacheClient
 
 from ..core.validator_helpers import type_check, check_uint32, check_uint64
 
+EVICTION_POLICIES = {None: 0, "lru": 1, "lfu": 2}
+
 class DatasetCache:
     """
     A client to interface with tensor caching service
+
+    Args:
+        session_id (int): A user assigned session id for the current pipeline.
+        size (int, optional): Size of the memory set aside for the row caching in MB. 0 for unlimited (default=0).
+        spilling (bool, optional): Spill to disk if out of memory (default=False).
+        port (int, optional): Port of the cache server (default=50052).
+        prefetch_size (int, optional): Number of rows to prefetch from the cache server (default=20).
+        eviction_policy (str, optional): Which rows to move out of memory when the memory is full, 'lru' or 'lfu'.
+            The rows are spilled to disk if spilling is True, otherwise they are dropped and read again from the
+            dataset on the next cache miss. None means new rows are spilled or rejected instead (default=None).
+        compress (bool, optional): Compress the rows cached by the server (default=False).
     """
 
-    def __init__(self, session_id=None, size=0, spilling=False, port=50052, prefetch_size=20):
+    def __init__(self, session_id=None, size=0, spilling=False, port=50052, prefetch_size=20, eviction_policy=None,
+                 compress=False):
         check_uint32(session_id, "session_id")
         check_uint64(size, "size")
         type_check(spilling, (bool,), "spilling")
         check_uint32(port, "port")
         check_uint32(prefetch_size, "prefetch size")
+        if eviction_policy is not None:
+            type_check(eviction_policy, (str,), "eviction_policy")
+        if eviction_policy not in EVICTION_POLICIES:
+            raise ValueError("eviction_policy should be 'lru', 'lfu' or None.")
+        type_check(compress, (bool,), "compress")
 
         self.session_id = session_id
         self.size = size
         self.spilling = spilling
         self.port = port
         self.prefetch_size = prefetch_size
-        self.cache_client = CacheClient(session_id, size, spilling, port, prefetch_size)
+        self.eviction_policy = eviction_policy
+        self.compress = compress
+        self.cache_client = CacheClient(session_id, size, spilling, port, prefetch_size,
+                                        EVICTION_POLICIES[eviction_policy], compress)
 
     def GetStat(self):
         return self.cache_client.GetStat()
@@ -53,5 +75,7 @@ class DatasetCache:
         new_cache.size = copy.deepcopy(self.size, memodict)
         new_cache.port = copy.deepcopy(self.port, memodict)
         new_cache.prefetch_size = copy.deepcopy(self.prefetch_size, memodict)
+        new_cache.eviction_policy = copy.deepcopy(self.eviction_policy, memodict)
+        new_cache.compress = copy.deepcopy(self.compress, memodict)
         new_cache.cache_client = self.cache_client
         return new_cache
@@ -57,11 +57,14 @@ class GraphData:
         auto_shutdown (bool, optional): Valid when working_mode is set to 'server',
             Control when all clients have connected and no client connected to the server,
             automatically exit the server (default=True).
+        csr_storage (bool, optional): Valid when working_mode is set to 'local' or 'server',
+            store the graph in compressed sparse row format, with contiguous neighbor arrays and feature columns
+            instead of one object per node and edge. It uses much less memory for large graphs (default=False).
     """
 
     @check_gnn_graphdata
     def __init__(self, dataset_file, num_parallel_workers=None, working_mode='local', hostname='127.0.0.1', port=50051,
-                 num_client=1, auto_shutdown=True):
+                 num_client=1, auto_shutdown=True, csr_storage=False):
         self._dataset_file = dataset_file
         self._working_mode = working_mode
         if num_parallel_workers is None:
@@ -72,11 +75,12 @@ class GraphData:
         atexit.register(stop)
 
         if working_mode in ['local', 'client']:
-            self._graph_data = GraphDataClient(dataset_file, num_parallel_workers, working_mode, hostname, port)
+            self._graph_data = GraphDataClient(dataset_file, num_parallel_workers, working_mode, hostname, port,
+                                               csr_storage)
 
         if working_mode == 'server':
             self._graph_data = GraphDataServer(
-                dataset_file, num_parallel_workers, hostname, port, num_client, auto_shutdown)
+                dataset_file, num_parallel_workers, hostname, port, num_client, auto_shutdown, csr_storage)
             try:
                 while self._graph_data.is_stoped() is not True:
                     time.sleep(1)
@@ -22,6 +22,7 @@ User can also define custom sampler by extending from Sampler class.
 import numpy as np
 import mindspore._c_dataengine as cde
 import mindspore.dataset as ds
+from .validators import check_distributed_sampler, check_shuffle_block_size
 
 class Sampler:
     """
@@ -225,6 +226,9 @@ class DistributedSampler(BuiltinSampler):
         shuffle (bool, optional): If true, the indices are shuffled (default=True).
         num_samples (int, optional): The number of samples to draw (default=None, all elements).
         offset(int, optional): Offset from shard when the element of dataset is allocated
+        shuffle_block_size (int, optional): If positive, shuffle blocks of this many consecutive rows and then the
+            rows within a window of a few blocks, instead of all the rows. Each shard reads a contiguous slice of
+            this order, which keeps the reads of rows stored together close (default=0).
     Examples:
         >>> import mindspore.dataset as ds
         >>>
@@ -238,9 +242,12 @@ class DistributedSampler(BuiltinSampler):
         ValueError: If num_shards is not positive.
         ValueError: If shard_id is smaller than 0 or equal to num_shards or larger than num_shards.
         ValueError: If shuffle is not a boolean value.
+        ValueError: If shuffle_block_size is negative.
+        ValueError: If shuffle_block_size is positive and offset is set.
     """
 
-    def __init__(self, num_shards, shard_id, shuffle=True, num_samples=None, offset=-1):
+    @check_distributed_sampler
+    def __init__(self, num_shards, shard_id, shuffle=True, num_samples=None, offset=-1, shuffle_block_size=0):
         if num_shards <= 0:
             raise ValueError("num_shards should be a positive integer value, but got num_shards={}".format(num_shards))
 
@@ -260,6 +267,7 @@ class DistributedSampler(BuiltinSampler):
         self.shuffle = shuffle
         self.seed = 0
         self.offset = offset
+        self.shuffle_block_size = shuffle_block_size
         super().__init__(num_samples)
 
     def create(self):
@@ -267,7 +275,7 @@ class DistributedSampler(BuiltinSampler):
         # each time user calls create_dict_iterator() (to do repeat) sampler would get a different seed to shuffle
         self.seed += 1
         c_sampler = cde.DistributedSampler(num_samples, self.num_shards, self.shard_id,
-                                           self.shuffle, self.seed, self.offset)
+                                           self.shuffle, self.seed, self.offset, True, self.shuffle_block_size)
         c_child_sampler = self.create_child()
         c_sampler.add_child(c_child_sampler)
         return c_sampler
@@ -275,7 +283,7 @@ class DistributedSampler(BuiltinSampler):
     def create_for_minddataset(self):
         num_samples = self.num_samples if self.num_samples is not None else 0
         c_sampler = cde.MindrecordDistributedSampler(self.num_shards, self.shard_id, self.shuffle,
-                                                     self.seed, num_samples, self.offset)
+                                                     self.seed, num_samples, self.offset, self.shuffle_block_size)
         c_child_sampler = self.create_child_for_minddataset()
         c_sampler.add_child(c_child_sampler)
         return c_sampler
@@ -293,6 +301,7 @@ class DistributedSampler(BuiltinSampler):
         return self.child_sampler.is_sharded()
 
     def set_offset(self, offset):
+        check_shuffle_block_size(self.shuffle_block_size, offset)
         self.offset = offset
         return self
 
@@ -714,6 +714,29 @@ def check_zip_dataset(method):
     return new_method
 
 
+def check_shuffle_block_size(shuffle_block_size, offset):
+    """check a block shuffle is not combined with an offset, which distributes the rows unevenly."""
+    type_check(shuffle_block_size, (int,), "shuffle_block_size")
+    if shuffle_block_size < 0:
+        raise ValueError("shuffle_block_size should not be negative, but got shuffle_block_size={}"
+                         .format(shuffle_block_size))
+    if shuffle_block_size > 0 and offset != -1:
+        raise ValueError("shuffle_block_size can not be used with an offset, which distributes the rows unevenly, "
+                         "but got offset={}".format(offset))
+
+
+def check_distributed_sampler(method):
+    """check the input arguments of DistributedSampler."""
+
+    @wraps(method)
+    def new_method(self, *args, **kwargs):
+        [_, _, _, _, offset, shuffle_block_size], _ = parse_user_args(method, *args, **kwargs)
+        check_shuffle_block_size(shuffle_block_size, offset)
+        return method(self, *args, **kwargs)
+
+    return new_method
+
+
 def check_concat(method):
     """check the input arguments of concat method in `Dataset`."""
 
@@ -943,7 +966,7 @@ def check_gnn_graphdata(method):
     @wraps(method)
     def new_method(self, *args, **kwargs):
         [dataset_file, num_parallel_workers, working_mode, hostname,
-         port, num_client, auto_shutdown], _ = parse_user_args(method, *args, **kwargs)
+         port, num_client, auto_shutdown, csr_storage], _ = parse_user_args(method, *args, **kwargs)
         check_file(dataset_file)
         if num_parallel_workers is not None:
             check_num_parallel_workers(num_parallel_workers)
@@ -958,6 +981,7 @@ def check_gnn_graphdata(method):
         type_check(num_client, (int,), "num_client")
         check_value(num_client, (1, 255), "num_client")
         type_check(auto_shutdown, (bool,), "auto_shutdown")
+        type_check(csr_storage, (bool,), "csr_storage")
         return method(self, *args, **kwargs)
 
     return new_method
@@ -301,6 +301,9 @@ class WordpieceTokenizer(cde.WordpieceTokenizerOp):
         unknown_token (str, optional): When we can not found the token: if 'unknown_token' is empty string,
             return the token directly, else return 'unknown_token'(default='[UNK]').
         with_offsets (bool, optional): If or not output offsets of tokens (default=False).
+        output_ids (bool, optional): If True, output the ids of the tokens in vocab instead of the tokens, the same
+            as a Lookup after the tokenizer without the string tokens in between. 'unknown_token' has to be in vocab,
+            or every token has to be in vocab if it is empty (default=False).
 
     Examples:
         >>> # If with_offsets=False, default output one column {["text", dtype=str]}
@@ -317,14 +320,15 @@ class WordpieceTokenizer(cde.WordpieceTokenizerOp):
 
     @check_wordpiece_tokenizer
     def __init__(self, vocab, suffix_indicator='##', max_bytes_per_token=100,
-                 unknown_token='[UNK]', with_offsets=False):
+                 unknown_token='[UNK]', with_offsets=False, output_ids=False):
         self.vocab = vocab
         self.suffix_indicator = suffix_indicator
         self.max_bytes_per_token = max_bytes_per_token
         self.unknown_token = unknown_token
         self.with_offsets = with_offsets
+        self.output_ids = output_ids
         super().__init__(self.vocab, self.suffix_indicator, self.max_bytes_per_token,
-                         self.unknown_token, self.with_offsets)
+                         self.unknown_token, self.with_offsets, self.output_ids)
 
 
 DE_C_INTER_SENTENCEPIECE_LOADTYPE = {
@@ -576,6 +580,8 @@ if platform.system().lower() != 'windows':
             preserve_unused_token(bool, optional): If True, do not split special tokens like
                 '[CLS]', '[SEP]', '[UNK]', '[PAD]', '[MASK]'(default=True).
             with_offsets (bool, optional): If or not output offsets of tokens (default=False).
+            output_ids (bool, optional): If True, output the ids of the tokens in vocab instead of the tokens, the
+                same as a Lookup after the tokenizer without the string tokens in between (default=False).
 
         Examples:
             >>> # If with_offsets=False, default output one column {["text", dtype=str]}
@@ -598,7 +604,7 @@ if platform.system().lower() != 'windows':
         @check_bert_tokenizer
         def __init__(self, vocab, suffix_indicator='##', max_bytes_per_token=100, unknown_token='[UNK]',
                      lower_case=False, keep_whitespace=False, normalization_form=NormalizeForm.NONE,
-                     preserve_unused_token=True, with_offsets=False):
+                     preserve_unused_token=True, with_offsets=False, output_ids=False):
             if not isinstance(normalization_form, NormalizeForm):
                 raise TypeError("Wrong input type for normalization_form, should be NormalizeForm.")
 
@@ -611,9 +617,10 @@ if platform.system().lower() != 'windows':
             self.normalization_form = DE_C_INTER_NORMALIZE_FORM[normalization_form]
             self.preserve_unused_token = preserve_unused_token
             self.with_offsets = with_offsets
+            self.output_ids = output_ids
             super().__init__(self.vocab, self.suffix_indicator, self.max_bytes_per_token, self.unknown_token,
                              self.lower_case, self.keep_whitespace, self.normalization_form,
-                             self.preserve_unused_token, self.with_offsets)
+                             self.preserve_unused_token, self.with_offsets, self.output_ids)
 
 
 class TruncateSequencePair(cde.TruncateSequencePairOp):
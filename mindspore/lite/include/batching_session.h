@@ -0,0 +1,66 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef MINDSPORE_LITE_INCLUDE_BATCHING_SESSION_H
+#define MINDSPORE_LITE_INCLUDE_BATCHING_SESSION_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "include/lite_session.h"
+
+namespace mindspore {
+namespace session {
+/// \brief BatchingOptions defined the limits of one batch formed by BatchingSession.
+struct BatchingOptions {
+  int max_batch_size_ = 8;   /**< max samples along the N dimension of one batched run */
+  int max_delay_us_ = 1000;  /**< max time the first request of a batch waits for more requests */
+};
+
+/// \brief BatchingSession defined a front-end of LiteSession which coalesces concurrent requests into batched runs.
+class MS_API BatchingSession {
+ public:
+  /// \brief Static method to create a BatchingSession pointer.
+  ///
+  /// \note The first dimension of every graph input and output must be the batch dimension. The session is resized to
+  /// the batch size of every batched run, a plan cache in its context avoids compiling kernels for each of them.
+  ///
+  /// \param[in] session Define a compiled session, it is used only by the batching session and must outlive it.
+  /// \param[in] options Define the limits of one batch.
+  ///
+  /// \return Pointer of MindSpore Lite BatchingSession.
+  static BatchingSession *CreateBatchingSession(LiteSession *session, const BatchingOptions &options);
+
+  /// \brief Destructor of MindSpore Lite BatchingSession, pending requests fail and it waits for their Run calls to
+  /// return.
+  virtual ~BatchingSession() = default;
+
+  /// \brief Run one request, blocking until the batch containing it has run.
+  ///
+  /// \note Thread safe, requests from concurrent callers are batched together.
+  ///
+  /// \param[in] inputs Define the inputs of the request in the order of LiteSession::GetInputs, all of them with the
+  /// same batch size.
+  /// \param[out] outputs Define the outputs of the request by output node name, the caller owns the tensors.
+  ///
+  /// \return STATUS as an error code of running the request, STATUS is defined in errorcode.h.
+  virtual int Run(const std::vector<tensor::MSTensor *> &inputs,
+                  std::unordered_map<std::string, std::vector<tensor::MSTensor *>> *outputs) = 0;
+};
+}  // namespace session
+}  // namespace mindspore
+#endif  // MINDSPORE_LITE_INCLUDE_BATCHING_SESSION_H
@@ -0,0 +1,54 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef MINDSPORE_LITE_INCLUDE_COMPILED_MODEL_H
+#define MINDSPORE_LITE_INCLUDE_COMPILED_MODEL_H
+
+#include <memory>
+#include "include/model.h"
+#include "include/context.h"
+#include "include/lite_session.h"
+
+namespace mindspore {
+namespace session {
+/// \brief CompiledModel defined a model prepared once in MindSpore Lite, whose weights are shared by all the sessions
+/// created from it.
+class MS_API CompiledModel {
+ public:
+  /// \brief Static method to create a CompiledModel pointer.
+  ///
+  /// \param[in] model Define the model to be compiled, it must outlive the compiled model and its sessions.
+  /// \param[in] context Define the context of the sessions to be created.
+  ///
+  /// \return Pointer of MindSpore Lite CompiledModel.
+  static std::shared_ptr<CompiledModel> Compile(lite::Model *model, lite::Context *context);
+
+  /// \brief Destructor of MindSpore Lite CompiledModel.
+  virtual ~CompiledModel() = default;
+
+  /// \brief Create a compiled session which holds the activations, the inputs and the outputs of one request.
+  ///
+  /// \note Sessions created from one compiled model may run concurrently, each of them runs one request at a time.
+  /// Packed weights and the weight data of the model are shared, every session has its own allocator. The sessions
+  /// keep the compiled model alive.
+  ///
+  /// \return Pointer of MindSpore Lite LiteSession, CompileGraph should not be called on it again.
+  virtual LiteSession *CreateSession() = 0;
+};
+}  // namespace session
+}  // namespace mindspore
+#endif  // MINDSPORE_LITE_INCLUDE_COMPILED_MODEL_H
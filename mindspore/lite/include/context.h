@@ -70,6 +70,9 @@ class MS_API Context {
   int thread_num_ = 2; /**< thread number config for thread pool */
   std::shared_ptr<Allocator> allocator = nullptr;
   CpuBindMode cpu_bind_mode_ = MID_CPU;
+  bool enable_parallel_ = false; /**< run independent kernels of the graph concurrently on the thread pool */
+  int plan_cache_size_ = 0; /**< number of input shapes whose memory plans are kept by Resize, below 2 disables */
+  bool enable_profiling_ = false; /**< record every kernel run, see LiteSession::GetProfiler */
 };
 }  // namespace mindspore::lite
 #endif  // MINDSPORE_LITE_INCLUDE_CONTEXT_H_
@@ -24,6 +24,7 @@
 #include "include/ms_tensor.h"
 #include "include/model.h"
 #include "include/context.h"
+#include "include/profiler.h"
 
 namespace mindspore {
 namespace session {
@@ -59,7 +60,7 @@ class MS_API LiteSession {
   ///
   /// \note CompileGraph should be called before RunGraph.
   ///
-  /// \param[in] model Define the model to be compiled.
+  /// \param[in] model Define the model to be compiled, its MetaGraph must not be freed while the session exists.
   ///
   /// \return STATUS as an error code of compiling graph, STATUS is defined in errorcode.h.
   virtual int CompileGraph(lite::Model *model) = 0;
@@ -104,6 +105,11 @@ class MS_API LiteSession {
   ///
   /// \return STATUS as an error code of resize inputs, STATUS is defined in errorcode.h.
   virtual int Resize(const std::vector<tensor::MSTensor *> &inputs) = 0;
+
+  /// \brief Get the profiler recording the kernels run by RunGraph.
+  ///
+  /// \return Pointer of the profiler owned by the session, nullptr unless profiling is enabled in the context.
+  virtual Profiler *GetProfiler() const { return nullptr; }
 };
 }  // namespace session
 }  // namespace mindspore
@@ -47,6 +47,16 @@ class MS_API Model {
   /// \return Pointer of MindSpore Lite Model.
   static Model *Import(const char *model_buf, size_t size);
 
+  /// \brief Static method to create a Model pointer by mapping a model file into memory.
+  ///
+  /// \note The file is mapped instead of copied, weights of the model point into the mapping, so processes loading
+  /// the same model file share its pages. The file should not be modified while the model is alive.
+  ///
+  /// \param[in] model_path Define the path of the model file.
+  ///
+  /// \return Pointer of MindSpore Lite Model.
+  static Model *ImportFromFile(const char *model_path);
+
   /// \brief Constructor of MindSpore Lite Model using default value for parameters.
   ///
   /// \return Instance of MindSpore Lite Model.
@@ -68,6 +78,10 @@ class MS_API Model {
   const schema::MetaGraph *GetMetaGraph() const;
 
   /// \brief Free MetaGraph in MindSpore Lite Model.
+  ///
+  /// \note The sessions compiled from this model, directly or through a CompiledModel, reference the weights and the
+  /// pre-packed weights in the MetaGraph buffer instead of copying them. FreeMetaGraph must only be called once all
+  /// these sessions and compiled models are destroyed, calling it earlier leaves them with dangling weights.
   void FreeMetaGraph();
 
  protected:
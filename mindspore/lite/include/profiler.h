@@ -0,0 +1,60 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_INCLUDE_PROFILER_H
+#define MINDSPORE_LITE_INCLUDE_PROFILER_H
+
+#include <string>
+#include "include/model.h"
+
+namespace mindspore {
+namespace session {
+/// \brief Profiler defined the per-kernel records of the RunGraph calls of a session with profiling enabled.
+///
+/// \note Every kernel run records its wall time, an estimate of its FLOPs, the bytes of its outputs, the bytes the
+/// allocator grew by during the run and the share of the thread pool busy with its tasks.
+class MS_API Profiler {
+ public:
+  /// \brief Destructor of MindSpore Lite Profiler.
+  virtual ~Profiler() = default;
+
+  /// \brief Drop all records, e.g. the ones of warm up runs.
+  virtual void Clear() = 0;
+
+  /// \brief Get the summary table of the records.
+  ///
+  /// \param[in] sort_key Define the column rows are sorted by, one of total, avg, p50, p90, p99, max, flops, name.
+  ///
+  /// \return The table with one row per kernel, empty if sort_key is invalid.
+  virtual std::string Summary(const std::string &sort_key = "total") const = 0;
+
+  /// \brief Write the summary of every kernel as a json array.
+  ///
+  /// \param[in] path Define the file to write.
+  ///
+  /// \return STATUS as an error code of writing the file, STATUS is defined in errorcode.h.
+  virtual int WriteSummaryJson(const std::string &path) const = 0;
+
+  /// \brief Write every kernel run as a complete event of the Chrome trace event format, for chrome://tracing.
+  ///
+  /// \param[in] path Define the file to write.
+  ///
+  /// \return STATUS as an error code of writing the file, STATUS is defined in errorcode.h.
+  virtual int WriteChromeTrace(const std::string &path) const = 0;
+};
+}  // namespace session
+}  // namespace mindspore
+#endif  // MINDSPORE_LITE_INCLUDE_PROFILER_H
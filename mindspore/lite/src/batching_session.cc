@@ -0,0 +1,286 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "src/batching_session.h"
+#include <algorithm>
+#include <cstring>
+#include "include/errorcode.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace lite {
+BatchingSession::~BatchingSession() {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    stop_ = true;
+  }
+  queue_cond_.notify_all();
+  if (batch_thread_.joinable()) {
+    batch_thread_.join();
+  }
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  // the batching thread has finished the batch it was running, the requests still queued fail
+  for (auto *request : queue_) {
+    request->ret = RET_ERROR;
+    request->done = true;
+  }
+  queue_.clear();
+  done_cond_.notify_all();
+  leave_cond_.wait(lock, [this]() { return running_ == 0; });
+}
+
+int BatchingSession::Init() {
+  if (session_ == nullptr) {
+    MS_LOG(ERROR) << "The input session is nullptr.";
+    return RET_PARAM_INVALID;
+  }
+  if (options_.max_batch_size_ <= 0 || options_.max_delay_us_ < 0) {
+    MS_LOG(ERROR) << "Invalid batching options, max batch size: " << options_.max_batch_size_
+                  << ", max delay: " << options_.max_delay_us_;
+    return RET_PARAM_INVALID;
+  }
+  for (auto *input : session_->GetInputs()) {
+    MS_ASSERT(input != nullptr);
+    if (input->shape().empty()) {
+      MS_LOG(ERROR) << "Graph input without a batch dimension can not be batched";
+      return RET_PARAM_INVALID;
+    }
+    input_shapes_.emplace_back(input->shape());
+    input_types_.emplace_back(input->data_type());
+  }
+  batch_thread_ = std::thread([this]() { BatchLoop(); });
+  return RET_OK;
+}
+
+int BatchingSession::CheckInputs(const std::vector<tensor::MSTensor *> &inputs, int *batch) const {
+  if (inputs.size() != input_shapes_.size()) {
+    MS_LOG(ERROR) << "Inputs size " << inputs.size() << " is not equal to " << input_shapes_.size();
+    return RET_PARAM_INVALID;
+  }
+  *batch = 0;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (inputs[i] == nullptr || inputs[i]->MutableData() == nullptr) {
+      MS_LOG(ERROR) << "Input tensor or its data is nullptr!";
+      return RET_PARAM_INVALID;
+    }
+    auto shape = inputs[i]->shape();
+    auto &graph_shape = input_shapes_[i];
+    if (shape.size() != graph_shape.size() || !std::equal(shape.begin() + 1, shape.end(), graph_shape.begin() + 1) ||
+        inputs[i]->data_type() != input_types_[i]) {
+      MS_LOG(ERROR) << "Input " << i << " differs from the graph input in more than the batch dimension";
+      return RET_PARAM_INVALID;
+    }
+    if (i == 0) {
+      *batch = shape[0];
+    } else if (shape[0] != *batch) {
+      MS_LOG(ERROR) << "Inputs of one request have different batch sizes " << *batch << " and " << shape[0];
+      return RET_PARAM_INVALID;
+    }
+  }
+  if (*batch <= 0 || *batch > options_.max_batch_size_) {
+    MS_LOG(ERROR) << "Batch size " << *batch << " of the request is out of (0, " << options_.max_batch_size_ << "]";
+    return RET_PARAM_INVALID;
+  }
+  return RET_OK;
+}
+
+int BatchingSession::Run(const std::vector<tensor::MSTensor *> &inputs,
+                         std::unordered_map<std::string, std::vector<tensor::MSTensor *>> *outputs) {
+  if (outputs == nullptr) {
+    MS_LOG(ERROR) << "The outputs is nullptr.";
+    return RET_PARAM_INVALID;
+  }
+  int batch = 0;
+  auto ret = CheckInputs(inputs, &batch);
+  if (ret != RET_OK) {
+    return ret;
+  }
+  outputs->clear();
+  Request request{&inputs, outputs, batch, std::chrono::steady_clock::now(), RET_OK, false};
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  if (stop_) {
+    MS_LOG(ERROR) << "The batching session is stopping";
+    return RET_ERROR;
+  }
+  queue_.emplace_back(&request);
+  ++running_;
+  queue_cond_.notify_one();
+  done_cond_.wait(lock, [&request]() { return request.done; });
+  if (--running_ == 0 && stop_) {
+    leave_cond_.notify_all();
+  }
+  return request.ret;
+}
+
+int BatchingSession::QueuedSamples() const {
+  int samples = 0;
+  for (auto *request : queue_) {
+    samples += request->batch;
+  }
+  return samples;
+}
+
+std::vector<BatchingSession::Request *> BatchingSession::NextBatch() {
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  queue_cond_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+  if (stop_) {
+    return {};
+  }
+  auto deadline = queue_.front()->arrival + std::chrono::microseconds(options_.max_delay_us_);
+  queue_cond_.wait_until(lock, deadline,
+                         [this]() { return stop_ || QueuedSamples() >= options_.max_batch_size_; });
+  if (stop_) {
+    return {};
+  }
+  std::vector<Request *> batch;
+  int samples = 0;
+  // keep the arrival order, a request which does not fit any more opens the next batch
+  while (!queue_.empty() && samples + queue_.front()->batch <= options_.max_batch_size_) {
+    samples += queue_.front()->batch;
+    batch.emplace_back(queue_.front());
+    queue_.pop_front();
+  }
+  return batch;
+}
+
+void BatchingSession::BatchLoop() {
+  while (true) {
+    auto batch = NextBatch();
+    if (batch.empty()) {
+      break;
+    }
+    auto ret = RunBatch(batch);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Run batch of " << batch.size() << " requests failed: " << ret;
+    }
+    Finish(batch, ret);
+  }
+}
+
+int BatchingSession::ResizeBatch(int batch_size) {
+  auto graph_inputs = session_->GetInputs();
+  if (graph_inputs.front()->shape().front() == batch_size) {
+    return RET_OK;
+  }
+  std::vector<tensor::MSTensor *> resized_inputs;
+  for (auto *input : graph_inputs) {
+    auto shape = input->shape();
+    shape[0] = batch_size;
+    resized_inputs.emplace_back(tensor::MSTensor::CreateTensor(input->data_type(), shape));
+  }
+  auto ret = session_->Resize(resized_inputs);
+  for (auto *input : resized_inputs) {
+    delete input;
+  }
+  return ret;
+}
+
+int BatchingSession::RunBatch(const std::vector<Request *> &batch) {
+  int batch_size = 0;
+  for (auto *request : batch) {
+    batch_size += request->batch;
+  }
+  auto ret = ResizeBatch(batch_size);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Resize session to batch size " << batch_size << " failed: " << ret;
+    return ret;
+  }
+  auto graph_inputs = session_->GetInputs();
+  for (size_t i = 0; i < graph_inputs.size(); ++i) {
+    auto dst = reinterpret_cast<char *>(graph_inputs[i]->MutableData());
+    if (dst == nullptr) {
+      MS_LOG(ERROR) << "Malloc data of graph input " << i << " failed";
+      return RET_MEMORY_FAILED;
+    }
+    // N is the outermost dimension, so the inputs of the requests are concatenated one after another
+    size_t offset = 0;
+    for (auto *request : batch) {
+      auto src = request->inputs->at(i);
+      memcpy(dst + offset, src->MutableData(), src->Size());
+      offset += src->Size();
+    }
+  }
+  ret = session_->RunGraph();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Run batched graph failed: " << ret;
+    return ret;
+  }
+  return ScatterOutputs(batch, batch_size);
+}
+
+int BatchingSession::ScatterOutputs(const std::vector<Request *> &batch, int batch_size) {
+  for (auto &item : session_->GetOutputs()) {
+    for (auto *output : item.second) {
+      auto shape = output->shape();
+      if (shape.empty() || shape[0] != batch_size) {
+        MS_LOG(ERROR) << "Output of node " << item.first << " has no batch dimension of size " << batch_size;
+        return RET_ERROR;
+      }
+      auto src = reinterpret_cast<char *>(output->MutableData());
+      size_t sample_size = output->Size() / batch_size;
+      size_t offset = 0;
+      for (auto *request : batch) {
+        shape[0] = request->batch;
+        auto *request_output = tensor::MSTensor::CreateTensor(output->data_type(), shape);
+        if (request_output == nullptr || request_output->MutableData() == nullptr) {
+          MS_LOG(ERROR) << "Create output tensor of node " << item.first << " failed";
+          delete request_output;
+          return RET_MEMORY_FAILED;
+        }
+        memcpy(request_output->MutableData(), src + offset, sample_size * request->batch);
+        offset += sample_size * request->batch;
+        (*request->outputs)[item.first].emplace_back(request_output);
+      }
+    }
+  }
+  return RET_OK;
+}
+
+void BatchingSession::Finish(const std::vector<Request *> &batch, int ret) {
+  std::lock_guard<std::mutex> lock(queue_mutex_);
+  for (auto *request : batch) {
+    if (ret != RET_OK) {
+      for (auto &item : *request->outputs) {
+        for (auto *output : item.second) {
+          delete output;
+        }
+      }
+      request->outputs->clear();
+    }
+    request->ret = ret;
+    request->done = true;
+  }
+  done_cond_.notify_all();
+}
+}  // namespace lite
+
+session::BatchingSession *session::BatchingSession::CreateBatchingSession(session::LiteSession *session,
+                                                                          const BatchingOptions &options) {
+  auto batching_session = new (std::nothrow) lite::BatchingSession(session, options);
+  if (batching_session == nullptr) {
+    MS_LOG(ERROR) << "new batching session failed";
+    return nullptr;
+  }
+  auto ret = batching_session->Init();
+  if (ret != lite::RET_OK) {
+    MS_LOG(ERROR) << "init batching session failed: " << ret;
+    delete batching_session;
+    return nullptr;
+  }
+  return batching_session;
+}
+}  // namespace mindspore
@@ -0,0 +1,93 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef MINDSPORE_LITE_SRC_BATCHING_SESSION_H_
+#define MINDSPORE_LITE_SRC_BATCHING_SESSION_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "include/batching_session.h"
+
+namespace mindspore {
+namespace lite {
+// Requests are queued by the callers and a batching thread runs them. It takes the queued requests once the batch is
+// full or the first of them has waited max_delay_us_, concatenates their inputs along N, runs the session once and
+// slices the outputs back.
+class BatchingSession : public session::BatchingSession {
+ public:
+  BatchingSession(session::LiteSession *session, const session::BatchingOptions &options)
+      : session_(session), options_(options) {}
+
+  ~BatchingSession() override;
+
+  int Init();
+
+  int Run(const std::vector<tensor::MSTensor *> &inputs,
+          std::unordered_map<std::string, std::vector<tensor::MSTensor *>> *outputs) override;
+
+ private:
+  struct Request {
+    const std::vector<tensor::MSTensor *> *inputs;
+    std::unordered_map<std::string, std::vector<tensor::MSTensor *>> *outputs;
+    int batch;
+    std::chrono::steady_clock::time_point arrival;
+    int ret;
+    bool done;
+  };
+
+  int CheckInputs(const std::vector<tensor::MSTensor *> &inputs, int *batch) const;
+
+  void BatchLoop();
+
+  int QueuedSamples() const;
+
+  // take the requests of the next batch out of the queue, empty if the session is stopping
+  std::vector<Request *> NextBatch();
+
+  int RunBatch(const std::vector<Request *> &batch);
+
+  int ResizeBatch(int batch_size);
+
+  int ScatterOutputs(const std::vector<Request *> &batch, int batch_size);
+
+  void Finish(const std::vector<Request *> &batch, int ret);
+
+  session::LiteSession *session_ = nullptr;
+  session::BatchingOptions options_;
+  // graph inputs as seen at Init, the batching thread resizes the session while callers check their requests
+  std::vector<std::vector<int>> input_shapes_;
+  std::vector<TypeId> input_types_;
+  std::mutex queue_mutex_;
+  std::condition_variable queue_cond_;
+  std::condition_variable done_cond_;
+  std::condition_variable leave_cond_;
+  std::deque<Request *> queue_;
+  // callers inside Run, the destructor waits for them to leave before the members go away
+  int running_ = 0;
+  bool stop_ = false;
+  std::thread batch_thread_;
+};
+}  // namespace lite
+}  // namespace mindspore
+
+#endif  // MINDSPORE_LITE_SRC_BATCHING_SESSION_H_
@@ -0,0 +1,162 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "src/compiled_model.h"
+#include <algorithm>
+#include "include/errorcode.h"
+#include "utils/log_adapter.h"
+#include "src/lite_session.h"
+#include "src/runtime/allocator.h"
+#include "src/runtime/weight_prepack.h"
+
+namespace mindspore {
+namespace lite {
+namespace {
+constexpr size_t kConvWeightIndex = 1;
+
+bool IsPackableWeight(const schema::Tensor *weight) {
+  if (weight == nullptr || weight->dims() == nullptr || weight->data() == nullptr) {
+    return false;
+  }
+  return IsPackableConvWeight(weight->nodeType(), weight->format(), weight->dataType(), weight->dims()->data(),
+                              weight->dims()->size(), weight->data()->size(), weight->packedLayout());
+}
+}  // namespace
+
+CompiledModel::~CompiledModel() {
+  for (auto &packed_weight : packed_weights_) {
+    free(packed_weight.data);
+  }
+  packed_weights_.clear();
+}
+
+int CompiledModel::Init(Model *model, Context *context) {
+  if (model == nullptr || model->GetMetaGraph() == nullptr || context == nullptr) {
+    MS_LOG(ERROR) << "The input model or context is nullptr.";
+    return RET_PARAM_INVALID;
+  }
+  model_ = model;
+  context_.float16_priority = context->float16_priority;
+  context_.device_ctx_ = context->device_ctx_;
+  context_.thread_num_ = context->thread_num_;
+  context_.cpu_bind_mode_ = context->cpu_bind_mode_;
+  context_.enable_parallel_ = context->enable_parallel_;
+  context_.plan_cache_size_ = context->plan_cache_size_;
+  context_.enable_profiling_ = context->enable_profiling_;
+  return PrepackWeights();
+}
+
+int CompiledModel::PrepackWeights() {
+  // fp16 and gpu kernels consume the origin weight data
+  if (context_.float16_priority || context_.device_ctx_.type != DT_CPU) {
+    return RET_OK;
+  }
+  auto meta_graph = model_->GetMetaGraph();
+  for (size_t i = 0; i < meta_graph->nodes()->size(); ++i) {
+    auto node = meta_graph->nodes()->GetAs<schema::CNode>(i);
+    MS_ASSERT(node != nullptr);
+    if (node->primitive() == nullptr || node->primitive()->value_type() != schema::PrimitiveType_Conv2D ||
+        node->inputIndex()->size() <= kConvWeightIndex) {
+      continue;
+    }
+    auto conv = node->primitive()->value_as_Conv2D();
+    if (conv == nullptr || !IsPackableConv(node->quantType(), conv->group())) {
+      continue;
+    }
+    size_t weight_index = node->inputIndex()->GetAs<uint32_t>(kConvWeightIndex);
+    auto weight = meta_graph->allTensors()->GetAs<schema::Tensor>(weight_index);
+    if (!IsPackableWeight(weight)) {
+      continue;
+    }
+    auto layout =
+      ConvWeightLayout(conv->kernelH(), conv->kernelW(), conv->strideH(), conv->strideW(), conv->dilateH(),
+                       conv->dilateW());
+    auto packed = std::find_if(packed_weights_.begin(), packed_weights_.end(),
+                               [weight_index](const PackedWeight &item) { return item.tensor_index == weight_index; });
+    if (layout == schema::WeightLayout_ORIGIN || packed != packed_weights_.end()) {
+      continue;
+    }
+    int output_channel = weight->dims()->Get(0);
+    int kernel_h = weight->dims()->Get(1);
+    int kernel_w = weight->dims()->Get(2);
+    int input_channel = weight->dims()->Get(3);
+    auto size = PackedWeightSize(layout, output_channel, kernel_h, kernel_w, input_channel);
+    auto data = malloc(size);
+    if (data == nullptr) {
+      MS_LOG(ERROR) << "Malloc packed weight failed, size: " << size;
+      return RET_MEMORY_FAILED;
+    }
+    auto ret = PackConvWeight(layout, reinterpret_cast<const float *>(weight->data()->data()), output_channel, kernel_h,
+                              kernel_w, input_channel, data);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Prepack weight of node " << node->name()->str() << " failed: " << ret;
+      free(data);
+      return ret;
+    }
+    packed_weights_.push_back({weight_index, layout, data, size});
+  }
+  MS_LOG(DEBUG) << "Prepack " << packed_weights_.size() << " weights for shared sessions";
+  return RET_OK;
+}
+
+void CompiledModel::AttachPackedWeights(const std::vector<tensor::Tensor *> &tensors) const {
+  for (auto &packed_weight : packed_weights_) {
+    MS_ASSERT(packed_weight.tensor_index < tensors.size());
+    tensors[packed_weight.tensor_index]->SetPackedData(packed_weight.layout, packed_weight.data, packed_weight.size);
+  }
+}
+
+session::LiteSession *CompiledModel::CreateSession() {
+  // sessions running concurrently must not share the memory pool
+  Context context(context_.thread_num_, Allocator::Create(), context_.device_ctx_);
+  context.float16_priority = context_.float16_priority;
+  context.cpu_bind_mode_ = context_.cpu_bind_mode_;
+  context.enable_parallel_ = context_.enable_parallel_;
+  context.plan_cache_size_ = context_.plan_cache_size_;
+  context.enable_profiling_ = context_.enable_profiling_;
+  auto session = new (std::nothrow) LiteSession();
+  if (session == nullptr) {
+    MS_LOG(ERROR) << "new session failed";
+    return nullptr;
+  }
+  auto ret = session->Init(&context);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "init session failed: " << ret;
+    delete session;
+    return nullptr;
+  }
+  session->set_compiled_model(shared_from_this());
+  ret = session->CompileGraph(model_);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "compile session failed: " << ret;
+    delete session;
+    return nullptr;
+  }
+  return session;
+}
+}  // namespace lite
+
+std::shared_ptr<session::CompiledModel> session::CompiledModel::Compile(lite::Model *model, lite::Context *context) {
+  auto compiled_model = std::make_shared<lite::CompiledModel>();
+  auto ret = compiled_model->Init(model, context);
+  if (ret != lite::RET_OK) {
+    MS_LOG(ERROR) << "init compiled model failed: " << ret;
+    return nullptr;
+  }
+  return compiled_model;
+}
+}  // namespace mindspore
@@ -0,0 +1,61 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef MINDSPORE_LITE_SRC_COMPILED_MODEL_H_
+#define MINDSPORE_LITE_SRC_COMPILED_MODEL_H_
+
+#include <memory>
+#include <vector>
+#include "include/compiled_model.h"
+#include "src/ir/tensor.h"
+
+namespace mindspore {
+namespace lite {
+// Every session created from a compiled model references the weight data in the model buffer. Conv weights which the
+// cpu kernels accept pre-packed are packed once here and attached to the weight tensors of each session, so
+// concurrent sessions only add activations, inputs and outputs to the memory of one model.
+class CompiledModel : public session::CompiledModel, public std::enable_shared_from_this<CompiledModel> {
+ public:
+  CompiledModel() = default;
+
+  ~CompiledModel() override;
+
+  int Init(Model *model, Context *context);
+
+  session::LiteSession *CreateSession() override;
+
+  // tensors are the ones converted from the model, in the order of MetaGraph::allTensors
+  void AttachPackedWeights(const std::vector<tensor::Tensor *> &tensors) const;
+
+ private:
+  struct PackedWeight {
+    size_t tensor_index;
+    schema::WeightLayout layout;
+    void *data;
+    size_t size;
+  };
+
+  int PrepackWeights();
+
+  Model *model_ = nullptr;
+  Context context_;
+  std::vector<PackedWeight> packed_weights_;
+};
+}  // namespace lite
+}  // namespace mindspore
+
+#endif  // MINDSPORE_LITE_SRC_COMPILED_MODEL_H_
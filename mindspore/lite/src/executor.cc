@@ -20,6 +20,18 @@
 #include "src/common/ms_tensor_utils.h"
 
 namespace mindspore::lite {
+int Executor::Prepare(std::vector<kernel::LiteKernel *> &kernels) {
+  auto ret = memory_planner_.Plan(kernels);
+  if (ret == RET_INFER_INVALID) {
+    MS_LOG(WARNING) << "Some shapes are only known at runtime, fall back to dynamic memory";
+    return RET_OK;
+  }
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Plan static memory failed: " << ret;
+  }
+  return ret;
+}
+
 int Executor::Run(std::vector<tensor::Tensor *> &in_tensors, std::vector<tensor::Tensor *> &out_tensors,
                   std::vector<kernel::LiteKernel *> &kernels, Allocator *allocator,
                   const session::KernelCallBack &before, const session::KernelCallBack &after) {
@@ -34,7 +46,10 @@ int Executor::Run(std::vector<tensor::Tensor *> &in_tensors, std::vector<tensor:
       return RET_ERROR;
     }
   }
-  kernel::LiteKernelUtil::InitTensorRefCount(kernels);
+  bool static_memory = memory_planner_.IsPlanned();
+  if (!static_memory) {
+    kernel::LiteKernelUtil::InitTensorRefCount(kernels);
+  }
   for (auto *kernel : kernels) {
     MS_ASSERT(nullptr != kernel);
 
@@ -44,7 +59,14 @@ int Executor::Run(std::vector<tensor::Tensor *> &in_tensors, std::vector<tensor:
         MS_LOG(ERROR) << "run kernel before_callback failed, name: " << kernel->name();
       }
     }
+    KernelProfiler::Mark mark;
+    if (profiler_ != nullptr) {
+      mark = profiler_->Begin(allocator);
+    }
     auto ret = kernel->Run();
+    if (profiler_ != nullptr) {
+      profiler_->End(kernel, mark, allocator, true);
+    }
     if (0 != ret) {
       MS_LOG(ERROR) << "run kernel failed, name: " << kernel->name();
       return ret;
@@ -55,6 +77,9 @@ int Executor::Run(std::vector<tensor::Tensor *> &in_tensors, std::vector<tensor:
         MS_LOG(ERROR) << "run kernel after_callback failed, name: " << kernel->name();
       }
     }
+    if (static_memory) {
+      continue;
+    }
     for (auto input_kernel : kernel->in_kernels()) {
       MS_ASSERT(input_kernel != nullptr);
       if (input_kernel->is_model_output()) {
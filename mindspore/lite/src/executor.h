@@ -19,6 +19,8 @@
 
 #include <vector>
 #include "src/runtime/allocator.h"
+#include "src/runtime/memory_planner.h"
+#include "src/runtime/kernel_profiler.h"
 #include "src/lite_kernel.h"
 #include "include/lite_session.h"
 
@@ -28,18 +30,30 @@ class Executor {
   Executor() = default;
   virtual ~Executor() = default;
 
-  virtual int Prepare(std::vector<kernel::LiteKernel *> &kernels) { return 0; }
+  virtual int Prepare(std::vector<kernel::LiteKernel *> &kernels);
 
   virtual int Run(std::vector<tensor::Tensor *> &in_tensors, std::vector<tensor::Tensor *> &out_tensors,
           std::vector<kernel::LiteKernel *> &kernels, Allocator *allocator = nullptr,
           const session::KernelCallBack &before = nullptr, const session::KernelCallBack &after = nullptr);
 
+  // hand the planned tensors over to another executor, Resume binds them to this plan again
+  void Suspend() { memory_planner_.Detach(); }
+
+  void Resume() { memory_planner_.Attach(); }
+
+  // record every kernel run, nullptr disables profiling
+  void set_profiler(KernelProfiler *profiler) { profiler_ = profiler; }
+
  protected:
   int TransformTensorLayoutFp32(tensor::Tensor *tensor, schema::Format dst_format, Allocator *allocator = nullptr);
 
   int TransformTensorLayoutUint8(tensor::Tensor *tensor, schema::Format dst_format, Allocator *allocator = nullptr);
 
   int TransformTensorLayout(tensor::Tensor *tensor, schema::Format dst_format, Allocator *allocator = nullptr);
+
+  // intermediate tensors are bound to a pre-planned arena once planning succeeded
+  MemoryPlanner memory_planner_;
+  KernelProfiler *profiler_ = nullptr;
 };
 
 }  // namespace mindspore::lite
@@ -121,6 +121,8 @@ class Tensor : public mindspore::tensor::MetaTensor {
 
   void set_allocator(mindspore::lite::Allocator *allocator) { allocator_ = allocator; }
 
+  mindspore::lite::Allocator *allocator() const { return this->allocator_; }
+
   int MallocData(mindspore::lite::Allocator *allocator = nullptr) {
     if (nullptr != this->data_) {
       return 0;
@@ -178,6 +180,21 @@ class Tensor : public mindspore::tensor::MetaTensor {
 
   std::vector<tensor::QuantArg> GetQuantParams() const;
 
+  // weight data packed offline, referenced in place from the model buffer
+  void SetPackedData(schema::WeightLayout layout, void *data, size_t size) {
+    this->packed_layout_ = layout;
+    this->packed_data_ = data;
+    this->packed_size_ = size;
+  }
+
+  // return nullptr unless the packed data has exactly the layout and size the kernel expects
+  void *PackedData(schema::WeightLayout layout, size_t size) const {
+    if (packed_layout_ != layout || packed_size_ != size) {
+      return nullptr;
+    }
+    return packed_data_;
+  }
+
   void Prepare() {
     if (allocator_ != nullptr) {
       data_ = allocator_->Prepare(data_);
@@ -192,6 +209,9 @@ class Tensor : public mindspore::tensor::MetaTensor {
   size_t refCount = 0;
   std::vector<tensor::QuantArg> quant_params_;
   mindspore::lite::Allocator *allocator_ = nullptr;
+  schema::WeightLayout packed_layout_ = schema::WeightLayout_ORIGIN;
+  void *packed_data_ = nullptr;
+  size_t packed_size_ = 0;
 };
 
 class LiteTensor : public mindspore::tensor::MSTensor {
@@ -18,6 +18,7 @@
 #define MINDSPORE_LITE_SRC_LITE_KERNEL_H_
 #include <vector>
 #include <string>
+#include <memory>
 #ifdef ENABLE_ARM
 #include <arm_neon.h>
 #endif
@@ -54,6 +55,12 @@ struct KernelKey {
   }
 };
 
+// what ReSize computed from the tensor shapes, kept by the resize plan cache to switch shapes without ReSize
+struct KernelShapeState {
+  virtual ~KernelShapeState() = default;
+};
+using KernelShapeStatePtr = std::shared_ptr<KernelShapeState>;
+
 class LiteKernel {
  public:
   LiteKernel() = default;
@@ -77,6 +84,7 @@ class LiteKernel {
 
   virtual int Prepare() {
     if (!InferShapeDone()) {
+      // the primitive belongs to the session of this kernel, not to the shared model
       (const_cast<mindspore::lite::PrimitiveC *>(primitive_))->InferShape(in_tensors_, out_tensors_);
       ReSize();
     }
@@ -95,6 +103,12 @@ class LiteKernel {
 
   virtual int Run() { return -1; }
 
+  // a kernel returning a state must not read the shape dependent members of its primitive outside ReSize,
+  // nullptr means the kernel is resized again when its shapes come back
+  virtual KernelShapeStatePtr SaveShapeState() { return nullptr; }
+
+  virtual int RestoreShapeState(const KernelShapeStatePtr &state) { return RET_ERROR; }
+
   std::string name() { return this->name_; }
 
   virtual void train() { train_mode_ = true; }
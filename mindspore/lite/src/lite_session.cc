@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <vector>
 #include "include/errorcode.h"
 #include "src/lite_session.h"
@@ -22,9 +23,12 @@
 #include "src/runtime/runtime_api.h"
 #include "src/runtime/allocator.h"
 #include "src/executor.h"
+#include "src/runtime/parallel_executor.h"
 #include "src/common/utils.h"
 #include "src/common/graph_util.h"
 #include "src/kernel_registry.h"
+#include "src/compiled_model.h"
+#include "src/model.h"
 #if SUPPORT_GPU
 #include "src/runtime/opencl/opencl_runtime.h"
 #endif
@@ -64,6 +68,11 @@ int LiteSession::ConvertTensors(const lite::Model *model) {
       // no copy data, do copy when call LiteKernel::Init
       dstTensor->SetData(const_cast<unsigned char *>(srcTensor->data()->data()));
     }
+    auto packed_data = srcTensor->packedData();
+    if (srcTensor->packedLayout() != schema::WeightLayout_ORIGIN && packed_data != nullptr && packed_data->size() > 0) {
+      dstTensor->SetPackedData(srcTensor->packedLayout(), const_cast<unsigned char *>(packed_data->data()),
+                               packed_data->size());
+    }
     auto quant_params = srcTensor->quantParams();
     if (quant_params != nullptr) {
       for (int j = 0; j < quant_params->size(); j++) {
@@ -76,6 +85,9 @@ int LiteSession::ConvertTensors(const lite::Model *model) {
 
     this->tensors_.emplace_back(dstTensor);
   }
+  if (compiled_model_ != nullptr) {
+    compiled_model_->AttachPackedWeights(this->tensors_);
+  }
   return RET_OK;
 }
 
@@ -185,6 +197,23 @@ void LiteSession::InitGraphInOutTensors(const lite::Model *model) {
   InitGraphOutputMap(model);
 }
 
+int LiteSession::CopyPrimitives(const lite::Model *model) {
+  MS_ASSERT(model != nullptr);
+  auto meta_graph = model->GetMetaGraph();
+  MS_ASSERT(meta_graph != nullptr);
+  for (size_t i = 0; i < meta_graph->nodes()->size(); i++) {
+    auto cNode = meta_graph->nodes()->GetAs<schema::CNode>(i);
+    auto *primitive = CopyPrimitive(cNode->primitive());
+    if (primitive == nullptr) {
+      MS_LOG(ERROR) << "Op " << cNode->name()->str() << " is not supported, type: "
+                    << schema::EnumNamePrimitiveType(cNode->primitive()->value_type());
+      return RET_ERROR;
+    }
+    this->primitives_.emplace_back(primitive);
+  }
+  return RET_OK;
+}
+
 int LiteSession::CompileGraph(Model *model) {
   // model.MetaGraph ==> kernels
   if (model == nullptr) {
@@ -198,17 +227,28 @@ int LiteSession::CompileGraph(Model *model) {
     return ret;
   }
 
+  ret = CopyPrimitives(model);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "CopyPrimitives failed: " << ret;
+    return ret;
+  }
+
   InitGraphInOutTensors(model);
+  model_ = model;
 
   // scheduler kernels
   Scheduler scheduler(context_);
-  ret = scheduler.Schedule(model, &tensors_, &kernels_);
+  ret = scheduler.Schedule(model, primitives_, &tensors_, &kernels_);
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "Schedule kernels failed: " << ret;
     return ret;
   }
 
-  executor->Prepare(this->kernels_);
+  ret = executor->Prepare(this->kernels_);
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Prepare executor failed: " << ret;
+    return ret;
+  }
   return RET_OK;
 }
 
@@ -237,6 +277,7 @@ int LiteSession::Init(Context *context) {
   }
   this->context_->float16_priority = context->float16_priority;
   this->context_->cpu_bind_mode_ = context->cpu_bind_mode_;
+  this->context_->enable_parallel_ = context->enable_parallel_;
   ConfigThreadPool(context->cpu_bind_mode_, context->thread_num_);
   auto ret = KernelRegistry::GetInstance()->Init();
   if (ret != RET_OK) {
@@ -249,11 +290,38 @@ int LiteSession::Init(Context *context) {
     opencl_runtime->Init();
   }
 #endif
-  executor = new Executor();
+  this->context_->plan_cache_size_ = context->plan_cache_size_;
+  this->context_->enable_profiling_ = context->enable_profiling_;
+  if (context_->enable_profiling_) {
+    profiler_ = new (std::nothrow) KernelProfiler(context_->thread_num_);
+    if (profiler_ == nullptr) {
+      MS_LOG(ERROR) << "new profiler failed";
+      return RET_MEMORY_FAILED;
+    }
+  }
+  if (context_->enable_parallel_ && context_->thread_num_ > 1 && context_->allocator != nullptr) {
+    // concurrent kernels malloc their workspace from several threads, the allocator belongs to the caller so it is
+    // wrapped instead of being reconfigured
+    context_->allocator = std::make_shared<SyncAllocator>(context_->allocator);
+  }
+  executor = CreateExecutor();
   MS_EXCEPTION_IF_NULL(executor);
   return RET_OK;
 }
 
+Executor *LiteSession::CreateExecutor() {
+  Executor *new_executor = nullptr;
+  if (context_->enable_parallel_ && context_->thread_num_ > 1) {
+    new_executor = new (std::nothrow) ParallelExecutor();
+  } else {
+    new_executor = new (std::nothrow) Executor();
+  }
+  if (new_executor != nullptr) {
+    new_executor->set_profiler(profiler_);
+  }
+  return new_executor;
+}
+
 void LiteSession::BindThread(bool if_bind) {
   if (this->context_->cpu_bind_mode_ != NO_BIND) {
     DoAllThreadBind(if_bind, static_cast<int>(this->context_->cpu_bind_mode_));
@@ -261,6 +329,13 @@ void LiteSession::BindThread(bool if_bind) {
 }
 
 LiteSession::~LiteSession() {
+  // executor releases the memory arena and unbinds planned tensors, so it must go before tensors
+  delete this->executor;
+  this->executor = nullptr;
+  for (auto &cached : plan_cache_) {
+    ReleasePlan(&cached.second);
+  }
+  plan_cache_.clear();
   for (auto *tensor : tensors_) {
     // weight data can not be to free, we will free weight data when freeing meta_graph
     if (tensor->TensorType() == schema::NodeType_ValueNode && !IsContain(this->inputs_, tensor)) {
@@ -288,9 +363,12 @@ LiteSession::~LiteSession() {
   for (auto *kernel : kernels_) {
     delete kernel;
   }
+  for (auto *primitive : primitives_) {
+    delete primitive;
+  }
+  delete this->profiler_;
+  this->profiler_ = nullptr;
   delete this->context_;
-  delete this->executor;
-  this->executor = nullptr;
 }
 
 std::vector<mindspore::tensor::MSTensor *> LiteSession::GetInputsByName(const std::string &name) const {
@@ -324,12 +402,19 @@ int LiteSession::ResizeInputs(const std::vector<mindspore::tensor::MSTensor *> &
       MS_LOG(ERROR) << "Input tensor is nullptr!";
       return RET_PARAM_INVALID;
     }
+    if (inputs_[i]->shape() != inputs[i]->shape()) {
+      // the buffer was sized for the old shape, MutableData allocates a new one
+      inputs_[i]->FreeData();
+    }
     inputs_[i]->set_shape(inputs[i]->shape());
   }
   return RET_OK;
 }
 
 int LiteSession::Resize(const std::vector<mindspore::tensor::MSTensor *> &inputs) {
+  if (context_->plan_cache_size_ > 1 && model_ != nullptr) {
+    return ResizeWithPlanCache(inputs);
+  }
   std::vector<tensor::Tensor *> inputs_old(inputs_);
   auto ret = ResizeInputs(inputs);
   if (ret != RET_OK) {
@@ -347,6 +432,151 @@ int LiteSession::Resize(const std::vector<mindspore::tensor::MSTensor *> &inputs
     }
     return ret;
   }
+  // tensor sizes changed, plan the memory arena again
+  return executor->Prepare(this->kernels_);
+}
+
+std::vector<std::vector<int>> LiteSession::TensorShapes() const {
+  std::vector<std::vector<int>> tensor_shapes;
+  tensor_shapes.reserve(tensors_.size());
+  for (auto *tensor : tensors_) {
+    tensor_shapes.emplace_back(tensor->shape());
+  }
+  return tensor_shapes;
+}
+
+void LiteSession::RestoreTensorShapes(const std::vector<std::vector<int>> &tensor_shapes) {
+  MS_ASSERT(tensor_shapes.size() == tensors_.size());
+  for (size_t i = 0; i < tensors_.size(); ++i) {
+    tensors_[i]->set_shape(tensor_shapes[i]);
+  }
+}
+
+std::vector<bool> LiteSession::InferFlags() const {
+  std::vector<bool> infer_flags;
+  infer_flags.reserve(kernels_.size());
+  for (auto *kernel : kernels_) {
+    auto primitive = kernel->GetPrimitive();
+    infer_flags.emplace_back(primitive != nullptr && primitive->GetInferFlag());
+  }
+  return infer_flags;
+}
+
+void LiteSession::RestoreInferFlags(const std::vector<bool> &infer_flags) {
+  MS_ASSERT(infer_flags.size() == kernels_.size());
+  for (size_t i = 0; i < kernels_.size(); ++i) {
+    auto primitive = const_cast<PrimitiveC *>(kernels_[i]->GetPrimitive());
+    if (primitive != nullptr) {
+      primitive->SetInferFlag(infer_flags[i]);
+    }
+  }
+}
+
+std::vector<kernel::KernelShapeStatePtr> LiteSession::KernelStates() const {
+  std::vector<kernel::KernelShapeStatePtr> kernel_states;
+  kernel_states.reserve(kernels_.size());
+  for (auto *kernel : kernels_) {
+    kernel_states.emplace_back(kernel->SaveShapeState());
+  }
+  return kernel_states;
+}
+
+std::vector<kernel::LiteKernel *> LiteSession::RestoreKernelStates(
+  const std::vector<kernel::KernelShapeStatePtr> &kernel_states) {
+  MS_ASSERT(kernel_states.size() == kernels_.size());
+  std::vector<kernel::LiteKernel *> stale_kernels;
+  for (size_t i = 0; i < kernels_.size(); ++i) {
+    if (kernel_states[i] == nullptr || kernels_[i]->RestoreShapeState(kernel_states[i]) != RET_OK) {
+      stale_kernels.emplace_back(kernels_[i]);
+    }
+  }
+  return stale_kernels;
+}
+
+void LiteSession::ReleasePlan(ResizePlan *plan) {
+  MS_ASSERT(plan != nullptr);
+  delete plan->executor;
+  plan->executor = nullptr;
+}
+
+void LiteSession::CachePlan(const InputShapes &input_shapes, const ResizePlan &plan) {
+  plan_cache_.emplace_front(input_shapes, plan);
+  // the active plan takes one of the slots
+  while (plan_cache_.size() >= static_cast<size_t>(context_->plan_cache_size_)) {
+    ReleasePlan(&plan_cache_.back().second);
+    plan_cache_.pop_back();
+  }
+}
+
+int LiteSession::ResizeWithPlanCache(const std::vector<mindspore::tensor::MSTensor *> &inputs) {
+  if (inputs.size() != inputs_.size()) {
+    MS_LOG(ERROR) << "Inputs size " << inputs.size() << " is not equal to " << inputs_.size();
+    return RET_PARAM_INVALID;
+  }
+  InputShapes old_input_shapes;
+  InputShapes new_input_shapes;
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    if (inputs[i] == nullptr) {
+      MS_LOG(ERROR) << "Input tensor is nullptr!";
+      return RET_PARAM_INVALID;
+    }
+    old_input_shapes.emplace_back(inputs_[i]->shape());
+    new_input_shapes.emplace_back(inputs[i]->shape());
+  }
+  if (new_input_shapes == old_input_shapes) {
+    return RET_OK;
+  }
+  for (size_t i = 0; i < inputs_.size(); ++i) {
+    if (new_input_shapes[i] != old_input_shapes[i]) {
+      inputs_[i]->FreeData();
+    }
+  }
+
+  ResizePlan active_plan{executor, TensorShapes(), InferFlags(), KernelStates()};
+  executor->Suspend();
+  auto iter = std::find_if(plan_cache_.begin(), plan_cache_.end(),
+                           [&new_input_shapes](const std::pair<InputShapes, ResizePlan> &cached) {
+                             return cached.first == new_input_shapes;
+                           });
+  Executor *new_executor = nullptr;
+  Scheduler scheduler(context_);
+  auto ret = ResizeInputs(inputs);
+  if (ret == RET_OK && iter != plan_cache_.end()) {
+    MS_LOG(DEBUG) << "Resize hits the plan cache";
+    // the shapes were inferred and the kernels resized when the plan was made, only stateless kernels run again
+    RestoreTensorShapes(iter->second.tensor_shapes);
+    RestoreInferFlags(iter->second.infer_flags);
+    ret = scheduler.ReSizeKernels(RestoreKernelStates(iter->second.kernel_states));
+    if (ret == RET_OK) {
+      new_executor = iter->second.executor;
+      plan_cache_.erase(iter);
+      new_executor->Resume();
+    }
+  } else if (ret == RET_OK) {
+    // plan the memory of the new shapes and keep the active plan for switching back
+    ret = scheduler.ReSizeKernels(kernels_);
+    if (ret == RET_OK) {
+      new_executor = CreateExecutor();
+      ret = new_executor == nullptr ? RET_MEMORY_FAILED : new_executor->Prepare(kernels_);
+    }
+    if (ret != RET_OK) {
+      delete new_executor;
+      new_executor = nullptr;
+    }
+  }
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Resize kernels for new input shapes failed: " << ret;
+    RestoreTensorShapes(active_plan.tensor_shapes);
+    RestoreInferFlags(active_plan.infer_flags);
+    auto resize_ret = scheduler.ReSizeKernels(kernels_);
+    if (resize_ret != RET_OK) {
+      MS_LOG(ERROR) << "restore kernel size fail!ret: " << resize_ret;
+    }
+    executor->Resume();
+    return ret;
+  }
+  executor = new_executor;
+  CachePlan(old_input_shapes, active_plan);
   return RET_OK;
 }
 }  // namespace lite
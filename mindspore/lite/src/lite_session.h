@@ -17,7 +17,9 @@
 #ifndef MINDSPORE_LITE_SRC_LITE_SESSION_H_
 #define MINDSPORE_LITE_SRC_LITE_SESSION_H_
 
+#include <list>
 #include <memory>
+#include <utility>
 #include <vector>
 #include <string>
 #include <unordered_map>
@@ -31,6 +33,8 @@
 
 namespace mindspore {
 namespace lite {
+class CompiledModel;
+
 class LiteSession : public session::LiteSession {
  public:
   LiteSession() = default;
@@ -56,9 +60,18 @@ class LiteSession : public session::LiteSession {
 
   int Resize(const std::vector<mindspore::tensor::MSTensor *> &inputs) override;
 
+  session::Profiler *GetProfiler() const override { return this->profiler_; }
+
+  // must be set before CompileGraph, the session then shares the packed weights of the compiled model
+  void set_compiled_model(std::shared_ptr<CompiledModel> compiled_model) {
+    this->compiled_model_ = std::move(compiled_model);
+  }
+
  protected:
   int ConvertTensors(const lite::Model *model);
 
+  int CopyPrimitives(const lite::Model *model);
+
   void InitGraphInOutTensors(const lite::Model *model);
 
   void InitGraphInputTensors(const lite::Model *model);
@@ -73,9 +86,44 @@ class LiteSession : public session::LiteSession {
 
   int ResizeInputs(const std::vector<mindspore::tensor::MSTensor *> &inputs);
 
+  Executor *CreateExecutor();
+
+ private:
+  // memory planned for one set of input shapes, the kernels and their packed weights are shared by all plans.
+  // Switching back to a plan restores the kernel states instead of resizing, only the kernels which keep no
+  // state (SaveShapeState returns nullptr) run InferShape and ReSize again.
+  struct ResizePlan {
+    Executor *executor = nullptr;
+    std::vector<std::vector<int>> tensor_shapes;
+    std::vector<bool> infer_flags;
+    std::vector<kernel::KernelShapeStatePtr> kernel_states;
+  };
+  using InputShapes = std::vector<std::vector<int>>;
+
+  int ResizeWithPlanCache(const std::vector<mindspore::tensor::MSTensor *> &inputs);
+
+  void CachePlan(const InputShapes &input_shapes, const ResizePlan &plan);
+
+  void ReleasePlan(ResizePlan *plan);
+
+  std::vector<std::vector<int>> TensorShapes() const;
+
+  void RestoreTensorShapes(const std::vector<std::vector<int>> &tensor_shapes);
+
+  std::vector<bool> InferFlags() const;
+
+  void RestoreInferFlags(const std::vector<bool> &infer_flags);
+
+  std::vector<kernel::KernelShapeStatePtr> KernelStates() const;
+
+  // returns the kernels which could not restore their state and must be resized
+  std::vector<kernel::LiteKernel *> RestoreKernelStates(const std::vector<kernel::KernelShapeStatePtr> &kernel_states);
+
  protected:
   Context *context_ = nullptr;
   std::vector<kernel::LiteKernel *> kernels_;
+  // shape inference writes to the primitives, so every session owns the ones of its kernels
+  std::vector<PrimitiveC *> primitives_;
   std::vector<tensor::Tensor *> tensors_;
   // graph input tensors
   std::vector<tensor::Tensor *> inputs_;
@@ -88,6 +136,14 @@ class LiteSession : public session::LiteSession {
   // graph output node name -- output tensors
   std::unordered_map<std::string, std::vector<mindspore::tensor::MSTensor *>> output_map_;
   Executor *executor = nullptr;
+  // created by Init when the context enables profiling, shared by the executors of all cached plans
+  KernelProfiler *profiler_ = nullptr;
+
+ private:
+  const Model *model_ = nullptr;
+  std::shared_ptr<CompiledModel> compiled_model_ = nullptr;
+  // plans of the input shapes used before, most recently used first, the active plan is not in the list
+  std::list<std::pair<InputShapes, ResizePlan>> plan_cache_;
 };
 }  // namespace lite
 }  // namespace mindspore
@@ -107,16 +107,24 @@
 #include "src/ops/ceil.h"
 #include "src/ops/round.h"
 #include "src/ops/primitive_c.h"
-#include "include/model.h"
+#include "src/model.h"
 #include "utils/log_adapter.h"
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace mindspore::lite {
 
 class ModelImpl {
  public:
   static ModelImpl *Import(const char *model_buf, size_t size);
+  static ModelImpl *ImportFromFile(const char *model_path);
   ModelImpl() = default;
-  explicit ModelImpl(const char *model_buf, size_t size) : model_buf_(model_buf), buf_size_(size) {
+  explicit ModelImpl(const char *model_buf, size_t size, bool is_mapped = false)
+      : model_buf_(model_buf), buf_size_(size), is_mapped_(is_mapped) {
     meta_graph_ = schema::GetMetaGraph(model_buf);
   }
   virtual ~ModelImpl();
@@ -126,11 +134,13 @@ class ModelImpl {
   int BuildOps();
 
  protected:
-  PrimitiveC *CopyPrimitive(const schema::Primitive *src_prim);
+  void ReleaseModelBuf();
 
  protected:
   const char *model_buf_;
   size_t buf_size_;
+  // model_buf_ is a private mapping of the model file instead of a heap copy
+  bool is_mapped_ = false;
   const schema::MetaGraph *meta_graph_ = nullptr;
   std::map<std::string, PrimitiveC *> ops_;
 };
@@ -164,6 +174,58 @@ ModelImpl *ModelImpl::Import(const char *model_buf, size_t size) {
   return model;
 }
 
+ModelImpl *ModelImpl::ImportFromFile(const char *model_path) {
+  if (model_path == nullptr) {
+    MS_LOG(ERROR) << "The model path is nullptr";
+    return nullptr;
+  }
+#ifdef _WIN32
+  MS_LOG(ERROR) << "Mapping model file is not supported on windows";
+  return nullptr;
+#else
+  int fd = open(model_path, O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "Open model file failed: " << model_path;
+    return nullptr;
+  }
+  struct stat file_stat {};
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    MS_LOG(ERROR) << "Get size of model file failed: " << model_path;
+    close(fd);
+    return nullptr;
+  }
+  auto size = static_cast<size_t>(file_stat.st_size);
+  // pages of a private mapping stay shared in page cache between processes until someone writes to them, so weights
+  // which kernels use in place are loaded once per host
+  void *map_addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map_addr == MAP_FAILED) {
+    MS_LOG(ERROR) << "Map model file failed: " << model_path;
+    return nullptr;
+  }
+  auto model_buf = reinterpret_cast<const char *>(map_addr);
+  flatbuffers::Verifier verify(reinterpret_cast<const uint8_t *>(model_buf), size);
+  if (!schema::VerifyMetaGraphBuffer(verify)) {
+    MS_LOG(ERROR) << "The model file is invalid and fail to create graph: " << model_path;
+    munmap(map_addr, size);
+    return nullptr;
+  }
+  auto model = new (std::nothrow) ModelImpl(model_buf, size, true);
+  if (model == nullptr) {
+    MS_LOG(ERROR) << "Create modelImpl failed";
+    munmap(map_addr, size);
+    return nullptr;
+  }
+  auto ret = model->BuildOps();
+  if (0 != ret) {
+    MS_LOG(ERROR) << "BuildOps failed";
+    delete model;
+    return nullptr;
+  }
+  return model;
+#endif
+}
+
 PrimitiveC *ModelImpl::GetOp(const std::string &name) const {
   auto iter = ops_.find(name);
   if (iter == ops_.end()) {
@@ -173,22 +235,34 @@ PrimitiveC *ModelImpl::GetOp(const std::string &name) const {
   }
 }
 
-ModelImpl::~ModelImpl() {
+void ModelImpl::ReleaseModelBuf() {
+  if (this->model_buf_ == nullptr) {
+    return;
+  }
+#ifndef _WIN32
+  if (is_mapped_) {
+    munmap(const_cast<char *>(this->model_buf_), this->buf_size_);
+    this->model_buf_ = nullptr;
+    return;
+  }
+#endif
   delete[](this->model_buf_);
+  this->model_buf_ = nullptr;
+}
+
+ModelImpl::~ModelImpl() {
+  ReleaseModelBuf();
   for (auto iter : ops_) {
     delete (iter.second);
   }
   ops_.clear();
 }
 
-void ModelImpl::FreeMetaGraph() {
-  delete[](this->model_buf_);
-  model_buf_ = nullptr;
-}
+void ModelImpl::FreeMetaGraph() { ReleaseModelBuf(); }
 
 const schema::MetaGraph *ModelImpl::meta_graph() const { return this->meta_graph_; }
 
-PrimitiveC *ModelImpl::CopyPrimitive(const schema::Primitive *src_prim) {
+PrimitiveC *CopyPrimitive(const schema::Primitive *src_prim) {
   MS_EXCEPTION_IF_NULL(src_prim);
   auto op_type = src_prim->value_type();
   switch (op_type) {
@@ -398,6 +472,22 @@ Model *Model::Import(const char *model_buf, size_t size) {
   return model;
 }
 
+Model *Model::ImportFromFile(const char *model_path) {
+  auto model_impl = ModelImpl::ImportFromFile(model_path);
+  if (model_impl == nullptr) {
+    MS_LOG(ERROR) << "model impl is null";
+    return nullptr;
+  }
+  auto model = new (std::nothrow) Model();
+  if (model == nullptr) {
+    MS_LOG(ERROR) << "new model failed";
+    delete model_impl;
+    return nullptr;
+  }
+  model->model_impl_ = model_impl;
+  return model;
+}
+
 Model::~Model() { delete (this->model_impl_); }
 
 mindspore::lite::PrimitiveC *Model::GetOp(const std::string &name) const {
@@ -0,0 +1,29 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_MODEL_H_
+#define MINDSPORE_LITE_SRC_MODEL_H_
+
+#include "include/model.h"
+#include "schema/model_generated.h"
+#include "src/ops/primitive_c.h"
+
+namespace mindspore::lite {
+// returns nullptr for the types lite can not run, the result wraps src_prim and must not outlive the model buffer
+PrimitiveC *CopyPrimitive(const schema::Primitive *src_prim);
+}  // namespace mindspore::lite
+
+#endif  // MINDSPORE_LITE_SRC_MODEL_H_
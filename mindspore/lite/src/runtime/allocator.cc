@@ -119,5 +119,30 @@ void DefaultAllocator::Clear() {
   freeList.clear();
   UnLock();
 }
+
+void *SyncAllocator::Malloc(size_t size) {
+  std::lock_guard<std::mutex> guard(lock_);
+  return allocator_->Malloc(size);
+}
+
+void SyncAllocator::Free(void *ptr) {
+  std::lock_guard<std::mutex> guard(lock_);
+  allocator_->Free(ptr);
+}
+
+size_t SyncAllocator::GetTotalSize() {
+  std::lock_guard<std::mutex> guard(lock_);
+  return allocator_->GetTotalSize();
+}
+
+void SyncAllocator::Clear() {
+  std::lock_guard<std::mutex> guard(lock_);
+  allocator_->Clear();
+}
+
+void *SyncAllocator::Prepare(void *ptr) {
+  std::lock_guard<std::mutex> guard(lock_);
+  return allocator_->Prepare(ptr);
+}
 }  // namespace mindspore::lite
 
@@ -24,8 +24,12 @@
 #include <map>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 namespace mindspore::lite {
+// 6 is empirical value
+constexpr int kDefaultShiftFactor = 6;
+
 struct AllocatorContext {
   int shiftFactor;
   bool lockFlag;
@@ -67,11 +71,28 @@ class DefaultAllocator : public Allocator {
   // <membuf->buf, membuf>
   std::unordered_map<void *, MemBuf *> allocatedList;
   std::multimap<size_t, MemBuf *> freeList;
-  // 6 is empirical value
-  int shiftFactor = 6;
+  int shiftFactor = kDefaultShiftFactor;
   bool lockFlag = false;
 };
 
+// Serializes the calls to an allocator which is not configured for concurrent use, without changing its settings
+class SyncAllocator : public Allocator {
+ public:
+  explicit SyncAllocator(std::shared_ptr<Allocator> allocator) : allocator_(std::move(allocator)) {
+    name = allocator_->name;
+  }
+  ~SyncAllocator() override = default;
+  void *Malloc(size_t size) override;
+  void Free(void *ptr) override;
+  size_t GetTotalSize() override;
+  void Clear() override;
+  void *Prepare(void *ptr) override;
+
+ private:
+  std::shared_ptr<Allocator> allocator_;
+  std::mutex lock_;
+};
+
 #define MAX_MALLOC_SIZE 500 * 1024 * 1024
 
 }  // namespace mindspore::lite
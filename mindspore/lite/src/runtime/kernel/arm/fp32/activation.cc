@@ -35,28 +35,32 @@ int ActivationCPUKernel::Init() { return RET_OK; }
 
 int ActivationCPUKernel::ReSize() { return RET_OK; }
 
-int ActivationCPUKernel::DoActivation(int task_id) {
-  auto input_addr = reinterpret_cast<float *>(in_tensors_.at(0)->Data());
-  auto output_addr = reinterpret_cast<float *>(out_tensors_.at(0)->Data());
-  auto length = in_tensors_.at(0)->ElementsNum();
+namespace {
+// elements below this are not worth a chunk of their own
+constexpr int kActivationMinGrain = 1024;
+// a few chunks per thread let idle threads balance out slow cores
+constexpr int kActivationChunksPerThread = 4;
+}  // namespace
 
-  int stride = UP_DIV(length, thread_count_);
-  int count = MSMIN(stride, length - stride * task_id);
+int ActivationCPUKernel::DoActivation(int begin, int end) {
+  auto input_addr = reinterpret_cast<float *>(in_tensors_.at(0)->Data()) + begin;
+  auto output_addr = reinterpret_cast<float *>(out_tensors_.at(0)->Data()) + begin;
+  int count = end - begin;
 
   auto error_code = RET_OK;
 
   if (type_ == schema::ActivationType_RELU) {
-    error_code = Fp32Relu(input_addr + stride * task_id, count, output_addr + stride * task_id);
+    error_code = Fp32Relu(input_addr, count, output_addr);
   } else if (type_ == schema::ActivationType_RELU6) {
-    error_code = Fp32Relu6(input_addr + stride * task_id, count, output_addr + stride * task_id);
+    error_code = Fp32Relu6(input_addr, count, output_addr);
   } else if (type_ == schema::ActivationType_LEAKY_RELU) {
-    error_code = LRelu(input_addr + stride * task_id, count, output_addr + stride * task_id, alpha_);
+    error_code = LRelu(input_addr, count, output_addr, alpha_);
   } else if (type_ == schema::ActivationType_SIGMOID) {
-    error_code = Sigmoid(input_addr + stride * task_id, count, output_addr + stride * task_id);
+    error_code = Sigmoid(input_addr, count, output_addr);
   } else if (type_ == schema::ActivationType_TANH) {
-    error_code = Tanh(input_addr + stride * task_id, count, output_addr + stride * task_id);
+    error_code = Tanh(input_addr, count, output_addr);
   } else if (type_ == schema::ActivationType_HSWISH) {
-    error_code = HSwish(input_addr + stride * task_id, count, output_addr + stride * task_id);
+    error_code = HSwish(input_addr, count, output_addr);
   } else {
     MS_LOG(ERROR) << "Activation type error";
     return RET_ERROR;
@@ -67,11 +71,11 @@ int ActivationCPUKernel::DoActivation(int task_id) {
   return RET_OK;
 }
 
-int ActivationRun(int task_id, LiteParallelGroupEnv *penv, void *cdata) {
+int ActivationRun(int begin, int end, void *cdata) {
   auto activation_kernel = reinterpret_cast<ActivationCPUKernel *>(cdata);
-  auto error_code = activation_kernel->DoActivation(task_id);
+  auto error_code = activation_kernel->DoActivation(begin, end);
   if (error_code != RET_OK) {
-    MS_LOG(ERROR) << "ActivationRun error task_id[" << task_id << "] error_code[" << error_code << "]";
+    MS_LOG(ERROR) << "ActivationRun error range[" << begin << ", " << end << ") error_code[" << error_code << "]";
     return RET_ERROR;
   }
   return RET_OK;
@@ -83,7 +87,9 @@ int ActivationCPUKernel::Run() {
     MS_LOG(ERROR) << "Prepare failed.";
     return ret;
   }
-  int error_code = LiteBackendParallelLaunch(ActivationRun, this, thread_count_);
+  auto length = in_tensors_.at(0)->ElementsNum();
+  int grain = MSMAX(kActivationMinGrain, UP_DIV(length, thread_count_ * kActivationChunksPerThread));
+  int error_code = LiteBackendParallelFor(ActivationRun, this, 0, length, grain);
   if (error_code != RET_OK) {
     MS_LOG(ERROR) << "Activation function error error_code[" << error_code << "]";
     return RET_ERROR;
@@ -36,7 +36,7 @@ class ActivationCPUKernel : public LiteKernel {
   int Init() override;
   int ReSize() override;
   int Run() override;
-  int DoActivation(int task_id);
+  int DoActivation(int begin, int end);
 
  private:
   int thread_count_;
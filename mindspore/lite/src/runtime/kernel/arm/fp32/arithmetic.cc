@@ -15,6 +15,7 @@
  */
 
 #include "src/runtime/kernel/arm/fp32/arithmetic.h"
+#include <memory>
 #include "src/runtime/kernel/arm/int8/add_int8.h"
 #include "src/runtime/kernel/arm/int8/mul_int8.h"
 #include "schema/model_generated.h"
@@ -64,6 +65,24 @@ int ArithmeticCPUKernel::ReSize() {
   return RET_OK;
 }
 
+KernelShapeStatePtr ArithmeticCPUKernel::SaveShapeState() {
+  auto state = std::make_shared<ShapeState>();
+  state->param = *arithmeticParameter_;
+  state->opt_run = arithmetic_opt_run_;
+  return state;
+}
+
+int ArithmeticCPUKernel::RestoreShapeState(const KernelShapeStatePtr &state) {
+  auto shape_state = std::dynamic_pointer_cast<ShapeState>(state);
+  if (shape_state == nullptr) {
+    MS_LOG(ERROR) << "shape state of kernel " << name_ << " is invalid";
+    return RET_ERROR;
+  }
+  *arithmeticParameter_ = shape_state->param;
+  arithmetic_opt_run_ = shape_state->opt_run;
+  return RET_OK;
+}
+
 int ArithmeticCPUKernel::DoArithmetic(int task_id) {
   auto input0_data = reinterpret_cast<float *>(in_tensors_[0]->Data());
   auto input1_data1 = reinterpret_cast<float *>(in_tensors_[1]->Data());
@@ -171,9 +171,16 @@ class ArithmeticCPUKernel : public LiteKernel {
   int Init() override;
   int ReSize() override;
   int Run() override;
+  KernelShapeStatePtr SaveShapeState() override;
+  int RestoreShapeState(const KernelShapeStatePtr &state) override;
   int DoArithmetic(int task_id);
 
  private:
+  struct ShapeState : public KernelShapeState {
+    ArithmeticParameter param;
+    ArithmeticOptRun opt_run;
+  };
+
   int thread_count_;
   float *tile_data0_ = nullptr;
   float *tile_data1_ = nullptr;
@@ -24,7 +24,7 @@ using mindspore::lite::RET_OK;
 namespace mindspore::kernel {
 Convolution1x1CPUKernel::~Convolution1x1CPUKernel() {
   FreeTmpBuffer();
-  if (weight_ptr_ != nullptr) {
+  if (weight_ptr_ != nullptr && !weight_prepacked_) {
     free(weight_ptr_);
     weight_ptr_ = nullptr;
   }
@@ -83,6 +83,12 @@ int Convolution1x1CPUKernel::InitConv1x1BiasWeight() {
   }
 
   size = input_channel * UP_ROUND(output_channel, C8NUM) * sizeof(float);
+  auto packed_weight = filter_tensor->PackedData(schema::WeightLayout_CONV1X1_FP32_COL8, size);
+  if (packed_weight != nullptr) {
+    weight_ptr_ = reinterpret_cast<float *>(packed_weight);
+    weight_prepacked_ = true;
+    return RET_OK;
+  }
   weight_ptr_ = reinterpret_cast<float *>(malloc(size));
   if (weight_ptr_ == nullptr) {
     MS_LOG(ERROR) << "Conv1x1 Malloc weight_ptr_ error!";
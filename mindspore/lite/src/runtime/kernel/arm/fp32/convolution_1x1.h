@@ -60,6 +60,7 @@ class Convolution1x1CPUKernel : public ConvolutionBaseCPUKernel {
   int thread_count_ = 0;
   int thread_stride_ = 0;
   float *weight_ptr_ = nullptr;
+  bool weight_prepacked_ = false;
   float *pack_input_ = nullptr;
   float *input_ptr_ = nullptr;
   float *output_ptr_ = nullptr;
@@ -67,14 +67,20 @@ int Convolution3x3CPUKernel::InitWeightBias() {
   const int k_plane = 16;
   // init weight
   size_t transformed_size = iC4 * C4NUM * oc_block_num * oc_block * k_plane * sizeof(float);
-  transformed_filter_addr_ = reinterpret_cast<float *>(malloc(transformed_size));
-  if (transformed_filter_addr_ == nullptr) {
-    MS_LOG(ERROR) << "malloc transformed filter addr failed.";
-    return RET_ERROR;
+  auto packed_filter = filter_tensor->PackedData(schema::WeightLayout_CONV3X3_FP32_WINOGRAD, transformed_size);
+  if (packed_filter != nullptr) {
+    transformed_filter_addr_ = reinterpret_cast<float *>(packed_filter);
+    filter_prepacked_ = true;
+  } else {
+    transformed_filter_addr_ = reinterpret_cast<float *>(malloc(transformed_size));
+    if (transformed_filter_addr_ == nullptr) {
+      MS_LOG(ERROR) << "malloc transformed filter addr failed.";
+      return RET_ERROR;
+    }
+    memset(transformed_filter_addr_, 0, transformed_size);
+    auto weight_data = reinterpret_cast<float *>(in_tensors_.at(kWeightIndex)->Data());
+    ProcessFilter(weight_data, transformed_filter_addr_, conv_param_, oc_block, oc_block_num);
   }
-  memset(transformed_filter_addr_, 0, transformed_size);
-  auto weight_data = reinterpret_cast<float *>(in_tensors_.at(kWeightIndex)->Data());
-  ProcessFilter(weight_data, transformed_filter_addr_, conv_param_, oc_block, oc_block_num);
 
   // init bias
   size_t new_bias_size = oC4 * C4NUM * sizeof(float);
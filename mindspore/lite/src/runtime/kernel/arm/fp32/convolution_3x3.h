@@ -30,7 +30,7 @@ class Convolution3x3CPUKernel : public ConvolutionBaseCPUKernel {
                           const mindspore::lite::PrimitiveC *primitive)
       : ConvolutionBaseCPUKernel(parameter, inputs, outputs, ctx, primitive) {}
   ~Convolution3x3CPUKernel() override {
-    if (transformed_filter_addr_ != nullptr) {
+    if (transformed_filter_addr_ != nullptr && !filter_prepacked_) {
       free(transformed_filter_addr_);
     }
     if (tile_buffer_ != nullptr) {
@@ -63,6 +63,7 @@ class Convolution3x3CPUKernel : public ConvolutionBaseCPUKernel {
   }
 
   float *transformed_filter_addr_ = nullptr;
+  bool filter_prepacked_ = false;
   float *tile_buffer_ = nullptr;
   float *block_unit_buffer_ = nullptr;
   float *tmp_dst_buffer_ = nullptr;
@@ -16,6 +16,10 @@
 
 #include "nnacl/common_func.h"
 #include "nnacl/quantization/fixed_point.h"
+#ifdef ENABLE_AVX
+#include "nnacl/x86_64/cpu_info.h"
+#include "nnacl/x86_64/gemm_fp32_avx.h"
+#endif
 
 int offset(const int *shape, const int dim0, const int dim1, const int dim2, const int dim3) {
   return ((dim0 * shape[1] + dim1) * shape[2] + dim2) * shape[3] + dim3;
@@ -108,6 +112,12 @@ void IndirectGemmFp32_8x8(float *output, const float *input, const float *weight
   } else if (mode) {
     IndirectGemmFp32_Comm(output, input, weight, ic4, C8NUM, output_channel, offset);
   } else {
+#ifdef ENABLE_AVX
+    if (X86SupportAvx2()) {
+      IndirectGemmFp32_8x8Avx2(output, input, weight, bias, step, ic4, output_channel, relu, relu6);
+      return;
+    }
+#endif
     IndirectGemmFp32(output, input, weight, bias, step, ic4, output_channel, offset, relu, relu6);
   }
 }
@@ -15,6 +15,10 @@
  */
 
 #include "nnacl/fp32/matmul.h"
+#ifdef ENABLE_AVX
+#include "nnacl/x86_64/cpu_info.h"
+#include "nnacl/x86_64/gemm_fp32_avx.h"
+#endif
 
 void RowMajor2Row8Major(float *src_ptr, float *dst_ptr, int row, int col) {
   for (int r = 0; r < row; r++) {
@@ -272,6 +276,12 @@ void MatMul(const float *a, const float *b, float *c, const float *bias, ActType
 #ifdef ENABLE_ARM64
   MatmulFloatNeon64(a, b, c, bias, (int)act_type, deep, row, col, stride, write_nhwc);
 #else
+#ifdef ENABLE_AVX
+  if (X86SupportAvx2()) {
+    MatmulFloatAvx2(a, b, c, bias, (int)act_type, deep, row, col, stride, write_nhwc);
+    return;
+  }
+#endif
   MatMul8x8(a, b, c, bias, act_type, deep, row, col, stride, write_nhwc);
 #endif
 }
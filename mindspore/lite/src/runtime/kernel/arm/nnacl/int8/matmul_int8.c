@@ -17,6 +17,10 @@
 #include "nnacl/int8/matmul_int8.h"
 #include <limits.h>
 #include "nnacl/quantization/fixed_point.h"
+#ifdef ENABLE_AVX
+#include "nnacl/x86_64/cpu_info.h"
+#include "nnacl/x86_64/gemm_int8_avx.h"
+#endif
 void RowMajor2Row8MajorInt8(int8_t *src_ptr, int8_t *dst_ptr, int row, int col) {
   for (int r = 0; r < row; r++) {
     int8_t *src = src_ptr + r * col;
@@ -105,6 +109,16 @@ void RowMajor2Col8MajorInt8(int8_t *src_ptr, int8_t *dst_ptr, int row, int col)
 
 void MatMulInt8(const int8_t *a, const int8_t *b, int32_t *c, const int row8, const int col8, const int deep,
                 const int32_t a_zp, const int32_t b_zp) {
+#ifdef ENABLE_AVX
+  if (X86SupportAvx512Vnni()) {
+    MatMulInt8Avx512Vnni(a, b, c, row8, col8, deep, a_zp, b_zp);
+    return;
+  }
+  if (X86SupportAvx2()) {
+    MatMulInt8Avx2(a, b, c, row8, col8, deep, a_zp, b_zp);
+    return;
+  }
+#endif
   /*  col8-major * row8-major => row8x8-major  */
   for (int row = 0; row < row8; row++) {
     for (int col = 0; col < col8; col++) {
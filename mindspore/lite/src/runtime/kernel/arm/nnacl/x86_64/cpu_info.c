@@ -0,0 +1,71 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/x86_64/cpu_info.h"
+#include <cpuid.h>
+#include <stdint.h>
+
+#define CPUID_FMA_BIT (1u << 12)
+#define CPUID_OSXSAVE_BIT (1u << 27)
+#define CPUID_AVX_BIT (1u << 28)
+#define CPUID_AVX2_BIT (1u << 5)
+#define CPUID_AVX512F_BIT (1u << 16)
+#define CPUID_AVX512VL_BIT (1u << 31)
+#define CPUID_AVX512VNNI_BIT (1u << 11)
+#define XCR0_YMM_MASK 0x6u
+#define XCR0_ZMM_MASK 0xe6u
+
+// -1: not detected yet, detection is idempotent so a race only repeats it
+static int avx2_support = -1;
+static int avx512_vnni_support = -1;
+
+static uint64_t ReadXcr0() {
+  uint32_t eax, edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return ((uint64_t)edx << 32) | eax;
+}
+
+static void DetectCpuFeatures() {
+  unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+  int avx2 = 0;
+  int vnni = 0;
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & CPUID_OSXSAVE_BIT) && (ecx & CPUID_AVX_BIT) &&
+      (ecx & CPUID_FMA_BIT)) {
+    uint64_t xcr0 = ReadXcr0();
+    unsigned int ecx1 = ecx;
+    if ((xcr0 & XCR0_YMM_MASK) == XCR0_YMM_MASK && __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+      avx2 = (ebx & CPUID_AVX2_BIT) && (ecx1 & CPUID_FMA_BIT);
+      vnni = avx2 && (xcr0 & XCR0_ZMM_MASK) == XCR0_ZMM_MASK && (ebx & CPUID_AVX512F_BIT) &&
+             (ebx & CPUID_AVX512VL_BIT) && (ecx & CPUID_AVX512VNNI_BIT);
+    }
+  }
+  avx512_vnni_support = vnni ? 1 : 0;
+  avx2_support = avx2 ? 1 : 0;
+}
+
+bool X86SupportAvx2() {
+  if (avx2_support < 0) {
+    DetectCpuFeatures();
+  }
+  return avx2_support == 1;
+}
+
+bool X86SupportAvx512Vnni() {
+  if (avx2_support < 0) {
+    DetectCpuFeatures();
+  }
+  return avx512_vnni_support == 1;
+}
@@ -0,0 +1,127 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/x86_64/gemm_fp32_avx.h"
+#include <immintrin.h>
+#include <string.h>
+#include "nnacl/matmul_parameter.h"
+
+#define AVX2_TARGET __attribute__((target("avx2,fma")))
+
+AVX2_TARGET static inline __m256 LoadPartialFp32(const float *src, int num) {
+  if (num >= C8NUM) {
+    return _mm256_loadu_ps(src);
+  }
+  float buf[C8NUM] = {0};
+  memcpy(buf, src, num * sizeof(float));
+  return _mm256_loadu_ps(buf);
+}
+
+AVX2_TARGET static inline void StorePartialFp32(float *dst, __m256 value, int num) {
+  if (num >= C8NUM) {
+    _mm256_storeu_ps(dst, value);
+    return;
+  }
+  float buf[C8NUM];
+  _mm256_storeu_ps(buf, value);
+  memcpy(dst, buf, num * sizeof(float));
+}
+
+AVX2_TARGET static inline __m256 ActivateFp32(__m256 value, bool relu, bool relu6) {
+  if (relu6 && !relu) {
+    value = _mm256_min_ps(value, _mm256_set1_ps(6.0f));
+  }
+  if (relu || relu6) {
+    value = _mm256_max_ps(value, _mm256_setzero_ps());
+  }
+  return value;
+}
+
+AVX2_TARGET void MatmulFloatAvx2(const float *a, const float *b, float *c, const float *bias, int act_type, int depth,
+                                 int row, int col, size_t stride, bool write_nhwc) {
+  int row_8 = UP_ROUND(row, C8NUM);
+  int row_blocks = UP_DIV(row, C8NUM);
+  int col_blocks = UP_DIV(col, C8NUM);
+  bool relu6 = act_type == ActType_Relu6;
+  bool relu = act_type == ActType_Relu;
+  for (int cb = 0; cb < col_blocks; ++cb) {
+    const float *b_block = b + cb * depth * C8NUM;
+    int col_res = col - cb * C8NUM;
+    // the col8x8 layout also fills the padding columns, which read the padded bias like MatMul8x8 does
+    int bias_num = write_nhwc ? col_res : C8NUM;
+    __m256 bias_value = bias == NULL ? _mm256_setzero_ps() : LoadPartialFp32(bias + cb * C8NUM, bias_num);
+    for (int rb = 0; rb < row_blocks; ++rb) {
+      const float *a_block = a + rb * depth * C8NUM;
+      // one accumulator per row of the 8x8 tile, each holding 8 columns
+      __m256 acc[C8NUM];
+      for (int i = 0; i < C8NUM; ++i) {
+        acc[i] = bias_value;
+      }
+      for (int d = 0; d < depth; ++d) {
+        __m256 b_value = _mm256_loadu_ps(b_block + d * C8NUM);
+        const float *a_value = a_block + d * C8NUM;
+        for (int i = 0; i < C8NUM; ++i) {
+          acc[i] = _mm256_fmadd_ps(_mm256_broadcast_ss(a_value + i), b_value, acc[i]);
+        }
+      }
+      for (int i = 0; i < C8NUM; ++i) {
+        acc[i] = ActivateFp32(acc[i], relu, relu6);
+      }
+      if (write_nhwc) {
+        int row_res = MSMIN(row - rb * C8NUM, C8NUM);
+        for (int i = 0; i < row_res; ++i) {
+          StorePartialFp32(c + (rb * C8NUM + i) * stride + cb * C8NUM, acc[i], col_res);
+        }
+      } else {
+        float *dst = c + cb * row_8 * C8NUM + rb * C8NUM * C8NUM;
+        for (int i = 0; i < C8NUM; ++i) {
+          _mm256_storeu_ps(dst + i * C8NUM, acc[i]);
+        }
+      }
+    }
+  }
+}
+
+AVX2_TARGET void IndirectGemmFp32_8x8Avx2(float *output, const float *input, const float *weight, const float *bias,
+                                          size_t step, size_t ic4, size_t output_channel, size_t relu, size_t relu6) {
+  size_t oc_blocks = UP_DIV(output_channel, C8NUM);
+  size_t weight_block_size = step * ic4 * C4NUM * C8NUM;
+  for (size_t ob = 0; ob < oc_blocks; ++ob) {
+    const float *weight_block = weight + ob * weight_block_size;
+    int oc_res = (int)(output_channel - ob * C8NUM);
+    // one accumulator per pixel of the tile, each holding 8 output channels
+    __m256 acc[TILE_NUM];
+    __m256 bias_value = bias == NULL ? _mm256_setzero_ps() : LoadPartialFp32(bias + ob * C8NUM, oc_res);
+    for (int i = 0; i < TILE_NUM; ++i) {
+      acc[i] = bias_value;
+    }
+    for (size_t n = 0; n < step; ++n) {
+      for (size_t k = 0; k < ic4; ++k) {
+        const float *src = input + (n * ic4 + k) * TILE_NUM * C4NUM;
+        const float *w = weight_block + (n * ic4 + k) * C4NUM * C8NUM;
+        for (int m = 0; m < C4NUM; ++m) {
+          __m256 w_value = _mm256_loadu_ps(w + m * C8NUM);
+          for (int i = 0; i < TILE_NUM; ++i) {
+            acc[i] = _mm256_fmadd_ps(_mm256_broadcast_ss(src + i * C4NUM + m), w_value, acc[i]);
+          }
+        }
+      }
+    }
+    for (int i = 0; i < TILE_NUM; ++i) {
+      StorePartialFp32(output + i * output_channel + ob * C8NUM, ActivateFp32(acc[i], relu, relu6), oc_res);
+    }
+  }
+}
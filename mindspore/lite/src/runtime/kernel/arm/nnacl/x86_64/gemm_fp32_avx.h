@@ -0,0 +1,37 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_NNACL_X86_64_GEMM_FP32_AVX_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_NNACL_X86_64_GEMM_FP32_AVX_H_
+
+#include <stddef.h>
+#include "nnacl/op_base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// same packing as MatMul: a is col8-major, b is row8-major, act_type is ActType
+void MatmulFloatAvx2(const float *a, const float *b, float *c, const float *bias, int act_type, int depth, int row,
+                     int col, size_t stride, bool write_nhwc);
+
+// same packing as IndirectGemmFp32_8x8 with mode 0: one tile of TILE_NUM pixels written in nhwc
+void IndirectGemmFp32_8x8Avx2(float *output, const float *input, const float *weight, const float *bias, size_t step,
+                              size_t ic4, size_t output_channel, size_t relu, size_t relu6);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_NNACL_X86_64_GEMM_FP32_AVX_H_
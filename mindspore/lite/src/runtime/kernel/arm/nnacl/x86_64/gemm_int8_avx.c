@@ -0,0 +1,93 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/x86_64/gemm_int8_avx.h"
+#include <immintrin.h>
+
+#define AVX2_TARGET __attribute__((target("avx2,fma")))
+#define AVX512_VNNI_TARGET __attribute__((target("avx2,fma,avx512f,avx512vl,avx512vnni")))
+
+// 8 columns of two adjacent depths of b interleaved as int16 pairs: b[d][0], b[d+1][0], b[d][1], b[d+1][1], ...
+AVX2_TARGET static inline __m256i LoadDepthPairInt8(const int8_t *b, bool has_next, __m256i b_zp) {
+  __m128i cur = _mm_loadl_epi64((const __m128i *)b);
+  __m128i next = has_next ? _mm_loadl_epi64((const __m128i *)(b + C8NUM)) : _mm_setzero_si128();
+  // a missing odd depth is multiplied by a zero in the paired a value, so it never contributes
+  return _mm256_sub_epi16(_mm256_cvtepi8_epi16(_mm_unpacklo_epi8(cur, next)), b_zp);
+}
+
+// a[d][i] - a_zp and a[d+1][i] - a_zp packed as one int16 pair and broadcast to all lanes
+static inline int32_t PackDepthPairInt8(const int8_t *a, int i, bool has_next, int32_t a_zp) {
+  int32_t cur = (int32_t)a[i] - a_zp;
+  int32_t next = has_next ? (int32_t)a[C8NUM + i] - a_zp : 0;
+  return (int32_t)(((uint32_t)next << 16) | ((uint32_t)cur & 0xffff));
+}
+
+AVX2_TARGET void MatMulInt8Avx2(const int8_t *a, const int8_t *b, int32_t *c, const int row8, const int col8,
+                                const int deep, const int32_t a_zp, const int32_t b_zp) {
+  __m256i b_zp_value = _mm256_set1_epi16((int16_t)b_zp);
+  for (int cb = 0; cb < col8 / C8NUM; ++cb) {
+    const int8_t *b_block = b + cb * deep * C8NUM;
+    for (int rb = 0; rb < row8 / C8NUM; ++rb) {
+      const int8_t *a_block = a + rb * deep * C8NUM;
+      __m256i acc[C8NUM];
+      for (int i = 0; i < C8NUM; ++i) {
+        acc[i] = _mm256_setzero_si256();
+      }
+      for (int d = 0; d < deep; d += 2) {
+        bool has_next = d + 1 < deep;
+        __m256i b_value = LoadDepthPairInt8(b_block + d * C8NUM, has_next, b_zp_value);
+        const int8_t *a_value = a_block + d * C8NUM;
+        for (int i = 0; i < C8NUM; ++i) {
+          __m256i a_pair = _mm256_set1_epi32(PackDepthPairInt8(a_value, i, has_next, a_zp));
+          acc[i] = _mm256_add_epi32(acc[i], _mm256_madd_epi16(a_pair, b_value));
+        }
+      }
+      int32_t *dst = c + cb * row8 * C8NUM + rb * C8NUM * C8NUM;
+      for (int i = 0; i < C8NUM; ++i) {
+        _mm256_storeu_si256((__m256i *)(dst + i * C8NUM), acc[i]);
+      }
+    }
+  }
+}
+
+AVX512_VNNI_TARGET void MatMulInt8Avx512Vnni(const int8_t *a, const int8_t *b, int32_t *c, const int row8,
+                                             const int col8, const int deep, const int32_t a_zp, const int32_t b_zp) {
+  __m256i b_zp_value = _mm256_set1_epi16((int16_t)b_zp);
+  for (int cb = 0; cb < col8 / C8NUM; ++cb) {
+    const int8_t *b_block = b + cb * deep * C8NUM;
+    for (int rb = 0; rb < row8 / C8NUM; ++rb) {
+      const int8_t *a_block = a + rb * deep * C8NUM;
+      __m256i acc[C8NUM];
+      for (int i = 0; i < C8NUM; ++i) {
+        acc[i] = _mm256_setzero_si256();
+      }
+      for (int d = 0; d < deep; d += 2) {
+        bool has_next = d + 1 < deep;
+        __m256i b_value = LoadDepthPairInt8(b_block + d * C8NUM, has_next, b_zp_value);
+        const int8_t *a_value = a_block + d * C8NUM;
+        for (int i = 0; i < C8NUM; ++i) {
+          __m256i a_pair = _mm256_set1_epi32(PackDepthPairInt8(a_value, i, has_next, a_zp));
+          // vpdpwssd fuses the pairwise multiply and the accumulation
+          acc[i] = _mm256_dpwssd_epi32(acc[i], a_pair, b_value);
+        }
+      }
+      int32_t *dst = c + cb * row8 * C8NUM + rb * C8NUM * C8NUM;
+      for (int i = 0; i < C8NUM; ++i) {
+        _mm256_storeu_si256((__m256i *)(dst + i * C8NUM), acc[i]);
+      }
+    }
+  }
+}
@@ -0,0 +1,34 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_NNACL_X86_64_GEMM_INT8_AVX_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_NNACL_X86_64_GEMM_INT8_AVX_H_
+
+#include "nnacl/op_base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// same packing and result layout as MatMulInt8: a is col8-major, b is row8-major, c is row8x8-major
+void MatMulInt8Avx2(const int8_t *a, const int8_t *b, int32_t *c, const int row8, const int col8, const int deep,
+                    const int32_t a_zp, const int32_t b_zp);
+void MatMulInt8Avx512Vnni(const int8_t *a, const int8_t *b, int32_t *c, const int row8, const int col8,
+                          const int deep, const int32_t a_zp, const int32_t b_zp);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_ARM_NNACL_X86_64_GEMM_INT8_AVX_H_
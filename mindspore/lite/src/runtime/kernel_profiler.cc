@@ -0,0 +1,291 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/kernel_profiler.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include "include/errorcode.h"
+#include "src/common/utils.h"
+#include "src/runtime/thread_pool.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore::lite {
+namespace {
+uint64_t LastDim(const tensor::Tensor *tensor) {
+  auto &shape = tensor->shape();
+  return (shape.empty() || shape.back() <= 0) ? 0 : static_cast<uint64_t>(shape.back());
+}
+
+// multiply-adds count as two flops, kernels without a dedicated formula count one flop per output element
+uint64_t EstimateFlops(kernel::LiteKernel *kernel) {
+  auto &inputs = kernel->in_tensors();
+  auto &outputs = kernel->out_tensors();
+  if (outputs.empty() || outputs.front() == nullptr) {
+    return 0;
+  }
+  uint64_t out_elements = outputs.front()->ElementsNum();
+  switch (kernel->Type()) {
+    case schema::PrimitiveType_Conv2D:
+    case schema::PrimitiveType_DepthwiseConv2D: {
+      // every output element reads one output channel's share of the weight
+      auto out_channel = LastDim(outputs.front());
+      if (inputs.size() < 2 || out_channel == 0) {
+        break;
+      }
+      return 2 * out_elements * inputs[1]->ElementsNum() / out_channel;
+    }
+    case schema::PrimitiveType_DeConv2D:
+    case schema::PrimitiveType_DeDepthwiseConv2D: {
+      // every input element scatters into one input channel's share of the weight
+      auto in_channel = inputs.empty() ? 0 : LastDim(inputs.front());
+      if (inputs.size() < 2 || in_channel == 0) {
+        break;
+      }
+      return 2 * static_cast<uint64_t>(inputs[0]->ElementsNum()) * inputs[1]->ElementsNum() / in_channel;
+    }
+    case schema::PrimitiveType_MatMul:
+    case schema::PrimitiveType_FullConnection: {
+      auto col = LastDim(outputs.front());
+      if (inputs.empty() || out_elements == 0) {
+        break;
+      }
+      uint64_t depth = static_cast<uint64_t>(inputs[0]->ElementsNum()) * col / out_elements;
+      return 2 * out_elements * depth;
+    }
+    default:
+      break;
+  }
+  return out_elements;
+}
+
+uint64_t Percentile(const std::vector<uint64_t> &sorted, int percent) {
+  if (sorted.empty()) {
+    return 0;
+  }
+  // nearest rank
+  auto rank = static_cast<size_t>(std::ceil(percent / 100.0 * sorted.size()));
+  return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+std::string JsonEscape(const std::string &str) {
+  std::string escaped;
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      escaped.push_back('\\');
+      escaped.push_back(c);
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char buf[8];
+      snprintf(buf, sizeof(buf), "\\u%04x", c);
+      escaped.append(buf);
+    } else {
+      escaped.push_back(c);
+    }
+  }
+  return escaped;
+}
+
+int WriteFile(const std::string &path, const std::string &content) {
+  std::ofstream ofs(path, std::ios::out | std::ios::trunc);
+  if (!ofs.is_open()) {
+    MS_LOG(ERROR) << "Open file failed: " << path;
+    return RET_ERROR;
+  }
+  ofs << content;
+  ofs.close();
+  if (ofs.fail()) {
+    MS_LOG(ERROR) << "Write file failed: " << path;
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+}  // namespace
+
+KernelProfiler::KernelProfiler(int thread_num) : thread_num_(std::max(thread_num, 1)), origin_us_(GetTimeUs()) {}
+
+KernelProfiler::~KernelProfiler() = default;
+
+KernelProfiler::Mark KernelProfiler::Begin(Allocator *allocator) const {
+  Mark mark;
+  mark.allocated = allocator == nullptr ? 0 : allocator->GetTotalSize();
+  // only the launches of this kernel count, the pool may be running tasks of other sessions
+  predict::ThreadPool::SetBusyTimeCounter(&busy_ns_);
+  mark.busy_ns = busy_ns_.load();
+  mark.begin_us = GetTimeUs();
+  return mark;
+}
+
+void KernelProfiler::End(kernel::LiteKernel *kernel, const Mark &mark, Allocator *allocator, bool exclusive) {
+  MS_ASSERT(kernel != nullptr);
+  auto end_us = GetTimeUs();
+  predict::ThreadPool::SetBusyTimeCounter(nullptr);
+  auto busy_ns = busy_ns_.load();
+  auto allocated = allocator == nullptr ? 0 : allocator->GetTotalSize();
+  uint64_t duration_us = end_us > mark.begin_us ? end_us - mark.begin_us : 0;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto iter = record_index_.find(kernel->name());
+  if (iter == record_index_.end()) {
+    iter = record_index_.emplace(kernel->name(), records_.size()).first;
+    records_.emplace_back();
+    records_.back().name = kernel->name();
+    records_.back().type = kernel->type_str();
+  }
+  auto &record = records_[iter->second];
+  record.durations_us.emplace_back(duration_us);
+  record.flops += EstimateFlops(kernel);
+  for (auto *output : kernel->out_tensors()) {
+    record.output_bytes = std::max(record.output_bytes, output == nullptr ? 0 : output->Size());
+  }
+  if (allocated > mark.allocated) {
+    record.allocated_bytes = std::max(record.allocated_bytes, allocated - mark.allocated);
+  }
+  // a kernel without intra-op tasks still keeps the thread running it busy; in a parallel run the pool time of
+  // concurrent kernels can not be told apart, so only the own thread is accounted
+  uint64_t wall_ns = duration_us * 1000;
+  uint64_t pool_ns = busy_ns > mark.busy_ns ? busy_ns - mark.busy_ns : 0;
+  record.busy_ns += exclusive ? std::max(pool_ns, wall_ns) : wall_ns;
+  events_.push_back({iter->second, mark.begin_us > origin_us_ ? mark.begin_us - origin_us_ : 0, duration_us,
+                     ThreadIndex()});
+}
+
+int KernelProfiler::ThreadIndex() {
+  auto result = thread_index_.emplace(std::this_thread::get_id(), static_cast<int>(thread_index_.size()));
+  return result.first->second;
+}
+
+void KernelProfiler::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  record_index_.clear();
+  records_.clear();
+  events_.clear();
+  thread_index_.clear();
+  origin_us_ = GetTimeUs();
+}
+
+std::vector<KernelProfiler::KernelSummary> KernelProfiler::Summarize() const {
+  std::vector<KernelSummary> summaries;
+  for (auto &record : records_) {
+    auto sorted = record.durations_us;
+    std::sort(sorted.begin(), sorted.end());
+    KernelSummary summary;
+    summary.record = &record;
+    summary.total_us = 0;
+    for (auto duration : sorted) {
+      summary.total_us += duration;
+    }
+    summary.avg_us = sorted.empty() ? 0 : static_cast<double>(summary.total_us) / sorted.size();
+    summary.p50_us = Percentile(sorted, 50);
+    summary.p90_us = Percentile(sorted, 90);
+    summary.p99_us = Percentile(sorted, 99);
+    summary.min_us = sorted.empty() ? 0 : sorted.front();
+    summary.max_us = sorted.empty() ? 0 : sorted.back();
+    // flops per nanosecond are gflops per second
+    summary.gflops = summary.total_us == 0 ? 0 : static_cast<double>(record.flops) / (summary.total_us * 1000.0);
+    summary.utilization =
+      summary.total_us == 0 ? 0 : static_cast<double>(record.busy_ns) / (summary.total_us * 1000.0 * thread_num_);
+    summary.utilization = std::min(summary.utilization, 1.0);
+    summaries.emplace_back(summary);
+  }
+  return summaries;
+}
+
+std::string KernelProfiler::Summary(const std::string &sort_key) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto summaries = Summarize();
+  using Less = bool (*)(const KernelSummary &, const KernelSummary &);
+  static const std::unordered_map<std::string, Less> kSortKeys = {
+    {"total", [](const KernelSummary &a, const KernelSummary &b) { return a.total_us > b.total_us; }},
+    {"avg", [](const KernelSummary &a, const KernelSummary &b) { return a.avg_us > b.avg_us; }},
+    {"p50", [](const KernelSummary &a, const KernelSummary &b) { return a.p50_us > b.p50_us; }},
+    {"p90", [](const KernelSummary &a, const KernelSummary &b) { return a.p90_us > b.p90_us; }},
+    {"p99", [](const KernelSummary &a, const KernelSummary &b) { return a.p99_us > b.p99_us; }},
+    {"max", [](const KernelSummary &a, const KernelSummary &b) { return a.max_us > b.max_us; }},
+    {"flops", [](const KernelSummary &a, const KernelSummary &b) { return a.record->flops > b.record->flops; }},
+    {"name", [](const KernelSummary &a, const KernelSummary &b) { return a.record->name < b.record->name; }}};
+  auto sort_iter = kSortKeys.find(sort_key);
+  if (sort_iter == kSortKeys.end()) {
+    MS_LOG(ERROR) << "Invalid sort key: " << sort_key
+                  << ", should be one of total, avg, p50, p90, p99, max, flops, name";
+    return "";
+  }
+  std::stable_sort(summaries.begin(), summaries.end(), sort_iter->second);
+  uint64_t graph_total_us = 0;
+  for (auto &summary : summaries) {
+    graph_total_us += summary.total_us;
+  }
+
+  std::ostringstream oss;
+  oss << std::left << std::setw(40) << "name" << std::setw(24) << "type" << std::right << std::setw(8) << "runs"
+      << std::setw(11) << "avg(ms)" << std::setw(11) << "p50(ms)" << std::setw(11) << "p90(ms)" << std::setw(11)
+      << "p99(ms)" << std::setw(11) << "min(ms)" << std::setw(11) << "max(ms)" << std::setw(9) << "total%"
+      << std::setw(10) << "GFLOPS" << std::setw(8) << "util%" << std::setw(12) << "out(KB)" << std::setw(12)
+      << "alloc(KB)" << "\n";
+  oss << std::fixed;
+  for (auto &summary : summaries) {
+    auto &record = *summary.record;
+    double percent = graph_total_us == 0 ? 0 : 100.0 * summary.total_us / graph_total_us;
+    oss << std::left << std::setw(40) << record.name << std::setw(24) << record.type << std::right << std::setw(8)
+        << record.durations_us.size() << std::setprecision(3) << std::setw(11) << summary.avg_us / 1000
+        << std::setw(11) << summary.p50_us / 1000.0 << std::setw(11) << summary.p90_us / 1000.0 << std::setw(11)
+        << summary.p99_us / 1000.0 << std::setw(11) << summary.min_us / 1000.0 << std::setw(11)
+        << summary.max_us / 1000.0 << std::setprecision(2) << std::setw(9) << percent << std::setw(10)
+        << summary.gflops << std::setw(8) << summary.utilization * 100 << std::setw(12)
+        << record.output_bytes / 1024.0 << std::setw(12) << record.allocated_bytes / 1024.0 << "\n";
+  }
+  oss << "total(ms): " << std::setprecision(3) << graph_total_us / 1000.0 << ", threads: " << thread_num_ << "\n";
+  return oss.str();
+}
+
+int KernelProfiler::WriteSummaryJson(const std::string &path) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto summaries = Summarize();
+  std::ostringstream oss;
+  oss << "[";
+  for (size_t i = 0; i < summaries.size(); ++i) {
+    auto &summary = summaries[i];
+    auto &record = *summary.record;
+    oss << (i == 0 ? "\n" : ",\n") << "  {\"name\": \"" << JsonEscape(record.name) << "\", \"type\": \""
+        << JsonEscape(record.type) << "\", \"runs\": " << record.durations_us.size()
+        << ", \"total_us\": " << summary.total_us << ", \"avg_us\": " << summary.avg_us
+        << ", \"p50_us\": " << summary.p50_us << ", \"p90_us\": " << summary.p90_us
+        << ", \"p99_us\": " << summary.p99_us << ", \"min_us\": " << summary.min_us
+        << ", \"max_us\": " << summary.max_us << ", \"flops\": " << record.flops << ", \"gflops\": " << summary.gflops
+        << ", \"utilization\": " << summary.utilization << ", \"output_bytes\": " << record.output_bytes
+        << ", \"allocated_bytes\": " << record.allocated_bytes << "}";
+  }
+  oss << "\n]\n";
+  return WriteFile(path, oss.str());
+}
+
+int KernelProfiler::WriteChromeTrace(const std::string &path) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::ostringstream oss;
+  oss << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  for (size_t i = 0; i < events_.size(); ++i) {
+    auto &event = events_[i];
+    auto &record = records_[event.record];
+    oss << (i == 0 ? "\n" : ",\n") << "  {\"name\": \"" << JsonEscape(record.name) << "\", \"cat\": \""
+        << JsonEscape(record.type) << "\", \"ph\": \"X\", \"ts\": " << event.begin_us
+        << ", \"dur\": " << event.duration_us << ", \"pid\": 0, \"tid\": " << event.tid << "}";
+  }
+  oss << "\n]}\n";
+  return WriteFile(path, oss.str());
+}
+}  // namespace mindspore::lite
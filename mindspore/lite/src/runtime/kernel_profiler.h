@@ -0,0 +1,105 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_PROFILER_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_PROFILER_H_
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "include/profiler.h"
+#include "src/runtime/allocator.h"
+#include "src/lite_kernel.h"
+
+namespace mindspore::lite {
+// Records every kernel run of the executors of one session. Timing is taken on the thread running the kernel, so the
+// records of kernels running concurrently in a parallel run are guarded by a mutex.
+class KernelProfiler : public session::Profiler {
+ public:
+  // state sampled right before a kernel runs
+  struct Mark {
+    uint64_t begin_us = 0;
+    uint64_t busy_ns = 0;
+    size_t allocated = 0;
+  };
+
+  explicit KernelProfiler(int thread_num);
+  ~KernelProfiler() override;
+
+  Mark Begin(Allocator *allocator) const;
+
+  // exclusive means the kernel had the thread pool to itself, so the pool busy time and the allocator growth during
+  // the run belong to it; pass allocator nullptr to skip the allocator growth
+  void End(kernel::LiteKernel *kernel, const Mark &mark, Allocator *allocator, bool exclusive);
+
+  void Clear() override;
+
+  std::string Summary(const std::string &sort_key) const override;
+
+  int WriteSummaryJson(const std::string &path) const override;
+
+  int WriteChromeTrace(const std::string &path) const override;
+
+ private:
+  struct KernelRecord {
+    std::string name;
+    std::string type;
+    std::vector<uint64_t> durations_us;
+    uint64_t flops = 0;
+    size_t output_bytes = 0;
+    size_t allocated_bytes = 0;
+    uint64_t busy_ns = 0;
+  };
+
+  struct TraceEvent {
+    size_t record;
+    uint64_t begin_us;
+    uint64_t duration_us;
+    int tid;
+  };
+
+  struct KernelSummary {
+    const KernelRecord *record;
+    uint64_t total_us;
+    double avg_us;
+    uint64_t p50_us;
+    uint64_t p90_us;
+    uint64_t p99_us;
+    uint64_t min_us;
+    uint64_t max_us;
+    double gflops;
+    double utilization;
+  };
+
+  std::vector<KernelSummary> Summarize() const;
+  int ThreadIndex();
+
+  int thread_num_;
+  uint64_t origin_us_;
+  mutable std::mutex mutex_;
+  // time the pool spent in tasks launched by the kernels of this session
+  mutable std::atomic<uint64_t> busy_ns_ = {0};
+  std::unordered_map<std::string, size_t> record_index_;
+  std::vector<KernelRecord> records_;
+  std::vector<TraceEvent> events_;
+  std::unordered_map<std::thread::id, int> thread_index_;
+};
+}  // namespace mindspore::lite
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_PROFILER_H_
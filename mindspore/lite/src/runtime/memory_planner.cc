@@ -0,0 +1,215 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/runtime/memory_planner.h"
+#include <algorithm>
+#include <unordered_map>
+#include "include/errorcode.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore::lite {
+namespace {
+constexpr size_t kArenaAlignment = 64;
+
+size_t AlignSize(size_t size) { return (size + kArenaAlignment - 1) / kArenaAlignment * kArenaAlignment; }
+}  // namespace
+
+MemoryPlanner::~MemoryPlanner() { Clear(); }
+
+int MemoryPlanner::CollectLifetimes(const std::vector<kernel::LiteKernel *> &kernels,
+                                    const std::vector<size_t> &steps) {
+  std::unordered_map<tensor::Tensor *, size_t> tensor_index;
+  size_t kernel_count = kernels.size();
+  size_t last_step = steps.empty() ? 0 : *std::max_element(steps.begin(), steps.end()) + 1;
+  for (size_t i = 0; i < kernel_count; ++i) {
+    size_t step = steps[i];
+    auto *kernel = kernels[i];
+    MS_ASSERT(kernel != nullptr);
+    auto primitive = kernel->GetPrimitive();
+    if (primitive != nullptr && !primitive->GetInferFlag()) {
+      MS_LOG(INFO) << "Shape of kernel " << kernel->name() << " is inferred at runtime, skip memory planning";
+      return RET_INFER_INVALID;
+    }
+    for (auto *in_tensor : kernel->in_tensors()) {
+      auto iter = tensor_index.find(in_tensor);
+      if (iter != tensor_index.end()) {
+        lifetimes_[iter->second].end = std::max(lifetimes_[iter->second].end, step);
+      }
+    }
+    // only tensors produced by cpu kernels live in host memory
+    if (kernel->desc().arch != kernel::KERNEL_ARCH::kCPU) {
+      continue;
+    }
+    for (auto *out_tensor : kernel->out_tensors()) {
+      MS_ASSERT(out_tensor != nullptr);
+      if (tensor_index.find(out_tensor) != tensor_index.end()) {
+        continue;
+      }
+      auto size = out_tensor->Size();
+      if (size == 0) {
+        MS_LOG(INFO) << "Output of kernel " << kernel->name() << " has unknown size, skip memory planning";
+        return RET_INFER_INVALID;
+      }
+      // graph outputs are read by the user after RunGraph, keep them alive until the end
+      size_t end = kernel->is_model_output() ? last_step : step;
+      tensor_index[out_tensor] = lifetimes_.size();
+      lifetimes_.push_back({out_tensor, out_tensor->allocator(), AlignSize(size), step, end, 0});
+    }
+  }
+  return RET_OK;
+}
+
+size_t MemoryPlanner::AssignOffsets() {
+  std::vector<TensorLifetime *> order;
+  for (auto &lifetime : lifetimes_) {
+    order.emplace_back(&lifetime);
+  }
+  // greedy by size: place big tensors first, each one at the lowest offset not used by a live placed tensor
+  std::stable_sort(order.begin(), order.end(),
+                   [](const TensorLifetime *a, const TensorLifetime *b) { return a->size > b->size; });
+  std::vector<TensorLifetime *> placed;
+  size_t total_size = 0;
+  for (auto *cur : order) {
+    std::vector<TensorLifetime *> conflicts;
+    for (auto *other : placed) {
+      if (other->begin <= cur->end && cur->begin <= other->end) {
+        conflicts.emplace_back(other);
+      }
+    }
+    std::sort(conflicts.begin(), conflicts.end(),
+              [](const TensorLifetime *a, const TensorLifetime *b) { return a->offset < b->offset; });
+    size_t offset = 0;
+    for (auto *other : conflicts) {
+      if (other->offset >= offset + cur->size) {
+        break;
+      }
+      offset = std::max(offset, other->offset + other->size);
+    }
+    cur->offset = offset;
+    total_size = std::max(total_size, offset + cur->size);
+    placed.emplace_back(cur);
+  }
+  return total_size;
+}
+
+int MemoryPlanner::Plan(const std::vector<kernel::LiteKernel *> &kernels) {
+  std::vector<size_t> steps(kernels.size());
+  for (size_t i = 0; i < steps.size(); ++i) {
+    steps[i] = i;
+  }
+  return Plan(kernels, steps);
+}
+
+int MemoryPlanner::Plan(const std::vector<kernel::LiteKernel *> &kernels, const std::vector<size_t> &steps) {
+  Unbind();
+  if (kernels.size() != steps.size()) {
+    MS_LOG(ERROR) << "Kernels size " << kernels.size() << " is not equal to steps size " << steps.size();
+    return RET_PARAM_INVALID;
+  }
+  auto ret = CollectLifetimes(kernels, steps);
+  if (ret != RET_OK) {
+    lifetimes_.clear();
+    return ret;
+  }
+  auto total_size = AssignOffsets();
+  if (total_size > arena_size_) {
+    free(arena_);
+    arena_size_ = 0;
+    arena_ = reinterpret_cast<char *>(malloc(total_size));
+    if (arena_ == nullptr) {
+      MS_LOG(ERROR) << "Malloc memory arena failed, size: " << total_size;
+      lifetimes_.clear();
+      return RET_MEMORY_FAILED;
+    }
+    arena_size_ = total_size;
+  }
+  planned_ = true;
+  Attach();
+  MS_LOG(DEBUG) << "Plan " << lifetimes_.size() << " tensors into memory arena of size " << arena_size_;
+  return RET_OK;
+}
+
+std::vector<std::pair<tensor::Tensor *, tensor::Tensor *>> MemoryPlanner::ReusedMemory() const {
+  std::vector<std::pair<tensor::Tensor *, tensor::Tensor *>> reused;
+  for (auto &first : lifetimes_) {
+    for (auto &second : lifetimes_) {
+      bool share = first.offset < second.offset + second.size && second.offset < first.offset + first.size;
+      if (share && first.end < second.begin) {
+        reused.emplace_back(first.tensor, second.tensor);
+      }
+    }
+  }
+  return reused;
+}
+
+void MemoryPlanner::Attach() {
+  if (!planned_) {
+    return;
+  }
+  for (auto &lifetime : lifetimes_) {
+    // release buffers left over from dynamic allocation before binding the tensor to the arena
+    lifetime.tensor->FreeData();
+    lifetime.tensor->set_allocator(this);
+    lifetime.tensor->SetData(arena_ + lifetime.offset);
+  }
+}
+
+void MemoryPlanner::Detach() {
+  for (auto &lifetime : lifetimes_) {
+    // the tensor may be bound to another plan by now
+    if (lifetime.tensor->allocator() != this) {
+      continue;
+    }
+    if (InArena(lifetime.tensor->Data())) {
+      lifetime.tensor->SetData(nullptr);
+    }
+    lifetime.tensor->set_allocator(lifetime.origin_allocator);
+  }
+}
+
+void MemoryPlanner::Unbind() {
+  Detach();
+  lifetimes_.clear();
+  planned_ = false;
+}
+
+bool MemoryPlanner::InArena(const void *ptr) const {
+  auto addr = reinterpret_cast<const char *>(ptr);
+  return arena_ != nullptr && addr >= arena_ && addr < arena_ + arena_size_;
+}
+
+void *MemoryPlanner::Malloc(size_t size) {
+  if (size > MAX_MALLOC_SIZE) {
+    MS_LOG(ERROR) << "MallocData out of max_size, size: " << size;
+    return nullptr;
+  }
+  return malloc(size);
+}
+
+void MemoryPlanner::Free(void *ptr) {
+  if (ptr == nullptr || InArena(ptr)) {
+    return;
+  }
+  free(ptr);
+}
+
+void MemoryPlanner::Clear() {
+  Unbind();
+  free(arena_);
+  arena_ = nullptr;
+  arena_size_ = 0;
+}
+}  // namespace mindspore::lite
@@ -0,0 +1,82 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_MEMORY_PLANNER_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_MEMORY_PLANNER_H_
+
+#include <utility>
+#include <vector>
+#include "src/runtime/allocator.h"
+#include "src/lite_kernel.h"
+
+namespace mindspore::lite {
+// Plans all intermediate tensors of a topologically sorted kernel list into one arena. Every tensor gets a fixed
+// offset computed from its lifetime, tensors whose lifetimes do not overlap share memory, and the tensors stay bound
+// to the arena across runs, so running the graph needs neither malloc nor free for intermediates.
+class MemoryPlanner : public Allocator {
+ public:
+  MemoryPlanner() { name = "memory_planner"; }
+  ~MemoryPlanner() override;
+
+  // return RET_INFER_INVALID if some shape is only known at runtime, the caller should fall back to dynamic memory
+  int Plan(const std::vector<kernel::LiteKernel *> &kernels);
+
+  // kernels sharing the same step may run concurrently, their tensors never share memory
+  int Plan(const std::vector<kernel::LiteKernel *> &kernels, const std::vector<size_t> &steps);
+
+  bool IsPlanned() const { return planned_; }
+
+  // pairs of planned tensors sharing memory, the lifetime of the first one ends before the second one begins
+  std::vector<std::pair<tensor::Tensor *, tensor::Tensor *>> ReusedMemory() const;
+
+  // unbind the planned tensors but keep the plan and the arena, so Attach can bind them again without planning
+  void Detach();
+
+  void Attach();
+
+  // fall back for tensors which are released and malloced again outside the plan
+  void *Malloc(size_t size) override;
+
+  void Free(void *ptr) override;
+
+  size_t GetTotalSize() override { return arena_size_; }
+
+  // unbind all planned tensors and release the arena
+  void Clear() override;
+
+ private:
+  struct TensorLifetime {
+    tensor::Tensor *tensor;
+    Allocator *origin_allocator;
+    size_t size;
+    size_t begin;
+    size_t end;
+    size_t offset;
+  };
+
+  int CollectLifetimes(const std::vector<kernel::LiteKernel *> &kernels, const std::vector<size_t> &steps);
+  size_t AssignOffsets();
+  void Unbind();
+  bool InArena(const void *ptr) const;
+
+  std::vector<TensorLifetime> lifetimes_;
+  char *arena_ = nullptr;
+  size_t arena_size_ = 0;
+  bool planned_ = false;
+};
+}  // namespace mindspore::lite
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_MEMORY_PLANNER_H_
@@ -15,55 +15,230 @@
  */
 
 #include "src/runtime/parallel_executor.h"
+#include <algorithm>
+#include <thread>
+#include "src/common/ms_tensor_utils.h"
+#include "src/common/utils.h"
+#include "src/runtime/runtime_api.h"
 using mindspore::predict::ThreadPool;
 using mindspore::predict::TvmEnv;
-#define MAX_THREAD_NUM 8
 namespace mindspore::lite {
-ParallelExecutor::~ParallelExecutor() {
-  delete pool;
-  pool = nullptr;
-}
 int ParallelExecutor::Prepare(std::vector<mindspore::kernel::LiteKernel *> &kernels) {
-  pool = new ThreadPool();
-  pool->ConfigThreadPool(NO_BIND, MAX_THREAD_NUM);
-  for (mindspore::kernel::LiteKernel *kernel : kernels) {
-    refCount[kernel] = kernel->out_kernels().size();
+  producers_.clear();
+  consumers_.clear();
+  for (auto *kernel : kernels) {
+    producers_[kernel];
+    consumers_[kernel];
+  }
+  for (auto *kernel : kernels) {
+    for (auto *in_kernel : kernel->in_kernels()) {
+      if (producers_.find(in_kernel) != producers_.end()) {
+        AddEdge(in_kernel, kernel);
+      }
+    }
+  }
+  // tensor lifetimes are measured in waves, the memory edges keep a kernel from overwriting memory which a slower
+  // kernel of an earlier wave still uses
+  std::unordered_map<kernel::LiteKernel *, size_t> wave;
+  std::vector<size_t> steps;
+  for (auto *kernel : kernels) {
+    size_t step = 0;
+    for (auto *in_kernel : producers_[kernel]) {
+      step = std::max(step, wave[in_kernel] + 1);
+    }
+    wave[kernel] = step;
+    steps.emplace_back(step);
+  }
+  auto ret = memory_planner_.Plan(kernels, steps);
+  if (ret == RET_INFER_INVALID) {
+    MS_LOG(WARNING) << "Some shapes are only known at runtime, fall back to dynamic memory";
+    return RET_OK;
+  }
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "Plan static memory failed: " << ret;
+    return ret;
+  }
+  AddMemoryEdges(kernels);
+  return RET_OK;
+}
+
+void ParallelExecutor::AddEdge(kernel::LiteKernel *producer, kernel::LiteKernel *consumer) {
+  // in_kernels/out_kernels may hold one kernel several times, keep each edge once
+  if (producer == consumer || IsContain(producers_[consumer], producer)) {
+    return;
+  }
+  producers_[consumer].emplace_back(producer);
+  consumers_[producer].emplace_back(consumer);
+}
+
+void ParallelExecutor::AddMemoryEdges(const std::vector<kernel::LiteKernel *> &kernels) {
+  std::unordered_map<tensor::Tensor *, std::vector<kernel::LiteKernel *>> users;
+  std::unordered_map<tensor::Tensor *, kernel::LiteKernel *> writers;
+  for (auto *kernel : kernels) {
+    for (auto *in_tensor : kernel->in_tensors()) {
+      users[in_tensor].emplace_back(kernel);
+    }
+    for (auto *out_tensor : kernel->out_tensors()) {
+      users[out_tensor].emplace_back(kernel);
+      writers[out_tensor] = kernel;
+    }
+  }
+  // the lifetimes of the tensors sharing memory end in an earlier wave, so the edges never close a cycle
+  for (auto &reused : memory_planner_.ReusedMemory()) {
+    auto writer = writers.find(reused.second);
+    if (writer == writers.end()) {
+      continue;
+    }
+    for (auto *user : users[reused.first]) {
+      AddEdge(user, writer->second);
+    }
+  }
+}
+
+static int LaunchOnLanes(LiteParallelTaskLambda task, void *cdata, int num_task, void *launcher_data) {
+  auto executor = reinterpret_cast<ParallelExecutor *>(launcher_data);
+  return executor->LaunchTasks(task, cdata, num_task);
+}
+
+static int RunLaneTask(int task_id, TvmEnv *env, void *data) {
+  auto executor = reinterpret_cast<ParallelExecutor *>(data);
+  // the pool is busy with the lanes, parallel launches of the kernels are shared out among the lanes
+  SetParallelLauncher(LaunchOnLanes, executor);
+  executor->RunLane();
+  SetParallelLauncher(nullptr, nullptr);
+  return 0;
+}
+
+void ParallelExecutor::RunTasks(Launch *launch) {
+  for (int task = launch->next_task++; task < launch->num_task; task = launch->next_task++) {
+    if (launch->task(task, launch->cdata) != 0) {
+      launch->failed = true;
+    }
+    --launch->pending_tasks;
   }
 }
 
-void ParallelExecutor::PrepareReadyKernels(const std::vector<mindspore::kernel::LiteKernel *> &kernels) {
-  for (auto iter = refCount.begin(); iter != refCount.end();) {
-    if (iter->second == 0) {
-      readyKernels.emplace_back(iter->first);
-      iter = refCount.erase(iter);
-    } else {
-      iter++;
+int ParallelExecutor::LaunchTasks(LiteParallelTaskLambda task, void *cdata, int num_task) {
+  Launch launch;
+  launch.task = task;
+  launch.cdata = cdata;
+  launch.num_task = num_task;
+  launch.pending_tasks = num_task;
+  if (num_task > 1) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    launches_.emplace_back(&launch);
+    cond_.notify_all();
+  }
+  RunTasks(&launch);
+  if (num_task > 1) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = std::find(launches_.begin(), launches_.end(), &launch);
+    if (iter != launches_.end()) {
+      launches_.erase(iter);
     }
   }
-  results.resize(readyKernels.size());
+  // helpers leave the launch alone after they decreased helpers
+  while (launch.pending_tasks.load() != 0 || launch.helpers.load() != 0) {
+    std::this_thread::yield();
+  }
+  return launch.failed ? RET_ERROR : RET_OK;
 }
 
-static int RunKernel(int index, TvmEnv *env, void *data) {
-  ParallelExecutor *executor = reinterpret_cast<ParallelExecutor *>(data);
-  auto kernel = executor->GetReadyKernel(index);
+int ParallelExecutor::RunKernel(kernel::LiteKernel *kernel) {
+  if (before_ != nullptr && *before_ != nullptr) {
+    if (!(*before_)(PackToMSTensors(kernel->in_tensors()), PackToMSTensors(kernel->out_tensors()),
+                    {kernel->name(), kernel->type_str()})) {
+      MS_LOG(ERROR) << "run kernel before_callback failed, name: " << kernel->name();
+    }
+  }
+  // a kernel of a single lane run has the thread pool to itself
+  auto allocator = single_lane_ ? allocator_ : nullptr;
+  KernelProfiler::Mark mark;
+  if (profiler_ != nullptr) {
+    mark = profiler_->Begin(allocator);
+  }
   auto ret = kernel->Run();
-  executor->SetResult(index, ret);
-  if (0 != ret) {
+  if (profiler_ != nullptr) {
+    profiler_->End(kernel, mark, allocator, single_lane_);
+  }
+  if (ret != RET_OK) {
     MS_LOG(ERROR) << "run kernel failed, name: " << kernel->name();
-    return 0;
+    return ret;
   }
+  if (after_ != nullptr && *after_ != nullptr) {
+    if (!(*after_)(PackToMSTensors(kernel->in_tensors()), PackToMSTensors(kernel->out_tensors()),
+                   {kernel->name(), kernel->type_str()})) {
+      MS_LOG(ERROR) << "run kernel after_callback failed, name: " << kernel->name();
+    }
+  }
+  return RET_OK;
+}
 
+void ParallelExecutor::FinishKernel(kernel::LiteKernel *kernel) {
+  unfinished_kernels_--;
+  for (auto *consumer : consumers_[kernel]) {
+    auto iter = wait_count_.find(consumer);
+    if (iter != wait_count_.end() && --iter->second == 0) {
+      ready_kernels_.emplace_back(consumer);
+    }
+  }
+  if (static_memory_) {
+    return;
+  }
   for (auto input_kernel : kernel->in_kernels()) {
     MS_ASSERT(input_kernel != nullptr);
     if (input_kernel->is_model_output()) {
       continue;
     }
-    ret = input_kernel->DecOutTensorRefCount();
+    auto ret = input_kernel->DecOutTensorRefCount();
     if (0 != ret) {
       MS_LOG(WARNING) << "DecOutTensorRefCount for kernel" << kernel->name() << " failed";
     }
   }
-  return 0;
+}
+
+void ParallelExecutor::RunLane() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    cond_.wait(lock, [this] {
+      return !ready_kernels_.empty() || !launches_.empty() || running_kernels_ == 0 || result_ != RET_OK;
+    });
+    if (result_ != RET_OK) {
+      return;
+    }
+    if (!ready_kernels_.empty()) {
+      auto *kernel = ready_kernels_.front();
+      ready_kernels_.pop_front();
+      running_kernels_++;
+      lock.unlock();
+      auto ret = RunKernel(kernel);
+      lock.lock();
+      running_kernels_--;
+      if (ret != RET_OK) {
+        result_ = ret;
+      } else {
+        FinishKernel(kernel);
+      }
+      cond_.notify_all();
+      continue;
+    }
+    if (!launches_.empty()) {
+      auto *launch = launches_.front();
+      launch->helpers++;
+      lock.unlock();
+      RunTasks(launch);
+      lock.lock();
+      // all its tasks are taken, nobody needs to help any more
+      auto iter = std::find(launches_.begin(), launches_.end(), launch);
+      if (iter != launches_.end()) {
+        launches_.erase(iter);
+      }
+      launch->helpers--;
+      continue;
+    }
+    // nothing runs and nothing is ready, either all kernels finished or the rest never gets ready
+    return;
+  }
 }
 
 int ParallelExecutor::Run(std::vector<tensor::Tensor *> &in_tensors, std::vector<tensor::Tensor *> &out_tensors,
@@ -80,31 +255,47 @@ int ParallelExecutor::Run(std::vector<tensor::Tensor *> &in_tensors, std::vector
       return RET_ERROR;
     }
   }
-  kernel::LiteKernelUtil::InitTensorRefCount(kernels);
-
-  PrepareReadyKernels(kernels);
-  while (readyKernels.size() > 0) {
-    pool->LaunchWork(RunKernel, this, readyKernels.size());
-
-    if (std::find_if(results.begin(), results.end(), [](const int &ret) { return (ret != 0); }) != results.end()) {
-      return RET_ERROR;
+  static_memory_ = memory_planner_.IsPlanned();
+  if (!static_memory_) {
+    kernel::LiteKernelUtil::InitTensorRefCount(kernels);
+  }
+  wait_count_.clear();
+  ready_kernels_.clear();
+  launches_.clear();
+  for (auto *kernel : kernels) {
+    wait_count_[kernel] = producers_[kernel].size();
+    if (producers_[kernel].empty()) {
+      ready_kernels_.emplace_back(kernel);
     }
-    for (auto completedKernel : readyKernels) {
-      for (auto out : completedKernel->out_kernels()) {
-        auto iter = refCount.find(out);
-        if (iter == refCount.end()) {
-          continue;
-        }
-        (iter->second)--;
-        if (iter->second <= 0) {
-          refCount.erase(iter);
-        }
-      }
+  }
+  running_kernels_ = 0;
+  unfinished_kernels_ = kernels.size();
+  result_ = RET_OK;
+  allocator_ = allocator;
+  before_ = &before;
+  after_ = &after;
+  // callbacks are user code, always call them from the master thread, so a run with callbacks has a single lane
+  single_lane_ = before != nullptr || after != nullptr;
+  if (single_lane_) {
+    RunLane();
+  } else {
+    auto pool = predict::GlobalThreadPool();
+    MS_ASSERT(pool != nullptr);
+    // one lane per thread of the pool
+    if (!pool->LaunchWork(RunLaneTask, this, 0)) {
+      MS_LOG(ERROR) << "launch lanes to thread pool failed";
+      return RET_ERROR;
     }
-    readyKernels.clear();
-    PrepareReadyKernels(kernels);
   }
-
+  before_ = nullptr;
+  after_ = nullptr;
+  if (result_ != RET_OK) {
+    return result_;
+  }
+  if (unfinished_kernels_ != 0) {
+    MS_LOG(ERROR) << unfinished_kernels_ << " kernels are never ready, the graph has a cycle";
+    return RET_ERROR;
+  }
   return RET_OK;
 }
 
@@ -17,6 +17,10 @@
 #ifndef MINDSPORE_LITE_PARALLEL_EXECUTOR_H_
 #define MINDSPORE_LITE_PARALLEL_EXECUTOR_H_
 
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 #include <vector>
 #include <unordered_map>
 #include "src/runtime/allocator.h"
@@ -26,27 +30,70 @@
 #include "src/runtime/thread_pool.h"
 
 namespace mindspore::lite {
+// Runs the kernel DAG as a dataflow on the lite thread pool: every pool thread runs a lane which takes the next ready
+// kernel, and a kernel is ready as soon as the kernels it waits for finished. Parallel launches of running kernels go
+// to the executor instead of the pool, lanes without a ready kernel help with their tasks, so the threads are split
+// between the kernels running at the moment and a kernel running alone gets all of them.
 class ParallelExecutor : public Executor {
  public:
   ParallelExecutor() = default;
-  virtual ~ParallelExecutor();
+  ~ParallelExecutor() override = default;
 
   int Prepare(std::vector<kernel::LiteKernel *> &kernels) override;
 
   int Run(std::vector<tensor::Tensor *> &in_tensors, std::vector<tensor::Tensor *> &out_tensors,
           std::vector<kernel::LiteKernel *> &kernels, Allocator *allocator = nullptr,
           const session::KernelCallBack &before = nullptr, const session::KernelCallBack &after = nullptr) override;
-  inline kernel::LiteKernel *GetReadyKernel(const int index) { return readyKernels.at(index); }
-  inline void SetResult(const int index, const int result) { results.at(index) = result; }
+
+  // take and run ready kernels until all kernels finished or one of them failed
+  void RunLane();
+
+  // run the tasks of a parallel launch of a running kernel, idle lanes take some of them
+  int LaunchTasks(LiteParallelTaskLambda task, void *cdata, int num_task);
 
  private:
-  void PrepareReadyKernels(const std::vector<kernel::LiteKernel *> &kernels);
+  // tasks of one parallel launch, taken one by one by the launching lane and its helpers
+  struct Launch {
+    LiteParallelTaskLambda task = nullptr;
+    void *cdata = nullptr;
+    int num_task = 0;
+    std::atomic_int next_task = {0};
+    std::atomic_int pending_tasks = {0};
+    std::atomic_int helpers = {0};
+    std::atomic_bool failed = {false};
+  };
+
+  void AddEdge(kernel::LiteKernel *producer, kernel::LiteKernel *consumer);
+
+  void AddMemoryEdges(const std::vector<kernel::LiteKernel *> &kernels);
+
+  int RunKernel(kernel::LiteKernel *kernel);
+
+  // called with mutex_ held
+  void FinishKernel(kernel::LiteKernel *kernel);
+
+  static void RunTasks(Launch *launch);
 
  private:
-  predict::ThreadPool *pool;
-  std::unordered_map<kernel::LiteKernel *, size_t> refCount;
-  std::vector<kernel::LiteKernel *> readyKernels;
-  std::vector<int> results;
+  // kernels each kernel waits for and the kernels waiting for it: its producers and, once the memory is planned, the
+  // kernels using the tensors whose memory its outputs reuse
+  std::unordered_map<kernel::LiteKernel *, std::vector<kernel::LiteKernel *>> producers_;
+  std::unordered_map<kernel::LiteKernel *, std::vector<kernel::LiteKernel *>> consumers_;
+  // state of the current run, guarded by mutex_
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::unordered_map<kernel::LiteKernel *, size_t> wait_count_;
+  std::deque<kernel::LiteKernel *> ready_kernels_;
+  std::vector<Launch *> launches_;
+  size_t running_kernels_ = 0;
+  size_t unfinished_kernels_ = 0;
+  int result_ = RET_OK;
+  // set for the whole run
+  bool static_memory_ = false;
+  bool single_lane_ = false;
+  Allocator *allocator_ = nullptr;
+  const session::KernelCallBack *before_ = nullptr;
+  const session::KernelCallBack *after_ = nullptr;
 };
 
 }  // namespace mindspore::lite
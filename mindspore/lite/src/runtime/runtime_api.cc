@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <mutex>
 #include <string>
 #include "src/runtime/runtime_api.h"
@@ -22,6 +23,37 @@
 #include "utils/log_adapter.h"
 
 static std::mutex gWorkspaceMutex;
+// set on threads which run inside an executor sharing the thread pool, their parallel launches go to the executor
+static thread_local LiteParallelLauncher gParallelLauncher = nullptr;
+static thread_local void *gParallelLauncherData = nullptr;
+
+namespace {
+struct LaunchTasks {
+  FTVMParallelLambda flambda;
+  void *cdata;
+  LiteParallelGroupEnv env;
+};
+
+struct RangeTasks {
+  LiteParallelRangeLambda flambda;
+  void *cdata;
+  int begin;
+  int end;
+  int grain;
+};
+
+int RunLaunchTask(int task_id, void *cdata) {
+  auto tasks = reinterpret_cast<LaunchTasks *>(cdata);
+  return tasks->flambda(task_id, &tasks->env, tasks->cdata);
+}
+
+int RunRangeTask(int task_id, void *cdata) {
+  auto tasks = reinterpret_cast<RangeTasks *>(cdata);
+  int begin = tasks->begin + task_id * tasks->grain;
+  return tasks->flambda(begin, std::min(tasks->end, begin + tasks->grain), tasks->cdata);
+}
+}  // namespace
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -76,6 +108,14 @@ void ConfigThreadPool(int mode, int nthreads) {
 }
 
 int LiteBackendParallelLaunch(FTVMParallelLambda flambda, void *cdata, int num_task) {
+  if (gParallelLauncher != nullptr) {
+    LaunchTasks tasks{flambda, cdata, {nullptr, num_task}};
+    if (gParallelLauncher(RunLaunchTask, &tasks, num_task, gParallelLauncherData) != 0) {
+      MS_LOG(ERROR) << "run tasks on the parallel launcher failed";
+      return -1;
+    }
+    return 0;
+  }
   auto p = mindspore::predict::GlobalThreadPool();
   if (p == nullptr) {
     MS_LOG(ERROR) << "Get thread pool instance failed";
@@ -88,6 +128,34 @@ int LiteBackendParallelLaunch(FTVMParallelLambda flambda, void *cdata, int num_t
   return 0;
 }
 
+int LiteBackendParallelFor(LiteParallelRangeLambda flambda, void *cdata, int begin, int end, int grain) {
+  if (gParallelLauncher != nullptr) {
+    if (end <= begin) {
+      return 0;
+    }
+    grain = std::max(grain, 1);
+    RangeTasks tasks{flambda, cdata, begin, end, grain};
+    int num_task = static_cast<int>((static_cast<int64_t>(end) - begin + grain - 1) / grain);
+    if (gParallelLauncher(RunRangeTask, &tasks, num_task, gParallelLauncherData) != 0) {
+      MS_LOG(ERROR) << "run range [" << begin << ", " << end << ") on the parallel launcher failed";
+      return -1;
+    }
+    return 0;
+  }
+  auto p = mindspore::predict::GlobalThreadPool();
+  if (p == nullptr) {
+    MS_LOG(ERROR) << "Get thread pool instance failed";
+    return -1;
+  }
+  if (!p->ParallelFor(begin, end, grain, [flambda, cdata](int chunk_begin, int chunk_end) {
+        return flambda(chunk_begin, chunk_end, cdata);
+      })) {
+    MS_LOG(ERROR) << "parallel for of thread pool failed";
+    return -1;
+  }
+  return 0;
+}
+
 void DoAllThreadBind(bool ifBind, int mode) {
   auto p = mindspore::predict::GlobalThreadPool();
   if (p == nullptr) {
@@ -99,6 +167,11 @@ void DoAllThreadBind(bool ifBind, int mode) {
   }
 }
 
+void SetParallelLauncher(LiteParallelLauncher launcher, void *launcher_data) {
+  gParallelLauncher = launcher;
+  gParallelLauncherData = launcher_data;
+}
+
 #ifdef __cplusplus
 }
 #endif
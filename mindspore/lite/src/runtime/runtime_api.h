@@ -39,6 +39,11 @@ typedef struct {
   int32_t num_task;
 } LiteParallelGroupEnv;
 typedef int (*FTVMParallelLambda)(int task_id, LiteParallelGroupEnv *penv, void *cdata);
+// runs the elements [begin, end) of one chunk
+typedef int (*LiteParallelRangeLambda)(int begin, int end, void *cdata);
+typedef int (*LiteParallelTaskLambda)(int task_id, void *cdata);
+// runs the tasks [0, num_task) of one parallel launch and returns after all of them finished
+typedef int (*LiteParallelLauncher)(LiteParallelTaskLambda task, void *cdata, int num_task, void *launcher_data);
 INTERNAL_API_DLL void LiteAPISetLastError(const char *msg);
 INTERNAL_API_DLL void *LiteBackendAllocWorkspace(int deviceType, int deviceId, uint64_t size, int dtypeCode,
                                                  int dtypeBits);
@@ -47,8 +52,13 @@ INTERNAL_API_DLL void SetMaxWokerNum(int num);
 INTERNAL_API_DLL void ConfigThreadPool(int mode, int nthreads);
 INTERNAL_API_DLL inline void CfgThreadPool(int nthread) { ConfigThreadPool(-1, nthread); }
 INTERNAL_API_DLL int LiteBackendParallelLaunch(FTVMParallelLambda flambda, void *cdata, int num_task);
+// split [begin, end) into chunks of grain elements which idle threads steal from busy ones
+INTERNAL_API_DLL int LiteBackendParallelFor(LiteParallelRangeLambda flambda, void *cdata, int begin, int end,
+                                            int grain);
 INTERNAL_API_DLL int LiteBackendRegisterSystemLibSymbol(const char *name, void *ptr);
 INTERNAL_API_DLL void DoAllThreadBind(bool ifBind, int mode);
+// parallel launches from the calling thread run on launcher instead of the thread pool, nullptr restores the pool
+INTERNAL_API_DLL void SetParallelLauncher(LiteParallelLauncher launcher, void *launcher_data);
 
 #ifdef __cplusplus
 }
@@ -16,6 +16,9 @@
 
 #include "src/runtime/thread_pool.h"
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
 #include "utils/log_adapter.h"
 #ifdef MS_COMPILE_IOS
 #include <sys/types.h>
@@ -30,38 +33,29 @@ constexpr int kDefaultMidCount = 2;
 constexpr int kSmallCpuNum = 4;
 constexpr int kBigMidCpuNum = 4;
 constexpr int kDefaultThreadNum = 1;
-static unsigned int kDefaultMaxThreadNums = 8;
+constexpr unsigned int kDefaultMaxThreadNums = 8;
 static unsigned int localMaxThreadNums = 1;
+constexpr int kSpinCountBeforePark = 4096;
+constexpr int kRangeShift = 32;
+constexpr uint64_t kRangeMask = 0xffffffff;
 static ThreadPool globalThreadPool;
+// set on threads running chunks of a job, a launch from inside a task runs in place instead of waiting for the pool
+static thread_local bool tlsInsideJob = false;
+// busy time counter of the launches from this thread
+static thread_local std::atomic<uint64_t> *tlsBusyTimeCounter = nullptr;
 
-ThreadPool *GlobalThreadPool() { return &globalThreadPool; }
-
-bool LiteQueue::Enqueue(ThreadPoolTask *task) {
-  const int tailIndex = tail.load(std::memory_order_relaxed);
-  // queue full
-  auto next = (tailIndex + 1) % kSingleThreadMaxTask;
-  if (next == head.load(std::memory_order_acquire)) {
-    return false;
-  }
-  buffer[tailIndex] = task;
-  tail.store(next, std::memory_order_release);
-  ++taskSize;
-  return true;
+static inline uint64_t PackRange(int begin, int end) {
+  return (static_cast<uint64_t>(begin) << kRangeShift) | static_cast<uint64_t>(static_cast<uint32_t>(end));
 }
 
-bool LiteQueue::Dequeue(ThreadPoolTask **out) {
-  if (taskSize == 0) {
-    return false;
-  }
-  // queue empty
-  const int headIndex = head.load(std::memory_order_relaxed);
-  if (headIndex == tail.load(std::memory_order_acquire)) {
-    return false;
-  }
-  *out = buffer[headIndex];
-  head.store((headIndex + 1) % kSingleThreadMaxTask, std::memory_order_release);
-  return true;
-}
+static inline int RangeBegin(uint64_t range) { return static_cast<int>(range >> kRangeShift); }
+
+static inline int RangeEnd(uint64_t range) { return static_cast<int>(range & kRangeMask); }
+
+ThreadPool *GlobalThreadPool() { return &globalThreadPool; }
+
+// a pool may use every core of the machine, but not less than the old default on machines reporting few cores
+static unsigned int MaxThreadNums() { return std::max(kDefaultMaxThreadNums, std::thread::hardware_concurrency()); }
 
 bool LiteThreadBind::Bind(bool ifBind, int numThreads, bool master) {
   if (master) {
@@ -108,11 +102,52 @@ void LiteThreadBind::InitSortedCpuId() {
   for (int i = numCores - 1; i >= 0; --i) {
     sortedCpuIds.emplace_back(i);
   }
-  if (sortedCpuIds.size() > kSmallCpuNum) {
+  // only the big and mid cores of a single node phone soc are worth binding to, a numa machine keeps all its cpus so
+  // the threads spread over the nodes and steal from their own node first
+  int numaNodes = cpuNumaNodes.empty() ? 1 : *std::max_element(cpuNumaNodes.begin(), cpuNumaNodes.end()) + 1;
+  if (numaNodes <= 1 && sortedCpuIds.size() > kSmallCpuNum) {
     sortedCpuIds.resize(bigCore + midCore);
   }
 }
 
+void LiteThreadBind::InitNumaNodes() {
+  cpuNumaNodes.clear();
+#if defined(__linux__) && !defined(__ANDROID__)
+  for (int node = 0;; ++node) {
+    std::ifstream cpuList("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    if (!cpuList.is_open()) {
+      break;
+    }
+    // cpulist looks like "0-15,32-47"
+    std::string item;
+    while (std::getline(cpuList, item, ',')) {
+      int first = 0;
+      int last = 0;
+      int matched = sscanf(item.c_str(), "%d-%d", &first, &last);
+      if (matched < 1 || first < 0) {
+        continue;
+      }
+      if (matched == 1) {
+        last = first;
+      }
+      if (static_cast<int>(cpuNumaNodes.size()) <= last) {
+        cpuNumaNodes.resize(last + 1, 0);
+      }
+      for (int cpu = first; cpu <= last; ++cpu) {
+        cpuNumaNodes[cpu] = node;
+      }
+    }
+  }
+#endif
+}
+
+int LiteThreadBind::NumaNodeOfCpu(int cpuId) const {
+  if (cpuId < 0 || cpuId >= static_cast<int>(cpuNumaNodes.size())) {
+    return 0;
+  }
+  return cpuNumaNodes[cpuId];
+}
+
 bool LiteThreadBind::BindMasterThread(bool bindFlag, int mode) {
   std::vector<int> cpu;
   if (bindFlag) {
@@ -123,9 +158,11 @@ bool LiteThreadBind::BindMasterThread(bool bindFlag, int mode) {
       cpuIndex = 0;
     }
     cpu.emplace_back(sortedCpuIds[cpuIndex]);
+    masterCpu = static_cast<int>(sortedCpuIds[cpuIndex]);
   } else {
     // unbind master
     cpu.assign(sortedCpuIds.begin(), sortedCpuIds.end());
+    masterCpu = -1;
   }
   cpu_set_t cpuSet;
 #ifndef CPU_SET
@@ -148,8 +185,10 @@ bool LiteThreadBind::BindMasterThread(bool bindFlag, int mode) {
 }
 
 bool LiteThreadBind::BindThreads(bool bindFlag) {
+  threadCpuList.assign(threadIdList.size(), -1);
   if (bindFlag && bindModel != NO_BIND) {
-    size_t bindNums = std::min(sortedCpuIds.size(), threadIdList.size());
+    // the master holds one of the cpus
+    size_t bindNums = sortedCpuIds.empty() ? 0 : std::min(sortedCpuIds.size() - 1, threadIdList.size());
     cpu_set_t cpuSet;
     size_t coreIndex;
     for (size_t i = 0; i < bindNums; ++i) {
@@ -172,6 +211,7 @@ bool LiteThreadBind::BindThreads(bool bindFlag) {
         MS_LOG(ERROR) << "do SetCPUBind failed";
         return false;
       }
+      threadCpuList[i] = static_cast<int>(sortedCpuIds[coreIndex]);
     }
   } else {
     // unbind
@@ -226,59 +266,147 @@ bool LiteThreadBind::SetCPUBind(pthread_t threadId, cpu_set_t *cpuSet) {
 
 bool ThreadPool::SetThreadPool() {
   std::lock_guard<std::mutex> Lock(poolMutex);
+  auto maxThreadNums = MaxThreadNums();
   if (configThreadNums <= 0) {
     MS_LOG(WARNING) << "numThreads " << configThreadNums << ", must be greater than 0";
     configThreadNums = curThreadRunNums;
   }
   if (localMaxThreadNums == 0) {
     localMaxThreadNums = 1;
-  } else if (localMaxThreadNums > kDefaultMaxThreadNums) {
-    localMaxThreadNums = kDefaultMaxThreadNums;
-  }
-  if (configThreadNums > kDefaultMaxThreadNums) {
-    configThreadNums = kDefaultMaxThreadNums;
+  } else if (localMaxThreadNums > maxThreadNums) {
+    localMaxThreadNums = maxThreadNums;
   }
-  int addNum = 0;
-  if (configThreadNums > kDefaultMaxThreadNums) {
-    addNum = configThreadNums - curThreadRunNums;
-  } else if (localMaxThreadNums > curThreadNums) {
-    addNum = localMaxThreadNums - curThreadNums;
+  if (configThreadNums > static_cast<int>(maxThreadNums)) {
+    configThreadNums = static_cast<int>(maxThreadNums);
   }
-  AddNewThread(addNum);
-  if (curThreadRunNums > localMaxThreadNums) {
-    SubRunThread(localMaxThreadNums);
-  } else {
-    AddRunThread(localMaxThreadNums);
+  // the configured number of threads is created and bound up front, the max worker number picks how many of them
+  // take part in a launch
+  int poolThreadNums = std::max(configThreadNums, static_cast<int>(localMaxThreadNums));
+  if (poolThreadNums > curThreadNums) {
+    AddNewThread(poolThreadNums - curThreadNums);
   }
+  // workers beyond the run number simply sit out the launches and park
+  curThreadRunNums = static_cast<int>(localMaxThreadNums);
   return true;
 }
 
 void ThreadPool::AddNewThread(int newNums) {
-  for (int i = curThreadNums - 1, j = 0; j < newNums; ++i, ++j) {
-    auto active = new std::atomic_bool{true};
-    auto queue = std::make_shared<LiteQueue>();
-    threadList.emplace_back([this, i, active, queue]() {
-      ThreadPoolTask *task = nullptr;
-      while (!exitRun) {
-        while (*active) {
-          if (queue->Dequeue(&task)) {
-            auto ret = task->first(i + 1, task->second.tvmParam, task->second.cdata);
-            if (ret != 0) {
-              errorInfo.emplace_back(std::make_pair(i + 1, std::make_pair(false, ret)));
-            }
-            queue->taskSize--;
-          }
-          std::this_thread::yield();
-        }
-        std::unique_lock<std::mutex> queueLock(tMutex);
-        queueReady.wait(queueLock, [active, this] { return exitRun || *active; });
-      }
-    });
-    activateList.emplace_back(active);
-    queueList.emplace_back(queue);
+  for (int i = 0; i < newNums; ++i) {
+    int workerId = curThreadNums + i;
+    threadList.emplace_back([this, workerId]() { WorkerLoop(workerId); });
   }
   curThreadNums += newNums;
-  curThreadRunNums += newNums;
+  UpdateStealOrder();
+}
+
+void ThreadPool::UpdateStealOrder() {
+  threadNumaNodes.assign(curThreadNums, 0);
+  if (threadBind != nullptr) {
+    threadNumaNodes[0] = threadBind->NumaNodeOfCpu(threadBind->masterCpu);
+    for (int i = 1; i < curThreadNums && i - 1 < static_cast<int>(threadBind->threadCpuList.size()); ++i) {
+      threadNumaNodes[i] = threadBind->NumaNodeOfCpu(threadBind->threadCpuList[i - 1]);
+    }
+  }
+  // try the threads on the same numa node first, each group in ring order starting after the thief
+  stealOrder.assign(curThreadNums, {});
+  for (int i = 0; i < curThreadNums; ++i) {
+    std::vector<int> remote;
+    for (int j = 1; j < curThreadNums; ++j) {
+      int victim = (i + j) % curThreadNums;
+      if (threadNumaNodes[victim] == threadNumaNodes[i]) {
+        stealOrder[i].emplace_back(victim);
+      } else {
+        remote.emplace_back(victim);
+      }
+    }
+    stealOrder[i].insert(stealOrder[i].end(), remote.begin(), remote.end());
+  }
+}
+
+void ThreadPool::WorkerLoop(int workerId) {
+  tlsInsideJob = true;
+  uint64_t seenEpoch = jobEpoch.load();
+  while (!exitRun) {
+    int spinCount = 0;
+    while (jobEpoch.load() == seenEpoch && !exitRun) {
+      if (++spinCount < kSpinCountBeforePark) {
+        std::this_thread::yield();
+        continue;
+      }
+      std::unique_lock<std::mutex> queueLock(tMutex);
+      ++parkedWorkers;
+      queueReady.wait(queueLock, [this, seenEpoch] { return exitRun || jobEpoch.load() != seenEpoch; });
+      --parkedWorkers;
+    }
+    if (exitRun) {
+      break;
+    }
+    seenEpoch = jobEpoch.load();
+    // the master waits for activeWorkers after clearing curJob, so a job seen here stays alive until we leave it
+    ++activeWorkers;
+    auto job = curJob.load();
+    if (job != nullptr && workerId < job->participants) {
+      RunJob(job, workerId);
+    }
+    --activeWorkers;
+  }
+}
+
+bool ThreadPool::PopChunk(Job *job, int workerId, int *chunk) {
+  auto &range = job->ranges[workerId].range;
+  auto cur = range.load();
+  while (RangeBegin(cur) < RangeEnd(cur)) {
+    if (range.compare_exchange_weak(cur, PackRange(RangeBegin(cur) + 1, RangeEnd(cur)))) {
+      *chunk = RangeBegin(cur);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool ThreadPool::StealChunk(Job *job, int workerId, int *chunk) {
+  for (auto victim : stealOrder[workerId]) {
+    if (victim >= job->participants) {
+      continue;
+    }
+    auto &range = job->ranges[victim].range;
+    auto cur = range.load();
+    while (RangeBegin(cur) < RangeEnd(cur)) {
+      // take the back half, the victim keeps working on the front of its range
+      int begin = RangeBegin(cur);
+      int end = RangeEnd(cur);
+      int stealBegin = end - (end - begin + 1) / 2;
+      if (range.compare_exchange_weak(cur, PackRange(begin, stealBegin))) {
+        *chunk = stealBegin;
+        // our own range is empty, nobody else updates it until we publish the rest of the loot
+        job->ranges[workerId].range.store(PackRange(stealBegin + 1, end));
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void ThreadPool::RunChunk(Job *job, int chunk) {
+  int begin = job->begin + chunk * job->grain;
+  int end = std::min(job->end, begin + job->grain);
+  bool countBusyTime = job->busyTimeNs != nullptr;
+  auto start = countBusyTime ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+  if ((*job->fun)(begin, end) != 0) {
+    job->failed = true;
+  }
+  if (countBusyTime) {
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    *job->busyTimeNs += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+  }
+  --job->pendingChunks;
+}
+
+void ThreadPool::RunJob(Job *job, int workerId) {
+  int chunk = 0;
+  while (PopChunk(job, workerId, &chunk) || StealChunk(job, workerId, &chunk)) {
+    RunChunk(job, chunk);
+  }
 }
 
 bool ThreadPool::SetThreadCpuBind(bool ifBind, int mode, bool master) {
@@ -292,7 +420,8 @@ bool ThreadPool::SetThreadCpuBind(bool ifBind, int mode, bool master) {
       MS_LOG(ERROR) << "create threadBind failed";
       return false;
     }
-    threadBind->threadIdList.resize(kDefaultMaxThreadNums);
+    threadBind->threadIdList.resize(MaxThreadNums());
+    threadBind->InitNumaNodes();
     threadBind->InitSortedCpuId();
   }
   threadBind->threadIdList.clear();
@@ -300,123 +429,110 @@ bool ThreadPool::SetThreadCpuBind(bool ifBind, int mode, bool master) {
     threadBind->threadIdList.emplace_back(it.native_handle());
   }
   threadBind->bindModel = static_cast<AffinityMode>(mode);
-  if (!threadBind->Bind(ifBind, curThreadRunNums, master)) {
+  bool ret = threadBind->Bind(ifBind, curThreadRunNums, master);
+  UpdateStealOrder();
+  if (!ret) {
     MS_LOG(ERROR) << "bind failed";
     return false;
   }
   return true;
 }
 
-bool ThreadPool::AddTask(WorkFun &&worker, void *cdata, int numTask) {
-  if (numTask <= 0) {
-    numTask = curThreadRunNums;
+bool ThreadPool::ParallelFor(int begin, int end, int grain, const RangeFun &fun) {
+  if (end <= begin) {
+    return true;
   }
-  TvmEnv env{};
-  env.num_task = numTask;
-  errorInfo.clear();
-  // single task, run master thread
-  if (curThreadRunNums <= 1) {
-    for (int i = 0; i < numTask; ++i) {
-      int ret = worker(i, &env, cdata);
-      if (ret != 0) {
-        errorInfo.emplace_back(std::make_pair(0, std::make_pair(false, ret)));
-      }
+  grain = std::max(grain, 1);
+  int chunkNum = static_cast<int>((static_cast<int64_t>(end) - begin + grain - 1) / grain);
+  std::unique_lock<std::mutex> launchLock(launchMutex, std::defer_lock);
+  int participants = 1;
+  if (!tlsInsideJob && chunkNum > 1) {
+    launchLock.lock();
+    if (!SetThreadPool()) {
+      return false;
     }
-    return CheckResult();
-  }
-  ThreadPoolTask task;
-  task.first = std::move(worker);
-  task.second.cdata = cdata;
-  task.second.tvmParam = &env;
-  return DistributeTask(&task, numTask);
-}
-
-bool ThreadPool::DistributeTask(ThreadPoolTask *task, int numTask) {
-  auto taskOri = *task;
-  if (numTask > curThreadRunNums) {
-    task->first = [taskOri, numTask, this](int task_id, TvmEnv *penv, void *cdata) -> int {
-      for (int i = task_id; i < numTask; i += curThreadRunNums) {
-        int ret = taskOri.first(i, penv, cdata);
-        if (ret != 0) {
-          errorInfo.emplace_back(std::make_pair(i + 1, std::make_pair(false, ret)));
-        }
-      }
-      return 0;
-    };
-  }
-  bool kSuccFlag;
-  auto size = std::min(curThreadRunNums, numTask);
-  for (int i = 0; i < size - 1; ++i) {
-    do {
-      kSuccFlag = true;
-      if (!queueList[i]->Enqueue(task)) {
-        std::this_thread::yield();
-        kSuccFlag = false;
-      }
-    } while (!kSuccFlag);
-  }
-  // master thread
-  int ret = task->first(0, task->second.tvmParam, task->second.cdata);
-  if (ret != 0) {
-    errorInfo.emplace_back(std::make_pair(0, std::make_pair(false, ret)));
+    participants = std::min(curThreadRunNums, chunkNum);
   }
-  kSuccFlag = false;
-  while (!kSuccFlag) {
-    std::this_thread::yield();
-    kSuccFlag = true;
-    for (int i = 0; i < curThreadRunNums - 1; ++i) {
-      if (queueList[i]->taskSize != 0) {
-        kSuccFlag = false;
-        break;
+  if (participants <= 1) {
+    bool succ = true;
+    for (int chunkBegin = begin; chunkBegin < end; chunkBegin += std::min(grain, end - chunkBegin)) {
+      if (fun(chunkBegin, std::min(end, chunkBegin + grain)) != 0) {
+        succ = false;
       }
     }
+    return succ;
   }
-  return CheckResult();
-}
 
-void ThreadPool::AddRunThread(int num) {
-  int activeNums = num - curThreadRunNums;
-  if (activeNums <= 0 || activateList.size() < activeNums) {
-    return;
-  }
-  for (int i = curThreadRunNums - 1, j = 0; j < activeNums; ++i, ++j) {
-    *activateList[i] = true;
+  Job job;
+  job.fun = &fun;
+  job.begin = begin;
+  job.end = end;
+  job.grain = grain;
+  job.participants = participants;
+  job.ranges.reset(new (std::nothrow) ChunkRange[participants]);
+  if (job.ranges == nullptr) {
+    MS_LOG(ERROR) << "malloc chunk ranges failed";
+    return false;
   }
-  std::lock_guard<std::mutex> queueLock(tMutex);
-  queueReady.notify_all();
-  curThreadRunNums = num;
-}
-
-void ThreadPool::SubRunThread(int num) {
-  int deactiveNums = curThreadRunNums - num;
-  if (deactiveNums <= 0) {
-    return;
+  // contiguous initial split keeps neighbouring chunks on one thread as long as nobody needs to steal
+  for (int i = 0; i < participants; ++i) {
+    job.ranges[i].range.store(PackRange(static_cast<int64_t>(chunkNum) * i / participants,
+                                        static_cast<int64_t>(chunkNum) * (i + 1) / participants));
+  }
+  job.pendingChunks = chunkNum;
+  job.busyTimeNs = tlsBusyTimeCounter;
+  curJob.store(&job);
+  ++jobEpoch;
+  if (parkedWorkers.load() > 0) {
+    std::lock_guard<std::mutex> queueLock(tMutex);
+    queueReady.notify_all();
+  }
+  tlsInsideJob = true;
+  RunJob(&job, 0);
+  tlsInsideJob = false;
+  while (job.pendingChunks.load() != 0) {
+    std::this_thread::yield();
   }
-  for (int i = num - 1, j = 0; j < deactiveNums; ++i, ++j) {
-    *activateList[i] = false;
+  curJob.store(nullptr);
+  while (activeWorkers.load() != 0) {
+    std::this_thread::yield();
   }
-  curThreadRunNums = num;
-}
-
-bool ThreadPool::CheckResult() {
-  bool kSuccFlag = true;
-  for (auto result : errorInfo) {
-    if (result.second.first) {
-      MS_LOG(ERROR) << "task " << result.first << " failed, error code is " << result.second.second;
-      kSuccFlag = false;
-    }
+  if (job.failed) {
+    MS_LOG(ERROR) << "some tasks of the parallel launch failed";
+    return false;
   }
-  return kSuccFlag;
+  return true;
 }
 
 bool ThreadPool::LaunchWork(WorkFun worker, void *cdata, int numTask) {
-  if (!SetThreadPool()) {
-    return false;
+  if (numTask <= 0 && tlsInsideJob) {
+    // the launch we are running in holds launchMutex and keeps the pool as it is
+    numTask = curThreadRunNums;
+  } else if (numTask <= 0) {
+    // resizing the pool replaces the steal order the workers of a running launch read
+    std::lock_guard<std::mutex> launchLock(launchMutex);
+    if (!SetThreadPool()) {
+      return false;
+    }
+    numTask = curThreadRunNums;
   }
-  return AddTask(std::move(worker), cdata, numTask);
+  TvmEnv env{};
+  env.num_task = numTask;
+  RangeFun fun = [&worker, &env, cdata](int begin, int end) -> int {
+    for (int i = begin; i < end; ++i) {
+      int ret = worker(i, &env, cdata);
+      if (ret != 0) {
+        MS_LOG(ERROR) << "task " << i << " failed, error code is " << ret;
+        return ret;
+      }
+    }
+    return 0;
+  };
+  return ParallelFor(0, numTask, 1, fun);
 }
 
 bool ThreadPool::BindAllThreads(bool ifBind, int mode, bool master) {
+  std::lock_guard<std::mutex> launchLock(launchMutex);
   if (!SetThreadPool()) {
     return false;
   }
@@ -424,25 +540,30 @@ bool ThreadPool::BindAllThreads(bool ifBind, int mode, bool master) {
 }
 
 void ThreadPool::ConfigThreadPool(int mode, int numThreads) {
+  // sessions sharing a compiled model configure the pool from concurrent runs
+  std::lock_guard<std::mutex> Lock(poolMutex);
   configBindMode = mode;
   configThreadNums = numThreads;
 }
 
-void ThreadPool::ConfigMaxThreadNum(unsigned int num) { localMaxThreadNums = num; }
+void ThreadPool::SetBusyTimeCounter(std::atomic<uint64_t> *counter) { tlsBusyTimeCounter = counter; }
+
+void ThreadPool::ConfigMaxThreadNum(unsigned int num) {
+  std::lock_guard<std::mutex> Lock(poolMutex);
+  localMaxThreadNums = num;
+}
 
 ThreadPool::~ThreadPool() {
-  curThreadRunNums = static_cast<int>(threadList.size() + 1);
   exitRun = true;
-  SubRunThread(kDefaultThreadNum);
-  queueReady.notify_all();
+  {
+    std::lock_guard<std::mutex> queueLock(tMutex);
+    queueReady.notify_all();
+  }
   for (auto &it : threadList) {
     if (it.joinable()) {
       it.join();
     }
   }
-  for (const auto &it : activateList) {
-    delete it;
-  }
 }
 }  // namespace predict
 }  // namespace mindspore
@@ -41,38 +41,25 @@ typedef struct {
 #define CPU_SET_LOCAL(cpu, cpusetp) ((cpusetp)->__bits[(cpu) / __NCPUBITS] |= (1UL << ((cpu) % __NCPUBITS)))
 #endif
 
-constexpr int kSingleThreadMaxTask = 2;
 using TvmEnv = LiteParallelGroupEnv;
 using WorkFun = std::function<int(int, TvmEnv *, void *)>;
-using TaskParam = struct Param {
-  void *cdata;
-  TvmEnv *tvmParam;
-};
-using ThreadPoolTask = std::pair<WorkFun, TaskParam>;
+// runs the elements [begin, end) of one chunk
+using RangeFun = std::function<int(int, int)>;
 enum AffinityMode : int { BIG_CORE = 1, MID_CORE = -1, NO_BIND = 0 };
 
-class LiteQueue {
- public:
-  LiteQueue() = default;
-  ~LiteQueue() = default;
-  bool Enqueue(ThreadPoolTask *task);
-  bool Dequeue(ThreadPoolTask **out);
-  std::atomic_int taskSize = {0};
-
- private:
-  std::atomic_int head = {0};
-  std::atomic_int tail = {0};
-  ThreadPoolTask *buffer[kSingleThreadMaxTask]{};
-};
-
 class LiteThreadBind {
  public:
   LiteThreadBind() = default;
   ~LiteThreadBind() = default;
   void InitSortedCpuId();
+  void InitNumaNodes();
   bool Bind(bool ifBind, int numThreads, bool master);
+  int NumaNodeOfCpu(int cpuId) const;
   AffinityMode bindModel = MID_CORE;
   std::vector<pthread_t> threadIdList;
+  // cpu each thread of threadIdList is bound to, -1 when it is not bound
+  std::vector<int> threadCpuList;
+  int masterCpu = -1;
 
  private:
   bool BindMasterThread(bool bindFlag, int mode);
@@ -81,42 +68,73 @@ class LiteThreadBind {
   int bigCore = 0;
   int midCore = 0;
   std::vector<unsigned int> sortedCpuIds{};
+  std::vector<int> cpuNumaNodes{};
 };
 
+// Work stealing pool. A launch is split into chunks which are dealt out to the master and the running workers as
+// contiguous ranges; a thread that runs out of chunks steals half of the remaining range of another thread, trying
+// threads on its own NUMA node first. Idle workers spin for a while before they park on a condition variable.
 class ThreadPool {
  public:
   ThreadPool() = default;
   ~ThreadPool();
   bool LaunchWork(WorkFun worker, void *cdata, int numTask);
+  // split [begin, end) into chunks of grain elements, a slow thread only delays the chunks nobody has stolen yet
+  bool ParallelFor(int begin, int end, int grain, const RangeFun &fun);
   void ConfigThreadPool(int mode, int numThreads);
   void ConfigMaxThreadNum(unsigned int num);
   bool BindAllThreads(bool ifBind, int mode, bool master = true);
+  // launches from the calling thread add the time their tasks run to counter, nullptr stops counting; a profiler
+  // passes its own counter so concurrent sessions do not count the tasks of each other
+  static void SetBusyTimeCounter(std::atomic<uint64_t> *counter);
   ThreadPool(const ThreadPool &) = delete;
   ThreadPool &operator=(const ThreadPool &) = delete;
 
  private:
+  // chunk range [begin, end) of one thread packed as begin << 32 | end, so owner and thieves update it with one CAS
+  struct alignas(64) ChunkRange {
+    std::atomic<uint64_t> range = {0};
+  };
+  struct Job {
+    const RangeFun *fun = nullptr;
+    int begin = 0;
+    int end = 0;
+    int grain = 1;
+    int participants = 1;
+    std::unique_ptr<ChunkRange[]> ranges;
+    std::atomic_int pendingChunks = {0};
+    std::atomic_bool failed = {false};
+    std::atomic<uint64_t> *busyTimeNs = nullptr;
+  };
+
   bool SetThreadPool();
   void AddNewThread(int newNums);
   bool SetThreadCpuBind(bool ifBind, int mode, bool master);
-  bool AddTask(WorkFun &&worker, void *cdata, int numTask);
-  bool DistributeTask(ThreadPoolTask *task, int numTask);
-  void AddRunThread(int num);
-  void SubRunThread(int num);
-  bool CheckResult();
+  void UpdateStealOrder();
+  void WorkerLoop(int workerId);
+  void RunJob(Job *job, int workerId);
+  bool PopChunk(Job *job, int workerId, int *chunk);
+  bool StealChunk(Job *job, int workerId, int *chunk);
+  void RunChunk(Job *job, int chunk);
 
   std::mutex poolMutex;
+  std::mutex launchMutex;
   std::mutex tMutex;
   std::condition_variable queueReady;
   std::atomic_bool exitRun = {false};
-  std::vector<std::atomic_bool *> activateList{};
+  std::atomic<Job *> curJob = {nullptr};
+  std::atomic<uint64_t> jobEpoch = {0};
+  std::atomic_int activeWorkers = {0};
+  std::atomic_int parkedWorkers = {0};
   int curThreadNums = 1;
   int curThreadRunNums = 1;
   int configThreadNums = 1;
   int configBindMode = -1;
   std::vector<std::thread> threadList{};
-  std::vector<std::shared_ptr<LiteQueue>> queueList{};
+  // victims of each thread in the order they are tried, thread 0 is the master
+  std::vector<std::vector<int>> stealOrder{};
+  std::vector<int> threadNumaNodes{};
   std::unique_ptr<LiteThreadBind> threadBind{nullptr};
-  std::vector<std::pair<int, std::pair<bool, int>>> errorInfo{};
 };
 
 ThreadPool* GlobalThreadPool();
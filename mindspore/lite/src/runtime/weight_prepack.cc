@@ -0,0 +1,99 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "src/runtime/weight_prepack.h"
+#include <cstring>
+#include "include/errorcode.h"
+#include "ir/dtype/type_id.h"
+#include "utils/log_adapter.h"
+#include "src/runtime/kernel/arm/nnacl/fp32/matmul.h"
+#include "src/runtime/kernel/arm/fp32/convolution_3x3.h"
+
+namespace mindspore::lite {
+namespace {
+constexpr int kWinogradKernelPlane = 16;
+constexpr size_t kWeightDimSize = 4;
+}  // namespace
+
+bool IsPackableConv(schema::QuantType quant_type, int group) {
+  return quant_type == schema::QuantType_QUANT_NONE && group == 1;
+}
+
+bool IsPackableConvWeight(schema::NodeType node_type, schema::Format format, int data_type, const int32_t *dims,
+                          size_t dims_size, size_t data_size, schema::WeightLayout packed_layout) {
+  if (node_type != schema::NodeType_ValueNode || format != schema::Format_KHWC || data_type != kNumberTypeFloat32 ||
+      dims == nullptr || dims_size != kWeightDimSize || packed_layout != schema::WeightLayout_ORIGIN) {
+    return false;
+  }
+  size_t element_num = 1;
+  for (size_t i = 0; i < dims_size; ++i) {
+    element_num *= dims[i];
+  }
+  return data_size == element_num * sizeof(float);
+}
+
+schema::WeightLayout ConvWeightLayout(int kernel_h, int kernel_w, int stride_h, int stride_w, int dilate_h,
+                                      int dilate_w) {
+  if (kernel_h == 1 && kernel_w == 1) {
+    return schema::WeightLayout_CONV1X1_FP32_COL8;
+  }
+  if (kernel_h == 3 && kernel_w == 3 && stride_h == 1 && stride_w == 1 && dilate_h == 1 && dilate_w == 1) {
+    return schema::WeightLayout_CONV3X3_FP32_WINOGRAD;
+  }
+  return schema::WeightLayout_ORIGIN;
+}
+
+size_t PackedWeightSize(schema::WeightLayout layout, int output_channel, int kernel_h, int kernel_w,
+                        int input_channel) {
+  switch (layout) {
+    case schema::WeightLayout_CONV1X1_FP32_COL8:
+      return input_channel * UP_ROUND(output_channel, C8NUM) * sizeof(float);
+    case schema::WeightLayout_CONV3X3_FP32_WINOGRAD:
+      return UP_DIV(input_channel, C4NUM) * C4NUM * UP_DIV(output_channel, C8NUM) * C8NUM * kWinogradKernelPlane *
+             sizeof(float);
+    default:
+      return 0;
+  }
+}
+
+int PackConvWeight(schema::WeightLayout layout, const float *weight, int output_channel, int kernel_h, int kernel_w,
+                   int input_channel, void *dst) {
+  if (weight == nullptr || dst == nullptr) {
+    MS_LOG(ERROR) << "Weight or packed buffer is nullptr";
+    return RET_NULL_PTR;
+  }
+  memset(dst, 0, PackedWeightSize(layout, output_channel, kernel_h, kernel_w, input_channel));
+  auto src = const_cast<float *>(weight);
+  switch (layout) {
+    case schema::WeightLayout_CONV1X1_FP32_COL8:
+      RowMajor2Col8Major(src, reinterpret_cast<float *>(dst), output_channel, input_channel);
+      return RET_OK;
+    case schema::WeightLayout_CONV3X3_FP32_WINOGRAD: {
+      ConvParameter conv_param{};
+      conv_param.output_channel_ = output_channel;
+      conv_param.kernel_h_ = kernel_h;
+      conv_param.kernel_w_ = kernel_w;
+      conv_param.input_channel_ = input_channel;
+      kernel::ProcessFilter(src, reinterpret_cast<float *>(dst), &conv_param, C8NUM, UP_DIV(output_channel, C8NUM));
+      return RET_OK;
+    }
+    default:
+      MS_LOG(ERROR) << "Unsupported weight layout " << schema::EnumNameWeightLayout(layout);
+      return RET_PARAM_INVALID;
+  }
+}
+}  // namespace mindspore::lite
@@ -0,0 +1,48 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_WEIGHT_PREPACK_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_WEIGHT_PREPACK_H_
+
+#include <cstddef>
+#include <cstdint>
+#include "schema/model_generated.h"
+
+namespace mindspore::lite {
+// whether the weight of a Conv2D node may be pre-packed, shared by the converter and the runtime so the models
+// packed offline and the weights packed at load time follow the same rule
+bool IsPackableConv(schema::QuantType quant_type, int group);
+
+// whether a conv weight is an unpacked fp32 KHWC constant whose data matches its dims
+bool IsPackableConvWeight(schema::NodeType node_type, schema::Format format, int data_type, const int32_t *dims,
+                          size_t dims_size, size_t data_size, schema::WeightLayout packed_layout);
+
+// layout of the fp32 conv kernel which CpuConvFp32KernelCreator picks without looking at the input shape, return
+// WeightLayout_ORIGIN if the choice depends on the input shape
+schema::WeightLayout ConvWeightLayout(int kernel_h, int kernel_w, int stride_h, int stride_w, int dilate_h,
+                                      int dilate_w);
+
+// return 0 if the layout is not packed
+size_t PackedWeightSize(schema::WeightLayout layout, int output_channel, int kernel_h, int kernel_w,
+                        int input_channel);
+
+// pack a KHWC fp32 conv weight, dst holds PackedWeightSize bytes
+int PackConvWeight(schema::WeightLayout layout, const float *weight, int output_channel, int kernel_h, int kernel_w,
+                   int input_channel, void *dst);
+}  // namespace mindspore::lite
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_WEIGHT_PREPACK_H_
@@ -26,17 +26,17 @@
 #endif
 
 namespace mindspore::lite {
-int Scheduler::Schedule(const lite::Model *model, std::vector<tensor::Tensor *> *tensors,
-                        std::vector<kernel::LiteKernel *> *kernels) {
+int Scheduler::Schedule(const lite::Model *model, const std::vector<PrimitiveC *> &primitives,
+                        std::vector<tensor::Tensor *> *tensors, std::vector<kernel::LiteKernel *> *kernels) {
   // 1. op ---> kernel
   // 2. sub graph
   // 3. kernels (kernels --> subGraph)
-  int ret = InferShape(model, tensors);
+  int ret = InferShape(model, primitives, tensors);
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "op infer shape failed.";
     return RET_ERROR;
   }
-  ret = InitOp2Kernel(model, tensors, kernels);
+  ret = InitOp2Kernel(model, primitives, tensors, kernels);
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "init op to kernel failed.";
     return RET_ERROR;
@@ -77,13 +77,18 @@ int Scheduler::ReSizeKernels(const std::vector<kernel::LiteKernel *> &kernels) {
   return RET_OK;
 }
 
-int Scheduler::InferShape(const lite::Model *model, std::vector<tensor::Tensor *> *tensors) {
+int Scheduler::InferShape(const lite::Model *model, const std::vector<PrimitiveC *> &primitives,
+                          std::vector<tensor::Tensor *> *tensors) {
   MS_EXCEPTION_IF_NULL(model);
   MS_EXCEPTION_IF_NULL(tensors);
   auto meta_graph = model->GetMetaGraph();
   MS_EXCEPTION_IF_NULL(meta_graph);
   bool infer_shape_interrupt = false;
   uint32_t kernelCount = meta_graph->nodes()->size();
+  if (primitives.size() != kernelCount) {
+    MS_LOG(ERROR) << "Primitives size " << primitives.size() << " is not equal to nodes size " << kernelCount;
+    return RET_ERROR;
+  }
   for (uint32_t i = 0; i < kernelCount; i++) {
     auto cNode = meta_graph->nodes()->GetAs<schema::CNode>(i);
     std::vector<tensor::Tensor *> inputs;
@@ -96,7 +101,7 @@ int Scheduler::InferShape(const lite::Model *model, std::vector<tensor::Tensor *
     for (size_t j = 0; j < outIndexes->size(); j++) {
       outputs.emplace_back(tensors->at(size_t(outIndexes->GetAs<uint32_t>(j))));
     }
-    auto *primitive = model->GetOp(cNode->name()->str());
+    auto *primitive = primitives[i];
     if (primitive == nullptr) {
       MS_LOG(ERROR) << "Op " << cNode->name()->str() << " should exist in model, type: "
                     << schema::EnumNamePrimitiveType(cNode->primitive()->value_type());
@@ -119,8 +124,8 @@ int Scheduler::InferShape(const lite::Model *model, std::vector<tensor::Tensor *
   return RET_OK;
 }
 
-int Scheduler::InitOp2Kernel(const lite::Model *model, std::vector<tensor::Tensor *> *tensors,
-                             std::vector<kernel::LiteKernel *> *kernels) {
+int Scheduler::InitOp2Kernel(const lite::Model *model, const std::vector<PrimitiveC *> &primitives,
+                             std::vector<tensor::Tensor *> *tensors, std::vector<kernel::LiteKernel *> *kernels) {
   MS_EXCEPTION_IF_NULL(model);
   MS_EXCEPTION_IF_NULL(tensors);
   auto meta_graph = model->GetMetaGraph();
@@ -139,7 +144,7 @@ int Scheduler::InitOp2Kernel(const lite::Model *model, std::vector<tensor::Tenso
     for (size_t j = 0; j < outIndexes->size(); j++) {
       outputs.emplace_back(tensors->at(size_t(outIndexes->GetAs<uint32_t>(j))));
     }
-    auto *primitive = model->GetOp(cNode->name()->str());
+    auto *primitive = primitives[i];
     auto *kernel = this->ScheduleNode(inputs, outputs, primitive);
     if (nullptr == kernel) {
       MS_LOG(ERROR) << "ScheduleNode return nullptr, name: " << cNode->name()->str()
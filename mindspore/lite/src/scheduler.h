@@ -27,8 +27,9 @@ namespace mindspore::lite {
 class Scheduler {
  public:
   explicit Scheduler(const Context *ctx) { context_ = const_cast<Context *>(ctx); }
-  int Schedule(const lite::Model *model, std::vector<tensor::Tensor *> *tensors,
-               std::vector<kernel::LiteKernel *> *kernels);
+  // primitives holds one primitive per node of the model, in the order of MetaGraph::nodes
+  int Schedule(const lite::Model *model, const std::vector<PrimitiveC *> &primitives,
+               std::vector<tensor::Tensor *> *tensors, std::vector<kernel::LiteKernel *> *kernels);
 
   int ReSizeKernels(const std::vector<kernel::LiteKernel *> &kernels);
 
@@ -38,9 +39,10 @@ class Scheduler {
                                    const mindspore::lite::PrimitiveC *primitive);
 
  private:
-  int InitOp2Kernel(const lite::Model *model, std::vector<tensor::Tensor *> *tensors,
-                    std::vector<kernel::LiteKernel *> *kernels);
-  int InferShape(const lite::Model *model, std::vector<tensor::Tensor *> *tensors);
+  int InitOp2Kernel(const lite::Model *model, const std::vector<PrimitiveC *> &primitives,
+                    std::vector<tensor::Tensor *> *tensors, std::vector<kernel::LiteKernel *> *kernels);
+  int InferShape(const lite::Model *model, const std::vector<PrimitiveC *> &primitives,
+                 std::vector<tensor::Tensor *> *tensors);
 
   // construct SubGraphKernel for each kernel-group in markedKernelGroup
   void ConstructSubgraphs(std::vector<kernel::LiteKernel *> *kernels);
@@ -14,12 +14,23 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
 #include <memory>
+#include <thread>
+#include <vector>
 #include "mindspore/lite/schema/inner/model_generated.h"
 #include "mindspore/lite/include/model.h"
 #include "common/common_test.h"
 #include "include/lite_session.h"
+#include "include/compiled_model.h"
+#include "include/batching_session.h"
 #include "include/context.h"
 #include "include/errorcode.h"
 #include "mindspore/core/utils/log_adapter.h"
@@ -337,6 +348,521 @@ TEST_F(InferTest, TestParallelExecutor) {
   MS_LOG(INFO) << "Passed";
 }
 
+TEST_F(InferTest, TestResizePlanCache) {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_Add;
+  auto primitive = new schema::AddT;
+  node->primitive->value.value = primitive;
+  node->name = "Add";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0, 1};
+  meta_graph->outputIndex = {2};
+
+  for (int i = 0; i < 2; i++) {
+    auto input = std::make_unique<schema::TensorT>();
+    input->nodeType = schema::NodeType::NodeType_ValueNode;
+    input->format = schema::Format_NHWC;
+    input->dataType = TypeId::kNumberTypeFloat32;
+    input->dims = {1, 28, 28, 3};
+    input->offset = -1;
+    meta_graph->allTensors.emplace_back(std::move(input));
+  }
+
+  auto output = std::make_unique<schema::TensorT>();
+  output->nodeType = schema::NodeType::NodeType_Parameter;
+  output->format = schema::Format_NHWC;
+  output->dataType = TypeId::kNumberTypeFloat32;
+  output->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(output));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  size_t size = builder.GetSize();
+  const char *content = reinterpret_cast<char *>(builder.GetBufferPointer());
+
+  auto model = lite::Model::Import(content, size);
+  ASSERT_NE(nullptr, model);
+  meta_graph.reset();
+  content = nullptr;
+  auto context = new lite::Context;
+  context->cpu_bind_mode_ = lite::NO_BIND;
+  context->device_ctx_.type = lite::DT_CPU;
+  context->thread_num_ = 2;
+  context->plan_cache_size_ = 2;
+  auto session = session::LiteSession::CreateSession(context);
+  ASSERT_NE(nullptr, session);
+  auto ret = session->CompileGraph(model);
+  ASSERT_EQ(lite::RET_OK, ret);
+
+  // 28 -> 14 compiles new kernels, 14 -> 28 hits the cache, 28 -> 7 evicts the plan of 14
+  std::vector<int> sizes = {14, 28, 7, 28};
+  for (auto hw : sizes) {
+    std::vector<int> shape = {1, hw, hw, 3};
+    auto in0 = tensor::MSTensor::CreateTensor(TypeId::kNumberTypeFloat32, shape);
+    auto in1 = tensor::MSTensor::CreateTensor(TypeId::kNumberTypeFloat32, shape);
+    ret = session->Resize({in0, in1});
+    ASSERT_EQ(lite::RET_OK, ret);
+    delete in0;
+    delete in1;
+    for (auto *in_tensor : session->GetInputs()) {
+      ASSERT_EQ(shape, in_tensor->shape());
+      ASSERT_NE(nullptr, in_tensor->MutableData());
+    }
+    ret = session->RunGraph();
+    ASSERT_EQ(lite::RET_OK, ret);
+    auto outputs = session->GetOutputs();
+    ASSERT_EQ(outputs.size(), 1);
+    auto outTensor = outputs.begin()->second.front();
+    ASSERT_NE(nullptr, outTensor);
+    ASSERT_EQ(hw * hw * 3, outTensor->ElementsNum());
+    ASSERT_NE(nullptr, outTensor->MutableData());
+  }
+  delete session;
+  delete context;
+}
+
+TEST_F(InferTest, TestResizePlanCacheSwitch) {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_Add;
+  auto primitive = new schema::AddT;
+  node->primitive->value.value = primitive;
+  node->name = "Add";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0, 1};
+  meta_graph->outputIndex = {2};
+
+  for (int i = 0; i < 2; i++) {
+    auto input = std::make_unique<schema::TensorT>();
+    input->nodeType = schema::NodeType::NodeType_ValueNode;
+    input->format = schema::Format_NHWC;
+    input->dataType = TypeId::kNumberTypeFloat32;
+    input->dims = {1, 28, 28, 3};
+    input->offset = -1;
+    meta_graph->allTensors.emplace_back(std::move(input));
+  }
+
+  auto output = std::make_unique<schema::TensorT>();
+  output->nodeType = schema::NodeType::NodeType_Parameter;
+  output->format = schema::Format_NHWC;
+  output->dataType = TypeId::kNumberTypeFloat32;
+  output->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(output));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  size_t size = builder.GetSize();
+  const char *content = reinterpret_cast<char *>(builder.GetBufferPointer());
+
+  auto model = lite::Model::Import(content, size);
+  ASSERT_NE(nullptr, model);
+  meta_graph.reset();
+  content = nullptr;
+  auto context = new lite::Context;
+  context->cpu_bind_mode_ = lite::NO_BIND;
+  context->device_ctx_.type = lite::DT_CPU;
+  context->thread_num_ = 2;
+  context->plan_cache_size_ = 2;
+  auto session = session::LiteSession::CreateSession(context);
+  ASSERT_NE(nullptr, session);
+  auto ret = session->CompileGraph(model);
+  ASSERT_EQ(lite::RET_OK, ret);
+
+  // the first switch to 14 plans its memory, every later switch reactivates one of the two cached plans
+  std::vector<int> sizes = {14, 28, 14, 28, 14, 28};
+  for (size_t step = 0; step < sizes.size(); ++step) {
+    auto hw = sizes[step];
+    std::vector<int> shape = {1, hw, hw, 3};
+    auto in0 = tensor::MSTensor::CreateTensor(TypeId::kNumberTypeFloat32, shape);
+    auto in1 = tensor::MSTensor::CreateTensor(TypeId::kNumberTypeFloat32, shape);
+    ret = session->Resize({in0, in1});
+    ASSERT_EQ(lite::RET_OK, ret);
+    delete in0;
+    delete in1;
+    auto inputs = session->GetInputs();
+    ASSERT_EQ(inputs.size(), 2);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      ASSERT_EQ(shape, inputs[i]->shape());
+      auto in_data = reinterpret_cast<float *>(inputs[i]->MutableData());
+      ASSERT_NE(nullptr, in_data);
+      for (int j = 0; j < inputs[i]->ElementsNum(); ++j) {
+        in_data[j] = static_cast<float>(j % 7 + i * step);
+      }
+    }
+    ret = session->RunGraph();
+    ASSERT_EQ(lite::RET_OK, ret);
+    auto outputs = session->GetOutputs();
+    ASSERT_EQ(outputs.size(), 1);
+    auto outTensor = outputs.begin()->second.front();
+    ASSERT_NE(nullptr, outTensor);
+    ASSERT_EQ(shape, outTensor->shape());
+    ASSERT_EQ(hw * hw * 3, outTensor->ElementsNum());
+    auto out_data = reinterpret_cast<float *>(outTensor->MutableData());
+    ASSERT_NE(nullptr, out_data);
+    for (int j = 0; j < outTensor->ElementsNum(); ++j) {
+      ASSERT_EQ(static_cast<float>(2 * (j % 7) + step), out_data[j]);
+    }
+  }
+  delete session;
+  delete context;
+}
+
+TEST_F(InferTest, TestCompiledModelSessions) {
+  const int batch_hw = 8;
+  const int channel_in = 4;
+  const int channel_out = 8;
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_Conv2D;
+  auto primitive = new schema::Conv2DT;
+  primitive->padMode = schema::PadMode_SAME;
+  primitive->channelIn = channel_in;
+  primitive->channelOut = channel_out;
+  primitive->format = schema::Format_NHWC;
+  primitive->group = 1;
+  primitive->strideH = 1;
+  primitive->strideW = 1;
+  primitive->kernelH = 1;
+  primitive->kernelW = 1;
+  primitive->dilateH = 1;
+  primitive->dilateW = 1;
+  node->primitive->value.value = primitive;
+  node->name = "Conv2D";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {2};
+
+  auto input0 = std::make_unique<schema::TensorT>();
+  input0->nodeType = schema::NodeType::NodeType_ValueNode;
+  input0->format = schema::Format_NHWC;
+  input0->dataType = TypeId::kNumberTypeFloat32;
+  input0->dims = {1, batch_hw, batch_hw, channel_in};
+  input0->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(input0));
+
+  std::vector<float> weight_data(channel_out * channel_in);
+  for (size_t i = 0; i < weight_data.size(); i++) {
+    weight_data[i] = 0.01f * i - 0.1f;
+  }
+  auto weight = std::make_unique<schema::TensorT>();
+  weight->nodeType = schema::NodeType::NodeType_ValueNode;
+  weight->format = schema::Format_KHWC;
+  weight->dataType = TypeId::kNumberTypeFloat32;
+  weight->dims = {channel_out, 1, 1, channel_in};
+  weight->data.resize(weight_data.size() * sizeof(float));
+  memcpy(weight->data.data(), weight_data.data(), weight->data.size());
+  weight->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(weight));
+
+  auto output = std::make_unique<schema::TensorT>();
+  output->nodeType = schema::NodeType::NodeType_Parameter;
+  output->format = schema::Format_NHWC;
+  output->dataType = TypeId::kNumberTypeFloat32;
+  output->dims = {1, batch_hw, batch_hw, channel_out};
+  output->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(output));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  size_t size = builder.GetSize();
+  const char *content = reinterpret_cast<char *>(builder.GetBufferPointer());
+
+  auto model = lite::Model::Import(content, size);
+  ASSERT_NE(nullptr, model);
+  meta_graph.reset();
+  content = nullptr;
+  auto context = new lite::Context;
+  context->cpu_bind_mode_ = lite::NO_BIND;
+  context->device_ctx_.type = lite::DT_CPU;
+  context->thread_num_ = 2;
+  auto compiled_model = session::CompiledModel::Compile(model, context);
+  ASSERT_NE(nullptr, compiled_model);
+
+  const int session_num = 3;
+  std::vector<session::LiteSession *> sessions;
+  for (int i = 0; i < session_num; i++) {
+    auto session = compiled_model->CreateSession();
+    ASSERT_NE(nullptr, session);
+    sessions.emplace_back(session);
+  }
+  // the sessions keep the compiled model alive
+  compiled_model.reset();
+
+  // every session resizes to its own shape concurrently, the primitives written by shape inference are per session
+  std::vector<int> results(session_num, lite::RET_ERROR);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < session_num; i++) {
+    threads.emplace_back([&sessions, &results, i]() {
+      int hw = batch_hw + 2 * i;
+      auto resize_tensor =
+        tensor::MSTensor::CreateTensor(TypeId::kNumberTypeFloat32, std::vector<int>{1, hw, hw, channel_in});
+      results[i] = sessions[i]->Resize({resize_tensor});
+      delete resize_tensor;
+      if (results[i] != lite::RET_OK) {
+        return;
+      }
+      auto in_tensor = sessions[i]->GetInputs().front();
+      auto in_data = reinterpret_cast<float *>(in_tensor->MutableData());
+      for (int j = 0; j < in_tensor->ElementsNum(); j++) {
+        in_data[j] = static_cast<float>((i + j) % 7);
+      }
+      results[i] = sessions[i]->RunGraph();
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (int i = 0; i < session_num; i++) {
+    ASSERT_EQ(lite::RET_OK, results[i]);
+    int hw = batch_hw + 2 * i;
+    auto in_data = reinterpret_cast<float *>(sessions[i]->GetInputs().front()->MutableData());
+    auto out_tensor = sessions[i]->GetOutputs().begin()->second.front();
+    ASSERT_EQ(hw * hw * channel_out, out_tensor->ElementsNum());
+    auto out_data = reinterpret_cast<float *>(out_tensor->MutableData());
+    for (int p = 0; p < hw * hw; p++) {
+      for (int oc = 0; oc < channel_out; oc++) {
+        float expect = 0;
+        for (int ic = 0; ic < channel_in; ic++) {
+          expect += in_data[p * channel_in + ic] * weight_data[oc * channel_in + ic];
+        }
+        ASSERT_LE(std::fabs(expect - out_data[p * channel_out + oc]), 0.001);
+      }
+    }
+  }
+  for (auto *session : sessions) {
+    delete session;
+  }
+  delete context;
+  delete model;
+}
+
+TEST_F(InferTest, TestBatchingSession) {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_Add;
+  auto primitive = new schema::AddT;
+  node->primitive->value.value = primitive;
+  node->name = "Add";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0, 1};
+  meta_graph->outputIndex = {2};
+
+  for (int i = 0; i < 2; i++) {
+    auto input = std::make_unique<schema::TensorT>();
+    input->nodeType = schema::NodeType::NodeType_ValueNode;
+    input->format = schema::Format_NHWC;
+    input->dataType = TypeId::kNumberTypeFloat32;
+    input->dims = {1, 4, 4, 3};
+    input->offset = -1;
+    meta_graph->allTensors.emplace_back(std::move(input));
+  }
+
+  auto output = std::make_unique<schema::TensorT>();
+  output->nodeType = schema::NodeType::NodeType_Parameter;
+  output->format = schema::Format_NHWC;
+  output->dataType = TypeId::kNumberTypeFloat32;
+  output->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(output));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  size_t size = builder.GetSize();
+  const char *content = reinterpret_cast<char *>(builder.GetBufferPointer());
+
+  auto model = lite::Model::Import(content, size);
+  ASSERT_NE(nullptr, model);
+  meta_graph.reset();
+  content = nullptr;
+  auto context = new lite::Context;
+  context->cpu_bind_mode_ = lite::NO_BIND;
+  context->device_ctx_.type = lite::DT_CPU;
+  context->thread_num_ = 2;
+  context->plan_cache_size_ = 4;
+  auto session = session::LiteSession::CreateSession(context);
+  ASSERT_NE(nullptr, session);
+  auto ret = session->CompileGraph(model);
+  ASSERT_EQ(lite::RET_OK, ret);
+  session::BatchingOptions options;
+  options.max_batch_size_ = 4;
+  options.max_delay_us_ = 2000;
+  auto batching_session = session::BatchingSession::CreateBatchingSession(session, options);
+  ASSERT_NE(nullptr, batching_session);
+
+  const int request_num = 8;
+  std::vector<int> results(request_num, lite::RET_ERROR);
+  std::vector<std::thread> threads;
+  for (int i = 0; i < request_num; i++) {
+    threads.emplace_back([batching_session, &results, i]() {
+      // requests of batch 1 and 2 are mixed in one batched run
+      std::vector<int> shape = {1 + i % 2, 4, 4, 3};
+      auto in0 = tensor::MSTensor::CreateTensor(TypeId::kNumberTypeFloat32, shape);
+      auto in1 = tensor::MSTensor::CreateTensor(TypeId::kNumberTypeFloat32, shape);
+      auto in0_data = reinterpret_cast<float *>(in0->MutableData());
+      auto in1_data = reinterpret_cast<float *>(in1->MutableData());
+      for (int j = 0; j < in0->ElementsNum(); j++) {
+        in0_data[j] = static_cast<float>(i);
+        in1_data[j] = static_cast<float>(j);
+      }
+      std::unordered_map<std::string, std::vector<tensor::MSTensor *>> outputs;
+      results[i] = batching_session->Run({in0, in1}, &outputs);
+      if (results[i] == lite::RET_OK) {
+        auto out_tensor = outputs.begin()->second.front();
+        auto out_data = reinterpret_cast<float *>(out_tensor->MutableData());
+        for (int j = 0; j < out_tensor->ElementsNum(); j++) {
+          if (out_tensor->shape() != shape || std::fabs(out_data[j] - in0_data[j] - in1_data[j]) > 0.001) {
+            results[i] = lite::RET_ERROR;
+            break;
+          }
+        }
+      }
+      for (auto &item : outputs) {
+        for (auto *out_tensor : item.second) {
+          delete out_tensor;
+        }
+      }
+      delete in0;
+      delete in1;
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (auto result : results) {
+    ASSERT_EQ(lite::RET_OK, result);
+  }
+  delete batching_session;
+
+  // the batch never fills up and the delay never runs out, deleting the batching session fails the queued requests
+  options.max_batch_size_ = request_num + 1;
+  options.max_delay_us_ = 60 * 1000 * 1000;
+  batching_session = session::BatchingSession::CreateBatchingSession(session, options);
+  ASSERT_NE(nullptr, batching_session);
+  std::atomic_int started = {0};
+  std::fill(results.begin(), results.end(), lite::RET_OK);
+  threads.clear();
+  for (int i = 0; i < request_num; i++) {
+    threads.emplace_back([batching_session, &results, &started, i]() {
+      std::vector<int> shape = {1, 4, 4, 3};
+      auto in0 = tensor::MSTensor::CreateTensor(TypeId::kNumberTypeFloat32, shape);
+      auto in1 = tensor::MSTensor::CreateTensor(TypeId::kNumberTypeFloat32, shape);
+      std::unordered_map<std::string, std::vector<tensor::MSTensor *>> outputs;
+      started++;
+      results[i] = batching_session->Run({in0, in1}, &outputs);
+      delete in0;
+      delete in1;
+    });
+  }
+  while (started.load() < request_num) {
+    std::this_thread::yield();
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  delete batching_session;
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (auto result : results) {
+    ASSERT_EQ(lite::RET_ERROR, result);
+  }
+  delete session;
+  delete context;
+}
+
+TEST_F(InferTest, TestProfiler) {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_Add;
+  node->primitive->value.value = new schema::AddT;
+  node->name = "Add";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0, 1};
+  meta_graph->outputIndex = {2};
+  for (int i = 0; i < 3; ++i) {
+    auto tensor = std::make_unique<schema::TensorT>();
+    tensor->nodeType = i < 2 ? schema::NodeType::NodeType_ValueNode : schema::NodeType::NodeType_Parameter;
+    tensor->format = schema::Format_NHWC;
+    tensor->dataType = TypeId::kNumberTypeFloat32;
+    if (i < 2) {
+      tensor->dims = {1, 28, 28, 3};
+    }
+    tensor->offset = -1;
+    meta_graph->allTensors.emplace_back(std::move(tensor));
+  }
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  auto model = lite::Model::Import(reinterpret_cast<char *>(builder.GetBufferPointer()), builder.GetSize());
+  ASSERT_NE(nullptr, model);
+  lite::Context context;
+  context.cpu_bind_mode_ = lite::NO_BIND;
+  context.device_ctx_.type = lite::DT_CPU;
+  context.thread_num_ = 2;
+  context.enable_profiling_ = true;
+  auto session = session::LiteSession::CreateSession(&context);
+  ASSERT_NE(nullptr, session);
+  ASSERT_EQ(lite::RET_OK, session->CompileGraph(model));
+  for (auto *input : session->GetInputs()) {
+    memset(input->MutableData(), 0, input->Size());
+  }
+  auto profiler = session->GetProfiler();
+  ASSERT_NE(nullptr, profiler);
+  ASSERT_EQ(lite::RET_OK, session->RunGraph());
+  // warm up runs are dropped
+  profiler->Clear();
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(lite::RET_OK, session->RunGraph());
+  }
+
+  auto summary = profiler->Summary();
+  ASSERT_NE(std::string::npos, summary.find("Add"));
+  ASSERT_NE(std::string::npos, summary.find("GFLOPS"));
+  ASSERT_TRUE(profiler->Summary("unknown").empty());
+  const std::string trace_path = "./profiler_trace.json";
+  ASSERT_EQ(lite::RET_OK, profiler->WriteChromeTrace(trace_path));
+  std::ifstream ifs(trace_path);
+  std::string trace((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+  ASSERT_NE(std::string::npos, trace.find("\"traceEvents\""));
+  const std::string complete_event = "\"ph\": \"X\"";
+  size_t events = 0;
+  for (auto pos = trace.find(complete_event); pos != std::string::npos; pos = trace.find(complete_event, pos + 1)) {
+    ++events;
+  }
+  ASSERT_EQ(3, events);
+  std::remove(trace_path.c_str());
+  delete session;
+  delete model;
+}
+
 TEST_F(InferTest, TestModel) {
   auto buf = new char *[1];
   size_t model_size;
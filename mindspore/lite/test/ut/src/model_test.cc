@@ -0,0 +1,156 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include "mindspore/lite/schema/inner/model_generated.h"
+#include "mindspore/lite/include/model.h"
+#include "common/common_test.h"
+#include "include/lite_session.h"
+#include "include/context.h"
+#include "include/errorcode.h"
+
+namespace mindspore {
+namespace {
+constexpr char kModelPath[] = "./import_from_file_test.ms";
+
+// flatbuffer of a graph with a single Add node
+std::string AddModelBuffer() {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_Add;
+  node->primitive->value.value = new schema::AddT;
+  node->name = "Add";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0, 1};
+  meta_graph->outputIndex = {2};
+  for (int i = 0; i < 3; i++) {
+    auto tensor = std::make_unique<schema::TensorT>();
+    tensor->nodeType = i < 2 ? schema::NodeType::NodeType_ValueNode : schema::NodeType::NodeType_Parameter;
+    tensor->format = schema::Format_NHWC;
+    tensor->dataType = TypeId::kNumberTypeFloat32;
+    if (i < 2) {
+      tensor->dims = {1, 4, 4, 3};
+    }
+    tensor->offset = -1;
+    meta_graph->allTensors.emplace_back(std::move(tensor));
+  }
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  return std::string(reinterpret_cast<char *>(builder.GetBufferPointer()), builder.GetSize());
+}
+
+void WriteModelFile(const std::string &content) {
+  std::ofstream file(kModelPath, std::ios::binary | std::ios::trunc);
+  file.write(content.data(), content.size());
+}
+
+// number of mappings of the model file in this process, -1 if the mappings can not be read
+int ModelFileMappings() {
+  char *path = realpath(kModelPath, nullptr);
+  std::ifstream maps("/proc/self/maps");
+  if (path == nullptr || !maps.is_open()) {
+    free(path);
+    return -1;
+  }
+  std::string model_path(path);
+  free(path);
+  int count = 0;
+  std::string line;
+  while (std::getline(maps, line)) {
+    if (line.size() >= model_path.size() &&
+        line.compare(line.size() - model_path.size(), model_path.size(), model_path) == 0) {
+      count++;
+    }
+  }
+  return count;
+}
+}  // namespace
+
+class ModelTest : public mindspore::CommonTest {
+ public:
+  ModelTest() {}
+
+  void TearDown() override { remove(kModelPath); }
+};
+
+TEST_F(ModelTest, TestImportFromFile) {
+  WriteModelFile(AddModelBuffer());
+  auto model = lite::Model::ImportFromFile(kModelPath);
+  ASSERT_NE(nullptr, model);
+  ASSERT_NE(nullptr, model->GetMetaGraph());
+  ASSERT_EQ(1, model->GetMetaGraph()->nodes()->size());
+  ASSERT_NE(nullptr, model->GetOp("Add"));
+
+  lite::Context context;
+  context.cpu_bind_mode_ = lite::NO_BIND;
+  context.device_ctx_.type = lite::DT_CPU;
+  context.thread_num_ = 1;
+  auto session = session::LiteSession::CreateSession(&context);
+  ASSERT_NE(nullptr, session);
+  ASSERT_EQ(lite::RET_OK, session->CompileGraph(model));
+  ASSERT_EQ(lite::RET_OK, session->RunGraph());
+  ASSERT_EQ(48, session->GetOutputs().begin()->second.front()->ElementsNum());
+  delete session;
+  delete model;
+}
+
+TEST_F(ModelTest, TestImportInvalidFile) {
+  auto content = AddModelBuffer();
+  WriteModelFile(content.substr(0, content.size() / 2));
+  ASSERT_EQ(nullptr, lite::Model::ImportFromFile(kModelPath));
+  WriteModelFile(std::string(content.size(), 'x'));
+  ASSERT_EQ(nullptr, lite::Model::ImportFromFile(kModelPath));
+  WriteModelFile("");
+  ASSERT_EQ(nullptr, lite::Model::ImportFromFile(kModelPath));
+  // a file which failed to import leaves no mapping behind
+  ASSERT_LE(ModelFileMappings(), 0);
+}
+
+TEST_F(ModelTest, TestImportMissingFile) {
+  remove(kModelPath);
+  ASSERT_EQ(nullptr, lite::Model::ImportFromFile(kModelPath));
+  ASSERT_EQ(nullptr, lite::Model::ImportFromFile(nullptr));
+}
+
+TEST_F(ModelTest, TestFreeReleasesMapping) {
+  WriteModelFile(AddModelBuffer());
+  auto model = lite::Model::ImportFromFile(kModelPath);
+  ASSERT_NE(nullptr, model);
+  if (ModelFileMappings() < 0) {
+    delete model;
+    return;
+  }
+  ASSERT_GT(ModelFileMappings(), 0);
+  model->FreeMetaGraph();
+  ASSERT_EQ(0, ModelFileMappings());
+  delete model;
+
+  model = lite::Model::ImportFromFile(kModelPath);
+  ASSERT_NE(nullptr, model);
+  ASSERT_GT(ModelFileMappings(), 0);
+  delete model;
+  ASSERT_EQ(0, ModelFileMappings());
+}
+}  // namespace mindspore
@@ -0,0 +1,113 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX
+#include <vector>
+#include "common/common_test.h"
+#include "mindspore/lite/src/runtime/kernel/arm/nnacl/common_func.h"
+#include "mindspore/lite/src/runtime/kernel/arm/nnacl/matmul_parameter.h"
+#include "mindspore/lite/src/runtime/kernel/arm/nnacl/x86_64/cpu_info.h"
+#include "mindspore/lite/src/runtime/kernel/arm/nnacl/x86_64/gemm_fp32_avx.h"
+#include "mindspore/lite/src/runtime/kernel/arm/nnacl/x86_64/gemm_int8_avx.h"
+
+namespace mindspore {
+class TestGemmAvx : public mindspore::CommonTest {
+ public:
+  TestGemmAvx() {}
+};
+
+namespace {
+void FillFp32(std::vector<float> *data) {
+  for (size_t i = 0; i < data->size(); ++i) {
+    (*data)[i] = static_cast<float>(static_cast<int>(i * 37 % 17) - 8) / 4.0f;
+  }
+}
+
+void FillInt8(std::vector<int8_t> *data, int seed) {
+  for (size_t i = 0; i < data->size(); ++i) {
+    (*data)[i] = static_cast<int8_t>(static_cast<int>((i + seed) * 73 % 256) - 128);
+  }
+}
+}  // namespace
+
+TEST_F(TestGemmAvx, MatmulFp32Nhwc) {
+  if (!X86SupportAvx2()) {
+    return;
+  }
+  int row = 13, col = 11, deep = 7, stride = 12;
+  int row8 = UP_ROUND(row, C8NUM), col8 = UP_ROUND(col, C8NUM);
+  std::vector<float> a(row8 * deep), b(col8 * deep), bias(col8), out(row * stride), correct(row * stride);
+  FillFp32(&a);
+  FillFp32(&b);
+  FillFp32(&bias);
+  for (int r = 0; r < row; r++) {
+    for (int c = 0; c < col; c++) {
+      float value = bias[c];
+      for (int d = 0; d < deep; d++) {
+        value += a[r / C8NUM * deep * C8NUM + d * C8NUM + r % C8NUM] *
+                 b[c / C8NUM * deep * C8NUM + d * C8NUM + c % C8NUM];
+      }
+      correct[r * stride + c] = MSMIN(MSMAX(value, 0.0f), 6.0f);
+    }
+  }
+  MatmulFloatAvx2(a.data(), b.data(), out.data(), bias.data(), ActType_Relu6, deep, row, col, stride, true);
+  CompareOutputData(out.data(), correct.data(), row * stride, 0.0001);
+}
+
+TEST_F(TestGemmAvx, IndirectGemmFp32) {
+  if (!X86SupportAvx2()) {
+    return;
+  }
+  size_t step = 9, ic4 = 3, output_channel = 13;
+  size_t oc8 = UP_DIV(output_channel, C8NUM);
+  std::vector<float> input(step * ic4 * TILE_NUM * C4NUM), weight(oc8 * step * ic4 * C4NUM * C8NUM);
+  std::vector<float> bias(oc8 * C8NUM), out(TILE_NUM * output_channel), correct(TILE_NUM * output_channel);
+  FillFp32(&input);
+  FillFp32(&weight);
+  FillFp32(&bias);
+  IndirectGemmFp32(correct.data(), input.data(), weight.data(), bias.data(), step, ic4, output_channel, 0, 1, 0);
+  IndirectGemmFp32_8x8Avx2(out.data(), input.data(), weight.data(), bias.data(), step, ic4, output_channel, 1, 0);
+  CompareOutputData(out.data(), correct.data(), TILE_NUM * output_channel, 0.0001);
+}
+
+TEST_F(TestGemmAvx, MatmulInt8) {
+  if (!X86SupportAvx2()) {
+    return;
+  }
+  int row8 = 16, col8 = 24, deep = 15;
+  int32_t a_zp = -3, b_zp = 5;
+  std::vector<int8_t> a(row8 * deep), b(col8 * deep);
+  std::vector<int32_t> out(row8 * col8), correct(row8 * col8);
+  FillInt8(&a, 1);
+  FillInt8(&b, 2);
+  for (int r = 0; r < row8; r++) {
+    for (int c = 0; c < col8; c++) {
+      int32_t value = 0;
+      for (int d = 0; d < deep; d++) {
+        value += (a[r / C8NUM * deep * C8NUM + d * C8NUM + r % C8NUM] - a_zp) *
+                 (b[c / C8NUM * deep * C8NUM + d * C8NUM + c % C8NUM] - b_zp);
+      }
+      correct[c / C8NUM * row8 * C8NUM + r * C8NUM + c % C8NUM] = value;
+    }
+  }
+  MatMulInt8Avx2(a.data(), b.data(), out.data(), row8, col8, deep, a_zp, b_zp);
+  CompareOutputData(out.data(), correct.data(), row8 * col8, 0);
+  if (X86SupportAvx512Vnni()) {
+    MatMulInt8Avx512Vnni(a.data(), b.data(), out.data(), row8, col8, deep, a_zp, b_zp);
+    CompareOutputData(out.data(), correct.data(), row8 * col8, 0);
+  }
+}
+}  // namespace mindspore
+#endif
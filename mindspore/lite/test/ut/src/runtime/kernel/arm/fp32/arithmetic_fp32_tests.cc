@@ -1013,4 +1013,71 @@ TEST_F(TestArithmeticTestFp32, EqualFp32) {
   input1_tensor.SetData(nullptr);
   output0_tensor.SetData(nullptr);
 }
+
+TEST_F(TestArithmeticTestFp32, AddRestoreShapeStateFp32) {
+  ArithmeticParameter add_param;
+  add_param.broadcasting_ = false;
+  add_param.op_parameter_.type_ = schema::PrimitiveType_Add;
+  add_param.activation_type_ = schema::ActivationType_NO_ACTIVATION;
+
+  std::vector<float> input0 = {1, 2, 3, 4, 5, 6, 7, 8};
+  std::vector<float> input1 = {10, 20, 30, 40, 50, 60, 70, 80};
+  std::vector<float> output(8);
+  lite::tensor::Tensor input0_tensor;
+  lite::tensor::Tensor input1_tensor;
+  lite::tensor::Tensor output0_tensor;
+  input0_tensor.set_data_type(kNumberTypeFloat32);
+  input0_tensor.SetData(input0.data());
+  input1_tensor.SetData(input1.data());
+  output0_tensor.SetData(output.data());
+  input0_tensor.set_shape({2, 4});
+  input1_tensor.set_shape({2, 4});
+  output0_tensor.set_shape({2, 4});
+  std::vector<lite::tensor::Tensor *> inputs_tensor = {&input0_tensor, &input1_tensor};
+  std::vector<lite::tensor::Tensor *> outputs_tensor = {&output0_tensor};
+
+  kernel::KernelKey desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, schema::PrimitiveType_Eltwise};
+  auto creator = lite::KernelRegistry::GetInstance()->GetCreator(desc);
+  ASSERT_NE(creator, nullptr);
+  lite::Context ctx;
+  ctx.thread_num_ = 2;
+  kernel::LiteKernel *kernel =
+    creator(inputs_tensor, outputs_tensor, reinterpret_cast<OpParameter *>(&add_param), &ctx, desc, nullptr);
+  ASSERT_NE(kernel, nullptr);
+  auto elementwise_state = kernel->SaveShapeState();
+  ASSERT_NE(elementwise_state, nullptr);
+
+  // a scalar second input switches the kernel to the optimized broadcast
+  input0_tensor.set_shape({8});
+  input1_tensor.set_shape({1});
+  output0_tensor.set_shape({8});
+  ASSERT_EQ(kernel->ReSize(), lite::RET_OK);
+  auto scalar_state = kernel->SaveShapeState();
+  ASSERT_NE(scalar_state, nullptr);
+  ASSERT_EQ(kernel->Run(), lite::RET_OK);
+  std::vector<float> scalar_out = {11, 12, 13, 14, 15, 16, 17, 18};
+  CompareOutputData(output.data(), scalar_out.data(), 8, 0.00001);
+
+  // switching back restores the elementwise add without ReSize
+  input0_tensor.set_shape({2, 4});
+  input1_tensor.set_shape({2, 4});
+  output0_tensor.set_shape({2, 4});
+  ASSERT_EQ(kernel->RestoreShapeState(elementwise_state), lite::RET_OK);
+  ASSERT_EQ(kernel->Run(), lite::RET_OK);
+  std::vector<float> elementwise_out = {11, 22, 33, 44, 55, 66, 77, 88};
+  CompareOutputData(output.data(), elementwise_out.data(), 8, 0.00001);
+
+  input0_tensor.set_shape({8});
+  input1_tensor.set_shape({1});
+  output0_tensor.set_shape({8});
+  ASSERT_EQ(kernel->RestoreShapeState(scalar_state), lite::RET_OK);
+  ASSERT_EQ(kernel->Run(), lite::RET_OK);
+  CompareOutputData(output.data(), scalar_out.data(), 8, 0.00001);
+  EXPECT_NE(kernel->RestoreShapeState(nullptr), lite::RET_OK);
+
+  delete kernel;
+  input0_tensor.SetData(nullptr);
+  input1_tensor.SetData(nullptr);
+  output0_tensor.SetData(nullptr);
+}
 }  // namespace mindspore
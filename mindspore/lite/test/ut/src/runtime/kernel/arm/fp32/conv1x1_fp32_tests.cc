@@ -16,6 +16,7 @@
 #include <sys/time.h>
 #include <iostream>
 #include <memory>
+#include <vector>
 #include "utils/log_adapter.h"
 #include "common/common_test.h"
 #include "src/common/file_utils.h"
@@ -309,6 +310,35 @@ TEST_F(TestConv1x1Fp32, Conv1x1Test1) {
   free(correct);
 }
 
+TEST_F(TestConv1x1Fp32, Conv1x1PrepackedWeightTest1) {
+  std::vector<lite::tensor::Tensor *> inputs_;
+  std::vector<lite::tensor::Tensor *> outputs_;
+  auto conv_param = new ConvParameter();
+  lite::Context *ctx = new lite::Context();
+  ctx->thread_num_ = 1;
+  float *correct;
+  int total_size = Conv1x1TestInit1(&inputs_, &outputs_, conv_param, &correct);
+  /* weight packed the way the converter does, the original data must not be used anymore */
+  auto weight_t = inputs_[1];
+  std::vector<float> packed_weight(4 * UP_ROUND(3, C8NUM), 0);
+  RowMajor2Col8Major(reinterpret_cast<float *>(weight_t->Data()), packed_weight.data(), 3, 4);
+  weight_t->SetPackedData(schema::WeightLayout_CONV1X1_FP32_COL8, packed_weight.data(),
+                          packed_weight.size() * sizeof(float));
+  memset(weight_t->Data(), 0, weight_t->Size());
+  kernel::Convolution1x1CPUKernel *conv1x1 =
+    new kernel::Convolution1x1CPUKernel(reinterpret_cast<OpParameter *>(conv_param), inputs_, outputs_, ctx, nullptr);
+
+  conv1x1->Init();
+  conv1x1->Run();
+
+  CompareOutputData(reinterpret_cast<float *>(outputs_[0]->Data()), correct, total_size, 0.0001);
+  delete conv_param;
+  delete conv1x1;
+  for (auto t : inputs_) delete t;
+  for (auto t : outputs_) delete t;
+  free(correct);
+}
+
 int Conv1x1TestInit2(std::vector<lite::tensor::Tensor *> *inputs_, std::vector<lite::tensor::Tensor *> *outputs_,
                      ConvParameter *conv_param, float **correct) {
   size_t buffer_size;
@@ -0,0 +1,144 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <vector>
+#include "common/common_test.h"
+#include "include/errorcode.h"
+#include "mindspore/lite/src/lite_kernel.h"
+#include "mindspore/lite/src/runtime/memory_planner.h"
+
+namespace mindspore {
+class MemoryPlannerTest : public mindspore::CommonTest {
+ public:
+  MemoryPlannerTest() {}
+};
+
+TEST_F(MemoryPlannerTest, TestReuseChain) {
+  std::vector<int> shape = {1, 16};
+  auto tensor0 = std::make_shared<lite::tensor::Tensor>(kNumberTypeFloat32, shape);
+  auto tensor1 = std::make_shared<lite::tensor::Tensor>(kNumberTypeFloat32, shape);
+  auto tensor2 = std::make_shared<lite::tensor::Tensor>(kNumberTypeFloat32, shape);
+  auto tensor3 = std::make_shared<lite::tensor::Tensor>(kNumberTypeFloat32, shape);
+
+  kernel::KernelKey desc{kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, schema::PrimitiveType_Activation};
+  auto kernel0 = std::make_shared<kernel::LiteKernel>();
+  auto kernel1 = std::make_shared<kernel::LiteKernel>();
+  auto kernel2 = std::make_shared<kernel::LiteKernel>();
+  kernel0->set_desc(desc);
+  kernel1->set_desc(desc);
+  kernel2->set_desc(desc);
+  kernel0->set_in_tensors({tensor0.get()});
+  kernel0->set_out_tensors({tensor1.get()});
+  kernel1->set_in_tensors({tensor1.get()});
+  kernel1->set_out_tensors({tensor2.get()});
+  kernel2->set_in_tensors({tensor2.get()});
+  kernel2->set_out_tensors({tensor3.get()});
+  kernel2->set_is_model_output(true);
+  std::vector<kernel::LiteKernel *> kernels = {kernel0.get(), kernel1.get(), kernel2.get()};
+
+  lite::MemoryPlanner planner;
+  ASSERT_EQ(planner.Plan(kernels), lite::RET_OK);
+  ASSERT_TRUE(planner.IsPlanned());
+  // tensor1 is dead when tensor3 is produced, so only two buffers of 64 bytes are needed
+  ASSERT_EQ(planner.GetTotalSize(), 128);
+  ASSERT_EQ(tensor1->Data(), tensor3->Data());
+  ASSERT_NE(tensor1->Data(), tensor2->Data());
+  ASSERT_EQ(tensor0->Data(), nullptr);
+
+  planner.Clear();
+  ASSERT_FALSE(planner.IsPlanned());
+  ASSERT_EQ(tensor1->Data(), nullptr);
+  ASSERT_EQ(tensor3->allocator(), nullptr);
+}
+
+TEST_F(MemoryPlannerTest, TestKeepBranchAlive) {
+  std::vector<int> shape = {1, 16};
+  auto tensor0 = std::make_shared<lite::tensor::Tensor>(kNumberTypeFloat32, shape);
+  auto tensor1 = std::make_shared<lite::tensor::Tensor>(kNumberTypeFloat32, shape);
+  auto tensor2 = std::make_shared<lite::tensor::Tensor>(kNumberTypeFloat32, shape);
+  auto tensor3 = std::make_shared<lite::tensor::Tensor>(kNumberTypeFloat32, shape);
+
+  kernel::KernelKey desc{kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, schema::PrimitiveType_Add};
+  auto kernel0 = std::make_shared<kernel::LiteKernel>();
+  auto kernel1 = std::make_shared<kernel::LiteKernel>();
+  auto kernel2 = std::make_shared<kernel::LiteKernel>();
+  kernel0->set_desc(desc);
+  kernel1->set_desc(desc);
+  kernel2->set_desc(desc);
+  kernel0->set_in_tensors({tensor0.get()});
+  kernel0->set_out_tensors({tensor1.get()});
+  kernel1->set_in_tensors({tensor1.get()});
+  kernel1->set_out_tensors({tensor2.get()});
+  // tensor1 is also consumed by the last kernel, it must not be overwritten by tensor3
+  kernel2->set_in_tensors({tensor1.get(), tensor2.get()});
+  kernel2->set_out_tensors({tensor3.get()});
+  kernel2->set_is_model_output(true);
+  std::vector<kernel::LiteKernel *> kernels = {kernel0.get(), kernel1.get(), kernel2.get()};
+
+  lite::MemoryPlanner planner;
+  ASSERT_EQ(planner.Plan(kernels), lite::RET_OK);
+  ASSERT_EQ(planner.GetTotalSize(), 192);
+  ASSERT_NE(tensor1->Data(), tensor3->Data());
+  ASSERT_NE(tensor2->Data(), tensor3->Data());
+}
+
+TEST_F(MemoryPlannerTest, TestConcurrentSteps) {
+  std::vector<int> shape = {1, 16};
+  std::vector<std::shared_ptr<lite::tensor::Tensor>> tensors;
+  for (int i = 0; i < 5; ++i) {
+    tensors.emplace_back(std::make_shared<lite::tensor::Tensor>(kNumberTypeFloat32, shape));
+  }
+  kernel::KernelKey desc{kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, schema::PrimitiveType_Activation};
+  std::vector<std::shared_ptr<kernel::LiteKernel>> holders;
+  for (int i = 0; i < 4; ++i) {
+    holders.emplace_back(std::make_shared<kernel::LiteKernel>());
+    holders.back()->set_desc(desc);
+  }
+  // two independent branches: t0 -> k0 -> t1 -> k2 -> t3 and t0 -> k1 -> t2 -> k3 -> t4
+  holders[0]->set_in_tensors({tensors[0].get()});
+  holders[0]->set_out_tensors({tensors[1].get()});
+  holders[1]->set_in_tensors({tensors[0].get()});
+  holders[1]->set_out_tensors({tensors[2].get()});
+  holders[2]->set_in_tensors({tensors[1].get()});
+  holders[2]->set_out_tensors({tensors[3].get()});
+  holders[3]->set_in_tensors({tensors[2].get()});
+  holders[3]->set_out_tensors({tensors[4].get()});
+  holders[2]->set_is_model_output(true);
+  holders[3]->set_is_model_output(true);
+  std::vector<kernel::LiteKernel *> kernels;
+  for (auto &holder : holders) {
+    kernels.emplace_back(holder.get());
+  }
+
+  lite::MemoryPlanner planner;
+  // run in sequence, t1 is dead when t4 is produced
+  ASSERT_EQ(planner.Plan(kernels), lite::RET_OK);
+  ASSERT_EQ(planner.GetTotalSize(), 192);
+  ASSERT_EQ(tensors[1]->Data(), tensors[4]->Data());
+  auto reused = planner.ReusedMemory();
+  ASSERT_EQ(reused.size(), 1);
+  ASSERT_EQ(reused[0].first, tensors[1].get());
+  ASSERT_EQ(reused[0].second, tensors[4].get());
+  // run branch by branch concurrently, every tensor is alive in the same wave as another one
+  planner.Clear();
+  ASSERT_EQ(planner.Plan(kernels, {0, 0, 1, 1}), lite::RET_OK);
+  ASSERT_EQ(planner.GetTotalSize(), 256);
+  ASSERT_NE(tensors[1]->Data(), tensors[4]->Data());
+  ASSERT_NE(tensors[2]->Data(), tensors[3]->Data());
+  ASSERT_TRUE(planner.ReusedMemory().empty());
+}
+}  // namespace mindspore
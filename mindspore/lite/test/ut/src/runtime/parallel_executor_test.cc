@@ -0,0 +1,231 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "include/errorcode.h"
+#include "mindspore/lite/src/executor.h"
+#include "mindspore/lite/src/lite_kernel.h"
+#include "mindspore/lite/src/runtime/allocator.h"
+#include "mindspore/lite/src/runtime/parallel_executor.h"
+#include "mindspore/lite/src/runtime/runtime_api.h"
+#include "mindspore/lite/src/runtime/thread_pool.h"
+
+namespace mindspore {
+namespace {
+constexpr int kElements = 16;
+
+constexpr auto kWaitTimeout = std::chrono::seconds(2);
+
+// out = scale * sum(inputs), the logical clock records when the kernel started and ended
+class ScaleSumKernel : public kernel::LiteKernel {
+ public:
+  ScaleSumKernel(float scale, std::atomic_int *clock) : scale_(scale), clock_(clock) {}
+  ~ScaleSumKernel() override = default;
+
+  int Run() override {
+    start_ = (*clock_)++;
+    // a kernel waiting for another one holds its lane until the other one ended or the wait timed out
+    auto wait_begin = std::chrono::steady_clock::now();
+    while (wait_for_ != nullptr && !wait_for_->done_ && std::chrono::steady_clock::now() - wait_begin < kWaitTimeout) {
+      std::this_thread::yield();
+    }
+    auto out = reinterpret_cast<float *>(out_tensors_[0]->Data());
+    for (int i = 0; i < kElements; ++i) {
+      float sum = 0;
+      for (auto *input : in_tensors_) {
+        sum += reinterpret_cast<float *>(input->Data())[i];
+      }
+      out[i] = scale_ * sum;
+    }
+    end_ = (*clock_)++;
+    done_ = true;
+    return lite::RET_OK;
+  }
+
+  int start_ = -1;
+  int end_ = -1;
+  std::atomic_bool done_ = {false};
+  const ScaleSumKernel *wait_for_ = nullptr;
+
+ private:
+  float scale_;
+  std::atomic_int *clock_;
+};
+
+// t1 = 2 * t0, t2 = 3 * t0 and t5 = 5 * t0 only read the graph input, t3 = t1 + t2 and t4 = t3 + t1 wait for them
+struct TestGraph {
+  TestGraph() {
+    for (int i = 0; i < 6; ++i) {
+      tensors.emplace_back(std::make_shared<lite::tensor::Tensor>(kNumberTypeFloat32, std::vector<int>{1, kElements}));
+    }
+    const std::vector<float> scales = {2, 3, 1, 1, 5};
+    for (auto scale : scales) {
+      holders.emplace_back(std::make_shared<ScaleSumKernel>(scale, &clock));
+    }
+    Connect(0, {}, {0}, 1);
+    Connect(1, {}, {0}, 2);
+    Connect(2, {0, 1}, {1, 2}, 3);
+    Connect(3, {2, 0}, {3, 1}, 4);
+    Connect(4, {}, {0}, 5);
+    holders[3]->set_is_model_output(true);
+    holders[4]->set_is_model_output(true);
+    for (auto &holder : holders) {
+      kernels.emplace_back(holder.get());
+    }
+    tensors[0]->MallocData();
+    auto input = reinterpret_cast<float *>(tensors[0]->Data());
+    for (int i = 0; i < kElements; ++i) {
+      input[i] = static_cast<float>(i);
+    }
+    in_tensors = {tensors[0].get()};
+    out_tensors = {tensors[4].get(), tensors[5].get()};
+  }
+
+  void Connect(size_t kernel, const std::vector<size_t> &producers, const std::vector<size_t> &inputs_index,
+               size_t output_index) {
+    std::vector<lite::tensor::Tensor *> inputs;
+    for (auto index : inputs_index) {
+      inputs.emplace_back(tensors[index].get());
+    }
+    holders[kernel]->set_in_tensors(inputs);
+    holders[kernel]->set_out_tensors({tensors[output_index].get()});
+    for (auto index : producers) {
+      holders[kernel]->AddInKernel(holders[index].get());
+      holders[index]->AddOutKernel(holders[kernel].get());
+    }
+  }
+
+  std::vector<float> Output(size_t index) {
+    auto data = reinterpret_cast<float *>(out_tensors[index]->Data());
+    return std::vector<float>(data, data + kElements);
+  }
+
+  std::atomic_int clock = {0};
+  std::vector<std::shared_ptr<lite::tensor::Tensor>> tensors;
+  std::vector<std::shared_ptr<ScaleSumKernel>> holders;
+  std::vector<kernel::LiteKernel *> kernels;
+  std::vector<lite::tensor::Tensor *> in_tensors;
+  std::vector<lite::tensor::Tensor *> out_tensors;
+  std::shared_ptr<lite::Allocator> allocator = lite::Allocator::Create();
+};
+}  // namespace
+
+class ParallelExecutorTest : public mindspore::CommonTest {
+ public:
+  ParallelExecutorTest() {}
+};
+
+TEST_F(ParallelExecutorTest, TestSameOutputsAsSerial) {
+  predict::GlobalThreadPool()->ConfigMaxThreadNum(4);
+  TestGraph serial_graph;
+  lite::Executor serial;
+  ASSERT_EQ(serial.Prepare(serial_graph.kernels), lite::RET_OK);
+  ASSERT_EQ(serial.Run(serial_graph.in_tensors, serial_graph.out_tensors, serial_graph.kernels,
+                       serial_graph.allocator.get()),
+            lite::RET_OK);
+
+  TestGraph parallel_graph;
+  lite::ParallelExecutor parallel;
+  ASSERT_EQ(parallel.Prepare(parallel_graph.kernels), lite::RET_OK);
+  // run twice, the second run reuses the plan of the first one
+  for (int run = 0; run < 2; ++run) {
+    ASSERT_EQ(parallel.Run(parallel_graph.in_tensors, parallel_graph.out_tensors, parallel_graph.kernels,
+                           parallel_graph.allocator.get()),
+              lite::RET_OK);
+    for (size_t i = 0; i < serial_graph.out_tensors.size(); ++i) {
+      ASSERT_EQ(parallel_graph.Output(i), serial_graph.Output(i));
+    }
+  }
+  // t4 = (2 + 3) * t0 + 2 * t0
+  ASSERT_EQ(parallel_graph.Output(0)[3], 21.0f);
+}
+
+TEST_F(ParallelExecutorTest, TestDependencyOrder) {
+  predict::GlobalThreadPool()->ConfigMaxThreadNum(4);
+  TestGraph graph;
+  lite::ParallelExecutor parallel;
+  ASSERT_EQ(parallel.Prepare(graph.kernels), lite::RET_OK);
+  ASSERT_EQ(parallel.Run(graph.in_tensors, graph.out_tensors, graph.kernels, graph.allocator.get()), lite::RET_OK);
+  for (auto &holder : graph.holders) {
+    ASSERT_GE(holder->start_, 0);
+    ASSERT_GT(holder->end_, holder->start_);
+    // a kernel starts after all its producers ended
+    for (auto *in_kernel : holder->in_kernels()) {
+      ASSERT_GT(holder->start_, static_cast<ScaleSumKernel *>(in_kernel)->end_);
+    }
+  }
+}
+
+TEST_F(ParallelExecutorTest, TestSuccessorsDoNotWaitForSlowKernels) {
+  predict::GlobalThreadPool()->ConfigMaxThreadNum(4);
+  TestGraph graph;
+  // t5 = 5 * t0 has no consumer but keeps running until t4 = t3 + t1 two levels deeper has been computed
+  graph.holders[4]->wait_for_ = graph.holders[3].get();
+  lite::ParallelExecutor parallel;
+  ASSERT_EQ(parallel.Prepare(graph.kernels), lite::RET_OK);
+  ASSERT_EQ(parallel.Run(graph.in_tensors, graph.out_tensors, graph.kernels, graph.allocator.get()), lite::RET_OK);
+  ASSERT_LT(graph.holders[4]->start_, graph.holders[2]->start_);
+  ASSERT_GT(graph.holders[4]->end_, graph.holders[3]->end_);
+  ASSERT_EQ(graph.Output(1)[3], 15.0f);
+}
+
+namespace {
+// runs a parallel launch of many short tasks and records the threads which ran them
+class LaunchKernel : public kernel::LiteKernel {
+ public:
+  LaunchKernel() = default;
+  ~LaunchKernel() override = default;
+
+  int Run() override { return LiteBackendParallelLaunch(RunTask, this, kTaskNum); }
+
+  static int RunTask(int task_id, LiteParallelGroupEnv *penv, void *cdata) {
+    auto kernel = reinterpret_cast<LaunchKernel *>(cdata);
+    {
+      std::lock_guard<std::mutex> lock(kernel->mutex_);
+      kernel->threads_.insert(std::this_thread::get_id());
+    }
+    auto begin = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - begin < std::chrono::milliseconds(1)) {
+    }
+    return 0;
+  }
+
+  static constexpr int kTaskNum = 64;
+  std::mutex mutex_;
+  std::set<std::thread::id> threads_;
+};
+}  // namespace
+
+TEST_F(ParallelExecutorTest, TestLaunchSharedByIdleLanes) {
+  predict::GlobalThreadPool()->ConfigMaxThreadNum(4);
+  TestGraph graph;
+  // a large kernel next to the small ones of the first level gets the threads they leave idle
+  LaunchKernel launch_kernel;
+  graph.kernels.emplace_back(&launch_kernel);
+  lite::ParallelExecutor parallel;
+  ASSERT_EQ(parallel.Prepare(graph.kernels), lite::RET_OK);
+  ASSERT_EQ(parallel.Run(graph.in_tensors, graph.out_tensors, graph.kernels, graph.allocator.get()), lite::RET_OK);
+  ASSERT_GT(launch_kernel.threads_.size(), 1u);
+  ASSERT_EQ(graph.Output(0)[3], 21.0f);
+}
+}  // namespace mindspore
@@ -0,0 +1,105 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "common/common_test.h"
+#include "mindspore/lite/src/runtime/runtime_api.h"
+#include "mindspore/lite/src/runtime/thread_pool.h"
+
+namespace mindspore {
+class ThreadPoolTest : public mindspore::CommonTest {
+ public:
+  ThreadPoolTest() {}
+};
+
+TEST_F(ThreadPoolTest, TestParallelForCoversRange) {
+  auto pool = predict::GlobalThreadPool();
+  pool->ConfigMaxThreadNum(4);
+  for (int grain = 1; grain <= 7; ++grain) {
+    const int count = 1000;
+    std::vector<std::atomic_int> visits(count);
+    bool succ = pool->ParallelFor(0, count, grain, [&visits, grain](int begin, int end) {
+      EXPECT_LE(end - begin, grain);
+      for (int i = begin; i < end; ++i) {
+        visits[i]++;
+      }
+      return 0;
+    });
+    ASSERT_TRUE(succ);
+    for (auto &visit : visits) {
+      ASSERT_EQ(visit.load(), 1);
+    }
+  }
+}
+
+TEST_F(ThreadPoolTest, TestNestedLaunch) {
+  auto pool = predict::GlobalThreadPool();
+  pool->ConfigMaxThreadNum(4);
+  std::atomic_int sum = {0};
+  bool succ = pool->LaunchWork(
+    [pool, &sum](int task_id, predict::TvmEnv *penv, void *cdata) {
+      EXPECT_EQ(penv->num_task, 8);
+      // a launch from inside a task runs in place
+      return pool->ParallelFor(0, 4, 1, [&sum, task_id](int begin, int end) {
+        sum += (end - begin) * task_id;
+        return 0;
+      }) ? 0 : 1;
+    },
+    nullptr, 8);
+  ASSERT_TRUE(succ);
+  ASSERT_EQ(sum.load(), 4 * 28);
+}
+
+TEST_F(ThreadPoolTest, TestTaskFailure) {
+  auto pool = predict::GlobalThreadPool();
+  pool->ConfigMaxThreadNum(4);
+  bool succ = pool->LaunchWork([](int task_id, predict::TvmEnv *penv, void *cdata) { return task_id == 3 ? 1 : 0; },
+                               nullptr, 8);
+  ASSERT_FALSE(succ);
+  auto ret = LiteBackendParallelFor([](int begin, int end, void *cdata) { return 0; }, nullptr, 0, 100, 10);
+  ASSERT_EQ(ret, 0);
+}
+
+TEST_F(ThreadPoolTest, TestConfiguredThreadNum) {
+  predict::ThreadPool pool;
+  // more threads than the old cap of 8
+  const int thread_num = 12;
+  pool.ConfigThreadPool(predict::NO_BIND, thread_num);
+  pool.ConfigMaxThreadNum(thread_num);
+  int expect_num = std::min(thread_num, static_cast<int>(std::max(8u, std::thread::hardware_concurrency())));
+  std::atomic_int nested_tasks = {0};
+  bool succ = pool.LaunchWork(
+    [&pool, &nested_tasks, expect_num](int task_id, predict::TvmEnv *penv, void *cdata) {
+      EXPECT_EQ(penv->num_task, expect_num);
+      // a nested launch sized by the pool runs in place
+      return pool.LaunchWork(
+               [&nested_tasks](int task_id, predict::TvmEnv *penv, void *cdata) {
+                 nested_tasks++;
+                 return 0;
+               },
+               nullptr, 0)
+               ? 0
+               : 1;
+    },
+    nullptr, 0);
+  ASSERT_TRUE(succ);
+  ASSERT_EQ(nested_tasks.load(), expect_num * expect_num);
+  pool.ConfigMaxThreadNum(4);
+}
+}  // namespace mindspore
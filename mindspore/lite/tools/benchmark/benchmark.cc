@@ -290,6 +290,12 @@ int Benchmark::MarkPerformance() {
     }
   }
 
+  // only the benchmark loops are profiled
+  auto profiler = session->GetProfiler();
+  if (profiler != nullptr) {
+    profiler->Clear();
+  }
+
   MS_LOG(INFO) << "Running benchmark loops...";
   uint64_t timeMin = 1000000;
   uint64_t timeMax = 0;
@@ -321,6 +327,34 @@ int Benchmark::MarkPerformance() {
            _flags->modelPath.substr(_flags->modelPath.find_last_of(DELIM_SLASH) + 1).c_str(), _flags->numThreads,
            timeMin / 1000.0f, timeMax / 1000.0f, timeAvg / 1000.0f);
   }
+  return DumpProfile();
+}
+
+int Benchmark::DumpProfile() {
+  auto profiler = session->GetProfiler();
+  if (profiler == nullptr) {
+    return RET_OK;
+  }
+  auto summary = profiler->Summary(_flags->profileSortBy);
+  if (summary.empty()) {
+    MS_LOG(ERROR) << "Get profile summary failed, profileSortBy: " << _flags->profileSortBy;
+    return RET_ERROR;
+  }
+  printf("%s", summary.c_str());
+  if (!_flags->profileSummaryPath.empty()) {
+    auto status = profiler->WriteSummaryJson(_flags->profileSummaryPath);
+    if (status != RET_OK) {
+      MS_LOG(ERROR) << "Write profile summary failed: " << _flags->profileSummaryPath;
+      return status;
+    }
+  }
+  if (!_flags->profileTracePath.empty()) {
+    auto status = profiler->WriteChromeTrace(_flags->profileTracePath);
+    if (status != RET_OK) {
+      MS_LOG(ERROR) << "Write profile trace failed: " << _flags->profileTracePath;
+      return status;
+    }
+  }
   return RET_OK;
 }
 
@@ -362,19 +396,23 @@ int Benchmark::RunBenchmark(const std::string &deviceType) {
   std::string modelName = _flags->modelPath.substr(_flags->modelPath.find_last_of(DELIM_SLASH) + 1);
 
   MS_LOG(INFO) << "start reading model file";
-  size_t size = 0;
-  char *graphBuf = ReadFile(_flags->modelPath.c_str(), &size);
-  if (graphBuf == nullptr) {
-    MS_LOG(ERROR) << "Read model file failed while running %s", modelName.c_str();
-    return RET_ERROR;
+  auto model = lite::Model::ImportFromFile(_flags->modelPath.c_str());
+  if (model == nullptr) {
+    // mapping the file is not supported everywhere, e.g. on windows, read it into a buffer instead
+    MS_LOG(WARNING) << "Map model file failed, read it instead";
+    size_t size = 0;
+    char *graphBuf = ReadFile(_flags->modelPath.c_str(), &size);
+    if (graphBuf == nullptr) {
+      MS_LOG(ERROR) << "Read model file failed while running %s", modelName.c_str();
+      return RET_ERROR;
+    }
+    model = lite::Model::Import(graphBuf, size);
+    delete[](graphBuf);
   }
-  auto model = lite::Model::Import(graphBuf, size);
   if (model == nullptr) {
     MS_LOG(ERROR) << "Import model file failed while running %s", modelName.c_str();
-    delete[](graphBuf);
     return RET_ERROR;
   }
-  delete[](graphBuf);
   auto context = new (std::nothrow) lite::Context;
   if (context == nullptr) {
     MS_LOG(ERROR) << "New context failed while running %s", modelName.c_str();
@@ -397,6 +435,9 @@ int Benchmark::RunBenchmark(const std::string &deviceType) {
   }
   context->thread_num_ = _flags->numThreads;
   context->float16_priority = _flags->fp16Priority;
+  context->enable_parallel_ = _flags->enableParallel;
+  context->enable_profiling_ = _flags->profiling || !_flags->profileSummaryPath.empty() ||
+                               !_flags->profileTracePath.empty();
   session = session::LiteSession::CreateSession(context);
   delete (context);
   if (session == nullptr) {
@@ -506,6 +547,7 @@ int Benchmark::Init() {
   MS_LOG(INFO) << "NumThreads = " << this->_flags->numThreads;
   MS_LOG(INFO) << "Fp16Priority = " << this->_flags->fp16Priority;
   MS_LOG(INFO) << "calibDataPath = " << this->_flags->calibDataPath;
+  MS_LOG(INFO) << "Profiling = " << this->_flags->profiling;
 
   if (this->_flags->loopCount < 1) {
     MS_LOG(ERROR) << "LoopCount:" << this->_flags->loopCount << " must be greater than 0";
@@ -64,7 +64,14 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
     AddFlag(&BenchmarkFlags::loopCount, "loopCount", "Run loop count", 10);
     AddFlag(&BenchmarkFlags::numThreads, "numThreads", "Run threads number", 2);
     AddFlag(&BenchmarkFlags::fp16Priority, "fp16Priority", "Priority float16", false);
+    AddFlag(&BenchmarkFlags::enableParallel, "enableParallel", "Run independent kernels concurrently", false);
     AddFlag(&BenchmarkFlags::warmUpLoopCount, "warmUpLoopCount", "Run warm up loop", 3);
+    // Profiling
+    AddFlag(&BenchmarkFlags::profiling, "profiling", "Print the time of every kernel of the benchmark loops", false);
+    AddFlag(&BenchmarkFlags::profileSortBy, "profileSortBy",
+            "Sort kernels by total | avg | p50 | p90 | p99 | max | flops | name", "total");
+    AddFlag(&BenchmarkFlags::profileSummaryPath, "profileSummaryPath", "Write the kernel summary as json", "");
+    AddFlag(&BenchmarkFlags::profileTracePath, "profileTracePath", "Write kernel runs as a chrome trace", "");
     // MarkAccuracy
     AddFlag(&BenchmarkFlags::calibDataPath, "calibDataPath", "Calibration data file path", "");
     AddFlag(&BenchmarkFlags::accuracyThreshold, "accuracyThreshold", "Threshold of accuracy", 0.5);
@@ -90,7 +97,13 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
   int loopCount;
   int numThreads;
   bool fp16Priority;
+  bool enableParallel;
   int warmUpLoopCount;
+  // Profiling
+  bool profiling;
+  std::string profileSortBy;
+  std::string profileSummaryPath;
+  std::string profileTracePath;
   // MarkAccuracy
   std::string calibDataPath;
   float accuracyThreshold;
@@ -133,6 +146,8 @@ class MS_API Benchmark {
 
   int MarkAccuracy();
 
+  int DumpProfile();
+
  private:
   BenchmarkFlags *_flags;
   session::LiteSession *session;
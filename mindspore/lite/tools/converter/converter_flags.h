@@ -75,6 +75,7 @@ class Flags : public virtual mindspore::lite::FlagParser {
   std::string bitNum;
   std::string configFile;
   bool formatTrans = true;
+  bool prepackWeight = false;
   std::string convWeightQuantChannelThreshold;
 };
 }  // namespace converter
@@ -29,6 +29,7 @@
 #include "tools/converter/legacy_optimizer/fusion/quant_cast_fusion_pass.h"
 #include "tools/converter/legacy_optimizer/graph/weight_format_hardcode_pass.h"
 #include "tools/converter/legacy_optimizer/graph/weight_format_transform_pass.h"
+#include "tools/converter/legacy_optimizer/graph/weight_prepack_pass.h"
 #include "tools/converter/legacy_optimizer/graph/format_trans_pass.h"
 #include "tools/converter/legacy_optimizer/graph/eltwise_format_trans_pass.h"
 #include "tools/converter/legacy_optimizer/graph/isolated_node_remove_pass.h"
@@ -197,6 +198,17 @@ int GraphDefTransform::Transform(const converter::Flags &ctx) {
       return status;
     }
   }
+
+  // weights are final now, pack them for the runtime kernels
+  if (ctx.prepackWeight) {
+    Optimizer weightPrepackOptimizer;
+    weightPrepackOptimizer.AddPass(new (std::nothrow) WeightPrepackPass());
+    status = weightPrepackOptimizer.Run(graphDefT);
+    if (status != RET_OK && status != RET_NO_CHANGE) {
+      MS_LOG(ERROR) << "Run weightPrepackOptimizer graphPasses Failed";
+      return status;
+    }
+  }
   return RET_OK;
 }
 }  // namespace mindspore::lite
@@ -0,0 +1,88 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "tools/converter/legacy_optimizer/graph/weight_prepack_pass.h"
+#include <utility>
+#include <vector>
+#include "utils/log_adapter.h"
+#include "src/runtime/weight_prepack.h"
+
+namespace mindspore {
+namespace lite {
+namespace {
+constexpr size_t kConvWeightIndex = 1;
+
+bool IsPackableWeight(const schema::TensorT &weight_tensor) {
+  return IsPackableConvWeight(weight_tensor.nodeType, weight_tensor.format, weight_tensor.dataType,
+                              weight_tensor.dims.data(), weight_tensor.dims.size(), weight_tensor.data.size(),
+                              weight_tensor.packedLayout);
+}
+}  // namespace
+
+STATUS WeightPrepackPass::Run(schema::MetaGraphT *graph) {
+  MS_ASSERT(graph != nullptr);
+  bool changed = false;
+  for (auto &node : graph->nodes) {
+    MS_ASSERT(node != nullptr);
+    MS_ASSERT(node->primitive != nullptr);
+    if (node->primitive->value.type != schema::PrimitiveType_Conv2D || node->inputIndex.size() <= kConvWeightIndex) {
+      continue;
+    }
+    auto conv_attr = node->primitive->value.AsConv2D();
+    MS_ASSERT(conv_attr != nullptr);
+    if (!IsPackableConv(node->quantType, conv_attr->group)) {
+      continue;
+    }
+    auto weight_index = node->inputIndex.at(kConvWeightIndex);
+    MS_ASSERT(graph->allTensors.size() > weight_index);
+    auto weight_tensor = graph->allTensors.at(weight_index).get();
+    if (!IsPackableWeight(*weight_tensor)) {
+      continue;
+    }
+    auto layout = ConvWeightLayout(conv_attr->kernelH, conv_attr->kernelW, conv_attr->strideH, conv_attr->strideW,
+                                   conv_attr->dilateH, conv_attr->dilateW);
+    if (layout == schema::WeightLayout_ORIGIN) {
+      continue;
+    }
+    auto status = PackWeight(weight_tensor, layout);
+    if (status != RET_OK) {
+      MS_LOG(ERROR) << "Prepack weight of node " << node->name << " failed: " << status;
+      return status;
+    }
+    changed = true;
+  }
+  return changed ? RET_OK : RET_NO_CHANGE;
+}
+
+STATUS WeightPrepackPass::PackWeight(schema::TensorT *weight_tensor, schema::WeightLayout layout) {
+  MS_ASSERT(weight_tensor != nullptr);
+  int output_channel = weight_tensor->dims[0];
+  int kernel_h = weight_tensor->dims[1];
+  int kernel_w = weight_tensor->dims[2];
+  int input_channel = weight_tensor->dims[3];
+  std::vector<uint8_t> packed(PackedWeightSize(layout, output_channel, kernel_h, kernel_w, input_channel));
+  auto status = PackConvWeight(layout, reinterpret_cast<float *>(weight_tensor->data.data()), output_channel, kernel_h,
+                               kernel_w, input_channel, packed.data());
+  if (status != RET_OK) {
+    return status;
+  }
+  weight_tensor->packedLayout = layout;
+  weight_tensor->packedData = std::move(packed);
+  return RET_OK;
+}
+}  // namespace lite
+}  // namespace mindspore
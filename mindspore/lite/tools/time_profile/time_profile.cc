@@ -109,6 +109,7 @@ int TimeProfile::InitSession() {
   ctx->cpu_bind_mode_ = static_cast<CpuBindMode>(_flags->cpu_bind_mode_);
   ctx->device_ctx_.type = lite::DT_CPU;
   ctx->thread_num_ = _flags->num_threads_;
+  ctx->enable_profiling_ = !_flags->trace_path_.empty();
 
   session_ = session::LiteSession::CreateSession(ctx);
   if (session_ == nullptr) {
@@ -359,6 +360,11 @@ int TimeProfile::RunTimeProfile() {
 
   printf("\n total time:     %5.5f ms,   kernel cost:   %5.5f ms \n\n", runCost, op_cost_total_ / _flags->loop_count_);
   printf("-------------------------------------------------------------------------\n");
+  auto profiler = session_->GetProfiler();
+  if (profiler != nullptr && profiler->WriteChromeTrace(_flags->trace_path_) != RET_OK) {
+    MS_LOG(ERROR) << "Write chrome trace failed: " << _flags->trace_path_;
+    ret = RET_ERROR;
+  }
   delete model;
   delete session_;
   return ret;
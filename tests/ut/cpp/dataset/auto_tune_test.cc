@@ -0,0 +1,117 @@
+/**
+ * Copyright 2019 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <map>
+#include <memory>
+#include <string>
+#include "common/common.h"
+#include "minddata/dataset/core/client.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/engine/datasetops/source/image_folder_op.h"
+#define private public
+#include "minddata/dataset/engine/perf/auto_tune.h"
+#undef private
+#include "gtest/gtest.h"
+
+using namespace mindspore::dataset;
+
+std::shared_ptr<BatchOp> Batch(int batch_size = 1, bool drop = false, int rows_per_buf = 2);
+
+std::shared_ptr<ExecutionTree> Build(std::vector<std::shared_ptr<DatasetOp>> ops);
+
+std::shared_ptr<ImageFolderOp> ImageFolder(int64_t num_works, int64_t rows, int64_t conns, std::string path,
+                                           bool shuf = false, std::shared_ptr<Sampler> sampler = nullptr,
+                                           std::map<std::string, int32_t> map = {}, bool decode = false);
+
+class MindDataTestAutoTune : public UT::DatasetOpTesting {
+ protected:
+  void SetUp() override {
+    DatasetOpTesting::SetUp();
+    std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+    enable_autotune_ = cfg->enable_autotune();
+    cfg->set_enable_autotune(true);
+    image_folder_ = ImageFolder(4, 2, 8, datasets_root_path_ + "/testPK/data");
+    batch_ = Batch(4);
+    tree_ = Build({image_folder_, batch_});
+    ASSERT_TRUE(tree_->Prepare().IsOk());
+    image_folder_->SetActiveWorkers(1);
+    batch_->SetActiveWorkers(1);
+    auto_tune_ = std::make_unique<AutoTune>(tree_.get());
+    ASSERT_TRUE(auto_tune_->Init().IsOk());
+    // the tree iterates in post order, the leaf comes first
+    ASSERT_EQ(auto_tune_->ops_.size(), 2);
+    ASSERT_EQ(auto_tune_->ops_[0].op, image_folder_.get());
+    ASSERT_EQ(auto_tune_->ops_[1].op, batch_.get());
+    auto_tune_->window_samples_ = kSamples;
+  }
+
+  void TearDown() override { GlobalContext::config_manager()->set_enable_autotune(enable_autotune_); }
+
+  // Pretend every sample of the window saw the output connector of the op at this utilization
+  void SetUtilization(int32_t index, double utilization) {
+    auto_tune_->ops_[index].sum_utilization = utilization * kSamples;
+  }
+
+  static constexpr int32_t kSamples = 10;
+  bool enable_autotune_;
+  std::shared_ptr<ImageFolderOp> image_folder_;
+  std::shared_ptr<BatchOp> batch_;
+  std::shared_ptr<ExecutionTree> tree_;
+  std::unique_ptr<AutoTune> auto_tune_;
+};
+
+TEST_F(MindDataTestAutoTune, TestScaleBottleneck) {
+  // batch starves its output while the images pile up in front of it
+  SetUtilization(0, 0.9);
+  SetUtilization(1, 0.1);
+  EXPECT_TRUE(auto_tune_->ScaleBottleneck());
+  EXPECT_EQ(image_folder_->active_workers(), 1);
+  EXPECT_EQ(batch_->active_workers(), 2);
+
+  // now the leaf can not keep up, it has no input to wait for
+  SetUtilization(0, 0.0);
+  SetUtilization(1, 0.9);
+  EXPECT_TRUE(auto_tune_->ScaleBottleneck());
+  EXPECT_EQ(image_folder_->active_workers(), 2);
+  EXPECT_EQ(batch_->active_workers(), 2);
+
+  // no op starves its output
+  SetUtilization(0, 0.5);
+  SetUtilization(1, 0.5);
+  EXPECT_FALSE(auto_tune_->ScaleBottleneck());
+  EXPECT_EQ(image_folder_->active_workers(), 2);
+  EXPECT_EQ(batch_->active_workers(), 2);
+}
+
+TEST_F(MindDataTestAutoTune, TestEnlargeBurstyQueues) {
+  int32_t image_folder_capacity = image_folder_->ConnectorCapacity();
+  int32_t batch_capacity = batch_->ConnectorCapacity();
+  ASSERT_GT(image_folder_capacity, 0);
+  // the images swing between empty and full, the batches are steady
+  auto_tune_->ops_[0].empty_samples = kSamples / 2;
+  auto_tune_->ops_[0].full_samples = kSamples / 2;
+  auto_tune_->ops_[1].full_samples = kSamples;
+  EXPECT_TRUE(auto_tune_->EnlargeBurstyQueues().IsOk());
+  EXPECT_EQ(image_folder_->ConnectorCapacity(), image_folder_capacity * 2);
+  EXPECT_EQ(batch_->ConnectorCapacity(), batch_capacity);
+
+  // the queue stops growing at four times its initial size
+  for (int i = 0; i < 3; i++) {
+    EXPECT_TRUE(auto_tune_->EnlargeBurstyQueues().IsOk());
+  }
+  EXPECT_EQ(image_folder_->ConnectorCapacity(), image_folder_capacity * 4);
+}
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <string>
@@ -21,6 +22,8 @@
 #include "utils/ms_utils.h"
 #include "gtest/gtest.h"
 #include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/engine/batch_slots.h"
+#include "minddata/dataset/kernels/tensor_op.h"
 #include "utils/log_adapter.h"
 #include "securec.h"
 #include "minddata/dataset/util/status.h"
@@ -37,6 +40,16 @@ class MindDataTestBatchOp : public UT::DatasetOpTesting {
  protected:
 };
 
+// Writes every row into a new tensor, like most image ops do
+class CopyOp : public TensorOp {
+ public:
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override {
+    return Tensor::CreateFromTensor(input, output);
+  }
+
+  std::string Name() const override { return "CopyOp"; }
+};
+
 std::shared_ptr<de::BatchOp> Batch(int32_t batch_size = 1, bool drop = false, int rows_per_buf = 2) {
   Status rc;
   std::shared_ptr<de::BatchOp> op;
@@ -373,3 +386,73 @@ TEST_F(MindDataTestBatchOp, TestSimpleBatchPadding) {
     EXPECT_TRUE(rc.IsOk());
   }
 }
+
+TEST_F(MindDataTestBatchOp, TestBatchSlots) {
+  BatchSlots slots(4);
+  // nothing is reserved before the row sizes are known
+  EXPECT_TRUE(slots.ReserveRow(0, 0).IsOk());
+  EXPECT_TRUE(slots.TakeBatch(0, 0).empty());
+
+  slots.SetRowBytes({3 * sizeof(float), 0});
+  std::vector<std::shared_ptr<Tensor>> rows;
+  for (int64_t row = 0; row < 4; row++) {
+    EXPECT_TRUE(slots.ReserveRow(0, 4 + row).IsOk());
+    std::shared_ptr<Tensor> t;
+    EXPECT_TRUE(Tensor::CreateEmpty(TensorShape({3}), DataType(DataType::DE_FLOAT32), &t).IsOk());
+    // a second tensor of the same size does not get a slot
+    std::shared_ptr<Tensor> other;
+    EXPECT_TRUE(Tensor::CreateEmpty(TensorShape({3}), DataType(DataType::DE_FLOAT32), &other).IsOk());
+    Tensor::ClearReservedAllocations();
+    EXPECT_NE(t->GetBuffer(), other->GetBuffer());
+    rows.push_back(t);
+  }
+  auto slabs = slots.TakeBatch(0, 1);
+  ASSERT_EQ(slabs.size(), 2);
+  ASSERT_NE(slabs[0], nullptr);
+  EXPECT_EQ(slabs[1], nullptr);
+  for (int32_t row = 0; row < 4; row++) {
+    EXPECT_EQ(rows[row]->GetBuffer(), slabs[0]->Slot(row));
+  }
+  EXPECT_TRUE(slots.TakeBatch(0, 1).empty());
+
+  // slabs of batches never taken are released
+  EXPECT_TRUE(slots.ReserveRow(0, 8).IsOk());
+  Tensor::ClearReservedAllocations();
+  slots.DropEpochsBefore(1);
+  EXPECT_TRUE(slots.TakeBatch(0, 2).empty());
+}
+
+TEST_F(MindDataTestBatchOp, TestMapBatchZeroCopy) {
+  std::string schema_file = datasets_root_path_ + "/testBatchDataset/test.data";
+  std::shared_ptr<MapOp> map_op;
+  MapOp::Builder builder;
+  builder.SetInColNames({"col_sint64"}).SetTensorFuncs({std::make_shared<CopyOp>()}).SetNumWorkers(2);
+  EXPECT_TRUE(builder.Build(&map_op).IsOk());
+  auto batch_op = Batch(5);
+  auto tree = Build({TFReader(schema_file, 3), map_op, batch_op, Repeat(2)});
+  tree->Prepare();
+  Status rc = tree->Launch();
+  EXPECT_TRUE(rc.IsOk());
+  int64_t payload[] = {-9223372036854775807 - 1, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 9223372036854775807};
+  de::DatasetIterator di(tree);
+  TensorMap tensor_map;
+  // both repeats give batches of 5, 5 and 2 rows, whether the rows were mapped into the batch or copied
+  for (int repeat = 0; repeat < 2; repeat++) {
+    for (int64_t begin = 0; begin < 12; begin += 5) {
+      int64_t size = std::min<int64_t>(5, 12 - begin);
+      std::shared_ptr<de::Tensor> t;
+      rc = de::Tensor::CreateFromMemory(de::TensorShape({size, 1}), de::DataType(DataType::DE_INT64),
+                                        (unsigned char *)(payload + begin), &t);
+      EXPECT_TRUE(rc.IsOk());
+      rc = di.GetNextAsMap(&tensor_map);
+      EXPECT_TRUE(rc.IsOk());
+      EXPECT_EQ(*t == *(tensor_map["col_sint64"]), true);
+    }
+  }
+  rc = di.GetNextAsMap(&tensor_map);
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_TRUE(tensor_map.empty());
+  // the first batch teaches the row size, the map workers write some of the later rows straight into the batch
+  EXPECT_GT(batch_op->rows_in_slots(), 0);
+  EXPECT_LE(batch_op->rows_in_slots(), 24 - 5);
+}
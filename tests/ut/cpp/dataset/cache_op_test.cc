@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <random>
 #include <string>
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/engine/cache/cache_client.h"
@@ -27,6 +28,9 @@
 #include "minddata/dataset/util/storage_container.h"  // lint !e322
 #include "minddata/dataset/engine/datasetops/source/random_data_op.h"
 #include "minddata/dataset/engine/data_schema.h"
+#include "minddata/dataset/util/arena.h"
+#include "minddata/dataset/util/cache_pool.h"
+#include "minddata/dataset/util/system_pool.h"
 
 using namespace mindspore::dataset;
 using mindspore::LogStream;
@@ -125,6 +129,79 @@ TEST_F(MindDataTestCacheOp, DISABLED_TestCacheServer) {
   ASSERT_TRUE(rc.IsOk());
 }
 
+TEST_F(MindDataTestCacheOp, TestCachePoolEviction) {
+  // A 1MB arena holds only a few of the 256KB buffers. Nothing to spill, so the evicted buffers are dropped.
+  std::shared_ptr<Arena> arena;
+  Status rc = Arena::CreateArena(&arena, 1);
+  ASSERT_TRUE(rc.IsOk());
+  auto cp = std::make_shared<CachePool>(CachePool::value_allocator(arena), "", CachePool::EvictPolicy::kLru);
+  rc = cp->ServiceStart();
+  ASSERT_TRUE(rc.IsOk());
+  const int num_buffers = 8;
+  const size_t buffer_sz = 256 * 1024;
+  std::mt19937 gen(1);
+  std::vector<std::vector<uint8_t>> data(num_buffers, std::vector<uint8_t>(buffer_sz));
+  std::vector<CachePool::key_type> keys(num_buffers);
+  std::vector<uint8_t> out(buffer_sz);
+  WritableSlice dest(out.data(), out.size());
+  for (auto i = 0; i < num_buffers; ++i) {
+    for (auto &b : data[i]) {
+      b = static_cast<uint8_t>(gen());
+    }
+    rc = cp->Insert({ReadableSlice(data[i].data(), data[i].size())}, &keys[i]);
+    ASSERT_TRUE(rc.IsOk());
+    // Keep reading the 5th buffer so that it is always the most recently used one.
+    if (i >= 4) {
+      rc = cp->Read(keys[4], &dest);
+      ASSERT_TRUE(rc.IsOk());
+    }
+  }
+  auto stat = cp->GetStat();
+  MS_LOG(INFO) << "In memory: " << stat.num_mem_cached << ". Evicted: " << stat.num_evicted << ".";
+  EXPECT_GT(stat.num_evicted, 0);
+  EXPECT_EQ(stat.num_mem_cached + stat.num_evicted, num_buffers);
+  EXPECT_EQ(stat.num_mem_hit, 4);
+  // The oldest buffer is gone. The most recent ones are still there.
+  EXPECT_EQ(cp->GetSize(keys[0]), 0);
+  rc = cp->Read(keys[0], &dest);
+  EXPECT_EQ(rc.get_code(), StatusCode::kFileNotExist);
+  EXPECT_EQ(cp->GetSize(keys[4]), buffer_sz);
+  rc = cp->Read(keys[num_buffers - 1], &dest);
+  ASSERT_TRUE(rc.IsOk());
+  EXPECT_EQ(out, data[num_buffers - 1]);
+  rc = cp->ServiceStop();
+  ASSERT_TRUE(rc.IsOk());
+}
+
+TEST_F(MindDataTestCacheOp, TestCachePoolCompression) {
+  auto cp = std::make_shared<CachePool>(CachePool::value_allocator(std::make_shared<SystemPool>()), "",
+                                        CachePool::EvictPolicy::kNone, true);
+  Status rc = cp->ServiceStart();
+  ASSERT_TRUE(rc.IsOk());
+  std::vector<uint8_t> first(100000, 1);
+  std::vector<uint8_t> second(50000, 2);
+  CachePool::key_type key;
+  rc = cp->Insert({ReadableSlice(first.data(), first.size()), ReadableSlice(second.data(), second.size())}, &key);
+  ASSERT_TRUE(rc.IsOk());
+  // Size is reported before compression
+  EXPECT_EQ(cp->GetSize(key), first.size() + second.size());
+  std::vector<uint8_t> out(first.size() + second.size());
+  WritableSlice dest(out.data(), out.size());
+  size_t bytes_read = 0;
+  rc = cp->Read(key, &dest, &bytes_read);
+  ASSERT_TRUE(rc.IsOk());
+  EXPECT_EQ(bytes_read, out.size());
+  EXPECT_TRUE(std::equal(first.begin(), first.end(), out.begin()));
+  EXPECT_TRUE(std::equal(second.begin(), second.end(), out.begin() + first.size()));
+  auto stat = cp->GetStat();
+#ifdef ENABLE_CACHE
+  EXPECT_EQ(stat.num_compressed, 1);
+#endif
+  EXPECT_EQ(stat.num_mem_cached, 1);
+  rc = cp->ServiceStop();
+  ASSERT_TRUE(rc.IsOk());
+}
+
 TEST_F(MindDataTestCacheOp, DISABLED_TestConcurrencyRequest) {
   // Clear the rc of the master thread if any
   (void)TaskManager::GetMasterThreadRc();
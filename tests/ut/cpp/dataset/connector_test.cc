@@ -24,6 +24,7 @@
 
 #include "common/common.h"
 #include "minddata/dataset/engine/connector.h"
+#include "minddata/dataset/engine/db_connector.h"
 #include "minddata/dataset/util/task_manager.h"
 #include "utils/log_adapter.h"
 
@@ -347,3 +348,44 @@ void MindDataTestConnector::GoToSleep(int max_dur) {
   uint32_t duration = GenRand(max_dur);
   std::this_thread::sleep_for(std::chrono::milliseconds(duration));
 }
+
+// Test scenario: out of order DbConnector with 2 producers and a reorder window of 4.
+// The buffers of producer 1 overtake the slow buffer of producer 0 within the window, and the EOE of
+// the producers are merged into a single EOE once both reached the end of the epoch.
+TEST_F(MindDataTestConnector, TestOutOfOrder) {
+  MS_LOG(INFO) << "Doing MindDataTestConnector.TestOutOfOrder.";
+  DbConnector connector(2, 1, 4);
+  connector.SetOutOfOrder(4);
+  ASSERT_TRUE(connector.out_of_order());
+
+  // Round robin positions: producer 0 has 0, 2, 4, producer 1 has 1, 3, 5
+  ASSERT_TRUE(connector.Add(1, std::make_unique<DataBuffer>(1, DataBuffer::kDeBFlagNone)).IsOk());
+  ASSERT_TRUE(connector.Add(1, std::make_unique<DataBuffer>(3, DataBuffer::kDeBFlagNone)).IsOk());
+  ASSERT_TRUE(connector.Add(1, std::make_unique<DataBuffer>(5, DataBuffer::kDeBFlagNone)).IsOk());
+  std::unique_ptr<DataBuffer> buffer;
+  ASSERT_TRUE(connector.PopWithRetry(0, &buffer).IsOk());
+  EXPECT_EQ(buffer->id(), 1);
+  ASSERT_TRUE(connector.PopWithRetry(0, &buffer).IsOk());
+  EXPECT_EQ(buffer->id(), 3);
+  // Buffer 5 is outside of the window while buffer 0 is missing
+  ASSERT_TRUE(connector.Add(0, std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagNone)).IsOk());
+  ASSERT_TRUE(connector.Add(0, std::make_unique<DataBuffer>(2, DataBuffer::kDeBFlagNone)).IsOk());
+  std::vector<int32_t> expected = {0, 2, 5};
+  for (auto id : expected) {
+    ASSERT_TRUE(connector.PopWithRetry(0, &buffer).IsOk());
+    EXPECT_EQ(buffer->id(), id);
+  }
+
+  ASSERT_TRUE(connector.Add(1, std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOE)).IsOk());
+  ASSERT_TRUE(connector.Add(0, std::make_unique<DataBuffer>(4, DataBuffer::kDeBFlagNone)).IsOk());
+  ASSERT_TRUE(connector.Add(0, std::make_unique<DataBuffer>(0, DataBuffer::kDeBFlagEOE)).IsOk());
+  ASSERT_TRUE(connector.Add(0, std::make_unique<DataBuffer>(6, DataBuffer::kDeBFlagNone)).IsOk());
+  ASSERT_TRUE(connector.PopWithRetry(0, &buffer).IsOk());
+  EXPECT_EQ(buffer->id(), 4);
+  ASSERT_TRUE(connector.PopWithRetry(0, &buffer).IsOk());
+  EXPECT_TRUE(buffer->eoe());
+  // The next epoch starts after the single EOE
+  ASSERT_TRUE(connector.PopWithRetry(0, &buffer).IsOk());
+  EXPECT_EQ(buffer->id(), 6);
+  EXPECT_EQ(connector.size(), 0);
+}
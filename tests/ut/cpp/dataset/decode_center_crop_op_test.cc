@@ -0,0 +1,62 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <utility>
+#include <vector>
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "minddata/dataset/kernels/image/center_crop_op.h"
+#include "minddata/dataset/kernels/image/decode_center_crop_op.h"
+#include "minddata/dataset/kernels/image/decode_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::MsLogLevel::INFO;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::LogStream;
+
+class MindDataTestDecodeCenterCropOp : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestDecodeCenterCropOp() : CVOpCommon() {}
+};
+
+// Decoding only the center window of a JPEG gives the same pixels as decoding it all and cropping the center.
+// A window larger than the image is padded, as CenterCropOp does.
+TEST_F(MindDataTestDecodeCenterCropOp, TestOp) {
+  MS_LOG(INFO) << "Doing MindDataTestDecodeCenterCropOp-TestOp.";
+  std::shared_ptr<Tensor> decoded;
+  DecodeOp decode_op(true);
+  ASSERT_TRUE(decode_op.Compute(raw_input_tensor_, &decoded).IsOk());
+  int32_t height = decoded->shape()[0];
+  int32_t width = decoded->shape()[1];
+
+  std::vector<std::pair<int32_t, int32_t>> sizes = {{100, 80}, {height, width}, {height + 10, 32}};
+  for (auto &size : sizes) {
+    CenterCropOp center_crop_op(size.first, size.second);
+    std::shared_ptr<Tensor> expected;
+    ASSERT_TRUE(center_crop_op.Compute(decoded, &expected).IsOk());
+
+    DecodeCenterCropOp op(center_crop_op);
+    EXPECT_EQ(op.Name(), kDecodeCenterCropOp);
+    std::shared_ptr<Tensor> output;
+    ASSERT_TRUE(op.Compute(raw_input_tensor_, &output).IsOk());
+    ASSERT_EQ(output->shape(), TensorShape({size.first, size.second, 3}));
+    ASSERT_EQ(output->shape(), expected->shape());
+    auto expected_it = expected->begin<uint8_t>();
+    for (auto it = output->begin<uint8_t>(); it != output->end<uint8_t>(); ++it, ++expected_it) {
+      ASSERT_EQ(*it, *expected_it);
+    }
+  }
+}
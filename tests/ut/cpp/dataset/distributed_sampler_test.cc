@@ -21,6 +21,7 @@
 #include "minddata/dataset/engine/data_buffer.h"
 #include "minddata/dataset/engine/datasetops/source/sampler/sampler.h"
 #include "minddata/dataset/engine/datasetops/source/sampler/distributed_sampler.h"
+#include "minddata/mindrecord/include/common/shard_utils.h"
 #include "utils/log_adapter.h"
 
 #include <vector>
@@ -121,3 +122,41 @@ TEST_F(MindDataTestDistributedSampler, TestThreeShards) {
   ASSERT_EQ(db->eoe(), true);
 }
 
+TEST_F(MindDataTestDistributedSampler, TestBlockShuffle) {
+  int64_t num_rows = 1000;
+  int64_t block_size = 10;
+  int64_t num_shards = 3;
+  auto sample_ids = [&](int64_t shard_id, uint32_t seed) {
+    DistributedSampler m_sampler(0, num_shards, shard_id, true, seed, -1, true, block_size);
+    DummyRandomAccessOp dummyRandomAccessOp(num_rows);
+    m_sampler.HandshakeRandomAccessOp(&dummyRandomAccessOp);
+    std::unique_ptr<DataBuffer> db;
+    TensorRow row;
+    std::vector<int64_t> out;
+    EXPECT_EQ(m_sampler.GetNextSample(&db), Status::OK());
+    db->PopRow(&row);
+    for (auto it = row[0]->begin<int64_t>(); it != row[0]->end<int64_t>(); it++) {
+      out.push_back(*it);
+    }
+    EXPECT_EQ(m_sampler.GetNextSample(&db), Status::OK());
+    EXPECT_EQ(db->eoe(), true);
+    return out;
+  };
+
+  // Shards are disjoint and cover all the rows, each one reads its own blocks and those of the windows at its ends
+  std::unordered_set<int64_t> rows;
+  for (int64_t shard_id = 0; shard_id < num_shards; shard_id++) {
+    std::vector<int64_t> out = sample_ids(shard_id, 5);
+    ASSERT_EQ(static_cast<int64_t>(out.size()), (num_rows + num_shards - 1) / num_shards);
+    EXPECT_EQ(out, sample_ids(shard_id, 5));
+    EXPECT_NE(out, sample_ids(shard_id, 6));
+    std::unordered_set<int64_t> blocks;
+    for (auto id : out) {
+      rows.insert(id);
+      blocks.insert(id / block_size);
+    }
+    EXPECT_LE(static_cast<int64_t>(blocks.size()),
+              static_cast<int64_t>(out.size()) / block_size + 2 * mindspore::mindrecord::kShuffleWindowBlocks);
+  }
+  EXPECT_EQ(static_cast<int64_t>(rows.size()), num_rows);
+}
@@ -0,0 +1,88 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "minddata/dataset/kernels/data/type_cast_op.h"
+#include "minddata/dataset/kernels/image/fused_normalize_op.h"
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/rescale_op.h"
+#include "minddata/dataset/kernels/image/resize_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::MsLogLevel::INFO;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::LogStream;
+
+class MindDataTestFusedNormalizeOp : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestFusedNormalizeOp() : CVOpCommon() {}
+};
+
+// The fused op gives the same image as Resize, Rescale, Normalize, HwcToChw and TypeCast one after the other
+TEST_F(MindDataTestFusedNormalizeOp, TestOp) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedNormalizeOp-TestOp.";
+  float rescale = 1.0 / 255;
+  float shift = 0.0;
+  std::vector<float> mean = {0.485, 0.456, 0.406};
+  std::vector<float> stddev = {0.229, 0.224, 0.225};
+  std::vector<std::shared_ptr<TensorOp>> ops = {
+    std::make_shared<ResizeOp>(64, 48), std::make_shared<RescaleOp>(rescale, shift),
+    std::make_shared<NormalizeOp>(mean[0], mean[1], mean[2], stddev[0], stddev[1], stddev[2]),
+    std::make_shared<HwcToChwOp>(), std::make_shared<TypeCastOp>(DataType(DataType::DE_FLOAT64))};
+  std::shared_ptr<Tensor> expected = input_tensor_;
+  for (auto &op : ops) {
+    Status s = op->Compute(expected, &expected);
+    ASSERT_TRUE(s.IsOk());
+  }
+
+  FusedNormalizeOp fused_op(rescale, shift, mean, stddev);
+  fused_op.set_resize_op(ops[0]);
+  fused_op.set_to_chw(true);
+  fused_op.set_output_type(DataType(DataType::DE_FLOAT64));
+  EXPECT_TRUE(fused_op.OneToOne());
+  std::shared_ptr<Tensor> output;
+  Status s = fused_op.Compute(input_tensor_, &output);
+  ASSERT_TRUE(s.IsOk());
+
+  ASSERT_EQ(output->shape(), TensorShape({3, 64, 48}));
+  ASSERT_EQ(output->type(), DataType(DataType::DE_FLOAT64));
+  ASSERT_EQ(output->shape(), expected->shape());
+  auto expected_it = expected->begin<double>();
+  for (auto it = output->begin<double>(); it != output->end<double>(); ++it, ++expected_it) {
+    EXPECT_NEAR(*it, *expected_it, 1e-4);
+  }
+}
+
+TEST_F(MindDataTestFusedNormalizeOp, TestOutputShape) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedNormalizeOp-TestOutputShape.";
+  FusedNormalizeOp fused_op(1.0, 0.0, {121.0, 115.0, 100.0}, {70.0, 68.0, 71.0});
+  std::vector<TensorShape> outputs;
+  Status s = fused_op.OutputShape({TensorShape({32, 24, 3})}, outputs);
+  ASSERT_TRUE(s.IsOk());
+  EXPECT_EQ(outputs[0], TensorShape({32, 24, 3}));
+  fused_op.set_to_chw(true);
+  s = fused_op.OutputShape({TensorShape({32, 24, 3})}, outputs);
+  ASSERT_TRUE(s.IsOk());
+  EXPECT_EQ(outputs[0], TensorShape({3, 32, 24}));
+
+  // Only 3 channel images can be normalized
+  std::shared_ptr<Tensor> gray;
+  ASSERT_TRUE(Tensor::CreateEmpty(TensorShape({4, 4}), DataType(DataType::DE_UINT8), &gray).IsOk());
+  std::shared_ptr<Tensor> output;
+  EXPECT_TRUE(fused_op.Compute(gray, &output).IsError());
+}
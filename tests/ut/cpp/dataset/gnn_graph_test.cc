@@ -20,6 +20,8 @@
 
 #include "common/common.h"
 #include "gtest/gtest.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/util/status.h"
 #include "minddata/dataset/engine/gnn/node.h"
 #include "minddata/dataset/engine/gnn/graph_data_impl.h"
@@ -266,3 +268,152 @@ TEST_F(MindDataTestGNNGraph, TestRandomWalkDefaults) {
   EXPECT_TRUE(s.IsOk());
   EXPECT_TRUE(walk_path->shape().ToString() == "<33,60>");
 }
+
+TEST_F(MindDataTestGNNGraph, TestCsrStorage) {
+  std::string path = "data/mindrecord/testGraphData/testdata";
+  GraphDataImpl graph(path, 1);
+  Status s = graph.Init();
+  EXPECT_TRUE(s.IsOk());
+  GraphDataImpl csr_graph(path, 1, false, true);
+  s = csr_graph.Init();
+  EXPECT_TRUE(s.IsOk());
+
+  MetaInfo meta_info;
+  s = csr_graph.GetMetaInfo(&meta_info);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_TRUE(meta_info.node_type.size() == 2);
+
+  std::shared_ptr<Tensor> nodes;
+  s = csr_graph.GetAllNodes(meta_info.node_type[0], &nodes);
+  EXPECT_TRUE(s.IsOk());
+  std::vector<NodeIdType> node_list;
+  for (auto itr = nodes->begin<NodeIdType>(); itr != nodes->end<NodeIdType>(); ++itr) {
+    node_list.push_back(*itr);
+  }
+
+  // The neighbors and the features are the same as with one object per node and edge
+  std::shared_ptr<Tensor> neighbors;
+  std::shared_ptr<Tensor> expected_neighbors;
+  s = csr_graph.GetAllNeighbors(node_list, meta_info.node_type[1], &neighbors);
+  EXPECT_TRUE(s.IsOk());
+  s = graph.GetAllNeighbors(node_list, meta_info.node_type[1], &expected_neighbors);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_TRUE(neighbors->ToString() == expected_neighbors->ToString());
+
+  TensorRow features;
+  TensorRow expected_features;
+  s = csr_graph.GetNodeFeature(nodes, meta_info.node_feature_type, &features);
+  EXPECT_TRUE(s.IsOk());
+  s = graph.GetNodeFeature(nodes, meta_info.node_feature_type, &expected_features);
+  EXPECT_TRUE(s.IsOk());
+  ASSERT_EQ(features.size(), expected_features.size());
+  for (size_t i = 0; i < features.size(); ++i) {
+    EXPECT_TRUE(features[i]->ToString() == expected_features[i]->ToString());
+  }
+
+  std::shared_ptr<Tensor> edges;
+  s = csr_graph.GetAllEdges(meta_info.edge_type[0], &edges);
+  EXPECT_TRUE(s.IsOk());
+  std::vector<EdgeIdType> edge_list;
+  for (auto itr = edges->begin<EdgeIdType>(); itr != edges->end<EdgeIdType>(); ++itr) {
+    edge_list.push_back(*itr);
+  }
+  s = csr_graph.GetEdgeFeature(edges, meta_info.edge_feature_type, &features);
+  EXPECT_TRUE(s.IsOk());
+  s = graph.GetEdgeFeature(edges, meta_info.edge_feature_type, &expected_features);
+  EXPECT_TRUE(s.IsOk());
+  ASSERT_EQ(features.size(), expected_features.size());
+  for (size_t i = 0; i < features.size(); ++i) {
+    EXPECT_TRUE(features[i]->ToString() == expected_features[i]->ToString());
+  }
+
+  std::shared_ptr<Tensor> edge_nodes;
+  std::shared_ptr<Tensor> expected_edge_nodes;
+  s = csr_graph.GetNodesFromEdges(edge_list, &edge_nodes);
+  EXPECT_TRUE(s.IsOk());
+  s = graph.GetNodesFromEdges(edge_list, &expected_edge_nodes);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_TRUE(edge_nodes->ToString() == expected_edge_nodes->ToString());
+
+  // Every sampled neighbor is a neighbor of its node
+  s = csr_graph.GetSampledNeighbors(node_list, {10}, {meta_info.node_type[1]}, &neighbors);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_TRUE(neighbors->shape().ToString() == "<10,11>");
+  for (size_t i = 0; i < node_list.size(); ++i) {
+    std::shared_ptr<Tensor> all_neighbors;
+    s = csr_graph.GetAllNeighbors({node_list[i]}, meta_info.node_type[1], &all_neighbors);
+    EXPECT_TRUE(s.IsOk());
+    std::unordered_set<NodeIdType> neighbor_set = {kDefaultNodeId};
+    for (auto itr = all_neighbors->begin<NodeIdType>(); itr != all_neighbors->end<NodeIdType>(); ++itr) {
+      neighbor_set.insert(*itr);
+    }
+    for (dsize_t j = 1; j < 11; ++j) {
+      NodeIdType neighbor;
+      s = neighbors->GetItemAt(&neighbor, {static_cast<dsize_t>(i), j});
+      EXPECT_TRUE(s.IsOk());
+      EXPECT_TRUE(neighbor_set.find(neighbor) != neighbor_set.end());
+    }
+  }
+
+  s = csr_graph.GetSampledNeighbors({301}, {10}, {meta_info.node_type[1]}, &neighbors);
+  EXPECT_TRUE(s.ToString().find("Invalid node id:301") != std::string::npos);
+
+  std::string sns_path = "data/mindrecord/testGraphData/sns";
+  GraphDataImpl sns_graph(sns_path, 1, false, true);
+  s = sns_graph.Init();
+  EXPECT_TRUE(s.IsOk());
+  s = sns_graph.GetMetaInfo(&meta_info);
+  EXPECT_TRUE(s.IsOk());
+  s = sns_graph.GetAllNodes(meta_info.node_type[0], &nodes);
+  EXPECT_TRUE(s.IsOk());
+  node_list.clear();
+  for (auto itr = nodes->begin<NodeIdType>(); itr != nodes->end<NodeIdType>(); ++itr) {
+    node_list.push_back(*itr);
+  }
+  std::vector<NodeType> meta_path(59, 1);
+  std::shared_ptr<Tensor> walk_path;
+  s = sns_graph.RandomWalk(node_list, meta_path, 2.0, 0.5, -1, &walk_path);
+  EXPECT_TRUE(s.IsOk());
+  EXPECT_TRUE(walk_path->shape().ToString() == "<33,60>");
+}
+
+// The samples only depend on the seed, the large batches are split across the workers
+TEST_F(MindDataTestGNNGraph, TestSamplingReproducible) {
+  uint32_t original_seed = GlobalContext::config_manager()->seed();
+  std::string path = "data/mindrecord/testGraphData/testdata";
+  std::vector<std::string> results[2];
+  int32_t num_workers[2] = {1, 4};
+  for (int k = 0; k < 2; ++k) {
+    GlobalContext::config_manager()->set_seed(135);
+    GraphDataImpl graph(path, num_workers[k]);
+    Status s = graph.Init();
+    EXPECT_TRUE(s.IsOk());
+
+    MetaInfo meta_info;
+    s = graph.GetMetaInfo(&meta_info);
+    EXPECT_TRUE(s.IsOk());
+    std::shared_ptr<Tensor> nodes;
+    s = graph.GetAllNodes(meta_info.node_type[0], &nodes);
+    EXPECT_TRUE(s.IsOk());
+    std::vector<NodeIdType> node_list;
+    while (node_list.size() < 1000) {
+      for (auto itr = nodes->begin<NodeIdType>(); itr != nodes->end<NodeIdType>(); ++itr) {
+        node_list.push_back(*itr);
+      }
+    }
+
+    std::shared_ptr<Tensor> out;
+    s = graph.GetSampledNeighbors(node_list, {2, 3}, {meta_info.node_type[1], meta_info.node_type[0]}, &out);
+    EXPECT_TRUE(s.IsOk());
+    results[k].push_back(out->ToString());
+    s = graph.GetNegSampledNeighbors(node_list, 3, meta_info.node_type[1], &out);
+    EXPECT_TRUE(s.IsOk());
+    results[k].push_back(out->ToString());
+    std::vector<NodeType> meta_path = {meta_info.node_type[1], meta_info.node_type[0], meta_info.node_type[1]};
+    s = graph.RandomWalk(node_list, meta_path, 2.0, 0.5, -1, &out);
+    EXPECT_TRUE(s.IsOk());
+    results[k].push_back(out->ToString());
+  }
+  EXPECT_TRUE(results[0] == results[1]);
+  GlobalContext::config_manager()->set_seed(original_seed);
+}
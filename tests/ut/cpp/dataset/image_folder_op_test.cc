@@ -20,6 +20,7 @@
 #include "common/common.h"
 #include "utils/ms_utils.h"
 #include "minddata/dataset/core/client.h"
+#include "minddata/dataset/core/config_manager.h"
 #include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/datasetops/source/image_folder_op.h"
 #include "minddata/dataset/engine/datasetops/source/sampler/distributed_sampler.h"
@@ -442,3 +443,45 @@ TEST_F(MindDataTestImageFolderSampler, TestImageFolderSharding2) {
     EXPECT_TRUE(i == 11);
   }
 }
+
+TEST_F(MindDataTestImageFolderSampler, TestImageFolderAutoTune) {
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  bool enable_autotune = cfg->enable_autotune();
+  int64_t autotune_steps = cfg->autotune_steps();
+  cfg->set_enable_autotune(true);
+  cfg->set_autotune_steps(20);
+  std::string folder_path = datasets_root_path_ + "/testPK/data";
+  auto image_folder = ImageFolder(2, 2, 4, folder_path, false);
+  auto tree = Build({image_folder, Repeat(2)});
+  tree->Prepare();
+  // The op launches extra workers for the autotuner but only runs the requested ones
+  EXPECT_TRUE(image_folder->gated());
+  EXPECT_GE(image_folder->num_workers(), 2);
+  EXPECT_EQ(image_folder->active_workers(), 2);
+  int32_t res[] = {0, 1, 2, 3};
+  Status rc = tree->Launch();
+  if (rc.IsError()) {
+    MS_LOG(ERROR) << "Return code error detected during tree launch: " << common::SafeCStr(rc.ToString()) << ".";
+    EXPECT_TRUE(false);
+  } else {
+    DatasetIterator di(tree);
+    TensorMap tensor_map;
+    di.GetNextAsMap(&tensor_map);
+    uint64_t i = 0;
+    int32_t label = 0;
+    while (tensor_map.size() != 0) {
+      // Scaling the op while it runs keeps the order of the rows
+      tensor_map["label"]->GetItemAt<int32_t>(&label, {});
+      EXPECT_TRUE(res[(i % 44) / 11] == label);
+      if (i == 30) {
+        image_folder->SetActiveWorkers(image_folder->num_workers());
+        EXPECT_TRUE(image_folder->ResizeConnector(8).IsOk());
+      }
+      i++;
+      di.GetNextAsMap(&tensor_map);
+    }
+    EXPECT_TRUE(i == 88);
+  }
+  cfg->set_enable_autotune(enable_autotune);
+  cfg->set_autotune_steps(autotune_steps);
+}
@@ -443,6 +443,71 @@ TEST_F(MindDataTestMapOp, TestTFReaderRepeatMap) {
   ASSERT_EQ(row_count, 10 * num_repeats);
 }
 
+// TestOutOfOrder scenario:
+//    TFReaderOp -> MapOp with 5 workers -> RepeatOp of 3, with the tree in out of order mode.
+//    The buffers of the MapOp may come out of the round robin order, but every epoch still has all 10 rows.
+TEST_F(MindDataTestMapOp, TestOutOfOrder) {
+  Status rc;
+  MS_LOG(INFO) << "Doing TestOutOfOrder.";
+  uint32_t num_repeats = 3;
+
+  auto my_tfreader_op = this->CreateTFReaderOp();
+  rc = my_tree_->AssociateNode(my_tfreader_op);
+  EXPECT_TRUE(rc.IsOk());
+  auto my_no_op = std::make_shared<mindspore::dataset::test::NoOp>();
+  std::vector<std::shared_ptr<TensorOp>> my_func_list;
+  my_func_list.push_back(my_no_op);
+
+  std::shared_ptr<MapOp> my_map_op;
+  MapOp::Builder builder;
+  builder.SetInColNames({"label"}).SetOutColNames({}).SetTensorFuncs(std::move(my_func_list)).SetNumWorkers(5);
+  rc = builder.Build(&my_map_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree_->AssociateNode(my_map_op);
+  EXPECT_TRUE(rc.IsOk());
+
+  std::shared_ptr<RepeatOp> my_repeat_op;
+  rc = RepeatOp::Builder(num_repeats).Build(&my_repeat_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree_->AssociateNode(my_repeat_op);
+  EXPECT_TRUE(rc.IsOk());
+
+  rc = my_repeat_op->AddChild(my_map_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_map_op->AddChild(my_tfreader_op);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree_->AssignRoot(my_repeat_op);
+  EXPECT_TRUE(rc.IsOk());
+
+  // The window must be positive
+  EXPECT_FALSE(my_tree_->SetOutOfOrder(true, 0).IsOk());
+  rc = my_tree_->SetOutOfOrder(true, 3);
+  EXPECT_TRUE(rc.IsOk());
+  rc = my_tree_->Prepare();
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_TRUE(my_map_op->out_of_order());
+  // Too late once the tree is prepared
+  EXPECT_FALSE(my_tree_->SetOutOfOrder(false, 3).IsOk());
+  rc = my_tree_->Launch();
+  EXPECT_TRUE(rc.IsOk());
+
+  DatasetIterator di(my_tree_);
+  TensorRow tensor_list;
+  for (uint32_t epoch = 0; epoch < num_repeats; epoch++) {
+    uint32_t row_count = 0;
+    rc = di.FetchNextTensorRow(&tensor_list);
+    EXPECT_TRUE(rc.IsOk());
+    while (!tensor_list.empty()) {
+      EXPECT_EQ(tensor_list.size(), 4);
+      row_count++;
+      rc = di.FetchNextTensorRow(&tensor_list);
+      EXPECT_TRUE(rc.IsOk());
+    }
+    // Each epoch ends with one EOE, no buffer of the next epoch is mixed in
+    ASSERT_EQ(row_count, 10);
+  }
+}
+
 TEST_F(MindDataTestMapOp, TestTFReaderMapRepeat) {
   Status rc;
   MS_LOG(INFO) << "Doing TestTFReaderMapRepeat.";
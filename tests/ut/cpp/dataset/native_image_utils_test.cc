@@ -0,0 +1,112 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <opencv2/imgproc/imgproc.hpp>
+#include <random>
+#include <vector>
+#include "common/common.h"
+#include "minddata/dataset/kernels/image/native_image_utils.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::MsLogLevel::INFO;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::LogStream;
+
+class MindDataTestNativeImageUtils : public UT::Common {
+ public:
+  MindDataTestNativeImageUtils() {}
+
+  cv::Mat RandomImage(int height, int width, int channels) {
+    cv::Mat image(height, width, CV_8UC(channels));
+    std::uniform_int_distribution<int> dist(0, 255);
+    for (size_t i = 0; i < image.total() * channels; i++) {
+      image.data[i] = static_cast<uint8_t>(dist(gen_));
+    }
+    return image;
+  }
+
+  std::mt19937 gen_{0};
+};
+
+// Same pixels as cv::resize with INTER_LINEAR, also for a crop which is not dense
+TEST_F(MindDataTestNativeImageUtils, TestResizeBilinear) {
+  MS_LOG(INFO) << "Doing MindDataTestNativeImageUtils-TestResizeBilinear.";
+  std::vector<std::vector<int>> sizes = {{500, 375, 224, 224}, {32, 24, 64, 48}, {100, 100, 33, 250},
+                                         {7, 301, 19, 3},      {1, 1, 5, 5},     {64, 64, 31, 31}};
+  for (int channels : {1, 3, 4}) {
+    for (const auto &size : sizes) {
+      cv::Mat image = RandomImage(size[0] + 3, size[1] + 5, channels);
+      cv::Mat roi = image(cv::Rect(5, 3, size[1], size[0]));
+      ASSERT_TRUE(native::ResizeBilinearMatchesCv(size[0], size[1], size[2], size[3]));
+      cv::Mat expected;
+      cv::resize(roi, expected, cv::Size(size[3], size[2]), 0, 0, cv::INTER_LINEAR);
+      cv::Mat output(size[2], size[3], CV_8UC(channels));
+      native::ResizeBilinear(roi.data, size[0], size[1], roi.step[0], channels, output.data, size[2], size[3]);
+      EXPECT_EQ(cv::norm(output, expected, cv::NORM_INF), 0);
+    }
+  }
+  // OpenCV resizes by area for an exact 2x down-scaling
+  EXPECT_FALSE(native::ResizeBilinearMatchesCv(64, 48, 32, 24));
+}
+
+TEST_F(MindDataTestNativeImageUtils, TestNormalize) {
+  MS_LOG(INFO) << "Doing MindDataTestNativeImageUtils-TestNormalize.";
+  cv::Mat image = RandomImage(37, 51, 3);
+  float scale[3] = {1.0f / 70, 1.0f / 68, 1.0f / 71};
+  float offset[3] = {-121.0f / 70, -115.0f / 68, -100.0f / 71};
+  int64_t num_pixels = image.total();
+  std::vector<float> hwc(num_pixels * 3);
+  std::vector<float> chw(num_pixels * 3);
+  native::NormalizeToFloat(image.data, hwc.data(), num_pixels, scale, offset, false);
+  native::NormalizeToFloat(image.data, chw.data(), num_pixels, scale, offset, true);
+  cv::Mat channels[3];
+  cv::split(image, channels);
+  for (int c = 0; c < 3; c++) {
+    cv::Mat expected;
+    channels[c].convertTo(expected, CV_32F, scale[c], offset[c]);
+    for (int64_t i = 0; i < num_pixels; i++) {
+      EXPECT_EQ(hwc[i * 3 + c], expected.at<float>(i));
+      EXPECT_EQ(chw[c * num_pixels + i], expected.at<float>(i));
+    }
+  }
+}
+
+TEST_F(MindDataTestNativeImageUtils, TestHwcToChw) {
+  MS_LOG(INFO) << "Doing MindDataTestNativeImageUtils-TestHwcToChw.";
+  cv::Mat image = RandomImage(29, 67, 3);
+  int64_t num_pixels = image.total();
+  std::vector<uint8_t> output(num_pixels * 3);
+  native::HwcToChw(image.data, output.data(), num_pixels, 3, 1);
+  for (int c = 0; c < 3; c++) {
+    cv::Mat channel;
+    cv::extractChannel(image, channel, c);
+    EXPECT_EQ(memcmp(output.data() + c * num_pixels, channel.data, num_pixels), 0);
+  }
+}
+
+TEST_F(MindDataTestNativeImageUtils, TestFlip) {
+  MS_LOG(INFO) << "Doing MindDataTestNativeImageUtils-TestFlip.";
+  for (int channels : {1, 3, 4}) {
+    cv::Mat image = RandomImage(13, 77, channels);
+    for (bool horizontal : {true, false}) {
+      cv::Mat expected;
+      cv::flip(image, expected, horizontal ? 1 : 0);
+      cv::Mat output(image.rows, image.cols, image.type());
+      native::Flip(image.data, output.data, image.rows, image.cols, channels, horizontal);
+      EXPECT_EQ(cv::norm(output, expected, cv::NORM_INF), 0);
+    }
+  }
+}
@@ -152,6 +152,31 @@ TEST_F(MindDataTestQueue, Test5) {
   ASSERT_EQ(gRefCountDestructorCalled, 4);
 }
 
+TEST_F(MindDataTestQueue, TestResize) {
+  Queue<std::unique_ptr<int>> que(3);
+  // Wrap around the end of the array before resizing
+  std::unique_ptr<int> a;
+  ASSERT_TRUE(que.Add(std::make_unique<int>(0)).IsOk());
+  ASSERT_TRUE(que.PopFront(&a).IsOk());
+  for (int i = 1; i <= 3; i++) {
+    ASSERT_TRUE(que.Add(std::make_unique<int>(i)).IsOk());
+  }
+  // Can not drop queued elements
+  ASSERT_TRUE(que.Resize(2).IsError());
+  ASSERT_TRUE(que.Resize(6).IsOk());
+  ASSERT_EQ(que.capacity(), 6);
+  ASSERT_EQ(que.size(), 3);
+  for (int i = 4; i <= 6; i++) {
+    ASSERT_TRUE(que.Add(std::make_unique<int>(i)).IsOk());
+  }
+  // The elements keep their order
+  for (int i = 1; i <= 6; i++) {
+    ASSERT_TRUE(que.PopFront(&a).IsOk());
+    ASSERT_EQ(*a, i);
+  }
+  ASSERT_TRUE(que.empty());
+}
+
 TEST_F(MindDataTestQueue, Test6) {
   // Create a list of queues
   QueueList<std::unique_ptr<int>> my_list_of_queues;
@@ -23,6 +23,14 @@
 #include "minddata/dataset/kernels/image/decode_op.h"
 #include "minddata/dataset/engine/datasetops/source/image_folder_op.h"
 #include "minddata/dataset/engine/execution_tree.h"
+#include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
+#include "minddata/dataset/kernels/data/type_cast_op.h"
+#include "minddata/dataset/kernels/image/center_crop_op.h"
+#include "minddata/dataset/kernels/image/fused_normalize_op.h"
+#include "minddata/dataset/kernels/image/hwc_to_chw_op.h"
+#include "minddata/dataset/kernels/image/normalize_op.h"
+#include "minddata/dataset/kernels/image/rescale_op.h"
+#include "minddata/dataset/kernels/image/resize_op.h"
 
 
 using namespace mindspore::dataset;
@@ -102,4 +110,72 @@ TEST_F(MindDataTestTensorOpFusionPass, RandomCropDecodeResize_fusion_enabled) {
   auto func_it = tfuncs.begin();
   EXPECT_EQ((*func_it)->Name(), kRandomCropDecodeResizeOp);
   EXPECT_EQ(++func_it, tfuncs.end());
-}
\ No newline at end of file
+}
+// A chain of Resize, Rescale, Normalize, HwcToChw and TypeCast to float is fused into one FusedNormalizeOp by
+// applying the rules one after the other, and the ops which do not match any rule are kept.
+TEST_F(MindDataTestTensorOpFusionPass, FusedNormalize_rules) {
+  MS_LOG(INFO) << "Doing FusedNormalize_rules";
+  std::vector<std::shared_ptr<TensorOp>> func_list = {
+    std::make_shared<DecodeOp>(),
+    std::make_shared<ResizeOp>(224, 224),
+    std::make_shared<RescaleOp>(1.0 / 255, 0.0),
+    std::make_shared<NormalizeOp>(0.485, 0.456, 0.406, 0.229, 0.224, 0.225),
+    std::make_shared<HwcToChwOp>(),
+    std::make_shared<TypeCastOp>(DataType(DataType::DE_FLOAT16)),
+    std::make_shared<TypeCastOp>(DataType(DataType::DE_INT32))};
+  std::shared_ptr<MapOp> map_op;
+  MapOp::Builder builder;
+  builder.SetInColNames({}).SetOutColNames({}).SetTensorFuncs(func_list).SetNumWorkers(4);
+  Status rc = builder.Build(&map_op);
+  EXPECT_TRUE(rc.IsOk());
+
+  TensorOpFusionPass pass;
+  bool modified = false;
+  rc = pass.RunOnNode(map_op, &modified);
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_TRUE(modified);
+  auto &tfuncs = map_op->TFuncs();
+  ASSERT_EQ(tfuncs.size(), 3);
+  EXPECT_EQ(tfuncs[0]->Name(), kDecodeOp);
+  EXPECT_EQ(tfuncs[1]->Name(), kFusedNormalizeOp);
+  EXPECT_EQ(tfuncs[2]->Name(), kTypeCastOp);
+  auto fused_op = std::static_pointer_cast<FusedNormalizeOp>(tfuncs[1]);
+  EXPECT_TRUE(fused_op->has_resize_op());
+  EXPECT_TRUE(fused_op->to_chw());
+  EXPECT_EQ(fused_op->output_type(), DataType(DataType::DE_FLOAT16));
+
+  // Nothing is left to fuse
+  modified = false;
+  rc = pass.RunOnNode(map_op, &modified);
+  EXPECT_TRUE(rc.IsOk());
+  EXPECT_FALSE(modified);
+}
+
+// Decode followed by CenterCrop is fused when decoding to RGB only, and more rules can be registered
+TEST_F(MindDataTestTensorOpFusionPass, DecodeCenterCrop_rules) {
+  MS_LOG(INFO) << "Doing DecodeCenterCrop_rules";
+  std::vector<std::shared_ptr<TensorOp>> func_list = {
+    std::make_shared<DecodeOp>(true), std::make_shared<CenterCropOp>(32), std::make_shared<DecodeOp>(false),
+    std::make_shared<CenterCropOp>(32), std::make_shared<HwcToChwOp>()};
+  std::shared_ptr<MapOp> map_op;
+  MapOp::Builder builder;
+  builder.SetInColNames({}).SetOutColNames({}).SetTensorFuncs(func_list).SetNumWorkers(4);
+  Status rc = builder.Build(&map_op);
+  EXPECT_TRUE(rc.IsOk());
+
+  TensorOpFusionPass pass;
+  pass.AddRule({"CenterCropHwcToChw", {kCenterCropOp, kHwcToChwOp},
+                [](const std::vector<std::shared_ptr<TensorOp>> &ops, std::shared_ptr<TensorOp> *fused) {
+                  *fused = std::make_shared<CenterCropOp>(16);
+                  return Status::OK();
+                }});
+  bool modified = false;
+  rc = pass.RunOnNode(map_op, &modified);
+  EXPECT_TRUE(rc.IsOk());
+  auto &tfuncs = map_op->TFuncs();
+  ASSERT_EQ(tfuncs.size(), 3);
+  EXPECT_EQ(tfuncs[0]->Name(), kDecodeCenterCropOp);
+  EXPECT_EQ(tfuncs[1]->Name(), kDecodeOp);
+  EXPECT_EQ(tfuncs[2]->Name(), kCenterCropOp);
+  EXPECT_EQ(static_cast<CenterCropOp *>(tfuncs[2].get())->crop_height(), 16);
+}
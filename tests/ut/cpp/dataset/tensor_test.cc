@@ -22,6 +22,7 @@
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/core/cv_tensor.h"
 #include "minddata/dataset/core/data_type.h"
+#include "minddata/dataset/util/system_pool.h"
 
 using namespace mindspore::dataset;
 
@@ -537,3 +538,43 @@ TEST_F(MindDataTestTensorDE, TensorEmpty) {
   t2->Invalidate();
   ASSERT_TRUE(!t2->HasData());
 }
+
+TEST_F(MindDataTestTensorDE, TensorViewFromMemory) {
+  std::shared_ptr<MemoryPool> pool = std::make_shared<SystemPool>();
+  void *p = nullptr;
+  ASSERT_TRUE(pool->Allocate(6 * sizeof(int32_t), &p).IsOk());
+  auto *src = reinterpret_cast<uchar *>(p);
+  std::vector<int32_t> values = {1, 2, 3, 4, 5, 6};
+  ASSERT_EQ(memcpy_s(src, 6 * sizeof(int32_t), values.data(), 6 * sizeof(int32_t)), 0);
+
+  TensorPtr t;
+  Status rc = Tensor::CreateViewFromMemory(TensorShape({2, 3}), DataType(DataType::DE_INT32), src,
+                                           6 * sizeof(int32_t), pool, &t);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(t->GetBuffer(), src);
+  ASSERT_EQ(pool.use_count(), 2);
+  int32_t o;
+  t->GetItemAt<int32_t>(&o, {1, 2});
+  ASSERT_EQ(o, 6);
+
+  // The view shares the memory with its source
+  ASSERT_TRUE(t->SetItemAt<int32_t>({0, 0}, 7).IsOk());
+  ASSERT_EQ(reinterpret_cast<int32_t *>(src)[0], 7);
+
+  // Unaligned data, wrong length and strings are rejected
+  TensorPtr t2;
+  rc = Tensor::CreateViewFromMemory(TensorShape({1}), DataType(DataType::DE_INT32), src + 1, sizeof(int32_t), pool,
+                                    &t2);
+  ASSERT_TRUE(rc.IsError());
+  rc = Tensor::CreateViewFromMemory(TensorShape({2, 3}), DataType(DataType::DE_INT32), src, 5 * sizeof(int32_t), pool,
+                                    &t2);
+  ASSERT_TRUE(rc.IsError());
+  rc = Tensor::CreateViewFromMemory(TensorShape({1}), DataType(DataType::DE_STRING), src, 6 * sizeof(int32_t), pool,
+                                    &t2);
+  ASSERT_TRUE(rc.IsError());
+  t2.reset();
+
+  // The memory goes back to the pool with the tensor
+  t.reset();
+  ASSERT_EQ(pool.use_count(), 1);
+}
@@ -14,18 +14,24 @@
  * limitations under the License.
  */
 #include <memory>
+#include <random>
 #include <string>
 #include <string_view>
+#include <unordered_set>
+#include <vector>
 
 #include "common/common.h"
 #include "minddata/dataset/text/kernels/basic_tokenizer_op.h"
+#include "minddata/dataset/text/kernels/bert_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/case_fold_op.h"
+#include "minddata/dataset/text/kernels/lookup_op.h"
 #include "minddata/dataset/text/kernels/normalize_utf8_op.h"
 #include "minddata/dataset/text/kernels/regex_replace_op.h"
 #include "minddata/dataset/text/kernels/regex_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/unicode_char_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/unicode_script_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/whitespace_tokenizer_op.h"
+#include "minddata/dataset/text/kernels/wordpiece_tokenizer_op.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
 
@@ -358,4 +364,162 @@ std::shared_ptr<Tensor> input;
   TensorRow output;
   Status s = basic_tokenizer->Compute(TensorRow(0, {input}), &output);
   EXPECT_TRUE(s.IsOk());
-}
\ No newline at end of file
+}
+
+TEST_F(MindDataTestTokenizerOp, TestWordpieceTokenizerOutputIds) {
+  MS_LOG(INFO) << "Doing TestWordpieceTokenizerOutputIds.";
+  std::vector<std::string> words = {"book", "favor", "##ite", "dur", "##ing", "我", "最", "[UNK]"};
+  std::shared_ptr<Vocab> vocab;
+  Status s = Vocab::BuildFromVector(words, {}, true, &vocab);
+  EXPECT_TRUE(s.IsOk());
+  std::shared_ptr<const DoubleArrayTrie> trie;
+  s = vocab->GetTrie(&trie);
+  EXPECT_TRUE(s.IsOk());
+  for (const auto &word : words) {
+    EXPECT_EQ(trie->Find(word), vocab->Lookup(word));
+  }
+  EXPECT_EQ(trie->Find("boo"), DoubleArrayTrie::kNoValue);
+  EXPECT_EQ(trie->Find("books"), DoubleArrayTrie::kNoValue);
+
+  std::shared_ptr<Tensor> input;
+  Tensor::CreateFromVector(std::vector<std::string>{"favorite", "book", "during", "我最", "what"}, &input);
+  std::unique_ptr<WordpieceTokenizerOp> token_op(new WordpieceTokenizerOp(vocab));
+  std::unique_ptr<WordpieceTokenizerOp> id_op(new WordpieceTokenizerOp(vocab, "##", 100, "[UNK]", false, true));
+  TensorRow tokens;
+  TensorRow ids;
+  s = token_op->Compute(TensorRow(0, {input}), &tokens);
+  EXPECT_TRUE(s.IsOk());
+  s = id_op->Compute(TensorRow(0, {input}), &ids);
+  EXPECT_TRUE(s.IsOk());
+  ASSERT_EQ(ids[0]->type(), DataType::DE_INT32);
+  ASSERT_EQ(ids[0]->Size(), 7);
+  ASSERT_EQ(tokens[0]->Size(), ids[0]->Size());
+  for (dsize_t i = 0; i < ids[0]->Size(); ++i) {
+    std::string_view token;
+    int32_t id;
+    EXPECT_TRUE(tokens[0]->GetItemAt(&token, {i}).IsOk());
+    EXPECT_TRUE(ids[0]->GetItemAt(&id, {i}).IsOk());
+    EXPECT_EQ(id, vocab->Lookup(std::string(token)));
+  }
+  CheckEqual(tokens[0], {1}, "##ite");
+  CheckEqual(tokens[0], {5}, "[UNK]");
+}
+
+TEST_F(MindDataTestTokenizerOp, TestTrieOfLargeVocab) {
+  MS_LOG(INFO) << "Doing TestTrieOfLargeVocab.";
+  // about the size of a BERT vocab, random words with shared prefixes and wordpiece suffixes
+  std::mt19937 rng(0);
+  std::unordered_set<std::string> unique_words;
+  std::vector<std::string> words;
+  while (words.size() < 30000) {
+    std::string word = rng() % 3 == 0 ? "##" : "";
+    size_t len = 1 + rng() % 12;
+    for (size_t i = 0; i < len; ++i) {
+      word += static_cast<char>('a' + rng() % 26);
+    }
+    if (unique_words.insert(word).second) {
+      words.push_back(word);
+    }
+  }
+  std::shared_ptr<Vocab> vocab;
+  Status s = Vocab::BuildFromVector(words, {}, true, &vocab);
+  EXPECT_TRUE(s.IsOk());
+  std::shared_ptr<const DoubleArrayTrie> trie;
+  s = vocab->GetTrie(&trie);
+  EXPECT_TRUE(s.IsOk());
+  for (const auto &word : words) {
+    ASSERT_EQ(trie->Find(word), vocab->Lookup(word));
+    EXPECT_EQ(trie->Find(word + "{"), DoubleArrayTrie::kNoValue);
+  }
+  EXPECT_EQ(trie->Find(""), DoubleArrayTrie::kNoValue);
+  EXPECT_EQ(trie->Find("##"), DoubleArrayTrie::kNoValue);
+}
+
+TEST_F(MindDataTestTokenizerOp, TestBertTokenizerOutputIds) {
+  MS_LOG(INFO) << "Doing TestBertTokenizerOutputIds.";
+  std::vector<std::string> words = {"i",    "am",   "mak",    "##ing", "small", "mistake", "##s",
+                                    "work", "hour", "during", "中",    "国",    "[CLS]",   "[UNK]"};
+  std::shared_ptr<Vocab> vocab;
+  Status s = Vocab::BuildFromVector(words, {}, true, &vocab);
+  EXPECT_TRUE(s.IsOk());
+
+  std::shared_ptr<Tensor> input;
+  Tensor::CreateScalar<std::string>("I am making small mistakes during working hours 中国 [CLS] what", &input);
+  std::unique_ptr<BertTokenizerOp> token_op(new BertTokenizerOp(vocab, "##", 100, "[UNK]", true, false,
+                                                                NormalizeForm::kNone, true, true, false));
+  std::unique_ptr<BertTokenizerOp> id_op(new BertTokenizerOp(vocab, "##", 100, "[UNK]", true, false,
+                                                             NormalizeForm::kNone, true, true, true));
+  std::unique_ptr<LookupOp> lookup_op(new LookupOp(vocab, vocab->Lookup("[UNK]")));
+  TensorRow tokens;
+  TensorRow ids;
+  s = token_op->Compute(TensorRow(0, {input}), &tokens);
+  EXPECT_TRUE(s.IsOk());
+  s = id_op->Compute(TensorRow(0, {input}), &ids);
+  EXPECT_TRUE(s.IsOk());
+  std::shared_ptr<Tensor> lookup_ids;
+  s = lookup_op->Compute(tokens[0], &lookup_ids);
+  EXPECT_TRUE(s.IsOk());
+
+  // the same ids and offsets as the tokenizer followed by a lookup
+  ASSERT_EQ(ids.size(), tokens.size());
+  ASSERT_EQ(ids[0]->type(), lookup_ids->type());
+  ASSERT_EQ(ids[0]->shape(), lookup_ids->shape());
+  ASSERT_EQ(ids[0]->Size(), 16);
+  for (dsize_t i = 0; i < ids[0]->Size(); ++i) {
+    int32_t id;
+    int32_t lookup_id;
+    EXPECT_TRUE(ids[0]->GetItemAt(&id, {i}).IsOk());
+    EXPECT_TRUE(lookup_ids->GetItemAt(&lookup_id, {i}).IsOk());
+    EXPECT_EQ(id, lookup_id);
+  }
+  for (size_t i = 1; i < ids.size(); ++i) {
+    EXPECT_EQ(*ids[i], *tokens[i]);
+  }
+  CheckEqual(tokens[0], {3}, "##ing");
+  CheckEqual(tokens[0], {14}, "[CLS]");
+  CheckEqual(tokens[0], {15}, "[UNK]");
+}
+
+TEST_F(MindDataTestTokenizerOp, TestBertTokenizerOutputIdsOfBlankInput) {
+  MS_LOG(INFO) << "Doing TestBertTokenizerOutputIdsOfBlankInput.";
+  std::vector<std::string> words = {"i", "am", "[UNK]"};
+  std::shared_ptr<Vocab> vocab;
+  Status s = Vocab::BuildFromVector(words, {}, true, &vocab);
+  EXPECT_TRUE(s.IsOk());
+  std::unique_ptr<BertTokenizerOp> token_op(new BertTokenizerOp(vocab, "##", 100, "[UNK]", true, false,
+                                                                NormalizeForm::kNone, true, true, false));
+  std::unique_ptr<BertTokenizerOp> id_op(new BertTokenizerOp(vocab, "##", 100, "[UNK]", true, false,
+                                                             NormalizeForm::kNone, true, true, true));
+  std::unique_ptr<LookupOp> lookup_op(new LookupOp(vocab, vocab->Lookup("[UNK]")));
+  for (std::string text : {"", " \t  "}) {
+    std::shared_ptr<Tensor> input;
+    Tensor::CreateScalar<std::string>(text, &input);
+    TensorRow tokens;
+    TensorRow ids;
+    s = token_op->Compute(TensorRow(0, {input}), &tokens);
+    EXPECT_TRUE(s.IsOk());
+    s = id_op->Compute(TensorRow(0, {input}), &ids);
+    EXPECT_TRUE(s.IsOk());
+    std::shared_ptr<Tensor> lookup_ids;
+    s = lookup_op->Compute(tokens[0], &lookup_ids);
+    EXPECT_TRUE(s.IsOk());
+
+    // the string path gives one empty token at offset 0, which the lookup maps to the unknown token
+    ASSERT_EQ(ids.size(), 3);
+    ASSERT_EQ(ids[0]->Size(), 1);
+    ASSERT_EQ(ids[0]->shape(), lookup_ids->shape());
+    int32_t id;
+    int32_t lookup_id;
+    EXPECT_TRUE(ids[0]->GetItemAt(&id, {0}).IsOk());
+    EXPECT_TRUE(lookup_ids->GetItemAt(&lookup_id, {0}).IsOk());
+    EXPECT_EQ(id, vocab->Lookup("[UNK]"));
+    EXPECT_EQ(id, lookup_id);
+    uint32_t offset;
+    for (size_t i = 1; i < ids.size(); ++i) {
+      ASSERT_EQ(ids[i]->Size(), 1);
+      EXPECT_TRUE(ids[i]->GetItemAt(&offset, {0}).IsOk());
+      EXPECT_EQ(offset, 0);
+      EXPECT_EQ(*ids[i], *tokens[i]);
+    }
+  }
+}
@@ -400,6 +400,51 @@ void ShardWriterImageNetOpenForAppend(string filename) {
   MS_LOG(INFO) << "Done create index";
 }
 
+void ShardWriterImageNetPaged(const std::string &filename, uint64_t page_size) {
+  // load binary data
+  std::vector<std::vector<uint8_t>> bin_data;
+  std::vector<std::string> filenames;
+  if (-1 == mindrecord::GetAbsoluteFiles("./data/mindrecord/testImageNetData/images", filenames)) {
+    MS_LOG(INFO) << "-- ATTN -- Missed data directory. Skip this case. -----------------";
+    return;
+  }
+  mindrecord::Img2DataUint8(filenames, bin_data);
+
+  // init shardHeader with schema and index
+  mindrecord::ShardHeader header_data;
+  json anno_schema_json = R"({"file_name": {"type": "string"}, "label": {"type": "int32"}})"_json;
+  std::shared_ptr<mindrecord::Schema> anno_schema = mindrecord::Schema::Build("annotation", anno_schema_json);
+  if (anno_schema == nullptr) {
+    MS_LOG(ERROR) << "Build annotation schema failed";
+    return;
+  }
+  int anno_schema_id = header_data.AddSchema(anno_schema);
+  std::vector<std::pair<uint64_t, std::string>> fields;
+  fields.emplace_back(anno_schema_id, "file_name");
+  fields.emplace_back(anno_schema_id, "label");
+  header_data.AddIndexFields(fields);
+
+  // load  meta data
+  std::vector<json> annotations;
+  LoadDataFromImageNet("./data/mindrecord/testImageNetData/annotation.txt", annotations, 10);
+  std::map<std::uint64_t, std::vector<json>> rawdatas;
+  rawdatas.insert(pair<uint64_t, vector<json>>(anno_schema_id, annotations));
+
+  // small pages spread the images over several blob pages of one shard
+  {
+    mindrecord::ShardWriter fw;
+    fw.Open({filename});
+    fw.SetPageSize(page_size);
+    fw.SetShardHeader(std::make_shared<mindrecord::ShardHeader>(header_data));
+    fw.WriteRawData(rawdatas, bin_data);
+    fw.Commit();
+  }
+
+  mindrecord::ShardIndexGenerator sg{filename};
+  sg.Build();
+  sg.WriteToDatabase();
+  MS_LOG(INFO) << "Done create index";
+}
 
 }  // namespace mindrecord
 }  // namespace mindspore
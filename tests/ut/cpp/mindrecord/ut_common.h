@@ -72,6 +72,8 @@ void ShardWriterImageNet();
 void ShardWriterImageNetOneSample();
 
 void ShardWriterImageNetOpenForAppend(string filename);
+
+void ShardWriterImageNetPaged(const std::string &filename, uint64_t page_size);
 }  // namespace mindrecord
 }  // namespace mindspore
 #endif  // TESTS_MINDRECORD_UT_UT_COMMON_H_
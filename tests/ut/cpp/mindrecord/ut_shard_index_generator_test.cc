@@ -29,6 +29,8 @@
 
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+#include "minddata/mindrecord/include/shard_binary_index.h"
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
 #include "minddata/mindrecord/include/shard_index.h"
@@ -81,5 +83,62 @@ TEST_F(TestShardIndexGenerator, TakeFieldType) {
   auto type5 = ShardIndexGenerator::TakeFieldType("label", schema2);
   ASSERT_EQ("array", type5);
 }
+
+TEST_F(TestShardIndexGenerator, BinaryIndex) {
+  MS_LOG(INFO) << FormatInfo("Test ShardBinaryIndex: write, load and look up");
+
+  // rows out of order, label cycles through 0, 1, 2 except a real 10.0 in row 9,
+  // name is null in row 8 and empty in row 0
+  std::vector<IndexRow> rows;
+  std::vector<std::vector<IndexValue>> values;
+  for (uint64_t i = 0; i < 10; ++i) {
+    uint64_t row_id = 9 - i;
+    rows.push_back(IndexRow{row_id, row_id / 4, 0, row_id * 10, row_id * 10 + 5, row_id / 4 + 1, row_id * 100,
+                            row_id * 100 + 50});
+    IndexValue label;
+    label.type = IndexValueType::kInteger;
+    label.integer = static_cast<int64_t>(row_id % 3);
+    label.text = std::to_string(row_id % 3);
+    if (row_id == 9) {
+      label.type = IndexValueType::kReal;
+      label.real = 10.0;
+      label.text = "10.0";
+    }
+    IndexValue name;
+    if (row_id != 8) {
+      name.type = IndexValueType::kText;
+      name.text = row_id == 0 ? "" : "name" + std::to_string(row_id);
+    }
+    values.push_back({label, name});
+  }
+  std::string index_path = "./binary_index_test.idx";
+  ASSERT_EQ(ShardBinaryIndex::Write(index_path, "binary_index_test", 1024, {"label_0", "name_0"}, {true, false}, rows,
+                                    values),
+            SUCCESS);
+
+  ShardBinaryIndex binary_index;
+  ASSERT_EQ(binary_index.Load(index_path), SUCCESS);
+  ASSERT_EQ(binary_index.GetShardName(), "binary_index_test");
+  ASSERT_EQ(binary_index.GetFileSize(), 1024u);
+  ASSERT_EQ(binary_index.GetNumRows(), 10u);
+  ASSERT_EQ(binary_index.GetRow(3).row_id, 3u);
+  ASSERT_EQ(binary_index.GetRow(3).page_offset_blob, 300u);
+  ASSERT_EQ(binary_index.GetFieldId("name_0"), 1);
+  ASSERT_EQ(binary_index.GetFieldId("score_0"), -1);
+  ASSERT_EQ(binary_index.GetValue(1, 7), "name7");
+  // numbers are ordered and matched by value like sqlite does
+  ASSERT_EQ(binary_index.GetDistinctValues(0), (std::vector<std::string>{"0", "1", "2", "10.0"}));
+  ASSERT_EQ(binary_index.GetRowsByValue(0, "1", 0, 10), (std::vector<uint64_t>{1, 4, 7}));
+  ASSERT_EQ(binary_index.GetRowsByValue(0, "1.0", 0, 10), (std::vector<uint64_t>{1, 4, 7}));
+  ASSERT_EQ(binary_index.GetRowsByValue(0, "1", 4, 8), (std::vector<uint64_t>{4, 7}));
+  ASSERT_EQ(binary_index.GetRowsByValue(0, "10", 0, 10), (std::vector<uint64_t>{9}));
+  ASSERT_TRUE(binary_index.GetRowsByValue(0, "3", 0, 10).empty());
+  // null reads as empty but only the empty text matches it
+  ASSERT_EQ(binary_index.GetValue(1, 8), "");
+  ASSERT_EQ(binary_index.GetRowsByValue(1, "", 0, 10), (std::vector<uint64_t>{0}));
+  ASSERT_EQ(binary_index.GetDistinctValues(1).front(), "");
+  ASSERT_EQ(binary_index.GetDistinctValues(1).size(), 9u);
+  remove(common::SafeCStr(index_path));
+}
 }  // namespace mindrecord
 }  // namespace mindspore
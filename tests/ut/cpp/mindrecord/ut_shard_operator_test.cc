@@ -18,6 +18,7 @@
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -25,6 +26,7 @@
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
 #include "minddata/mindrecord/include/shard_category.h"
+#include "minddata/mindrecord/include/shard_distributed_sample.h"
 #include "minddata/mindrecord/include/shard_pk_sample.h"
 #include "minddata/mindrecord/include/shard_reader.h"
 #include "minddata/mindrecord/include/shard_sample.h"
@@ -265,6 +267,41 @@ TEST_F(TestShardOperator, TestShardShuffle) {
   dataset.Finish();
 }
 
+TEST_F(TestShardOperator, TestShardDistributedSampleBlockShuffle) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test block shuffle of distributed sample"));
+  const int num_tasks = 1000;
+  const int num_shards = 4;
+  const int64_t block_size = 10;
+  const uint32_t seed = 3;
+  ShardTask tasks;
+  for (int i = 0; i < num_tasks; i++) {
+    tasks.InsertTask(TaskType::kCommonTask, 0, i, {}, json{{"id", i}});
+  }
+
+  // The shards split one order, which is the same for the same seed
+  std::set<int> ids;
+  for (int shard_id = 0; shard_id < num_shards; shard_id++) {
+    ShardDistributedSample sample(num_shards, shard_id, true, seed, 0, -1, block_size);
+    ShardTask shard_tasks = tasks;
+    ASSERT_EQ(sample(shard_tasks), SUCCESS);
+    ASSERT_EQ(static_cast<int>(shard_tasks.Size()), num_tasks / num_shards);
+    ShardDistributedSample same_sample(num_shards, shard_id, true, seed, 0, -1, block_size);
+    ShardTask same_tasks = tasks;
+    ASSERT_EQ(same_sample(same_tasks), SUCCESS);
+    std::set<int> blocks;
+    for (uint32_t i = 0; i < shard_tasks.Size(); i++) {
+      int id = std::get<1>(std::get<1>(shard_tasks.GetTaskByID(i)));
+      EXPECT_EQ(id, std::get<1>(std::get<1>(same_tasks.GetTaskByID(i))));
+      ids.insert(id);
+      blocks.insert(id / block_size);
+    }
+    // whole blocks, except in the windows at both ends of the slice
+    int64_t max_blocks = num_tasks / num_shards / block_size + 2 * kShuffleWindowBlocks;
+    EXPECT_LE(static_cast<int64_t>(blocks.size()), max_blocks);
+  }
+  EXPECT_EQ(static_cast<int>(ids.size()), num_tasks);
+}
+
 TEST_F(TestShardOperator, TestShardSampleShuffle) {
   MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test read imageNet"));
 
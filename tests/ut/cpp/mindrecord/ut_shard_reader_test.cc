@@ -14,16 +14,21 @@
  * limitations under the License.
  */
 
+#include <sys/stat.h>
+#include <unistd.h>
 #include <cstring>
+#include <fstream>
 #include <functional>
 #include <iostream>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
 #include "utils/ms_utils.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_category.h"
 #include "minddata/mindrecord/include/shard_reader.h"
 #include "minddata/mindrecord/include/shard_sample.h"
 #include "ut_common.h"
@@ -45,6 +50,7 @@ class TestShardReader : public UT::Common {
       string db_name = std::string("./imagenet.shard0") + std::to_string(i) + ".db";
       remove(common::SafeCStr(filename));
       remove(common::SafeCStr(db_name));
+      remove(common::SafeCStr(filename + kBinaryIndexSuffix));
     }
   }
 };
@@ -194,5 +200,174 @@ TEST_F(TestShardReader, TestShardReaderConsumer) {
   }
   dataset.Finish();
 }
+
+namespace {
+const char kPagedFileName[] = "./imagenet_paged.shard01";
+const int kPagedRows = 10;
+// about three images per blob page, the last page is partially filled
+const uint64_t kPagedPageSize = 1 << 18;
+
+// end_task_id -1 reads row by row, kPagedRows merges the adjacent blobs of each page into one read
+std::vector<std::tuple<std::vector<uint8_t>, json>> ReadAllById(ShardReader *dataset, int64_t end_task_id = -1) {
+  std::vector<std::tuple<std::vector<uint8_t>, json>> rows;
+  for (int task_id = 0; task_id < kPagedRows; ++task_id) {
+    auto row = dataset->GetNextById(task_id, 0, end_task_id).second;
+    rows.insert(rows.end(), row.begin(), row.end());
+  }
+  return rows;
+}
+
+// the classes of the label, the labels of all rows and the rows of the first class, read through the index
+struct IndexedRows {
+  std::set<std::string> classes;
+  std::vector<json> labels;
+  std::vector<json> category_labels;
+};
+
+IndexedRows ReadThroughIndex() {
+  IndexedRows result;
+  {
+    ShardReader reader;
+    EXPECT_EQ(reader.Open({kPagedFileName}, true, 1), SUCCESS);
+    EXPECT_EQ(reader.GetAllClasses("label", result.classes), SUCCESS);
+  }
+  {
+    ShardReader reader;
+    EXPECT_EQ(reader.Open({kPagedFileName}, true, 1, {"file_name", "label"}), SUCCESS);
+    EXPECT_EQ(reader.Launch(true), SUCCESS);
+    for (auto &row : ReadAllById(&reader)) {
+      result.labels.push_back(std::get<1>(row));
+    }
+    reader.Finish();
+  }
+  if (!result.classes.empty()) {
+    std::vector<std::pair<std::string, std::string>> categories = {{"label", *result.classes.begin()}};
+    std::vector<std::shared_ptr<ShardOperator>> ops = {std::make_shared<ShardCategory>(categories)};
+    ShardReader reader;
+    EXPECT_EQ(reader.Open({kPagedFileName}, true, 1, {"file_name", "label"}, ops), SUCCESS);
+    EXPECT_EQ(reader.Launch(), SUCCESS);
+    while (true) {
+      auto rows = reader.GetNext();
+      if (rows.empty()) break;
+      for (auto &row : rows) {
+        result.category_labels.push_back(std::get<1>(row));
+      }
+    }
+    reader.Finish();
+  }
+  return result;
+}
+
+void ExpectSameRows(const IndexedRows &rows, const IndexedRows &expected) {
+  EXPECT_EQ(rows.classes, expected.classes);
+  EXPECT_EQ(rows.labels, expected.labels);
+  EXPECT_EQ(rows.category_labels, expected.category_labels);
+}
+
+void RemovePagedFile() {
+  for (auto suffix : {"", ".db", kBinaryIndexSuffix}) {
+    remove(common::SafeCStr(std::string(kPagedFileName) + suffix));
+  }
+}
+}  // namespace
+
+TEST_F(TestShardReader, TestShardReaderPreadSameAsFileStream) {
+  MS_LOG(INFO) << FormatInfo("Test pread and prefetch give the rows of the file streams");
+  ShardWriterImageNetPaged(kPagedFileName, kPagedPageSize);
+  struct stat file_stat;
+  ASSERT_EQ(stat(kPagedFileName, &file_stat), 0);
+  ASSERT_GT(static_cast<uint64_t>(file_stat.st_size), 3 * kPagedPageSize);
+
+  ShardReader stream_reader;
+  stream_reader.SetMapFiles(false);
+  ASSERT_EQ(stream_reader.Open({kPagedFileName}, true, 1), SUCCESS);
+  ASSERT_EQ(stream_reader.Launch(true), SUCCESS);
+  auto expected = ReadAllById(&stream_reader);
+  stream_reader.Finish();
+  ASSERT_EQ(expected.size(), static_cast<size_t>(kPagedRows));
+
+  // prefetch depth 1 keeps the prefetcher right behind the reads, 0 reads with pread only
+  for (int prefetch_depth : {kPrefetchDepth, 1, 0}) {
+    for (int64_t end_task_id : {-1, kPagedRows}) {
+      ShardReader dataset;
+      dataset.SetPrefetchDepth(prefetch_depth);
+      ASSERT_EQ(dataset.Open({kPagedFileName}, true, 1), SUCCESS);
+      ASSERT_EQ(dataset.Launch(true), SUCCESS);
+      auto rows = ReadAllById(&dataset, end_task_id);
+      dataset.Finish();
+      ASSERT_EQ(rows.size(), expected.size());
+      for (size_t i = 0; i < rows.size(); ++i) {
+        ASSERT_FALSE(std::get<0>(rows[i]).empty());
+        ASSERT_EQ(std::get<0>(rows[i]), std::get<0>(expected[i]));
+        ASSERT_EQ(std::get<1>(rows[i]), std::get<1>(expected[i]));
+      }
+    }
+  }
+  RemovePagedFile();
+}
+
+TEST_F(TestShardReader, TestShardReaderTruncatedFile) {
+  MS_LOG(INFO) << FormatInfo("Test reading a shard file truncated after open");
+  ShardWriterImageNetPaged(kPagedFileName, kPagedPageSize);
+  struct stat file_stat;
+  ASSERT_EQ(stat(kPagedFileName, &file_stat), 0);
+
+  ShardReader dataset;
+  ASSERT_EQ(dataset.Open({kPagedFileName}, true, 1), SUCCESS);
+  // cut the blob pages in half while the file is mapped, the rows behind the end fail instead of raising SIGBUS
+  ASSERT_EQ(truncate(kPagedFileName, file_stat.st_size / 2), 0);
+  ASSERT_EQ(dataset.Launch(true), SUCCESS);
+  auto rows = ReadAllById(&dataset);
+  dataset.Finish();
+  ASSERT_LT(rows.size(), static_cast<size_t>(kPagedRows));
+  RemovePagedFile();
+}
+TEST_F(TestShardReader, TestShardReaderBinaryIndexSameAsDb) {
+  MS_LOG(INFO) << FormatInfo("Test the binary index gives the rows of the index db");
+  ShardWriterImageNetPaged(kPagedFileName, kPagedPageSize);
+  std::string index_path = std::string(kPagedFileName) + kBinaryIndexSuffix;
+  struct stat file_stat;
+  ASSERT_EQ(stat(common::SafeCStr(index_path), &file_stat), 0);
+  auto binary_rows = ReadThroughIndex();
+  ASSERT_FALSE(binary_rows.classes.empty());
+  ASSERT_EQ(binary_rows.labels.size(), static_cast<size_t>(kPagedRows));
+  ASSERT_FALSE(binary_rows.category_labels.empty());
+
+  ASSERT_EQ(remove(common::SafeCStr(index_path)), 0);
+  auto db_rows = ReadThroughIndex();
+  ExpectSameRows(binary_rows, db_rows);
+  RemovePagedFile();
+}
+
+TEST_F(TestShardReader, TestShardReaderStaleBinaryIndex) {
+  MS_LOG(INFO) << FormatInfo("Test a stale or corrupt binary index falls back to the index db");
+  ShardWriterImageNetPaged(kPagedFileName, kPagedPageSize);
+  std::string index_path = std::string(kPagedFileName) + kBinaryIndexSuffix;
+  ASSERT_EQ(remove(common::SafeCStr(index_path)), 0);
+  auto expected = ReadThroughIndex();
+  ASSERT_EQ(expected.labels.size(), static_cast<size_t>(kPagedRows));
+
+  // an index of an older version and an index that is not one at all
+  std::string old_version(kBinaryIndexMagic, strlen(kBinaryIndexMagic));
+  uint64_t version = 1;
+  old_version.append(reinterpret_cast<const char *>(&version), sizeof(version));
+  for (const auto &content : {old_version, std::string("not a binary index")}) {
+    {
+      std::ofstream out(index_path, std::ios::binary | std::ios::trunc);
+      out << content;
+    }
+    ExpectSameRows(ReadThroughIndex(), expected);
+  }
+
+  // an index of the shard before it was rewritten with other pages
+  ShardWriterImageNetPaged(kPagedFileName, kPagedPageSize);
+  std::string stale_path = index_path + ".stale";
+  ASSERT_EQ(rename(common::SafeCStr(index_path), common::SafeCStr(stale_path)), 0);
+  RemovePagedFile();
+  ShardWriterImageNetPaged(kPagedFileName, 2 * kPagedPageSize);
+  ASSERT_EQ(rename(common::SafeCStr(stale_path), common::SafeCStr(index_path)), 0);
+  ExpectSameRows(ReadThroughIndex(), expected);
+  RemovePagedFile();
+}
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -15,6 +15,8 @@
  */
 #include <iostream>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "common/common_test.h"
 #include "common/py_func_graph_fetcher.h"
@@ -100,6 +102,17 @@ class TestOptOpt : public UT::Common {
     return CheckTransform(before, after, eq);
   }
 
+  // a copy of the substitution which records the nodes it is tried on
+  SubstitutionPtr RecordTries(const SubstitutionPtr &substitution, std::vector<AnfNodePtr> *tried) {
+    auto recorded = std::make_shared<Substitution>(*substitution);
+    auto predicate = substitution->predicate_;
+    recorded->predicate_ = [predicate, tried](const AnfNodePtr &node) {
+      tried->push_back(node);
+      return predicate(node);
+    };
+    return recorded;
+  }
+
  public:
   UT::PyFuncGraphFetcher getPyFun;
 
@@ -177,6 +190,62 @@ TEST_F(TestOptOpt, ConstantVariable) {
   ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({Qct_to_P})));
 }
 
+TEST_F(TestOptOpt, MultiPattern) {
+  FuncGraphPtr before = getPyFun.CallAndParseRet("test_multi_pattern", "before_1");
+  FuncGraphPtr after = getPyFun.CallAndParseRet("test_multi_pattern", "after");
+
+  ASSERT_TRUE(nullptr != before);
+  ASSERT_TRUE(nullptr != after);
+  // each substitution enables the next one on the same nodes, all of them are applied in a single list
+  ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({idempotent_P, elim_R, Qct_to_P})));
+  ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({Qct_to_P, elim_R, idempotent_P})));
+
+  // (P(P(x)), S(S(...S(y)))), only P(P(x)) is replaced
+  const int chain_length = 32;
+  auto S = std::make_shared<Primitive>("S");
+  auto T = std::make_shared<Primitive>("T");
+  FuncGraphPtr func_graph = std::make_shared<FuncGraph>();
+  auto x = func_graph->add_parameter();
+  AnfNodePtr chain = func_graph->add_parameter();
+  std::vector<AnfNodePtr> chain_nodes;
+  for (int i = 0; i < chain_length; ++i) {
+    chain = func_graph->NewCNode({NewValueNode(S), chain});
+    chain_nodes.push_back(chain);
+  }
+  auto p_p_x = func_graph->NewCNode({NewValueNode(P), func_graph->NewCNode({NewValueNode(P), x})});
+  func_graph->set_output(func_graph->NewCNode({NewValueNode(prim::kPrimMakeTuple), p_p_x, chain}));
+
+  std::vector<AnfNodePtr> tried_p;
+  std::vector<AnfNodePtr> tried_t;
+  std::unordered_map<AnfNodePtr, int> visits;
+  auto count_visits = [&visits](const AnfNodePtr &node) {
+    visits[node]++;
+    return false;
+  };
+  SubstitutionList transform({RecordTries(idempotent_P, &tried_p),
+                              RecordTries(MakeSubstitution(std::make_shared<QctToP>(), "T_to_P", T), &tried_t),
+                              MakeSubstitution(std::make_shared<QctToP>(), "count_visits", count_visits)});
+  auto output = func_graph->output();
+  OptimizerPtr optimizer = std::make_shared<Optimizer>("ut_test", std::make_shared<pipeline::Resource>());
+  ASSERT_TRUE(transform(func_graph, optimizer));
+  auto new_p_x = output->cast<CNodePtr>()->input(1);
+  ASSERT_TRUE(IsPrimitiveCNode(new_p_x, P));
+  ASSERT_EQ(new_p_x->cast<CNodePtr>()->input(1), x);
+
+  // the index only tries a substitution on the nodes of its primitive
+  ASSERT_FALSE(tried_p.empty());
+  for (auto &node : tried_p) {
+    ASSERT_TRUE(IsPrimitiveCNode(node, P));
+  }
+  ASSERT_TRUE(tried_t.empty());
+  // one pass replaces and one pass finds nothing to do, the untouched chain is visited once in each pass while
+  // the user of the replaced node is visited again in the first one
+  for (auto &node : chain_nodes) {
+    ASSERT_EQ(visits[node], 2);
+  }
+  ASSERT_EQ(visits[output], 3);
+}
+
 TEST_F(TestOptOpt, CSE) {
   // test a simple cse testcase test_f1
   FuncGraphPtr test_graph1 = getPyFun.CallAndParseRet("test_cse", "test_f1");
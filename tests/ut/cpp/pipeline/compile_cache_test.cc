@@ -0,0 +1,252 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/common_test.h"
+#include "pipeline/jit/compile_cache.h"
+#include "pipeline/jit/static_analysis/static_analysis.h"
+#include "ir/manager.h"
+#include "ir/tensor.h"
+#include "frontend/operator/ops.h"
+#include "vm/segment_runner.h"
+#include "vm/transform.h"
+#include "utils/convert_utils.h"
+
+namespace mindspore {
+namespace pipeline {
+namespace {
+constexpr char kCachePath[] = "./compile_cache_test";
+constexpr uint64_t kCacheSize = 1024 * 1024;
+}  // namespace
+
+class TestCompileCache : public UT::Common {
+ public:
+  TestCompileCache() { UT::InitPythonPath(); }
+  void SetUp() { CompileCache::GetInstance().Init(kCachePath, kCacheSize); }
+  void TearDown() {
+    CompileCache::GetInstance().Init("", 0);
+    DIR *dir = opendir(kCachePath);
+    if (dir == nullptr) {
+      return;
+    }
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != nullptr) {
+      (void)remove((std::string(kCachePath) + "/" + entry->d_name).c_str());
+    }
+    (void)closedir(dir);
+    (void)rmdir(kCachePath);
+  }
+
+  tensor::TensorPtr MakeTensor(double value) {
+    return std::make_shared<tensor::Tensor>(std::vector<double>{value, value}, kFloat32);
+  }
+
+  // x + [value, value]
+  FuncGraphPtr MakeGraph(double value) {
+    auto func_graph = std::make_shared<FuncGraph>();
+    auto x = func_graph->add_parameter();
+    auto add = func_graph->NewCNode({NewValueNode(prim::kPrimTensorAdd), x, NewValueNode(MakeTensor(value))});
+    func_graph->set_output(add);
+    return func_graph;
+  }
+
+  // Depend(w, Depend(b, x)) with the weights w and b, the output is the value of w
+  FuncGraphPtr MakeWeightGraph(double weight, double bias) {
+    auto func_graph = std::make_shared<FuncGraph>();
+    auto x = func_graph->add_parameter();
+    x->set_name("x");
+    x->set_abstract(MakeTensor(0)->ToAbstract()->Broaden());
+    auto add_weight = [&func_graph](const std::string &name, const tensor::TensorPtr &value) {
+      auto param = func_graph->add_parameter();
+      param->set_name(name);
+      param->set_default_param(value);
+      param->set_abstract(abstract::FromValue(value, true));
+      return param;
+    };
+    auto w = add_weight("w", MakeTensor(weight));
+    auto b = add_weight("b", MakeTensor(bias));
+    auto depend_bias = func_graph->NewCNode({NewValueNode(prim::kPrimDepend), b, x});
+    depend_bias->set_abstract(b->abstract());
+    auto depend_weight = func_graph->NewCNode({NewValueNode(prim::kPrimDepend), w, depend_bias});
+    depend_weight->set_abstract(w->abstract());
+    func_graph->set_output(depend_weight);
+    return func_graph;
+  }
+
+  ParameterPtr GetParameter(const FuncGraphPtr &func_graph, const std::string &name) {
+    for (auto &node : func_graph->parameters()) {
+      auto param = node->cast<ParameterPtr>();
+      if (param != nullptr && param->name() == name) {
+        return param;
+      }
+    }
+    return nullptr;
+  }
+
+  // Run the graph on the vm, the parameters with default value take their value
+  tensor::TensorPtr Run(const FuncGraphPtr &func_graph, const tensor::TensorPtr &input) {
+    auto manager = Manage(func_graph);
+    compile::CompileGraph transform(std::make_shared<compile::Backend>("vm"));
+    AnfNodePtrList nodes;
+    for (auto &segment : transform.SplitNodes(func_graph)) {
+      if (utils::isa<VectorRef>(segment)) {
+        for (auto &item : utils::cast<VectorRef>(segment)) {
+          nodes.push_back(utils::cast<AnfNodePtr>(item));
+        }
+      }
+    }
+    auto result = compile::MsVmConvert(nodes, "");
+    VectorRef args;
+    for (auto &node : result.inputs) {
+      auto param = node->cast<ParameterPtr>();
+      MS_EXCEPTION_IF_NULL(param);
+      if (param->has_default()) {
+        args.push_back(param->default_param());
+      } else {
+        args.push_back(input);
+      }
+    }
+    auto outputs = (*result.run)(args);
+    return py::cast<tensor::TensorPtr>(BaseRefToPyData(outputs[0]));
+  }
+
+  std::string GetFilePath(const std::string &key) { return std::string(kCachePath) + "/" + key + ".mindir"; }
+
+  std::string ReadFile(const std::string &file_path) {
+    std::ifstream ifs(file_path, std::ios::in | std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+  }
+
+  void WriteFile(const std::string &file_path, const std::string &content) {
+    std::ofstream ofs(file_path, std::ios::out | std::ios::binary | std::ios::trunc);
+    ofs.write(content.data(), static_cast<std::streamsize>(content.size()));
+  }
+
+  struct stat GetStat(const std::string &file_path) {
+    struct stat file_stat = {};
+    (void)stat(file_path.c_str(), &file_stat);
+    return file_stat;
+  }
+
+  void SetUseTime(const std::string &file_path, time_t time) {
+    struct utimbuf times = {time, time};
+    ASSERT_EQ(utime(file_path.c_str(), &times), 0);
+  }
+};
+
+TEST_F(TestCompileCache, test_same_graph_same_key) {
+  auto &cache = CompileCache::GetInstance();
+  abstract::AbstractBasePtrList args_spec = {abstract::FromValue(1, true)};
+  ASSERT_EQ(cache.GetKey(MakeGraph(1.0), args_spec), cache.GetKey(MakeGraph(1.0), args_spec));
+}
+
+TEST_F(TestCompileCache, test_constant_data_changes_key) {
+  auto &cache = CompileCache::GetInstance();
+  abstract::AbstractBasePtrList args_spec = {abstract::FromValue(1, true)};
+  ASSERT_NE(cache.GetKey(MakeGraph(1.0), args_spec), cache.GetKey(MakeGraph(2.0), args_spec));
+}
+
+TEST_F(TestCompileCache, test_args_spec_changes_key) {
+  auto &cache = CompileCache::GetInstance();
+  auto func_graph = MakeGraph(1.0);
+  abstract::AbstractBasePtrList int_args = {abstract::FromValue(1, true)};
+  abstract::AbstractBasePtrList float_args = {abstract::FromValue(1.0f, true)};
+  ASSERT_NE(cache.GetKey(func_graph, int_args), cache.GetKey(func_graph, float_args));
+}
+
+TEST_F(TestCompileCache, test_store_load_run) {
+  auto &cache = CompileCache::GetInstance();
+  auto input = MakeTensor(5.0);
+  abstract::AbstractBasePtrList args_spec = {input->ToAbstract()->Broaden()};
+  auto func_graph = MakeWeightGraph(1.0, 2.0);
+  auto key = cache.GetKey(func_graph, args_spec);
+  cache.Store(key, func_graph);
+
+  // the network compiled again with other weights has the same key, the cached graph takes its weights by name
+  auto network = MakeWeightGraph(3.0, 4.0);
+  ASSERT_EQ(cache.GetKey(network, args_spec), key);
+  auto loaded = cache.Load(key, network);
+  ASSERT_NE(loaded, nullptr);
+  for (auto &name : {"w", "b"}) {
+    auto param = GetParameter(loaded, name);
+    ASSERT_NE(param, nullptr);
+    ASSERT_EQ(param->default_param(), GetParameter(network, name)->default_param());
+  }
+  auto output = Run(loaded, input);
+  ASSERT_TRUE(output->ValueEqual(*Run(network, input)));
+  ASSERT_TRUE(output->ValueEqual(*MakeTensor(3.0)));
+}
+
+TEST_F(TestCompileCache, test_invalid_file_falls_back) {
+  auto &cache = CompileCache::GetInstance();
+  auto func_graph = MakeWeightGraph(1.0, 2.0);
+  auto key = cache.GetKey(func_graph, {});
+  cache.Store(key, func_graph);
+  auto file_path = GetFilePath(key);
+  auto content = ReadFile(file_path);
+  ASSERT_FALSE(content.empty());
+  ASSERT_NE(cache.Load(key, func_graph), nullptr);
+  // the weights of the cached graph are missing in this graph
+  ASSERT_EQ(cache.Load(key, MakeGraph(1.0)), nullptr);
+
+  // a file of an older version, a corrupted graph, a truncated file and garbage are missed
+  const std::string magic = "MSCOMPILECACHE ";
+  std::string stale = magic + "0" + content.substr(content.find(' ', magic.size()));
+  std::string corrupted = content;
+  corrupted[corrupted.size() - 1] ^= 0x5a;
+  std::vector<std::string> invalid_files = {stale, corrupted, content.substr(0, content.size() / 2), "garbage"};
+  for (auto &invalid : invalid_files) {
+    WriteFile(file_path, invalid);
+    ASSERT_EQ(cache.Load(key, func_graph), nullptr);
+  }
+
+  // the graph compiled after the miss replaces the invalid file
+  cache.Store(key, func_graph);
+  ASSERT_NE(cache.Load(key, func_graph), nullptr);
+}
+
+TEST_F(TestCompileCache, test_evict_least_recently_used) {
+  auto &cache = CompileCache::GetInstance();
+  auto func_graph = MakeWeightGraph(1.0, 2.0);
+  cache.Store("first", func_graph);
+  auto file_size = static_cast<uint64_t>(GetStat(GetFilePath("first")).st_size);
+  ASSERT_GT(file_size, 0);
+  // room for two graphs
+  cache.Init(kCachePath, 2 * file_size + file_size / 2);
+  cache.Store("second", func_graph);
+
+  // a hit marks the graph as used
+  SetUseTime(GetFilePath("first"), 1000);
+  SetUseTime(GetFilePath("second"), 2000);
+  ASSERT_NE(cache.Load("first", func_graph), nullptr);
+  ASSERT_GT(GetStat(GetFilePath("first")).st_mtime, 2000);
+
+  cache.Store("third", func_graph);
+  ASSERT_NE(cache.Load("first", func_graph), nullptr);
+  ASSERT_EQ(cache.Load("second", func_graph), nullptr);
+  ASSERT_NE(cache.Load("third", func_graph), nullptr);
+}
+}  // namespace pipeline
+}  // namespace mindspore
@@ -124,6 +124,25 @@ def test_constant_variable(tag):
     return fns[tag]
 
 
+def test_multi_pattern(tag):
+    """ test_multi_pattern """
+    P = Primitive('P')
+    Q = Primitive('Q')
+    R = Primitive('R')
+
+    fns = FnDict()
+
+    @fns
+    def before_1(x):
+        return P(P(R(Q(15)))) + R(P(P(x)))
+
+    @fns
+    def after(x):
+        return P(15) + P(x)
+
+    return fns[tag]
+
+
 def cost(x):
     """ cost """
     return x * 10
@@ -237,6 +237,28 @@ def test_graphdata_getedgefeature():
     assert features[1].shape == (40,)
 
 
+def test_graphdata_csr_storage():
+    """
+    Test the graph stored in compressed sparse row format gives the same results
+    """
+    logger.info('test csr storage.\n')
+    g = ds.GraphData(DATASET_FILE)
+    csr_g = ds.GraphData(DATASET_FILE, csr_storage=True)
+    nodes = csr_g.get_all_nodes(1)
+    assert np.array_equal(nodes, g.get_all_nodes(1))
+    neighbor = csr_g.get_all_neighbors(nodes, 2)
+    assert np.array_equal(neighbor, g.get_all_neighbors(nodes, 2))
+    for feature, expected in zip(csr_g.get_node_feature(neighbor.tolist(), [2, 3]),
+                                 g.get_node_feature(neighbor.tolist(), [2, 3])):
+        assert np.array_equal(feature, expected)
+    edges = csr_g.get_all_edges(0)
+    assert np.array_equal(csr_g.get_nodes_from_edges(edges), g.get_nodes_from_edges(edges))
+    for feature, expected in zip(csr_g.get_edge_feature(edges, [1, 2]), g.get_edge_feature(edges, [1, 2])):
+        assert np.array_equal(feature, expected)
+    neighbor = csr_g.get_sampled_neighbors(nodes, [2, 3], [2, 1])
+    assert neighbor.shape == (10, 9)
+
+
 if __name__ == '__main__':
     test_graphdata_getfullneighbor()
     test_graphdata_getnodefeature_input_check()
@@ -247,3 +269,4 @@ if __name__ == '__main__':
     test_graphdata_randomwalkdefault()
     test_graphdata_randomwalk()
     test_graphdata_getedgefeature()
+    test_graphdata_csr_storage()
@@ -52,6 +52,8 @@ def add_and_remove_cv_file():
                 os.remove("{}".format(x))
             if os.path.exists("{}.db".format(x)):
                 os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
         writer = FileWriter(CV_FILE_NAME, FILES_NUM)
         data = get_data(CV_DIR_NAME)
         cv_schema_json = {"id": {"type": "int32"},
@@ -67,11 +69,13 @@ def add_and_remove_cv_file():
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            os.remove("{}.idx".format(x))
         raise error
     else:
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            os.remove("{}.idx".format(x))
 
 @pytest.fixture
 def add_and_remove_nlp_file():
@@ -84,6 +88,8 @@ def add_and_remove_nlp_file():
                 os.remove("{}".format(x))
             if os.path.exists("{}.db".format(x)):
                 os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
         writer = FileWriter(NLP_FILE_NAME, FILES_NUM)
         data = [x for x in get_nlp_data(NLP_FILE_POS, NLP_FILE_VOCAB, 10)]
         nlp_schema_json = {"id": {"type": "string"}, "label": {"type": "int32"},
@@ -106,11 +112,13 @@ def add_and_remove_nlp_file():
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            os.remove("{}.idx".format(x))
         raise error
     else:
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            os.remove("{}.idx".format(x))
 
 
 @pytest.fixture
@@ -124,6 +132,8 @@ def add_and_remove_nlp_compress_file():
                 os.remove("{}".format(x))
             if os.path.exists("{}.db".format(x)):
                 os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
         writer = FileWriter(NLP_FILE_NAME, FILES_NUM)
         data = []
         for row_id in range(16):
@@ -158,11 +168,13 @@ def add_and_remove_nlp_compress_file():
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            os.remove("{}.idx".format(x))
         raise error
     else:
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            os.remove("{}.idx".format(x))
 
 
 def test_nlp_compress_data(add_and_remove_nlp_compress_file):
@@ -225,6 +237,8 @@ def test_cv_minddataset_writer_tutorial():
                 os.remove("{}".format(x))
             if os.path.exists("{}.db".format(x)):
                 os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
         writer = FileWriter(CV_FILE_NAME, FILES_NUM)
         data = get_data(CV_DIR_NAME)
         cv_schema_json = {"file_name": {"type": "string"}, "label": {"type": "int32"},
@@ -237,11 +251,13 @@ def test_cv_minddataset_writer_tutorial():
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            os.remove("{}.idx".format(x))
         raise error
     else:
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            os.remove("{}.idx".format(x))
 
 
 def test_cv_minddataset_partition_tutorial(add_and_remove_cv_file):
@@ -643,10 +659,14 @@ def test_cv_minddataset_reader_two_dataset(add_and_remove_cv_file):
             os.remove(CV1_FILE_NAME)
         if os.path.exists("{}.db".format(CV1_FILE_NAME)):
             os.remove("{}.db".format(CV1_FILE_NAME))
+        if os.path.exists("{}.idx".format(CV1_FILE_NAME)):
+            os.remove("{}.idx".format(CV1_FILE_NAME))
         if os.path.exists(CV2_FILE_NAME):
             os.remove(CV2_FILE_NAME)
         if os.path.exists("{}.db".format(CV2_FILE_NAME)):
             os.remove("{}.db".format(CV2_FILE_NAME))
+        if os.path.exists("{}.idx".format(CV2_FILE_NAME)):
+            os.remove("{}.idx".format(CV2_FILE_NAME))
         writer = FileWriter(CV1_FILE_NAME, 1)
         data = get_data(CV_DIR_NAME)
         cv_schema_json = {"id": {"type": "int32"},
@@ -692,20 +712,28 @@ def test_cv_minddataset_reader_two_dataset(add_and_remove_cv_file):
             os.remove(CV1_FILE_NAME)
         if os.path.exists("{}.db".format(CV1_FILE_NAME)):
             os.remove("{}.db".format(CV1_FILE_NAME))
+        if os.path.exists("{}.idx".format(CV1_FILE_NAME)):
+            os.remove("{}.idx".format(CV1_FILE_NAME))
         if os.path.exists(CV2_FILE_NAME):
             os.remove(CV2_FILE_NAME)
         if os.path.exists("{}.db".format(CV2_FILE_NAME)):
             os.remove("{}.db".format(CV2_FILE_NAME))
+        if os.path.exists("{}.idx".format(CV2_FILE_NAME)):
+            os.remove("{}.idx".format(CV2_FILE_NAME))
         raise error
     else:
         if os.path.exists(CV1_FILE_NAME):
             os.remove(CV1_FILE_NAME)
         if os.path.exists("{}.db".format(CV1_FILE_NAME)):
             os.remove("{}.db".format(CV1_FILE_NAME))
+        if os.path.exists("{}.idx".format(CV1_FILE_NAME)):
+            os.remove("{}.idx".format(CV1_FILE_NAME))
         if os.path.exists(CV2_FILE_NAME):
             os.remove(CV2_FILE_NAME)
         if os.path.exists("{}.db".format(CV2_FILE_NAME)):
             os.remove("{}.db".format(CV2_FILE_NAME))
+        if os.path.exists("{}.idx".format(CV2_FILE_NAME)):
+            os.remove("{}.idx".format(CV2_FILE_NAME))
 
 def test_cv_minddataset_reader_two_dataset_partition(add_and_remove_cv_file):
     paths = ["{}{}".format(CV1_FILE_NAME, str(x).rjust(1, '0'))
@@ -716,6 +744,8 @@ def test_cv_minddataset_reader_two_dataset_partition(add_and_remove_cv_file):
                 os.remove("{}".format(x))
             if os.path.exists("{}.db".format(x)):
                 os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
         writer = FileWriter(CV1_FILE_NAME, FILES_NUM)
         data = get_data(CV_DIR_NAME)
         cv_schema_json = {"id": {"type": "int32"},
@@ -751,11 +781,13 @@ def test_cv_minddataset_reader_two_dataset_partition(add_and_remove_cv_file):
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            os.remove("{}.idx".format(x))
         raise error
     else:
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            os.remove("{}.idx".format(x))
 
 def test_cv_minddataset_reader_basic_tutorial(add_and_remove_cv_file):
     """tutorial for cv minderdataset."""
@@ -1093,6 +1125,8 @@ def test_write_with_multi_bytes_and_array_and_read_by_MindDataset():
             os.remove("{}".format(mindrecord_file_name))
         if os.path.exists("{}.db".format(mindrecord_file_name)):
             os.remove("{}.db".format(mindrecord_file_name))
+        if os.path.exists("{}.idx".format(mindrecord_file_name)):
+            os.remove("{}.idx".format(mindrecord_file_name))
         data = [{"file_name": "001.jpg", "label": 4,
                  "image1": bytes("image1 bytes abc", encoding='UTF-8'),
                  "image2": bytes("image1 bytes def", encoding='UTF-8'),
@@ -1336,10 +1370,12 @@ def test_write_with_multi_bytes_and_array_and_read_by_MindDataset():
     except Exception as error:
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        os.remove("{}.idx".format(mindrecord_file_name))
         raise error
     else:
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        os.remove("{}.idx".format(mindrecord_file_name))
 
 
 def test_write_with_multi_bytes_and_MindDataset():
@@ -1517,10 +1553,12 @@ def test_write_with_multi_bytes_and_MindDataset():
     except Exception as error:
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        os.remove("{}.idx".format(mindrecord_file_name))
         raise error
     else:
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        os.remove("{}.idx".format(mindrecord_file_name))
 
 def test_write_with_multi_array_and_MindDataset():
     mindrecord_file_name = "test.mindrecord"
@@ -1719,10 +1757,12 @@ def test_write_with_multi_array_and_MindDataset():
     except Exception as error:
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        os.remove("{}.idx".format(mindrecord_file_name))
         raise error
     else:
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        os.remove("{}.idx".format(mindrecord_file_name))
 
 
 def test_numpy_generic():
@@ -1734,6 +1774,8 @@ def test_numpy_generic():
                 os.remove("{}".format(x))
             if os.path.exists("{}.db".format(x)):
                 os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
         writer = FileWriter(CV_FILE_NAME, FILES_NUM)
         cv_schema_json = {"label1": {"type": "int32"}, "label2": {"type": "int64"},
                           "label3": {"type": "float32"}, "label4": {"type": "float64"}}
@@ -1764,11 +1806,13 @@ def test_numpy_generic():
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            os.remove("{}.idx".format(x))
         raise error
     else:
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            os.remove("{}.idx".format(x))
 
 
 def test_write_with_float32_float64_float32_array_float64_array_and_MindDataset():
@@ -1918,10 +1962,12 @@ def test_write_with_float32_float64_float32_array_float64_array_and_MindDataset(
     except Exception as error:
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        os.remove("{}.idx".format(mindrecord_file_name))
         raise error
     else:
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        os.remove("{}.idx".format(mindrecord_file_name))
 
 if __name__ == '__main__':
     test_nlp_compress_data(add_and_remove_nlp_compress_file)
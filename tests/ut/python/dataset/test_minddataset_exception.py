@@ -30,6 +30,8 @@ def create_cv_mindrecord(files_num):
         os.remove(CV_FILE_NAME)
     if os.path.exists("{}.db".format(CV_FILE_NAME)):
         os.remove("{}.db".format(CV_FILE_NAME))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME)):
+        os.remove("{}.idx".format(CV_FILE_NAME))
     writer = FileWriter(CV_FILE_NAME, files_num)
     cv_schema_json = {"file_name": {"type": "string"}, "label": {"type": "int32"}, "data": {"type": "bytes"}}
     data = [{"file_name": "001.jpg", "label": 43, "data": bytes('0xffsafdafda', encoding='utf-8')}]
@@ -45,6 +47,8 @@ def create_diff_schema_cv_mindrecord(files_num):
         os.remove(CV1_FILE_NAME)
     if os.path.exists("{}.db".format(CV1_FILE_NAME)):
         os.remove("{}.db".format(CV1_FILE_NAME))
+    if os.path.exists("{}.idx".format(CV1_FILE_NAME)):
+        os.remove("{}.idx".format(CV1_FILE_NAME))
     writer = FileWriter(CV1_FILE_NAME, files_num)
     cv_schema_json = {"file_name_1": {"type": "string"}, "label": {"type": "int32"}, "data": {"type": "bytes"}}
     data = [{"file_name_1": "001.jpg", "label": 43, "data": bytes('0xffsafdafda', encoding='utf-8')}]
@@ -60,6 +64,8 @@ def create_diff_page_size_cv_mindrecord(files_num):
         os.remove(CV1_FILE_NAME)
     if os.path.exists("{}.db".format(CV1_FILE_NAME)):
         os.remove("{}.db".format(CV1_FILE_NAME))
+    if os.path.exists("{}.idx".format(CV1_FILE_NAME)):
+        os.remove("{}.idx".format(CV1_FILE_NAME))
     writer = FileWriter(CV1_FILE_NAME, files_num)
     writer.set_page_size(1 << 26)  # 64MB
     cv_schema_json = {"file_name": {"type": "string"}, "label": {"type": "int32"}, "data": {"type": "bytes"}}
@@ -79,6 +85,7 @@ def test_cv_lack_json():
         ds.MindDataset(CV_FILE_NAME, "no_exist.json", columns_list, num_readers)
     os.remove(CV_FILE_NAME)
     os.remove("{}.db".format(CV_FILE_NAME))
+    os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_cv_lack_mindrecord():
@@ -111,6 +118,7 @@ def test_invalid_mindrecord():
 def test_minddataset_lack_db():
     create_cv_mindrecord(1)
     os.remove("{}.db".format(CV_FILE_NAME))
+    os.remove("{}.idx".format(CV_FILE_NAME))
     columns_list = ["data", "file_name", "label"]
     num_readers = 4
     with pytest.raises(Exception, match="MindRecordOp init failed"):
@@ -139,6 +147,7 @@ def test_cv_minddataset_pk_sample_error_class_column():
             num_iter += 1
     os.remove(CV_FILE_NAME)
     os.remove("{}.db".format(CV_FILE_NAME))
+    os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_cv_minddataset_pk_sample_exclusive_shuffle():
@@ -154,6 +163,7 @@ def test_cv_minddataset_pk_sample_exclusive_shuffle():
             num_iter += 1
     os.remove(CV_FILE_NAME)
     os.remove("{}.db".format(CV_FILE_NAME))
+    os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_cv_minddataset_reader_different_schema():
@@ -169,8 +179,10 @@ def test_cv_minddataset_reader_different_schema():
             num_iter += 1
     os.remove(CV_FILE_NAME)
     os.remove("{}.db".format(CV_FILE_NAME))
+    os.remove("{}.idx".format(CV_FILE_NAME))
     os.remove(CV1_FILE_NAME)
     os.remove("{}.db".format(CV1_FILE_NAME))
+    os.remove("{}.idx".format(CV1_FILE_NAME))
 
 
 def test_cv_minddataset_reader_different_page_size():
@@ -186,8 +198,10 @@ def test_cv_minddataset_reader_different_page_size():
             num_iter += 1
     os.remove(CV_FILE_NAME)
     os.remove("{}.db".format(CV_FILE_NAME))
+    os.remove("{}.idx".format(CV_FILE_NAME))
     os.remove(CV1_FILE_NAME)
     os.remove("{}.db".format(CV1_FILE_NAME))
+    os.remove("{}.idx".format(CV1_FILE_NAME))
 
 
 def test_minddataset_invalidate_num_shards():
@@ -204,10 +218,12 @@ def test_minddataset_invalidate_num_shards():
     except Exception as error:
         os.remove(CV_FILE_NAME)
         os.remove("{}.db".format(CV_FILE_NAME))
+        os.remove("{}.idx".format(CV_FILE_NAME))
         raise error
     else:
         os.remove(CV_FILE_NAME)
         os.remove("{}.db".format(CV_FILE_NAME))
+        os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_minddataset_invalidate_shard_id():
@@ -224,10 +240,12 @@ def test_minddataset_invalidate_shard_id():
     except Exception as error:
         os.remove(CV_FILE_NAME)
         os.remove("{}.db".format(CV_FILE_NAME))
+        os.remove("{}.idx".format(CV_FILE_NAME))
         raise error
     else:
         os.remove(CV_FILE_NAME)
         os.remove("{}.db".format(CV_FILE_NAME))
+        os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_minddataset_shard_id_bigger_than_num_shard():
@@ -244,6 +262,7 @@ def test_minddataset_shard_id_bigger_than_num_shard():
     except Exception as error:
         os.remove(CV_FILE_NAME)
         os.remove("{}.db".format(CV_FILE_NAME))
+        os.remove("{}.idx".format(CV_FILE_NAME))
         raise error
 
     with pytest.raises(Exception) as error_info:
@@ -256,10 +275,12 @@ def test_minddataset_shard_id_bigger_than_num_shard():
     except Exception as error:
         os.remove(CV_FILE_NAME)
         os.remove("{}.db".format(CV_FILE_NAME))
+        os.remove("{}.idx".format(CV_FILE_NAME))
         raise error
     else:
         os.remove(CV_FILE_NAME)
         os.remove("{}.db".format(CV_FILE_NAME))
+        os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_cv_minddataset_partition_num_samples_equals_0():
@@ -283,10 +304,12 @@ def test_cv_minddataset_partition_num_samples_equals_0():
     except Exception as error:
         os.remove(CV_FILE_NAME)
         os.remove("{}.db".format(CV_FILE_NAME))
+        os.remove("{}.idx".format(CV_FILE_NAME))
         raise error
     else:
         os.remove(CV_FILE_NAME)
         os.remove("{}.db".format(CV_FILE_NAME))
+        os.remove("{}.idx".format(CV_FILE_NAME))
 
 if __name__ == '__main__':
     test_cv_lack_json()
@@ -49,6 +49,8 @@ def add_and_remove_cv_file():
             os.remove("{}".format(x)) if os.path.exists("{}".format(x)) else None
             os.remove("{}.db".format(x)) if os.path.exists(
                 "{}.db".format(x)) else None
+            os.remove("{}.idx".format(x)) if os.path.exists(
+                "{}.idx".format(x)) else None
         writer = FileWriter(CV_FILE_NAME, FILES_NUM)
         data = get_data(CV_DIR_NAME)
         cv_schema_json = {"id": {"type": "int32"},
@@ -64,11 +66,13 @@ def add_and_remove_cv_file():
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            os.remove("{}.idx".format(x))
         raise error
     else:
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            os.remove("{}.idx".format(x))
 
 
 @pytest.fixture
@@ -82,6 +86,8 @@ def add_and_remove_nlp_file():
                 os.remove("{}".format(x))
             if os.path.exists("{}.db".format(x)):
                 os.remove("{}.db".format(x))
+            if os.path.exists("{}.idx".format(x)):
+                os.remove("{}.idx".format(x))
         writer = FileWriter(NLP_FILE_NAME, FILES_NUM)
         data = [x for x in get_nlp_data(NLP_FILE_POS, NLP_FILE_VOCAB, 10)]
         nlp_schema_json = {"id": {"type": "string"}, "label": {"type": "int32"},
@@ -104,11 +110,13 @@ def add_and_remove_nlp_file():
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            os.remove("{}.idx".format(x))
         raise error
     else:
         for x in paths:
             os.remove("{}".format(x))
             os.remove("{}.db".format(x))
+            os.remove("{}.idx".format(x))
 
 def test_cv_minddataset_reader_basic_padded_samples(add_and_remove_cv_file):
     """tutorial for cv minderdataset."""
@@ -234,6 +234,24 @@ def test_add_sampler_invalid_input():
         data2 = ds.ManifestDataset(manifest_file, sampler=sampler, num_samples=20)        
     assert "Conflicting arguments during sampler assignments" in str(info.value)
 
+def test_distributed_sampler_block_size_invalid():
+    with pytest.raises(ValueError) as info:
+        ds.DistributedSampler(2, 0, shuffle_block_size=-1)
+    assert "shuffle_block_size should not be negative" in str(info.value)
+
+    with pytest.raises(ValueError) as info:
+        ds.DistributedSampler(2, 0, offset=1, shuffle_block_size=4)
+    assert "can not be used with an offset" in str(info.value)
+
+    # concat sets an offset for each child
+    sampler = ds.DistributedSampler(2, 0, shuffle_block_size=4)
+    with pytest.raises(ValueError) as info:
+        sampler.set_offset(1)
+    assert "can not be used with an offset" in str(info.value)
+
+    sampler = ds.DistributedSampler(2, 0, shuffle=False)
+    assert sampler.set_offset(1).offset == 1
+
 
 if __name__ == '__main__':
     test_sequential_sampler(True)
@@ -244,3 +262,4 @@ if __name__ == '__main__':
     test_subset_sampler()
     test_sampler_chain()
     test_add_sampler_invalid_input()
+    test_distributed_sampler_block_size_invalid()
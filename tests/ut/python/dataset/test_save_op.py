@@ -37,21 +37,29 @@ def fixture_remove():
         os.remove("{}".format(CV_FILE_NAME1))
     if os.path.exists("{}.db".format(CV_FILE_NAME1)):
         os.remove("{}.db".format(CV_FILE_NAME1))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME1)):
+        os.remove("{}.idx".format(CV_FILE_NAME1))
 
     if os.path.exists("{}".format(CV_FILE_NAME2)):
         os.remove("{}".format(CV_FILE_NAME2))
     if os.path.exists("{}.db".format(CV_FILE_NAME2)):
         os.remove("{}.db".format(CV_FILE_NAME2))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME2)):
+        os.remove("{}.idx".format(CV_FILE_NAME2))
     yield "yield_cv_data"
     if os.path.exists("{}".format(CV_FILE_NAME1)):
         os.remove("{}".format(CV_FILE_NAME1))
     if os.path.exists("{}.db".format(CV_FILE_NAME1)):
         os.remove("{}.db".format(CV_FILE_NAME1))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME1)):
+        os.remove("{}.idx".format(CV_FILE_NAME1))
 
     if os.path.exists("{}".format(CV_FILE_NAME2)):
         os.remove("{}".format(CV_FILE_NAME2))
     if os.path.exists("{}.db".format(CV_FILE_NAME2)):
         os.remove("{}.db".format(CV_FILE_NAME2))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME2)):
+        os.remove("{}.idx".format(CV_FILE_NAME2))
 
 
 def test_case_00(add_and_remove_cv_file):  # only bin data
@@ -364,6 +372,8 @@ def type_tester(t):
         os.remove("{}".format(CV_FILE_NAME2))
     if os.path.exists("{}.db".format(CV_FILE_NAME2)):
         os.remove("{}.db".format(CV_FILE_NAME2))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME2)):
+        os.remove("{}.idx".format(CV_FILE_NAME2))
 
 
 def test_case_04():
@@ -407,6 +417,8 @@ def test_case_07():
         os.remove("{}".format(CV_FILE_NAME2))
     if os.path.exists("{}.db".format(CV_FILE_NAME2)):
         os.remove("{}.db".format(CV_FILE_NAME2))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME2)):
+        os.remove("{}.idx".format(CV_FILE_NAME2))
     d1 = ds.TFRecordDataset(TFRECORD_FILES, shuffle=False)
     tf_data = []
     for x in d1.create_dict_iterator():
@@ -432,3 +444,5 @@ def test_case_07():
         os.remove("{}".format(CV_FILE_NAME2))
     if os.path.exists("{}.db".format(CV_FILE_NAME2)):
         os.remove("{}.db".format(CV_FILE_NAME2))
+    if os.path.exists("{}.idx".format(CV_FILE_NAME2)):
+        os.remove("{}.idx".format(CV_FILE_NAME2))
@@ -225,6 +225,39 @@ def check_bert_tokenizer_with_offsets(first, last, expect_str,
         count = count + 1
 
 
+def check_bert_tokenizer_output_ids(first, last, vocab_list, suffix_indicator='##', max_bytes_per_token=100,
+                                    unknown_token='[UNK]', lower_case=False, keep_whitespace=False,
+                                    normalization_form=text.utils.NormalizeForm.NONE, preserve_unused_token=False,
+                                    **_):
+    def tokenize(output_ids):
+        dataset = ds.TextFileDataset(BERT_TOKENIZER_FILE, shuffle=False)
+        if first > 1:
+            dataset = dataset.skip(first - 1)
+        if last >= first:
+            dataset = dataset.take(last - first + 1)
+        tokenizer_op = text.BertTokenizer(
+            vocab=vocab, suffix_indicator=suffix_indicator, max_bytes_per_token=max_bytes_per_token,
+            unknown_token=unknown_token, lower_case=lower_case, keep_whitespace=keep_whitespace,
+            normalization_form=normalization_form, preserve_unused_token=preserve_unused_token, with_offsets=True,
+            output_ids=output_ids)
+        dataset = dataset.map(input_columns=['text'], output_columns=['token', 'offsets_start', 'offsets_limit'],
+                              columns_order=['token', 'offsets_start', 'offsets_limit'], operations=tokenizer_op)
+        if not output_ids:
+            dataset = dataset.map(input_columns=['token'], operations=text.Lookup(vocab, unknown_token))
+        return dataset
+
+    vocab = text.Vocab.from_list(vocab_list)
+    count = 0
+    for expected, out in zip(tokenize(False).create_dict_iterator(), tokenize(True).create_dict_iterator()):
+        logger.info("Out:", out['token'])
+        logger.info("Exp:", expected['token'])
+        np.testing.assert_array_equal(out['token'], expected['token'])
+        np.testing.assert_array_equal(out['offsets_start'], expected['offsets_start'])
+        np.testing.assert_array_equal(out['offsets_limit'], expected['offsets_limit'])
+        count = count + 1
+    assert count == last - first + 1
+
+
 def test_bert_tokenizer_default():
     """
     Test WordpieceTokenizer when with_offsets=False
@@ -241,6 +274,16 @@ def test_bert_tokenizer_with_offsets():
         check_bert_tokenizer_with_offsets(**paras)
 
 
+def test_bert_tokenizer_output_ids():
+    """
+    Test BertTokenizer when output_ids=True gives the ids of BertTokenizer followed by Lookup
+    """
+    for paras in test_paras:
+        if paras.get('unknown_token', '[UNK]'):
+            check_bert_tokenizer_output_ids(**paras)
+
+
 if __name__ == '__main__':
     test_bert_tokenizer_default()
     test_bert_tokenizer_with_offsets()
+    test_bert_tokenizer_output_ids()
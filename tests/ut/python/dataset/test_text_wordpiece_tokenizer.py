@@ -139,6 +139,30 @@ def check_wordpiece_tokenizer_with_offsets(first, last, expect_str, expected_off
         count = count + 1
 
 
+def check_wordpiece_tokenizer_output_ids(first, last, expect_str, expected_offsets_start, expected_offsets_limit,
+                                         vocab_list, unknown_token='[UNK]', max_bytes_per_token=100):
+    dataset = ds.TextFileDataset(WORDPIECE_TOKENIZER_FILE, shuffle=False)
+    if first > 1:
+        dataset = dataset.skip(first - 1)
+    if last >= first:
+        dataset = dataset.take(last - first + 1)
+    vocab_list = vocab_list + [unknown_token]
+    vocab = text.Vocab.from_list(vocab_list)
+    tokenizer_op = text.WordpieceTokenizer(vocab=vocab, with_offsets=True, unknown_token=unknown_token,
+                                           max_bytes_per_token=max_bytes_per_token, output_ids=True)
+    dataset = dataset.map(input_columns=['text'], output_columns=['token', 'offsets_start', 'offsets_limit'],
+                          columns_order=['token', 'offsets_start', 'offsets_limit'], operations=tokenizer_op)
+    count = 0
+    for i in dataset.create_dict_iterator():
+        expected_ids = [vocab_list.index(token) for token in expect_str[count]]
+        logger.info("Out:", i['token'])
+        logger.info("Exp:", expected_ids)
+        np.testing.assert_array_equal(i['token'], expected_ids)
+        np.testing.assert_array_equal(i['offsets_start'], expected_offsets_start[count])
+        np.testing.assert_array_equal(i['offsets_limit'], expected_offsets_limit[count])
+        count = count + 1
+
+
 def test_wordpiece_tokenizer_default():
     """
     Test WordpieceTokenizer
@@ -155,6 +179,16 @@ def test_wordpiece_tokenizer_with_offsets():
         check_wordpiece_tokenizer_with_offsets(**paras)
 
 
+def test_wordpiece_tokenizer_output_ids():
+    """
+    Test WordpieceTokenizer when output_ids=True, the unknown token has to be in vocab
+    """
+    for paras in test_paras:
+        if paras.get('unknown_token', '[UNK]'):
+            check_wordpiece_tokenizer_output_ids(**paras)
+
+
 if __name__ == '__main__':
     test_wordpiece_tokenizer_default()
     test_wordpiece_tokenizer_with_offsets()
+    test_wordpiece_tokenizer_output_ids()
@@ -46,6 +46,7 @@ def test_cv_file_writer_default_shard_num():
 
     os.remove("{}".format(CV_FILE_NAME))
     os.remove("{}.db".format(CV_FILE_NAME))
+    os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_cv_file_writer_shard_num_10():
@@ -69,6 +70,7 @@ def test_cv_file_writer_shard_num_10():
     for item in paths:
         os.remove("{}".format(item))
         os.remove("{}.db".format(item))
+        os.remove("{}.idx".format(item))
 
 
 def test_cv_file_writer_file_name_none():
@@ -189,6 +191,7 @@ def test_file_writer_fail_add_index():
 
     os.remove("{}".format(file_name))
     os.remove("{}.db".format(file_name))
+    os.remove("{}.idx".format(file_name))
 
 
 def test_add_index_with_incorrect_field():
@@ -250,6 +253,7 @@ def test_mkv_file_reader_with_negative_num_consumer():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        os.remove("{}.idx".format(x))
 
 
 def test_write_raw_data_with_empty_list():
@@ -273,6 +277,7 @@ def test_write_raw_data_with_empty_list():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        os.remove("{}.idx".format(x))
 
 
 def test_issue_38():
@@ -311,6 +316,7 @@ def test_issue_39():
     reader.close()
     os.remove("{}".format(CV_FILE_NAME))
     os.remove("{}.db".format(CV_FILE_NAME))
+    os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_issue_40():
@@ -328,6 +334,7 @@ def test_issue_40():
 
     os.remove("{}".format(CV_FILE_NAME))
     os.remove("{}.db".format(CV_FILE_NAME))
+    os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_issue_73():
@@ -353,6 +360,7 @@ def test_issue_73():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        os.remove("{}.idx".format(x))
 
 
 def test_issue_117():
@@ -394,6 +402,7 @@ def test_issue_95():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        os.remove("{}.idx".format(x))
 
 
 def test_mindrecord_add_index_016():
@@ -444,6 +453,7 @@ def test_issue_118():
     for item in paths:
         os.remove("{}".format(item))
         os.remove("{}.db".format(item))
+        os.remove("{}.idx".format(item))
 
 
 def test_issue_87():
@@ -512,6 +522,7 @@ def test_issue_84():
     for item in paths:
         os.remove("{}".format(item))
         os.remove("{}.db".format(item))
+        os.remove("{}.idx".format(item))
 
     os.rename("imagenet.mindrecord1.db.bk", "imagenet.mindrecord1.db")
     paths = ["{}{}".format(CV_FILE_NAME, str(x).rjust(1, '0'))
@@ -519,6 +530,7 @@ def test_issue_84():
     for item in paths:
         os.remove("{}".format(item))
         os.remove("{}.db".format(item))
+        os.remove("{}.idx".format(item))
 
 
 def test_issue_65():
@@ -573,6 +585,7 @@ def test_issue_124():
     for item in paths:
         os.remove("{}".format(item))
         os.remove("{}.db".format(item))
+        os.remove("{}.idx".format(item))
 
 
 def test_issue_36():
@@ -611,6 +624,7 @@ def test_issue_34():
     reader.close()
     os.remove(CV_FILE_NAME)
     os.remove("{}.db".format(CV_FILE_NAME))
+    os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_file_writer_raw_data_038():
@@ -638,6 +652,7 @@ def test_file_writer_raw_data_038():
     if shard_num == 1:
         os.remove("test_file_writer_raw_data_")
         os.remove("test_file_writer_raw_data_.db")
+        os.remove("test_file_writer_raw_data_.idx")
         return
     for x in range(shard_num):
         n = str(x)
@@ -647,6 +662,8 @@ def test_file_writer_raw_data_038():
             os.remove("test_file_writer_raw_data_{}".format(n))
         if os.path.exists("test_file_writer_raw_data_{}.db".format(n)):
             os.remove("test_file_writer_raw_data_{}.db".format(n))
+        if os.path.exists("test_file_writer_raw_data_{}.idx".format(n)):
+            os.remove("test_file_writer_raw_data_{}.idx".format(n))
 
 
 def test_more_than_1_bytes_in_schema():
@@ -686,3 +703,4 @@ def test_shard_4_raw_data_1():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        os.remove("{}.idx".format(x))
@@ -106,6 +106,7 @@ def test_nlp_page_reader():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        os.remove("{}.idx".format(x))
 
 
 def test_cv_file_writer():
@@ -182,6 +183,7 @@ def test_cv_page_reader():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        os.remove("{}.idx".format(x))
 
 
 def test_mkv_file_writer():
@@ -257,6 +259,7 @@ def test_mkv_page_reader_random():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        os.remove("{}.idx".format(x))
 
 
 def test_mkv_file_writer_with_exactly_schema():
@@ -348,3 +351,4 @@ def test_mkv_file_reader_with_exactly_schema():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        os.remove("{}.idx".format(x))
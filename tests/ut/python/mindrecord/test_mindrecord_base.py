@@ -77,6 +77,7 @@ def test_write_read_process():
 
     os.remove("{}".format(mindrecord_file_name))
     os.remove("{}.db".format(mindrecord_file_name))
+    os.remove("{}.idx".format(mindrecord_file_name))
 
 
 def test_write_read_process_with_define_index_field():
@@ -128,6 +129,7 @@ def test_write_read_process_with_define_index_field():
 
     os.remove("{}".format(mindrecord_file_name))
     os.remove("{}.db".format(mindrecord_file_name))
+    os.remove("{}.idx".format(mindrecord_file_name))
 
 
 def test_cv_file_writer_tutorial():
@@ -169,6 +171,7 @@ def test_cv_file_append_writer():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        os.remove("{}.idx".format(x))
 
 
 def test_cv_file_append_writer_absolute_path():
@@ -198,6 +201,7 @@ def test_cv_file_append_writer_absolute_path():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        os.remove("{}.idx".format(x))
 
 
 def test_cv_file_writer_loop_and_read():
@@ -226,6 +230,7 @@ def test_cv_file_writer_loop_and_read():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        os.remove("{}.idx".format(x))
 
 
 def test_cv_file_reader_tutorial():
@@ -339,6 +344,7 @@ def test_cv_page_reader_tutorial_new_api():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        os.remove("{}.idx".format(x))
 
 
 def test_nlp_file_writer_tutorial():
@@ -402,6 +408,7 @@ def test_nlp_page_reader_tutorial():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        os.remove("{}.idx".format(x))
 
 
 def test_cv_file_writer_shard_num_10():
@@ -420,6 +427,7 @@ def test_cv_file_writer_shard_num_10():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        os.remove("{}.idx".format(x))
 
 
 def test_cv_file_writer_absolute_path():
@@ -439,6 +447,7 @@ def test_cv_file_writer_absolute_path():
     for x in paths:
         os.remove("{}".format(x))
         os.remove("{}.db".format(x))
+        os.remove("{}.idx".format(x))
 
 
 def test_cv_file_writer_without_data():
@@ -458,6 +467,7 @@ def test_cv_file_writer_without_data():
     reader.close()
     os.remove(CV_FILE_NAME)
     os.remove("{}.db".format(CV_FILE_NAME))
+    os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_cv_file_writer_no_blob():
@@ -480,6 +490,7 @@ def test_cv_file_writer_no_blob():
     reader.close()
     os.remove(CV_FILE_NAME)
     os.remove("{}.db".format(CV_FILE_NAME))
+    os.remove("{}.idx".format(CV_FILE_NAME))
 
 
 def test_cv_file_writer_no_raw():
@@ -508,6 +519,7 @@ def test_cv_file_writer_no_raw():
     reader.close()
     os.remove(NLP_FILE_NAME)
     os.remove("{}.db".format(NLP_FILE_NAME))
+    os.remove("{}.idx".format(NLP_FILE_NAME))
 
 
 def test_write_read_process_with_multi_bytes():
@@ -633,6 +645,7 @@ def test_write_read_process_with_multi_bytes():
 
     os.remove("{}".format(mindrecord_file_name))
     os.remove("{}.db".format(mindrecord_file_name))
+    os.remove("{}.idx".format(mindrecord_file_name))
 
 
 def test_write_read_process_with_multi_array():
@@ -777,6 +790,7 @@ def test_write_read_process_with_multi_array():
 
     os.remove("{}".format(mindrecord_file_name))
     os.remove("{}.db".format(mindrecord_file_name))
+    os.remove("{}.idx".format(mindrecord_file_name))
 
 
 def test_write_read_process_with_multi_bytes_and_array():
@@ -964,3 +978,4 @@ def test_write_read_process_with_multi_bytes_and_array():
 
     os.remove("{}".format(mindrecord_file_name))
     os.remove("{}.db".format(mindrecord_file_name))
+    os.remove("{}.idx".format(mindrecord_file_name))
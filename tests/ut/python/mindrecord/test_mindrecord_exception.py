@@ -37,11 +37,15 @@ def remove_file(file_name):
     remove_one_file(x)
     x = file_name + ".db"
     remove_one_file(x)
+    x = file_name + ".idx"
+    remove_one_file(x)
     for i in range(FILES_NUM):
         x = file_name + str(i)
         remove_one_file(x)
         x = file_name + str(i) + ".db"
         remove_one_file(x)
+        x = file_name + str(i) + ".idx"
+        remove_one_file(x)
 
 @pytest.fixture
 def fixture_cv_file():
@@ -117,6 +121,7 @@ def test_lack_db(fixture_cv_file):
     """test file reader when db file does not exist."""
     create_cv_mindrecord(1)
     os.remove("{}.db".format(CV_FILE_NAME))
+    os.remove("{}.idx".format(CV_FILE_NAME))
     with pytest.raises(MRMOpenError) as err:
         reader = FileReader(CV_FILE_NAME)
         reader.close()
@@ -131,6 +136,7 @@ def test_lack_some_partition_and_db(fixture_cv_file):
              for x in range(FILES_NUM)]
     os.remove("{}".format(paths[3]))
     os.remove("{}.db".format(paths[3]))
+    os.remove("{}.idx".format(paths[3]))
     with pytest.raises(MRMOpenError) as err:
         reader = FileReader(CV_FILE_NAME + "0")
         reader.close()
@@ -195,6 +201,7 @@ def test_lack_some_db(fixture_cv_file):
     paths = ["{}{}".format(CV_FILE_NAME, str(x).rjust(1, '0'))
              for x in range(FILES_NUM)]
     os.remove("{}.db".format(paths[3]))
+    os.remove("{}.idx".format(paths[3]))
     with pytest.raises(MRMOpenError) as err:
         reader = FileReader(CV_FILE_NAME + "0")
         reader.close()
@@ -219,6 +226,7 @@ def test_invalid_db(fixture_cv_file):
     """test file reader when the content of db is illegal."""
     create_cv_mindrecord(1)
     os.remove("imagenet.mindrecord.db")
+    os.remove("imagenet.mindrecord.idx")
     with open('imagenet.mindrecord.db', 'w') as f:
         f.write('just for test')
     with pytest.raises(MRMOpenError) as err:
@@ -362,6 +370,7 @@ def test_invalid_schema():
 
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        os.remove("{}.idx".format(mindrecord_file_name))
 
     # int32  =>  np.int32
     schema = {"file_name": {"type": "string"},
@@ -377,6 +386,7 @@ def test_invalid_schema():
 
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        os.remove("{}.idx".format(mindrecord_file_name))
 
     # float64  =>  np.float64
     schema = {"file_name": {"type": "string"},
@@ -392,6 +402,7 @@ def test_invalid_schema():
 
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        os.remove("{}.idx".format(mindrecord_file_name))
 
     # int64  =>  int8
     schema = {"file_name": {"type": "string"},
@@ -407,6 +418,7 @@ def test_invalid_schema():
 
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        os.remove("{}.idx".format(mindrecord_file_name))
 
     # int64  =>  uint64
     schema = {"file_name": {"type": "string"},
@@ -422,6 +434,7 @@ def test_invalid_schema():
 
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        os.remove("{}.idx".format(mindrecord_file_name))
 
     # bytes  =>  byte
     schema = {"file_name": {"type": "strint"},
@@ -437,6 +450,7 @@ def test_invalid_schema():
 
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        os.remove("{}.idx".format(mindrecord_file_name))
 
     # float32  => float3
     schema = {"file_name": {"type": "string"},
@@ -452,6 +466,7 @@ def test_invalid_schema():
 
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        os.remove("{}.idx".format(mindrecord_file_name))
 
     # string with shape
     schema = {"file_name": {"type": "string", "shape": [-1]},
@@ -467,6 +482,7 @@ def test_invalid_schema():
 
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        os.remove("{}.idx".format(mindrecord_file_name))
 
     # bytes with shape
     schema = {"file_name": {"type": "string"},
@@ -482,6 +498,7 @@ def test_invalid_schema():
 
         os.remove("{}".format(mindrecord_file_name))
         os.remove("{}.db".format(mindrecord_file_name))
+        os.remove("{}.idx".format(mindrecord_file_name))
 
 def test_write_with_invalid_data():
     mindrecord_file_name = "test.mindrecord"
@@ -490,6 +507,7 @@ def test_write_with_invalid_data():
     with pytest.raises(Exception, match="Failed to write dataset"):
         remove_one_file(mindrecord_file_name)
         remove_one_file(mindrecord_file_name + ".db")
+        remove_one_file(mindrecord_file_name + ".idx")
 
         data = [{"filename": "001.jpg", "label": 43, "score": 0.8, "mask": np.array([3, 6, 9], dtype=np.int64),
                  "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -525,6 +543,7 @@ def test_write_with_invalid_data():
     with pytest.raises(Exception, match="Failed to write dataset"):
         remove_one_file(mindrecord_file_name)
         remove_one_file(mindrecord_file_name + ".db")
+        remove_one_file(mindrecord_file_name + ".idx")
 
         data = [{"file_name": "001.jpg", "label": 43, "score": 0.8, "masks": np.array([3, 6, 9], dtype=np.int64),
                  "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -560,6 +579,7 @@ def test_write_with_invalid_data():
     with pytest.raises(Exception, match="Failed to write dataset"):
         remove_one_file(mindrecord_file_name)
         remove_one_file(mindrecord_file_name + ".db")
+        remove_one_file(mindrecord_file_name + ".idx")
 
         data = [{"file_name": "001.jpg", "label": 43, "score": 0.8, "mask": np.array([3, 6, 9], dtype=np.int64),
                  "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -595,6 +615,7 @@ def test_write_with_invalid_data():
     with pytest.raises(Exception, match="Failed to write dataset"):
         remove_one_file(mindrecord_file_name)
         remove_one_file(mindrecord_file_name + ".db")
+        remove_one_file(mindrecord_file_name + ".idx")
 
         data = [{"file_name": "001.jpg", "lable": 43, "score": 0.8, "mask": np.array([3, 6, 9], dtype=np.int64),
                  "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -630,6 +651,7 @@ def test_write_with_invalid_data():
     with pytest.raises(Exception, match="Failed to write dataset"):
         remove_one_file(mindrecord_file_name)
         remove_one_file(mindrecord_file_name + ".db")
+        remove_one_file(mindrecord_file_name + ".idx")
 
         data = [{"file_name": "001.jpg", "label": 43, "scores": 0.8, "mask": np.array([3, 6, 9], dtype=np.int64),
                  "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -665,6 +687,7 @@ def test_write_with_invalid_data():
     with pytest.raises(Exception, match="Failed to write dataset"):
         remove_one_file(mindrecord_file_name)
         remove_one_file(mindrecord_file_name + ".db")
+        remove_one_file(mindrecord_file_name + ".idx")
 
         data = [{"file_name": 1, "label": 43, "score": 0.8, "mask": np.array([3, 6, 9], dtype=np.int64),
                  "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -700,6 +723,7 @@ def test_write_with_invalid_data():
     with pytest.raises(Exception, match="Failed to write dataset"):
         remove_one_file(mindrecord_file_name)
         remove_one_file(mindrecord_file_name + ".db")
+        remove_one_file(mindrecord_file_name + ".idx")
 
         data = [{"file_name": "001.jpg", "label": "cat", "score": 0.8, "mask": np.array([3, 6, 9], dtype=np.int64),
                  "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -735,6 +759,7 @@ def test_write_with_invalid_data():
     with pytest.raises(Exception, match="Failed to write dataset"):
         remove_one_file(mindrecord_file_name)
         remove_one_file(mindrecord_file_name + ".db")
+        remove_one_file(mindrecord_file_name + ".idx")
 
         data = [{"file_name": "001.jpg", "label": 43, "score": 0.8, "mask": np.array([3, 6, 9], dtype=np.int64),
                  "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -770,6 +795,7 @@ def test_write_with_invalid_data():
     with pytest.raises(Exception, match="Failed to write dataset"):
         remove_one_file(mindrecord_file_name)
         remove_one_file(mindrecord_file_name + ".db")
+        remove_one_file(mindrecord_file_name + ".idx")
 
         data = [{"file_name": "001.jpg", "label": 43, "score": 0.8, "mask": [3, 6, 9],
                  "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -805,6 +831,7 @@ def test_write_with_invalid_data():
     with pytest.raises(Exception, match="Failed to write dataset"):
         remove_one_file(mindrecord_file_name)
         remove_one_file(mindrecord_file_name + ".db")
+        remove_one_file(mindrecord_file_name + ".idx")
 
         data = [{"file_name": "001.jpg", "score": 0.8, "mask": np.array([3, 6, 9], dtype=np.int64),
                  "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -839,6 +866,7 @@ def test_write_with_invalid_data():
     # more field is ok
     remove_one_file(mindrecord_file_name)
     remove_one_file(mindrecord_file_name + ".db")
+    remove_one_file(mindrecord_file_name + ".idx")
 
     data = [{"file_name": "001.jpg", "label": 43, "score": 0.8, "mask": np.array([3, 6, 9], dtype=np.int64),
              "segments": np.array([[5.0, 1.6], [65.2, 8.3]], dtype=np.float32),
@@ -872,3 +900,4 @@ def test_write_with_invalid_data():
 
     remove_one_file(mindrecord_file_name)
     remove_one_file(mindrecord_file_name + ".db")
+    remove_one_file(mindrecord_file_name + ".idx")
@@ -180,6 +180,8 @@ def test_tfrecord_to_mindrecord():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     tfrecord_transformer = TFRecordToMR(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME),
                                         MINDRECORD_FILE_NAME, feature_dict, ["image_bytes"])
@@ -193,6 +195,7 @@ def test_tfrecord_to_mindrecord():
 
     os.remove(MINDRECORD_FILE_NAME)
     os.remove(MINDRECORD_FILE_NAME + ".db")
+    os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     os.remove(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME))
 
@@ -219,6 +222,8 @@ def test_tfrecord_to_mindrecord_scalar_with_1():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     tfrecord_transformer = TFRecordToMR(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME),
                                         MINDRECORD_FILE_NAME, feature_dict, ["image_bytes"])
@@ -232,6 +237,7 @@ def test_tfrecord_to_mindrecord_scalar_with_1():
 
     os.remove(MINDRECORD_FILE_NAME)
     os.remove(MINDRECORD_FILE_NAME + ".db")
+    os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     os.remove(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME))
 
@@ -258,6 +264,8 @@ def test_tfrecord_to_mindrecord_scalar_with_1_list_small_len_exception():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     with pytest.raises(ValueError):
         tfrecord_transformer = TFRecordToMR(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME),
@@ -268,6 +276,8 @@ def test_tfrecord_to_mindrecord_scalar_with_1_list_small_len_exception():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     os.remove(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME))
 
@@ -294,6 +304,8 @@ def test_tfrecord_to_mindrecord_list_with_diff_type_exception():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     with pytest.raises(ValueError):
         tfrecord_transformer = TFRecordToMR(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME),
@@ -304,6 +316,8 @@ def test_tfrecord_to_mindrecord_list_with_diff_type_exception():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     os.remove(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME))
 
@@ -330,6 +344,8 @@ def test_tfrecord_to_mindrecord_list_without_bytes_type():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     tfrecord_transformer = TFRecordToMR(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME),
                                         MINDRECORD_FILE_NAME, feature_dict)
@@ -343,6 +359,7 @@ def test_tfrecord_to_mindrecord_list_without_bytes_type():
 
     os.remove(MINDRECORD_FILE_NAME)
     os.remove(MINDRECORD_FILE_NAME + ".db")
+    os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     os.remove(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME))
 
@@ -369,6 +386,8 @@ def test_tfrecord_to_mindrecord_scalar_with_2_exception():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     tfrecord_transformer = TFRecordToMR(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME),
                                         MINDRECORD_FILE_NAME, feature_dict, ["image_bytes"])
@@ -379,6 +398,8 @@ def test_tfrecord_to_mindrecord_scalar_with_2_exception():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     os.remove(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME))
 
@@ -405,6 +426,8 @@ def test_tfrecord_to_mindrecord_scalar_string_with_1_exception():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     with pytest.raises(ValueError):
         tfrecord_transformer = TFRecordToMR(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME),
@@ -415,6 +438,8 @@ def test_tfrecord_to_mindrecord_scalar_string_with_1_exception():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     os.remove(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME))
 
@@ -441,6 +466,8 @@ def test_tfrecord_to_mindrecord_scalar_bytes_with_10_exception():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     with pytest.raises(ValueError):
         tfrecord_transformer = TFRecordToMR(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME),
@@ -451,6 +478,8 @@ def test_tfrecord_to_mindrecord_scalar_bytes_with_10_exception():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     os.remove(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME))
 
@@ -477,6 +506,8 @@ def test_tfrecord_to_mindrecord_exception_bytes_fields_is_not_string_type():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     with pytest.raises(ValueError):
         tfrecord_transformer = TFRecordToMR(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME),
@@ -487,6 +518,8 @@ def test_tfrecord_to_mindrecord_exception_bytes_fields_is_not_string_type():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     os.remove(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME))
 
@@ -513,6 +546,8 @@ def test_tfrecord_to_mindrecord_exception_bytes_fields_is_not_list():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     with pytest.raises(ValueError):
         tfrecord_transformer = TFRecordToMR(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME),
@@ -523,6 +558,8 @@ def test_tfrecord_to_mindrecord_exception_bytes_fields_is_not_list():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     os.remove(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME))
 
@@ -545,6 +582,8 @@ def test_tfrecord_to_mindrecord_with_special_field_name():
         os.remove(MINDRECORD_FILE_NAME)
     if os.path.exists(MINDRECORD_FILE_NAME + ".db"):
         os.remove(MINDRECORD_FILE_NAME + ".db")
+    if os.path.exists(MINDRECORD_FILE_NAME + ".idx"):
+        os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     tfrecord_transformer = TFRecordToMR(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME),
                                         MINDRECORD_FILE_NAME, feature_dict, ["image/encoded"])
@@ -558,5 +597,6 @@ def test_tfrecord_to_mindrecord_with_special_field_name():
 
     os.remove(MINDRECORD_FILE_NAME)
     os.remove(MINDRECORD_FILE_NAME + ".db")
+    os.remove(MINDRECORD_FILE_NAME + ".idx")
 
     os.remove(os.path.join(TFRECORD_DATA_DIR, TFRECORD_FILE_NAME))